@@ -1,5 +1,9 @@
 #include <benchmark/benchmark.h>
+#include "perf_counters.h"
 #include "common/cache.h"
+#include "common/symbol_map.h"
+#include <numeric>
+#include <random>
 #include <thread>
 #include <vector>
 
@@ -9,6 +13,7 @@ using namespace mdfh;
 static void BM_CacheUpdate(benchmark::State& state) {
     SymbolCache cache(100);
     
+    bench::PerfScope perf(state);
     for (auto _ : state) {
         cache.update_bid(0, 2450.25, 1000);
         benchmark::ClobberMemory();
@@ -23,6 +28,7 @@ static void BM_CacheRead(benchmark::State& state) {
     SymbolCache cache(100);
     cache.update_bid(0, 2450.25, 1000);
     
+    bench::PerfScope perf(state);
     for (auto _ : state) {
         MarketSnapshot snapshot = cache.get_snapshot(0);
         benchmark::DoNotOptimize(snapshot);
@@ -37,6 +43,7 @@ static void BM_CacheUpdateBatch(benchmark::State& state) {
     SymbolCache cache(100);
     int num_symbols = state.range(0);
     
+    bench::PerfScope perf(state);
     for (auto _ : state) {
         for (int i = 0; i < num_symbols; ++i) {
             cache.update_bid(i % 100, 2450.25 + i, 1000 + i);
@@ -56,6 +63,7 @@ static void BM_CacheMixedWorkload(benchmark::State& state) {
         cache.update_bid(i, 2450.25, 1000);
     }
     
+    bench::PerfScope perf(state);
     for (auto _ : state) {
         // 70% reads, 30% writes
         for (int i = 0; i < 100; ++i) {
@@ -76,6 +84,7 @@ BENCHMARK(BM_CacheMixedWorkload);
 static void BM_CacheTradeUpdate(benchmark::State& state) {
     SymbolCache cache(100);
     
+    bench::PerfScope perf(state);
     for (auto _ : state) {
         cache.update_trade(0, 2450.50, 500);
         benchmark::ClobberMemory();
@@ -96,6 +105,7 @@ static void BM_CacheStatistics(benchmark::State& state) {
         }
     }
     
+    bench::PerfScope perf(state);
     for (auto _ : state) {
         uint64_t total = cache.get_total_updates();
         benchmark::DoNotOptimize(total);
@@ -114,8 +124,9 @@ static void BM_CacheMultiThreadRead(benchmark::State& state) {
         cache.update_bid(i, 2450.25, 1000);
     }
     
-    if (state.thread_index == 0) {
+    if (state.thread_index() == 0) {
         // Writer thread
+        bench::PerfScope perf(state);
         for (auto _ : state) {
             for (int i = 0; i < 100; ++i) {
                 cache.update_bid(i, 2450.25 + state.iterations(), 1000);
@@ -123,6 +134,7 @@ static void BM_CacheMultiThreadRead(benchmark::State& state) {
         }
     } else {
         // Reader threads
+        bench::PerfScope perf(state);
         for (auto _ : state) {
             for (int i = 0; i < 100; ++i) {
                 MarketSnapshot snapshot = cache.get_snapshot(i);
@@ -135,4 +147,73 @@ static void BM_CacheMultiThreadRead(benchmark::State& state) {
 }
 BENCHMARK(BM_CacheMultiThreadRead)->Threads(4)->UseRealTime();
 
+// Benchmark: Full snapshot scan of the cache (visualizer / resync path) at
+// universe sizes up to 1M instruments; one cache line per symbol
+static void BM_CacheScan(benchmark::State& state) {
+    const size_t num_symbols = static_cast<size_t>(state.range(0));
+    SymbolCache cache(num_symbols);
+    for (size_t i = 0; i < num_symbols; ++i) {
+        cache.update_trade(static_cast<uint32_t>(i), 100.0 + i % 97, 10);
+    }
+    
+    bench::PerfScope perf(state);
+    for (auto _ : state) {
+        double sum = 0.0;
+        for (size_t i = 0; i < num_symbols; ++i) {
+            sum += cache.get_snapshot(static_cast<uint32_t>(i)).last_traded_price;
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    
+    state.SetItemsProcessed(state.iterations() * num_symbols);
+    state.counters["cache_MB"] = static_cast<double>(num_symbols * sizeof(MarketState)) / (1 << 20);
+}
+BENCHMARK(BM_CacheScan)->Arg(1000)->Arg(65536)->Arg(1 << 20);
+
+// Benchmark: Random-symbol quote updates through the id -> slot map, as the
+// feed handler applies them. Arg 0: symbols tracked; arg 1: 1 = ids are the
+// slots (identity map), 0 = ids scattered over a 16M id space.
+static void BM_CacheUpdateMapped(benchmark::State& state) {
+    const size_t num_symbols = static_cast<size_t>(state.range(0));
+    const bool identity = state.range(1) != 0;
+    
+    std::mt19937 rng(42);
+    std::vector<SymbolId> ids(num_symbols);
+    if (identity) {
+        std::iota(ids.begin(), ids.end(), 0);
+    } else {
+        constexpr SymbolId ID_SPACE = 1u << 24;
+        std::vector<bool> used(ID_SPACE, false);
+        std::uniform_int_distribution<SymbolId> id_dist(0, ID_SPACE - 1);
+        for (auto& id : ids) {
+            do {
+                id = id_dist(rng);
+            } while (used[id]);
+            used[id] = true;
+        }
+    }
+    SymbolMap map = identity ? SymbolMap(num_symbols) : SymbolMap(ids);
+    SymbolCache cache(num_symbols);
+    
+    // Pre-drawn message ids so the loop measures lookup + update only
+    std::vector<SymbolId> stream(4096);
+    std::uniform_int_distribution<size_t> pick(0, num_symbols - 1);
+    for (auto& id : stream) {
+        id = ids[pick(rng)];
+    }
+    
+    size_t i = 0;
+    bench::PerfScope perf(state);
+    for (auto _ : state) {
+        cache.update_quote(map.slot(stream[i++ & 4095]), 2450.25, 100, 2450.75, 200);
+    }
+    
+    state.SetItemsProcessed(state.iterations());
+    state.counters["map_MB"] = static_cast<double>(map.memory_bytes()) / (1 << 20);
+    state.counters["cache_MB"] = static_cast<double>(num_symbols * sizeof(MarketState)) / (1 << 20);
+}
+BENCHMARK(BM_CacheUpdateMapped)
+    ->Args({1000, 1})->Args({1000, 0})
+    ->Args({1 << 20, 1})->Args({1 << 20, 0});
+
 BENCHMARK_MAIN();
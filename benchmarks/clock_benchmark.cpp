@@ -0,0 +1,111 @@
+#include <benchmark/benchmark.h>
+#include "perf_counters.h"
+#include "common/tsc_clock.h"
+#include <chrono>
+#include <time.h>
+
+using namespace mdfh;
+
+// Benchmark: Raw rdtsc
+static void BM_Rdtsc(benchmark::State& state) {
+    bench::PerfScope perf(state);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(TscClock::rdtsc());
+    }
+    
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_Rdtsc);
+
+// Benchmark: rdtscp (waits for prior instructions)
+static void BM_Rdtscp(benchmark::State& state) {
+    bench::PerfScope perf(state);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(TscClock::rdtscp());
+    }
+    
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_Rdtscp);
+
+// Benchmark: TscClock::now_ticks (hot-path timestamp)
+static void BM_TscNowTicks(benchmark::State& state) {
+    bench::PerfScope perf(state);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(TscClock::now_ticks());
+    }
+    
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_TscNowTicks);
+
+// Benchmark: TscClock::now_ns (read + conversion)
+static void BM_TscNowNs(benchmark::State& state) {
+    bench::PerfScope perf(state);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(TscClock::now_ns());
+    }
+    
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_TscNowNs);
+
+// Benchmark: TscClock::now_wall_ns (replaces system_clock in generate_tick)
+static void BM_TscNowWallNs(benchmark::State& state) {
+    bench::PerfScope perf(state);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(TscClock::now_wall_ns());
+    }
+    
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_TscNowWallNs);
+
+// Benchmark: Tick-delta conversion
+static void BM_TscDeltaToNs(benchmark::State& state) {
+    uint64_t delta = 12345;
+    
+    bench::PerfScope perf(state);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(TscClock::delta_to_ns(delta));
+        delta += 7;
+    }
+    
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_TscDeltaToNs);
+
+// Baseline: std::chrono::steady_clock
+static void BM_SteadyClock(benchmark::State& state) {
+    bench::PerfScope perf(state);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(std::chrono::steady_clock::now());
+    }
+    
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_SteadyClock);
+
+// Baseline: std::chrono::system_clock
+static void BM_SystemClock(benchmark::State& state) {
+    bench::PerfScope perf(state);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(std::chrono::system_clock::now());
+    }
+    
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_SystemClock);
+
+// Baseline: clock_gettime(CLOCK_MONOTONIC_RAW)
+static void BM_MonotonicRaw(benchmark::State& state) {
+    bench::PerfScope perf(state);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(TscClock::monotonic_raw_ns());
+    }
+    
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_MonotonicRaw);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,147 @@
+#include <benchmark/benchmark.h>
+#include "perf_counters.h"
+#include "common/cache.h"
+#include "common/consolidated_book.h"
+#include "common/tsc_clock.h"
+#include <memory>
+#include <random>
+#include <vector>
+
+using namespace mdfh;
+
+namespace {
+
+constexpr size_t NUM_SYMBOLS = 1000;
+constexpr size_t NUM_QUOTES = 1 << 14;
+
+struct VenueQuote {
+    uint16_t venue;
+    uint16_t symbol_id;
+    double bid;
+    double ask;
+    uint32_t bid_qty;
+    uint32_t ask_qty;
+};
+
+// Quotes from all venues interleaved, prices jittering around a per-symbol
+// mid so the best venue keeps changing
+std::vector<VenueQuote> make_quotes(size_t num_venues) {
+    std::mt19937 rng(42);
+    std::uniform_int_distribution<int> symbol(0, NUM_SYMBOLS - 1);
+    std::uniform_int_distribution<int> ticks(-5, 5);
+    std::uniform_int_distribution<uint32_t> qty(100, 1000);
+
+    std::vector<VenueQuote> quotes(NUM_QUOTES);
+    for (size_t i = 0; i < NUM_QUOTES; ++i) {
+        auto& q = quotes[i];
+        q.venue = static_cast<uint16_t>(i % num_venues);
+        q.symbol_id = static_cast<uint16_t>(symbol(rng));
+        double mid = 100.0 + q.symbol_id + ticks(rng) * 0.01;
+        q.bid = mid - 0.01;
+        q.ask = mid + 0.01;
+        q.bid_qty = qty(rng);
+        q.ask_qty = qty(rng);
+    }
+    return quotes;
+}
+
+} // namespace
+
+// Benchmark: Venue cache update only (what a single-venue handler pays)
+static void BM_VenueCacheQuote(benchmark::State& state) {
+    size_t num_venues = static_cast<size_t>(state.range(0));
+    auto quotes = make_quotes(num_venues);
+    std::vector<std::unique_ptr<SymbolCache>> caches;
+    for (size_t v = 0; v < num_venues; ++v) {
+        caches.push_back(std::make_unique<SymbolCache>(NUM_SYMBOLS));
+    }
+
+    size_t i = 0;
+    bench::PerfScope perf(state);
+    for (auto _ : state) {
+        const auto& q = quotes[i++ & (NUM_QUOTES - 1)];
+        caches[q.venue]->update_quote(q.symbol_id, q.bid, q.bid_qty, q.ask, q.ask_qty);
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_VenueCacheQuote)->Arg(2)->Arg(4)->Arg(8)->Arg(16);
+
+// Benchmark: Venue cache update plus incremental consolidation; the
+// difference to BM_VenueCacheQuote is the consolidation cost per update
+static void BM_ConsolidatedQuote(benchmark::State& state) {
+    size_t num_venues = static_cast<size_t>(state.range(0));
+    auto quotes = make_quotes(num_venues);
+    std::vector<std::unique_ptr<SymbolCache>> caches;
+    for (size_t v = 0; v < num_venues; ++v) {
+        caches.push_back(std::make_unique<SymbolCache>(NUM_SYMBOLS));
+    }
+    ConsolidatedBook book(NUM_SYMBOLS, num_venues);
+    // The feed handler passes its batch receive time; one clock read per batch
+    uint64_t receive_ticks = TscClock::now_ticks();
+
+    size_t i = 0;
+    bench::PerfScope perf(state);
+    for (auto _ : state) {
+        const auto& q = quotes[i++ & (NUM_QUOTES - 1)];
+        caches[q.venue]->update_quote(q.symbol_id, q.bid, q.bid_qty, q.ask, q.ask_qty);
+        book.update_quote(q.venue, q.symbol_id, q.bid, q.bid_qty, q.ask, q.ask_qty, receive_ticks);
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_ConsolidatedQuote)->Arg(2)->Arg(4)->Arg(8)->Arg(16);
+
+// Benchmark: Baseline that rebuilds the BBO by reading every venue cache's
+// snapshot on each update (what the consolidated book avoids)
+static void BM_RescanVenueCaches(benchmark::State& state) {
+    size_t num_venues = static_cast<size_t>(state.range(0));
+    auto quotes = make_quotes(num_venues);
+    std::vector<std::unique_ptr<SymbolCache>> caches;
+    for (size_t v = 0; v < num_venues; ++v) {
+        caches.push_back(std::make_unique<SymbolCache>(NUM_SYMBOLS));
+    }
+
+    size_t i = 0;
+    bench::PerfScope perf(state);
+    for (auto _ : state) {
+        const auto& q = quotes[i++ & (NUM_QUOTES - 1)];
+        caches[q.venue]->update_quote(q.symbol_id, q.bid, q.bid_qty, q.ask, q.ask_qty);
+
+        double best_bid = 0.0;
+        double best_ask = 0.0;
+        for (size_t v = 0; v < num_venues; ++v) {
+            MarketSnapshot snap = caches[v]->get_snapshot(q.symbol_id);
+            if (snap.best_bid > best_bid) best_bid = snap.best_bid;
+            if (snap.best_ask > 0.0 && (best_ask == 0.0 || snap.best_ask < best_ask)) best_ask = snap.best_ask;
+        }
+        benchmark::DoNotOptimize(best_bid);
+        benchmark::DoNotOptimize(best_ask);
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_RescanVenueCaches)->Arg(2)->Arg(4)->Arg(8)->Arg(16);
+
+// Benchmark: Consolidated snapshot read
+static void BM_ConsolidatedRead(benchmark::State& state) {
+    size_t num_venues = static_cast<size_t>(state.range(0));
+    auto quotes = make_quotes(num_venues);
+    ConsolidatedBook book(NUM_SYMBOLS, num_venues);
+    for (const auto& q : quotes) {
+        book.update_quote(q.venue, q.symbol_id, q.bid, q.bid_qty, q.ask, q.ask_qty, 0);
+    }
+
+    uint16_t symbol_id = 0;
+    bench::PerfScope perf(state);
+    for (auto _ : state) {
+        auto snap = book.get_snapshot(symbol_id);
+        benchmark::DoNotOptimize(snap);
+        symbol_id = static_cast<uint16_t>((symbol_id + 1) % NUM_SYMBOLS);
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_ConsolidatedRead)->Arg(2)->Arg(8);
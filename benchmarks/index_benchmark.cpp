@@ -0,0 +1,160 @@
+#include <benchmark/benchmark.h>
+#include "perf_counters.h"
+#include "common/index_engine.h"
+#include <algorithm>
+#include <numeric>
+#include <random>
+#include <vector>
+
+using namespace mdfh;
+
+namespace {
+
+constexpr size_t NUM_SYMBOLS = 2000;
+constexpr size_t NUM_TICKS = 1 << 14;
+
+// Free-float market cap indices, each over a random subset of the universe,
+// so popular symbols end up in hundreds of indices
+std::vector<IndexDefinition> make_indices(size_t num_indices, size_t constituents) {
+    std::mt19937 rng(42);
+    std::uniform_real_distribution<double> shares(1e6, 1e9);
+    std::uniform_real_distribution<double> free_float(0.2, 1.0);
+    std::vector<SymbolId> universe(NUM_SYMBOLS);
+    std::iota(universe.begin(), universe.end(), 0);
+
+    std::vector<IndexDefinition> defs(num_indices);
+    for (size_t i = 0; i < num_indices; ++i) {
+        std::shuffle(universe.begin(), universe.end(), rng);
+        defs[i] = {"IDX" + std::to_string(i), IndexWeighting::FREE_FLOAT_MARKET_CAP, 1000.0, {}};
+        for (size_t c = 0; c < constituents; ++c) {
+            defs[i].constituents.push_back({universe[c], shares(rng), free_float(rng)});
+        }
+    }
+    return defs;
+}
+
+struct Tick {
+    SymbolId symbol_id;
+    double price;
+};
+
+// Random walk ticks over the whole universe
+std::vector<Tick> make_ticks() {
+    std::mt19937 rng(7);
+    std::uniform_int_distribution<int> symbol(0, NUM_SYMBOLS - 1);
+    std::uniform_int_distribution<int> move(-5, 5);
+    std::vector<double> prices(NUM_SYMBOLS);
+    for (size_t s = 0; s < NUM_SYMBOLS; ++s) prices[s] = 100.0 + s;
+
+    std::vector<Tick> ticks(NUM_TICKS);
+    for (auto& t : ticks) {
+        t.symbol_id = static_cast<SymbolId>(symbol(rng));
+        prices[t.symbol_id] = std::max(1.0, prices[t.symbol_id] + move(rng) * 0.05);
+        t.price = prices[t.symbol_id];
+    }
+    return ticks;
+}
+
+void price_all(IndexEngine& engine) {
+    for (size_t s = 0; s < NUM_SYMBOLS; ++s) {
+        engine.update_price(static_cast<SymbolId>(s), 100.0 + s);
+    }
+}
+
+} // namespace
+
+// Benchmark: Incremental update of every index containing the ticked symbol
+// (args: indices, constituents per index)
+static void BM_IndexIncrementalUpdate(benchmark::State& state) {
+    size_t num_indices = static_cast<size_t>(state.range(0));
+    auto defs = make_indices(num_indices, static_cast<size_t>(state.range(1)));
+    auto ticks = make_ticks();
+    IndexEngine engine(NUM_SYMBOLS, defs);
+    price_all(engine);
+    uint64_t adjustments = engine.get_stats().index_updates;
+
+    size_t i = 0;
+    bench::PerfScope perf(state);
+    for (auto _ : state) {
+        const auto& t = ticks[i++ & (NUM_TICKS - 1)];
+        engine.update_price(t.symbol_id, t.price);
+        benchmark::ClobberMemory();
+    }
+
+    auto stats = engine.get_stats();
+    state.SetItemsProcessed(state.iterations());
+    state.counters["fanout"] = benchmark::Counter(
+        static_cast<double>(stats.index_updates - adjustments) / std::max<uint64_t>(1, state.iterations()));
+    state.counters["max_drift"] = stats.max_drift;
+}
+BENCHMARK(BM_IndexIncrementalUpdate)->Args({100, 500})->Args({1000, 50})->Args({1000, 500});
+
+// Benchmark: Baseline that re-sums every index containing the ticked symbol
+// from all its constituents' prices (what the incremental update avoids)
+static void BM_IndexFullRecompute(benchmark::State& state) {
+    size_t num_indices = static_cast<size_t>(state.range(0));
+    auto defs = make_indices(num_indices, static_cast<size_t>(state.range(1)));
+    auto ticks = make_ticks();
+
+    // Same CSR rows the engine builds, plus flat per-index term arrays
+    std::vector<std::vector<uint32_t>> rows(NUM_SYMBOLS);
+    std::vector<std::vector<std::pair<uint16_t, double>>> terms(num_indices);
+    for (size_t i = 0; i < num_indices; ++i) {
+        for (const auto& c : defs[i].constituents) {
+            rows[c.symbol_id].push_back(static_cast<uint32_t>(i));
+            terms[i].emplace_back(c.symbol_id, c.shares * c.free_float);
+        }
+    }
+    std::vector<double> prices(NUM_SYMBOLS);
+    for (size_t s = 0; s < NUM_SYMBOLS; ++s) prices[s] = 100.0 + s;
+    std::vector<double> sums(num_indices);
+
+    size_t i = 0;
+    bench::PerfScope perf(state);
+    for (auto _ : state) {
+        const auto& t = ticks[i++ & (NUM_TICKS - 1)];
+        prices[t.symbol_id] = t.price;
+        for (uint32_t index : rows[t.symbol_id]) {
+            double sum = 0.0;
+            for (const auto& term : terms[index]) sum += term.second * prices[term.first];
+            sums[index] = sum;
+        }
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_IndexFullRecompute)->Args({100, 500})->Args({1000, 50})->Args({1000, 500});
+
+// Benchmark: Index value read (seqlock snapshot)
+static void BM_IndexRead(benchmark::State& state) {
+    size_t num_indices = 1000;
+    IndexEngine engine(NUM_SYMBOLS, make_indices(num_indices, 500));
+    price_all(engine);
+
+    size_t index = 0;
+    bench::PerfScope perf(state);
+    for (auto _ : state) {
+        auto snap = engine.get_snapshot(index);
+        benchmark::DoNotOptimize(snap);
+        index = (index + 1) % num_indices;
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_IndexRead);
+
+// Benchmark: Recomputing all 1k x 500 indices at once (resync_all)
+static void BM_IndexResyncAll(benchmark::State& state) {
+    IndexEngine engine(NUM_SYMBOLS, make_indices(1000, 500));
+    price_all(engine);
+
+    bench::PerfScope perf(state);
+    for (auto _ : state) {
+        engine.resync_all();
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_IndexResyncAll)->Unit(benchmark::kMicrosecond);
@@ -1,5 +1,7 @@
 #include <benchmark/benchmark.h>
+#include "perf_counters.h"
 #include "common/latency_tracker.h"
+#include "common/outlier_recorder.h"
 #include <random>
 #include <thread>
 
@@ -9,6 +11,7 @@ using namespace mdfh;
 static void BM_RecordLatency(benchmark::State& state) {
     LatencyTracker tracker;
     
+    bench::PerfScope perf(state);
     for (auto _ : state) {
         tracker.record(15000);  // 15 microseconds
         benchmark::ClobberMemory();
@@ -26,6 +29,7 @@ static void BM_RecordLatencyBatch(benchmark::State& state) {
     std::mt19937 rng(42);
     std::normal_distribution<double> dist(15000, 5000);  // mean 15us, stddev 5us
     
+    bench::PerfScope perf(state);
     for (auto _ : state) {
         for (int i = 0; i < batch_size; ++i) {
             uint64_t latency = std::max(0.0, dist(rng));
@@ -50,6 +54,7 @@ static void BM_GetStatistics(benchmark::State& state) {
         tracker.record(latency);
     }
     
+    bench::PerfScope perf(state);
     for (auto _ : state) {
         LatencyStats stats = tracker.get_stats();
         benchmark::DoNotOptimize(stats);
@@ -63,9 +68,10 @@ BENCHMARK(BM_GetStatistics);
 static void BM_RecordLatencyConcurrent(benchmark::State& state) {
     static LatencyTracker tracker;
     
-    std::mt19937 rng(42 + state.thread_index);
+    std::mt19937 rng(42 + state.thread_index());
     std::normal_distribution<double> dist(15000, 5000);
     
+    bench::PerfScope perf(state);
     for (auto _ : state) {
         uint64_t latency = std::max(0.0, dist(rng));
         tracker.record(latency);
@@ -84,6 +90,7 @@ static void BM_PercentileCalculation(benchmark::State& state) {
         tracker.record(i * 100);  // 0, 100, 200, ... nanoseconds
     }
     
+    bench::PerfScope perf(state);
     for (auto _ : state) {
         LatencyStats stats = tracker.get_stats();
         benchmark::DoNotOptimize(stats.p50);
@@ -108,6 +115,7 @@ static void BM_ExportHistogram(benchmark::State& state) {
         tracker.record(latency);
     }
     
+    bench::PerfScope perf(state);
     for (auto _ : state) {
         bool success = tracker.export_to_csv("/tmp/benchmark_histogram.csv");
         benchmark::DoNotOptimize(success);
@@ -126,6 +134,7 @@ static void BM_RingBufferWraparound(benchmark::State& state) {
         tracker.record(15000 + (i % 1000));
     }
     
+    bench::PerfScope perf(state);
     for (auto _ : state) {
         tracker.record(15000);
         benchmark::ClobberMemory();
@@ -139,6 +148,7 @@ BENCHMARK(BM_RingBufferWraparound);
 static void BM_Reset(benchmark::State& state) {
     LatencyTracker tracker;
     
+    bench::PerfScope perf(state);
     for (auto _ : state) {
         state.PauseTiming();
         // Fill with data
@@ -155,4 +165,52 @@ static void BM_Reset(benchmark::State& state) {
 }
 BENCHMARK(BM_Reset);
 
+// Benchmark: Outlier threshold check (the per-message hot-path cost)
+static void BM_OutlierCheck(benchmark::State& state) {
+    OutlierRecorder recorder;
+    uint64_t latency = 15000;
+    
+    bench::PerfScope perf(state);
+    for (auto _ : state) {
+        bool outlier = recorder.is_outlier(latency, latency / 4);
+        benchmark::DoNotOptimize(outlier);
+        latency ^= 1;
+    }
+    
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_OutlierCheck);
+
+// Benchmark: Outlier capture (slow path, taken only for tail messages)
+static void BM_OutlierCapture(benchmark::State& state) {
+    OutlierRecorder recorder;
+    OutlierRecord record{};
+    record.end_to_end_ns = 2000000;
+    
+    bench::PerfScope perf(state);
+    for (auto _ : state) {
+        record.seq_num++;
+        recorder.capture(record);
+    }
+    
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_OutlierCapture);
+
+// Benchmark: Concurrent outlier capture
+static void BM_OutlierCaptureConcurrent(benchmark::State& state) {
+    static OutlierRecorder recorder;
+    OutlierRecord record{};
+    record.symbol_id = static_cast<uint16_t>(state.thread_index());
+    
+    bench::PerfScope perf(state);
+    for (auto _ : state) {
+        record.seq_num++;
+        recorder.capture(record);
+    }
+    
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_OutlierCaptureConcurrent)->Threads(2)->Threads(4);
+
 BENCHMARK_MAIN();
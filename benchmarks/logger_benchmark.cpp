@@ -0,0 +1,116 @@
+#include <benchmark/benchmark.h>
+#include "perf_counters.h"
+#include "common/logger.h"
+#include <cstdio>
+#include <sstream>
+
+using namespace mdfh;
+
+// Route logger output to /dev/null so the background thread's I/O
+// does not dominate the terminal; only the producer side is measured.
+static void SetupNullOutput() {
+    static FILE* null_out = std::fopen("/dev/null", "w");
+    Logger::instance().set_output(null_out);
+}
+
+// Benchmark: Hot-thread cost of a log call with integer arguments
+static void BM_LogCallInts(benchmark::State& state) {
+    SetupNullOutput();
+    int64_t i = 0;
+
+    bench::PerfScope perf(state);
+    for (auto _ : state) {
+        MDFH_LOG_INFO("Slow consumer detected on fd {} seq {}", 7, i++);
+    }
+
+    state.SetItemsProcessed(state.iterations());
+    state.counters["dropped"] = static_cast<double>(Logger::instance().get_records_dropped());
+}
+BENCHMARK(BM_LogCallInts);
+
+// Benchmark: Log call with string and double arguments
+static void BM_LogCallMixed(benchmark::State& state) {
+    SetupNullOutput();
+    double price = 2450.25;
+
+    bench::PerfScope perf(state);
+    for (auto _ : state) {
+        MDFH_LOG_INFO("Symbol {} price {} qty {}", "RELIANCE", price, 1000);
+        price += 0.05;
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_LogCallMixed);
+
+// Benchmark: Deduplicated call (identical arguments, folded at the call site)
+static void BM_LogCallDeduplicated(benchmark::State& state) {
+    SetupNullOutput();
+
+    bench::PerfScope perf(state);
+    for (auto _ : state) {
+        MDFH_LOG_WARN("Slow consumer detected on fd {}", 7);
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_LogCallDeduplicated);
+
+// Benchmark: Rate-limited call site
+static void BM_LogCallRateLimited(benchmark::State& state) {
+    SetupNullOutput();
+    int64_t i = 0;
+
+    bench::PerfScope perf(state);
+    for (auto _ : state) {
+        MDFH_LOG_WARN_RL(10, "Slow consumer detected on fd {} seq {}", 7, i++);
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_LogCallRateLimited);
+
+// Benchmark: Disabled level (cost of the level check only)
+static void BM_LogCallDisabled(benchmark::State& state) {
+    bench::PerfScope perf(state);
+    for (auto _ : state) {
+        MDFH_LOG_DEBUG("Disabled {}", 1);
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_LogCallDisabled);
+
+// Baseline: synchronous ostream formatting (what std::cerr logging costs
+// before any write syscall)
+static void BM_OstreamFormatBaseline(benchmark::State& state) {
+    int64_t i = 0;
+
+    bench::PerfScope perf(state);
+    for (auto _ : state) {
+        std::ostringstream oss;
+        oss << "Slow consumer detected on fd " << 7 << " seq " << i++ << std::endl;
+        benchmark::DoNotOptimize(oss);
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_OstreamFormatBaseline);
+
+// Baseline: synchronous unbuffered write to /dev/null (std::cerr equivalent)
+static void BM_SyncWriteBaseline(benchmark::State& state) {
+    FILE* null_out = std::fopen("/dev/null", "w");
+    setvbuf(null_out, nullptr, _IONBF, 0);
+    int64_t i = 0;
+
+    bench::PerfScope perf(state);
+    for (auto _ : state) {
+        std::fprintf(null_out, "Slow consumer detected on fd %d seq %ld\n", 7, static_cast<long>(i++));
+    }
+
+    std::fclose(null_out);
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_SyncWriteBaseline);
+
+BENCHMARK_MAIN();
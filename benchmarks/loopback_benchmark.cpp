@@ -0,0 +1,593 @@
+// Loopback TCP end-to-end benchmark suite.
+//
+// Runs an ExchangeSimulator and one or more FeedHandlers in one process over
+// 127.0.0.1, sweeps tick rate / symbol count / client count / subscription
+// density, and ramps the tick rate to find the maximum sustainable rate
+// (no loss and p99 end-to-end latency within the SLO). Results are printed
+// as a table and written as JSON for tracking capacity across releases.
+//
+// With --scenario=FILE it instead plays a market scenario timeline (see
+// server/scenario.h) once over Poisson arrivals at --scenario-rate, and
+// reports per 100ms window what was generated and received, gaps,
+// backpressure and end-to-end latency, to show how the feed handler rides
+// out bursts.
+//
+// Run from the repository root (the simulator reads config/server.conf and
+// config/symbols.csv):
+//   ./build/benchmark/loopback_benchmark [--duration=2] [--slo-p99-us=5000]
+//       [--max-rate=2000000] [--out=loopback_results.json] [--quick]
+//   ./build/benchmark/loopback_benchmark --scenario=config/opening_burst.csv
+//       [--scenario-rate=20000] [--out=scenario_results.json]
+
+#include "server/exchange_simulator.h"
+#include "server/scenario.h"
+#include "client/feed_handler.h"
+#include "common/logger.h"
+#include "common/tsc_clock.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <memory>
+#include <numeric>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace mdfh;
+
+namespace {
+
+struct BenchOptions {
+    uint32_t duration_s = 2;
+    uint64_t slo_p99_ns = 5000000;
+    uint32_t max_rate = 2000000;
+    std::string out_file = "loopback_results.json";
+    bool quick = false;
+    std::string scenario_file;          // Scenario mode when set
+    uint32_t scenario_rate = 20000;     // Base tick rate the scenario multiplies
+};
+
+struct RunConfig {
+    uint32_t tick_rate;
+    size_t num_symbols;
+    size_t num_clients;
+    double subscription_density;   // Fraction of symbols each client subscribes to
+};
+
+struct RunResult {
+    RunConfig config;
+    bool ok = false;                // Setup succeeded
+    double duration_s = 0.0;
+    ServerStats server{};
+    uint64_t messages_received = 0;
+    uint64_t messages_lost = 0;     // Sent by the server but never received
+    uint64_t sequence_gaps = 0;
+    double generated_per_sec = 0.0;
+    double received_per_sec = 0.0;
+    LatencyStats latency{};         // Worst client per percentile
+    bool sustainable = false;
+};
+
+uint16_t g_next_port = 19876;
+
+std::vector<SymbolId> pick_subscription(size_t num_symbols, double density, size_t client_index) {
+    std::vector<SymbolId> ids(num_symbols);
+    std::iota(ids.begin(), ids.end(), 0);
+    std::mt19937 rng(static_cast<uint32_t>(client_index + 1));
+    std::shuffle(ids.begin(), ids.end(), rng);
+
+    size_t count = static_cast<size_t>(density * num_symbols + 0.5);
+    ids.resize(std::max<size_t>(1, std::min(count, num_symbols)));
+    return ids;
+}
+
+template<typename Pred>
+bool wait_for(Pred pred, int timeout_ms) {
+    for (int waited = 0; waited < timeout_ms; waited += 10) {
+        if (pred()) {
+            return true;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    return pred();
+}
+
+ServerStats diff(const ServerStats& a, const ServerStats& b) {
+    ServerStats d;
+    d.messages_generated = a.messages_generated - b.messages_generated;
+    d.messages_sent = a.messages_sent - b.messages_sent;
+    d.bytes_sent = a.bytes_sent - b.bytes_sent;
+    d.send_failures = a.send_failures - b.send_failures;
+    d.slow_consumer_events = a.slow_consumer_events - b.slow_consumer_events;
+    d.partial_sends = a.partial_sends - b.partial_sends;
+    d.log_overruns = a.log_overruns - b.log_overruns;
+    return d;
+}
+
+RunResult run_once(const RunConfig& cfg, const BenchOptions& opts) {
+    RunResult result;
+    result.config = cfg;
+    uint16_t port = g_next_port++;
+
+    std::unique_ptr<ExchangeSimulator> sim;
+    try {
+        sim = std::make_unique<ExchangeSimulator>(port, cfg.num_symbols);
+        sim->set_tick_rate(0);  // Hold ticks until every client has subscribed
+        sim->start();
+    } catch (const std::exception& e) {
+        std::fprintf(stderr, "Failed to start simulator: %s\n", e.what());
+        return result;
+    }
+    std::thread event_loop([&sim] { sim->run(); });
+
+    std::vector<std::unique_ptr<FeedHandler>> handlers;
+    for (size_t c = 0; c < cfg.num_clients; ++c) {
+        auto handler = std::make_unique<FeedHandler>("127.0.0.1", port, cfg.num_symbols);
+        handler->get_outlier_recorder().set_thresholds(0, 0);
+        if (handler->start()) {
+            handler->subscribe(pick_subscription(cfg.num_symbols, cfg.subscription_density, c));
+            handlers.push_back(std::move(handler));
+        }
+    }
+
+    bool connected = handlers.size() == cfg.num_clients &&
+        wait_for([&] { return sim->get_client_count() == cfg.num_clients; }, 2000);
+    // Let the event loop apply the subscriptions
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+
+    if (connected) {
+        ServerStats base = sim->get_stats();
+        auto start = std::chrono::steady_clock::now();
+
+        // The generator emits one batch per second; stop it half-way through
+        // the last second so exactly duration_s batches are produced
+        sim->set_tick_rate(cfg.tick_rate);
+        std::this_thread::sleep_for(std::chrono::milliseconds(opts.duration_s * 1000 - 500));
+        sim->set_tick_rate(0);
+
+        // Drain: wait until clients stop receiving
+        auto total_received = [&] {
+            uint64_t total = 0;
+            for (const auto& h : handlers) {
+                total += h->get_messages_received();
+            }
+            return total;
+        };
+        uint64_t last = total_received();
+        int stable_ms = 0;
+        for (int waited = 0; waited < 5000 && stable_ms < 200; waited += 50) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(50));
+            uint64_t now = total_received();
+            stable_ms = (now == last) ? stable_ms + 50 : 0;
+            last = now;
+        }
+        auto elapsed = std::chrono::steady_clock::now() - start;
+
+        result.ok = true;
+        result.server = diff(sim->get_stats(), base);
+        result.messages_received = last;
+        result.messages_lost = result.server.messages_sent > last ? result.server.messages_sent - last : 0;
+        result.duration_s = std::max<double>(
+            opts.duration_s, std::chrono::duration<double>(elapsed).count() - 0.5);
+        result.generated_per_sec = result.server.messages_generated / static_cast<double>(opts.duration_s);
+        result.received_per_sec = result.messages_received / static_cast<double>(opts.duration_s);
+
+        for (const auto& h : handlers) {
+            result.sequence_gaps += h->get_stats().sequence_gaps;
+            LatencyStats s = h->get_end_to_end_latency_stats();
+            result.latency.p50 = std::max(result.latency.p50, s.p50);
+            result.latency.p95 = std::max(result.latency.p95, s.p95);
+            result.latency.p99 = std::max(result.latency.p99, s.p99);
+            result.latency.p999 = std::max(result.latency.p999, s.p999);
+            result.latency.max = std::max(result.latency.max, s.max);
+            result.latency.sample_count += s.sample_count;
+        }
+
+        // The generator rounds the rate down to whole ticks per symbol
+        uint64_t per_symbol = std::max<uint64_t>(1, cfg.tick_rate / cfg.num_symbols);
+        uint64_t expected_generated = per_symbol * cfg.num_symbols * opts.duration_s;
+
+        // Partial sends are only backpressure now: the remainder stays queued
+        result.sustainable = result.server.send_failures == 0 &&
+                             result.server.log_overruns == 0 &&
+                             result.messages_lost == 0 &&
+                             result.sequence_gaps == 0 &&
+                             result.server.messages_generated >= expected_generated &&
+                             result.latency.p99 <= opts.slo_p99_ns;
+    } else {
+        std::fprintf(stderr, "Clients failed to connect on port %u\n", port);
+    }
+
+    for (auto& h : handlers) {
+        h->stop();
+    }
+    sim->stop();
+    event_loop.join();
+    return result;
+}
+
+void print_header() {
+    std::printf("%10s %8s %8s %8s %12s %12s %8s %8s %8s %10s %10s %10s %5s\n",
+                "rate", "symbols", "clients", "density", "gen/s", "recv/s", "drops",
+                "slow", "gaps", "p50(us)", "p99(us)", "p999(us)", "ok");
+}
+
+void print_result(const RunResult& r) {
+    if (!r.ok) {
+        std::printf("%10u %8zu %8zu %8.2f   (setup failed)\n", r.config.tick_rate,
+                    r.config.num_symbols, r.config.num_clients, r.config.subscription_density);
+        return;
+    }
+    std::printf("%10u %8zu %8zu %8.2f %12.0f %12.0f %8llu %8llu %8llu %10.1f %10.1f %10.1f %5s\n",
+                r.config.tick_rate, r.config.num_symbols, r.config.num_clients,
+                r.config.subscription_density, r.generated_per_sec, r.received_per_sec,
+                static_cast<unsigned long long>(r.server.send_failures + r.messages_lost),
+                static_cast<unsigned long long>(r.server.slow_consumer_events),
+                static_cast<unsigned long long>(r.sequence_gaps),
+                r.latency.p50 / 1000.0, r.latency.p99 / 1000.0, r.latency.p999 / 1000.0,
+                r.sustainable ? "yes" : "no");
+    std::fflush(stdout);
+}
+
+void write_run_json(FILE* out, const RunResult& r, const char* indent) {
+    std::fprintf(out,
+        "%s{\"tick_rate\": %u, \"num_symbols\": %zu, \"num_clients\": %zu, "
+        "\"subscription_density\": %.3f, \"ok\": %s, \"duration_s\": %.3f,\n"
+        "%s \"messages_generated\": %llu, \"messages_sent\": %llu, \"messages_received\": %llu, "
+        "\"generated_per_sec\": %.1f, \"received_per_sec\": %.1f,\n"
+        "%s \"send_failures\": %llu, \"slow_consumer_events\": %llu, \"partial_sends\": %llu, "
+        "\"log_overruns\": %llu, \"messages_lost\": %llu, \"sequence_gaps\": %llu,\n"
+        "%s \"latency_ns\": {\"p50\": %llu, \"p95\": %llu, \"p99\": %llu, \"p999\": %llu, "
+        "\"max\": %llu, \"samples\": %llu},\n"
+        "%s \"sustainable\": %s}",
+        indent, r.config.tick_rate, r.config.num_symbols, r.config.num_clients,
+        r.config.subscription_density, r.ok ? "true" : "false", r.duration_s,
+        indent,
+        static_cast<unsigned long long>(r.server.messages_generated),
+        static_cast<unsigned long long>(r.server.messages_sent),
+        static_cast<unsigned long long>(r.messages_received),
+        r.generated_per_sec, r.received_per_sec,
+        indent,
+        static_cast<unsigned long long>(r.server.send_failures),
+        static_cast<unsigned long long>(r.server.slow_consumer_events),
+        static_cast<unsigned long long>(r.server.partial_sends),
+        static_cast<unsigned long long>(r.server.log_overruns),
+        static_cast<unsigned long long>(r.messages_lost),
+        static_cast<unsigned long long>(r.sequence_gaps),
+        indent,
+        static_cast<unsigned long long>(r.latency.p50),
+        static_cast<unsigned long long>(r.latency.p95),
+        static_cast<unsigned long long>(r.latency.p99),
+        static_cast<unsigned long long>(r.latency.p999),
+        static_cast<unsigned long long>(r.latency.max),
+        static_cast<unsigned long long>(r.latency.sample_count),
+        indent, r.sustainable ? "true" : "false");
+}
+
+void write_runs_json(FILE* out, const std::vector<RunResult>& runs, const char* indent) {
+    std::fprintf(out, "[\n");
+    for (size_t i = 0; i < runs.size(); ++i) {
+        write_run_json(out, runs[i], indent);
+        std::fprintf(out, "%s\n", i + 1 < runs.size() ? "," : "");
+    }
+}
+
+struct Sweep {
+    const char* name;
+    std::vector<RunConfig> configs;
+    std::vector<RunResult> results;
+};
+
+struct CapacitySearch {
+    RunConfig base;
+    uint32_t max_sustainable_rate = 0;
+    std::vector<RunResult> steps;
+};
+
+// Double the rate until loss or an SLO breach, then bisect between the
+// last passing and first failing rate
+void find_max_rate(CapacitySearch& search, const BenchOptions& opts, uint32_t start_rate) {
+    constexpr int REFINE_STEPS = 3;
+    uint32_t last_ok = 0;
+    uint32_t first_fail = 0;
+
+    for (uint32_t rate = start_rate; rate <= opts.max_rate; rate *= 2) {
+        RunConfig cfg = search.base;
+        cfg.tick_rate = rate;
+        search.steps.push_back(run_once(cfg, opts));
+        print_result(search.steps.back());
+        if (search.steps.back().sustainable) {
+            last_ok = rate;
+        } else {
+            first_fail = rate;
+            break;
+        }
+    }
+
+    for (int i = 0; i < REFINE_STEPS && first_fail != 0 && first_fail - last_ok > first_fail / 20; ++i) {
+        uint32_t rate = last_ok + (first_fail - last_ok) / 2;
+        RunConfig cfg = search.base;
+        cfg.tick_rate = rate;
+        search.steps.push_back(run_once(cfg, opts));
+        print_result(search.steps.back());
+        if (search.steps.back().sustainable) {
+            last_ok = rate;
+        } else {
+            first_fail = rate;
+        }
+    }
+
+    search.max_sustainable_rate = last_ok;
+}
+
+constexpr size_t SCENARIO_SYMBOLS = 100;
+constexpr uint32_t SCENARIO_WINDOW_MS = 100;
+constexpr uint32_t SCENARIO_TAIL_MS = 1000;    // Observed after the last event
+
+struct ScenarioWindow {
+    uint64_t generated = 0;
+    uint64_t received = 0;
+    uint64_t sequence_gaps = 0;
+    uint64_t partial_sends = 0;         // Sends cut short by a full socket buffer
+    uint64_t slow_consumer_events = 0;
+    LatencyStats latency{};             // Quotes received in the window
+};
+
+// One client subscribed to every symbol; Zipf rates so bursts land on hot
+// symbols the way they do in production
+bool run_scenario(const BenchOptions& opts, std::vector<ScenarioWindow>& windows) {
+    uint64_t duration_ms;
+    try {
+        duration_ms = Scenario::load(opts.scenario_file, SCENARIO_SYMBOLS).get_duration_us() / 1000 +
+                      SCENARIO_TAIL_MS;
+    } catch (const std::exception& e) {
+        std::fprintf(stderr, "%s\n", e.what());
+        return false;
+    }
+    size_t num_windows = (duration_ms + SCENARIO_WINDOW_MS - 1) / SCENARIO_WINDOW_MS;
+    uint16_t port = g_next_port++;
+
+    std::unique_ptr<ExchangeSimulator> sim;
+    try {
+        sim = std::make_unique<ExchangeSimulator>(port, SCENARIO_SYMBOLS);
+        sim->set_tick_rate(0);  // The scenario clock starts with the first tick
+        sim->enable_poisson_arrivals(1.0);
+        sim->set_scenario_file(opts.scenario_file);
+        sim->start();
+    } catch (const std::exception& e) {
+        std::fprintf(stderr, "Failed to start simulator: %s\n", e.what());
+        return false;
+    }
+    std::thread event_loop([&sim] { sim->run(); });
+
+    std::vector<std::unique_ptr<LatencyTracker>> trackers;
+    for (size_t w = 0; w <= num_windows; ++w) {
+        trackers.push_back(std::make_unique<LatencyTracker>(1 << 14));
+    }
+    std::atomic<size_t> window{0};
+    FeedHandler handler("127.0.0.1", port, SCENARIO_SYMBOLS);
+    handler.get_outlier_recorder().set_thresholds(0, 0);
+    handler.set_quote_callback([&](const QuoteMessage& quote) {
+        uint64_t now = TscClock::now_wall_ns();
+        trackers[window.load(std::memory_order_relaxed)]->record(
+            now > quote.header.timestamp ? now - quote.header.timestamp : 0);
+    });
+
+    bool connected = handler.start();
+    if (connected) {
+        std::vector<SymbolId> symbols(SCENARIO_SYMBOLS);
+        std::iota(symbols.begin(), symbols.end(), 0);
+        handler.subscribe(symbols);
+        connected = wait_for([&] { return sim->get_client_count() == 1; }, 2000);
+        std::this_thread::sleep_for(std::chrono::milliseconds(200));
+    }
+
+    if (connected) {
+        ServerStats last_server = sim->get_stats();
+        uint64_t last_received = handler.get_messages_received();
+        uint64_t last_gaps = handler.get_stats().sequence_gaps;
+
+        auto start = std::chrono::steady_clock::now();
+        sim->set_tick_rate(opts.scenario_rate);
+        for (size_t w = 0; w < num_windows; ++w) {
+            std::this_thread::sleep_until(start + std::chrono::milliseconds((w + 1) * SCENARIO_WINDOW_MS));
+            window.store(w + 1, std::memory_order_relaxed);
+
+            ServerStats server = sim->get_stats();
+            uint64_t received = handler.get_messages_received();
+            uint64_t gaps = handler.get_stats().sequence_gaps;
+            ScenarioWindow sample;
+            sample.generated = server.messages_generated - last_server.messages_generated;
+            sample.partial_sends = server.partial_sends - last_server.partial_sends;
+            sample.slow_consumer_events = server.slow_consumer_events - last_server.slow_consumer_events;
+            sample.received = received - last_received;
+            sample.sequence_gaps = gaps - last_gaps;
+            sample.latency = trackers[w]->get_stats();
+            windows.push_back(sample);
+            last_server = server;
+            last_received = received;
+            last_gaps = gaps;
+        }
+        sim->set_tick_rate(0);
+    } else {
+        std::fprintf(stderr, "Client failed to connect on port %u\n", port);
+    }
+
+    handler.stop();
+    sim->stop();
+    event_loop.join();
+    return connected;
+}
+
+int run_scenario_mode(const BenchOptions& opts) {
+    std::printf("\n=== Scenario: %s at base rate %u msgs/s, %zu symbols (Zipf), %u ms windows ===\n",
+                opts.scenario_file.c_str(), opts.scenario_rate, SCENARIO_SYMBOLS, SCENARIO_WINDOW_MS);
+    std::vector<ScenarioWindow> windows;
+    if (!run_scenario(opts, windows)) {
+        return 1;
+    }
+
+    std::printf("%8s %12s %12s %8s %8s %8s %10s %10s %10s\n", "t(ms)", "gen/s", "recv/s",
+                "gaps", "partial", "slow", "p50(us)", "p99(us)", "max(us)");
+    double per_sec = 1000.0 / SCENARIO_WINDOW_MS;
+    for (size_t w = 0; w < windows.size(); ++w) {
+        const auto& s = windows[w];
+        std::printf("%8zu %12.0f %12.0f %8llu %8llu %8llu %10.1f %10.1f %10.1f\n",
+                    w * SCENARIO_WINDOW_MS, s.generated * per_sec, s.received * per_sec,
+                    static_cast<unsigned long long>(s.sequence_gaps),
+                    static_cast<unsigned long long>(s.partial_sends),
+                    static_cast<unsigned long long>(s.slow_consumer_events),
+                    s.latency.p50 / 1000.0, s.latency.p99 / 1000.0, s.latency.max / 1000.0);
+    }
+
+    FILE* out = std::fopen(opts.out_file.c_str(), "w");
+    if (!out) {
+        std::fprintf(stderr, "Failed to open %s\n", opts.out_file.c_str());
+        return 1;
+    }
+    std::fprintf(out, "{\n  \"benchmark\": \"loopback_scenario\",\n  \"timestamp\": %lld,\n"
+                 "  \"scenario\": \"%s\",\n  \"base_rate\": %u,\n  \"num_symbols\": %zu,\n"
+                 "  \"window_ms\": %u,\n  \"windows\": [\n",
+                 static_cast<long long>(std::time(nullptr)), opts.scenario_file.c_str(),
+                 opts.scenario_rate, SCENARIO_SYMBOLS, SCENARIO_WINDOW_MS);
+    for (size_t w = 0; w < windows.size(); ++w) {
+        const auto& s = windows[w];
+        std::fprintf(out, "    {\"t_ms\": %zu, \"generated\": %llu, \"received\": %llu, "
+                     "\"sequence_gaps\": %llu, \"partial_sends\": %llu, \"slow_consumer_events\": %llu,\n"
+                     "     \"latency_ns\": {\"p50\": %llu, \"p99\": %llu, \"p999\": %llu, "
+                     "\"max\": %llu, \"samples\": %llu}}%s\n",
+                     w * SCENARIO_WINDOW_MS,
+                     static_cast<unsigned long long>(s.generated),
+                     static_cast<unsigned long long>(s.received),
+                     static_cast<unsigned long long>(s.sequence_gaps),
+                     static_cast<unsigned long long>(s.partial_sends),
+                     static_cast<unsigned long long>(s.slow_consumer_events),
+                     static_cast<unsigned long long>(s.latency.p50),
+                     static_cast<unsigned long long>(s.latency.p99),
+                     static_cast<unsigned long long>(s.latency.p999),
+                     static_cast<unsigned long long>(s.latency.max),
+                     static_cast<unsigned long long>(s.latency.sample_count),
+                     w + 1 < windows.size() ? "," : "");
+    }
+    std::fprintf(out, "  ]\n}\n");
+    std::fclose(out);
+
+    std::printf("\nResults written to %s\n", opts.out_file.c_str());
+    return 0;
+}
+
+bool parse_options(int argc, char* argv[], BenchOptions& opts) {
+    for (int i = 1; i < argc; ++i) {
+        const char* arg = argv[i];
+        if (std::strncmp(arg, "--duration=", 11) == 0) {
+            opts.duration_s = std::max(1, std::atoi(arg + 11));
+        } else if (std::strncmp(arg, "--slo-p99-us=", 13) == 0) {
+            opts.slo_p99_ns = static_cast<uint64_t>(std::atoll(arg + 13)) * 1000;
+        } else if (std::strncmp(arg, "--max-rate=", 11) == 0) {
+            opts.max_rate = static_cast<uint32_t>(std::atoll(arg + 11));
+        } else if (std::strncmp(arg, "--out=", 6) == 0) {
+            opts.out_file = arg + 6;
+        } else if (std::strcmp(arg, "--quick") == 0) {
+            opts.quick = true;
+        } else if (std::strncmp(arg, "--scenario=", 11) == 0) {
+            opts.scenario_file = arg + 11;
+        } else if (std::strncmp(arg, "--scenario-rate=", 16) == 0) {
+            opts.scenario_rate = static_cast<uint32_t>(std::max(1LL, std::atoll(arg + 16)));
+        } else {
+            std::fprintf(stderr, "Usage: %s [--duration=SEC] [--slo-p99-us=N] "
+                         "[--max-rate=N] [--out=FILE] [--quick]\n"
+                         "       %s --scenario=FILE [--scenario-rate=N] [--out=FILE]\n", argv[0], argv[0]);
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    BenchOptions opts;
+    if (!parse_options(argc, argv, opts)) {
+        return 1;
+    }
+
+    Logger::instance().set_level(LogLevel::WARN);
+    TscClock::start_calibration_thread();
+
+    if (!opts.scenario_file.empty()) {
+        return run_scenario_mode(opts);
+    }
+
+    std::vector<Sweep> sweeps;
+    if (opts.quick) {
+        sweeps.push_back({"tick_rate", {{10000, 100, 1, 1.0}, {100000, 100, 1, 1.0}}, {}});
+        sweeps.push_back({"clients", {{50000, 100, 4, 1.0}}, {}});
+    } else {
+        sweeps.push_back({"tick_rate", {{10000, 100, 1, 1.0}, {50000, 100, 1, 1.0},
+                                        {100000, 100, 1, 1.0}, {200000, 100, 1, 1.0}}, {}});
+        sweeps.push_back({"symbols", {{100000, 10, 1, 1.0}, {100000, 100, 1, 1.0},
+                                      {100000, 500, 1, 1.0}}, {}});
+        sweeps.push_back({"clients", {{50000, 100, 1, 1.0}, {50000, 100, 4, 1.0},
+                                      {50000, 100, 16, 1.0}}, {}});
+        sweeps.push_back({"subscription_density", {{100000, 100, 4, 0.1}, {100000, 100, 4, 0.5},
+                                                   {100000, 100, 4, 1.0}}, {}});
+    }
+
+    for (auto& sweep : sweeps) {
+        std::printf("\n=== Sweep: %s ===\n", sweep.name);
+        print_header();
+        for (const auto& cfg : sweep.configs) {
+            sweep.results.push_back(run_once(cfg, opts));
+            print_result(sweep.results.back());
+        }
+    }
+
+    std::vector<CapacitySearch> searches;
+    searches.push_back({{0, 100, 1, 1.0}, 0, {}});
+    if (!opts.quick) {
+        searches.push_back({{0, 100, 4, 1.0}, 0, {}});
+    }
+
+    for (auto& search : searches) {
+        std::printf("\n=== Max sustainable rate: %zu symbols, %zu client(s), p99 SLO %.0f us ===\n",
+                    search.base.num_symbols, search.base.num_clients, opts.slo_p99_ns / 1000.0);
+        print_header();
+        find_max_rate(search, opts, 25000);
+        std::printf("Max sustainable rate: %u msgs/s\n", search.max_sustainable_rate);
+    }
+
+    FILE* out = std::fopen(opts.out_file.c_str(), "w");
+    if (!out) {
+        std::fprintf(stderr, "Failed to open %s\n", opts.out_file.c_str());
+        return 1;
+    }
+
+    std::fprintf(out, "{\n  \"benchmark\": \"loopback\",\n  \"timestamp\": %lld,\n"
+                 "  \"duration_s\": %u,\n  \"slo_p99_ns\": %llu,\n  \"sweeps\": {\n",
+                 static_cast<long long>(std::time(nullptr)), opts.duration_s,
+                 static_cast<unsigned long long>(opts.slo_p99_ns));
+    for (size_t i = 0; i < sweeps.size(); ++i) {
+        std::fprintf(out, "    \"%s\": ", sweeps[i].name);
+        write_runs_json(out, sweeps[i].results, "      ");
+        std::fprintf(out, "    ]%s\n", i + 1 < sweeps.size() ? "," : "");
+    }
+    std::fprintf(out, "  },\n  \"max_sustainable\": [\n");
+    for (size_t i = 0; i < searches.size(); ++i) {
+        const auto& s = searches[i];
+        std::fprintf(out, "    {\"num_symbols\": %zu, \"num_clients\": %zu, "
+                     "\"subscription_density\": %.3f, \"max_rate\": %u,\n     \"steps\": ",
+                     s.base.num_symbols, s.base.num_clients, s.base.subscription_density,
+                     s.max_sustainable_rate);
+        write_runs_json(out, s.steps, "       ");
+        std::fprintf(out, "     ]}%s\n", i + 1 < searches.size() ? "," : "");
+    }
+    std::fprintf(out, "  ]\n}\n");
+    std::fclose(out);
+
+    std::printf("\nResults written to %s\n", opts.out_file.c_str());
+    return 0;
+}
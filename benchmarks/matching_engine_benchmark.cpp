@@ -0,0 +1,180 @@
+#include <benchmark/benchmark.h>
+#include "perf_counters.h"
+#include "server/order_book.h"
+#include "server/order_flow.h"
+#include <memory>
+#include <random>
+#include <vector>
+
+using namespace mdfh;
+
+namespace {
+
+constexpr uint32_t REFERENCE_TICK = 10000;
+constexpr size_t TAPE_EVENTS = 1 << 18;
+
+// Fill the book with passive depth so the flow starts from a two-sided market
+void seed_book(OrderBook& book, OrderFlowGenerator* flow, std::vector<Fill>& fills) {
+    for (uint32_t depth = 1; depth <= 10; ++depth) {
+        uint64_t bid = book.add_limit(Side::BUY, REFERENCE_TICK - depth, 1000, fills);
+        uint64_t ask = book.add_limit(Side::SELL, REFERENCE_TICK + depth, 1000, fills);
+        if (flow) {
+            flow->on_resting(bid);
+            flow->on_resting(ask);
+        }
+    }
+}
+
+// One recorded run of the agent flow (reference random-walking), replayable
+// against a fresh book: ids are deterministic, so recorded cancels hit the
+// same orders
+std::vector<OrderEvent> record_tape() {
+    OrderBook book(REFERENCE_TICK);
+    OrderFlowGenerator flow(OrderFlowConfig{}, 42);
+    std::vector<Fill> fills;
+    seed_book(book, &flow, fills);
+
+    std::mt19937 walk(7);
+    uint32_t reference = REFERENCE_TICK;
+    std::vector<OrderEvent> tape;
+    tape.reserve(TAPE_EVENTS);
+    for (size_t i = 0; i < TAPE_EVENTS; ++i) {
+        if (walk() % 8 == 0) {
+            reference += (walk() % 2) ? 1 : -1;
+        }
+        OrderEvent event = flow.next(reference);
+        fills.clear();
+        uint64_t id = 0;
+        if (event.type == OrderEvent::Type::LIMIT) {
+            id = book.add_limit(event.side, event.price_tick, event.quantity, fills);
+        } else if (event.type == OrderEvent::Type::MARKET) {
+            book.add_market(event.side, event.quantity, fills);
+        } else {
+            book.cancel(event.order_id);
+        }
+        for (const Fill& fill : fills) {
+            flow.on_fill(fill);
+        }
+        if (id != 0) {
+            flow.on_resting(id);
+        }
+        tape.push_back(event);
+    }
+    return tape;
+}
+
+} // namespace
+
+// Benchmark: Book only, replaying recorded agent flow (limit/market/cancel mix)
+static void BM_OrderBook_ReplayFlow(benchmark::State& state) {
+    static const std::vector<OrderEvent> tape = record_tape();
+    auto book = std::make_unique<OrderBook>(REFERENCE_TICK);
+    std::vector<Fill> fills;
+    fills.reserve(64);
+    seed_book(*book, nullptr, fills);
+
+    size_t i = 0;
+    uint64_t total_fills = 0;
+    bench::PerfScope perf(state);
+    for (auto _ : state) {
+        if (i == tape.size()) {
+            // Replay must restart from the state the tape was recorded on
+            state.PauseTiming();
+            book = std::make_unique<OrderBook>(REFERENCE_TICK);
+            seed_book(*book, nullptr, fills);
+            i = 0;
+            state.ResumeTiming();
+        }
+        const OrderEvent& event = tape[i++];
+        fills.clear();
+        if (event.type == OrderEvent::Type::LIMIT) {
+            benchmark::DoNotOptimize(book->add_limit(event.side, event.price_tick, event.quantity, fills));
+        } else if (event.type == OrderEvent::Type::MARKET) {
+            benchmark::DoNotOptimize(book->add_market(event.side, event.quantity, fills));
+        } else {
+            benchmark::DoNotOptimize(book->cancel(event.order_id));
+        }
+        total_fills += fills.size();
+    }
+
+    state.SetItemsProcessed(state.iterations());
+    state.counters["fills_per_order"] = benchmark::Counter(
+        static_cast<double>(total_fills) / static_cast<double>(state.iterations()));
+}
+BENCHMARK(BM_OrderBook_ReplayFlow);
+
+// Benchmark: Flow generation + book, as the simulator runs it per order event
+static void BM_OrderBook_AgentFlow(benchmark::State& state) {
+    OrderBook book(REFERENCE_TICK);
+    OrderFlowGenerator flow(OrderFlowConfig{}, 42);
+    std::vector<Fill> fills;
+    fills.reserve(64);
+    seed_book(book, &flow, fills);
+
+    std::mt19937 walk(7);
+    uint32_t reference = REFERENCE_TICK;
+    bench::PerfScope perf(state);
+    for (auto _ : state) {
+        if (walk() % 8 == 0) {
+            reference += (walk() % 2) ? 1 : -1;
+        }
+        OrderEvent event = flow.next(reference);
+        fills.clear();
+        uint64_t id = 0;
+        if (event.type == OrderEvent::Type::LIMIT) {
+            id = book.add_limit(event.side, event.price_tick, event.quantity, fills);
+        } else if (event.type == OrderEvent::Type::MARKET) {
+            book.add_market(event.side, event.quantity, fills);
+        } else {
+            book.cancel(event.order_id);
+        }
+        for (const Fill& fill : fills) {
+            flow.on_fill(fill);
+        }
+        if (id != 0) {
+            flow.on_resting(id);
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_OrderBook_AgentFlow);
+
+// Benchmark: Rest a passive order and cancel it (pool slot reuse, O(1) cancel)
+static void BM_OrderBook_AddCancel(benchmark::State& state) {
+    OrderBook book(REFERENCE_TICK);
+    std::vector<Fill> fills;
+    seed_book(book, nullptr, fills);
+
+    uint32_t depth = 1;
+    bench::PerfScope perf(state);
+    for (auto _ : state) {
+        uint64_t id = book.add_limit(Side::BUY, REFERENCE_TICK - depth, 100, fills);
+        benchmark::DoNotOptimize(book.cancel(id));
+        depth = depth == 10 ? 1 : depth + 1;
+    }
+
+    state.SetItemsProcessed(state.iterations() * 2);
+}
+BENCHMARK(BM_OrderBook_AddCancel);
+
+// Benchmark: Market order sweeping N price levels, then replenishing them
+static void BM_OrderBook_Sweep(benchmark::State& state) {
+    uint32_t levels = static_cast<uint32_t>(state.range(0));
+    OrderBook book(REFERENCE_TICK);
+    std::vector<Fill> fills;
+    fills.reserve(levels);
+
+    bench::PerfScope perf(state);
+    for (auto _ : state) {
+        for (uint32_t depth = 1; depth <= levels; ++depth) {
+            book.add_limit(Side::SELL, REFERENCE_TICK + depth, 100, fills);
+        }
+        fills.clear();
+        benchmark::DoNotOptimize(book.add_market(Side::BUY, levels * 100, fills));
+    }
+
+    // Orders in: the resting makers plus the sweeping market order
+    state.SetItemsProcessed(state.iterations() * (levels + 1));
+}
+BENCHMARK(BM_OrderBook_Sweep)->Arg(1)->Arg(10)->Arg(100);
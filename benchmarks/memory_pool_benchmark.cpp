@@ -1,4 +1,5 @@
 #include <benchmark/benchmark.h>
+#include "perf_counters.h"
 #include "common/memory_pool.h"
 #include <vector>
 #include <memory>
@@ -9,6 +10,7 @@ using namespace mdfh;
 static void BM_PoolAllocate(benchmark::State& state) {
     MemoryPool pool(4096, 1000);
     
+    bench::PerfScope perf(state);
     for (auto _ : state) {
         void* ptr = pool.allocate();
         benchmark::DoNotOptimize(ptr);
@@ -21,6 +23,7 @@ BENCHMARK(BM_PoolAllocate);
 
 // Benchmark: Compare with malloc/free
 static void BM_MallocFree(benchmark::State& state) {
+    bench::PerfScope perf(state);
     for (auto _ : state) {
         void* ptr = malloc(4096);
         benchmark::DoNotOptimize(ptr);
@@ -37,6 +40,7 @@ static void BM_PoolAllocateBatch(benchmark::State& state) {
     int batch_size = state.range(0);
     std::vector<void*> ptrs(batch_size);
     
+    bench::PerfScope perf(state);
     for (auto _ : state) {
         // Allocate batch
         for (int i = 0; i < batch_size; ++i) {
@@ -58,6 +62,7 @@ BENCHMARK(BM_PoolAllocateBatch)->Range(10, 500);
 static void BM_PoolConcurrent(benchmark::State& state) {
     static MemoryPool pool(4096, 10000);
     
+    bench::PerfScope perf(state);
     for (auto _ : state) {
         void* ptr = pool.allocate();
         benchmark::DoNotOptimize(ptr);
@@ -81,6 +86,7 @@ static void BM_PoolExhaustion(benchmark::State& state) {
         if (ptr) ptrs.push_back(ptr);
     }
     
+    bench::PerfScope perf(state);
     for (auto _ : state) {
         // Try to allocate when exhausted
         void* ptr = pool.allocate();
@@ -105,6 +111,7 @@ static void BM_PoolBlockSizes(benchmark::State& state) {
     size_t block_size = state.range(0);
     MemoryPool pool(block_size, 1000);
     
+    bench::PerfScope perf(state);
     for (auto _ : state) {
         void* ptr = pool.allocate();
         benchmark::DoNotOptimize(ptr);
@@ -124,6 +131,7 @@ BENCHMARK(BM_PoolBlockSizes)
 static void BM_PoolReset(benchmark::State& state) {
     MemoryPool pool(4096, 1000);
     
+    bench::PerfScope perf(state);
     for (auto _ : state) {
         state.PauseTiming();
         // Allocate some blocks
@@ -1,4 +1,5 @@
 #include <benchmark/benchmark.h>
+#include "perf_counters.h"
 #include "client/parser.h"
 #include "common/protocol.h"
 #include <vector>
@@ -42,6 +43,7 @@ static void BM_ParseTrade(benchmark::State& state) {
     BinaryParser parser;
     auto msg_buffer = create_test_message(MessageType::TRADE, 1, 100);
     
+    bench::PerfScope perf(state);
     for (auto _ : state) {
         size_t parsed = parser.parse(msg_buffer.data(), msg_buffer.size());
         benchmark::DoNotOptimize(parsed);
@@ -56,6 +58,7 @@ static void BM_ParseQuote(benchmark::State& state) {
     BinaryParser parser;
     auto msg_buffer = create_test_message(MessageType::QUOTE, 1, 100);
     
+    bench::PerfScope perf(state);
     for (auto _ : state) {
         size_t parsed = parser.parse(msg_buffer.data(), msg_buffer.size());
         benchmark::DoNotOptimize(parsed);
@@ -79,6 +82,7 @@ static void BM_ParseFragmentedStream(benchmark::State& state) {
         ));
     }
     
+    bench::PerfScope perf(state);
     for (auto _ : state) {
         size_t total_parsed = 0;
         
@@ -114,6 +118,7 @@ static void BM_ParseContinuousStream(benchmark::State& state) {
         stream_buffer.insert(stream_buffer.end(), msg.begin(), msg.end());
     }
     
+    bench::PerfScope perf(state);
     for (auto _ : state) {
         parser.reset();
         size_t parsed = parser.parse(stream_buffer.data(), stream_buffer.size());
@@ -130,6 +135,7 @@ static void BM_MessageValidation(benchmark::State& state) {
     auto msg_buffer = create_test_message(MessageType::QUOTE, 1, 100);
     MessageHeader* header = reinterpret_cast<MessageHeader*>(msg_buffer.data());
     
+    bench::PerfScope perf(state);
     for (auto _ : state) {
         bool valid = (header->msg_type == static_cast<uint16_t>(MessageType::QUOTE) &&
                      header->symbol_id < 500 &&
@@ -0,0 +1,199 @@
+#ifndef PERF_COUNTERS_H
+#define PERF_COUNTERS_H
+
+#include <benchmark/benchmark.h>
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+
+namespace mdfh {
+namespace bench {
+
+// Hardware counters read with perf_event_open and reported as Google
+// Benchmark user counters, normalized per processed item (or per iteration
+// when the benchmark does not set items processed).
+//
+// Counts user-space only, so perf_event_paranoid <= 2 is enough. Events the
+// CPU or hypervisor does not expose are skipped; when none are available the
+// benchmark runs unchanged and reports no perf counters.
+class PerfCounters {
+public:
+    enum Event {
+        CYCLES = 0,
+        INSTRUCTIONS,
+        L1D_MISSES,
+        LLC_MISSES,
+        BRANCH_MISSES,
+        NUM_EVENTS
+    };
+
+    PerfCounters() {
+        for (int e = 0; e < NUM_EVENTS; ++e) {
+            fds_[e] = open_event(static_cast<Event>(e));
+        }
+    }
+
+    ~PerfCounters() {
+        for (int fd : fds_) {
+            if (fd >= 0) {
+                close(fd);
+            }
+        }
+    }
+
+    PerfCounters(const PerfCounters&) = delete;
+    PerfCounters& operator=(const PerfCounters&) = delete;
+
+    // One set per thread: perf events opened with pid=0 count the calling thread
+    static PerfCounters& for_this_thread() {
+        thread_local PerfCounters counters;
+        return counters;
+    }
+
+    bool available() const {
+        for (int fd : fds_) {
+            if (fd >= 0) return true;
+        }
+        return false;
+    }
+
+    void start() {
+        for (int fd : fds_) {
+            if (fd >= 0) {
+                ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+                ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+            }
+        }
+    }
+
+    void stop() {
+        for (int e = 0; e < NUM_EVENTS; ++e) {
+            values_[e] = 0;
+            if (fds_[e] < 0) continue;
+            ioctl(fds_[e], PERF_EVENT_IOC_DISABLE, 0);
+            values_[e] = read_scaled(fds_[e]);
+        }
+    }
+
+    bool has(Event e) const { return fds_[e] >= 0; }
+    uint64_t value(Event e) const { return values_[e]; }
+
+    static const char* name(Event e) {
+        static const char* NAMES[NUM_EVENTS] = {
+            "cycles", "instructions", "L1D_misses", "LLC_misses", "branch_misses"
+        };
+        return NAMES[e];
+    }
+
+private:
+    int fds_[NUM_EVENTS];
+    uint64_t values_[NUM_EVENTS] = {};
+
+    static int open_event(Event e) {
+        perf_event_attr attr;
+        std::memset(&attr, 0, sizeof(attr));
+        attr.size = sizeof(attr);
+        attr.disabled = 1;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+        switch (e) {
+            case CYCLES:
+                attr.type = PERF_TYPE_HARDWARE;
+                attr.config = PERF_COUNT_HW_CPU_CYCLES;
+                break;
+            case INSTRUCTIONS:
+                attr.type = PERF_TYPE_HARDWARE;
+                attr.config = PERF_COUNT_HW_INSTRUCTIONS;
+                break;
+            case L1D_MISSES:
+                attr.type = PERF_TYPE_HW_CACHE;
+                attr.config = PERF_COUNT_HW_CACHE_L1D |
+                              (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+                              (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+                break;
+            case LLC_MISSES:
+                attr.type = PERF_TYPE_HARDWARE;
+                attr.config = PERF_COUNT_HW_CACHE_MISSES;
+                break;
+            case BRANCH_MISSES:
+                attr.type = PERF_TYPE_HARDWARE;
+                attr.config = PERF_COUNT_HW_BRANCH_MISSES;
+                break;
+            default:
+                return -1;
+        }
+
+        return static_cast<int>(syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0));
+    }
+
+    // Scale for multiplexing when more events are open than PMU slots
+    static uint64_t read_scaled(int fd) {
+        uint64_t data[3] = {0, 0, 0};  // value, time_enabled, time_running
+        if (read(fd, data, sizeof(data)) != static_cast<ssize_t>(sizeof(data))) {
+            return 0;
+        }
+        if (data[2] == 0) {
+            return 0;
+        }
+        if (data[2] < data[1]) {
+            return static_cast<uint64_t>(static_cast<double>(data[0]) * data[1] / data[2]);
+        }
+        return data[0];
+    }
+};
+
+// RAII scope for a benchmark body. Declare it right before the
+// `for (auto _ : state)` loop; counters are published when the function
+// returns, after SetItemsProcessed has been called.
+class PerfScope {
+public:
+    explicit PerfScope(benchmark::State& state)
+        : state_(state), counters_(PerfCounters::for_this_thread()) {
+        counters_.start();
+    }
+
+    ~PerfScope() {
+        counters_.stop();
+        if (!counters_.available()) {
+            return;
+        }
+
+        double units = static_cast<double>(state_.items_processed() > 0 ?
+                                           state_.items_processed() : state_.iterations());
+        if (units <= 0) {
+            return;
+        }
+
+        for (int e = 0; e < PerfCounters::NUM_EVENTS; ++e) {
+            auto event = static_cast<PerfCounters::Event>(e);
+            if (counters_.has(event)) {
+                state_.counters[PerfCounters::name(event)] = benchmark::Counter(
+                    counters_.value(event) / units, benchmark::Counter::kAvgThreads);
+            }
+        }
+        if (counters_.has(PerfCounters::CYCLES) && counters_.has(PerfCounters::INSTRUCTIONS) &&
+            counters_.value(PerfCounters::CYCLES) > 0) {
+            state_.counters["IPC"] = benchmark::Counter(
+                static_cast<double>(counters_.value(PerfCounters::INSTRUCTIONS)) /
+                counters_.value(PerfCounters::CYCLES), benchmark::Counter::kAvgThreads);
+        }
+    }
+
+    PerfScope(const PerfScope&) = delete;
+    PerfScope& operator=(const PerfScope&) = delete;
+
+private:
+    benchmark::State& state_;
+    PerfCounters& counters_;
+};
+
+} // namespace bench
+} // namespace mdfh
+
+#endif // PERF_COUNTERS_H
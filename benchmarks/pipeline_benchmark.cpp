@@ -0,0 +1,212 @@
+#include <benchmark/benchmark.h>
+#include "perf_counters.h"
+#include "client/feed_handler.h"
+#include "server/tick_generator.h"
+#include "common/protocol.h"
+#include "common/tsc_clock.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <random>
+#include <vector>
+
+using namespace mdfh;
+
+// In-process hot path: TickGenerator -> encode -> BinaryParser ->
+// FeedHandler::handle_message -> SymbolCache, through a memory buffer.
+// No sockets, so results are a regression baseline for the CPU cost alone.
+
+namespace {
+
+constexpr size_t STREAM_MESSAGES = 16384;
+constexpr size_t GENERATE_BATCH = 1024;
+
+// Per-symbol simulator state used while encoding
+struct SymbolPrices {
+    std::vector<double> price;
+    std::vector<uint32_t> seq;
+
+    explicit SymbolPrices(size_t num_symbols)
+        : price(num_symbols, 2450.0), seq(num_symbols, 0) {}
+};
+
+// Symbol picker: uniform when skew == 0, Zipf(skew) otherwise
+class SymbolPicker {
+public:
+    SymbolPicker(size_t num_symbols, double skew) : rng_(42) {
+        std::vector<double> weights(num_symbols);
+        for (size_t i = 0; i < num_symbols; ++i) {
+            weights[i] = skew > 0.0 ? 1.0 / std::pow(static_cast<double>(i + 1), skew) : 1.0;
+        }
+        dist_ = std::discrete_distribution<size_t>(weights.begin(), weights.end());
+    }
+
+    uint16_t next() { return static_cast<uint16_t>(dist_(rng_)); }
+
+private:
+    std::mt19937_64 rng_;
+    std::discrete_distribution<size_t> dist_;
+};
+
+// Encode one tick the way ExchangeSimulator::generate_tick does
+size_t encode_tick(TickGenerator& gen, SymbolPrices& symbols, uint16_t symbol_id,
+                   uint64_t timestamp, uint8_t* out, bool* is_quote) {
+    double& price = symbols.price[symbol_id];
+    price = gen.generate_next_price(price, 0.0, 0.02, 0.001);
+
+    if (gen.should_generate_quote()) {
+        QuoteMessage msg{};
+        msg.header.msg_type = static_cast<uint16_t>(MessageType::QUOTE);
+        msg.header.seq_num = ++symbols.seq[symbol_id];
+        msg.header.timestamp = timestamp;
+        msg.header.symbol_id = symbol_id;
+
+        double spread = gen.generate_spread(price);
+        msg.payload.bid_price = price - spread / 2.0;
+        msg.payload.ask_price = price + spread / 2.0;
+        msg.payload.bid_qty = gen.generate_volume();
+        msg.payload.ask_qty = gen.generate_volume();
+        msg.checksum = calculate_checksum(&msg, sizeof(msg) - 4);
+
+        std::memcpy(out, &msg, sizeof(msg));
+        *is_quote = true;
+        return sizeof(msg);
+    }
+
+    TradeMessage msg{};
+    msg.header.msg_type = static_cast<uint16_t>(MessageType::TRADE);
+    msg.header.seq_num = ++symbols.seq[symbol_id];
+    msg.header.timestamp = timestamp;
+    msg.header.symbol_id = symbol_id;
+    msg.payload.price = price;
+    msg.payload.quantity = gen.generate_volume();
+    msg.checksum = calculate_checksum(&msg, sizeof(msg) - 4);
+
+    std::memcpy(out, &msg, sizeof(msg));
+    *is_quote = false;
+    return sizeof(msg);
+}
+
+// Pre-encode a stream of `num_messages` ticks
+std::vector<uint8_t> build_stream(size_t num_messages, size_t num_symbols, double skew,
+                                  size_t* num_quotes) {
+    TickGenerator gen;
+    SymbolPrices symbols(num_symbols);
+    SymbolPicker picker(num_symbols, skew);
+
+    std::vector<uint8_t> stream(num_messages * sizeof(QuoteMessage));
+    size_t pos = 0;
+    *num_quotes = 0;
+    uint64_t timestamp = TscClock::now_wall_ns();
+
+    for (size_t i = 0; i < num_messages; ++i) {
+        bool is_quote;
+        pos += encode_tick(gen, symbols, picker.next(), timestamp, &stream[pos], &is_quote);
+        *num_quotes += is_quote ? 1 : 0;
+    }
+    stream.resize(pos);
+    return stream;
+}
+
+void set_pipeline_counters(benchmark::State& state, uint64_t total_ticks,
+                           size_t messages_per_iteration, double quote_ratio) {
+    double messages = static_cast<double>(state.iterations()) * messages_per_iteration;
+    state.SetItemsProcessed(state.iterations() * messages_per_iteration);
+    // TSC reference cycles, not core cycles
+    state.counters["tsc_cycles_per_msg"] = static_cast<double>(total_ticks) / messages;
+    state.counters["ns_per_msg"] =
+        static_cast<double>(TscClock::delta_to_ns(total_ticks)) / messages;
+    state.counters["quote_ratio"] = quote_ratio;
+}
+
+} // namespace
+
+// Benchmark: Decode path over a pre-encoded stream
+// Args: num_symbols, skew x100 (0 = uniform, 100 = Zipf 1.0), recv chunk bytes
+static void BM_PipelineDecode(benchmark::State& state) {
+    size_t num_symbols = static_cast<size_t>(state.range(0));
+    double skew = static_cast<double>(state.range(1)) / 100.0;
+    size_t chunk = static_cast<size_t>(state.range(2));
+
+    size_t num_quotes;
+    auto stream = build_stream(STREAM_MESSAGES, num_symbols, skew, &num_quotes);
+
+    FeedHandler handler("127.0.0.1", 0, num_symbols);
+    // The stream's timestamps age across iterations; only time stages
+    handler.get_outlier_recorder().set_thresholds(0, OutlierRecorder::DEFAULT_STAGE_THRESHOLD_NS);
+
+    uint64_t total_ticks = 0;
+    bench::PerfScope perf(state);
+    for (auto _ : state) {
+        uint64_t start = TscClock::rdtsc();
+        for (size_t pos = 0; pos < stream.size(); pos += chunk) {
+            size_t len = std::min(chunk, stream.size() - pos);
+            uint64_t now = TscClock::now_ticks();
+            handler.process_batch(&stream[pos], len, now, now);
+        }
+        total_ticks += TscClock::rdtsc() - start;
+    }
+
+    if (handler.get_messages_received() != state.iterations() * STREAM_MESSAGES) {
+        state.SkipWithError("Messages lost in pipeline");
+        return;
+    }
+    set_pipeline_counters(state, total_ticks, STREAM_MESSAGES,
+                          static_cast<double>(num_quotes) / STREAM_MESSAGES);
+    state.counters["fragmented"] = static_cast<double>(handler.get_stats().fragmented_messages);
+}
+BENCHMARK(BM_PipelineDecode)
+    ->ArgNames({"symbols", "skew", "chunk"})
+    ->Args({100, 0, 65536})      // Whole-buffer reads
+    ->Args({100, 0, 1460})       // MSS-sized reads
+    ->Args({100, 0, 100})        // Heavy fragmentation
+    ->Args({100, 100, 1460})     // Hot symbols (Zipf 1.0)
+    ->Args({1000, 0, 1460})
+    ->Args({1000, 120, 1460})
+    ->Unit(benchmark::kMicrosecond);
+
+// Benchmark: Full path, generating and encoding each batch before decode
+// Args: num_symbols, skew x100
+static void BM_PipelineGenerateAndDecode(benchmark::State& state) {
+    size_t num_symbols = static_cast<size_t>(state.range(0));
+    double skew = static_cast<double>(state.range(1)) / 100.0;
+
+    TickGenerator gen;
+    SymbolPrices symbols(num_symbols);
+    SymbolPicker picker(num_symbols, skew);
+    FeedHandler handler("127.0.0.1", 0, num_symbols);
+
+    std::vector<uint8_t> buffer(GENERATE_BATCH * sizeof(QuoteMessage));
+    uint64_t total_ticks = 0;
+    size_t num_quotes = 0;
+
+    bench::PerfScope perf(state);
+    for (auto _ : state) {
+        uint64_t start = TscClock::rdtsc();
+
+        size_t pos = 0;
+        for (size_t i = 0; i < GENERATE_BATCH; ++i) {
+            bool is_quote;
+            pos += encode_tick(gen, symbols, picker.next(), TscClock::now_wall_ns(),
+                               &buffer[pos], &is_quote);
+            num_quotes += is_quote ? 1 : 0;
+        }
+
+        uint64_t now = TscClock::now_ticks();
+        handler.process_batch(buffer.data(), pos, now, now);
+
+        total_ticks += TscClock::rdtsc() - start;
+    }
+
+    set_pipeline_counters(state, total_ticks, GENERATE_BATCH,
+                          static_cast<double>(num_quotes) /
+                          (static_cast<double>(state.iterations()) * GENERATE_BATCH));
+}
+BENCHMARK(BM_PipelineGenerateAndDecode)
+    ->ArgNames({"symbols", "skew"})
+    ->Args({100, 0})
+    ->Args({100, 100})
+    ->Args({1000, 120})
+    ->Unit(benchmark::kMicrosecond);
+
+BENCHMARK_MAIN();
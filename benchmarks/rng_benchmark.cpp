@@ -0,0 +1,123 @@
+#include <benchmark/benchmark.h>
+#include "perf_counters.h"
+#include "common/philox.h"
+#include <random>
+#include <vector>
+
+using namespace mdfh;
+
+// Benchmark: mt19937_64 uniform double (the generators' previous source)
+static void BM_Mt19937_Uniform(benchmark::State& state) {
+    std::mt19937_64 rng(42);
+    std::uniform_real_distribution<double> uniform(0.0, 1.0);
+    
+    bench::PerfScope perf(state);
+    for (auto _ : state) {
+        double u = uniform(rng);
+        benchmark::DoNotOptimize(u);
+    }
+    
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_Mt19937_Uniform);
+
+// Benchmark: Philox uniform double, one at a time
+static void BM_Philox_Uniform(benchmark::State& state) {
+    Philox4x32 rng(42, RngStream::TICKS, 0);
+    
+    bench::PerfScope perf(state);
+    for (auto _ : state) {
+        double u = rng.uniform();
+        benchmark::DoNotOptimize(u);
+    }
+    
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_Philox_Uniform);
+
+// Benchmark: Philox uniforms in bulk (Philox4x32::LANES blocks per pass)
+static void BM_Philox_FillUniform(benchmark::State& state) {
+    size_t n = static_cast<size_t>(state.range(0));
+    Philox4x32 rng(42, RngStream::TICKS, 0);
+    std::vector<double> out(n);
+    
+    bench::PerfScope perf(state);
+    for (auto _ : state) {
+        rng.fill_uniform(out.data(), n);
+        benchmark::DoNotOptimize(out.data());
+    }
+    
+    state.SetItemsProcessed(state.iterations() * n);
+}
+BENCHMARK(BM_Philox_FillUniform)->Arg(1024)->Arg(16384);
+
+// Benchmark: mt19937_64 standard normal (std::normal_distribution)
+static void BM_Mt19937_Normal(benchmark::State& state) {
+    std::mt19937_64 rng(42);
+    std::normal_distribution<double> normal(0.0, 1.0);
+    
+    bench::PerfScope perf(state);
+    for (auto _ : state) {
+        double z = normal(rng);
+        benchmark::DoNotOptimize(z);
+    }
+    
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_Mt19937_Normal);
+
+// Benchmark: Philox standard normal, one at a time (Box-Muller)
+static void BM_Philox_Normal(benchmark::State& state) {
+    Philox4x32 rng(42, RngStream::TICKS, 0);
+    
+    bench::PerfScope perf(state);
+    for (auto _ : state) {
+        double z = rng.normal();
+        benchmark::DoNotOptimize(z);
+    }
+    
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_Philox_Normal);
+
+// Benchmark: Philox normals in bulk
+static void BM_Philox_FillNormal(benchmark::State& state) {
+    size_t n = static_cast<size_t>(state.range(0));
+    Philox4x32 rng(42, RngStream::TICKS, 0);
+    std::vector<double> out(n);
+    
+    bench::PerfScope perf(state);
+    for (auto _ : state) {
+        rng.fill_normal(out.data(), n);
+        benchmark::DoNotOptimize(out.data());
+    }
+    
+    state.SetItemsProcessed(state.iterations() * n);
+}
+BENCHMARK(BM_Philox_FillNormal)->Arg(1024)->Arg(16384);
+
+// Benchmark: Creating a per-symbol stream (what the old per-tick
+// TickGenerator construction paid with random_device + mt19937 seeding)
+static void BM_StreamSetup(benchmark::State& state) {
+    uint32_t id = 0;
+    
+    for (auto _ : state) {
+        Philox4x32 rng(42, RngStream::TICKS, id++);
+        benchmark::DoNotOptimize(rng());
+    }
+    
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_StreamSetup);
+
+static void BM_Mt19937_StreamSetup(benchmark::State& state) {
+    std::random_device rd;
+    
+    for (auto _ : state) {
+        std::mt19937_64 rng(rd());
+        benchmark::DoNotOptimize(rng());
+    }
+    
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_Mt19937_StreamSetup);
@@ -1,4 +1,5 @@
 #include <benchmark/benchmark.h>
+#include "perf_counters.h"
 #include <sys/socket.h>
 #include <netinet/in.h>
 #include <netinet/tcp.h>
@@ -11,6 +12,7 @@
 
 // Benchmark: Socket creation and configuration
 static void BM_SocketCreation(benchmark::State& state) {
+    mdfh::bench::PerfScope perf(state);
     for (auto _ : state) {
         int sock_fd = socket(AF_INET, SOCK_STREAM, 0);
         benchmark::DoNotOptimize(sock_fd);
@@ -69,6 +71,7 @@ static void BM_LoopbackLatency(benchmark::State& state) {
     char send_buf[64] = "PING";
     char recv_buf[64];
     
+    mdfh::bench::PerfScope perf(state);
     for (auto _ : state) {
         send(client_fd, send_buf, 4, 0);
         recv(client_fd, recv_buf, 4, 0);
@@ -89,6 +92,7 @@ static void BM_RecvBufferSize(benchmark::State& state) {
     
     int buffer_size = state.range(0);
     
+    mdfh::bench::PerfScope perf(state);
     for (auto _ : state) {
         setsockopt(sock_fd, SOL_SOCKET, SO_RCVBUF, &buffer_size, sizeof(buffer_size));
         benchmark::ClobberMemory();
@@ -110,6 +114,7 @@ static void BM_SetSocketOptions(benchmark::State& state) {
     int sock_fd = socket(AF_INET, SOCK_STREAM, 0);
     int flag = 1;
     
+    mdfh::bench::PerfScope perf(state);
     for (auto _ : state) {
         setsockopt(sock_fd, IPPROTO_TCP, TCP_NODELAY, &flag, sizeof(flag));
         setsockopt(sock_fd, SOL_SOCKET, SO_KEEPALIVE, &flag, sizeof(flag));
@@ -126,6 +131,7 @@ BENCHMARK(BM_SetSocketOptions);
 static void BM_NonBlockingToggle(benchmark::State& state) {
     int sock_fd = socket(AF_INET, SOCK_STREAM, 0);
     
+    mdfh::bench::PerfScope perf(state);
     for (auto _ : state) {
         int flags = fcntl(sock_fd, F_GETFL, 0);
         fcntl(sock_fd, F_SETFL, flags | O_NONBLOCK);
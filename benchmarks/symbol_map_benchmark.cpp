@@ -0,0 +1,112 @@
+#include <benchmark/benchmark.h>
+#include "perf_counters.h"
+#include "common/symbol_map.h"
+#include <numeric>
+#include <random>
+#include <vector>
+
+using namespace mdfh;
+
+namespace {
+
+// Distinct ids spread uniformly over [0, id_space)
+std::vector<SymbolId> make_ids(size_t count, size_t id_space, std::mt19937& rng) {
+    std::vector<SymbolId> ids(count);
+    if (count == id_space) {
+        std::iota(ids.begin(), ids.end(), 0);
+        return ids;
+    }
+    std::vector<bool> used(id_space, false);
+    std::uniform_int_distribution<SymbolId> id_dist(0, static_cast<SymbolId>(id_space - 1));
+    for (auto& id : ids) {
+        do {
+            id = id_dist(rng);
+        } while (used[id]);
+        used[id] = true;
+    }
+    return ids;
+}
+
+// Pre-drawn message ids: mostly tracked, 1 in 8 from anywhere in the space
+std::vector<SymbolId> make_stream(const std::vector<SymbolId>& ids, size_t id_space, std::mt19937& rng) {
+    std::vector<SymbolId> stream(4096);
+    std::uniform_int_distribution<size_t> pick(0, ids.size() - 1);
+    std::uniform_int_distribution<SymbolId> any(0, static_cast<SymbolId>(id_space - 1));
+    for (size_t i = 0; i < stream.size(); ++i) {
+        stream[i] = (i % 8 == 7) ? any(rng) : ids[pick(rng)];
+    }
+    return stream;
+}
+
+} // namespace
+
+// Args: tracked ids, id space. Cases: a handful of ids in a 16-bit space,
+// 1k ids scattered over 16M, 1M dense ids, 1M ids over 16M.
+#define SYMBOL_MAP_ARGS \
+    ->Args({5, 1 << 16})->Args({1000, 1 << 24}) \
+    ->Args({1 << 20, 1 << 20})->Args({1 << 20, 1 << 24})
+
+// Benchmark: Baseline flat table of 4-byte slots sized to the id space
+static void BM_FlatLookup(benchmark::State& state) {
+    const size_t count = static_cast<size_t>(state.range(0));
+    const size_t id_space = static_cast<size_t>(state.range(1));
+    std::mt19937 rng(42);
+    std::vector<SymbolId> ids = make_ids(count, id_space, rng);
+    std::vector<uint32_t> table(id_space, SymbolMap::NO_SLOT);
+    for (uint32_t slot = 0; slot < ids.size(); ++slot) {
+        table[ids[slot]] = slot;
+    }
+    std::vector<SymbolId> stream = make_stream(ids, id_space, rng);
+
+    size_t i = 0;
+    bench::PerfScope perf(state);
+    for (auto _ : state) {
+        SymbolId id = stream[i++ & 4095];
+        uint32_t slot = id < table.size() ? table[id] : SymbolMap::NO_SLOT;
+        benchmark::DoNotOptimize(slot);
+    }
+
+    state.SetItemsProcessed(state.iterations());
+    state.counters["table_MB"] = static_cast<double>(table.capacity() * sizeof(uint32_t)) / (1 << 20);
+}
+BENCHMARK(BM_FlatLookup) SYMBOL_MAP_ARGS;
+
+// Benchmark: Two-level SymbolMap (directory + shared empty page)
+static void BM_SymbolMapLookup(benchmark::State& state) {
+    const size_t count = static_cast<size_t>(state.range(0));
+    const size_t id_space = static_cast<size_t>(state.range(1));
+    std::mt19937 rng(42);
+    std::vector<SymbolId> ids = make_ids(count, id_space, rng);
+    SymbolMap map(ids);
+    std::vector<SymbolId> stream = make_stream(ids, id_space, rng);
+
+    size_t i = 0;
+    bench::PerfScope perf(state);
+    for (auto _ : state) {
+        uint32_t slot = map.slot(stream[i++ & 4095]);
+        benchmark::DoNotOptimize(slot);
+    }
+
+    state.SetItemsProcessed(state.iterations());
+    state.counters["table_MB"] = static_cast<double>(map.memory_bytes()) / (1 << 20);
+    state.counters["page_bits"] = map.page_bits();
+}
+BENCHMARK(BM_SymbolMapLookup) SYMBOL_MAP_ARGS;
+
+// Benchmark: Building the map from a loaded universe (startup cost)
+static void BM_SymbolMapBuild(benchmark::State& state) {
+    const size_t count = static_cast<size_t>(state.range(0));
+    const size_t id_space = static_cast<size_t>(state.range(1));
+    std::mt19937 rng(42);
+    std::vector<SymbolId> ids = make_ids(count, id_space, rng);
+
+    for (auto _ : state) {
+        SymbolMap map(ids);
+        benchmark::DoNotOptimize(map);
+    }
+
+    state.SetItemsProcessed(state.iterations() * count);
+}
+BENCHMARK(BM_SymbolMapBuild)->Unit(benchmark::kMillisecond) SYMBOL_MAP_ARGS;
+
+BENCHMARK_MAIN();
@@ -0,0 +1,81 @@
+#include <benchmark/benchmark.h>
+#include "common/symbol_universe.h"
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <unistd.h>
+
+using namespace mdfh;
+
+namespace {
+
+// A universe of n rows in the config/symbols.csv layout
+std::string make_csv(size_t n) {
+    std::string path = "/tmp/mdfh_symbols_bench_" + std::to_string(getpid()) + "_" + std::to_string(n) + ".csv";
+    std::ofstream out(path);
+    out << "symbol_id,symbol,price,volatility,drift,weight\n";
+    for (size_t i = 0; i < n; ++i) {
+        out << i << ",SYM" << i << "," << 100.0 + static_cast<double>(i % 5000) * 0.37
+            << ",0.0" << (1 + i % 9) << ",0.0001," << 1.0 + static_cast<double>(i % 7) << "\n";
+    }
+    return path;
+}
+
+} // namespace
+
+// Benchmark: The old loader, getline + istringstream per row (arg: rows)
+static void BM_IstreamLoad(benchmark::State& state) {
+    std::string path = make_csv(static_cast<size_t>(state.range(0)));
+    for (auto _ : state) {
+        std::ifstream file(path);
+        std::string line;
+        std::getline(file, line);
+        size_t loaded = 0;
+        while (std::getline(file, line)) {
+            std::istringstream iss(line);
+            uint32_t symbol_id;
+            std::string name;
+            double price, volatility, drift, weight = 0.0;
+            if ((iss >> symbol_id) && iss.ignore() && std::getline(iss, name, ',') &&
+                (iss >> price) && iss.ignore() && (iss >> volatility) && iss.ignore() &&
+                (iss >> drift)) {
+                iss.ignore() && (iss >> weight);
+                benchmark::DoNotOptimize(weight);
+                loaded++;
+            }
+        }
+        benchmark::DoNotOptimize(loaded);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+    std::remove(path.c_str());
+}
+BENCHMARK(BM_IstreamLoad)->Arg(10000)->Arg(100000)->Unit(benchmark::kMillisecond);
+
+// Benchmark: mmap + from_chars CSV parse (arg: rows)
+static void BM_CsvLoad(benchmark::State& state) {
+    std::string path = make_csv(static_cast<size_t>(state.range(0)));
+    for (auto _ : state) {
+        SymbolUniverse universe = SymbolUniverse::load(path);
+        benchmark::DoNotOptimize(universe.size());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+    std::remove(path.c_str());
+}
+BENCHMARK(BM_CsvLoad)->Arg(10000)->Arg(100000)->Unit(benchmark::kMillisecond);
+
+// Benchmark: Binary universe, mapped and validated with no parsing (arg: rows)
+static void BM_BinaryLoad(benchmark::State& state) {
+    std::string csv = make_csv(static_cast<size_t>(state.range(0)));
+    std::string path = csv + ".bin";
+    SymbolUniverse::load(csv).save(path);
+    for (auto _ : state) {
+        SymbolUniverse universe = SymbolUniverse::load(path);
+        benchmark::DoNotOptimize(universe.size());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+    std::remove(csv.c_str());
+    std::remove(path.c_str());
+}
+BENCHMARK(BM_BinaryLoad)->Arg(10000)->Arg(100000)->Unit(benchmark::kMillisecond);
@@ -1,5 +1,7 @@
 #include <benchmark/benchmark.h>
+#include "perf_counters.h"
 #include "server/tick_generator.h"
+#include "server/correlation_model.h"
 #include <random>
 
 using namespace mdfh;
@@ -12,6 +14,7 @@ static void BM_GenerateTick(benchmark::State& state) {
     double volatility = 0.03;
     double dt = 0.001;
     
+    bench::PerfScope perf(state);
     for (auto _ : state) {
         double price = generator.generate_next_price(current_price, drift, volatility, dt);
         benchmark::DoNotOptimize(price);
@@ -27,6 +30,7 @@ static void BM_BoxMuller(benchmark::State& state) {
     std::mt19937 rng(42);
     std::uniform_real_distribution<double> dist(0.0, 1.0);
     
+    bench::PerfScope perf(state);
     for (auto _ : state) {
         double u1 = dist(rng);
         double u2 = dist(rng);
@@ -43,6 +47,7 @@ static void BM_GenerateSpread(benchmark::State& state) {
     TickGenerator generator;
     double price = 2450.0;
     
+    bench::PerfScope perf(state);
     for (auto _ : state) {
         double spread = generator.generate_spread(price);
         benchmark::DoNotOptimize(spread);
@@ -64,6 +69,7 @@ static void BM_GenerateBatchTicks(benchmark::State& state) {
         volatilities.push_back(0.02 + (i % 3) * 0.01);
     }
     
+    bench::PerfScope perf(state);
     for (auto _ : state) {
         for (int i = 0; i < num_symbols; ++i) {
             prices[i] = generator.generate_next_price(prices[i], 0.0, volatilities[i], 0.001);
@@ -81,6 +87,7 @@ static void BM_VolatilityImpact(benchmark::State& state) {
     TickGenerator generator;
     double current_price = 2450.0;
     
+    bench::PerfScope perf(state);
     for (auto _ : state) {
         current_price = generator.generate_next_price(current_price, 0.0, volatility, 0.001);
         benchmark::DoNotOptimize(current_price);
@@ -96,6 +103,7 @@ static void BM_GenerateTrade(benchmark::State& state) {
     TickGenerator generator;
     double current_price = 2450.0;
     
+    bench::PerfScope perf(state);
     for (auto _ : state) {
         current_price = generator.generate_next_price(current_price, 0.0, 0.03, 0.001);
         uint32_t volume = generator.generate_volume();
@@ -122,6 +130,7 @@ static void BM_RealisticTickRate(benchmark::State& state) {
     std::mt19937 rng(42);
     std::uniform_int_distribution<int> symbol_dist(0, 99);
     
+    bench::PerfScope perf(state);
     for (auto _ : state) {
         int symbol_id = symbol_dist(rng);
         
@@ -148,4 +157,98 @@ static void BM_RealisticTickRate(benchmark::State& state) {
 }
 BENCHMARK(BM_RealisticTickRate);
 
+namespace {
+
+// Equicorrelated universe (rho = 0.3), positive definite for any size
+std::vector<double> make_correlation(size_t n) {
+    std::vector<double> c(n * n, 0.3);
+    for (size_t i = 0; i < n; ++i) c[i * n + i] = 1.0;
+    return c;
+}
+
+// Loadings on k factors: a market factor plus one sector factor per symbol
+std::vector<double> make_loadings(size_t n, size_t k) {
+    std::vector<double> b(n * k, 0.0);
+    for (size_t i = 0; i < n; ++i) {
+        b[i * k] = 0.5;
+        b[i * k + 1 + i % (k - 1)] = 0.4;
+    }
+    return b;
+}
+
+void step_all(CorrelationModel& model, std::vector<double>& shocks,
+              std::vector<double>& prices, const std::vector<double>& volatilities) {
+    model.draw(shocks.data());
+    for (size_t i = 0; i < prices.size(); ++i) {
+        prices[i] = TickGenerator::gbm_step(prices[i], 0.0, volatilities[i], 0.001, shocks[i]);
+    }
+}
+
+} // namespace
+
+// Benchmark: One independent GBM step of every symbol (baseline)
+static void BM_IndependentStep(benchmark::State& state) {
+    size_t n = static_cast<size_t>(state.range(0));
+    TickGenerator generator;
+    std::vector<double> prices(n, 1000.0);
+    
+    bench::PerfScope perf(state);
+    for (auto _ : state) {
+        for (size_t i = 0; i < n; ++i) {
+            prices[i] = generator.generate_next_price(prices[i], 0.0, 0.03, 0.001);
+        }
+        benchmark::DoNotOptimize(prices.data());
+    }
+    
+    state.SetItemsProcessed(state.iterations() * n);
+}
+BENCHMARK(BM_IndependentStep)->Arg(100)->Arg(1000)->Arg(10000);
+
+// Benchmark: One correlated step of every symbol through the Cholesky factor
+// of a full n x n correlation matrix (O(n^2); 10k would need 400MB of factor)
+static void BM_CorrelatedStepFull(benchmark::State& state) {
+    size_t n = static_cast<size_t>(state.range(0));
+    auto model = CorrelationModel::full(n, make_correlation(n), 42);
+    std::vector<double> shocks(n), prices(n, 1000.0), volatilities(n, 0.03);
+    
+    bench::PerfScope perf(state);
+    for (auto _ : state) {
+        step_all(model, shocks, prices, volatilities);
+        benchmark::DoNotOptimize(prices.data());
+    }
+    
+    state.SetItemsProcessed(state.iterations() * n);
+}
+BENCHMARK(BM_CorrelatedStepFull)->Arg(100)->Arg(1000);
+
+// Benchmark: One correlated step of every symbol through a k-factor model
+// (O(n * k); args: symbols, factors)
+static void BM_CorrelatedStepFactor(benchmark::State& state) {
+    size_t n = static_cast<size_t>(state.range(0));
+    size_t k = static_cast<size_t>(state.range(1));
+    auto model = CorrelationModel::factor(n, k, make_loadings(n, k), 42);
+    std::vector<double> shocks(n), prices(n, 1000.0), volatilities(n, 0.03);
+    
+    bench::PerfScope perf(state);
+    for (auto _ : state) {
+        step_all(model, shocks, prices, volatilities);
+        benchmark::DoNotOptimize(prices.data());
+    }
+    
+    state.SetItemsProcessed(state.iterations() * n);
+}
+BENCHMARK(BM_CorrelatedStepFactor)->Args({100, 8})->Args({1000, 8})->Args({10000, 8})->Args({10000, 32});
+
+// Benchmark: Factoring a full correlation matrix (one-time setup cost)
+static void BM_CholeskyFactor(benchmark::State& state) {
+    size_t n = static_cast<size_t>(state.range(0));
+    auto correlation = make_correlation(n);
+    
+    for (auto _ : state) {
+        auto model = CorrelationModel::full(n, correlation, 42);
+        benchmark::DoNotOptimize(&model);
+    }
+}
+BENCHMARK(BM_CholeskyFactor)->Arg(100)->Arg(1000)->Unit(benchmark::kMillisecond);
+
 BENCHMARK_MAIN();
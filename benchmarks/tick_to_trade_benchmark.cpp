@@ -0,0 +1,299 @@
+// Loopback tick-to-trade benchmark.
+//
+// Runs an ExchangeSimulator with its order gateway and a FeedHandler plus
+// OrderSender in one process over 127.0.0.1. A strategy in the feed
+// handler's quote callback reacts to every Nth quote with an order that
+// carries the quote's exchange timestamp; the ack echoes it back. Per order
+// the latency is split into stages, all on the shared wall clock:
+//   tick -> order sent           (feed delivery + strategy, client send time)
+//   order sent -> gateway        (order path into the exchange and matching)
+//   gateway -> ack received      (ack path back to the client)
+//   tick -> ack received         (tick-to-trade round trip)
+// Orders are market orders alternating buy/sell, so nothing accumulates:
+// in GBM mode they expire unfilled, in matching mode (market.mode in
+// config/server.conf) they trade against the book.
+//
+// Run from the repository root:
+//   ./build/benchmark/tick_to_trade_benchmark [--duration=2] [--order-every=10]
+//       [--out=tick_to_trade_results.json] [--quick]
+
+#include "server/exchange_simulator.h"
+#include "client/feed_handler.h"
+#include "client/order_sender.h"
+#include "common/latency_tracker.h"
+#include "common/logger.h"
+#include "common/tsc_clock.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <memory>
+#include <numeric>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace mdfh;
+
+namespace {
+
+struct BenchOptions {
+    uint32_t duration_s = 2;
+    uint32_t order_every = 10;      // React to every Nth quote
+    std::string out_file = "tick_to_trade_results.json";
+    bool quick = false;
+};
+
+struct RunConfig {
+    uint32_t tick_rate;             // Background market data rate
+    size_t num_symbols;
+};
+
+enum Stage {
+    TICK_TO_ORDER,
+    ORDER_TO_GATEWAY,
+    GATEWAY_TO_CLIENT,
+    TICK_TO_TRADE,
+    NUM_STAGES
+};
+
+const char* const STAGE_NAMES[NUM_STAGES] = {
+    "tick_to_order", "order_to_gateway", "gateway_to_client", "tick_to_trade"
+};
+
+struct RunResult {
+    RunConfig config;
+    bool ok = false;
+    uint64_t quotes = 0;
+    uint64_t orders = 0;
+    uint64_t acks = 0;
+    uint64_t fills = 0;             // Acks with a filled quantity (matching mode)
+    LatencyStats stages[NUM_STAGES]{};
+};
+
+uint16_t g_next_port = 19950;
+
+uint64_t since(uint64_t later, uint64_t earlier) {
+    return later > earlier ? later - earlier : 0;
+}
+
+RunResult run_once(const RunConfig& cfg, const BenchOptions& opts) {
+    RunResult result;
+    result.config = cfg;
+    uint16_t port = g_next_port;
+    uint16_t order_port = static_cast<uint16_t>(port + 1);
+    g_next_port += 2;
+
+    std::unique_ptr<ExchangeSimulator> sim;
+    try {
+        sim = std::make_unique<ExchangeSimulator>(port, cfg.num_symbols);
+        sim->set_tick_rate(0);
+        sim->set_order_port(order_port);
+        sim->start();
+    } catch (const std::exception& e) {
+        std::fprintf(stderr, "Failed to start simulator: %s\n", e.what());
+        return result;
+    }
+    std::thread event_loop([&sim] { sim->run(); });
+
+    OrderSender sender;
+    FeedHandler handler("127.0.0.1", port, cfg.num_symbols);
+    handler.get_outlier_recorder().set_thresholds(0, 0);
+
+    std::vector<std::unique_ptr<LatencyTracker>> trackers;
+    for (int s = 0; s < NUM_STAGES; ++s) {
+        trackers.push_back(std::make_unique<LatencyTracker>());
+    }
+
+    std::atomic<uint64_t> quotes{0};
+    std::atomic<bool> measuring{false};
+    uint64_t order_count = 0;
+    handler.set_quote_callback([&](const QuoteMessage& quote) {
+        uint64_t n = quotes.fetch_add(1, std::memory_order_relaxed) + 1;
+        if (!measuring.load(std::memory_order_relaxed) || n % opts.order_every != 0) {
+            return;
+        }
+        OrderSide side = (order_count++ & 1) ? OrderSide::SELL : OrderSide::BUY;
+        sender.send_new_order(quote.header.symbol_id, side, OrderType::MARKET,
+                              0.0, 100, quote.header.timestamp);
+    });
+
+    bool connected = sender.connect("127.0.0.1", order_port) && handler.start();
+    if (connected) {
+        std::vector<SymbolId> symbols(cfg.num_symbols);
+        std::iota(symbols.begin(), symbols.end(), 0);
+        handler.subscribe(symbols);
+        std::this_thread::sleep_for(std::chrono::milliseconds(200));
+    } else {
+        std::fprintf(stderr, "Failed to connect on ports %u/%u\n", port, order_port);
+    }
+
+    std::atomic<bool> reading{true};
+    std::atomic<uint64_t> acks{0};
+    std::atomic<uint64_t> fills{0};
+    std::thread ack_reader([&] {
+        auto on_ack = [&](const OrderAckMessage& ack) {
+            // The ack echoes the tick and order timestamps, so no per-order state
+            uint64_t received = TscClock::now_wall_ns();
+            uint64_t sent = ack.payload.order_timestamp;
+            trackers[TICK_TO_ORDER]->record(since(sent, ack.payload.trigger_timestamp));
+            trackers[ORDER_TO_GATEWAY]->record(since(ack.header.timestamp, sent));
+            trackers[GATEWAY_TO_CLIENT]->record(since(received, ack.header.timestamp));
+            trackers[TICK_TO_TRADE]->record(since(received, ack.payload.trigger_timestamp));
+            acks++;
+            fills += ack.payload.filled_quantity > 0 ? 1 : 0;
+        };
+        while (reading.load(std::memory_order_relaxed)) {
+            if (sender.poll_acks(on_ack, 10) < 0) {
+                break;
+            }
+        }
+    });
+
+    if (connected) {
+        measuring = true;
+        sim->set_tick_rate(cfg.tick_rate);
+        std::this_thread::sleep_for(std::chrono::milliseconds(opts.duration_s * 1000));
+        sim->set_tick_rate(0);
+        measuring = false;
+
+        // Drain outstanding acks
+        for (int waited = 0; waited < 2000 && acks < sender.get_orders_sent(); waited += 10) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+    }
+
+    reading = false;
+    ack_reader.join();
+    handler.stop();
+    sender.disconnect();
+    sim->stop();
+    event_loop.join();
+
+    if (connected) {
+        result.ok = true;
+        result.quotes = quotes.load();
+        result.orders = sender.get_orders_sent();
+        result.acks = acks.load();
+        result.fills = fills.load();
+        for (int s = 0; s < NUM_STAGES; ++s) {
+            result.stages[s] = trackers[s]->get_stats();
+        }
+    }
+    return result;
+}
+
+void print_header() {
+    std::printf("%10s %8s %8s %8s %8s | %-22s %-22s %-22s %-22s\n",
+                "rate", "symbols", "orders", "acks", "fills",
+                "tick->order p50/p99", "order->gw p50/p99", "gw->client p50/p99", "tick->ack p50/p99");
+}
+
+void print_result(const RunResult& r) {
+    if (!r.ok) {
+        std::printf("%10u %8zu   (setup failed)\n", r.config.tick_rate, r.config.num_symbols);
+        return;
+    }
+    std::printf("%10u %8zu %8llu %8llu %8llu |", r.config.tick_rate, r.config.num_symbols,
+                static_cast<unsigned long long>(r.orders),
+                static_cast<unsigned long long>(r.acks),
+                static_cast<unsigned long long>(r.fills));
+    for (int s = 0; s < NUM_STAGES; ++s) {
+        std::printf(" %9.1f/%-9.1fus", r.stages[s].p50 / 1000.0, r.stages[s].p99 / 1000.0);
+    }
+    std::printf("\n");
+    std::fflush(stdout);
+}
+
+void write_run_json(FILE* out, const RunResult& r, bool last) {
+    std::fprintf(out,
+        "    {\"tick_rate\": %u, \"num_symbols\": %zu, \"ok\": %s, \"quotes\": %llu, "
+        "\"orders\": %llu, \"acks\": %llu, \"fills\": %llu,\n     \"latency_ns\": {",
+        r.config.tick_rate, r.config.num_symbols, r.ok ? "true" : "false",
+        static_cast<unsigned long long>(r.quotes),
+        static_cast<unsigned long long>(r.orders),
+        static_cast<unsigned long long>(r.acks),
+        static_cast<unsigned long long>(r.fills));
+    for (int s = 0; s < NUM_STAGES; ++s) {
+        const LatencyStats& l = r.stages[s];
+        std::fprintf(out, "%s\n       \"%s\": {\"p50\": %llu, \"p95\": %llu, \"p99\": %llu, "
+                     "\"p999\": %llu, \"max\": %llu, \"samples\": %llu}",
+                     s == 0 ? "" : ",", STAGE_NAMES[s],
+                     static_cast<unsigned long long>(l.p50),
+                     static_cast<unsigned long long>(l.p95),
+                     static_cast<unsigned long long>(l.p99),
+                     static_cast<unsigned long long>(l.p999),
+                     static_cast<unsigned long long>(l.max),
+                     static_cast<unsigned long long>(l.sample_count));
+    }
+    std::fprintf(out, "}}%s\n", last ? "" : ",");
+}
+
+bool parse_options(int argc, char* argv[], BenchOptions& opts) {
+    for (int i = 1; i < argc; ++i) {
+        const char* arg = argv[i];
+        if (std::strncmp(arg, "--duration=", 11) == 0) {
+            opts.duration_s = std::max(1, std::atoi(arg + 11));
+        } else if (std::strncmp(arg, "--order-every=", 14) == 0) {
+            opts.order_every = static_cast<uint32_t>(std::max(1, std::atoi(arg + 14)));
+        } else if (std::strncmp(arg, "--out=", 6) == 0) {
+            opts.out_file = arg + 6;
+        } else if (std::strcmp(arg, "--quick") == 0) {
+            opts.quick = true;
+        } else {
+            std::fprintf(stderr, "Usage: %s [--duration=SEC] [--order-every=N] "
+                         "[--out=FILE] [--quick]\n", argv[0]);
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    BenchOptions opts;
+    if (!parse_options(argc, argv, opts)) {
+        return 1;
+    }
+
+    Logger::instance().set_level(LogLevel::WARN);
+    TscClock::start_calibration_thread();
+
+    // Order rate follows the quote rate (about half the ticks are quotes)
+    std::vector<RunConfig> configs;
+    if (opts.quick) {
+        configs.push_back({10000, 100});
+    } else {
+        for (uint32_t rate : {1000u, 10000u, 100000u}) {
+            configs.push_back({rate, 100});
+        }
+    }
+
+    std::printf("\n=== Tick-to-trade: order on every %u. quote ===\n", opts.order_every);
+    print_header();
+    std::vector<RunResult> results;
+    for (const auto& cfg : configs) {
+        results.push_back(run_once(cfg, opts));
+        print_result(results.back());
+    }
+
+    FILE* out = std::fopen(opts.out_file.c_str(), "w");
+    if (!out) {
+        std::fprintf(stderr, "Failed to open %s\n", opts.out_file.c_str());
+        return 1;
+    }
+    std::fprintf(out, "{\n  \"benchmark\": \"tick_to_trade\",\n  \"timestamp\": %lld,\n"
+                 "  \"duration_s\": %u,\n  \"order_every\": %u,\n  \"runs\": [\n",
+                 static_cast<long long>(std::time(nullptr)), opts.duration_s, opts.order_every);
+    for (size_t i = 0; i < results.size(); ++i) {
+        write_run_json(out, results[i], i + 1 == results.size());
+    }
+    std::fprintf(out, "  ]\n}\n");
+    std::fclose(out);
+
+    std::printf("\nResults written to %s\n", opts.out_file.c_str());
+    return 0;
+}
@@ -0,0 +1,99 @@
+#include <benchmark/benchmark.h>
+#include "perf_counters.h"
+#include "common/timing_wheel.h"
+#include <cmath>
+#include <functional>
+#include <queue>
+#include <random>
+#include <utility>
+#include <vector>
+
+using namespace mdfh;
+
+namespace {
+
+constexpr double TOTAL_RATE_PER_US = 1.0;   // 1M arrivals/sec over all symbols
+constexpr uint64_t WINDOW_US = 100;         // Clock advance per iteration
+constexpr size_t NUM_GAPS = 1 << 16;
+
+// Zipf (s = 1) arrival rates per microsecond, the simulator's skewed load
+std::vector<double> zipf_rates(size_t num_symbols) {
+    std::vector<double> rates(num_symbols);
+    double total = 0.0;
+    for (size_t i = 0; i < num_symbols; ++i) {
+        rates[i] = 1.0 / static_cast<double>(i + 1);
+        total += rates[i];
+    }
+    for (auto& r : rates) r *= TOTAL_RATE_PER_US / total;
+    return rates;
+}
+
+// Exp(1) samples, precomputed so only the scheduling is measured
+std::vector<double> unit_gaps() {
+    std::mt19937_64 rng(42);
+    std::exponential_distribution<double> exp(1.0);
+    std::vector<double> gaps(NUM_GAPS);
+    for (auto& g : gaps) g = exp(rng);
+    return gaps;
+}
+
+} // namespace
+
+// Benchmark: Poisson arrivals for every symbol through the timing wheel:
+// fire what is due and re-arm each symbol with its next gap (arg: symbols)
+static void BM_WheelArrivals(benchmark::State& state) {
+    size_t num_symbols = static_cast<size_t>(state.range(0));
+    auto rates = zipf_rates(num_symbols);
+    auto gaps = unit_gaps();
+    std::vector<double> next(num_symbols);
+    TimingWheel wheel(num_symbols);
+    size_t g = 0;
+    for (uint32_t s = 0; s < num_symbols; ++s) {
+        next[s] = gaps[g++ & (NUM_GAPS - 1)] / rates[s];
+        wheel.schedule(s, static_cast<uint64_t>(std::ceil(next[s])));
+    }
+
+    uint64_t now = 0;
+    uint64_t fired = 0;
+    bench::PerfScope perf(state);
+    for (auto _ : state) {
+        now += WINDOW_US;
+        fired += wheel.advance(now, [&](uint32_t s, uint64_t) {
+            next[s] += gaps[g++ & (NUM_GAPS - 1)] / rates[s];
+            wheel.schedule(s, static_cast<uint64_t>(std::ceil(next[s])));
+        });
+    }
+
+    state.SetItemsProcessed(static_cast<int64_t>(fired));
+}
+BENCHMARK(BM_WheelArrivals)->Arg(1000)->Arg(10000)->Arg(100000);
+
+// Benchmark: Baseline with a binary heap of (deadline, symbol), O(log n)
+// per arrival
+static void BM_HeapArrivals(benchmark::State& state) {
+    size_t num_symbols = static_cast<size_t>(state.range(0));
+    auto rates = zipf_rates(num_symbols);
+    auto gaps = unit_gaps();
+    using Entry = std::pair<double, uint32_t>;
+    std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> heap;
+    size_t g = 0;
+    for (uint32_t s = 0; s < num_symbols; ++s) {
+        heap.emplace(gaps[g++ & (NUM_GAPS - 1)] / rates[s], s);
+    }
+
+    double now = 0.0;
+    uint64_t fired = 0;
+    bench::PerfScope perf(state);
+    for (auto _ : state) {
+        now += WINDOW_US;
+        while (heap.top().first <= now) {
+            auto [at, s] = heap.top();
+            heap.pop();
+            heap.emplace(at + gaps[g++ & (NUM_GAPS - 1)] / rates[s], s);
+            fired++;
+        }
+    }
+
+    state.SetItemsProcessed(static_cast<int64_t>(fired));
+}
+BENCHMARK(BM_HeapArrivals)->Arg(1000)->Arg(10000)->Arg(100000);
@@ -0,0 +1,62 @@
+#include <benchmark/benchmark.h>
+#include "perf_counters.h"
+#include "common/trace.h"
+
+using namespace mdfh;
+
+// Benchmark: Scoped zone (two TSC reads + one ring store)
+static void BM_TraceZone(benchmark::State& state) {
+    bench::PerfScope perf(state);
+    for (auto _ : state) {
+        TraceZone zone(TraceZoneId::PARSE);
+        benchmark::ClobberMemory();
+    }
+    
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_TraceZone);
+
+// Benchmark: Pre-timestamped record (ring store only)
+static void BM_TraceRecord(benchmark::State& state) {
+    uint64_t t = TscClock::now_ticks();
+    
+    bench::PerfScope perf(state);
+    for (auto _ : state) {
+        Tracer::instance().record(TraceZoneId::SEND, t, t + 50);
+        t += 100;
+    }
+    
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_TraceRecord);
+
+// Benchmark: MDFH_TRACE_ZONE macro as configured by the build
+// (a no-op unless -DMDFH_TRACING=ON)
+static void BM_TraceZoneMacro(benchmark::State& state) {
+    bench::PerfScope perf(state);
+    for (auto _ : state) {
+        MDFH_TRACE_ZONE(DISPATCH);
+        benchmark::ClobberMemory();
+    }
+    
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_TraceZoneMacro);
+
+// Benchmark: Chrome JSON dump of a full buffer
+static void BM_TraceDump(benchmark::State& state) {
+    for (size_t i = 0; i < TraceBuffer::CAPACITY; ++i) {
+        Tracer::instance().record(TraceZoneId::RECEIVE, i * 100, i * 100 + 50);
+    }
+    
+    bench::PerfScope perf(state);
+    for (auto _ : state) {
+        bool ok = Tracer::instance().dump_chrome_json("/dev/null");
+        benchmark::DoNotOptimize(ok);
+    }
+    
+    state.SetItemsProcessed(state.iterations() * TraceBuffer::CAPACITY);
+}
+BENCHMARK(BM_TraceDump)->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
@@ -4,12 +4,23 @@
 #include "client/socket.h"
 #include "client/parser.h"
 #include "common/cache.h"
+#include "common/consolidated_book.h"
+#include "common/index_engine.h"
 #include "common/latency_tracker.h"
+#include "common/outlier_recorder.h"
+#include "common/symbol_map.h"
+#include "common/tsc_clock.h"
+#include "common/trace.h"
 #include <string>
+#include <vector>
+#include <cstring>
 #include <atomic>
 #include <thread>
+#include <mutex>
 #include <memory>
 #include <type_traits>
+#include <algorithm>
+#include <functional>
 
 namespace mdfh {
 
@@ -24,23 +35,72 @@ public:
     // Disconnect from server
     void disconnect();
     
-    // Start the feed handler
+    // Consume the same feed from a second, redundant connection (line B)
+    // and arbitrate per symbol between the two lines; call before start()
+    void set_line_b(const std::string& host, uint16_t port);
+    bool is_arbitrating() const { return lines_.size() > 1; }
+    
+    // Start the feed handler (succeeds if any line connects; the others
+    // keep reconnecting in the background)
     bool start();
     
     // Stop the feed handler
     void stop();
     
-    // Subscribe to symbols
-    bool subscribe(const std::vector<uint16_t>& symbol_ids);
+    // Subscribe to symbols; the list is remembered and re-sent (as a
+    // resume request) after every reconnect. Lists longer than
+    // MAX_SUBSCRIPTION_COUNT are refused.
+    bool subscribe(const std::vector<SymbolId>& symbol_ids);
     
-    // Load symbol names from CSV file
+    // Load symbol names from a symbols file (CSV or binary universe); call
+    // before start(). Ids that fill most of [0, num_symbols) map to
+    // themselves. Wide or sparse ids are remapped onto slots in file order
+    // (at most num_symbols of them) and the cache is rebuilt to that size,
+    // so take get_cache() after loading.
     bool load_symbols(const std::string& symbols_file);
     
     // Get symbol name by ID
-    std::string get_symbol_name(uint16_t symbol_id) const;
+    std::string get_symbol_name(SymbolId symbol_id) const;
     
-    // Get symbol cache for reading
+    // Get symbol cache for reading. It is indexed by local slot: use
+    // get_symbol_map().slot(symbol_id) (the identity unless load_symbols
+    // remapped a wide or sparse id space).
     const SymbolCache& get_cache() const { return *cache_; }
+    const SymbolMap& get_symbol_map() const { return symbol_map_; }
+    
+    // Also publish this feed's quotes into a multi-venue consolidated book
+    // as venue `venue`; the book must outlive the handler. Call before start().
+    // The book and the index engine take exchange ids and map them with
+    // their own SymbolMap (build them from get_symbol_map() for wide ids).
+    void set_consolidated_book(ConsolidatedBook* book, size_t venue) {
+        consolidated_book_ = book;
+        venue_ = venue;
+    }
+    
+    // Also feed this feed's trade prices into an index engine; the engine
+    // must outlive the handler. Call before start().
+    void set_index_engine(IndexEngine* engine) { index_engine_ = engine; }
+    
+    // Strategy hooks: called on the receiver thread right after a trade or
+    // quote has been applied to the cache (and counted in the latency
+    // stats), once per sequence number when arbitrating. They run on the
+    // hot path, so an order sent from here is the tick-to-trade reaction.
+    // Set before start().
+    void set_quote_callback(std::function<void(const QuoteMessage&)> callback) {
+        quote_callback_ = std::move(callback);
+    }
+    void set_trade_callback(std::function<void(const TradeMessage&)> callback) {
+        trade_callback_ = std::move(callback);
+    }
+    
+    // Run one received batch through parse -> dispatch -> cache update.
+    // Called from the receiver thread; in-process benchmarks call it directly
+    // to drive the hot path without a socket.
+    size_t process_batch(const void* data, size_t len,
+                         uint64_t receive_start_ticks, uint64_t receive_end_ticks,
+                         size_t line = 0);
+    
+    static constexpr size_t MAX_LINES = 2;
     
     struct FeedHandlerStats {
         uint64_t messages_received;
@@ -49,73 +109,315 @@ public:
         uint64_t sequence_gaps;
         uint64_t fragmented_messages;
         uint64_t checksum_errors;
+        uint64_t heartbeats_received;
+        uint64_t liveness_timeouts;
+        uint64_t reconnects;
+        uint64_t last_recovery_ns;   // Feed lost -> first message on the new connection
+        uint64_t max_recovery_ns;
+    };
+    
+    // A/B arbitration counters, indexed by line (0 = A, 1 = B)
+    struct ArbitrationStats {
+        uint64_t wins[MAX_LINES];             // Sequence numbers applied from this line first
+        uint64_t duplicates;                  // Copies dropped because the other line was first
+        uint64_t gaps_deferred;               // Copies held back on a line gap for the other line to fill
+        uint64_t restarts;                    // Symbol sequences restarted by a new server session
+        uint64_t line_gaps[MAX_LINES];        // Sequence gaps seen on each line on its own
+        LatencyStats advantage[MAX_LINES];    // How far this line's wins led the other copy (ns)
     };
     
     // Get statistics
     uint64_t get_messages_received() const { return messages_received_; }
     uint64_t get_bytes_received() const { return bytes_received_; }
     LatencyStats get_latency_stats() const { return latency_tracker_->get_stats(); }
+    // Exchange timestamp to dispatch end (requires a shared clock with the server)
+    LatencyStats get_end_to_end_latency_stats() const { return end_to_end_tracker_->get_stats(); }
     FeedHandlerStats get_stats() const;
+    ArbitrationStats get_arbitration_stats() const;
+    
+    // Tail-latency outliers captured with per-message context
+    OutlierRecorder& get_outlier_recorder() { return *outlier_recorder_; }
+    const OutlierRecorder& get_outlier_recorder() const { return *outlier_recorder_; }
     
-    // Connection status
+    // Connection status (any line)
     bool is_connected() const;
     
+    // Treat the feed as dead after this long without any bytes (heartbeats
+    // included) and reconnect; 0 disables the check
+    void set_liveness_timeout_ms(uint32_t timeout_ms) { liveness_timeout_ms_ = timeout_ms; }
+    uint32_t get_liveness_timeout_ms() const { return liveness_timeout_ms_; }
+    
+    static constexpr uint32_t DEFAULT_LIVENESS_TIMEOUT_MS = 3000;
+    
 private:
+    // Reconnect state machine (receiver thread only). WAITING: backing off
+    // until next_attempt_ns; CONNECTING: non-blocking connect in flight.
+    enum class ReconnectState {
+        WAITING,
+        CONNECTING
+    };
+    
+    // One connection to the feed with its own framing and sequence state
+    struct Line {
+        size_t index = 0;                   // 0 = A, 1 = B
+        std::string host;
+        uint16_t port = 0;
+        std::unique_ptr<MarketDataSocket> socket;
+        std::unique_ptr<BinaryParser> parser;
+        std::unique_ptr<LatencyTracker> advantage;  // Lead of this line's wins
+        
+        // Receiver thread only
+        uint64_t last_receive_ticks = 0;
+        bool live = false;
+        ReconnectState reconnect_state = ReconnectState::WAITING;
+        uint64_t next_attempt_ns = 0;
+        uint64_t connect_deadline_ns = 0;
+        uint32_t backoff_ms = 0;
+        uint32_t reconnect_attempts = 0;
+        uint64_t feed_lost_ns = 0;
+        bool recovering = false;            // Reconnected, waiting for the first message
+        uint32_t session = 0;               // Connections made so far; a new server session needs one
+        
+        std::atomic<uint64_t> wins{0};
+    };
+    
+    // A copy held back at a line gap, applied once the gap is filled or
+    // found to be lost on both lines
+    struct DeferredMessage {
+        uint32_t seq;
+        uint8_t line;
+        MessageType type;                   // TRADE or QUOTE
+        uint64_t receive_ticks;
+        uint8_t bytes[sizeof(QuoteMessage)];
+    };
+    
+    // Per-symbol arbitration state (receiver thread only). Recent wins are
+    // kept in a small ring indexed by sequence so a late copy can still be
+    // matched to its winner when the other line trails by a few messages.
+    static constexpr size_t WIN_HISTORY = 4;
+    struct ArbitrationState {
+        uint32_t applied_seq = 0;           // Last sequence applied to the cache
+        uint32_t line_seq[MAX_LINES] = {};  // Last sequence seen on each line
+        uint32_t line_session[MAX_LINES] = {};  // Line::session that carried it
+        uint32_t win_seq[WIN_HISTORY] = {};
+        uint8_t win_line[WIN_HISTORY] = {};
+        uint64_t win_ticks[WIN_HISTORY] = {};
+        
+        // Held copies in sequence order, all from one line; entries before
+        // deferred_head are already applied or dropped
+        std::vector<DeferredMessage> deferred;
+        size_t deferred_head = 0;
+    };
+    
+    // What arbitration does with one copy
+    enum class Verdict {
+        APPLY,      // First copy of its sequence: apply it now
+        DROP,       // The other line was first
+        DEFER       // Line gap: hold it until the other line fills the gap
+    };
+    
     std::string host_;
     uint16_t port_;
     size_t num_symbols_;
+    SymbolMap symbol_map_;              // Exchange id -> local slot
     
-    std::unique_ptr<MarketDataSocket> socket_;
-    std::unique_ptr<BinaryParser> parser_;
+    std::vector<std::unique_ptr<Line>> lines_;
     std::unique_ptr<SymbolCache> cache_;
+    ConsolidatedBook* consolidated_book_ = nullptr;
+    IndexEngine* index_engine_ = nullptr;
+    size_t venue_ = 0;
+    std::function<void(const QuoteMessage&)> quote_callback_;
+    std::function<void(const TradeMessage&)> trade_callback_;
     std::unique_ptr<LatencyTracker> latency_tracker_;
+    std::unique_ptr<LatencyTracker> end_to_end_tracker_;
+    std::unique_ptr<OutlierRecorder> outlier_recorder_;
     
     std::atomic<bool> running_;
     std::atomic<uint64_t> messages_received_;
     std::atomic<uint64_t> bytes_received_;
+    std::atomic<uint64_t> heartbeats_received_;
+    std::atomic<uint64_t> liveness_timeouts_;
+    std::atomic<uint32_t> liveness_timeout_ms_;
+    std::atomic<uint64_t> reconnects_;
+    std::atomic<uint64_t> last_recovery_ns_;
+    std::atomic<uint64_t> max_recovery_ns_;
+    std::atomic<uint64_t> duplicates_;
+    std::atomic<uint64_t> gaps_deferred_;
+    std::atomic<uint64_t> arbitrated_gaps_;
+    std::atomic<uint64_t> restarts_;
     
-    // Symbol names loaded from CSV file
+    // Current subscription; also serializes control-path socket calls
+    // (connect, disconnect, subscription sends) across threads
+    std::mutex control_mutex_;
+    std::vector<SymbolId> subscription_;
+    
+    // Symbol names loaded from CSV file, indexed by slot
     std::vector<std::string> symbol_names_;
     
     std::thread receiver_thread_;
     
+    // Current receive batch (receiver thread only)
+    Line* batch_line_ = nullptr;
+    uint64_t batch_receive_start_ = 0;
+    uint64_t batch_receive_end_ = 0;
+    uint32_t batch_bytes_ = 0;
+    uint32_t batch_index_ = 0;
+    
+    // A/B arbitration (receiver thread only; empty with a single line),
+    // indexed by slot
+    std::vector<ArbitrationState> arbitration_;
+    
     // Reconnection parameters
-    static constexpr int MAX_RECONNECT_ATTEMPTS = 10;
-    static constexpr int INITIAL_BACKOFF_MS = 100;
-    static constexpr int MAX_BACKOFF_MS = 30000;
+    static constexpr uint32_t INITIAL_BACKOFF_MS = 100;
+    static constexpr uint32_t MAX_BACKOFF_MS = 30000;
+    static constexpr uint32_t CONNECT_TIMEOUT_MS = 1000;
+    
+    // A line gap is left to the other line to fill only while that line
+    // trails by at most this many sequence numbers, and at most this many
+    // copies are held back per symbol meanwhile
+    static constexpr uint32_t MAX_DEFERRED_SEQS = 64;
+    
+    // Create a line and route its parser into the shared dispatch path
+    void add_line(const std::string& host, uint16_t port);
     
     // Receiver loop
     void receiver_loop();
     
-    // Reconnection with exponential backoff
-    bool reconnect();
+    // Service one line: reconnect, receive, liveness. Returns bytes received.
+    ssize_t poll_line(Line& line, uint8_t* buffer, size_t buffer_size);
     
-    // Template-based generic message handler (compile-time dispatch)
+    // Advance a line's reconnect state machine by one non-blocking step
+    void reconnect_step(Line& line);
+    void schedule_reconnect(Line& line, uint64_t now_ns);
+    
+    // New connection: reset the parser and resume the subscription
+    void on_reconnected(Line& line);
+    
+    // First message after a reconnect: record the recovery time
+    void on_recovered(Line& line, uint64_t now_ns);
+    
+    // A line lost its connection or timed out; symbols go stale once no
+    // line is live
+    void on_feed_lost(Line& line, const char* reason);
+    
+    // Last sequence applied to the cache for a symbol (resume point)
+    uint32_t get_resume_sequence(const Line& line, SymbolId symbol_id) const;
+    
+    // Decide whether this copy is the first of its sequence number. Copies
+    // held back earlier go out first if the gap before them turns out to
+    // be lost on both lines.
+    Verdict arbitrate(size_t line, const MessageHeader& header, uint32_t symbol_slot);
+    
+    // Hold a copy back at a line gap (arbitrate() returned DEFER)
+    template<typename MessageT>
+    void defer(size_t line, const MessageT& msg, uint32_t symbol_slot);
+    
+    // Apply held copies that are next in sequence. With skip_gap the first
+    // one is applied even though the sequences before it are lost.
+    void release_deferred(uint32_t symbol_slot, bool skip_gap);
+    
+    // Mark a sequence as applied from a line and credit the line's win
+    void record_win(ArbitrationState& state, size_t line, uint32_t seq, uint64_t receive_ticks);
+    
+    // Apply one message: cache update, latency tracking, strategy callbacks
     template<typename MessageT>
-    void handle_message(const MessageT& msg);
+    void dispatch(const MessageT& msg, uint32_t symbol_slot, uint64_t dispatch_start);
+    
+    // Template-based generic message handler (compile-time dispatch);
+    // symbol_slot is the message's local slot (NO_SLOT if untracked)
+    template<typename MessageT>
+    void handle_message(const MessageT& msg, uint32_t symbol_slot);
+    
+    // Record end-to-end latency and compare per-message stage timings
+    // against the outlier thresholds
+    inline void track_message_latency(const MessageHeader& header,
+                                      uint64_t dispatch_start, uint64_t dispatch_end);
+    
+    // Slow path: build and store the outlier record
+    void capture_outlier(const MessageHeader& header, uint64_t dispatch_end,
+                         uint64_t end_to_end_ns, uint64_t receive_ns,
+                         uint64_t queue_ns, uint64_t dispatch_ns, uint32_t batch_index);
 };
 
+template<typename MessageT>
+void FeedHandler::dispatch(const MessageT& msg, uint32_t symbol_slot, uint64_t dispatch_start) {
+    handle_message(msg, symbol_slot);
+    track_message_latency(msg.header, dispatch_start, TscClock::now_ticks());
+    
+    // Strategy reaction after the cache is current
+    if constexpr (std::is_same_v<MessageT, QuoteMessage>) {
+        if (quote_callback_) quote_callback_(msg);
+    } else if constexpr (std::is_same_v<MessageT, TradeMessage>) {
+        if (trade_callback_) trade_callback_(msg);
+    }
+}
+
+template<typename MessageT>
+void FeedHandler::defer(size_t line, const MessageT& msg, uint32_t symbol_slot) {
+    static_assert(sizeof(MessageT) <= sizeof(DeferredMessage::bytes), "message too large to defer");
+    DeferredMessage& entry = arbitration_[symbol_slot].deferred.emplace_back();
+    entry.seq = msg.header.seq_num;
+    entry.line = static_cast<uint8_t>(line);
+    entry.type = static_cast<MessageType>(msg.header.msg_type);
+    entry.receive_ticks = batch_receive_end_;
+    std::memcpy(entry.bytes, &msg, sizeof(MessageT));
+}
+
 // Template implementation for generic low-latency message handler
 template<typename MessageT>
-void FeedHandler::handle_message(const MessageT& msg) {
+void FeedHandler::handle_message(const MessageT& msg, uint32_t symbol_slot) {
     messages_received_++;
+    MDFH_TRACE_ZONE(CACHE_UPDATE);
     
     // Compile-time type dispatch using if constexpr (C++17)
     // This has ZERO runtime overhead compared to separate functions
     if constexpr (std::is_same_v<MessageT, TradeMessage>) {
         // Trade-specific handling
-        cache_->update_trade(msg.header.symbol_id, 
+        cache_->update_trade(symbol_slot,
                             msg.payload.price,
                             msg.payload.quantity);
+        if (index_engine_) {
+            index_engine_->update_price(msg.header.symbol_id, msg.payload.price);
+        }
     } else if constexpr (std::is_same_v<MessageT, QuoteMessage>) {
         // Quote-specific handling
-        cache_->update_quote(msg.header.symbol_id,
+        cache_->update_quote(symbol_slot,
                             msg.payload.bid_price,
                             msg.payload.bid_qty,
                             msg.payload.ask_price,
                             msg.payload.ask_qty);
+        if (consolidated_book_) {
+            consolidated_book_->update_quote(venue_, msg.header.symbol_id,
+                                             msg.payload.bid_price,
+                                             msg.payload.bid_qty,
+                                             msg.payload.ask_price,
+                                             msg.payload.ask_qty,
+                                             batch_receive_end_);
+        }
     } else if constexpr (std::is_same_v<MessageT, HeartbeatMessage>) {
-        // Heartbeat - no action needed
+        // Heartbeat - the receive itself refreshed the liveness timer
+        heartbeats_received_.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+inline void FeedHandler::track_message_latency(const MessageHeader& header,
+                                               uint64_t dispatch_start, uint64_t dispatch_end) {
+    uint32_t batch_index = batch_index_++;
+    
+    // Exchange timestamps are wall-clock ns; only meaningful on a shared clock
+    uint64_t now_wall = TscClock::to_wall_ns(dispatch_end);
+    uint64_t exchange_ts = header.timestamp;
+    uint64_t end_to_end_ns = now_wall > exchange_ts ? now_wall - exchange_ts : 0;
+    end_to_end_tracker_->record(end_to_end_ns);
+    
+    uint64_t receive_ns = TscClock::delta_to_ns(batch_receive_end_ - batch_receive_start_);
+    uint64_t queue_ns = TscClock::delta_to_ns(dispatch_start - batch_receive_end_);
+    uint64_t dispatch_ns = TscClock::delta_to_ns(dispatch_end - dispatch_start);
+    uint64_t max_stage_ns = std::max(receive_ns, std::max(queue_ns, dispatch_ns));
+    
+    if (__builtin_expect(outlier_recorder_->is_outlier(end_to_end_ns, max_stage_ns), 0)) {
+        capture_outlier(header, dispatch_end, end_to_end_ns, receive_ns,
+                        queue_ns, dispatch_ns, batch_index);
     }
 }
 
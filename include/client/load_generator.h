@@ -0,0 +1,120 @@
+#ifndef LOAD_GENERATOR_H
+#define LOAD_GENERATOR_H
+
+#include "common/protocol.h"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <atomic>
+#include <thread>
+#include <memory>
+
+namespace mdfh {
+
+struct LoadGeneratorConfig {
+    std::string host = "127.0.0.1";
+    uint16_t port = 9876;
+    size_t num_connections = 1000;
+    size_t num_threads = 4;           // epoll threads; connections are spread round-robin
+    size_t num_symbols = 100;         // Subscriptions are drawn from [0, num_symbols)
+    size_t min_subscriptions = 1;     // Symbols per connection, uniform in [min, max]
+    size_t max_subscriptions = 10;
+    size_t connect_batch = 128;       // Connects initiated per thread per loop pass
+    bool validate = false;            // Verify checksums (framing and gaps are always tracked)
+    uint64_t seed = 1;                // Subscription sets are reproducible per seed
+};
+
+// Per-connection counters (snapshot)
+struct ConnectionStats {
+    uint32_t id;
+    bool connected;
+    uint16_t subscriptions;
+    uint64_t messages;
+    uint64_t bytes;
+    uint64_t sequence_gaps;
+    uint64_t checksum_errors;         // Only counted with validate=true
+    uint64_t malformed;               // Framing resyncs, unknown or unsubscribed symbols
+    uint64_t connected_ns;            // steady_clock time the connect completed (0 = never)
+    uint64_t disconnected_ns;         // steady_clock time of disconnect (0 = still open)
+    
+    // Messages per second over the connection's lifetime up to now_ns
+    double message_rate(uint64_t now_ns) const {
+        uint64_t end = disconnected_ns ? disconnected_ns : now_ns;
+        if (connected_ns == 0 || end <= connected_ns) return 0.0;
+        return static_cast<double>(messages) * 1e9 / static_cast<double>(end - connected_ns);
+    }
+};
+
+struct LoadGeneratorStats {
+    uint64_t connections_open;
+    uint64_t connect_failures;
+    uint64_t disconnects;
+    uint64_t messages;
+    uint64_t bytes;
+    uint64_t sequence_gaps;
+    uint64_t checksum_errors;
+    uint64_t malformed;
+};
+
+// Lightweight many-connection client for stressing the server's fan-out.
+// A few epoll threads each own a slice of non-blocking connections, send a
+// randomized 0xFF subscription once connected, then drain and frame the
+// stream without touching a cache or parser. Counters are per connection and
+// updated once per recv, so draining costs a header read per message.
+class LoadGenerator {
+public:
+    explicit LoadGenerator(const LoadGeneratorConfig& config);
+    ~LoadGenerator();
+
+    LoadGenerator(const LoadGenerator&) = delete;
+    LoadGenerator& operator=(const LoadGenerator&) = delete;
+
+    // Spawn the worker threads; connections are opened asynchronously
+    bool start();
+
+    // Stop the workers and close all connections
+    void stop();
+
+    bool is_running() const { return running_.load(std::memory_order_acquire); }
+
+    // Statistics (safe to call while running)
+    LoadGeneratorStats get_stats() const;
+    std::vector<ConnectionStats> get_connection_stats() const;
+
+    // Write one row per connection
+    bool export_to_csv(const std::string& path) const;
+
+    // Subscriptions are kept to one 1024-byte message (32-bit ids) so the
+    // server reads each in a single recv
+    static constexpr size_t MAX_SUBSCRIPTION_SYMBOLS =
+        (1024 - sizeof(SubscriptionHeader)) / sizeof(SymbolId);
+    // Subscriptions are drawn from [0, num_symbols), num_symbols up to this
+    static constexpr size_t MAX_SYMBOLS = size_t{1} << 24;
+
+private:
+    struct Connection;
+    struct Worker;
+    struct BatchCounters;
+
+    void worker_loop(Worker& worker);
+    bool initiate_connect(Worker& worker, Connection& conn);
+    void on_connected(Worker& worker, Connection& conn);
+    void drain(Worker& worker, Connection& conn);
+    void close_connection(Worker& worker, Connection& conn, bool failed);
+    void consume(Connection& conn, const uint8_t* data, size_t len);
+    void on_message(Connection& conn, const uint8_t* msg, size_t size, BatchCounters& counters);
+
+    LoadGeneratorConfig config_;
+    uint32_t server_addr_;            // Network byte order
+    std::vector<std::unique_ptr<Connection>> connections_;
+    std::vector<std::unique_ptr<Worker>> workers_;
+    std::atomic<bool> running_;
+
+    std::atomic<uint64_t> connect_failures_{0};
+    std::atomic<uint64_t> disconnects_{0};
+};
+
+} // namespace mdfh
+
+#endif // LOAD_GENERATOR_H
@@ -0,0 +1,71 @@
+#ifndef ORDER_SENDER_H
+#define ORDER_SENDER_H
+
+#include "client/socket.h"
+#include "common/protocol.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <atomic>
+#include <functional>
+
+namespace mdfh {
+
+// Client side of an order entry session with the simulator's order
+// gateway. Orders are written straight to the socket from the calling
+// thread (typically a FeedHandler quote/trade callback); acknowledgements
+// are read by poll_acks(). One thread may send while another polls.
+class OrderSender {
+public:
+    OrderSender();
+    ~OrderSender();
+
+    OrderSender(const OrderSender&) = delete;
+    OrderSender& operator=(const OrderSender&) = delete;
+
+    // Connect to the order port (blocks up to timeout_ms)
+    bool connect(const std::string& host, uint16_t port, uint32_t timeout_ms = 5000);
+    void disconnect();
+    bool is_connected() const { return socket_.is_connected(); }
+
+    // Send a new order; trigger_timestamp is the exchange timestamp of the
+    // tick it reacts to and comes back in the ack. Returns the client order
+    // id, or 0 if the send failed. price is ignored for market orders.
+    uint64_t send_new_order(SymbolId symbol_id, OrderSide side, OrderType type,
+                            double price, uint32_t quantity, uint64_t trigger_timestamp = 0);
+
+    // Cancel an order sent on this session
+    bool send_cancel(SymbolId symbol_id, uint64_t client_order_id);
+
+    // Deliver received acks to handler. Waits up to timeout_ms for data
+    // (0 = don't wait). Returns the number of acks delivered, or -1 once
+    // the session is closed.
+    int poll_acks(const std::function<void(const OrderAckMessage&)>& handler, int timeout_ms = 0);
+
+    uint64_t get_orders_sent() const { return orders_sent_.load(std::memory_order_relaxed); }
+    uint64_t get_cancels_sent() const { return cancels_sent_.load(std::memory_order_relaxed); }
+    uint64_t get_acks_received() const { return acks_received_.load(std::memory_order_relaxed); }
+    uint64_t get_checksum_errors() const { return checksum_errors_.load(std::memory_order_relaxed); }
+
+private:
+    bool send_message(const void* msg, size_t len);
+
+    MarketDataSocket socket_;
+
+    // Sending thread
+    uint64_t next_client_order_id_ = 0;
+    uint32_t send_seq_ = 0;
+
+    // Polling thread
+    std::vector<uint8_t> rx_buffer_;
+    size_t rx_len_ = 0;
+
+    std::atomic<uint64_t> orders_sent_{0};
+    std::atomic<uint64_t> cancels_sent_{0};
+    std::atomic<uint64_t> acks_received_{0};
+    std::atomic<uint64_t> checksum_errors_{0};
+};
+
+} // namespace mdfh
+
+#endif // ORDER_SENDER_H
@@ -2,6 +2,7 @@
 #define PARSER_H
 
 #include "common/protocol.h"
+#include "common/symbol_map.h"
 #include <cstdint>
 #include <functional>
 #include <vector>
@@ -28,11 +29,32 @@ public:
     uint64_t get_malformed_messages() const { return malformed_messages_; }
     uint64_t get_fragmented_count() const { return fragmented_messages_; }
     
+    // Bytes currently buffered (includes the message being dispatched)
+    size_t get_buffer_fill() const { return buffer_pos_; }
+    
+    // Track per-symbol sequences by the map's slots instead of by id, so
+    // wide ids need no id-sized array; the map must outlive the parser.
+    // Messages for ids outside the map are dispatched but not sequence-checked.
+    void set_symbol_map(const SymbolMap* map) { symbol_map_ = map; }
+    
+    // Last sequence number processed for a symbol (0 = none yet)
+    uint32_t get_last_sequence(SymbolId symbol_id) const {
+        uint32_t index = sequence_index(symbol_id);
+        return index < last_seq_by_symbol_.size() ? last_seq_by_symbol_[index] : 0;
+    }
+    
     // Reset parser state
     void reset();
     
+    // Drop a partially received message (after a reconnect); keeps the
+    // per-symbol sequences so the new stream is checked against the old one
+    void reset_buffer() { buffer_pos_ = 0; }
+    
 private:
     static constexpr size_t MAX_MESSAGE_SIZE = 1024;
+    
+    // Without a symbol map, sequences are tracked by id for ids up to this
+    static constexpr uint32_t MAX_UNMAPPED_ID = (1u << 24) - 1;
     static constexpr size_t BUFFER_SIZE = 65536;
     
     // Fragmentation buffer
@@ -48,7 +70,15 @@ private:
     uint64_t checksum_errors_;
     uint64_t malformed_messages_;
     uint64_t fragmented_messages_;
-    uint32_t last_seq_num_;
+    
+    // Last sequence number seen per symbol (sequences are per symbol),
+    // indexed by slot with a symbol map and by id without one
+    std::vector<uint32_t> last_seq_by_symbol_;
+    const SymbolMap* symbol_map_ = nullptr;
+    
+    uint32_t sequence_index(SymbolId symbol_id) const {
+        return symbol_map_ ? symbol_map_->slot(symbol_id) : symbol_id;
+    }
     
     // Parse a complete message from buffer
     bool try_parse_message();
@@ -1,6 +1,7 @@
 #ifndef MARKET_DATA_SOCKET_H
 #define MARKET_DATA_SOCKET_H
 
+#include "common/protocol.h"
 #include <string>
 #include <vector>
 #include <cstdint>
@@ -10,18 +11,37 @@ namespace mdfh {
 
 class MarketDataSocket {
 public:
+    enum class ConnectStatus {
+        CONNECTED,
+        IN_PROGRESS,
+        FAILED
+    };
+    
     MarketDataSocket();
     ~MarketDataSocket();
     
-    // Connect to exchange feed
+    // Connect to exchange feed (blocks up to timeout_ms)
     bool connect(const std::string& host, uint16_t port, 
                  uint32_t timeout_ms = 5000);
     
+    // Non-blocking connect: start_connect() issues the connect and
+    // poll_connect() checks for completion without waiting
+    ConnectStatus start_connect(const std::string& host, uint16_t port);
+    ConnectStatus poll_connect();
+    
+    // A non-blocking connect was started and has not completed yet
+    bool is_connecting() const { return sockfd_ >= 0 && !connected_; }
+    
     // Non-blocking receive into pre-allocated buffer
     ssize_t receive(void* buffer, size_t max_len);
     
-    // Send subscription request
-    bool send_subscription(const std::vector<uint16_t>& symbol_ids);
+    // Send subscription request; lists over MAX_SUBSCRIPTION_COUNT are refused
+    bool send_subscription(const std::vector<SymbolId>& symbol_ids);
+    
+    // Send resume request: subscribe to symbol_ids and replay everything
+    // after last_seqs[i] (parallel to symbol_ids; 0 = no replay)
+    bool send_resume(const std::vector<SymbolId>& symbol_ids,
+                     const std::vector<uint32_t>& last_seqs);
     
     // Connection management
     bool is_connected() const;
@@ -42,6 +62,12 @@ private:
     
     bool set_nonblocking(int fd);
     bool wait_for_connection(int fd, uint32_t timeout_ms);
+    bool finish_connect();
+    void abort_connect();
+    
+    // Send a whole request, waiting up to SEND_TIMEOUT_MS per stall
+    bool send_request(const std::vector<uint8_t>& msg);
+    static constexpr int SEND_TIMEOUT_MS = 1000;
 };
 
 } // namespace mdfh
@@ -2,6 +2,7 @@
 #define VISUALIZER_H
 
 #include "common/cache.h"
+#include "common/protocol.h"
 #include "common/latency_tracker.h"
 #include <string>
 #include <vector>
@@ -12,7 +13,7 @@
 namespace mdfh {
 
 struct SymbolDisplay {
-    uint16_t symbol_id;
+    SymbolId symbol_id;
     std::string symbol_name;
     double bid;
     double ask;
@@ -20,6 +21,7 @@ struct SymbolDisplay {
     uint64_t volume;
     double change_pct;
     uint64_t update_count;
+    bool stale = false;
 };
 
 class Visualizer {
@@ -2,6 +2,7 @@
 #define CACHE_H
 
 #include <cstdint>
+#include <cstddef>
 #include <atomic>
 #include <vector>
 #include <array>
@@ -17,14 +18,15 @@ struct alignas(64) MarketState {
     uint32_t ask_quantity;
     double last_traded_price;
     uint32_t last_traded_quantity;
-    uint64_t last_update_time;
+    uint64_t last_update_time;  // Raw TscClock ticks
     uint64_t update_count;
+    bool stale;                 // Feed lost since the last update
     
     MarketState() 
         : sequence(0), best_bid(0.0), best_ask(0.0), 
           bid_quantity(0), ask_quantity(0),
           last_traded_price(0.0), last_traded_quantity(0),
-          last_update_time(0), update_count(0) {}
+          last_update_time(0), update_count(0), stale(false) {}
 };
 
 // Snapshot for consistent reads
@@ -35,38 +37,47 @@ struct MarketSnapshot {
     uint32_t ask_quantity;
     double last_traded_price;
     uint32_t last_traded_quantity;
-    uint64_t last_update_time;
+    uint64_t last_update_time;  // Nanoseconds (CLOCK_MONOTONIC_RAW timebase)
     uint64_t update_count;
+    bool stale;                 // Values predate a feed loss; not current
 };
 
+// One cache line per symbol in a flat array, indexed by the client's dense
+// local slot (see SymbolMap), not by exchange id.
 class SymbolCache {
 public:
     explicit SymbolCache(size_t num_symbols);
     ~SymbolCache();
     
     // Writer operations (single writer thread)
-    void update_bid(uint16_t symbol_id, double price, uint32_t quantity);
-    void update_ask(uint16_t symbol_id, double price, uint32_t quantity);
-    void update_trade(uint16_t symbol_id, double price, uint32_t quantity);
-    void update_quote(uint16_t symbol_id, double bid_price, uint32_t bid_qty,
+    void update_bid(uint32_t slot, double price, uint32_t quantity);
+    void update_ask(uint32_t slot, double price, uint32_t quantity);
+    void update_trade(uint32_t slot, double price, uint32_t quantity);
+    void update_quote(uint32_t slot, double bid_price, uint32_t bid_qty,
                       double ask_price, uint32_t ask_qty);
     
+    // Staleness (writer thread). Any update clears the flag again.
+    void mark_stale(uint32_t slot);
+    void mark_all_stale();
+    
     // Reader operations (lock-free, multiple readers)
-    MarketSnapshot get_snapshot(uint16_t symbol_id) const;
-    double get_bid(uint16_t symbol_id) const;
-    double get_ask(uint16_t symbol_id) const;
-    double get_ltp(uint16_t symbol_id) const;
+    MarketSnapshot get_snapshot(uint32_t slot) const;
+    double get_bid(uint32_t slot) const;
+    double get_ask(uint32_t slot) const;
+    double get_ltp(uint32_t slot) const;
+    bool is_stale(uint32_t slot) const;
     
     // Statistics
     size_t get_num_symbols() const { return num_symbols_; }
     uint64_t get_total_updates() const;
+    size_t get_stale_count() const;
     
 private:
     size_t num_symbols_;
     std::vector<MarketState> states_;
     
-    bool is_valid_symbol(uint16_t symbol_id) const {
-        return symbol_id < num_symbols_;
+    bool is_valid_symbol(uint32_t slot) const {
+        return slot < num_symbols_;
     }
 };
 
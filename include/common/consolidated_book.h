@@ -0,0 +1,114 @@
+#ifndef CONSOLIDATED_BOOK_H
+#define CONSOLIDATED_BOOK_H
+
+#include "common/protocol.h"
+#include "common/symbol_map.h"
+#include <cstdint>
+#include <cstddef>
+#include <atomic>
+#include <vector>
+
+namespace mdfh {
+
+// Consolidated best bid/offer per symbol across several venues, each fed by
+// its own FeedHandler. Every venue quote replaces that venue's top of book
+// and updates the symbol's best incrementally: O(1) unless the venue that
+// was at the best price backs off, in which case that side is rebuilt from
+// the symbol's venue slots (O(venues)). No venue cache is rescanned. Reads use the same seqlock protocol
+// as SymbolCache; because each venue writes from its own receiver thread,
+// writers take the seqlock by CAS (even -> odd) and exclude each other
+// per symbol.
+//
+// Symbols are exchange ids throughout; the book keeps its own SymbolMap,
+// since the venues' feed handlers may each map ids to different slots.
+class ConsolidatedBook {
+public:
+    static constexpr uint8_t NO_VENUE = 0xFF;
+    static constexpr size_t MAX_VENUES = 16;
+
+    // Symbols 0..num_symbols-1
+    ConsolidatedBook(size_t num_symbols, size_t num_venues);
+    // The symbols in the map (e.g. a feed handler's); quotes for other ids
+    // are ignored
+    ConsolidatedBook(SymbolMap symbols, size_t num_venues);
+
+    ConsolidatedBook(const ConsolidatedBook&) = delete;
+    ConsolidatedBook& operator=(const ConsolidatedBook&) = delete;
+
+    // Writer operations (one writer thread per venue). A zero price or
+    // quantity means the venue has no order on that side. receive_ticks is
+    // the TscClock time the venue's data arrived (the caller already has it;
+    // a second clock read would cost as much as the update itself).
+    void update_quote(size_t venue, SymbolId symbol_id, double bid_price, uint32_t bid_qty,
+                      double ask_price, uint32_t ask_qty, uint64_t receive_ticks);
+
+    // Drop a venue's quotes from every symbol (its feed was lost); they come
+    // back with the venue's next quote per symbol
+    void mark_venue_stale(size_t venue);
+
+    // Reader operations (lock-free, multiple readers)
+    struct Snapshot {
+        double best_bid;
+        double best_ask;
+        uint32_t bid_quantity;      // Aggregated over venues at the best price
+        uint32_t ask_quantity;
+        uint8_t bid_venue;          // Largest size at the best price; NO_VENUE if none
+        uint8_t ask_venue;
+        uint8_t bid_venue_count;    // Venues quoting the best price
+        uint8_t ask_venue_count;
+        uint64_t last_update_time;  // Receive time of the last venue quote, ns (CLOCK_MONOTONIC_RAW timebase)
+        uint64_t update_count;
+        bool stale;                 // No venue currently quotes this symbol
+    };
+
+    Snapshot get_snapshot(SymbolId symbol_id) const;
+
+    size_t get_num_symbols() const { return symbol_map_.size(); }
+    size_t get_num_venues() const { return num_venues_; }
+
+private:
+    // One venue's top of book for one symbol
+    struct VenueQuote {
+        double bid_price = 0.0;
+        double ask_price = 0.0;
+        uint32_t bid_qty = 0;
+        uint32_t ask_qty = 0;
+        bool live = false;
+    };
+
+    // Best price on one side of a symbol
+    struct Side {
+        double price = 0.0;
+        uint32_t quantity = 0;      // Aggregated over venues at price
+        uint32_t top_quantity = 0;  // Size of the attributed venue
+        uint8_t venue = NO_VENUE;
+        uint8_t venue_count = 0;
+    };
+
+    struct alignas(64) State {
+        std::atomic<uint64_t> sequence{0};  // Seqlock: odd = writing, even = stable
+        Side bid;
+        Side ask;
+        uint8_t live_venues = 0;
+        uint64_t last_update_time = 0;      // Raw TscClock ticks
+        uint64_t update_count = 0;
+    };
+
+    uint64_t lock(State& state);
+    void unlock(State& state, uint64_t seq);
+
+    template<bool IsBid>
+    void update_side(Side& side, const VenueQuote* quotes, size_t venue,
+                     double old_price, uint32_t old_qty, bool was_live);
+    template<bool IsBid>
+    void rebuild_side(Side& side, const VenueQuote* quotes);
+
+    SymbolMap symbol_map_;
+    size_t num_venues_;
+    std::vector<State> states_;       // Indexed by slot
+    std::vector<VenueQuote> quotes_;  // [slot * num_venues + venue]; guarded by the symbol's seqlock
+};
+
+} // namespace mdfh
+
+#endif // CONSOLIDATED_BOOK_H
@@ -0,0 +1,154 @@
+#ifndef INDEX_ENGINE_H
+#define INDEX_ENGINE_H
+
+#include "common/protocol.h"
+#include "common/symbol_map.h"
+#include <cstdint>
+#include <cstddef>
+#include <atomic>
+#include <string>
+#include <vector>
+
+namespace mdfh {
+
+class SymbolCache;
+
+enum class IndexWeighting : uint8_t {
+    PRICE = 0,                  // Sum of weight * price (weight = shares, usually 1)
+    FREE_FLOAT_MARKET_CAP = 1   // Sum of shares * free_float * price
+};
+
+struct IndexConstituent {
+    SymbolId symbol_id;
+    double shares;              // Shares outstanding, or the weight factor when price weighted
+    double free_float;          // Investable fraction 0..1 (market cap weighting only)
+};
+
+struct IndexDefinition {
+    std::string name;
+    IndexWeighting weighting;
+    double base_value;          // Index level when every constituent first has a price
+    std::vector<IndexConstituent> constituents;
+};
+
+// Live weighted indices over the symbol universe. Each index is a sum of
+// coefficient * price over its constituents divided by a divisor, and a
+// price update moves every index containing the symbol by
+// coefficient * (new - old): O(1) per (constituent, index) pair instead of
+// re-summing the index. Indices are based (divisor fixed so the level
+// equals base_value) the moment their last constituent gets a price.
+//
+// The symbol -> index adjacency is kept in CSR form: one offsets array over
+// symbols and one contiguous entry array of (index, coefficient), so an
+// update walks a single run of memory however many thousand indices share
+// the symbol. Because incremental sums accumulate rounding error, every
+// resync_interval updates one index is recomputed from the current prices
+// (round robin), bounding the drift without a full recompute on any tick.
+//
+// One writer thread (the feed handler's receiver thread); readers use a
+// seqlock over the whole engine, so a snapshot never sees one symbol's
+// update applied to some indices but not others.
+//
+// Symbols are exchange ids; per-symbol arrays are indexed by the slots of
+// the engine's own SymbolMap.
+class IndexEngine {
+public:
+    // Universe of symbols 0..num_symbols-1. Throws std::invalid_argument for
+    // a constituent outside the universe or a non-positive base value or
+    // coefficient.
+    IndexEngine(size_t num_symbols, const std::vector<IndexDefinition>& indices);
+    // Universe of the symbols in the map (e.g. a feed handler's)
+    IndexEngine(SymbolMap symbols, const std::vector<IndexDefinition>& indices);
+
+    IndexEngine(const IndexEngine&) = delete;
+    IndexEngine& operator=(const IndexEngine&) = delete;
+
+    // Writer operations (single writer thread)
+    void update_price(SymbolId symbol_id, double price);
+    // Seed every symbol from the cache's last traded prices (late attach);
+    // pass the feed handler's symbol map if its cache slots are not ids
+    void load_prices(const SymbolCache& cache, const SymbolMap* map = nullptr);
+    // Recompute every index from the current prices
+    void resync_all();
+
+    // One index is recomputed every `updates` price updates (0 = never)
+    void set_resync_interval(uint32_t updates) { resync_interval_ = updates; }
+
+    // Reader operations (lock-free, multiple readers)
+    struct Snapshot {
+        double value;                   // 0 until the index is based
+        uint32_t missing_constituents;  // Constituents without a price yet
+        uint64_t update_count;          // Constituent price changes applied
+    };
+
+    Snapshot get_snapshot(size_t index) const;
+    double get_value(size_t index) const { return get_snapshot(index).value; }
+
+    // Statistics
+    struct Stats {
+        uint64_t updates;               // Price changes applied
+        uint64_t index_updates;         // (constituent, index) adjustments
+        uint64_t resyncs;               // Indices recomputed from scratch
+        double max_drift;               // Largest relative correction a resync applied
+    };
+
+    Stats get_stats() const;
+    size_t get_num_indices() const { return states_.size(); }
+    size_t get_num_symbols() const { return symbol_map_.size(); }
+    const std::string& get_name(size_t index) const { return names_[index]; }
+    // Indices that contain the symbol (its CSR row length)
+    size_t get_symbol_fanout(SymbolId symbol_id) const;
+
+    static constexpr uint32_t DEFAULT_RESYNC_INTERVAL = 64;
+
+private:
+    struct Entry {
+        uint32_t index;
+        double coefficient;
+    };
+
+    struct Term {
+        uint32_t slot;
+        double coefficient;
+    };
+
+    struct State {
+        double sum = 0.0;               // Sum of coefficient * price
+        double divisor = 0.0;           // 0 until based
+        double base_value = 0.0;
+        uint32_t missing = 0;
+        uint64_t update_count = 0;
+    };
+
+    void write_begin();
+    void write_end();
+    void apply(uint32_t slot, double price);
+    void resync(size_t index);
+
+    SymbolMap symbol_map_;
+    std::vector<State> states_;
+    std::vector<std::string> names_;
+    std::vector<double> prices_;                // Last price per slot; 0 = none yet
+
+    // CSR adjacency: entries_[row_offsets_[s] .. row_offsets_[s + 1]) are the
+    // indices containing the symbol in slot s
+    std::vector<uint32_t> row_offsets_;
+    std::vector<Entry> entries_;
+
+    // Index -> constituents (for resync), also CSR
+    std::vector<uint32_t> index_offsets_;
+    std::vector<Term> terms_;
+
+    alignas(64) std::atomic<uint64_t> sequence_{0};  // Seqlock: odd = writing, even = stable
+    uint32_t resync_interval_ = DEFAULT_RESYNC_INTERVAL;
+    uint32_t updates_since_resync_ = 0;
+    size_t next_resync_ = 0;
+    uint64_t updates_ = 0;
+    uint64_t index_updates_ = 0;
+    uint64_t resyncs_ = 0;
+    double max_drift_ = 0.0;
+};
+
+} // namespace mdfh
+
+#endif // INDEX_ENGINE_H
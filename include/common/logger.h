@@ -0,0 +1,374 @@
+#ifndef LOGGER_H
+#define LOGGER_H
+
+#include <cstdint>
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+#include "common/tsc_clock.h"
+
+namespace mdfh {
+
+enum class LogLevel : uint8_t {
+    DEBUG = 0,
+    INFO = 1,
+    WARN = 2,
+    ERROR = 3
+};
+
+// Static descriptor for one MDFH_LOG_* call site.
+// Holds the format string and the per-site throttling state, so rate
+// limiting and deduplication never touch shared logger state.
+struct LogSite {
+    static constexpr uint64_t WINDOW_NS = 1000000000ULL;  // 1 second
+
+    LogLevel level;
+    const char* format;             // "{}" placeholders, expanded by the logger thread
+    uint32_t max_per_second;        // 0 = unlimited
+
+    // Producer-side state (relaxed; approximate when several threads share a site)
+    std::atomic<uint64_t> window_start_ns;
+    std::atomic<uint32_t> window_count;
+    std::atomic<uint64_t> last_emit_ns;
+    std::atomic<uint64_t> last_args_hash;
+    std::atomic<uint64_t> suppressed;
+
+    // Intrusive list of sites that have fired, walked by the logger thread
+    // to report suppressed counts that no later record picked up
+    std::atomic<bool> registered;
+    LogSite* next;
+
+    constexpr LogSite(LogLevel lvl, const char* fmt, uint32_t rate)
+        : level(lvl), format(fmt), max_per_second(rate),
+          window_start_ns(0), window_count(0), last_emit_ns(0),
+          last_args_hash(0), suppressed(0), registered(false), next(nullptr) {}
+
+    // Decide whether a record with the given argument hash is emitted.
+    // On success, returns the number of records folded since the last one.
+    bool admit(uint64_t now_ns, uint64_t args_hash, uint64_t& folded);
+};
+
+// Binary log argument: copied as-is on the hot thread, formatted later.
+// Strings up to MAX_STR bytes are stored inline; longer ones are copied
+// into the producing ring's spill buffer (SPILLED).
+struct LogArg {
+    static constexpr size_t MAX_STR = 23;
+
+    enum class Type : uint8_t { INT, UINT, DOUBLE, STR, SPILLED };
+
+    struct Spill {
+        uint32_t offset;            // Start in LogRing::spill
+        uint32_t length;
+        uint64_t end;               // Spill position after this string
+    };
+
+    Type type;
+    union {
+        int64_t i;
+        uint64_t u;
+        double d;
+        char s[MAX_STR + 1];
+        Spill spill;
+    };
+};
+
+struct LogRecord {
+    static constexpr size_t MAX_ARGS = 6;
+
+    const LogSite* site;
+    uint64_t timestamp_ns;
+    uint64_t folded;                // Records suppressed at this site before this one
+    uint8_t num_args;
+    LogArg args[MAX_ARGS];
+};
+
+// Single-producer/single-consumer ring owned by one logging thread.
+// Long string arguments go to a byte ring alongside the records; the logger
+// thread releases their bytes as it writes the records that use them.
+struct LogRing {
+    static constexpr size_t CAPACITY = 1024;  // Must be power of 2
+    static constexpr size_t INDEX_MASK = CAPACITY - 1;
+    static constexpr size_t SPILL_CAPACITY = 16384;  // Must be power of 2
+    static constexpr size_t SPILL_MASK = SPILL_CAPACITY - 1;
+    static constexpr size_t MAX_SPILL_STR = 4096;     // Longer strings are truncated
+
+    alignas(64) std::atomic<size_t> head{0};  // Written by producer
+    size_t spill_head = 0;                    // Producer only
+    alignas(64) std::atomic<size_t> tail{0};  // Written by logger thread
+    std::atomic<size_t> spill_tail{0};        // Written by logger thread
+    std::atomic<uint64_t> dropped{0};         // Records lost because the ring was full
+    std::atomic<bool> retired{false};         // Owning thread has exited
+    uint32_t thread_index = 0;
+    LogRecord records[CAPACITY];
+    char spill[SPILL_CAPACITY];
+};
+
+// Asynchronous binary logger.
+// The calling thread only encodes arguments into its own ring (no locks,
+// no formatting, no syscalls); a background thread formats and writes.
+// When a ring is full the record is dropped and counted, never blocked on.
+class Logger {
+public:
+    static Logger& instance();
+
+    // Minimum level checked before anything else at the call site
+    static bool enabled(LogLevel level) {
+        return static_cast<uint8_t>(level) >= min_level_.load(std::memory_order_relaxed);
+    }
+    static void set_level(LogLevel level) {
+        min_level_.store(static_cast<uint8_t>(level), std::memory_order_relaxed);
+    }
+
+    // Redirect output (nullptr = stdout for DEBUG/INFO, stderr for WARN/ERROR)
+    void set_output(FILE* out);
+
+    // Block until every record enqueued before the call has been written
+    void flush();
+
+    // Stop the background thread after draining all rings
+    void shutdown();
+
+    template<typename... Args>
+    void log(LogSite& site, const Args&... args);
+
+    // Statistics
+    uint64_t get_records_written() const { return records_written_.load(std::memory_order_relaxed); }
+    uint64_t get_records_dropped() const;
+    size_t get_num_rings() const;
+
+    // Monotonic nanoseconds used for record timestamps
+    static uint64_t now_ns() {
+        return TscClock::now_ns();
+    }
+
+    // Format a record into a line (exposed for testing); spill is the
+    // buffer of the ring the record came from
+    static std::string format_record(const LogRecord& rec, const char* spill = nullptr);
+
+    Logger(const Logger&) = delete;
+    Logger& operator=(const Logger&) = delete;
+
+private:
+    Logger();
+    ~Logger();
+
+    static std::atomic<uint8_t> min_level_;
+
+    std::atomic<bool> running_;
+    std::atomic<FILE*> output_;
+    std::atomic<uint64_t> records_written_;
+    std::thread consumer_thread_;
+
+    // Rings are created on a thread's first log call, retired when the
+    // thread exits and freed once drained
+    mutable std::mutex rings_mutex_;
+    std::vector<std::unique_ptr<LogRing>> rings_;
+    uint32_t next_thread_index_;
+    std::atomic<uint64_t> retired_dropped_;  // Drop counts of freed rings
+
+    std::atomic<LogSite*> sites_head_;
+
+    // Wall-clock offset applied to steady timestamps when formatting
+    int64_t wall_offset_ns_;
+
+    LogRing& local_ring();
+    LogRing* register_ring();
+    void register_site(LogSite& site);
+
+    void consumer_loop();
+    size_t drain();
+    void free_retired_rings();
+    void report_suppressed();
+    void write_line(LogLevel level, const std::string& line);
+};
+
+namespace log_detail {
+
+// Producer's reservation in its ring's spill buffer while encoding a record;
+// committed only if the record is enqueued
+struct SpillCursor {
+    LogRing* ring;
+    size_t head;
+};
+
+inline uint64_t hash_mix(uint64_t h, uint64_t v) {
+    // FNV-1a style mixing over 64-bit words
+    h ^= v;
+    h *= 1099511628211ULL;
+    return h;
+}
+
+// Copy a string longer than MAX_STR into the spill buffer. Returns false
+// if it is too long or the buffer has no room.
+inline bool spill_string(LogArg& arg, SpillCursor* spill, const char* str, size_t len) {
+    if (!spill || len > LogRing::MAX_SPILL_STR) {
+        return false;
+    }
+    LogRing& ring = *spill->ring;
+    size_t pos = spill->head;
+    size_t offset = pos & LogRing::SPILL_MASK;
+    if (offset + len > LogRing::SPILL_CAPACITY) {
+        pos += LogRing::SPILL_CAPACITY - offset;  // Strings never wrap
+        offset = 0;
+    }
+    if (pos + len - ring.spill_tail.load(std::memory_order_acquire) > LogRing::SPILL_CAPACITY) {
+        return false;
+    }
+    std::memcpy(ring.spill + offset, str, len);
+    spill->head = pos + len;
+    arg.type = LogArg::Type::SPILLED;
+    arg.spill = LogArg::Spill{static_cast<uint32_t>(offset), static_cast<uint32_t>(len), pos + len};
+    return true;
+}
+
+// Characters of a string argument (std::string, char array or C string)
+template<typename T>
+inline void string_arg(const T& value, const char*& str, size_t& len) {
+    if constexpr (std::is_same_v<std::decay_t<T>, std::string>) {
+        str = value.c_str();
+        len = value.size();
+    } else if constexpr (std::is_array_v<T>) {
+        str = value;
+        len = std::strlen(str);
+    } else {
+        str = value ? value : "";
+        len = std::strlen(str);
+    }
+}
+
+// Fold one argument into the record's dedup hash. Runs before admission,
+// so it reads the value in place and copies nothing.
+template<typename T>
+inline void hash_arg(uint64_t& hash, const T& value) {
+    using D = std::decay_t<T>;
+    if constexpr (std::is_same_v<D, bool>) {
+        hash = hash_mix(hash, value ? 1 : 0);
+    } else if constexpr (std::is_enum_v<D> || (std::is_integral_v<D> && std::is_signed_v<D>)) {
+        hash = hash_mix(hash, static_cast<uint64_t>(static_cast<int64_t>(value)));
+    } else if constexpr (std::is_integral_v<D>) {
+        hash = hash_mix(hash, static_cast<uint64_t>(value));
+    } else if constexpr (std::is_floating_point_v<D>) {
+        double d = static_cast<double>(value);
+        uint64_t bits;
+        std::memcpy(&bits, &d, sizeof(bits));
+        hash = hash_mix(hash, bits);
+    } else {
+        const char* str;
+        size_t len;
+        string_arg(value, str, len);
+        for (size_t i = 0; i < len; ++i) {
+            hash = hash_mix(hash, static_cast<uint8_t>(str[i]));
+        }
+    }
+}
+
+template<typename T>
+inline void encode(LogArg& arg, const T& value, SpillCursor* spill = nullptr) {
+    using D = std::decay_t<T>;
+    if constexpr (std::is_same_v<D, bool>) {
+        arg.type = LogArg::Type::UINT;
+        arg.u = value ? 1 : 0;
+    } else if constexpr (std::is_enum_v<D>) {
+        arg.type = LogArg::Type::INT;
+        arg.i = static_cast<int64_t>(value);
+    } else if constexpr (std::is_integral_v<D> && std::is_signed_v<D>) {
+        arg.type = LogArg::Type::INT;
+        arg.i = static_cast<int64_t>(value);
+    } else if constexpr (std::is_integral_v<D>) {
+        arg.type = LogArg::Type::UINT;
+        arg.u = static_cast<uint64_t>(value);
+    } else if constexpr (std::is_floating_point_v<D>) {
+        arg.type = LogArg::Type::DOUBLE;
+        arg.d = static_cast<double>(value);
+    } else {
+        // Short strings inline, long ones spilled; a string that cannot be
+        // spilled is cut to MAX_STR bytes ending in "..."
+        const char* str;
+        size_t len;
+        string_arg(value, str, len);
+        if (len > LogArg::MAX_STR && spill_string(arg, spill, str, len)) {
+            return;
+        }
+        arg.type = LogArg::Type::STR;
+        if (len <= LogArg::MAX_STR) {
+            std::memcpy(arg.s, str, len);
+            arg.s[len] = '\0';
+        } else {
+            std::memcpy(arg.s, str, LogArg::MAX_STR - 3);
+            std::memcpy(arg.s + LogArg::MAX_STR - 3, "...", 4);
+        }
+    }
+}
+
+} // namespace log_detail
+
+template<typename... Args>
+void Logger::log(LogSite& site, const Args&... args) {
+    static_assert(sizeof...(Args) <= LogRecord::MAX_ARGS, "Too many log arguments");
+
+    // Admission first: a throttled or duplicate record costs a hash of its
+    // arguments, never an encode or a spill copy
+    uint64_t hash = 14695981039346656037ULL;
+    (log_detail::hash_arg(hash, args), ...);
+
+    uint64_t now = now_ns();
+    uint64_t folded = 0;
+    if (!site.admit(now, hash, folded)) {
+        if (!site.registered.load(std::memory_order_relaxed)) {
+            register_site(site);
+        }
+        return;
+    }
+
+    LogRing& ring = local_ring();
+    size_t head = ring.head.load(std::memory_order_relaxed);
+    if (head - ring.tail.load(std::memory_order_acquire) >= LogRing::CAPACITY) {
+        ring.dropped.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    // The slot is not visible to the logger thread until head moves, so
+    // arguments are encoded straight into it
+    LogRecord& rec = ring.records[head & LogRing::INDEX_MASK];
+    rec.site = &site;
+    rec.timestamp_ns = now;
+    rec.folded = folded;
+    rec.num_args = static_cast<uint8_t>(sizeof...(Args));
+    log_detail::SpillCursor spill{&ring, ring.spill_head};
+    size_t idx = 0;
+    (log_detail::encode(rec.args[idx++], args, &spill), ...);
+
+    ring.spill_head = spill.head;
+    ring.head.store(head + 1, std::memory_order_release);
+}
+
+} // namespace mdfh
+
+// Call-site macros. Each expansion owns a static LogSite, so throttling
+// is per call site. Arguments are only evaluated when the level is enabled.
+#define MDFH_LOG_SITE(level, rate, fmt, ...)                                   \
+    do {                                                                       \
+        if (::mdfh::Logger::enabled(level)) {                                  \
+            static ::mdfh::LogSite mdfh_log_site_(level, fmt, rate);           \
+            ::mdfh::Logger::instance().log(mdfh_log_site_, ##__VA_ARGS__);     \
+        }                                                                      \
+    } while (0)
+
+#define MDFH_LOG_DEBUG(fmt, ...) MDFH_LOG_SITE(::mdfh::LogLevel::DEBUG, 0, fmt, ##__VA_ARGS__)
+#define MDFH_LOG_INFO(fmt, ...)  MDFH_LOG_SITE(::mdfh::LogLevel::INFO, 0, fmt, ##__VA_ARGS__)
+#define MDFH_LOG_WARN(fmt, ...)  MDFH_LOG_SITE(::mdfh::LogLevel::WARN, 0, fmt, ##__VA_ARGS__)
+#define MDFH_LOG_ERROR(fmt, ...) MDFH_LOG_SITE(::mdfh::LogLevel::ERROR, 0, fmt, ##__VA_ARGS__)
+
+// Rate-limited variants: at most `rate` records per second from this site
+#define MDFH_LOG_INFO_RL(rate, fmt, ...) MDFH_LOG_SITE(::mdfh::LogLevel::INFO, rate, fmt, ##__VA_ARGS__)
+#define MDFH_LOG_WARN_RL(rate, fmt, ...) MDFH_LOG_SITE(::mdfh::LogLevel::WARN, rate, fmt, ##__VA_ARGS__)
+
+#endif // LOGGER_H
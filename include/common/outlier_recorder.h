@@ -0,0 +1,107 @@
+#ifndef OUTLIER_RECORDER_H
+#define OUTLIER_RECORDER_H
+
+#include "common/protocol.h"
+#include <cstdint>
+#include <cstddef>
+#include <atomic>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace mdfh {
+
+// Per-message stages timed by the feed handler
+enum class LatencyStage : uint8_t {
+    RECEIVE = 0,   // recv() syscall for the batch that carried the message
+    QUEUE,         // Batch arrival until this message was dispatched
+    DISPATCH,      // Handler (cache update) time
+    COUNT
+};
+
+// Context captured for one tail-latency message (64 bytes)
+struct OutlierRecord {
+    uint64_t capture_ticks;             // TscClock ticks when captured
+    uint64_t exchange_timestamp_ns;     // Header timestamp (wall ns)
+    uint64_t end_to_end_ns;             // Exchange timestamp to dispatch end
+    uint32_t stage_ns[static_cast<size_t>(LatencyStage::COUNT)];
+    uint32_t seq_num;
+    SymbolId symbol_id;
+    uint32_t batch_bytes;               // Bytes returned by the recv() call
+    uint32_t batch_index;               // Position of the message within the batch
+    uint32_t parser_buffer_fill;        // Bytes buffered in the parser at dispatch
+    int32_t cpu;                        // CPU the receiver thread ran on
+    uint16_t msg_type;
+    uint16_t reserved;
+};
+
+static_assert(sizeof(OutlierRecord) == 64, "OutlierRecord should be one cache line");
+
+// Bounded, lock-free recorder for messages whose end-to-end or per-stage
+// latency crosses a threshold. Captures overwrite the oldest entries once the
+// ring is full; readers take a consistent snapshot without blocking writers.
+class OutlierRecorder {
+public:
+    static constexpr uint64_t DEFAULT_END_TO_END_THRESHOLD_NS = 1000000;  // 1ms
+    static constexpr uint64_t DEFAULT_STAGE_THRESHOLD_NS = 100000;        // 100us
+    
+    explicit OutlierRecorder(size_t capacity = 4096,
+                             uint64_t end_to_end_threshold_ns = DEFAULT_END_TO_END_THRESHOLD_NS,
+                             uint64_t stage_threshold_ns = DEFAULT_STAGE_THRESHOLD_NS);
+    
+    // Thresholds (0 disables that check)
+    void set_thresholds(uint64_t end_to_end_ns, uint64_t stage_ns) {
+        end_to_end_threshold_ns_.store(end_to_end_ns, std::memory_order_relaxed);
+        stage_threshold_ns_.store(stage_ns, std::memory_order_relaxed);
+    }
+    uint64_t get_end_to_end_threshold() const {
+        return end_to_end_threshold_ns_.load(std::memory_order_relaxed);
+    }
+    uint64_t get_stage_threshold() const {
+        return stage_threshold_ns_.load(std::memory_order_relaxed);
+    }
+    
+    // Cheap hot-path check; the caller builds a record only when this is true
+    inline bool is_outlier(uint64_t end_to_end_ns, uint64_t max_stage_ns) const {
+        uint64_t e2e_limit = end_to_end_threshold_ns_.load(std::memory_order_relaxed);
+        uint64_t stage_limit = stage_threshold_ns_.load(std::memory_order_relaxed);
+        return (e2e_limit != 0 && end_to_end_ns > e2e_limit) ||
+               (stage_limit != 0 && max_stage_ns > stage_limit);
+    }
+    
+    // Store a record (any thread, wait-free)
+    void capture(const OutlierRecord& record);
+    
+    // Records currently held, oldest first
+    std::vector<OutlierRecord> snapshot() const;
+    
+    // Total outliers captured (including overwritten ones)
+    uint64_t get_outlier_count() const { return head_.load(std::memory_order_relaxed); }
+    size_t capacity() const { return capacity_; }
+    
+    // Export held records to CSV
+    bool export_to_csv(const std::string& filename) const;
+    
+    // Discard held records (call while no thread is capturing)
+    void reset();
+    
+private:
+    // Slot sequence is odd while a writer owns the slot
+    struct alignas(64) Slot {
+        std::atomic<uint64_t> seq{0};
+        OutlierRecord record{};
+    };
+    
+    size_t capacity_;
+    size_t index_mask_;
+    std::unique_ptr<Slot[]> slots_;
+    alignas(64) std::atomic<uint64_t> head_{0};
+    std::atomic<uint64_t> end_to_end_threshold_ns_;
+    std::atomic<uint64_t> stage_threshold_ns_;
+};
+
+const char* latency_stage_name(LatencyStage stage);
+
+} // namespace mdfh
+
+#endif // OUTLIER_RECORDER_H
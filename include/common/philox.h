@@ -0,0 +1,88 @@
+#ifndef PHILOX_H
+#define PHILOX_H
+
+#include <cstdint>
+#include <cstddef>
+#include <array>
+
+namespace mdfh {
+
+// Independent random streams of one simulation run. A stream is identified
+// by (purpose, id), e.g. (TICKS, symbol_id), so what a symbol draws never
+// depends on which thread or shard generates it or in what order.
+enum class RngStream : uint32_t {
+    TICKS = 0,          // GBM shocks, spreads, volumes, quote/trade choice
+    FAULTS = 1,         // Injected sequence gaps
+    ORDER_FLOW = 2,     // Matching-mode agents
+    CORRELATION = 3,    // Joint shocks of the correlated price model
+    ARRIVALS = 4,       // Poisson inter-arrival times
+    DELIVERY_FAULTS = 5 // Reactor fault injection (one stream per reactor)
+};
+
+// Philox4x32-10 counter-based generator (Salmon et al., SC'11). Block n of
+// a stream is a pure function of (key, counter): 10 rounds of multiply/xor
+// over a 128-bit counter, giving four 32-bit words. The key is the run
+// seed; the counter is (block index, stream id). Streams never overlap,
+// any block can be computed directly (seek() is free), and the bulk fills
+// compute LANES blocks side by side, one per SIMD lane (AVX2 when
+// compiled for it).
+//
+// Satisfies UniformRandomBitGenerator, but uniform() and normal() are
+// faster than the <random> distributions and give the same values on
+// every standard library.
+class Philox4x32 {
+public:
+    using result_type = uint32_t;
+    using Block = std::array<uint32_t, 4>;
+
+    Philox4x32(uint64_t seed, RngStream purpose, uint32_t id);
+
+    // The raw function: Philox4x32-10 of one counter under a key
+    static Block block(const Block& counter, uint64_t key);
+
+    static constexpr result_type min() { return 0; }
+    static constexpr result_type max() { return UINT32_MAX; }
+
+    result_type operator()() {
+        if (next_word_ == 4) {
+            refill();
+        }
+        return buffer_[next_word_++];
+    }
+
+    // Uniform in (0, 1): never 0, so log() is safe
+    double uniform() { return to_unit((*this)()); }
+
+    // Standard normal (Box-Muller; the second value of each pair is kept)
+    double normal();
+
+    // Bulk versions; produce exactly the values the same number of
+    // uniform() / normal() calls would
+    void fill_uniform(double* out, size_t count);
+    void fill_normal(double* out, size_t count);
+
+    // Jump to block `index` of the stream (4 words per block)
+    void seek(uint64_t index);
+    uint64_t get_block_index() const { return next_block_; }
+
+    static double to_unit(uint32_t word) {
+        return (static_cast<double>(word) + 0.5) * (1.0 / 4294967296.0);
+    }
+
+    static constexpr size_t LANES = 8;  // Blocks computed per bulk pass
+
+private:
+    void refill();
+
+    uint64_t key_;
+    uint64_t stream_;           // Counter words 2..3
+    uint64_t next_block_ = 0;   // Counter words 0..1
+    Block buffer_{};
+    uint32_t next_word_ = 4;    // 4 = buffer used up
+    bool has_spare_normal_ = false;
+    double spare_normal_ = 0.0;
+};
+
+} // namespace mdfh
+
+#endif // PHILOX_H
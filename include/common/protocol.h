@@ -6,20 +6,34 @@
 
 namespace mdfh {
 
+// Carried in every message header. Version 2 widened symbol_id to 32 bits
+// (version 1 had a 16-bit id and no version field).
+constexpr uint16_t PROTOCOL_VERSION = 2;
+
+// Exchange symbol identifier. Ids need not be dense: clients map the ids
+// they track onto dense local slots (SymbolMap).
+using SymbolId = uint32_t;
+
 // Message Types
 enum class MessageType : uint16_t {
     TRADE = 0x01,
     QUOTE = 0x02,
     HEARTBEAT = 0x03,
+    NEW_ORDER = 0x10,       // Order entry session (client -> server)
+    CANCEL_ORDER = 0x11,    // Order entry session (client -> server)
+    ORDER_ACK = 0x12,       // Order entry session (server -> client)
+    RESUME = 0xFE,
     SUBSCRIBE = 0xFF
 };
 
-// Message Header (16 bytes)
+// Message Header (20 bytes, v2). Every field is naturally aligned; the
+// version is filled in on construction.
 struct __attribute__((packed)) MessageHeader {
     uint16_t msg_type;      // Message type
+    uint16_t version = PROTOCOL_VERSION;
     uint32_t seq_num;       // Sequence number
     uint64_t timestamp;     // Nanoseconds since epoch
-    uint16_t symbol_id;     // Symbol identifier
+    SymbolId symbol_id;     // Symbol identifier
 };
 
 // Trade Message Payload (12 bytes)
@@ -36,30 +50,131 @@ struct __attribute__((packed)) QuotePayload {
     uint32_t ask_qty;       // Ask quantity
 };
 
-// Complete Trade Message (16 + 12 + 4 = 32 bytes)
+// Complete Trade Message (20 + 12 + 4 = 36 bytes)
 struct __attribute__((packed)) TradeMessage {
     MessageHeader header;
     TradePayload payload;
     uint32_t checksum;      // XOR of all previous bytes
 };
 
-// Complete Quote Message (16 + 24 + 4 = 44 bytes)
+// Complete Quote Message (20 + 24 + 4 = 48 bytes)
 struct __attribute__((packed)) QuoteMessage {
     MessageHeader header;
     QuotePayload payload;
     uint32_t checksum;      // XOR of all previous bytes
 };
 
-// Heartbeat Message (16 + 4 = 20 bytes)
+// Heartbeat Message (20 + 4 = 24 bytes)
 struct __attribute__((packed)) HeartbeatMessage {
     MessageHeader header;
     uint32_t checksum;      // XOR of all previous bytes
 };
 
-// Subscription Message
+// Subscription Message: SubscriptionHeader followed by count SymbolIds
 struct __attribute__((packed)) SubscriptionHeader {
     uint8_t command;        // 0xFF for subscribe
-    uint16_t count;         // Number of symbols
+    uint32_t count;         // Number of symbols
+};
+
+// Resume Message: a subscription that also asks for a replay.
+// SubscriptionHeader (command 0xFE) followed by count ResumeEntry records;
+// the server replays retained messages with seq_num > last_seq (0 = none)
+struct __attribute__((packed)) ResumeEntry {
+    SymbolId symbol_id;     // Symbol identifier
+    uint32_t last_seq;      // Last sequence number the client processed
+};
+
+// Most symbols one subscription/resume request may carry: a whole
+// 1M-symbol universe fits in a single request
+constexpr size_t MAX_SUBSCRIPTION_COUNT = size_t{1} << 20;
+
+// Largest subscription/resume request the server accepts (~8MB); a request
+// may span several reads
+constexpr size_t MAX_SUBSCRIPTION_MESSAGE_SIZE =
+    sizeof(SubscriptionHeader) + MAX_SUBSCRIPTION_COUNT * sizeof(ResumeEntry);
+
+// Order entry (separate session on the simulator's order port). Messages
+// use the market data header: seq_num is the sender's per-session
+// sequence, timestamp its send time (wall-clock ns) and symbol_id the
+// instrument. Fixed size, XOR checksum like the market data messages.
+enum class OrderSide : uint8_t {
+    BUY = 0,
+    SELL = 1
+};
+
+enum class OrderType : uint8_t {
+    LIMIT = 0,
+    MARKET = 1              // Immediate-or-cancel against the book
+};
+
+enum class OrderStatus : uint8_t {
+    NEW = 0,                // Resting, nothing filled
+    PARTIALLY_FILLED = 1,   // Some filled on entry, the rest is resting
+    FILLED = 2,             // Fully filled on entry
+    EXPIRED = 3,            // Market order remainder discarded (may have filled some)
+    CANCELLED = 4,
+    REJECTED = 5            // New or cancel refused; see reject_reason
+};
+
+enum class RejectReason : uint8_t {
+    NONE = 0,
+    UNKNOWN_SYMBOL = 1,
+    INVALID_QUANTITY = 2,
+    INVALID_PRICE = 3,      // Non-positive, or outside the book's price band
+    DUPLICATE_ORDER_ID = 4,
+    UNKNOWN_ORDER = 5,      // Cancel of an order that is not open (filled, cancelled, never sent)
+    INVALID_FIELD = 6,      // Unknown side or order type
+    TOO_MANY_OPEN_ORDERS = 7  // The session already holds OrderGateway::MAX_OPEN_ORDERS open orders
+};
+
+// New Order Payload (30 bytes)
+struct __attribute__((packed)) NewOrderPayload {
+    uint64_t client_order_id;    // Chosen by the client, unique per session
+    uint64_t trigger_timestamp;  // Exchange timestamp of the tick that triggered the order (echoed)
+    double price;                // Ignored for market orders
+    uint32_t quantity;
+    uint8_t side;                // OrderSide
+    uint8_t order_type;          // OrderType
+};
+
+// Cancel Order Payload (8 bytes)
+struct __attribute__((packed)) CancelOrderPayload {
+    uint64_t client_order_id;    // Order to cancel
+};
+
+// Order Acknowledgement Payload (50 bytes). Answers every new order and
+// cancel; the header timestamp is when the gateway processed the request.
+struct __attribute__((packed)) OrderAckPayload {
+    uint64_t client_order_id;
+    uint64_t exchange_order_id;  // 0 when rejected
+    uint64_t trigger_timestamp;  // Echoed from the new order (0 for cancels)
+    uint64_t order_timestamp;    // Echoed header timestamp of the request (client send time)
+    double average_price;        // Of the quantity filled on entry
+    uint32_t filled_quantity;    // Filled on entry
+    uint32_t leaves_quantity;    // Still resting
+    uint8_t status;              // OrderStatus
+    uint8_t reject_reason;       // RejectReason
+};
+
+// Complete New Order Message (20 + 30 + 4 = 54 bytes)
+struct __attribute__((packed)) NewOrderMessage {
+    MessageHeader header;
+    NewOrderPayload payload;
+    uint32_t checksum;      // XOR of all previous bytes
+};
+
+// Complete Cancel Order Message (20 + 8 + 4 = 32 bytes)
+struct __attribute__((packed)) CancelOrderMessage {
+    MessageHeader header;
+    CancelOrderPayload payload;
+    uint32_t checksum;      // XOR of all previous bytes
+};
+
+// Complete Order Ack Message (20 + 50 + 4 = 74 bytes)
+struct __attribute__((packed)) OrderAckMessage {
+    MessageHeader header;
+    OrderAckPayload payload;
+    uint32_t checksum;      // XOR of all previous bytes
 };
 
 // Helper functions
@@ -92,6 +207,16 @@ inline size_t get_message_size(MessageType type) {
     }
 }
 
+// Size of an order entry message (0 for anything else)
+inline size_t get_order_message_size(MessageType type) {
+    switch (type) {
+        case MessageType::NEW_ORDER: return sizeof(NewOrderMessage);
+        case MessageType::CANCEL_ORDER: return sizeof(CancelOrderMessage);
+        case MessageType::ORDER_ACK: return sizeof(OrderAckMessage);
+        default: return 0;
+    }
+}
+
 } // namespace mdfh
 
 #endif // PROTOCOL_H
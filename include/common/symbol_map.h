@@ -0,0 +1,74 @@
+#ifndef SYMBOL_MAP_H
+#define SYMBOL_MAP_H
+
+#include "common/protocol.h"
+#include <algorithm>
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+
+namespace mdfh {
+
+// Maps the exchange symbol ids a process tracks onto dense local slots
+// 0..size()-1. Per-symbol state (cache, sequences, names, simulator state)
+// lives in flat arrays indexed by slot, so it stays proportional to the
+// symbols tracked however wide or sparse the id space is.
+//
+// The id -> slot table has two levels, built once: a directory with one
+// entry per page of ids, and pages of 4-byte slots for the pages that hold
+// a tracked id. Every other directory entry points at one shared page of
+// NO_SLOT, so lookup is two loads with no branch on whether the id is
+// tracked. The page size is picked at build time to minimize the table, so
+// dense ids get close to a flat array and a few ids scattered over a wide
+// space pay for a small directory and a page each.
+class SymbolMap {
+public:
+    static constexpr uint32_t NO_SLOT = UINT32_MAX;
+    // Every SymbolId is valid. The directory only reaches the largest tracked
+    // id, and its page size grows with the id range.
+    static constexpr SymbolId MAX_ID = UINT32_MAX;
+
+    // Identity: ids 0..num_symbols-1 are their own slots
+    explicit SymbolMap(size_t num_symbols = 0);
+
+    // Slots in the order given. Throws std::invalid_argument on a duplicate.
+    explicit SymbolMap(const std::vector<SymbolId>& ids);
+
+    // NO_SLOT if the id is not tracked. Ids past the directory are clamped
+    // onto its last entry, which is always the empty page.
+    uint32_t slot(SymbolId id) const {
+        uint32_t page = std::min(id >> page_bits_, last_page_);
+        return slots_[pages_[page] + (id & page_mask_)];
+    }
+    SymbolId id(uint32_t slot) const { return ids_[slot]; }
+    bool contains(SymbolId id) const { return slot(id) != NO_SLOT; }
+
+    size_t size() const { return ids_.size(); }
+    const std::vector<SymbolId>& ids() const { return ids_; }
+
+    // Ids per page is 1 << page_bits
+    uint32_t page_bits() const { return page_bits_; }
+
+    // Heap bytes held by the map
+    size_t memory_bytes() const {
+        return pages_.capacity() * sizeof(uint32_t) + slots_.capacity() * sizeof(uint32_t) +
+               ids_.capacity() * sizeof(SymbolId);
+    }
+
+    static constexpr uint32_t MIN_PAGE_BITS = 4;
+    static constexpr uint32_t MAX_PAGE_BITS = 20;
+
+private:
+    void build();
+
+    std::vector<uint32_t> pages_;   // Directory: offset of each page in slots_
+    std::vector<uint32_t> slots_;   // Pages; the first is the shared empty page
+    std::vector<SymbolId> ids_;     // Indexed by slot
+    uint32_t page_bits_ = MIN_PAGE_BITS;
+    uint32_t page_mask_ = (1u << MIN_PAGE_BITS) - 1;
+    uint32_t last_page_ = 0;
+};
+
+} // namespace mdfh
+
+#endif // SYMBOL_MAP_H
@@ -0,0 +1,95 @@
+#ifndef SYMBOL_UNIVERSE_H
+#define SYMBOL_UNIVERSE_H
+
+#include <cstdint>
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace mdfh {
+
+// One instrument of the universe. Fixed size, so a binary universe file is
+// an array of these that is used in place.
+struct SymbolRecord {
+    uint32_t symbol_id;
+    uint32_t name_offset;       // Into the universe's name bytes
+    uint32_t name_length;
+    uint32_t reserved;
+    double price;
+    double volatility;          // σ
+    double drift;               // μ
+    double weight;              // Relative tick intensity (0 = not given)
+};
+
+static_assert(sizeof(SymbolRecord) == 48, "SymbolRecord is a file format");
+
+// The symbols file, memory-mapped and shared by the server and the client.
+//
+// A CSV (header row, then symbol_id,symbol,price,volatility,drift[,weight])
+// is parsed in one pass over the mapping with std::from_chars: no per-line
+// allocation, streams or locale, and names are views into the mapping.
+// Rows that do not parse are skipped and counted. A binary universe
+// (written by save(), recognized by MAGIC) needs no parsing at all: its
+// records and names are used straight from the mapping. Binary files are
+// native-endian; regenerate them rather than copying between machines.
+class SymbolUniverse {
+public:
+    // Throws std::runtime_error if the file cannot be read or a binary
+    // universe is truncated
+    static SymbolUniverse load(const std::string& file);
+
+    // Write as a binary universe; throws std::runtime_error on failure
+    void save(const std::string& file) const;
+
+    SymbolUniverse(SymbolUniverse&& other) noexcept;
+    SymbolUniverse& operator=(SymbolUniverse&& other) noexcept;
+    SymbolUniverse(const SymbolUniverse&) = delete;
+    SymbolUniverse& operator=(const SymbolUniverse&) = delete;
+    ~SymbolUniverse();
+
+    size_t size() const { return count_; }
+    const SymbolRecord& operator[](size_t index) const { return records_[index]; }
+    const SymbolRecord* begin() const { return records_; }
+    const SymbolRecord* end() const { return records_ + count_; }
+
+    std::string_view name(const SymbolRecord& record) const {
+        return std::string_view(names_ + record.name_offset, record.name_length);
+    }
+
+    // CSV rows that did not parse
+    size_t get_skipped_rows() const { return skipped_rows_; }
+    bool is_binary() const { return binary_; }
+
+    static constexpr char MAGIC[8] = {'M', 'D', 'F', 'H', 'U', 'N', 'I', 'V'};
+    static constexpr uint32_t VERSION = 1;
+
+private:
+    // Binary layout: this header, count records, then names_size name bytes
+    struct FileHeader {
+        char magic[8];
+        uint32_t version;
+        uint32_t record_size;
+        uint64_t count;
+        uint64_t names_size;
+    };
+
+    SymbolUniverse() = default;
+    void parse_csv();
+    void map_binary(const std::string& file);
+    void unmap();
+
+    const char* data_ = nullptr;        // The mapping
+    size_t data_size_ = 0;
+    std::vector<SymbolRecord> parsed_;  // CSV rows; a binary universe uses the mapping
+    const SymbolRecord* records_ = nullptr;
+    size_t count_ = 0;
+    const char* names_ = nullptr;
+    size_t names_size_ = 0;
+    size_t skipped_rows_ = 0;
+    bool binary_ = false;
+};
+
+} // namespace mdfh
+
+#endif // SYMBOL_UNIVERSE_H
@@ -0,0 +1,128 @@
+#ifndef TIMING_WHEEL_H
+#define TIMING_WHEEL_H
+
+#include <cstdint>
+#include <cstddef>
+#include <array>
+#include <vector>
+
+namespace mdfh {
+
+// Hierarchical timing wheel over a fixed set of timer ids (0..capacity-1),
+// each with at most one pending deadline. Time is an integer tick count
+// chosen by the caller (the simulator uses microseconds).
+//
+// LEVELS wheels of SLOTS slots each: level 0 holds deadlines in the next
+// SLOTS ticks one per tick, level k holds the ones up to SLOTS^(k+1) ticks
+// out, SLOTS^k ticks per slot. When level 0 wraps, the due slot of the
+// level above is cascaded down (re-inserted by its exact deadline), so a
+// timer moves at most LEVELS - 1 times before it fires. Deadlines past the
+// top level's horizon park in its last slot and are re-inserted on cascade.
+//
+// schedule / cancel are O(1) (intrusive doubly linked slot lists indexed
+// by timer id, no allocation), and advance skips empty level-0 slots with
+// an occupancy bitmap. Single-threaded.
+class TimingWheel {
+public:
+    explicit TimingWheel(size_t capacity, uint64_t start = 0);
+
+    TimingWheel(const TimingWheel&) = delete;
+    TimingWheel& operator=(const TimingWheel&) = delete;
+
+    // Arm `id` for `deadline`, replacing a pending deadline. Deadlines at
+    // or before now() fire on the next tick.
+    void schedule(uint32_t id, uint64_t deadline);
+    // False if `id` was not pending
+    bool cancel(uint32_t id);
+    // Drop every pending timer and restart the clock at `now`
+    void clear(uint64_t now);
+
+    // Move the clock to `now`, calling fire(id, deadline) for every timer
+    // due on the way, in deadline order. fire may schedule or cancel
+    // timers. Returns the number fired.
+    template <typename Fn>
+    size_t advance(uint64_t now, Fn&& fire);
+
+    uint64_t now() const { return current_; }
+    bool is_scheduled(uint32_t id) const { return id < capacity_ && slot_of_[id] != NONE; }
+    uint64_t get_deadline(uint32_t id) const { return deadline_[id]; }
+    size_t size() const { return size_; }
+    size_t capacity() const { return capacity_; }
+
+    static constexpr uint32_t SLOT_BITS = 8;
+    static constexpr uint32_t SLOTS = 1u << SLOT_BITS;
+    static constexpr uint32_t LEVELS = 4;
+    static constexpr uint64_t HORIZON = 1ull << (SLOT_BITS * LEVELS);  // Ticks the wheels span
+
+private:
+    static constexpr uint32_t NONE = UINT32_MAX;
+    static constexpr uint64_t SLOT_MASK = SLOTS - 1;
+    static constexpr uint32_t BITMAP_WORDS = SLOTS / 64;
+
+    // Link `id` at the tail of the slot for deadline_[id] relative to
+    // current_ / remove it from its slot (size_ is the caller's)
+    void insert(uint32_t id);
+    void unlink(uint32_t id);
+    // Re-insert the due slot of every level whose lower levels wrapped at current_
+    void cascade();
+    // First occupied level-0 slot at or after `from`, or SLOTS
+    uint32_t next_occupied(uint32_t from) const;
+
+    size_t capacity_;
+    uint64_t current_;                  // Last tick processed
+    size_t size_ = 0;
+
+    // Per timer
+    std::vector<uint64_t> deadline_;
+    std::vector<uint32_t> next_;
+    std::vector<uint32_t> prev_;
+    std::vector<uint32_t> slot_of_;     // level * SLOTS + slot, NONE if not pending
+
+    // Per slot list, level * SLOTS + slot
+    std::vector<uint32_t> head_;
+    std::vector<uint32_t> tail_;
+    std::array<uint64_t, BITMAP_WORDS> occupied_{};  // Level 0 only
+};
+
+template <typename Fn>
+size_t TimingWheel::advance(uint64_t now, Fn&& fire) {
+    size_t fired = 0;
+    while (current_ < now) {
+        uint64_t next = current_ + 1;
+        if ((next & SLOT_MASK) != 0) {
+            // Jump to the next occupied slot, or to the end of the rotation
+            // so the wrap below cascades the upper levels
+            uint32_t slot = next_occupied(static_cast<uint32_t>(next & SLOT_MASK));
+            uint64_t target = (next & ~SLOT_MASK) + slot;
+            if (slot == SLOTS) {
+                current_ = target - 1 < now ? target - 1 : now;
+                continue;
+            }
+            if (target > now) {
+                current_ = now;
+                break;
+            }
+            next = target;
+        }
+        current_ = next;
+        if ((next & SLOT_MASK) == 0) {
+            cascade();
+        }
+
+        // Timers scheduled by fire() land at current_ + 1 or later, so the
+        // slot drains
+        uint32_t slot = static_cast<uint32_t>(next & SLOT_MASK);
+        while (head_[slot] != NONE) {
+            uint32_t id = head_[slot];
+            unlink(id);
+            size_--;
+            fire(id, deadline_[id]);
+            fired++;
+        }
+    }
+    return fired;
+}
+
+} // namespace mdfh
+
+#endif // TIMING_WHEEL_H
@@ -0,0 +1,127 @@
+#ifndef TRACE_H
+#define TRACE_H
+
+#include "common/tsc_clock.h"
+#include <cstdint>
+#include <cstddef>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace mdfh {
+
+// Hot-path zones. Names appear in the trace viewer.
+enum class TraceZoneId : uint16_t {
+    RECEIVE = 0,
+    PARSE,
+    DISPATCH,
+    CACHE_UPDATE,
+    TICK_GENERATE,
+    BROADCAST,
+    SEND,
+    COUNT
+};
+
+const char* trace_zone_name(TraceZoneId zone);
+
+// Complete event: one zone entry/exit (16 bytes)
+struct TraceEvent {
+    uint64_t start_ticks;
+    uint32_t duration_ticks;
+    uint16_t zone;
+    uint16_t reserved;
+};
+
+// Per-thread flight-recorder ring. Single writer; the oldest events are
+// overwritten once full so tracing never blocks or allocates.
+struct TraceBuffer {
+    static constexpr size_t CAPACITY = 65536;  // Must be power of 2
+    static constexpr size_t INDEX_MASK = CAPACITY - 1;
+
+    alignas(64) std::atomic<uint64_t> head{0};
+    uint32_t thread_index = 0;
+    std::string thread_name;
+    std::unique_ptr<TraceEvent[]> events{new TraceEvent[CAPACITY]};
+};
+
+class Tracer {
+public:
+    static Tracer& instance();
+
+    // Record one event on the calling thread's buffer
+    inline void record(TraceZoneId zone, uint64_t start_ticks, uint64_t end_ticks) {
+        TraceBuffer& buf = local_buffer();
+        uint64_t head = buf.head.load(std::memory_order_relaxed);
+        TraceEvent& ev = buf.events[head & TraceBuffer::INDEX_MASK];
+        ev.start_ticks = start_ticks;
+        uint64_t dur = end_ticks - start_ticks;
+        ev.duration_ticks = dur > UINT32_MAX ? UINT32_MAX : static_cast<uint32_t>(dur);
+        ev.zone = static_cast<uint16_t>(zone);
+        buf.head.store(head + 1, std::memory_order_release);
+    }
+
+    // Name the calling thread in dumps (defaults to the pthread name)
+    void set_thread_name(const std::string& name);
+
+    // Write every buffered event as Chrome trace JSON (also loadable by
+    // ui.perfetto.dev). Safe to call while other threads are recording.
+    bool dump_chrome_json(const std::string& filename) const;
+
+    // Async-signal-safe dump request; the dump happens on the next poll
+    void request_dump() { dump_requested_.store(true, std::memory_order_relaxed); }
+    bool poll_dump(const std::string& filename);
+
+    // Total events recorded across all threads (including overwritten ones)
+    uint64_t get_total_events() const;
+
+    // Discard buffered events (call while no thread is recording)
+    void reset();
+
+    Tracer(const Tracer&) = delete;
+    Tracer& operator=(const Tracer&) = delete;
+
+private:
+    Tracer() = default;
+
+    mutable std::mutex buffers_mutex_;
+    std::vector<std::unique_ptr<TraceBuffer>> buffers_;
+    std::atomic<bool> dump_requested_{false};
+
+    TraceBuffer& local_buffer();
+    TraceBuffer* register_buffer();
+};
+
+// RAII zone: timestamps on construction and records on destruction
+class TraceZone {
+public:
+    explicit TraceZone(TraceZoneId zone)
+        : zone_(zone), start_(TscClock::now_ticks()) {}
+
+    ~TraceZone() {
+        Tracer::instance().record(zone_, start_, TscClock::now_ticks());
+    }
+
+    TraceZone(const TraceZone&) = delete;
+    TraceZone& operator=(const TraceZone&) = delete;
+
+private:
+    TraceZoneId zone_;
+    uint64_t start_;
+};
+
+} // namespace mdfh
+
+// Zones compile to nothing unless configured with -DMDFH_TRACING=ON
+#define MDFH_TRACE_CONCAT_INNER(a, b) a##b
+#define MDFH_TRACE_CONCAT(a, b) MDFH_TRACE_CONCAT_INNER(a, b)
+
+#ifdef MDFH_TRACING
+#define MDFH_TRACE_ZONE(zone) \
+    ::mdfh::TraceZone MDFH_TRACE_CONCAT(mdfh_trace_zone_, __LINE__)(::mdfh::TraceZoneId::zone)
+#else
+#define MDFH_TRACE_ZONE(zone) ((void)0)
+#endif
+
+#endif // TRACE_H
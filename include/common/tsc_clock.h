@@ -0,0 +1,138 @@
+#ifndef TSC_CLOCK_H
+#define TSC_CLOCK_H
+
+#include <cstdint>
+#include <cstddef>
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <time.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define MDFH_HAS_RDTSC 1
+#else
+#define MDFH_HAS_RDTSC 0
+#endif
+
+namespace mdfh {
+
+// Calibrated invariant-TSC clock.
+//
+// Hot paths call now_ticks() (a single rdtsc) and store raw ticks; conversion
+// to nanoseconds is a multiply/shift done by readers, off the hot path.
+// Calibration against CLOCK_MONOTONIC_RAW happens on first use and can be
+// refreshed periodically with recalibrate() or the background calibrator.
+// A recalibration continues the current conversion line and slews its rate
+// to absorb any offset from CLOCK_MONOTONIC_RAW, so now_ns() never steps.
+// When the CPU lacks an invariant TSC, ticks are CLOCK_MONOTONIC_RAW
+// nanoseconds and conversion is the identity.
+class TscClock {
+public:
+    // Raw timestamp counter (not serializing)
+    static inline uint64_t rdtsc() {
+#if MDFH_HAS_RDTSC
+        return __rdtsc();
+#else
+        return monotonic_raw_ns();
+#endif
+    }
+
+    // Timestamp counter that waits for prior instructions to retire
+    static inline uint64_t rdtscp() {
+#if MDFH_HAS_RDTSC
+        unsigned int aux;
+        return __rdtscp(&aux);
+#else
+        return monotonic_raw_ns();
+#endif
+    }
+
+    // Cheapest monotonic tick source available on this machine
+    static inline uint64_t now_ticks() {
+        if (__builtin_expect(state().use_tsc, 1)) {
+            return rdtsc();
+        }
+        return monotonic_raw_ns();
+    }
+
+    // Monotonic nanoseconds (CLOCK_MONOTONIC_RAW timebase)
+    static inline uint64_t now_ns() { return to_ns(now_ticks()); }
+
+    // Wall-clock nanoseconds since epoch, derived from the tick source
+    static inline uint64_t now_wall_ns() { return to_wall_ns(now_ticks()); }
+
+    // Convert a tick value to CLOCK_MONOTONIC_RAW nanoseconds
+    static uint64_t to_ns(uint64_t ticks);
+
+    // Convert a tick value to wall-clock nanoseconds since epoch
+    static uint64_t to_wall_ns(uint64_t ticks);
+
+    // Convert a tick interval to nanoseconds
+    static inline uint64_t delta_to_ns(uint64_t delta_ticks) {
+        const State& s = state();
+        return static_cast<uint64_t>(
+            (static_cast<unsigned __int128>(delta_ticks) * s.mult.load(std::memory_order_relaxed)) >> SHIFT);
+    }
+
+    // Re-measure the tick frequency against CLOCK_MONOTONIC_RAW and steer
+    // the conversion towards it without a step.
+    // Blocks for roughly `sample_ms`; call from a non-critical thread.
+    static void recalibrate(uint32_t sample_ms = 10);
+
+    // Periodic background recalibration (idempotent)
+    static void start_calibration_thread(uint32_t interval_ms = 1000);
+    static void stop_calibration_thread();
+
+    // Introspection
+    static bool is_tsc_invariant();
+    static bool using_tsc() { return state().use_tsc; }
+    static double ticks_per_ns();
+
+    static inline uint64_t monotonic_raw_ns() {
+        struct timespec ts;
+        clock_gettime(CLOCK_MONOTONIC_RAW, &ts);
+        return static_cast<uint64_t>(ts.tv_sec) * 1000000000ULL + ts.tv_nsec;
+    }
+
+private:
+    // ns = base_ns + ((ticks - base_ticks) * mult) >> SHIFT
+    static constexpr unsigned SHIFT = 32;
+
+    // One consistent snapshot of the conversion parameters
+    struct Params {
+        uint64_t base_ticks;
+        uint64_t base_ns;
+        uint64_t mult;
+        int64_t wall_offset_ns;           // CLOCK_REALTIME - CLOCK_MONOTONIC_RAW
+    };
+
+    struct State {
+        bool use_tsc;
+        std::atomic<uint64_t> seq;        // Seqlock guarding the conversion parameters
+        std::atomic<uint64_t> base_ticks;
+        std::atomic<uint64_t> base_ns;
+        std::atomic<uint64_t> mult;
+        std::atomic<int64_t> wall_offset_ns;
+        std::mutex write_mutex;           // Serializes seqlock writers
+
+        std::atomic<bool> calibrator_running;
+        std::thread calibrator;
+
+        State();
+        ~State();
+    };
+
+    static Params load_params();
+    static void store_params(const Params& params);
+    static uint64_t convert(const Params& params, uint64_t ticks);
+
+    static State& state() {
+        static State s;
+        return s;
+    }
+};
+
+} // namespace mdfh
+
+#endif // TSC_CLOCK_H
@@ -0,0 +1,87 @@
+#ifndef BROADCAST_LOG_H
+#define BROADCAST_LOG_H
+
+#include <cstdint>
+#include <cstddef>
+#include <atomic>
+#include <memory>
+#include "common/protocol.h"
+
+namespace mdfh {
+
+// Shared, append-only ring of encoded wire messages.
+//
+// The tick thread encodes every message exactly once into the log; reactors
+// read it in place and send straight from it, so per-message memory and
+// encode cost do not depend on the number of clients. Positions are
+// monotonic byte offsets (never reused), physical offset = pos & mask.
+// The ring is split into SEGMENTS equal segments and a message never
+// straddles a segment boundary (so never the end of the ring either): when
+// fewer than MAX_MESSAGE_SIZE bytes remain the writer skips to the next
+// segment, and readers apply the same rule (next_message_pos). Every segment
+// start is therefore a message boundary, which lets a reader that has no
+// cursor into the log (a replay) start parsing at segment_start().
+//
+// Readers are never waited for. Bytes stay valid until the writer laps
+// them; a reader checks is_valid() after using a range (seqlock style) and
+// treats anything older than lag_limit() as lost.
+class BroadcastLog {
+public:
+    static constexpr size_t MAX_MESSAGE_SIZE = sizeof(QuoteMessage);
+    static constexpr size_t MIN_CAPACITY = 64 * 1024;
+    static constexpr size_t SEGMENTS = 16;
+
+    // Capacity is rounded up to a power of 2 (at least MIN_CAPACITY)
+    explicit BroadcastLog(size_t capacity_bytes);
+
+    BroadcastLog(const BroadcastLog&) = delete;
+    BroadcastLog& operator=(const BroadcastLog&) = delete;
+
+    // Producer side (single writer; callers serialize)
+    // Append one encoded message; not visible to readers until commit()
+    bool append(const void* msg, size_t len);
+    // Publish everything appended so far
+    void commit() { head_.store(write_pos_, std::memory_order_release); }
+
+    // Reader side
+    // End of committed data
+    uint64_t head() const { return head_.load(std::memory_order_acquire); }
+    // Everything the writer may have touched, committed or not
+    uint64_t written() const { return written_.load(std::memory_order_acquire); }
+
+    const uint8_t* at(uint64_t pos) const { return data_.get() + (pos & mask_); }
+
+    // Position of the message that starts at or after pos
+    uint64_t next_message_pos(uint64_t pos) const {
+        return (segment_mask_ + 1 - (pos & segment_mask_) < MAX_MESSAGE_SIZE) ? (pos | segment_mask_) + 1 : pos;
+    }
+
+    // First segment boundary at or after pos (always a message boundary)
+    uint64_t segment_start(uint64_t pos) const { return (pos + segment_mask_) & ~static_cast<uint64_t>(segment_mask_); }
+
+    // True while the bytes from pos onwards have not been overwritten.
+    // Call after reading them: the fence orders those reads before the check.
+    bool is_valid(uint64_t pos) const {
+        std::atomic_thread_fence(std::memory_order_acquire);
+        return written_.load(std::memory_order_relaxed) - pos <= capacity_;
+    }
+
+    // Readers further behind the writer than this are considered lapped
+    uint64_t lag_limit() const { return capacity_ / 2; }
+
+    size_t capacity() const { return capacity_; }
+
+private:
+    std::unique_ptr<uint8_t[]> data_;
+    size_t capacity_;
+    size_t mask_;
+    size_t segment_mask_;
+    uint64_t write_pos_;  // Producer only
+
+    alignas(64) std::atomic<uint64_t> head_{0};     // Committed end
+    alignas(64) std::atomic<uint64_t> written_{0};  // Reserved end (raised before copying)
+};
+
+} // namespace mdfh
+
+#endif // BROADCAST_LOG_H
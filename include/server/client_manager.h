@@ -1,6 +1,7 @@
 #ifndef CLIENT_MANAGER_H
 #define CLIENT_MANAGER_H
 
+#include "common/protocol.h"
 #include <cstdint>
 #include <vector>
 #include <mutex>
@@ -44,17 +45,17 @@ public:
     size_t get_client_count() const;
     
     // Subscription management
-    void subscribe(int fd, const std::unordered_set<uint16_t>& symbol_ids);
-    void unsubscribe(int fd, uint16_t symbol_id);
+    void subscribe(int fd, const std::unordered_set<SymbolId>& symbol_ids);
+    void unsubscribe(int fd, SymbolId symbol_id);
     void clear_subscriptions(int fd);
-    bool is_subscribed(int fd, uint16_t symbol_id) const;
+    bool is_subscribed(int fd, SymbolId symbol_id) const;
     size_t get_subscription_count(int fd) const;
-    std::vector<int> get_subscribed_clients(uint16_t symbol_id) const;
+    std::vector<int> get_subscribed_clients(SymbolId symbol_id) const;
     
 private:
     mutable std::mutex mutex_;
     std::unordered_map<int, ClientInfo> clients_;
-    std::unordered_map<int, std::unordered_set<uint16_t>> subscriptions_;
+    std::unordered_map<int, std::unordered_set<SymbolId>> subscriptions_;
 };
 
 } // namespace mdfh
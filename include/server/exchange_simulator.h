@@ -2,28 +2,60 @@
 #define EXCHANGE_SIMULATOR_H
 
 #include <cstdint>
+#include <array>
 #include <vector>
 #include <atomic>
 #include <thread>
 #include <mutex>
 #include <condition_variable>
 #include <string>
+#include <memory>
 #include <sys/epoll.h>
 #include "server/client_manager.h"
+#include "server/broadcast_log.h"
+#include "server/reactor.h"
+#include "server/order_book.h"
+#include "server/order_flow.h"
+#include "server/order_gateway.h"
+#include "server/correlation_model.h"
+#include "server/tick_generator.h"
+#include "server/scenario.h"
+#include "server/fault_injector.h"
+#include "common/symbol_map.h"
+#include "common/timing_wheel.h"
 
 namespace mdfh {
 
 struct SymbolState {
-    uint16_t symbol_id = 0;
+    SymbolId symbol_id = 0;
     std::string symbol_name;
     double current_price = 0.0;
     double volatility = 0.0;      // σ
     double drift = 0.0;           // μ
     uint32_t seq_num = 0;
     uint32_t ticks_since_price_update = 0;  // Counter for price updates
+    double tick_weight = 0.0;     // Relative tick intensity (symbols.csv weight column; 0 = not given)
+    double rate_share = 0.0;      // Fraction of the tick rate this symbol gets
+    double rate_multiplier = 1.0;         // Scenario: symbol's own burst factor
+    double volatility_multiplier = 1.0;   // Scenario: symbol's own volatility factor
+    bool halted = false;                  // Scenario: no ticks generated
 };
 
-class ExchangeSimulator {
+// Aggregate send-side counters (monotonic since construction)
+struct ServerStats {
+    uint64_t messages_generated;      // Ticks produced by the generator
+    uint64_t messages_sent;           // Per-client messages queued for sending
+    uint64_t bytes_sent;              // Bytes accepted by the kernel
+    uint64_t send_failures;           // Per-client messages dropped
+    uint64_t slow_consumer_events;    // Clients lapped by the broadcast log (their backlog dropped)
+    uint64_t partial_sends;           // Sends cut short by a full socket buffer (remainder stays queued)
+    uint64_t log_overruns;            // Reactors or in-flight sends overtaken by the log writer
+    uint64_t heartbeats_sent;         // Sent to clients whose link was idle
+    uint64_t messages_replayed;       // Re-sent from the log to resuming clients (also in messages_sent)
+    uint64_t faults_injected;         // Delivery faults applied by the reactors (see FaultConfig)
+};
+
+class ExchangeSimulator : public OrderHandler {
 public:
     // Initialize with explicit parameters
     ExchangeSimulator(uint16_t port, size_t num_symbols = 100);
@@ -32,19 +64,26 @@ public:
     // Initialize with custom config file (for testing)
     ExchangeSimulator(uint16_t port, size_t num_symbols, const std::string& config_file);
     // Test-only accessors for verifying symbol state
-    size_t get_num_loaded_symbols() const { return loaded_symbols_count_; }
-    const SymbolState &get_symbol(size_t index) const { return loaded_symbols_.at(index); }
+    size_t get_num_loaded_symbols() const { return symbols_.size(); }
+    const SymbolState &get_symbol(size_t index) const { return symbols_.at(index); }
     // Test-only accessor for client connection management
     size_t get_num_connected_clients() const { return client_manager_.get_client_count(); }
     std::vector<int> get_client_fds() const { return client_manager_.get_all_clients(); }
     // Test-only accessor for client subscriptions
-    bool is_client_subscribed(int client_fd, uint16_t symbol_id) const;
+    bool is_client_subscribed(int client_fd, SymbolId symbol_id) const;
     size_t get_client_subscription_count(int client_fd) const;
     // Expose generate_tick for testing
-    void generate_tick(uint16_t symbol_id);
+    void generate_tick(SymbolId symbol_id);
+    // Expose generate_arrivals for testing (simulated clock in microseconds)
+    void generate_arrivals(uint64_t now_us);
+    // Test-only accessor for a symbol's order book (matching mode; nullptr otherwise)
+    const OrderBook* get_order_book(SymbolId symbol_id) const {
+        uint32_t slot = symbol_map_.slot(symbol_id);
+        return slot < matching_.size() ? matching_[slot].book.get() : nullptr;
+    }
 #endif
     
-    ~ExchangeSimulator();
+    ~ExchangeSimulator() override;
     
     // Start accepting connections
     void start();
@@ -55,30 +94,97 @@ public:
     // Configuration
     void set_tick_rate(uint32_t ticks_per_second);
     void enable_fault_injection(bool enable);
+    // Fault probabilities (fault_injection.* keys); takes effect at start()
+    void set_fault_config(const FaultConfig& config) { fault_config_ = config; }
+    const FaultConfig& get_fault_config() const { return fault_config_; }
+    // Delivery faults applied so far, by kind, over all reactors
+    std::array<uint64_t, NUM_FAULTS> get_fault_counts() const;
+    // Number of reactor threads (0 = auto); takes effect at start()
+    void set_num_reactors(size_t num_reactors);
+    size_t get_num_reactors() const { return reactors_.size(); }
+    // Size of the shared broadcast log in bytes; ignored once started
+    void set_broadcast_log_size(size_t bytes);
+    // Heartbeat clients whose link has been idle this long (0 = off); takes effect at start()
+    void set_heartbeat_interval_ms(uint32_t interval_ms);
+    // Also serve the feed on a second port (A/B line redundancy; 0 = off); takes effect at start()
+    void set_line_b_port(uint16_t port) { line_b_port_ = port; }
+    // Quotes and trades come from per-symbol order books driven by synthetic
+    // order flow (market.mode = matching) instead of being drawn directly
+    bool is_matching_enabled() const { return matching_enabled_; }
+    // Prices move together under a correlation or factor model
+    // (market.correlation) instead of independently
+    bool is_correlated() const { return correlation_ != nullptr; }
+    // Symbols tick as independent Poisson processes with per-symbol rates
+    // (market.arrivals = poisson) instead of each getting rate / num_symbols
+    // ticks in turn
+    bool is_poisson_arrivals() const { return arrival_wheel_ != nullptr; }
+    // Switch to Poisson arrivals with Zipf rates (as market.arrivals =
+    // poisson, market.rate_skew); call before start()
+    void enable_poisson_arrivals(double rate_skew);
+    // Play a scenario timeline of rate bursts, volatility jumps and halts
+    // (market.scenario_file; empty = none). Its clock starts with the
+    // first tick generated. Throws std::runtime_error on a bad file.
+    void set_scenario_file(const std::string& file);
+    bool has_scenario() const { return scenario_ != nullptr; }
+    // Run seed (market.seed, or drawn at startup when 0). Every random
+    // stream is keyed by it and the symbol id, so the same seed produces
+    // the same market whatever the threading or tick order.
+    uint64_t get_seed() const { return seed_; }
+    // Accept order entry sessions on this port (0 = off); takes effect at start()
+    void set_order_port(uint16_t port) { order_port_ = port; }
+    OrderGatewayStats get_order_gateway_stats() const;
+    
+    // OrderHandler (gateway thread). In matching mode orders go into the
+    // symbol's book and their fills and top-of-book changes are published
+    // on the feed like the agents'; in GBM mode there is no book, so limit
+    // orders are acknowledged as resting and market orders expire unfilled.
+    OrderResult submit_order(const OrderRequest& request) override;
+    bool cancel_order(SymbolId symbol_id, uint64_t exchange_order_id) override;
+    bool is_order_open(SymbolId symbol_id, uint64_t exchange_order_id) override;
+    
+    // Exchange id -> slot of the loaded symbols; per-symbol state is
+    // indexed by slot, so ids may be sparse anywhere in the SymbolId range
+    const SymbolMap& get_symbol_map() const { return symbol_map_; }
+    
+    // Statistics
+    ServerStats get_stats() const;
+    size_t get_client_count() const { return client_manager_.get_client_count(); }
     
     // Stop the simulator
     void stop();
     
 private:
-    // Accept new client connections
-    void handle_new_connection();
+    // Bind, listen and register a non-blocking listening socket with epoll
+    int open_listener(uint16_t port);
+    
+    // Accept new client connections and hand them to reactors round-robin
+    void handle_new_connection(int listen_fd);
     
 #ifndef TESTING
-    // Generate market tick using Geometric Brownian Motion (exposed in TESTING)
-    void generate_tick(uint16_t symbol_id);
+    // Generate and publish one market tick (exposed in TESTING)
+    void generate_tick(SymbolId symbol_id);
+    
+    // Poisson mode: encode and publish every arrival due by now_us on the
+    // arrival clock (exposed in TESTING). The first call, and the first
+    // after a rate change, draws the schedule starting at now_us.
+    void generate_arrivals(uint64_t now_us);
 #endif
     
-    // Broadcast message to all connected clients (or filtered by symbol)
-    void broadcast_message(const void* data, size_t len, uint16_t symbol_id = 0xFFFF);
+    // Advance a symbol with Geometric Brownian Motion and append the tick
+    // to the broadcast log (caller holds publish_mutex_)
+    void encode_tick(uint32_t slot);
     
-    // Handle client data (subscription messages)
-    void handle_client_data(int client_fd);
+    // Matching mode: run one agent order through the symbol's book and
+    // append a trade per fill and a quote if the top of book changed
+    // (caller holds publish_mutex_)
+    void encode_matching_tick(uint32_t slot, uint64_t timestamp);
     
-    // Handle subscription message
-    void handle_subscription_message(int client_fd, const uint8_t* data, size_t len);
+    // Append a trade per entry in fills_ and a quote if the symbol's top of
+    // book moved since it was last published (caller holds publish_mutex_)
+    void encode_book_changes(uint32_t slot, uint64_t timestamp);
     
-    // Handle client disconnection
-    void handle_client_disconnect(int client_fd);
+    // Make appended ticks visible to the reactors (caller holds publish_mutex_)
+    void publish();
     
     // Tick generation thread
     void tick_generation_loop();
@@ -86,6 +192,41 @@ private:
     // Initialize symbols
     void initialize_symbols();
     
+    // Build and seed one order book and order flow per symbol (matching mode)
+    void initialize_matching();
+    
+    // Load the correlation model named by market.correlation (if any)
+    void initialize_correlation();
+    
+    // Set each symbol's share of the tick rate and, for market.arrivals =
+    // poisson, the arrival streams and timing wheel
+    void initialize_arrivals();
+    
+    // Drop the schedule and draw every symbol's first arrival after now_us
+    // at `rate` (caller holds publish_mutex_)
+    void schedule_arrivals(uint32_t rate, uint64_t now_us);
+    
+    // Draw the symbol's next exponential inter-arrival time and arm its
+    // timer, or disarm it while halted (caller holds publish_mutex_)
+    void schedule_next_arrival(uint32_t slot);
+    
+    // Load market.scenario_file (if any) and reset every multiplier and halt
+    void initialize_scenario();
+    
+    // Apply every scenario event due by now_us on the tick clock, starting
+    // the scenario clock on the first call (caller holds publish_mutex_)
+    void apply_due_scenario_events(uint64_t now_us);
+    
+    // Apply one event at now_us; Poisson arrivals of the affected symbols
+    // are redrawn at their new rate (caller holds publish_mutex_)
+    void apply_scenario_event(const ScenarioEvent& event, uint64_t now_us);
+    
+    // Advance every symbol's price one GBM step with correlated shocks
+    // (caller holds publish_mutex_)
+    void step_correlated_prices(double dt);
+    
+    uint32_t price_to_tick(double price) const;
+    
     // Load configuration from file (private, but used by test constructor)
     void load_config(const std::string& config_file);
     
@@ -93,26 +234,89 @@ private:
     size_t num_symbols_;
     std::string symbols_file_;
     int server_fd_;
+    uint16_t line_b_port_ = 0;
+    int line_b_fd_ = -1;
+    uint16_t order_port_ = 0;
+    std::unique_ptr<OrderGateway> order_gateway_;
+    uint64_t next_gbm_order_id_ = 0;    // Order ids in GBM mode (gateway thread)
     int epoll_fd_;
     
     std::atomic<bool> running_;
     std::atomic<uint32_t> tick_rate_;
     std::atomic<bool> fault_injection_enabled_;
+    FaultConfig fault_config_;
+    
+    // Loaded symbols in file order. Every per-symbol array is indexed by
+    // slot, so memory follows the symbols loaded, not num_symbols.
+    std::vector<SymbolState> symbols_;            // Indexed by slot
+    SymbolMap symbol_map_;                        // symbol_id -> slot
+    uint64_t seed_ = 0;
+    std::vector<TickGenerator> tick_generators_;  // Indexed by slot
+    std::vector<Philox4x32> fault_rngs_;          // Indexed by slot
+    
+    ClientManager client_manager_;  // Shared registry; reactors own the sockets
     
-    std::vector<SymbolState> symbols_;  // Sparse array indexed by symbol_id
-    std::vector<SymbolState> loaded_symbols_;  // Compact array for testing
-    size_t loaded_symbols_count_;
+    size_t broadcast_log_size_;
+    std::unique_ptr<BroadcastLog> broadcast_log_;  // Every tick is encoded here once
     
-    ClientManager client_manager_;
+    uint32_t heartbeat_interval_ms_;
+    
+    // Matching-engine mode (tick thread / publish_mutex_ only)
+    struct MatchingSymbol {
+        std::unique_ptr<OrderBook> book;
+        std::unique_ptr<OrderFlowGenerator> flow;
+        OrderBook::Top published{};     // Top of book last sent as a quote
+    };
+    bool matching_enabled_ = false;
+    double tick_size_ = 0.01;
+    uint32_t price_levels_ = OrderBook::DEFAULT_LEVELS;
+    OrderFlowConfig flow_config_;
+    std::vector<MatchingSymbol> matching_;  // Indexed by slot
+    std::vector<Fill> fills_;
+    
+    // Correlated price paths (tick thread / publish_mutex_ only)
+    std::string correlation_mode_ = "none";
+    std::string correlation_file_;
+    std::unique_ptr<CorrelationModel> correlation_;
+    std::vector<double> shocks_;                  // Indexed by slot
+    uint64_t ticks_since_step_ = 0;
+    
+    // Poisson arrivals (tick thread / publish_mutex_ only)
+    std::string arrivals_mode_ = "uniform";
+    double rate_skew_ = 0.0;                      // Zipf exponent over symbols.csv order
+    std::unique_ptr<TimingWheel> arrival_wheel_;  // One timer per slot, microseconds
+    std::vector<Philox4x32> arrival_rngs_;        // Indexed by slot
+    std::vector<double> next_arrival_us_;         // Exact arrival times behind the timers
+    uint32_t arrival_rate_ = 0;                   // Rate the pending arrivals were drawn at
+    
+    // Scenario timeline (tick thread / publish_mutex_ only)
+    std::string scenario_file_;
+    std::unique_ptr<Scenario> scenario_;
+    uint64_t scenario_origin_us_ = UINT64_MAX;    // Tick clock time of scenario time 0 (unset)
+    double market_rate_multiplier_ = 1.0;
+    double market_volatility_multiplier_ = 1.0;
+    
+    size_t num_reactors_;
+    std::vector<std::unique_ptr<Reactor>> reactors_;
+    size_t next_reactor_;
+    std::mutex publish_mutex_;  // generate_tick may run outside the tick thread (tests)
     
     std::thread tick_thread_;
     
+    // Generated ticks; send-side counters live in the reactors
+    std::atomic<uint64_t> messages_generated_{0};
+    
     // Condition variable for efficient tick rate pausing
     std::mutex tick_rate_mutex_;
     std::condition_variable tick_rate_cv_;
     
     static constexpr int MAX_EVENTS = 64;
     static constexpr int MAX_CLIENTS = 1000;
+    static constexpr size_t TICK_BATCH_SIZE = 64;  // Messages appended per commit
+    static constexpr uint32_t ARRIVAL_POLL_INTERVAL_MS = 1;  // Poisson mode: due arrivals are encoded this often
+    static constexpr size_t DEFAULT_BROADCAST_LOG_SIZE = 16 * 1024 * 1024;
+    static constexpr uint32_t DEFAULT_HEARTBEAT_INTERVAL_MS = 1000;
+    static constexpr uint32_t SEED_DEPTH_LEVELS = 10;  // Resting levels per side at start (matching mode)
 };
 
 } // namespace mdfh
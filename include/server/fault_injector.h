@@ -0,0 +1,94 @@
+#ifndef FAULT_INJECTOR_H
+#define FAULT_INJECTOR_H
+
+#include <cstdint>
+#include <cstddef>
+#include <array>
+#include <atomic>
+#include "common/philox.h"
+
+namespace mdfh {
+
+// Delivery faults a reactor can apply to one message for one subscriber
+enum class Fault : uint8_t {
+    NONE = 0,
+    FRAGMENT = 1,       // First half sent on its own, the rest with the next send
+    DELAY = 2,          // Client's stream held back for delay_us
+    CORRUPT = 3,        // One payload byte flipped (checksum fails, framing intact)
+    DUPLICATE = 4,      // Sent twice
+    REORDER = 5,        // Sent after the client's next message
+    DISCONNECT = 6,     // Connection closed by the server
+    SQUEEZE = 7         // Client's SO_SNDBUF shrunk for squeeze_ms
+};
+
+constexpr size_t NUM_FAULTS = 8;
+
+// Fault probabilities when fault injection is enabled. sequence_gap is per
+// generated tick; the rest are per message and subscriber, drawn
+// independently for every client. The defaults are the original 1% gaps
+// and 5% fragmentation.
+struct FaultConfig {
+    double sequence_gap = 0.01;
+    double fragment = 0.05;
+    double delay = 0.0;
+    double corrupt = 0.0;
+    double duplicate = 0.0;
+    double reorder = 0.0;
+    double disconnect = 0.0;
+    double squeeze = 0.0;
+    uint32_t delay_us = 1000;           // How long a delayed client's output is held
+    uint32_t reorder_us = 1000;         // Longest a reordered message waits to be passed
+    uint32_t squeeze_bytes = 4096;      // SO_SNDBUF while squeezed (the kernel enforces a floor)
+    uint32_t squeeze_ms = 100;
+};
+
+// Per-reactor fault source: one uniform per message and subscriber picks
+// the fault, so a run with every probability at zero costs a compare.
+// Probabilities are clamped to [0, 1] and scaled down if they sum past 1.
+// Counters have a single writer (the reactor thread).
+class FaultInjector {
+public:
+    // Draws from stream (DELIVERY_FAULTS, stream_id) of the run keyed by `seed`
+    FaultInjector(const FaultConfig& config, uint64_t seed, uint32_t stream_id = 0);
+
+    Fault draw() {
+        double u = rng_.uniform();
+        if (u >= any_) {
+            return Fault::NONE;
+        }
+        size_t i = 1;
+        while (i + 1 < NUM_FAULTS && u >= thresholds_[i]) {
+            ++i;
+        }
+        return static_cast<Fault>(i);
+    }
+
+    // Uniform in [0, n)
+    uint32_t draw_index(uint32_t n) {
+        return static_cast<uint32_t>(rng_.uniform() * n);
+    }
+
+    // A drawn fault was actually applied
+    void record(Fault fault) {
+        auto& counter = counts_[static_cast<size_t>(fault)];
+        counter.store(counter.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    }
+
+    uint64_t get_count(Fault fault) const {
+        return counts_[static_cast<size_t>(fault)].load(std::memory_order_relaxed);
+    }
+    uint64_t get_total() const;
+
+    const FaultConfig& get_config() const { return config_; }
+
+private:
+    FaultConfig config_;
+    Philox4x32 rng_;
+    std::array<double, NUM_FAULTS> thresholds_{};   // Cumulative probability up to each fault
+    double any_ = 0.0;                              // Probability of any fault
+    std::array<std::atomic<uint64_t>, NUM_FAULTS> counts_{};
+};
+
+} // namespace mdfh
+
+#endif // FAULT_INJECTOR_H
@@ -0,0 +1,139 @@
+#ifndef ORDER_BOOK_H
+#define ORDER_BOOK_H
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+
+namespace mdfh {
+
+enum class Side : uint8_t {
+    BUY = 0,
+    SELL = 1
+};
+
+// One execution against a resting (maker) order
+struct Fill {
+    uint64_t maker_id;
+    uint32_t price_tick;
+    uint32_t quantity;
+    bool maker_done;  // Maker order fully filled and removed from the book
+};
+
+// Price-time priority limit order book for one symbol.
+//
+// Prices are integer ticks. Price levels live in one contiguous ladder
+// covering a band of num_levels ticks, indexed by (tick - band low), so
+// walking to the next level is a pointer increment rather than a tree
+// lookup. Each level is a FIFO of orders linked by pool index; orders come
+// from a pooled array with an intrusive free list. An order id encodes its
+// pool slot (low 32 bits) and the slot's generation (high 32 bits), so
+// cancel is an O(1) lookup with no hash map, and a stale id never matches
+// a reused slot.
+//
+// The band re-centres on demand when an order arrives outside it, as long
+// as every resting order still fits; otherwise the order is rejected (a
+// price band, as on a real exchange). Single-threaded.
+class OrderBook {
+public:
+    static constexpr uint32_t DEFAULT_LEVELS = 4096;
+    static constexpr uint32_t NO_PRICE = UINT32_MAX;
+
+    // reference_tick is centred in the initial band
+    explicit OrderBook(uint32_t reference_tick, uint32_t num_levels = DEFAULT_LEVELS);
+
+    OrderBook(const OrderBook&) = delete;
+    OrderBook& operator=(const OrderBook&) = delete;
+
+    // Match a limit order and rest the remainder. Executions are appended
+    // to fills. Returns the resting order's id, or 0 if nothing rests
+    // (fully filled, zero quantity, or rejected outside the price band).
+    uint64_t add_limit(Side side, uint32_t price_tick, uint32_t quantity, std::vector<Fill>& fills);
+
+    // Match a market order against the opposite side; any unfilled
+    // remainder is discarded (immediate-or-cancel). Returns the filled quantity.
+    uint32_t add_market(Side side, uint32_t quantity, std::vector<Fill>& fills);
+
+    // Remove a resting order; false if the id is unknown, filled or cancelled
+    bool cancel(uint64_t order_id);
+
+    // True while the order is resting (not yet filled or cancelled)
+    bool is_resting(uint64_t order_id) const;
+
+    // Top of book; NO_PRICE and zero quantity for an empty side
+    struct Top {
+        uint32_t bid_tick;
+        uint32_t ask_tick;
+        uint64_t bid_quantity;
+        uint64_t ask_quantity;
+
+        bool operator==(const Top& other) const {
+            return bid_tick == other.bid_tick && ask_tick == other.ask_tick &&
+                   bid_quantity == other.bid_quantity && ask_quantity == other.ask_quantity;
+        }
+        bool operator!=(const Top& other) const { return !(*this == other); }
+    };
+    Top top() const;
+
+    // Total resting quantity at a price (0 outside the band)
+    uint64_t quantity_at(uint32_t price_tick) const;
+
+    size_t order_count() const { return bid_orders_ + ask_orders_; }
+    size_t bid_order_count() const { return bid_orders_; }
+    size_t ask_order_count() const { return ask_orders_; }
+    uint32_t band_low() const { return base_; }
+    uint32_t num_levels() const { return num_levels_; }
+    uint64_t get_rejected() const { return rejected_; }
+    uint64_t get_recenters() const { return recenters_; }
+
+private:
+    static constexpr uint32_t NIL = UINT32_MAX;
+
+    struct Order {
+        uint64_t id = 0;
+        uint32_t price_tick = 0;
+        uint32_t quantity = 0;      // 0 = free slot
+        uint32_t prev = NIL;
+        uint32_t next = NIL;        // Next in level FIFO, or next free slot
+        Side side = Side::BUY;
+    };
+
+    struct Level {
+        uint32_t head = NIL;
+        uint32_t tail = NIL;
+        uint64_t quantity = 0;
+    };
+
+    template<bool IsBuy>
+    uint32_t match(uint32_t quantity, uint32_t limit_index, std::vector<Fill>& fills);
+
+    // Level index for a tick, re-centring the band if needed; NIL if the
+    // tick cannot be brought into the band
+    uint32_t index_for(uint32_t price_tick);
+    bool recenter(uint32_t price_tick);
+
+    uint32_t allocate();
+    void release(uint32_t slot);
+    void unlink(Order& order, Level& level);
+
+    uint32_t next_ask_level(uint32_t from) const;
+    uint32_t next_bid_level(uint32_t from) const;
+
+    uint32_t num_levels_;
+    uint32_t base_;                 // Tick of levels_[0]
+    std::vector<Level> levels_;
+    std::vector<Order> orders_;
+    uint32_t free_head_ = NIL;
+
+    uint32_t best_bid_ = NIL;       // Level index
+    uint32_t best_ask_ = NIL;
+    size_t bid_orders_ = 0;
+    size_t ask_orders_ = 0;
+
+    uint64_t rejected_ = 0;
+    uint64_t recenters_ = 0;
+};
+
+} // namespace mdfh
+
+#endif // ORDER_BOOK_H
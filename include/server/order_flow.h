@@ -0,0 +1,74 @@
+#ifndef ORDER_FLOW_H
+#define ORDER_FLOW_H
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+#include "server/order_book.h"
+#include "common/philox.h"
+
+namespace mdfh {
+
+// Agent model for synthetic order flow (matching-engine mode). Ratios are
+// relative weights of the three event types.
+struct OrderFlowConfig {
+    double limit_ratio = 0.55;
+    double market_ratio = 0.05;
+    double cancel_ratio = 0.40;
+    double aggressive_ratio = 0.10;    // Share of limit orders priced through the reference
+    uint32_t max_depth_ticks = 20;     // Passive limit orders rest within this many ticks of the reference
+    uint32_t lot_size = 100;
+    uint32_t max_lots = 10;            // Order size is 1..max_lots lots
+    uint32_t max_live_orders = 2000;   // Per symbol; beyond this the agent only cancels
+};
+
+struct OrderEvent {
+    enum class Type : uint8_t {
+        LIMIT,
+        MARKET,
+        CANCEL
+    };
+    Type type;
+    Side side;
+    uint32_t price_tick;
+    uint32_t quantity;
+    uint64_t order_id;  // CANCEL only
+};
+
+// Generates limit, market and cancel orders for one symbol around a
+// reference price (the simulator's GBM price), so the book follows the
+// price process and trades come out of actual crossings. Passive orders
+// rest up to max_depth_ticks away, skewed towards the reference; aggressive
+// limits and market orders take liquidity. The generator tracks its own
+// resting orders so cancels hit live orders: the caller reports every
+// order that rests (on_resting) and every maker that is filled (on_fill).
+class OrderFlowGenerator {
+public:
+    // Draws from stream (ORDER_FLOW, stream_id) of the run keyed by `seed`
+    OrderFlowGenerator(const OrderFlowConfig& config, uint64_t seed, uint32_t stream_id = 0);
+
+    // Next event for the book; a CANCEL's order is already forgotten here
+    OrderEvent next(uint32_t reference_tick);
+
+    void on_resting(uint64_t order_id);
+    void on_fill(const Fill& fill);
+
+    size_t live_orders() const { return live_.size(); }
+
+private:
+    void forget(uint64_t order_id);
+
+    OrderFlowConfig config_;
+    Philox4x32 rng_;
+    double limit_threshold_;           // Cumulative event weights, normalized
+    double market_threshold_;
+
+    // Live order ids with O(1) removal: position_[slot] indexes live_,
+    // where slot is the low 32 bits of the order id
+    std::vector<uint64_t> live_;
+    std::vector<uint32_t> position_;
+};
+
+} // namespace mdfh
+
+#endif // ORDER_FLOW_H
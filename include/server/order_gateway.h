@@ -0,0 +1,142 @@
+#ifndef ORDER_GATEWAY_H
+#define ORDER_GATEWAY_H
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+#include <atomic>
+#include <thread>
+#include <memory>
+#include <unordered_map>
+#include "common/protocol.h"
+
+namespace mdfh {
+
+// A validated new order as the gateway hands it to the exchange
+struct OrderRequest {
+    SymbolId symbol_id;
+    OrderSide side;
+    OrderType type;
+    double price;
+    uint32_t quantity;
+};
+
+// Outcome of a new order on entry (later passive fills are not reported)
+struct OrderResult {
+    OrderStatus status;
+    RejectReason reject_reason;
+    uint64_t exchange_order_id;
+    uint32_t filled_quantity;
+    uint32_t leaves_quantity;
+    double average_price;
+};
+
+// Executes orders for the gateway; implemented by the exchange. Called on
+// the gateway thread.
+class OrderHandler {
+public:
+    virtual ~OrderHandler() = default;
+    virtual OrderResult submit_order(const OrderRequest& request) = 0;
+    // False if the order is no longer resting (filled in the meantime)
+    virtual bool cancel_order(SymbolId symbol_id, uint64_t exchange_order_id) = 0;
+    // False once the order has left the book (filled passively); handlers
+    // that cannot tell keep every order open until it is cancelled
+    virtual bool is_order_open(SymbolId symbol_id, uint64_t exchange_order_id) {
+        (void)symbol_id;
+        (void)exchange_order_id;
+        return true;
+    }
+};
+
+struct OrderGatewayStats {
+    uint64_t orders_received;
+    uint64_t cancels_received;
+    uint64_t acks_sent;
+    uint64_t rejects;
+    uint64_t checksum_errors;
+    uint64_t protocol_errors;       // Unknown message type; the session is closed
+};
+
+// Order entry sessions on their own port. One thread owns the listener and
+// every session: it reads fixed-size NewOrder / CancelOrder messages, has
+// the OrderHandler execute them and answers each with an OrderAck on the
+// same socket. Sessions track their open orders by client order id, so a
+// client can only cancel its own orders and duplicate ids are refused.
+// Passive fills are not reported to the gateway, so a session at
+// MAX_OPEN_ORDERS first drops the orders that have left the book and then
+// rejects new ones until some are cancelled or filled.
+class OrderGateway {
+public:
+    OrderGateway(uint16_t port, OrderHandler& handler);
+    ~OrderGateway();
+
+    OrderGateway(const OrderGateway&) = delete;
+    OrderGateway& operator=(const OrderGateway&) = delete;
+
+    // Bind, listen and start the gateway thread (throws if the port is taken)
+    void start();
+    void stop();
+
+    uint16_t get_port() const { return port_; }
+    size_t get_session_count() const { return session_count_.load(std::memory_order_relaxed); }
+    OrderGatewayStats get_stats() const;
+
+    static constexpr size_t MAX_SESSIONS = 64;
+    static constexpr size_t MAX_OPEN_ORDERS = 16384;    // Per session
+    // New orders between two sweeps of a full session's open orders
+    static constexpr size_t PRUNE_INTERVAL = MAX_OPEN_ORDERS / 16;
+
+private:
+    struct OpenOrder {
+        SymbolId symbol_id;
+        uint64_t exchange_order_id;
+    };
+
+    struct Session {
+        int fd = -1;
+        std::vector<uint8_t> rx;              // Partially received message
+        size_t rx_len = 0;
+        std::vector<uint8_t> tx;              // Acks the socket did not take yet
+        uint32_t ack_seq = 0;
+        bool dead = false;
+        std::unordered_map<uint64_t, OpenOrder> open_orders;  // By client order id
+        size_t orders_since_prune = PRUNE_INTERVAL;
+    };
+
+    void loop();
+    void accept_sessions();
+    void handle_readable(Session& session);
+    // Returns bytes consumed, 0 if the message is incomplete
+    size_t handle_message(Session& session, const uint8_t* data, size_t len);
+    void handle_new_order(Session& session, const NewOrderMessage& msg);
+    void handle_cancel(Session& session, const CancelOrderMessage& msg);
+    // Drop open orders the handler reports as no longer resting
+    void prune_open_orders(Session& session);
+    void send_ack(Session& session, SymbolId symbol_id, const OrderAckPayload& ack);
+    void flush(Session& session);
+    void close_session(Session& session);
+
+    uint16_t port_;
+    OrderHandler& handler_;
+    int listen_fd_;
+    int epoll_fd_;
+    int wake_fd_;                             // eventfd: stop()
+    std::atomic<bool> running_;
+    std::thread thread_;
+
+    // Gateway thread only
+    std::unordered_map<int, std::unique_ptr<Session>> sessions_;
+    std::vector<uint8_t> rx_buffer_;
+
+    std::atomic<size_t> session_count_{0};
+    std::atomic<uint64_t> orders_received_{0};
+    std::atomic<uint64_t> cancels_received_{0};
+    std::atomic<uint64_t> acks_sent_{0};
+    std::atomic<uint64_t> rejects_{0};
+    std::atomic<uint64_t> checksum_errors_{0};
+    std::atomic<uint64_t> protocol_errors_{0};
+};
+
+} // namespace mdfh
+
+#endif // ORDER_GATEWAY_H
@@ -0,0 +1,212 @@
+#ifndef REACTOR_H
+#define REACTOR_H
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+#include <atomic>
+#include <thread>
+#include <mutex>
+#include <memory>
+#include <unordered_map>
+#include <unordered_set>
+#include "server/broadcast_log.h"
+#include "server/fault_injector.h"
+#include "common/protocol.h"
+#include "common/symbol_map.h"
+#include "common/timing_wheel.h"
+
+namespace mdfh {
+
+struct ServerStats;
+class ClientManager;
+
+// Event loop that owns a subset of the server's clients: their sockets,
+// send cursors and subscriptions. The acceptor hands it new sockets and the
+// tick thread appends to the shared BroadcastLog; the reactor walks new log
+// entries once, queues per-client runs of subscribed messages and sends
+// them straight from the log with sendmsg. Fan-out, sends, subscription
+// updates and disconnects all happen on the reactor's own thread, so
+// nothing on the send path is shared with other reactors. A reconnecting
+// client can send a resume request instead of a plain subscription; the
+// reactor then replays what the log still holds after the client's last
+// sequence per symbol before live fan-out continues.
+//
+// Fault injection is per client and never waits: a delayed client's output
+// is held back and a squeezed socket restored by timers on the reactor's
+// own wheel, and corrupted, duplicated or reordered messages are copies
+// spliced into that client's run list. Other clients are not touched.
+class Reactor {
+public:
+    // The symbol map is the simulator's and must outlive the reactor
+    Reactor(size_t index, const SymbolMap& symbol_map, const BroadcastLog& log,
+            ClientManager& client_manager, const std::atomic<bool>& fault_injection_enabled,
+            const FaultConfig& faults, uint64_t seed);
+    ~Reactor();
+
+    Reactor(const Reactor&) = delete;
+    Reactor& operator=(const Reactor&) = delete;
+
+    void start();
+    void stop();
+
+    // Adopt an accepted, non-blocking client socket (acceptor thread)
+    void add_client(int fd);
+
+    // New log entries were committed (tick thread)
+    void notify();
+
+    // Send a heartbeat to clients idle for this long (0 = off); set before start()
+    void set_heartbeat_interval_ms(uint32_t interval_ms) { heartbeat_interval_ns_ = interval_ms * 1000000ULL; }
+
+    size_t get_client_count() const { return client_count_.load(std::memory_order_relaxed); }
+
+    // Add this reactor's send-side counters to stats
+    void accumulate_stats(ServerStats& stats) const;
+    const FaultInjector& get_fault_injector() const { return fault_injector_; }
+
+    // Log bytes walked per pass before pending output is flushed
+    static constexpr size_t MAX_PASS_BYTES = 256 * 1024;
+    // Iovecs handed to one sendmsg call
+    static constexpr int MAX_IOVECS = 64;
+    // Clients per reactor that can have fault timers pending at once
+    static constexpr uint32_t MAX_FAULT_TIMERS = 1024;
+    // Bytes read from a client per recv; larger requests are reassembled
+    static constexpr size_t RX_CHUNK = 64 * 1024;
+
+private:
+    // Contiguous range of whole messages queued for one client: log
+    // positions, or with INJECTED set an offset into the client's injected
+    // bytes (fault copies)
+    struct Run {
+        uint64_t pos;
+        uint32_t len;
+        uint32_t messages;
+    };
+    static constexpr uint64_t INJECTED = 1ull << 63;
+    static constexpr uint32_t NO_TIMER = UINT32_MAX;
+    static constexpr uint32_t NO_LIST = UINT32_MAX;
+
+    struct Client {
+        int fd = -1;
+        std::vector<Run> runs;            // Pending output; runs before run_head are sent
+        size_t run_head = 0;
+        uint8_t stash[BroadcastLog::MAX_MESSAGE_SIZE];  // Sent ahead of runs: a cut message's tail or a heartbeat
+        uint8_t stash_head = 0;
+        uint8_t stash_len = 0;
+        std::vector<SymbolId> symbols;    // Current subscription
+        std::vector<uint8_t> rx;          // Request cut at the last read boundary
+        bool want_write = false;          // EPOLLOUT armed
+        bool slow = false;
+        bool dirty = false;               // Has output queued in the current pass
+        bool dead = false;
+        uint64_t last_send_ns = 0;        // Last time bytes were accepted by the kernel
+        uint32_t heartbeat_seq = 0;
+
+        // Fault injection (times are TscClock ns, 0 = not active)
+        std::vector<uint8_t> injected;    // Bytes of INJECTED runs
+        uint64_t hold_until_ns = 0;       // DELAY: nothing is sent before this
+        uint64_t squeeze_until_ns = 0;    // SQUEEZE: SO_SNDBUF restored then
+        int sndbuf = 0;                   // SO_SNDBUF to restore
+        uint8_t held[BroadcastLog::MAX_MESSAGE_SIZE];  // REORDER: waits for the next message
+        uint8_t held_len = 0;
+        uint64_t held_until_ns = 0;       // Sent anyway at this time
+        uint32_t timer = NO_TIMER;        // Slot in fault_timers_
+
+        // State when first touched in the current pass (rolled back on overrun)
+        size_t pass_runs = 0;
+        uint32_t pass_last_len = 0;
+        uint32_t pass_last_messages = 0;
+        uint8_t pass_stash_len = 0;
+        size_t pass_injected = 0;
+        uint8_t pass_held_len = 0;
+
+        bool has_pending() const { return stash_head < stash_len || run_head < runs.size(); }
+    };
+
+    void loop();
+    void drain_inbox();
+    bool drain_log();
+    void enqueue(Client& client, uint64_t pos, uint32_t len);
+    void append_run(Client& client, uint64_t pos, uint32_t len);
+    void fragment(Client& client, uint64_t pos, uint32_t len);
+    void inject_fault(Client& client, uint64_t pos, uint32_t len);
+    void append_injected(Client& client, const uint8_t* data, uint32_t len);
+    void squeeze(Client& client);
+    bool arm_fault_timer(Client& client);
+    void run_fault_timers();
+    void expire_faults(Client& client);
+    const uint8_t* run_data(const Client& client, uint64_t pos) const;
+    void mark_dirty(Client& client);
+    void rollback_pass();
+    void flush(Client& client);
+    void consume(Client& client, size_t sent);
+    bool drop_if_lapped(Client& client);
+    void send_heartbeats();
+    void set_want_write(Client& client, bool enable);
+    void handle_client_data(Client& client);
+    // Handle the complete requests at the start of data; returns bytes used
+    size_t handle_requests(Client& client, const uint8_t* data, size_t len);
+    void handle_subscription_message(Client& client, const uint8_t* data, size_t len);
+    void handle_resume_message(Client& client, const uint8_t* data, size_t len);
+    void set_subscription(Client& client, const std::unordered_set<SymbolId>& symbol_ids);
+    void add_subscriber(SymbolId symbol_id, Client& client);
+    void remove_subscriber(SymbolId symbol_id, Client& client);
+    void replay(Client& client, const std::unordered_map<SymbolId, uint32_t>& replay_after);
+    void remove_client(Client& client);
+    void reap_dead_clients();
+    void wake();
+
+    size_t index_;
+    const SymbolMap& symbol_map_;          // Subscribable ids and their slots
+    ClientManager& client_manager_;
+    const BroadcastLog& log_;
+    const std::atomic<bool>& fault_injection_enabled_;
+
+    int epoll_fd_;
+    int wake_fd_;                         // eventfd: new log entries or clients
+    std::atomic<bool> running_;
+    std::atomic<bool> sleeping_;          // Reactor is (about to be) blocked in epoll_wait
+    std::thread thread_;
+
+    std::mutex inbox_mutex_;
+    std::vector<int> inbox_;              // Sockets handed over by the acceptor
+
+    // Owned by the reactor thread
+    uint64_t log_pos_;                    // Next log entry to fan out
+    std::unordered_map<int, std::unique_ptr<Client>> clients_;
+    // Fan-out index: 4 bytes per loaded symbol pointing into a pool of
+    // subscriber lists that only subscribed symbols hold, so a 1M-symbol
+    // universe costs 4 MB per reactor rather than an empty vector per
+    // symbol, and sparse ids cost nothing for the gaps between them
+    std::vector<uint32_t> subscriber_list_;          // Indexed by slot; NO_LIST if none
+    std::vector<std::vector<Client*>> lists_;
+    std::vector<uint32_t> free_lists_;
+    std::vector<Client*> dirty_clients_;
+    bool has_dead_clients_ = false;
+    uint64_t now_ns_ = 0;                 // Refreshed once per loop iteration
+    uint64_t heartbeat_interval_ns_ = 0;
+    uint64_t last_heartbeat_scan_ns_ = 0;
+    FaultInjector fault_injector_;
+    TimingWheel fault_timers_;            // Microseconds; one timer per faulted client
+    std::vector<Client*> timer_clients_;  // Indexed by timer slot
+    std::vector<uint32_t> free_timers_;
+    std::vector<Client*> expired_;
+    std::vector<uint8_t> rx_buffer_;      // Subscription / resume requests
+
+    std::atomic<size_t> client_count_{0};
+
+    // Send-side statistics (single writer: the reactor thread)
+    std::atomic<uint64_t> messages_sent_{0};
+    std::atomic<uint64_t> bytes_sent_{0};
+    std::atomic<uint64_t> send_failures_{0};
+    std::atomic<uint64_t> slow_consumer_events_{0};
+    std::atomic<uint64_t> partial_sends_{0};
+    std::atomic<uint64_t> log_overruns_{0};
+    std::atomic<uint64_t> heartbeats_sent_{0};
+    std::atomic<uint64_t> messages_replayed_{0};
+};
+
+} // namespace mdfh
+
+#endif // REACTOR_H
@@ -0,0 +1,74 @@
+#ifndef SCENARIO_H
+#define SCENARIO_H
+
+#include <cstdint>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace mdfh {
+
+enum class ScenarioAction : uint8_t {
+    RATE = 0,           // Tick rate multiplier
+    VOLATILITY = 1,     // GBM volatility multiplier
+    HALT = 2,           // Stop generating ticks
+    RESUME = 3          // Undo HALT
+};
+
+// One regime change, applied to one symbol or to the whole market
+struct ScenarioEvent {
+    uint64_t time_us;           // Since the scenario started
+    ScenarioAction action;
+    int64_t symbol_id;          // Scenario::ALL_SYMBOLS for the whole market
+    double value;               // Multiplier (RATE, VOLATILITY); unused otherwise
+};
+
+// A timeline of market regime changes the tick scheduler applies as its
+// clock passes them: rate bursts, volatility jumps, halts. Multipliers are
+// absolute (a later RATE event replaces an earlier one, 1 restores the
+// configured rate) and a market-wide multiplier composes with a symbol's
+// own, so a storm on one symbol rides on top of a market-wide burst.
+//
+// File format (CSV, '#' comments):
+//   time_ms,event,symbol,value
+//   0,rate,*,30            market-wide rate x30 at the open
+//   2000,rate,*,1
+//   3000,volatility,7,10   symbol 7 only
+//   3500,halt,7,
+//   5000,resume,7,
+class Scenario {
+public:
+    static constexpr int64_t ALL_SYMBOLS = -1;
+
+    // Events are applied in time order, ties in the order given
+    explicit Scenario(std::vector<ScenarioEvent> events);
+
+    // Symbol ids must be below num_symbols. Throws std::runtime_error naming
+    // the file and line on bad input.
+    static Scenario load(const std::string& file, size_t num_symbols);
+
+    // Time of the next event not yet applied (UINT64_MAX when done)
+    uint64_t next_time_us() const {
+        return next_ < events_.size() ? events_[next_].time_us : UINT64_MAX;
+    }
+    // The next event due at or before elapsed_us, or nullptr
+    const ScenarioEvent* pop_due(uint64_t elapsed_us) {
+        if (next_ < events_.size() && events_[next_].time_us <= elapsed_us) {
+            return &events_[next_++];
+        }
+        return nullptr;
+    }
+    void rewind() { next_ = 0; }
+
+    const std::vector<ScenarioEvent>& get_events() const { return events_; }
+    // Time of the last event
+    uint64_t get_duration_us() const { return events_.empty() ? 0 : events_.back().time_us; }
+
+private:
+    std::vector<ScenarioEvent> events_;
+    size_t next_ = 0;
+};
+
+} // namespace mdfh
+
+#endif // SCENARIO_H
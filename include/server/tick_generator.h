@@ -2,19 +2,26 @@
 #define TICK_GENERATOR_H
 
 #include <cstdint>
-#include <random>
+#include "common/philox.h"
 
 namespace mdfh {
 
 class TickGenerator {
 public:
+    // Seeded from std::random_device (not reproducible)
     TickGenerator();
+    // Reproducible: the ticks of symbol `symbol_id` in the run keyed by `seed`
+    TickGenerator(uint64_t seed, uint32_t symbol_id);
     
     // Generate next price using Geometric Brownian Motion
     // dS = μ * S * dt + σ * S * dW
     double generate_next_price(double current_price, double drift, 
                                double volatility, double dt);
     
+    // Same step with the N(0,1) shock supplied (correlated paths)
+    static double gbm_step(double current_price, double drift,
+                           double volatility, double dt, double normal);
+    
     // Generate bid-ask spread (0.05% - 0.2% of price)
     double generate_spread(double price);
     
@@ -25,13 +32,7 @@ public:
     bool should_generate_quote();
     
 private:
-    // Box-Muller transform for normal distribution
-    double generate_normal();
-    
-    std::mt19937_64 random_num_gen_;
-    std::uniform_real_distribution<double> uniform_;
-    bool has_spare_normal_;
-    double spare_normal_;
+    Philox4x32 random_num_gen_;
 };
 
 } // namespace mdfh
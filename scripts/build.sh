@@ -151,6 +151,8 @@ if [ "$BUILD_TESTS" = "ON" ]; then
     echo -e "  ${GREEN}${BUILD_DIR}/tests/socket_test${NC}"
     echo -e "  ${GREEN}${BUILD_DIR}/tests/feed_handler_test${NC}"
     echo -e "  ${GREEN}${BUILD_DIR}/tests/client_manager_test${NC}"
+    echo -e "  ${GREEN}${BUILD_DIR}/tests/logger_test${NC}"
+    echo -e "  ${GREEN}${BUILD_DIR}/tests/tsc_clock_test${NC}"
 fi
 
 if [ "$BUILD_BENCHMARKS" = "ON" ]; then
@@ -162,6 +164,11 @@ if [ "$BUILD_BENCHMARKS" = "ON" ]; then
     echo -e "  ${GREEN}${BUILD_DIR}/benchmark/tick_generator_benchmark${NC}"
     echo -e "  ${GREEN}${BUILD_DIR}/benchmark/memory_pool_benchmark${NC}"
     echo -e "  ${GREEN}${BUILD_DIR}/benchmark/socket_benchmark${NC}"
+    echo -e "  ${GREEN}${BUILD_DIR}/benchmark/logger_benchmark${NC}"
+    echo -e "  ${GREEN}${BUILD_DIR}/benchmark/clock_benchmark${NC}"
+    echo -e "  ${GREEN}${BUILD_DIR}/benchmark/trace_benchmark${NC}"
+    echo -e "  ${GREEN}${BUILD_DIR}/benchmark/pipeline_benchmark${NC}"
+    echo -e "  ${GREEN}${BUILD_DIR}/benchmark/loopback_benchmark${NC}"
 fi
 
 echo ""
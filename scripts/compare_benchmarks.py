@@ -0,0 +1,168 @@
+#!/usr/bin/env python3
+"""Compare Google Benchmark JSON results against a stored baseline.
+
+Each benchmark is compared on per-repetition CPU time with a two-sided
+Mann-Whitney U test. A change is flagged only when it is both statistically
+significant (p < alpha) and larger than --min-change, so run the benchmarks
+with --benchmark_repetitions (>= 5 recommended).
+
+For flagged benchmarks the median change of each hardware counter
+(instructions, cycles, cache and branch misses, per item) is shown, which
+usually explains *why* the time moved.
+
+Usage:
+    compare_benchmarks.py BASELINE CURRENT [--alpha 0.05] [--min-change 0.05]
+
+BASELINE and CURRENT are JSON files or directories of JSON files (matched by
+file name). Exits with status 1 when any regression is found.
+"""
+
+import argparse
+import json
+import math
+import os
+import statistics
+import sys
+
+PERF_COUNTERS = ["instructions", "cycles", "IPC", "L1D_misses", "LLC_misses", "branch_misses"]
+
+
+def load_runs(path):
+    """Return {benchmark name: [repetition dicts]} for one JSON file."""
+    with open(path) as f:
+        data = json.load(f)
+    runs = {}
+    for bench in data.get("benchmarks", []):
+        if bench.get("run_type", "iteration") != "iteration":
+            continue  # Skip mean/median/stddev aggregates
+        if bench.get("error_occurred"):
+            continue
+        runs.setdefault(bench.get("run_name", bench["name"]), []).append(bench)
+    return runs
+
+
+def collect(path):
+    """Map file name -> runs for a file or a directory of JSON files."""
+    if os.path.isdir(path):
+        result = {}
+        for name in sorted(os.listdir(path)):
+            if name.endswith(".json"):
+                try:
+                    result[name] = load_runs(os.path.join(path, name))
+                except (ValueError, KeyError):
+                    pass  # Not a Google Benchmark file (e.g. loopback suite)
+        return result
+    return {os.path.basename(path): load_runs(path)}
+
+
+def mann_whitney_u(a, b):
+    """Two-sided Mann-Whitney U test (normal approximation with tie correction)."""
+    n1, n2 = len(a), len(b)
+    combined = sorted([(v, 0) for v in a] + [(v, 1) for v in b])
+
+    # Average ranks over ties
+    ranks = [0.0] * len(combined)
+    tie_term = 0.0
+    i = 0
+    while i < len(combined):
+        j = i
+        while j + 1 < len(combined) and combined[j + 1][0] == combined[i][0]:
+            j += 1
+        rank = (i + j) / 2.0 + 1.0
+        for k in range(i, j + 1):
+            ranks[k] = rank
+        t = j - i + 1
+        tie_term += t ** 3 - t
+        i = j + 1
+
+    r1 = sum(r for r, (_, group) in zip(ranks, combined) if group == 0)
+    u1 = r1 - n1 * (n1 + 1) / 2.0
+    mean_u = n1 * n2 / 2.0
+    n = n1 + n2
+    var_u = n1 * n2 / 12.0 * ((n + 1) - tie_term / (n * (n - 1)))
+    if var_u <= 0:
+        return 1.0
+    z = (abs(u1 - mean_u) - 0.5) / math.sqrt(var_u)
+    return max(0.0, min(1.0, math.erfc(max(z, 0.0) / math.sqrt(2.0))))
+
+
+def pct(new, old):
+    if old == 0:
+        return 0.0
+    return (new - old) / old
+
+
+def counter_changes(base, cur):
+    notes = []
+    for name in PERF_COUNTERS:
+        b = [r[name] for r in base if name in r]
+        c = [r[name] for r in cur if name in r]
+        if b and c:
+            change = pct(statistics.median(c), statistics.median(b))
+            if abs(change) >= 0.01:
+                notes.append("%s %+.1f%%" % (name, change * 100))
+    return ", ".join(notes)
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Compare benchmark results against a baseline")
+    parser.add_argument("baseline")
+    parser.add_argument("current")
+    parser.add_argument("--alpha", type=float, default=0.05,
+                        help="Significance level for the U test (default 0.05)")
+    parser.add_argument("--min-change", type=float, default=0.05,
+                        help="Minimum relative change to flag (default 0.05 = 5%%)")
+    args = parser.parse_args()
+
+    baseline = collect(args.baseline)
+    current = collect(args.current)
+
+    regressions = 0
+    improvements = 0
+    print("%-60s %12s %12s %8s %8s  %s" % ("Benchmark", "Baseline", "Current", "Change", "p", "Verdict"))
+    print("-" * 120)
+
+    for file_name in sorted(current):
+        if file_name not in baseline:
+            continue
+        base_runs = baseline[file_name]
+        for name, cur in current[file_name].items():
+            base = base_runs.get(name)
+            if not base:
+                continue
+
+            b_times = [r["cpu_time"] for r in base]
+            c_times = [r["cpu_time"] for r in cur]
+            unit = cur[0].get("time_unit", "ns")
+            change = pct(statistics.median(c_times), statistics.median(b_times))
+
+            if len(b_times) < 3 or len(c_times) < 3:
+                p_value = float("nan")
+                verdict = "n/a (need >= 3 repetitions)"
+            else:
+                p_value = mann_whitney_u(b_times, c_times)
+                if p_value < args.alpha and change > args.min_change:
+                    verdict = "REGRESSION"
+                    regressions += 1
+                elif p_value < args.alpha and change < -args.min_change:
+                    verdict = "improvement"
+                    improvements += 1
+                else:
+                    verdict = "same"
+
+            if verdict in ("REGRESSION", "improvement"):
+                notes = counter_changes(base, cur)
+                if notes:
+                    verdict += " [" + notes + "]"
+
+            print("%-60s %9.1f %-2s %9.1f %-2s %+7.1f%% %8.3f  %s" % (
+                name[:60], statistics.median(b_times), unit, statistics.median(c_times), unit,
+                change * 100, p_value, verdict))
+
+    print("-" * 120)
+    print("%d regression(s), %d improvement(s)" % (regressions, improvements))
+    return 1 if regressions else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
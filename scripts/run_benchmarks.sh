@@ -10,6 +10,31 @@ echo -e "${BLUE}========================================${NC}"
 echo -e "${BLUE}Market Data Feed Handler - Benchmarks${NC}"
 echo -e "${BLUE}========================================${NC}\n"
 
+# Options:
+#   --repetitions N         Repetitions per benchmark (default 5; needed for compare)
+#   --save-baseline NAME    Store results as benchmarks/baselines/NAME
+#   --compare NAME          Flag significant regressions against a stored baseline
+REPETITIONS=5
+SAVE_BASELINE=""
+COMPARE_BASELINE=""
+while [[ $# -gt 0 ]]; do
+    case "$1" in
+        --repetitions) REPETITIONS="$2"; shift 2 ;;
+        --save-baseline) SAVE_BASELINE="$2"; shift 2 ;;
+        --compare) COMPARE_BASELINE="$2"; shift 2 ;;
+        *) echo -e "${RED}Unknown option: $1${NC}"; exit 1 ;;
+    esac
+done
+BASELINE_DIR="benchmarks/baselines"
+
+if [ -n "$COMPARE_BASELINE" ] && [ ! -d "$BASELINE_DIR/$COMPARE_BASELINE" ]; then
+    echo -e "${RED}Error: baseline '$COMPARE_BASELINE' not found in $BASELINE_DIR${NC}"
+    exit 1
+fi
+
+# Repetitions give the compare step a distribution per benchmark
+BENCH_ARGS="--benchmark_repetitions=$REPETITIONS --benchmark_out_format=json"
+
 # Build directory
 BUILD_DIR="../build"
 BENCHMARK_DIR="$BUILD_DIR/benchmarks"
@@ -27,22 +52,77 @@ mkdir -p "$RESULTS_DIR"
 
 # Run each benchmark
 echo -e "${GREEN}Running Parser Benchmark...${NC}"
-$BENCHMARK_DIR/parser_benchmark --benchmark_out=$RESULTS_DIR/parser.json --benchmark_out_format=json
+$BENCHMARK_DIR/parser_benchmark --benchmark_out=$RESULTS_DIR/parser.json $BENCH_ARGS
 
 echo -e "\n${GREEN}Running Cache Benchmark...${NC}"
-$BENCHMARK_DIR/cache_benchmark --benchmark_out=$RESULTS_DIR/cache.json --benchmark_out_format=json
+$BENCHMARK_DIR/cache_benchmark --benchmark_out=$RESULTS_DIR/cache.json $BENCH_ARGS
 
 echo -e "\n${GREEN}Running Latency Tracker Benchmark...${NC}"
-$BENCHMARK_DIR/latency_benchmark --benchmark_out=$RESULTS_DIR/latency.json --benchmark_out_format=json
+$BENCHMARK_DIR/latency_benchmark --benchmark_out=$RESULTS_DIR/latency.json $BENCH_ARGS
 
 echo -e "\n${GREEN}Running Tick Generator Benchmark...${NC}"
-$BENCHMARK_DIR/tick_generator_benchmark --benchmark_out=$RESULTS_DIR/tick_generator.json --benchmark_out_format=json
+$BENCHMARK_DIR/tick_generator_benchmark --benchmark_out=$RESULTS_DIR/tick_generator.json $BENCH_ARGS
 
 echo -e "\n${GREEN}Running Memory Pool Benchmark...${NC}"
-$BENCHMARK_DIR/memory_pool_benchmark --benchmark_out=$RESULTS_DIR/memory_pool.json --benchmark_out_format=json
+$BENCHMARK_DIR/memory_pool_benchmark --benchmark_out=$RESULTS_DIR/memory_pool.json $BENCH_ARGS
 
 echo -e "\n${GREEN}Running Socket Benchmark...${NC}"
-$BENCHMARK_DIR/socket_benchmark --benchmark_out=$RESULTS_DIR/socket.json --benchmark_out_format=json
+$BENCHMARK_DIR/socket_benchmark --benchmark_out=$RESULTS_DIR/socket.json $BENCH_ARGS
+
+echo -e "\n${GREEN}Running Logger Benchmark...${NC}"
+$BENCHMARK_DIR/logger_benchmark --benchmark_out=$RESULTS_DIR/logger.json $BENCH_ARGS
+
+echo -e "\n${GREEN}Running Clock Benchmark...${NC}"
+$BENCHMARK_DIR/clock_benchmark --benchmark_out=$RESULTS_DIR/clock.json $BENCH_ARGS
+
+echo -e "\n${GREEN}Running Trace Benchmark...${NC}"
+$BENCHMARK_DIR/trace_benchmark --benchmark_out=$RESULTS_DIR/trace.json $BENCH_ARGS
+
+echo -e "\n${GREEN}Running Pipeline Benchmark...${NC}"
+$BENCHMARK_DIR/pipeline_benchmark --benchmark_out=$RESULTS_DIR/pipeline.json $BENCH_ARGS
+
+echo -e "\n${GREEN}Running Consolidation Benchmark...${NC}"
+$BENCHMARK_DIR/consolidation_benchmark --benchmark_out=$RESULTS_DIR/consolidation.json $BENCH_ARGS
+
+echo -e "\n${GREEN}Running Index Engine Benchmark...${NC}"
+$BENCHMARK_DIR/index_benchmark --benchmark_out=$RESULTS_DIR/index.json $BENCH_ARGS
+
+echo -e "\n${GREEN}Running RNG Benchmark...${NC}"
+$BENCHMARK_DIR/rng_benchmark --benchmark_out=$RESULTS_DIR/rng.json $BENCH_ARGS
+
+echo -e "\n${GREEN}Running Timing Wheel Benchmark...${NC}"
+$BENCHMARK_DIR/timing_wheel_benchmark --benchmark_out=$RESULTS_DIR/timing_wheel.json $BENCH_ARGS
+
+echo -e "\n${GREEN}Running Symbol Universe Benchmark...${NC}"
+$BENCHMARK_DIR/symbol_universe_benchmark --benchmark_out=$RESULTS_DIR/symbol_universe.json $BENCH_ARGS
+
+echo -e "\n${GREEN}Running Symbol Map Benchmark...${NC}"
+$BENCHMARK_DIR/symbol_map_benchmark --benchmark_out=$RESULTS_DIR/symbol_map.json $BENCH_ARGS
+
+echo -e "\n${GREEN}Running Matching Engine Benchmark...${NC}"
+$BENCHMARK_DIR/matching_engine_benchmark --benchmark_out=$RESULTS_DIR/matching_engine.json $BENCH_ARGS
+
+echo -e "\n${GREEN}Running Loopback End-to-End Suite...${NC}"
+$BENCHMARK_DIR/loopback_benchmark --out=$RESULTS_DIR/loopback.json
+
+echo -e "\n${GREEN}Running Tick-to-Trade Suite...${NC}"
+$BENCHMARK_DIR/tick_to_trade_benchmark --out=$RESULTS_DIR/tick_to_trade.json
+
+if [ -n "$SAVE_BASELINE" ]; then
+    mkdir -p "$BASELINE_DIR/$SAVE_BASELINE"
+    cp $RESULTS_DIR/*.json "$BASELINE_DIR/$SAVE_BASELINE/"
+    echo -e "\n${GREEN}Baseline saved to $BASELINE_DIR/$SAVE_BASELINE${NC}"
+fi
+
+COMPARE_STATUS=0
+if [ -n "$COMPARE_BASELINE" ]; then
+    echo -e "\n${GREEN}Comparing against baseline '$COMPARE_BASELINE'...${NC}"
+    python3 scripts/compare_benchmarks.py "$BASELINE_DIR/$COMPARE_BASELINE" "$RESULTS_DIR"
+    COMPARE_STATUS=$?
+    if [ $COMPARE_STATUS -ne 0 ]; then
+        echo -e "${RED}Significant regressions detected${NC}"
+    fi
+fi
 
 echo -e "\n${BLUE}========================================${NC}"
 echo -e "${GREEN}All benchmarks completed!${NC}"
@@ -102,3 +182,5 @@ EOF
 
 echo -e "${GREEN}Summary created: $RESULTS_DIR/SUMMARY.txt${NC}"
 
+
+exit $COMPARE_STATUS
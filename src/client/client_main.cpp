@@ -1,5 +1,8 @@
 #include "client/feed_handler.h"
 #include "client/visualizer.h"
+#include "common/logger.h"
+#include "common/tsc_clock.h"
+#include "common/trace.h"
 #include <iostream>
 #include <csignal>
 #include <atomic>
@@ -28,19 +31,50 @@ int main(int argc, char* argv[]) {
     if (argc > 3) {
         num_symbols = static_cast<size_t>(std::atoi(argv[3]));
     }
+    uint64_t outlier_threshold_us = mdfh::OutlierRecorder::DEFAULT_END_TO_END_THRESHOLD_NS / 1000;
+    if (argc > 4) {
+        outlier_threshold_us = static_cast<uint64_t>(std::atoll(argv[4]));
+    }
+    uint32_t liveness_timeout_ms = mdfh::FeedHandler::DEFAULT_LIVENESS_TIMEOUT_MS;
+    if (argc > 5) {
+        liveness_timeout_ms = static_cast<uint32_t>(std::atoi(argv[5]));
+    }
+    
+    // Optional line B: same feed on a second port, arbitrated per symbol
+    uint16_t line_b_port = 0;
+    if (argc > 6) {
+        line_b_port = static_cast<uint16_t>(std::atoi(argv[6]));
+    }
     
     std::cout << "Starting Feed Handler..." << std::endl;
     std::cout << "Connecting to: " << host << ":" << port << std::endl;
+    if (line_b_port != 0) {
+        std::cout << "Line B: " << host << ":" << line_b_port << std::endl;
+    }
     std::cout << "Number of symbols: " << num_symbols << std::endl;
     std::cout << std::endl;
     
     // Install signal handler
     std::signal(SIGINT, signal_handler);
     std::signal(SIGTERM, signal_handler);
+#ifdef MDFH_TRACING
+    mdfh::Tracer::instance().set_thread_name("main");
+    // SIGUSR1 dumps the hot-path trace without stopping the client
+    std::signal(SIGUSR1, [](int) { mdfh::Tracer::instance().request_dump(); });
+#endif
+    
+    // Keep the TSC-to-nanosecond conversion calibrated while running
+    mdfh::TscClock::start_calibration_thread();
     
     try {
         // Create feed handler
         mdfh::FeedHandler handler(host, port, num_symbols);
+        handler.get_outlier_recorder().set_thresholds(
+            outlier_threshold_us * 1000, mdfh::OutlierRecorder::DEFAULT_STAGE_THRESHOLD_NS);
+        handler.set_liveness_timeout_ms(liveness_timeout_ms);
+        if (line_b_port != 0) {
+            handler.set_line_b(host, line_b_port);
+        }
         
         // Load symbol names from CSV file
         if (!handler.load_symbols("config/symbols.csv")) {
@@ -52,24 +86,21 @@ int main(int argc, char* argv[]) {
             return 1;
         }
         
-        // Subscribe to all symbols
-        std::vector<uint16_t> symbol_ids;
-        for (uint16_t i = 0; i < num_symbols; ++i) {
-            symbol_ids.push_back(i);
-        }
+        // Subscribe to all symbols (the ids behind the cache's slots)
+        const mdfh::SymbolMap& symbol_map = handler.get_symbol_map();
         
-        if (!handler.subscribe(symbol_ids)) {
+        if (!handler.subscribe(symbol_map.ids())) {
             std::cerr << "Failed to send subscription" << std::endl;
         }
         
         // Start visualizer
-        mdfh::Visualizer viz(handler.get_cache(), num_symbols);
+        mdfh::Visualizer viz(handler.get_cache(), symbol_map.size());
         viz.set_connection_info(host, port, handler.is_connected());
         
         // Pass symbol names to visualizer
         std::vector<std::string> symbol_names;
-        for (uint16_t i = 0; i < num_symbols; ++i) {
-            symbol_names.push_back(handler.get_symbol_name(i));
+        for (uint32_t slot = 0; slot < symbol_map.size(); ++slot) {
+            symbol_names.push_back(handler.get_symbol_name(symbol_map.id(slot)));
         }
         viz.set_symbol_names(symbol_names);
         
@@ -97,22 +128,52 @@ int main(int argc, char* argv[]) {
             
             last_messages = current_messages;
             last_time = now;
+            
+#ifdef MDFH_TRACING
+            mdfh::Tracer::instance().poll_dump("mdfh_client_trace.json");
+#endif
         }
         
         std::cout << "\nShutting down..." << std::endl;
         viz.stop();
         handler.stop();
+        mdfh::Logger::instance().flush();
         
         // Print final statistics
         std::cout << "\nFinal Statistics:" << std::endl;
         std::cout << "Total messages received: " << handler.get_messages_received() << std::endl;
         std::cout << "Total bytes received: " << handler.get_bytes_received() << std::endl;
+        auto feed_stats = handler.get_stats();
+        std::cout << "Heartbeats received: " << feed_stats.heartbeats_received
+                  << ", liveness timeouts: " << feed_stats.liveness_timeouts << std::endl;
+        std::cout << "Reconnects: " << feed_stats.reconnects
+                  << ", recovery last: " << (feed_stats.last_recovery_ns / 1000000) << "ms"
+                  << ", max: " << (feed_stats.max_recovery_ns / 1000000) << "ms" << std::endl;
+        if (handler.is_arbitrating()) {
+            auto arb = handler.get_arbitration_stats();
+            std::cout << "A/B wins - A: " << arb.wins[0] << ", B: " << arb.wins[1]
+                      << ", duplicates dropped: " << arb.duplicates
+                      << ", copies held for other line: " << arb.gaps_deferred
+                      << ", session restarts: " << arb.restarts << std::endl;
+            std::cout << "A/B lead p50 - A: " << (arb.advantage[0].p50 / 1000) << "μs"
+                      << " (" << arb.advantage[0].sample_count << " samples)"
+                      << ", B: " << (arb.advantage[1].p50 / 1000) << "μs"
+                      << " (" << arb.advantage[1].sample_count << " samples)"
+                      << ", line gaps A/B: " << arb.line_gaps[0] << "/" << arb.line_gaps[1] << std::endl;
+        }
         
         auto stats = handler.get_latency_stats();
         std::cout << "Latency - p50: " << (stats.p50/1000) << "μs, "
                   << "p99: " << (stats.p99/1000) << "μs, "
                   << "p999: " << (stats.p999/1000) << "μs" << std::endl;
         
+        const auto& outliers = handler.get_outlier_recorder();
+        std::cout << "Latency outliers: " << outliers.get_outlier_count() << std::endl;
+        if (outliers.get_outlier_count() > 0 &&
+            outliers.export_to_csv("mdfh_client_outliers.csv")) {
+            std::cout << "Outlier details written to mdfh_client_outliers.csv" << std::endl;
+        }
+        
     } catch (const std::exception& e) {
         std::cerr << "Error: " << e.what() << std::endl;
         return 1;
@@ -1,9 +1,12 @@
 #include "client/feed_handler.h"
-#include <iostream>
+#include "common/logger.h"
+#include "common/symbol_universe.h"
+#include "common/tsc_clock.h"
 #include <thread>
 #include <chrono>
-#include <fstream>
-#include <sstream>
+#include <limits>
+#include <unordered_set>
+#include <sched.h>
 
 namespace mdfh {
 
@@ -11,14 +14,25 @@ FeedHandler::FeedHandler(const std::string& host, uint16_t port, size_t num_symb
     : host_(host),
       port_(port),
       num_symbols_(num_symbols),
+      symbol_map_(num_symbols),
       running_(false),
       messages_received_(0),
-      bytes_received_(0) {
+      bytes_received_(0),
+      heartbeats_received_(0),
+      liveness_timeouts_(0),
+      liveness_timeout_ms_(DEFAULT_LIVENESS_TIMEOUT_MS),
+      reconnects_(0),
+      last_recovery_ns_(0),
+      max_recovery_ns_(0),
+      duplicates_(0),
+      gaps_deferred_(0),
+      arbitrated_gaps_(0),
+      restarts_(0) {
     
-    socket_ = std::make_unique<MarketDataSocket>();
-    parser_ = std::make_unique<BinaryParser>();
     cache_ = std::make_unique<SymbolCache>(num_symbols);
     latency_tracker_ = std::make_unique<LatencyTracker>();
+    end_to_end_tracker_ = std::make_unique<LatencyTracker>();
+    outlier_recorder_ = std::make_unique<OutlierRecorder>();
     
     // Initialize symbol names with default names
     symbol_names_.resize(num_symbols);
@@ -26,39 +40,101 @@ FeedHandler::FeedHandler(const std::string& host, uint16_t port, size_t num_symb
         symbol_names_[i] = "SYM" + std::to_string(i);
     }
     
-    // Set up generic message handler (low-latency mode)
-    parser_->set_generic_handler([this](const auto& msg) {
-        this->handle_message(msg);
-    });
+    add_line(host, port);
 }
 
 FeedHandler::~FeedHandler() {
     stop();
 }
 
+void FeedHandler::add_line(const std::string& host, uint16_t port) {
+    const size_t index = lines_.size();
+    auto line = std::make_unique<Line>();
+    line->index = index;
+    line->host = host;
+    line->port = port;
+    line->socket = std::make_unique<MarketDataSocket>();
+    line->parser = std::make_unique<BinaryParser>();
+    line->parser->set_symbol_map(&symbol_map_);
+    line->advantage = std::make_unique<LatencyTracker>();
+    line->backoff_ms = INITIAL_BACKOFF_MS;
+    
+    // Set up generic message handler (low-latency mode). With two lines
+    // every market data copy is arbitrated before it reaches the cache.
+    line->parser->set_generic_handler([this, index](const auto& msg) {
+        uint64_t dispatch_start = TscClock::now_ticks();
+        using MessageT = std::decay_t<decltype(msg)>;
+        if constexpr (std::is_same_v<MessageT, HeartbeatMessage>) {
+            this->dispatch(msg, SymbolMap::NO_SLOT, dispatch_start);
+        } else {
+            uint32_t slot = symbol_map_.slot(msg.header.symbol_id);
+            if (arbitration_.empty()) {
+                this->dispatch(msg, slot, dispatch_start);
+                return;
+            }
+            switch (this->arbitrate(index, msg.header, slot)) {
+                case Verdict::DROP:
+                    return;
+                case Verdict::DEFER:
+                    this->defer(index, msg, slot);
+                    return;
+                case Verdict::APPLY:
+                    break;
+            }
+            this->dispatch(msg, slot, dispatch_start);
+            // A gap just filled: copies held back behind it follow in order
+            if (slot < arbitration_.size() && !arbitration_[slot].deferred.empty()) {
+                this->release_deferred(slot, false);
+            }
+        }
+    });
+    
+    lines_.push_back(std::move(line));
+}
+
+void FeedHandler::set_line_b(const std::string& host, uint16_t port) {
+    if (running_ || lines_.size() >= MAX_LINES) {
+        MDFH_LOG_WARN("Line B must be configured once, before start()");
+        return;
+    }
+    add_line(host, port);
+    arbitration_.assign(symbol_map_.size(), ArbitrationState{});
+}
+
 bool FeedHandler::connect(const std::string& host, uint16_t port) {
-    if (!socket_->connect(host, port)) {
-        std::cerr << "Failed to connect to " << host << ":" << port << std::endl;
+    if (!lines_[0]->socket->connect(host, port)) {
+        MDFH_LOG_ERROR("Failed to connect to {}:{}", host, port);
         return false;
     }
-    std::cout << "Connected to " << host << ":" << port << std::endl;
+    MDFH_LOG_INFO("Connected to {}:{}", host, port);
     return true;
 }
 
 void FeedHandler::disconnect() {
     stop();
-    socket_->disconnect();
+    std::scoped_lock lock(control_mutex_);
+    for (auto& line : lines_) {
+        line->socket->disconnect();
+    }
 }
 
 bool FeedHandler::start() {
-    if (!socket_->is_connected()) {
-        if (!socket_->connect(host_, port_)) {
-            std::cerr << "Failed to connect to " << host_ << ":" << port_ << std::endl;
-            return false;
+    std::unique_lock lock(control_mutex_);
+    bool any_connected = false;
+    uint64_t now_ns = TscClock::now_ns();
+    for (auto& line : lines_) {
+        if (!line->socket->is_connected() && !line->socket->connect(line->host, line->port)) {
+            MDFH_LOG_ERROR("Failed to connect to {}:{}", line->host, line->port);
+            line->next_attempt_ns = now_ns + INITIAL_BACKOFF_MS * 1000000ULL;
+            continue;
         }
+        MDFH_LOG_INFO("Connected to {}:{}", line->host, line->port);
+        any_connected = true;
     }
-    
-    std::cout << "Connected to " << host_ << ":" << port_ << std::endl;
+    if (!any_connected) {
+        return false;
+    }
+    lock.unlock();
     
     running_ = true;
     receiver_thread_ = std::thread(&FeedHandler::receiver_loop, this);
@@ -73,132 +149,518 @@ void FeedHandler::stop() {
         receiver_thread_.join();
     }
     
-    socket_->disconnect();
+    std::scoped_lock lock(control_mutex_);
+    for (auto& line : lines_) {
+        line->socket->disconnect();
+    }
 }
 
-bool FeedHandler::subscribe(const std::vector<uint16_t>& symbol_ids) {
-    return socket_->send_subscription(symbol_ids);
+bool FeedHandler::subscribe(const std::vector<SymbolId>& symbol_ids) {
+    if (symbol_ids.size() > MAX_SUBSCRIPTION_COUNT) {
+        MDFH_LOG_WARN("Subscription of {} symbols exceeds the {} a request can carry",
+                      symbol_ids.size(), MAX_SUBSCRIPTION_COUNT);
+        return false;
+    }
+    std::scoped_lock lock(control_mutex_);
+    bool sent = false;
+    for (auto& line : lines_) {
+        // A line that is down gets the list with its resume request
+        if (line->socket->send_subscription(symbol_ids)) {
+            sent = true;
+        }
+    }
+    if (!sent) {
+        return false;
+    }
+    subscription_ = symbol_ids;
+    return true;
 }
 
 bool FeedHandler::load_symbols(const std::string& symbols_file) {
-    std::ifstream file(symbols_file);
-    if (!file.is_open()) {
-        std::cerr << "Failed to open symbols file: " << symbols_file << std::endl;
+    if (running_) {
+        MDFH_LOG_WARN("Symbols must be loaded before start()");
         return false;
     }
     
-    std::string line;
-    // Skip header line
-    if (!std::getline(file, line)) {
-        std::cerr << "Empty symbols file" << std::endl;
+    // Same loader as the server: CSV or binary universe. We only need
+    // symbol_id and symbol_name
+    std::vector<SymbolId> ids;
+    std::vector<std::string> names;
+    SymbolId max_id = 0;
+    try {
+        SymbolUniverse universe = SymbolUniverse::load(symbols_file);
+        for (const SymbolRecord& record : universe) {
+            ids.push_back(record.symbol_id);
+            names.emplace_back(universe.name(record));
+            max_id = std::max(max_id, record.symbol_id);
+        }
+    } catch (const std::exception& e) {
+        MDFH_LOG_ERROR("Failed to load symbols file: {}", e.what());
         return false;
     }
     
-    size_t loaded_count = 0;
-    while (std::getline(file, line)) {
-        std::istringstream iss(line);
-        uint16_t symbol_id;
-        std::string symbol_name;
-        
-        // Read: symbol_id,symbol,price,volatility,drift
-        // We only need symbol_id and symbol_name
-        if ((iss >> symbol_id) && iss.ignore() &&
-            std::getline(iss, symbol_name, ',')) {
-            
-            // Validate symbol_id
-            if (symbol_id >= num_symbols_) {
-                std::cerr << "Warning: Symbol ID " << symbol_id 
-                          << " exceeds max symbols " << num_symbols_ 
-                          << ", skipping" << std::endl;
-                continue;
-            }
-            
-            symbol_names_[symbol_id] = symbol_name;
-            loaded_count++;
+    // Drop duplicates; keep at most num_symbols ids, in file order
+    std::vector<SymbolId> kept;
+    std::vector<std::string> kept_names;
+    std::unordered_set<SymbolId> seen;
+    seen.reserve(std::min(ids.size(), num_symbols_));
+    SymbolId max_kept = 0;
+    for (size_t i = 0; i < ids.size(); ++i) {
+        SymbolId id = ids[i];
+        if (kept.size() == num_symbols_) {
+            break;
+        }
+        if (!seen.insert(id).second) {
+            continue;
+        }
+        kept.push_back(id);
+        kept_names.push_back(std::move(names[i]));
+        max_kept = std::max(max_kept, id);
+    }
+    size_t skipped = ids.size() - kept.size();
+    
+    // Ids that fill most of [0, num_symbols) are their own slots. Wide or
+    // sparse ids are remapped instead: they take the slots in file order and
+    // the per-symbol arrays shrink to them, so memory follows the symbols
+    // tracked rather than the id range.
+    if (!kept.empty() && (max_kept >= num_symbols_ || kept.size() * 2 < num_symbols_)) {
+        symbol_map_ = SymbolMap(kept);
+        cache_ = std::make_unique<SymbolCache>(kept.size());
+        symbol_names_.assign(kept.size(), std::string());
+        if (!arbitration_.empty()) {
+            arbitration_.assign(kept.size(), ArbitrationState{});
         }
+        MDFH_LOG_INFO("Symbol ids up to {} remapped onto {} local slots", max_id, kept.size());
+    } else {
+        symbol_map_ = SymbolMap(num_symbols_);
+    }
+    ids = std::move(kept);
+    names = std::move(kept_names);
+    
+    for (size_t i = 0; i < ids.size(); ++i) {
+        symbol_names_[symbol_map_.slot(ids[i])] = std::move(names[i]);
+    }
+    if (skipped > 0) {
+        MDFH_LOG_WARN("{} symbols skipped (duplicate or more than {} symbols)", skipped, num_symbols_);
     }
     
-    std::cout << "Loaded " << loaded_count << " symbol names from " << symbols_file << std::endl;
+    size_t loaded_count = ids.size();
+    MDFH_LOG_INFO("Loaded {} symbol names from {}", loaded_count, symbols_file);
     return loaded_count > 0;
 }
 
-std::string FeedHandler::get_symbol_name(uint16_t symbol_id) const {
-    if (symbol_id < symbol_names_.size()) {
-        return symbol_names_[symbol_id];
+std::string FeedHandler::get_symbol_name(SymbolId symbol_id) const {
+    uint32_t slot = symbol_map_.slot(symbol_id);
+    if (slot < symbol_names_.size()) {
+        return symbol_names_[slot];
     }
     return "UNKNOWN";
 }
 
 bool FeedHandler::is_connected() const {
-    return socket_->is_connected();
+    for (const auto& line : lines_) {
+        if (line->socket->is_connected()) {
+            return true;
+        }
+    }
+    return false;
 }
 
 void FeedHandler::receiver_loop() {
     constexpr size_t BUFFER_SIZE = 65536;
     std::vector<uint8_t> buffer(BUFFER_SIZE);
     
+#ifdef MDFH_TRACING
+    Tracer::instance().set_thread_name("receiver");
+#endif
+    
     while (running_) {
-        if (!socket_->is_connected()) {
-            if (!reconnect()) {
-                std::this_thread::sleep_for(std::chrono::seconds(1));
-                continue;
+        // One thread services every line, so arbitration state is never shared
+        bool received = false;
+        bool connected = false;
+        for (auto& line : lines_) {
+            if (poll_line(*line, buffer.data(), BUFFER_SIZE) > 0) {
+                received = true;
+            }
+            connected |= line->socket->is_connected();
+        }
+        if (!received) {
+            // Reconnects never block: stop() is honoured within a millisecond
+            if (connected) {
+                std::this_thread::sleep_for(std::chrono::microseconds(100));
+            } else {
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
             }
         }
+    }
+}
+
+ssize_t FeedHandler::poll_line(Line& line, uint8_t* buffer, size_t buffer_size) {
+    if (!line.socket->is_connected()) {
+        if (line.live) {
+            on_feed_lost(line, "connection closed");
+        }
+        reconnect_step(line);
+        if (!line.socket->is_connected()) {
+            return 0;
+        }
+    }
+    if (!line.live) {
+        // Fresh connection: the timer starts now, not at the last byte of the old one
+        line.live = true;
+        line.last_receive_ticks = TscClock::now_ticks();
+    }
+    
+    uint64_t receive_start = TscClock::now_ticks();
+    
+    ssize_t n;
+    {
+        MDFH_TRACE_ZONE(RECEIVE);
+        n = line.socket->receive(buffer, buffer_size);
+    }
+    
+    if (n > 0) {
+        uint64_t receive_end = TscClock::now_ticks();
+        latency_tracker_->record(TscClock::delta_to_ns(receive_end - receive_start));
+        line.last_receive_ticks = receive_end;
+        if (__builtin_expect(line.recovering, 0)) {
+            on_recovered(line, TscClock::to_ns(receive_end));
+        }
         
-        auto receive_start = std::chrono::steady_clock::now();
+        process_batch(buffer, n, receive_start, receive_end, line.index);
+    } else if (n == 0) {
+        // Would block or connection closed. The server heartbeats idle
+        // links, so silence longer than the timeout means a dead feed.
+        uint32_t timeout_ms = liveness_timeout_ms_.load(std::memory_order_relaxed);
+        if (timeout_ms > 0 && line.socket->is_connected() &&
+            TscClock::delta_to_ns(receive_start - line.last_receive_ticks) > timeout_ms * 1000000ULL) {
+            liveness_timeouts_.fetch_add(1, std::memory_order_relaxed);
+            MDFH_LOG_WARN("No data from {}:{} for {} ms, reconnecting", line.host, line.port, timeout_ms);
+            on_feed_lost(line, "liveness timeout");
+            std::scoped_lock lock(control_mutex_);
+            line.socket->disconnect();
+        }
+    } else {
+        // Error
+        MDFH_LOG_WARN("Receive error on {}:{}, attempting reconnect...", line.host, line.port);
+        std::scoped_lock lock(control_mutex_);
+        line.socket->disconnect();
+    }
+    return n;
+}
+
+size_t FeedHandler::process_batch(const void* data, size_t len,
+                                  uint64_t receive_start_ticks, uint64_t receive_end_ticks,
+                                  size_t line) {
+    batch_line_ = lines_[line].get();
+    batch_receive_start_ = receive_start_ticks;
+    batch_receive_end_ = receive_end_ticks;
+    batch_bytes_ = static_cast<uint32_t>(len);
+    batch_index_ = 0;
+    
+    bytes_received_ += len;
+    MDFH_TRACE_ZONE(PARSE);
+    return batch_line_->parser->parse(data, len);
+}
+
+FeedHandler::Verdict FeedHandler::arbitrate(size_t line, const MessageHeader& header, uint32_t symbol_slot) {
+    if (symbol_slot >= arbitration_.size()) {
+        return Verdict::APPLY;  // Not a tracked symbol; the cache rejects it
+    }
+    ArbitrationState& state = arbitration_[symbol_slot];
+    const uint32_t seq = header.seq_num;
+    const size_t other = line ^ 1;
+    
+    // A line's sequence going back on the same connection is a late or
+    // reordered copy: the line keeps its high-water mark and the copy is
+    // dropped unless it is the next one to apply. Only after a reconnect
+    // does going back mean the server restarted.
+    const uint32_t session = lines_[line]->session;
+    const bool late = seq < state.line_seq[line] && state.line_session[line] == session;
+    if (seq >= state.line_seq[line]) {
+        state.line_seq[line] = seq;
+    } else if (state.line_session[line] != session) {
+        // New session: start over from this copy; held copies belong to the
+        // old session and are discarded
+        MDFH_LOG_WARN_RL(10, "Symbol {} restarted at sequence {} on line {}:{} (was {}), new session",
+                         header.symbol_id, seq, lines_[line]->host, lines_[line]->port, state.line_seq[line]);
+        std::vector<DeferredMessage> deferred = std::move(state.deferred);
+        deferred.clear();
+        state = ArbitrationState{};
+        state.deferred = std::move(deferred);
+        state.line_seq[line] = seq;
+        restarts_.store(restarts_.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    }
+    state.line_session[line] = session;
+    
+    if (seq <= state.applied_seq) {
+        // The other line was first: drop the copy, credit the winner's lead
+        size_t slot = seq % WIN_HISTORY;
+        if (state.win_seq[slot] == seq && state.win_line[slot] != line) {
+            lines_[state.win_line[slot]]->advantage->record(
+                TscClock::delta_to_ns(batch_receive_end_ - state.win_ticks[slot]));
+            state.win_seq[slot] = 0;
+        }
+        duplicates_.store(duplicates_.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        return Verdict::DROP;
+    }
+    if (late && seq != state.applied_seq + 1) {
+        // Held copies stay in line order, so a late one is not held behind them
+        duplicates_.store(duplicates_.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        return Verdict::DROP;
+    }
+    
+    while (state.applied_seq != 0 && seq != state.applied_seq + 1) {
+        // Gap on this line. If the other line is live and has not yet reached
+        // the missing messages, it still carries them: hold this copy until
+        // they arrive. Otherwise both lines miss them and the gap is real.
+        uint32_t other_seq = state.line_seq[other];
+        size_t held = state.deferred.size() - state.deferred_head;
+        if (lines_[other]->live && other_seq <= state.applied_seq &&
+            seq - other_seq <= MAX_DEFERRED_SEQS && held < MAX_DEFERRED_SEQS) {
+            gaps_deferred_.store(gaps_deferred_.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+            return Verdict::DEFER;
+        }
+        arbitrated_gaps_.store(arbitrated_gaps_.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
         
-        ssize_t n = socket_->receive(buffer.data(), BUFFER_SIZE);
+        // Copies held back before this one go out first, in order
+        if (held == 0 || state.deferred[state.deferred_head].seq > seq) {
+            break;
+        }
+        release_deferred(symbol_slot, true);
+        if (seq <= state.applied_seq) {
+            duplicates_.store(duplicates_.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+            return Verdict::DROP;
+        }
+    }
+    
+    record_win(state, line, seq, batch_receive_end_);
+    return Verdict::APPLY;
+}
+
+void FeedHandler::record_win(ArbitrationState& state, size_t line, uint32_t seq, uint64_t receive_ticks) {
+    state.applied_seq = seq;
+    size_t slot = seq % WIN_HISTORY;
+    state.win_seq[slot] = seq;
+    state.win_line[slot] = static_cast<uint8_t>(line);
+    state.win_ticks[slot] = receive_ticks;
+    std::atomic<uint64_t>& wins = lines_[line]->wins;
+    wins.store(wins.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+}
+
+void FeedHandler::release_deferred(uint32_t symbol_slot, bool skip_gap) {
+    ArbitrationState& state = arbitration_[symbol_slot];
+    while (state.deferred_head < state.deferred.size()) {
+        const DeferredMessage& entry = state.deferred[state.deferred_head];
+        if (entry.seq <= state.applied_seq) {
+            // The other line delivered it meanwhile
+            state.deferred_head++;
+            duplicates_.store(duplicates_.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+            continue;
+        }
+        if (entry.seq != state.applied_seq + 1 && !skip_gap) {
+            break;
+        }
+        skip_gap = false;
+        state.deferred_head++;
+        record_win(state, entry.line, entry.seq, entry.receive_ticks);
         
-        if (n > 0) {
-            auto receive_end = std::chrono::steady_clock::now();
-            auto latency = std::chrono::duration_cast<std::chrono::nanoseconds>(
-                receive_end - receive_start).count();
-            
-            latency_tracker_->record(latency);
-            
-            bytes_received_ += n;
-            parser_->parse(buffer.data(), n);
-        } else if (n == 0) {
-            // Would block or connection closed
-            std::this_thread::sleep_for(std::chrono::microseconds(100));
+        uint64_t dispatch_start = TscClock::now_ticks();
+        if (entry.type == MessageType::TRADE) {
+            TradeMessage msg;
+            std::memcpy(&msg, entry.bytes, sizeof(msg));
+            dispatch(msg, symbol_slot, dispatch_start);
         } else {
-            // Error
-            std::cerr << "Receive error, attempting reconnect..." << std::endl;
-            socket_->disconnect();
+            QuoteMessage msg;
+            std::memcpy(&msg, entry.bytes, sizeof(msg));
+            dispatch(msg, symbol_slot, dispatch_start);
         }
     }
+    if (state.deferred_head == state.deferred.size()) {
+        state.deferred.clear();
+        state.deferred_head = 0;
+    }
 }
 
-bool FeedHandler::reconnect() {
-    int backoff_ms = INITIAL_BACKOFF_MS;
+void FeedHandler::on_feed_lost(Line& line, const char* reason) {
+    line.live = false;
     
-    for (int attempt = 0; attempt < MAX_RECONNECT_ATTEMPTS; ++attempt) {
-        std::cout << "Reconnection attempt " << (attempt + 1) << "..." << std::endl;
-        
-        if (socket_->connect(host_, port_)) {
-            std::cout << "Reconnected successfully" << std::endl;
-            return true;
+    // Copies the other line held back for this one to fill will not be
+    // filled now: count the gaps and apply them
+    for (uint32_t slot = 0; slot < arbitration_.size(); ++slot) {
+        ArbitrationState& state = arbitration_[slot];
+        while (!state.deferred.empty() && state.deferred[state.deferred_head].line != line.index) {
+            arbitrated_gaps_.store(arbitrated_gaps_.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+            release_deferred(slot, true);
         }
+    }
+    
+    bool any_live = std::any_of(lines_.begin(), lines_.end(),
+                                [](const auto& l) { return l->live; });
+    if (any_live) {
+        MDFH_LOG_WARN("Line {}:{} lost ({}), still served by the other line", line.host, line.port, reason);
+    } else {
+        cache_->mark_all_stale();
+        if (consolidated_book_) {
+            consolidated_book_->mark_venue_stale(venue_);
+        }
+        MDFH_LOG_WARN("Feed lost ({}), all symbols marked stale", reason);
+    }
+    
+    // Recovery is timed from the first loss, even if a reconnect fails again
+    // before any data arrives
+    uint64_t now_ns = TscClock::now_ns();
+    if (!line.recovering) {
+        line.feed_lost_ns = now_ns;
+    }
+    line.recovering = false;
+    line.reconnect_state = ReconnectState::WAITING;
+    line.next_attempt_ns = now_ns;  // First attempt right away
+    line.backoff_ms = INITIAL_BACKOFF_MS;
+    line.reconnect_attempts = 0;
+}
+
+void FeedHandler::reconnect_step(Line& line) {
+    uint64_t now_ns = TscClock::now_ns();
+    MarketDataSocket::ConnectStatus status;
+    
+    if (line.reconnect_state == ReconnectState::WAITING) {
+        if (now_ns < line.next_attempt_ns) {
+            return;
+        }
+        line.reconnect_attempts++;
+        MDFH_LOG_INFO("Reconnection attempt {} to {}:{}...", line.reconnect_attempts, line.host, line.port);
         
-        std::this_thread::sleep_for(std::chrono::milliseconds(backoff_ms));
-        
-        // Exponential backoff
-        backoff_ms = std::min(backoff_ms * 2, MAX_BACKOFF_MS);
+        std::scoped_lock lock(control_mutex_);
+        status = line.socket->start_connect(line.host, line.port);
+        line.reconnect_state = ReconnectState::CONNECTING;
+        line.connect_deadline_ns = now_ns + CONNECT_TIMEOUT_MS * 1000000ULL;
+    } else {
+        std::scoped_lock lock(control_mutex_);
+        status = line.socket->poll_connect();
+        if (status == MarketDataSocket::ConnectStatus::IN_PROGRESS && now_ns >= line.connect_deadline_ns) {
+            line.socket->disconnect();
+            status = MarketDataSocket::ConnectStatus::FAILED;
+        }
     }
     
-    std::cerr << "Failed to reconnect after " << MAX_RECONNECT_ATTEMPTS 
-              << " attempts" << std::endl;
-    return false;
+    if (status == MarketDataSocket::ConnectStatus::CONNECTED) {
+        on_reconnected(line);
+    } else if (status == MarketDataSocket::ConnectStatus::FAILED) {
+        schedule_reconnect(line, now_ns);
+    }
+}
+
+void FeedHandler::schedule_reconnect(Line& line, uint64_t now_ns) {
+    line.reconnect_state = ReconnectState::WAITING;
+    line.next_attempt_ns = now_ns + line.backoff_ms * 1000000ULL;
+    
+    // Exponential backoff
+    line.backoff_ms = std::min(line.backoff_ms * 2, MAX_BACKOFF_MS);
+}
+
+uint32_t FeedHandler::get_resume_sequence(const Line& line, SymbolId symbol_id) const {
+    // With two lines the cache reflects the arbitrated stream, not this line's
+    uint32_t slot = symbol_map_.slot(symbol_id);
+    if (slot < arbitration_.size()) {
+        return arbitration_[slot].applied_seq;
+    }
+    return line.parser->get_last_sequence(symbol_id);
+}
+
+void FeedHandler::on_reconnected(Line& line) {
+    // Bytes of a message cut off by the old connection must not be glued
+    // to the new stream; sequence state is kept so gaps stay visible
+    line.parser->reset_buffer();
+    reconnects_.fetch_add(1, std::memory_order_relaxed);
+    line.recovering = line.feed_lost_ns != 0;
+    line.session++;
+    
+    std::scoped_lock lock(control_mutex_);
+    MDFH_LOG_INFO("Reconnected to {}:{} after {} attempt(s)", line.host, line.port, line.reconnect_attempts);
+    if (subscription_.empty()) {
+        return;
+    }
+    
+    // Re-subscribe and ask for everything after the last sequence seen per
+    // symbol; symbols stay stale until their first update arrives. subscribe()
+    // keeps the list within MAX_SUBSCRIPTION_COUNT, so it fits one request.
+    std::vector<uint32_t> last_seqs(subscription_.size());
+    for (size_t i = 0; i < subscription_.size(); ++i) {
+        last_seqs[i] = get_resume_sequence(line, subscription_[i]);
+    }
+    if (!line.socket->send_resume(subscription_, last_seqs)) {
+        MDFH_LOG_WARN("Failed to resume subscription of {} symbols", subscription_.size());
+    }
+}
+
+void FeedHandler::on_recovered(Line& line, uint64_t now_ns) {
+    line.recovering = false;
+    uint64_t recovery_ns = now_ns > line.feed_lost_ns ? now_ns - line.feed_lost_ns : 0;
+    last_recovery_ns_.store(recovery_ns, std::memory_order_relaxed);
+    if (recovery_ns > max_recovery_ns_.load(std::memory_order_relaxed)) {
+        max_recovery_ns_.store(recovery_ns, std::memory_order_relaxed);
+    }
+    MDFH_LOG_INFO("Feed from {}:{} recovered in {} us", line.host, line.port, recovery_ns / 1000);
+}
+
+void FeedHandler::capture_outlier(const MessageHeader& header, uint64_t dispatch_end,
+                                  uint64_t end_to_end_ns, uint64_t receive_ns,
+                                  uint64_t queue_ns, uint64_t dispatch_ns, uint32_t batch_index) {
+    auto clamp32 = [](uint64_t v) {
+        return static_cast<uint32_t>(std::min<uint64_t>(v, std::numeric_limits<uint32_t>::max()));
+    };
+    
+    OutlierRecord record{};
+    record.capture_ticks = dispatch_end;
+    record.exchange_timestamp_ns = header.timestamp;
+    record.end_to_end_ns = end_to_end_ns;
+    record.stage_ns[static_cast<size_t>(LatencyStage::RECEIVE)] = clamp32(receive_ns);
+    record.stage_ns[static_cast<size_t>(LatencyStage::QUEUE)] = clamp32(queue_ns);
+    record.stage_ns[static_cast<size_t>(LatencyStage::DISPATCH)] = clamp32(dispatch_ns);
+    record.seq_num = header.seq_num;
+    record.symbol_id = header.symbol_id;
+    record.msg_type = header.msg_type;
+    record.batch_bytes = batch_bytes_;
+    record.batch_index = batch_index;
+    record.parser_buffer_fill = static_cast<uint32_t>(batch_line_->parser->get_buffer_fill());
+    record.cpu = sched_getcpu();
+    
+    outlier_recorder_->capture(record);
 }
 
 FeedHandler::FeedHandlerStats FeedHandler::get_stats() const {
-    FeedHandlerStats stats;
+    FeedHandlerStats stats{};
     stats.messages_received = messages_received_;
-    stats.messages_parsed = parser_->get_messages_parsed();
+    for (const auto& line : lines_) {
+        stats.messages_parsed += line->parser->get_messages_parsed();
+        stats.sequence_gaps += line->parser->get_sequence_gaps();
+        stats.fragmented_messages += line->parser->get_fragmented_count();
+        stats.checksum_errors += line->parser->get_checksum_errors();
+    }
+    if (is_arbitrating()) {
+        // Gaps that survived arbitration; per-line gaps are in ArbitrationStats
+        stats.sequence_gaps = arbitrated_gaps_.load(std::memory_order_relaxed);
+    }
     stats.bytes_received = bytes_received_;
-    stats.sequence_gaps = parser_->get_sequence_gaps();
-    stats.fragmented_messages = parser_->get_fragmented_count();
-    stats.checksum_errors = parser_->get_checksum_errors();
+    stats.heartbeats_received = heartbeats_received_.load(std::memory_order_relaxed);
+    stats.liveness_timeouts = liveness_timeouts_.load(std::memory_order_relaxed);
+    stats.reconnects = reconnects_.load(std::memory_order_relaxed);
+    stats.last_recovery_ns = last_recovery_ns_.load(std::memory_order_relaxed);
+    stats.max_recovery_ns = max_recovery_ns_.load(std::memory_order_relaxed);
+    return stats;
+}
+
+FeedHandler::ArbitrationStats FeedHandler::get_arbitration_stats() const {
+    ArbitrationStats stats{};
+    for (size_t i = 0; i < lines_.size(); ++i) {
+        stats.wins[i] = lines_[i]->wins.load(std::memory_order_relaxed);
+        stats.line_gaps[i] = lines_[i]->parser->get_sequence_gaps();
+        stats.advantage[i] = lines_[i]->advantage->get_stats();
+    }
+    stats.duplicates = duplicates_.load(std::memory_order_relaxed);
+    stats.gaps_deferred = gaps_deferred_.load(std::memory_order_relaxed);
+    stats.restarts = restarts_.load(std::memory_order_relaxed);
     return stats;
 }
 
@@ -0,0 +1,491 @@
+#include "client/load_generator.h"
+#include "common/protocol.h"
+#include "common/logger.h"
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <numeric>
+#include <random>
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/socket.h>
+#include <sys/epoll.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+#include <errno.h>
+
+namespace mdfh {
+
+namespace {
+
+constexpr int MAX_EVENTS = 256;
+constexpr int EPOLL_TIMEOUT_MS = 10;
+constexpr size_t RECV_BUFFER_SIZE = 65536;
+constexpr int MAX_RECVS_PER_EVENT = 4;  // Bound per-connection work so one busy socket cannot starve the rest
+constexpr size_t MAX_MESSAGE_SIZE = sizeof(QuoteMessage);
+
+enum class ConnectionState : uint8_t {
+    IDLE,
+    CONNECTING,
+    ACTIVE,
+    CLOSED
+};
+
+uint64_t steady_now_ns() {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+// Size of the message starting at msg (needs 2 bytes), 0 if the type is unknown
+size_t framed_size(const uint8_t* msg) {
+    uint16_t type;
+    std::memcpy(&type, msg, sizeof(type));
+    return get_message_size(static_cast<MessageType>(type));
+}
+
+// Single-writer counter: only the owning worker thread updates it
+inline void bump(std::atomic<uint64_t>& counter, uint64_t delta) {
+    if (delta != 0) {
+        counter.store(counter.load(std::memory_order_relaxed) + delta, std::memory_order_relaxed);
+    }
+}
+
+} // namespace
+
+struct LoadGenerator::Connection {
+    uint32_t id = 0;
+    int fd = -1;
+    ConnectionState state = ConnectionState::IDLE;  // Owned by the worker thread
+
+    // Sorted subscription and the last sequence number seen for each entry
+    std::vector<SymbolId> symbols;
+    std::vector<uint32_t> last_seq;
+
+    // Partial message carried over between recv calls
+    uint8_t carry[MAX_MESSAGE_SIZE];
+    size_t carry_len = 0;
+    bool resyncing = false;
+
+    std::atomic<bool> connected{false};
+    std::atomic<uint64_t> messages{0};
+    std::atomic<uint64_t> bytes{0};
+    std::atomic<uint64_t> sequence_gaps{0};
+    std::atomic<uint64_t> checksum_errors{0};
+    std::atomic<uint64_t> malformed{0};
+    std::atomic<uint64_t> connected_ns{0};
+    std::atomic<uint64_t> disconnected_ns{0};
+};
+
+struct LoadGenerator::Worker {
+    int epoll_fd = -1;
+    std::vector<Connection*> connections;
+    size_t next_to_connect = 0;
+    std::vector<uint8_t> recv_buffer;
+    std::thread thread;
+};
+
+struct LoadGenerator::BatchCounters {
+    uint64_t messages = 0;
+    uint64_t sequence_gaps = 0;
+    uint64_t checksum_errors = 0;
+    uint64_t malformed = 0;
+};
+
+LoadGenerator::LoadGenerator(const LoadGeneratorConfig& config)
+    : config_(config), server_addr_(0), running_(false) {
+
+    config_.num_threads = std::max<size_t>(1, std::min(config_.num_threads, config_.num_connections));
+    config_.num_symbols = std::min<size_t>(std::max<size_t>(1, config_.num_symbols), MAX_SYMBOLS);
+    config_.connect_batch = std::max<size_t>(1, config_.connect_batch);
+
+    size_t max_subs = std::min({config_.max_subscriptions, config_.num_symbols,
+                                MAX_SUBSCRIPTION_SYMBOLS});
+    size_t min_subs = std::min(std::max<size_t>(1, config_.min_subscriptions), max_subs);
+
+    // Random subscription sets (partial Fisher-Yates over all symbol ids)
+    std::mt19937_64 rng(config_.seed);
+    std::uniform_int_distribution<size_t> count_dist(min_subs, max_subs);
+    std::vector<SymbolId> ids(config_.num_symbols);
+    std::iota(ids.begin(), ids.end(), 0);
+
+    connections_.reserve(config_.num_connections);
+    for (size_t i = 0; i < config_.num_connections; ++i) {
+        auto conn = std::make_unique<Connection>();
+        conn->id = static_cast<uint32_t>(i);
+
+        size_t count = count_dist(rng);
+        for (size_t k = 0; k < count; ++k) {
+            std::uniform_int_distribution<size_t> pick(k, ids.size() - 1);
+            std::swap(ids[k], ids[pick(rng)]);
+        }
+        conn->symbols.assign(ids.begin(), ids.begin() + count);
+        std::sort(conn->symbols.begin(), conn->symbols.end());
+        conn->last_seq.assign(count, 0);
+
+        connections_.push_back(std::move(conn));
+    }
+}
+
+LoadGenerator::~LoadGenerator() {
+    stop();
+
+    for (auto& worker : workers_) {
+        if (worker->epoll_fd >= 0) {
+            close(worker->epoll_fd);
+        }
+    }
+}
+
+bool LoadGenerator::start() {
+    if (running_ || !workers_.empty()) {
+        return false;
+    }
+
+    in_addr addr{};
+    if (inet_pton(AF_INET, config_.host.c_str(), &addr) <= 0) {
+        MDFH_LOG_ERROR("Load generator: invalid host {}", config_.host);
+        return false;
+    }
+    server_addr_ = addr.s_addr;
+
+    for (size_t t = 0; t < config_.num_threads; ++t) {
+        auto worker = std::make_unique<Worker>();
+        worker->epoll_fd = epoll_create1(0);
+        if (worker->epoll_fd < 0) {
+            MDFH_LOG_ERROR("Load generator: epoll_create1 failed: {}", std::strerror(errno));
+            return false;
+        }
+        worker->recv_buffer.resize(RECV_BUFFER_SIZE);
+        workers_.push_back(std::move(worker));
+    }
+
+    // Round-robin so every thread ramps up at the same pace
+    for (size_t i = 0; i < connections_.size(); ++i) {
+        workers_[i % workers_.size()]->connections.push_back(connections_[i].get());
+    }
+
+    MDFH_LOG_INFO("Load generator: {} connections on {} threads to {}:{}",
+                  connections_.size(), workers_.size(), config_.host, config_.port);
+
+    running_ = true;
+    for (auto& worker : workers_) {
+        Worker* w = worker.get();
+        w->thread = std::thread([this, w]() { worker_loop(*w); });
+    }
+    return true;
+}
+
+void LoadGenerator::stop() {
+    running_ = false;
+    for (auto& worker : workers_) {
+        if (worker->thread.joinable()) {
+            worker->thread.join();
+        }
+    }
+}
+
+void LoadGenerator::worker_loop(Worker& worker) {
+    epoll_event events[MAX_EVENTS];
+
+    while (running_.load(std::memory_order_relaxed)) {
+        // Ramp up in batches so the server's listen backlog is not overrun
+        size_t initiated = 0;
+        while (worker.next_to_connect < worker.connections.size() &&
+               initiated < config_.connect_batch) {
+            initiate_connect(worker, *worker.connections[worker.next_to_connect++]);
+            ++initiated;
+        }
+
+        int nfds = epoll_wait(worker.epoll_fd, events, MAX_EVENTS, EPOLL_TIMEOUT_MS);
+        if (nfds < 0) {
+            if (errno == EINTR) continue;
+            MDFH_LOG_ERROR("Load generator: epoll_wait failed: {}", std::strerror(errno));
+            break;
+        }
+
+        for (int i = 0; i < nfds; ++i) {
+            Connection& conn = *static_cast<Connection*>(events[i].data.ptr);
+            uint32_t ev = events[i].events;
+
+            if (conn.state == ConnectionState::CONNECTING) {
+                if (ev & (EPOLLERR | EPOLLHUP)) {
+                    close_connection(worker, conn, true);
+                } else if (ev & EPOLLOUT) {
+                    on_connected(worker, conn);
+                }
+            } else if (conn.state == ConnectionState::ACTIVE) {
+                if (ev & EPOLLIN) {
+                    drain(worker, conn);
+                }
+                if (conn.state == ConnectionState::ACTIVE && (ev & (EPOLLERR | EPOLLHUP))) {
+                    close_connection(worker, conn, false);
+                }
+            }
+        }
+    }
+
+    // Shutdown: close without counting these as disconnects
+    for (Connection* conn : worker.connections) {
+        if (conn->fd >= 0) {
+            close(conn->fd);
+            conn->fd = -1;
+        }
+    }
+}
+
+bool LoadGenerator::initiate_connect(Worker& worker, Connection& conn) {
+    conn.fd = socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK, 0);
+    if (conn.fd < 0) {
+        MDFH_LOG_WARN_RL(10, "Load generator: socket() failed: {}", std::strerror(errno));
+        conn.state = ConnectionState::CLOSED;
+        connect_failures_.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(config_.port);
+    addr.sin_addr.s_addr = server_addr_;
+
+    if (::connect(conn.fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) < 0 &&
+        errno != EINPROGRESS) {
+        MDFH_LOG_WARN_RL(10, "Load generator: connect failed: {}", std::strerror(errno));
+        close_connection(worker, conn, true);
+        return false;
+    }
+
+    // Writable once the handshake completes (or fails)
+    epoll_event ev{};
+    ev.events = EPOLLOUT;
+    ev.data.ptr = &conn;
+    if (epoll_ctl(worker.epoll_fd, EPOLL_CTL_ADD, conn.fd, &ev) < 0) {
+        close_connection(worker, conn, true);
+        return false;
+    }
+
+    conn.state = ConnectionState::CONNECTING;
+    return true;
+}
+
+void LoadGenerator::on_connected(Worker& worker, Connection& conn) {
+    int error = 0;
+    socklen_t error_len = sizeof(error);
+    if (getsockopt(conn.fd, SOL_SOCKET, SO_ERROR, &error, &error_len) < 0 || error != 0) {
+        MDFH_LOG_WARN_RL(10, "Load generator: connect failed: {}", std::strerror(error));
+        close_connection(worker, conn, true);
+        return;
+    }
+
+    // 0xFF, count (u32 LE), symbol ids (u32 LE)
+    uint8_t msg[sizeof(SubscriptionHeader) + MAX_SUBSCRIPTION_SYMBOLS * sizeof(SymbolId)];
+    size_t len = 0;
+    uint32_t count = static_cast<uint32_t>(conn.symbols.size());
+    msg[len++] = 0xFF;
+    for (int shift = 0; shift < 32; shift += 8) {
+        msg[len++] = (count >> shift) & 0xFF;
+    }
+    for (SymbolId id : conn.symbols) {
+        for (int shift = 0; shift < 32; shift += 8) {
+            msg[len++] = (id >> shift) & 0xFF;
+        }
+    }
+
+    ssize_t sent = send(conn.fd, msg, len, MSG_NOSIGNAL);
+    if (sent != static_cast<ssize_t>(len)) {
+        close_connection(worker, conn, true);
+        return;
+    }
+
+    epoll_event ev{};
+    ev.events = EPOLLIN;
+    ev.data.ptr = &conn;
+    if (epoll_ctl(worker.epoll_fd, EPOLL_CTL_MOD, conn.fd, &ev) < 0) {
+        close_connection(worker, conn, true);
+        return;
+    }
+
+    conn.state = ConnectionState::ACTIVE;
+    conn.connected_ns.store(steady_now_ns(), std::memory_order_relaxed);
+    conn.connected.store(true, std::memory_order_release);
+}
+
+void LoadGenerator::drain(Worker& worker, Connection& conn) {
+    for (int i = 0; i < MAX_RECVS_PER_EVENT; ++i) {
+        ssize_t n = recv(conn.fd, worker.recv_buffer.data(), worker.recv_buffer.size(), 0);
+        if (n > 0) {
+            consume(conn, worker.recv_buffer.data(), static_cast<size_t>(n));
+            bump(conn.bytes, static_cast<uint64_t>(n));
+            if (static_cast<size_t>(n) < worker.recv_buffer.size()) {
+                return;  // Socket drained
+            }
+        } else if (n == 0) {
+            close_connection(worker, conn, false);
+            return;
+        } else {
+            if (errno == EINTR) continue;
+            if (errno != EAGAIN && errno != EWOULDBLOCK) {
+                close_connection(worker, conn, false);
+            }
+            return;
+        }
+    }
+}
+
+void LoadGenerator::close_connection(Worker& worker, Connection& conn, bool failed) {
+    if (conn.fd >= 0) {
+        epoll_ctl(worker.epoll_fd, EPOLL_CTL_DEL, conn.fd, nullptr);
+        close(conn.fd);
+        conn.fd = -1;
+    }
+
+    if (failed) {
+        connect_failures_.fetch_add(1, std::memory_order_relaxed);
+    } else if (conn.state == ConnectionState::ACTIVE) {
+        disconnects_.fetch_add(1, std::memory_order_relaxed);
+        conn.disconnected_ns.store(steady_now_ns(), std::memory_order_relaxed);
+        conn.connected.store(false, std::memory_order_release);
+    }
+    conn.state = ConnectionState::CLOSED;
+}
+
+void LoadGenerator::consume(Connection& conn, const uint8_t* data, size_t len) {
+    BatchCounters counters;
+    size_t pos = 0;
+
+    // Complete the message split across the previous recv
+    if (conn.carry_len > 0) {
+        while (conn.carry_len < 2 && pos < len) {
+            conn.carry[conn.carry_len++] = data[pos++];
+        }
+        if (conn.carry_len >= 2) {
+            size_t size = framed_size(conn.carry);
+            if (size == 0) {
+                counters.malformed++;
+                conn.resyncing = true;
+                conn.carry_len = 0;
+            } else {
+                size_t take = std::min(size - conn.carry_len, len - pos);
+                std::memcpy(conn.carry + conn.carry_len, data + pos, take);
+                conn.carry_len += take;
+                pos += take;
+                if (conn.carry_len == size) {
+                    on_message(conn, conn.carry, size, counters);
+                    conn.carry_len = 0;
+                }
+            }
+        }
+    }
+
+    if (conn.carry_len == 0) {
+        while (pos + 2 <= len) {
+            size_t size = framed_size(data + pos);
+            if (size == 0) {
+                // Lost framing (e.g. a partial send on the server): skip a byte at a time
+                if (!conn.resyncing) {
+                    counters.malformed++;
+                    conn.resyncing = true;
+                }
+                pos++;
+                continue;
+            }
+            if (pos + size > len) {
+                break;
+            }
+            conn.resyncing = false;
+            on_message(conn, data + pos, size, counters);
+            pos += size;
+        }
+
+        conn.carry_len = len - pos;
+        std::memcpy(conn.carry, data + pos, conn.carry_len);
+    }
+
+    bump(conn.messages, counters.messages);
+    bump(conn.sequence_gaps, counters.sequence_gaps);
+    bump(conn.checksum_errors, counters.checksum_errors);
+    bump(conn.malformed, counters.malformed);
+}
+
+void LoadGenerator::on_message(Connection& conn, const uint8_t* msg, size_t size,
+                               BatchCounters& counters) {
+    if (config_.validate && !validate_checksum(msg, size)) {
+        counters.checksum_errors++;
+        return;
+    }
+    counters.messages++;
+
+    MessageHeader header;
+    std::memcpy(&header, msg, sizeof(header));
+    if (header.msg_type == static_cast<uint16_t>(MessageType::HEARTBEAT)) {
+        return;
+    }
+
+    auto it = std::lower_bound(conn.symbols.begin(), conn.symbols.end(), header.symbol_id);
+    if (it == conn.symbols.end() || *it != header.symbol_id) {
+        counters.malformed++;  // Not subscribed: misframed or misrouted
+        return;
+    }
+
+    uint32_t& last_seq = conn.last_seq[it - conn.symbols.begin()];
+    if (last_seq != 0 && header.seq_num != last_seq + 1) {
+        counters.sequence_gaps++;
+    }
+    last_seq = header.seq_num;
+}
+
+LoadGeneratorStats LoadGenerator::get_stats() const {
+    LoadGeneratorStats stats{};
+    for (const auto& conn : connections_) {
+        if (conn->connected.load(std::memory_order_acquire)) {
+            stats.connections_open++;
+        }
+        stats.messages += conn->messages.load(std::memory_order_relaxed);
+        stats.bytes += conn->bytes.load(std::memory_order_relaxed);
+        stats.sequence_gaps += conn->sequence_gaps.load(std::memory_order_relaxed);
+        stats.checksum_errors += conn->checksum_errors.load(std::memory_order_relaxed);
+        stats.malformed += conn->malformed.load(std::memory_order_relaxed);
+    }
+    stats.connect_failures = connect_failures_.load(std::memory_order_relaxed);
+    stats.disconnects = disconnects_.load(std::memory_order_relaxed);
+    return stats;
+}
+
+std::vector<ConnectionStats> LoadGenerator::get_connection_stats() const {
+    std::vector<ConnectionStats> result;
+    result.reserve(connections_.size());
+    for (const auto& conn : connections_) {
+        ConnectionStats s{};
+        s.id = conn->id;
+        s.connected = conn->connected.load(std::memory_order_acquire);
+        s.subscriptions = static_cast<uint16_t>(conn->symbols.size());
+        s.messages = conn->messages.load(std::memory_order_relaxed);
+        s.bytes = conn->bytes.load(std::memory_order_relaxed);
+        s.sequence_gaps = conn->sequence_gaps.load(std::memory_order_relaxed);
+        s.checksum_errors = conn->checksum_errors.load(std::memory_order_relaxed);
+        s.malformed = conn->malformed.load(std::memory_order_relaxed);
+        s.connected_ns = conn->connected_ns.load(std::memory_order_relaxed);
+        s.disconnected_ns = conn->disconnected_ns.load(std::memory_order_relaxed);
+        result.push_back(s);
+    }
+    return result;
+}
+
+bool LoadGenerator::export_to_csv(const std::string& path) const {
+    std::ofstream file(path);
+    if (!file.is_open()) {
+        return false;
+    }
+
+    uint64_t now = steady_now_ns();
+    file << "id,connected,subscriptions,messages,bytes,msg_per_sec,sequence_gaps,"
+            "checksum_errors,malformed\n";
+    for (const auto& s : get_connection_stats()) {
+        file << s.id << ',' << (s.connected ? 1 : 0) << ',' << s.subscriptions << ','
+             << s.messages << ',' << s.bytes << ',' << static_cast<uint64_t>(s.message_rate(now)) << ','
+             << s.sequence_gaps << ',' << s.checksum_errors << ',' << s.malformed << '\n';
+    }
+    return file.good();
+}
+
+} // namespace mdfh
@@ -0,0 +1,209 @@
+#include "client/load_generator.h"
+#include "common/logger.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <thread>
+#include <sys/resource.h>
+
+// Many-connection load generator for the exchange server.
+//
+// Usage:
+//   ./build/load_generator [--host=127.0.0.1] [--port=9876] [--connections=1000]
+//       [--threads=4] [--symbols=100] [--min-subs=1] [--max-subs=10]
+//       [--duration=SEC] [--connect-batch=128] [--seed=1] [--validate] [--csv=FILE]
+
+std::atomic<bool> g_running(true);
+
+void signal_handler(int signal) {
+    if (signal == SIGINT || signal == SIGTERM) {
+        g_running = false;
+    }
+}
+
+namespace {
+
+struct Options {
+    mdfh::LoadGeneratorConfig config;
+    uint32_t duration_sec = 0;  // 0 = until interrupted
+    std::string csv_file;
+};
+
+bool parse_options(int argc, char* argv[], Options& opts) {
+    for (int i = 1; i < argc; ++i) {
+        const char* arg = argv[i];
+        if (std::strncmp(arg, "--host=", 7) == 0) {
+            opts.config.host = arg + 7;
+        } else if (std::strncmp(arg, "--port=", 7) == 0) {
+            opts.config.port = static_cast<uint16_t>(std::atoi(arg + 7));
+        } else if (std::strncmp(arg, "--connections=", 14) == 0) {
+            opts.config.num_connections = std::strtoull(arg + 14, nullptr, 10);
+        } else if (std::strncmp(arg, "--threads=", 10) == 0) {
+            opts.config.num_threads = std::strtoull(arg + 10, nullptr, 10);
+        } else if (std::strncmp(arg, "--symbols=", 10) == 0) {
+            opts.config.num_symbols = std::strtoull(arg + 10, nullptr, 10);
+        } else if (std::strncmp(arg, "--min-subs=", 11) == 0) {
+            opts.config.min_subscriptions = std::strtoull(arg + 11, nullptr, 10);
+        } else if (std::strncmp(arg, "--max-subs=", 11) == 0) {
+            opts.config.max_subscriptions = std::strtoull(arg + 11, nullptr, 10);
+        } else if (std::strncmp(arg, "--duration=", 11) == 0) {
+            opts.duration_sec = static_cast<uint32_t>(std::atoi(arg + 11));
+        } else if (std::strncmp(arg, "--connect-batch=", 16) == 0) {
+            opts.config.connect_batch = std::strtoull(arg + 16, nullptr, 10);
+        } else if (std::strncmp(arg, "--seed=", 7) == 0) {
+            opts.config.seed = std::strtoull(arg + 7, nullptr, 10);
+        } else if (std::strcmp(arg, "--validate") == 0) {
+            opts.config.validate = true;
+        } else if (std::strncmp(arg, "--csv=", 6) == 0) {
+            opts.csv_file = arg + 6;
+        } else {
+            std::fprintf(stderr, "Usage: %s [--host=IP] [--port=N] [--connections=N] [--threads=N] "
+                         "[--symbols=N] [--min-subs=N] [--max-subs=N] [--duration=SEC] "
+                         "[--connect-batch=N] [--seed=N] [--validate] [--csv=FILE]\n", argv[0]);
+            return false;
+        }
+    }
+    return true;
+}
+
+// Each connection needs a descriptor; raise the soft limit as far as allowed
+void raise_fd_limit(size_t connections) {
+    rlimit limit{};
+    if (getrlimit(RLIMIT_NOFILE, &limit) != 0) {
+        return;
+    }
+    rlim_t wanted = static_cast<rlim_t>(connections + 64);
+    if (limit.rlim_cur < wanted) {
+        limit.rlim_cur = std::min(wanted, limit.rlim_max);
+        setrlimit(RLIMIT_NOFILE, &limit);
+    }
+    if (limit.rlim_cur < wanted) {
+        std::cerr << "Warning: RLIMIT_NOFILE is " << limit.rlim_cur << ", some of the "
+                  << connections << " connections will fail" << std::endl;
+    }
+}
+
+uint64_t steady_now_ns() {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+double percentile(const std::vector<double>& sorted, double p) {
+    if (sorted.empty()) return 0.0;
+    size_t index = static_cast<size_t>(p * (sorted.size() - 1));
+    return sorted[index];
+}
+
+void print_report(const mdfh::LoadGenerator& generator) {
+    auto stats = generator.get_stats();
+    auto connections = generator.get_connection_stats();
+    uint64_t now = steady_now_ns();
+
+    std::vector<double> rates;
+    size_t with_gaps = 0;
+    size_t never_connected = 0;
+    for (const auto& c : connections) {
+        if (c.connected_ns == 0) {
+            never_connected++;
+            continue;
+        }
+        rates.push_back(c.message_rate(now));
+        if (c.sequence_gaps > 0) {
+            with_gaps++;
+        }
+    }
+    std::sort(rates.begin(), rates.end());
+
+    std::cout << "\nFinal Statistics:" << std::endl;
+    std::cout << "Connections: " << connections.size() << " requested, "
+              << stats.connections_open << " open, " << never_connected << " never connected, "
+              << stats.connect_failures << " connect failures, "
+              << stats.disconnects << " disconnects" << std::endl;
+    std::cout << "Total messages received: " << stats.messages << std::endl;
+    std::cout << "Total bytes received: " << stats.bytes << std::endl;
+    std::cout << "Sequence gaps: " << stats.sequence_gaps << " (" << with_gaps
+              << " connections affected)" << std::endl;
+    std::cout << "Checksum errors: " << stats.checksum_errors
+              << ", malformed: " << stats.malformed << std::endl;
+    std::printf("Per-connection msg/s - min: %.0f, p50: %.0f, p99: %.0f, max: %.0f\n",
+                percentile(rates, 0.0), percentile(rates, 0.5),
+                percentile(rates, 0.99), percentile(rates, 1.0));
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    Options opts;
+    if (!parse_options(argc, argv, opts)) {
+        return 1;
+    }
+
+    std::signal(SIGINT, signal_handler);
+    std::signal(SIGTERM, signal_handler);
+
+    raise_fd_limit(opts.config.num_connections);
+
+    std::cout << "Starting Load Generator..." << std::endl;
+    std::cout << "Connecting to: " << opts.config.host << ":" << opts.config.port << std::endl;
+    std::cout << "Connections: " << opts.config.num_connections
+              << " on " << opts.config.num_threads << " threads" << std::endl;
+    std::cout << "Subscriptions: " << opts.config.min_subscriptions << "-"
+              << opts.config.max_subscriptions << " of " << opts.config.num_symbols
+              << " symbols per connection" << std::endl;
+    std::cout << std::endl;
+
+    mdfh::LoadGenerator generator(opts.config);
+    if (!generator.start()) {
+        std::cerr << "Failed to start load generator" << std::endl;
+        return 1;
+    }
+
+    auto start_time = std::chrono::steady_clock::now();
+    auto last_stats = generator.get_stats();
+    auto last_time = start_time;
+
+    while (g_running) {
+        std::this_thread::sleep_for(std::chrono::seconds(1));
+
+        auto now = std::chrono::steady_clock::now();
+        auto stats = generator.get_stats();
+        double elapsed = std::chrono::duration<double>(now - last_time).count();
+
+        if (elapsed > 0) {
+            std::printf("open: %6lu  failed: %5lu  msg/s: %10.0f  MB/s: %7.1f  gaps: %lu\n",
+                        static_cast<unsigned long>(stats.connections_open),
+                        static_cast<unsigned long>(stats.connect_failures),
+                        (stats.messages - last_stats.messages) / elapsed,
+                        (stats.bytes - last_stats.bytes) / elapsed / (1024.0 * 1024.0),
+                        static_cast<unsigned long>(stats.sequence_gaps));
+            std::fflush(stdout);
+        }
+
+        last_stats = stats;
+        last_time = now;
+
+        if (opts.duration_sec > 0 &&
+            now - start_time >= std::chrono::seconds(opts.duration_sec)) {
+            break;
+        }
+    }
+
+    std::cout << "\nShutting down..." << std::endl;
+    print_report(generator);
+    if (!opts.csv_file.empty()) {
+        if (generator.export_to_csv(opts.csv_file)) {
+            std::cout << "Per-connection details written to " << opts.csv_file << std::endl;
+        } else {
+            std::cerr << "Failed to write " << opts.csv_file << std::endl;
+        }
+    }
+
+    generator.stop();
+    mdfh::Logger::instance().flush();
+    return 0;
+}
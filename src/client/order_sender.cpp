@@ -0,0 +1,134 @@
+#include "client/order_sender.h"
+#include "common/logger.h"
+#include "common/tsc_clock.h"
+#include <cstring>
+#include <poll.h>
+#include <sys/socket.h>
+
+namespace mdfh {
+
+namespace {
+
+constexpr size_t RX_BUFFER_SIZE = 64 * 1024;
+
+} // namespace
+
+OrderSender::OrderSender()
+    : rx_buffer_(RX_BUFFER_SIZE) {
+}
+
+OrderSender::~OrderSender() {
+    disconnect();
+}
+
+bool OrderSender::connect(const std::string& host, uint16_t port, uint32_t timeout_ms) {
+    if (!socket_.connect(host, port, timeout_ms)) {
+        MDFH_LOG_ERROR("Failed to connect order session to {}:{}", host, port);
+        return false;
+    }
+    socket_.set_tcp_nodelay(true);
+    rx_len_ = 0;
+    MDFH_LOG_INFO("Order session connected to {}:{}", host, port);
+    return true;
+}
+
+void OrderSender::disconnect() {
+    socket_.disconnect();
+}
+
+bool OrderSender::send_message(const void* msg, size_t len) {
+    if (!socket_.is_connected()) {
+        return false;
+    }
+    ssize_t sent = send(socket_.get_fd(), msg, len, MSG_NOSIGNAL);
+    return sent == static_cast<ssize_t>(len);
+}
+
+uint64_t OrderSender::send_new_order(SymbolId symbol_id, OrderSide side, OrderType type,
+                                     double price, uint32_t quantity, uint64_t trigger_timestamp) {
+    NewOrderMessage msg{};
+    msg.header.msg_type = static_cast<uint16_t>(MessageType::NEW_ORDER);
+    msg.header.seq_num = ++send_seq_;
+    msg.header.timestamp = TscClock::now_wall_ns();
+    msg.header.symbol_id = symbol_id;
+    msg.payload.client_order_id = ++next_client_order_id_;
+    msg.payload.trigger_timestamp = trigger_timestamp;
+    msg.payload.price = price;
+    msg.payload.quantity = quantity;
+    msg.payload.side = static_cast<uint8_t>(side);
+    msg.payload.order_type = static_cast<uint8_t>(type);
+    msg.checksum = calculate_checksum(&msg, sizeof(msg) - 4);
+
+    if (!send_message(&msg, sizeof(msg))) {
+        return 0;
+    }
+    orders_sent_.fetch_add(1, std::memory_order_relaxed);
+    return msg.payload.client_order_id;
+}
+
+bool OrderSender::send_cancel(SymbolId symbol_id, uint64_t client_order_id) {
+    CancelOrderMessage msg{};
+    msg.header.msg_type = static_cast<uint16_t>(MessageType::CANCEL_ORDER);
+    msg.header.seq_num = ++send_seq_;
+    msg.header.timestamp = TscClock::now_wall_ns();
+    msg.header.symbol_id = symbol_id;
+    msg.payload.client_order_id = client_order_id;
+    msg.checksum = calculate_checksum(&msg, sizeof(msg) - 4);
+
+    if (!send_message(&msg, sizeof(msg))) {
+        return false;
+    }
+    cancels_sent_.fetch_add(1, std::memory_order_relaxed);
+    return true;
+}
+
+int OrderSender::poll_acks(const std::function<void(const OrderAckMessage&)>& handler, int timeout_ms) {
+    if (!socket_.is_connected()) {
+        return -1;
+    }
+
+    if (timeout_ms > 0) {
+        struct pollfd pfd{socket_.get_fd(), POLLIN, 0};
+        if (poll(&pfd, 1, timeout_ms) <= 0) {
+            return 0;
+        }
+    }
+
+    ssize_t n = socket_.receive(rx_buffer_.data() + rx_len_, rx_buffer_.size() - rx_len_);
+    if (n <= 0) {
+        return socket_.is_connected() ? 0 : -1;
+    }
+    rx_len_ += static_cast<size_t>(n);
+
+    // Acks are fixed size; a trailing partial one waits for the next read
+    int delivered = 0;
+    size_t pos = 0;
+    while (rx_len_ - pos >= sizeof(OrderAckMessage)) {
+        const uint8_t* data = rx_buffer_.data() + pos;
+        uint16_t type;
+        std::memcpy(&type, data, sizeof(type));
+        if (type != static_cast<uint16_t>(MessageType::ORDER_ACK)) {
+            MDFH_LOG_ERROR("Order session: unexpected message type {}, disconnecting", type);
+            socket_.disconnect();
+            return -1;
+        }
+        if (validate_checksum(data, sizeof(OrderAckMessage))) {
+            OrderAckMessage ack;
+            std::memcpy(&ack, data, sizeof(ack));
+            acks_received_.fetch_add(1, std::memory_order_relaxed);
+            handler(ack);
+            delivered++;
+        } else {
+            checksum_errors_.fetch_add(1, std::memory_order_relaxed);
+        }
+        pos += sizeof(OrderAckMessage);
+    }
+
+    if (pos > 0) {
+        std::memmove(rx_buffer_.data(), rx_buffer_.data() + pos, rx_len_ - pos);
+        rx_len_ -= pos;
+    }
+    return delivered;
+}
+
+} // namespace mdfh
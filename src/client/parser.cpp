@@ -1,4 +1,5 @@
 #include "client/parser.h"
+#include "common/trace.h"
 #include <cstring>
 #include <iostream>
 
@@ -11,8 +12,7 @@ BinaryParser::BinaryParser()
       sequence_gaps_(0),
       checksum_errors_(0),
       malformed_messages_(0),
-      fragmented_messages_(0),
-      last_seq_num_(0) {
+      fragmented_messages_(0) {
 }
 
 BinaryParser::~BinaryParser() {
@@ -62,8 +62,8 @@ bool BinaryParser::try_parse_message() {
     MessageType msg_type = static_cast<MessageType>(header.msg_type);
     size_t msg_size = get_message_size(msg_type);
     
-    if (msg_size == 0 || msg_size > MAX_MESSAGE_SIZE) {
-        // Unknown or invalid message type
+    if (msg_size == 0 || msg_size > MAX_MESSAGE_SIZE || header.version != PROTOCOL_VERSION) {
+        // Unknown or invalid message type, or another protocol version
         malformed_messages_++;
         // Skip this byte and try again
         std::memmove(buffer_.data(), &buffer_[1], buffer_pos_ - 1);
@@ -102,11 +102,22 @@ bool BinaryParser::process_message(const void* msg_data, size_t msg_size,
     // Zero-copy: use reinterpret_cast instead of memcpy for header access
     const MessageHeader* header = reinterpret_cast<const MessageHeader*>(msg_data);
     
-    // Check sequence number
-    if (last_seq_num_ != 0 && header->seq_num != last_seq_num_ + 1) {
-        sequence_gaps_++;
+    // Check sequence number against this symbol's last one. Heartbeats
+    // carry a per-connection counter, not a symbol sequence.
+    // Without a map, ids past MAX_UNMAPPED_ID are not tracked rather
+    // than growing the array to match.
+    uint32_t index = sequence_index(header->symbol_id);
+    bool tracked = symbol_map_ ? index != SymbolMap::NO_SLOT : index <= MAX_UNMAPPED_ID;
+    if (type != MessageType::HEARTBEAT && tracked) {
+        if (index >= last_seq_by_symbol_.size()) {
+            last_seq_by_symbol_.resize(static_cast<size_t>(index) + 1, 0);
+        }
+        uint32_t& last_seq = last_seq_by_symbol_[index];
+        if (last_seq != 0 && header->seq_num != last_seq + 1) {
+            sequence_gaps_++;
+        }
+        last_seq = header->seq_num;
     }
-    last_seq_num_ = header->seq_num;
     
     // Use generic handler (required)
     if (!generic_handler_) {
@@ -114,6 +125,7 @@ bool BinaryParser::process_message(const void* msg_data, size_t msg_size,
         return false;
     }
     
+    MDFH_TRACE_ZONE(DISPATCH);
     generic_handler_(msg_data, type);
     return true;
 }
@@ -124,7 +136,7 @@ void BinaryParser::reset() {
     sequence_gaps_ = 0;
     checksum_errors_ = 0;
     malformed_messages_ = 0;
-    last_seq_num_ = 0;
+    last_seq_by_symbol_.clear();
 }
 
 } // namespace mdfh
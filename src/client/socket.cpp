@@ -8,6 +8,7 @@
 #include <sys/epoll.h>
 #include <netinet/in.h>
 #include <netinet/tcp.h>
+#include <poll.h>
 #include <arpa/inet.h>
 #include <errno.h>
 
@@ -32,17 +33,35 @@ MarketDataSocket::~MarketDataSocket() {
 
 bool MarketDataSocket::connect(const std::string& host, uint16_t port,
                                 uint32_t timeout_ms) {
+    ConnectStatus status = start_connect(host, port);
+    if (status == ConnectStatus::FAILED) {
+        return false;
+    }
+    
+    // Wait for connection with timeout
+    if (status == ConnectStatus::IN_PROGRESS &&
+        (!wait_for_connection(sockfd_, timeout_ms) || !finish_connect())) {
+        abort_connect();
+        return false;
+    }
+    return true;
+}
+
+MarketDataSocket::ConnectStatus MarketDataSocket::start_connect(const std::string& host,
+                                                                uint16_t port) {
+    disconnect();
+    
     // Create socket
     sockfd_ = socket(AF_INET, SOCK_STREAM, 0);
     if (sockfd_ < 0) {
-        return false;
+        return ConnectStatus::FAILED;
     }
     
     // Set non-blocking
     if (!set_nonblocking(sockfd_)) {
         close(sockfd_);
         sockfd_ = -1;
-        return false;
+        return ConnectStatus::FAILED;
     }
     
     // Connect
@@ -53,7 +72,7 @@ bool MarketDataSocket::connect(const std::string& host, uint16_t port,
     if (inet_pton(AF_INET, host.c_str(), &addr.sin_addr) <= 0) {
         close(sockfd_);
         sockfd_ = -1;
-        return false;
+        return ConnectStatus::FAILED;
     }
     
     int ret = ::connect(sockfd_, (struct sockaddr*)&addr, sizeof(addr));
@@ -61,7 +80,7 @@ bool MarketDataSocket::connect(const std::string& host, uint16_t port,
     if (ret < 0 && errno != EINPROGRESS) {
         close(sockfd_);
         sockfd_ = -1;
-        return false;
+        return ConnectStatus::FAILED;
     }
     
     // Add to epoll with EPOLLOUT to wait for connection completion
@@ -72,25 +91,52 @@ bool MarketDataSocket::connect(const std::string& host, uint16_t port,
     if (epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, sockfd_, &ev) < 0) {
         close(sockfd_);
         sockfd_ = -1;
-        return false;
+        return ConnectStatus::FAILED;
     }
     
-    // Wait for connection with timeout
-    if (!wait_for_connection(sockfd_, timeout_ms)) {
-        epoll_ctl(epoll_fd_, EPOLL_CTL_DEL, sockfd_, nullptr);
-        close(sockfd_);
-        sockfd_ = -1;
-        return false;
+    if (ret == 0) {
+        // Loopback connects can complete immediately
+        if (!finish_connect()) {
+            abort_connect();
+            return ConnectStatus::FAILED;
+        }
+        return ConnectStatus::CONNECTED;
+    }
+    return ConnectStatus::IN_PROGRESS;
+}
+
+MarketDataSocket::ConnectStatus MarketDataSocket::poll_connect() {
+    if (connected_) {
+        return ConnectStatus::CONNECTED;
+    }
+    if (sockfd_ < 0) {
+        return ConnectStatus::FAILED;
+    }
+    
+    struct epoll_event events[1];
+    int nfds = epoll_wait(epoll_fd_, events, 1, 0);
+    if (nfds == 0 || (nfds < 0 && errno == EINTR)) {
+        return ConnectStatus::IN_PROGRESS;
     }
     
+    // Writable (or errored): SO_ERROR holds the connect result
+    int error = 0;
+    socklen_t len = sizeof(error);
+    if (nfds < 0 || getsockopt(sockfd_, SOL_SOCKET, SO_ERROR, &error, &len) < 0 ||
+        error != 0 || !finish_connect()) {
+        abort_connect();
+        return ConnectStatus::FAILED;
+    }
+    return ConnectStatus::CONNECTED;
+}
+
+bool MarketDataSocket::finish_connect() {
     // Modify epoll to EPOLLIN for receiving data
+    struct epoll_event ev{};
     ev.events = EPOLLIN | EPOLLET; // Edge-triggered
     ev.data.fd = sockfd_;
     
     if (epoll_ctl(epoll_fd_, EPOLL_CTL_MOD, sockfd_, &ev) < 0) {
-        epoll_ctl(epoll_fd_, EPOLL_CTL_DEL, sockfd_, nullptr);
-        close(sockfd_);
-        sockfd_ = -1;
         return false;
     }
     
@@ -102,6 +148,12 @@ bool MarketDataSocket::connect(const std::string& host, uint16_t port,
     return true;
 }
 
+void MarketDataSocket::abort_connect() {
+    epoll_ctl(epoll_fd_, EPOLL_CTL_DEL, sockfd_, nullptr);
+    close(sockfd_);
+    sockfd_ = -1;
+}
+
 ssize_t MarketDataSocket::receive(void* buffer, size_t max_len) {
     if (!connected_ || sockfd_ < 0) {
         return -1;
@@ -129,26 +181,90 @@ ssize_t MarketDataSocket::receive(void* buffer, size_t max_len) {
     return n;
 }
 
-bool MarketDataSocket::send_subscription(const std::vector<uint16_t>& symbol_ids) {
+bool MarketDataSocket::send_subscription(const std::vector<SymbolId>& symbol_ids) {
     if (!connected_ || sockfd_ < 0) {
         return false;
     }
     
+    if (symbol_ids.size() > MAX_SUBSCRIPTION_COUNT) {
+        return false;
+    }
+    
     // Build subscription message
     std::vector<uint8_t> msg;
+    msg.reserve(sizeof(SubscriptionHeader) + symbol_ids.size() * sizeof(SymbolId));
     msg.push_back(0xFF); // Subscribe command
     
-    uint16_t count = static_cast<uint16_t>(symbol_ids.size());
-    msg.push_back(count & 0xFF);
-    msg.push_back((count >> 8) & 0xFF);
+    uint32_t count = static_cast<uint32_t>(symbol_ids.size());
+    for (int shift = 0; shift < 32; shift += 8) {
+        msg.push_back((count >> shift) & 0xFF);
+    }
+    
+    for (SymbolId id : symbol_ids) {
+        for (int shift = 0; shift < 32; shift += 8) {
+            msg.push_back((id >> shift) & 0xFF);
+        }
+    }
     
-    for (uint16_t id : symbol_ids) {
-        msg.push_back(id & 0xFF);
-        msg.push_back((id >> 8) & 0xFF);
+    return send_request(msg);
+}
+
+bool MarketDataSocket::send_resume(const std::vector<SymbolId>& symbol_ids,
+                                   const std::vector<uint32_t>& last_seqs) {
+    if (!connected_ || sockfd_ < 0 || symbol_ids.size() != last_seqs.size() ||
+        symbol_ids.size() > MAX_SUBSCRIPTION_COUNT) {
+        return false;
     }
     
-    ssize_t sent = send(sockfd_, msg.data(), msg.size(), MSG_NOSIGNAL);
-    return sent == static_cast<ssize_t>(msg.size());
+    // Build resume message: subscription header, then (symbol_id, last_seq) pairs
+    std::vector<uint8_t> msg;
+    msg.reserve(sizeof(SubscriptionHeader) + symbol_ids.size() * sizeof(ResumeEntry));
+    msg.push_back(0xFE); // Resume command
+    
+    uint32_t count = static_cast<uint32_t>(symbol_ids.size());
+    for (int shift = 0; shift < 32; shift += 8) {
+        msg.push_back((count >> shift) & 0xFF);
+    }
+    
+    for (size_t i = 0; i < symbol_ids.size(); ++i) {
+        SymbolId id = symbol_ids[i];
+        uint32_t seq = last_seqs[i];
+        for (int shift = 0; shift < 32; shift += 8) {
+            msg.push_back((id >> shift) & 0xFF);
+        }
+        for (int shift = 0; shift < 32; shift += 8) {
+            msg.push_back((seq >> shift) & 0xFF);
+        }
+    }
+    
+    return send_request(msg);
+}
+
+bool MarketDataSocket::send_request(const std::vector<uint8_t>& msg) {
+    // The socket is non-blocking and a large request outgrows the send
+    // buffer: wait for room rather than leave a partial request on the wire
+    size_t offset = 0;
+    while (offset < msg.size()) {
+        ssize_t sent = send(sockfd_, msg.data() + offset, msg.size() - offset, MSG_NOSIGNAL);
+        if (sent > 0) {
+            offset += static_cast<size_t>(sent);
+            continue;
+        }
+        if (sent < 0 && errno == EINTR) {
+            continue;
+        }
+        struct pollfd pfd{sockfd_, POLLOUT, 0};
+        if (sent < 0 && (errno == EAGAIN || errno == EWOULDBLOCK) &&
+            poll(&pfd, 1, SEND_TIMEOUT_MS) > 0) {
+            continue;
+        }
+        // A request cut short would misframe everything after it
+        if (offset > 0) {
+            connected_ = false;
+        }
+        return false;
+    }
+    return true;
 }
 
 bool MarketDataSocket::is_connected() const {
@@ -133,6 +133,9 @@ void Visualizer::draw_symbol_table(const std::vector<SymbolDisplay>& symbols) {
         std::cout << std::setw(15) << format_volume(sym.volume);
         std::cout << std::setw(10) << format_change(sym.change_pct);
         std::cout << std::setw(12) << sym.update_count;
+        if (sym.stale) {
+            std::cout << " " << COLOR_YELLOW << "STALE" << COLOR_RESET;
+        }
         std::cout << "\n";
     }
     
@@ -171,6 +174,7 @@ std::vector<SymbolDisplay> Visualizer::get_top_symbols() {
         disp.volume = snapshot.last_traded_quantity;
         disp.change_pct = 0.0; // TODO: Calculate from historical data
         disp.update_count = snapshot.update_count;
+        disp.stale = snapshot.stale;
         
         symbols.push_back(disp);
     }
@@ -1,6 +1,6 @@
 #include "common/cache.h"
+#include "common/tsc_clock.h"
 #include <stdexcept>
-#include <chrono>
 
 namespace mdfh {
 
@@ -11,10 +11,10 @@ SymbolCache::SymbolCache(size_t num_symbols)
 SymbolCache::~SymbolCache() {
 }
 
-void SymbolCache::update_bid(uint16_t symbol_id, double price, uint32_t quantity) {
-    if (!is_valid_symbol(symbol_id)) return;
+void SymbolCache::update_bid(uint32_t slot, double price, uint32_t quantity) {
+    if (!is_valid_symbol(slot)) return;
     
-    auto& state = states_[symbol_id];
+    auto& state = states_[slot];
     
     // Seqlock write protocol: increment to odd (write in progress)
     uint64_t seq = state.sequence.load(std::memory_order_relaxed);
@@ -22,50 +22,53 @@ void SymbolCache::update_bid(uint16_t symbol_id, double price, uint32_t quantity
     
     state.best_bid = price;
     state.bid_quantity = quantity;
-    state.last_update_time = std::chrono::steady_clock::now().time_since_epoch().count();
+    state.last_update_time = TscClock::now_ticks();
     state.update_count++;
+    state.stale = false;
     
     // Increment to even (write complete) - release ensures visibility
     state.sequence.store(seq + 2, std::memory_order_release);
 }
 
-void SymbolCache::update_ask(uint16_t symbol_id, double price, uint32_t quantity) {
-    if (!is_valid_symbol(symbol_id)) return;
+void SymbolCache::update_ask(uint32_t slot, double price, uint32_t quantity) {
+    if (!is_valid_symbol(slot)) return;
     
-    auto& state = states_[symbol_id];
+    auto& state = states_[slot];
     
     uint64_t seq = state.sequence.load(std::memory_order_relaxed);
     state.sequence.store(seq + 1, std::memory_order_release);
     
     state.best_ask = price;
     state.ask_quantity = quantity;
-    state.last_update_time = std::chrono::steady_clock::now().time_since_epoch().count();
+    state.last_update_time = TscClock::now_ticks();
     state.update_count++;
+    state.stale = false;
     
     state.sequence.store(seq + 2, std::memory_order_release);
 }
 
-void SymbolCache::update_trade(uint16_t symbol_id, double price, uint32_t quantity) {
-    if (!is_valid_symbol(symbol_id)) return;
+void SymbolCache::update_trade(uint32_t slot, double price, uint32_t quantity) {
+    if (!is_valid_symbol(slot)) return;
     
-    auto& state = states_[symbol_id];
+    auto& state = states_[slot];
     
     uint64_t seq = state.sequence.load(std::memory_order_relaxed);
     state.sequence.store(seq + 1, std::memory_order_release);
     
     state.last_traded_price = price;
     state.last_traded_quantity = quantity;
-    state.last_update_time = std::chrono::steady_clock::now().time_since_epoch().count();
+    state.last_update_time = TscClock::now_ticks();
     state.update_count++;
+    state.stale = false;
     
     state.sequence.store(seq + 2, std::memory_order_release);
 }
 
-void SymbolCache::update_quote(uint16_t symbol_id, double bid_price, uint32_t bid_qty,
+void SymbolCache::update_quote(uint32_t slot, double bid_price, uint32_t bid_qty,
                                 double ask_price, uint32_t ask_qty) {
-    if (!is_valid_symbol(symbol_id)) return;
+    if (!is_valid_symbol(slot)) return;
     
-    auto& state = states_[symbol_id];
+    auto& state = states_[slot];
     
     uint64_t seq = state.sequence.load(std::memory_order_relaxed);
     state.sequence.store(seq + 1, std::memory_order_release);
@@ -74,18 +77,37 @@ void SymbolCache::update_quote(uint16_t symbol_id, double bid_price, uint32_t bi
     state.bid_quantity = bid_qty;
     state.best_ask = ask_price;
     state.ask_quantity = ask_qty;
-    state.last_update_time = std::chrono::steady_clock::now().time_since_epoch().count();
+    state.last_update_time = TscClock::now_ticks();
     state.update_count++;
+    state.stale = false;
     
     state.sequence.store(seq + 2, std::memory_order_release);
 }
 
-MarketSnapshot SymbolCache::get_snapshot(uint16_t symbol_id) const {
+void SymbolCache::mark_stale(uint32_t slot) {
+    if (!is_valid_symbol(slot)) return;
+    
+    auto& state = states_[slot];
+    if (state.stale) return;
+    
+    uint64_t seq = state.sequence.load(std::memory_order_relaxed);
+    state.sequence.store(seq + 1, std::memory_order_release);
+    state.stale = true;
+    state.sequence.store(seq + 2, std::memory_order_release);
+}
+
+void SymbolCache::mark_all_stale() {
+    for (size_t i = 0; i < num_symbols_; ++i) {
+        mark_stale(static_cast<uint32_t>(i));
+    }
+}
+
+MarketSnapshot SymbolCache::get_snapshot(uint32_t slot) const {
     MarketSnapshot snapshot{};
     
-    if (!is_valid_symbol(symbol_id)) return snapshot;
+    if (!is_valid_symbol(slot)) return snapshot;
     
-    const auto& state = states_[symbol_id];
+    const auto& state = states_[slot];
     
     // Seqlock read protocol: retry if sequence is odd or changed
     uint64_t seq1, seq2;
@@ -106,18 +128,22 @@ MarketSnapshot SymbolCache::get_snapshot(uint16_t symbol_id) const {
         snapshot.last_traded_quantity = state.last_traded_quantity;
         snapshot.last_update_time = state.last_update_time;
         snapshot.update_count = state.update_count;
+        snapshot.stale = state.stale;
         
         // Check if sequence changed during read
         seq2 = state.sequence.load(std::memory_order_acquire);
     } while (seq1 != seq2);
     
+    // Stored as raw ticks by the writer; convert outside the hot path
+    snapshot.last_update_time = TscClock::to_ns(snapshot.last_update_time);
+    
     return snapshot;
 }
 
-double SymbolCache::get_bid(uint16_t symbol_id) const {
-    if (!is_valid_symbol(symbol_id)) return 0.0;
+double SymbolCache::get_bid(uint32_t slot) const {
+    if (!is_valid_symbol(slot)) return 0.0;
     
-    const auto& state = states_[symbol_id];
+    const auto& state = states_[slot];
     uint64_t seq1, seq2;
     double value;
     
@@ -133,10 +159,10 @@ double SymbolCache::get_bid(uint16_t symbol_id) const {
     return value;
 }
 
-double SymbolCache::get_ask(uint16_t symbol_id) const {
-    if (!is_valid_symbol(symbol_id)) return 0.0;
+double SymbolCache::get_ask(uint32_t slot) const {
+    if (!is_valid_symbol(slot)) return 0.0;
     
-    const auto& state = states_[symbol_id];
+    const auto& state = states_[slot];
     uint64_t seq1, seq2;
     double value;
     
@@ -152,10 +178,10 @@ double SymbolCache::get_ask(uint16_t symbol_id) const {
     return value;
 }
 
-double SymbolCache::get_ltp(uint16_t symbol_id) const {
-    if (!is_valid_symbol(symbol_id)) return 0.0;
+double SymbolCache::get_ltp(uint32_t slot) const {
+    if (!is_valid_symbol(slot)) return 0.0;
     
-    const auto& state = states_[symbol_id];
+    const auto& state = states_[slot];
     uint64_t seq1, seq2;
     double value;
     
@@ -171,6 +197,25 @@ double SymbolCache::get_ltp(uint16_t symbol_id) const {
     return value;
 }
 
+bool SymbolCache::is_stale(uint32_t slot) const {
+    if (!is_valid_symbol(slot)) return false;
+    
+    const auto& state = states_[slot];
+    uint64_t seq1, seq2;
+    bool value;
+    
+    do {
+        seq1 = state.sequence.load(std::memory_order_acquire);
+        while (seq1 & 1) {
+            seq1 = state.sequence.load(std::memory_order_acquire);
+        }
+        value = state.stale;
+        seq2 = state.sequence.load(std::memory_order_acquire);
+    } while (seq1 != seq2);
+    
+    return value;
+}
+
 uint64_t SymbolCache::get_total_updates() const {
     uint64_t total = 0;
     for (const auto& state : states_) {
@@ -191,4 +236,14 @@ uint64_t SymbolCache::get_total_updates() const {
     return total;
 }
 
+size_t SymbolCache::get_stale_count() const {
+    size_t count = 0;
+    for (size_t i = 0; i < num_symbols_; ++i) {
+        if (is_stale(static_cast<uint32_t>(i))) {
+            count++;
+        }
+    }
+    return count;
+}
+
 } // namespace mdfh
@@ -1,5 +1,5 @@
 #include "common/config_parser.h"
-#include <iostream>
+#include "common/logger.h"
 #include <algorithm>
 
 namespace mdfh {
@@ -7,7 +7,7 @@ namespace mdfh {
 bool ConfigParser::load(const std::string& filepath) {
     std::ifstream file(filepath);
     if (!file.is_open()) {
-        std::cerr << "Failed to open config file: " << filepath << std::endl;
+        MDFH_LOG_ERROR("Failed to open config file: {}", filepath);
         return false;
     }
     
@@ -0,0 +1,198 @@
+#include "common/consolidated_book.h"
+#include "common/tsc_clock.h"
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+namespace mdfh {
+
+ConsolidatedBook::ConsolidatedBook(size_t num_symbols, size_t num_venues)
+    : ConsolidatedBook(SymbolMap(num_symbols), num_venues) {
+}
+
+ConsolidatedBook::ConsolidatedBook(SymbolMap symbols, size_t num_venues)
+    : symbol_map_(std::move(symbols)),
+      num_venues_(num_venues),
+      states_(symbol_map_.size()),
+      quotes_(symbol_map_.size() * num_venues) {
+    if (num_venues == 0 || num_venues > MAX_VENUES) {
+        throw std::invalid_argument("ConsolidatedBook: venue count must be 1.." +
+                                    std::to_string(MAX_VENUES));
+    }
+}
+
+uint64_t ConsolidatedBook::lock(State& state) {
+    // Several venue threads may write the same symbol: claim the seqlock by
+    // moving it from even to odd, so readers and other writers both wait
+    uint64_t seq = state.sequence.load(std::memory_order_relaxed);
+    for (;;) {
+        if (seq & 1) {
+            seq = state.sequence.load(std::memory_order_relaxed);
+            continue;
+        }
+        if (state.sequence.compare_exchange_weak(seq, seq + 1, std::memory_order_acquire,
+                                                 std::memory_order_relaxed)) {
+            return seq;
+        }
+    }
+}
+
+void ConsolidatedBook::unlock(State& state, uint64_t seq) {
+    state.sequence.store(seq + 2, std::memory_order_release);
+}
+
+namespace {
+
+template<bool IsBid>
+inline bool better(double a, double b) {
+    return IsBid ? a > b : a < b;
+}
+
+} // namespace
+
+template<bool IsBid>
+void ConsolidatedBook::rebuild_side(Side& side, const VenueQuote* quotes) {
+    side = Side{};
+    for (size_t v = 0; v < num_venues_; ++v) {
+        const VenueQuote& q = quotes[v];
+        double price = IsBid ? q.bid_price : q.ask_price;
+        uint32_t qty = IsBid ? q.bid_qty : q.ask_qty;
+        if (!q.live || price <= 0.0 || qty == 0) continue;
+
+        if (side.venue == NO_VENUE || better<IsBid>(price, side.price)) {
+            side.price = price;
+            side.quantity = qty;
+            side.top_quantity = qty;
+            side.venue = static_cast<uint8_t>(v);
+            side.venue_count = 1;
+        } else if (price == side.price) {
+            side.quantity += qty;
+            side.venue_count++;
+            if (qty > side.top_quantity) {
+                side.top_quantity = qty;
+                side.venue = static_cast<uint8_t>(v);
+            }
+        }
+    }
+}
+
+template<bool IsBid>
+void ConsolidatedBook::update_side(Side& side, const VenueQuote* quotes, size_t venue,
+                                   double old_price, uint32_t old_qty, bool was_live) {
+    const VenueQuote& q = quotes[venue];
+    double price = IsBid ? q.bid_price : q.ask_price;
+    uint32_t qty = IsBid ? q.bid_qty : q.ask_qty;
+    bool present = q.live && price > 0.0 && qty > 0;
+
+    // The venue contributed to the best level: unless it simply improved
+    // on it, the level has to be rebuilt from the other venues
+    bool was_at_best = was_live && old_price > 0.0 && old_qty > 0 &&
+                       side.venue != NO_VENUE && old_price == side.price;
+    if (was_at_best && !(present && better<IsBid>(price, side.price))) {
+        rebuild_side<IsBid>(side, quotes);
+        return;
+    }
+    if (!present) return;
+
+    if (side.venue == NO_VENUE || better<IsBid>(price, side.price)) {
+        side.price = price;
+        side.quantity = qty;
+        side.top_quantity = qty;
+        side.venue = static_cast<uint8_t>(venue);
+        side.venue_count = 1;
+    } else if (price == side.price) {
+        side.quantity += qty;
+        side.venue_count++;
+        if (qty > side.top_quantity) {
+            side.top_quantity = qty;
+            side.venue = static_cast<uint8_t>(venue);
+        }
+    }
+}
+
+void ConsolidatedBook::update_quote(size_t venue, SymbolId symbol_id, double bid_price, uint32_t bid_qty,
+                                    double ask_price, uint32_t ask_qty, uint64_t receive_ticks) {
+    uint32_t slot = symbol_map_.slot(symbol_id);
+    if (slot >= states_.size() || venue >= num_venues_) return;
+
+    State& state = states_[slot];
+    VenueQuote* quotes = &quotes_[static_cast<size_t>(slot) * num_venues_];
+
+    uint64_t seq = lock(state);
+
+    VenueQuote& q = quotes[venue];
+    VenueQuote old = q;
+    q.bid_price = bid_price;
+    q.bid_qty = bid_qty;
+    q.ask_price = ask_price;
+    q.ask_qty = ask_qty;
+    q.live = true;
+    if (!old.live) {
+        state.live_venues++;
+    }
+
+    update_side<true>(state.bid, quotes, venue, old.bid_price, old.bid_qty, old.live);
+    update_side<false>(state.ask, quotes, venue, old.ask_price, old.ask_qty, old.live);
+    state.last_update_time = receive_ticks;
+    state.update_count++;
+
+    unlock(state, seq);
+}
+
+void ConsolidatedBook::mark_venue_stale(size_t venue) {
+    if (venue >= num_venues_) return;
+
+    for (size_t i = 0; i < states_.size(); ++i) {
+        State& state = states_[i];
+        VenueQuote* quotes = &quotes_[i * num_venues_];
+
+        uint64_t seq = lock(state);
+        VenueQuote& q = quotes[venue];
+        if (q.live) {
+            q.live = false;
+            state.live_venues--;
+            update_side<true>(state.bid, quotes, venue, q.bid_price, q.bid_qty, true);
+            update_side<false>(state.ask, quotes, venue, q.ask_price, q.ask_qty, true);
+        }
+        unlock(state, seq);
+    }
+}
+
+ConsolidatedBook::Snapshot ConsolidatedBook::get_snapshot(SymbolId symbol_id) const {
+    Snapshot snapshot{};
+    snapshot.bid_venue = NO_VENUE;
+    snapshot.ask_venue = NO_VENUE;
+    snapshot.stale = true;
+
+    uint32_t slot = symbol_map_.slot(symbol_id);
+    if (slot >= states_.size()) return snapshot;
+
+    const State& state = states_[slot];
+
+    uint64_t seq1, seq2;
+    do {
+        seq1 = state.sequence.load(std::memory_order_acquire);
+        while (seq1 & 1) {
+            seq1 = state.sequence.load(std::memory_order_acquire);
+        }
+
+        snapshot.best_bid = state.bid.price;
+        snapshot.best_ask = state.ask.price;
+        snapshot.bid_quantity = state.bid.quantity;
+        snapshot.ask_quantity = state.ask.quantity;
+        snapshot.bid_venue = state.bid.venue;
+        snapshot.ask_venue = state.ask.venue;
+        snapshot.bid_venue_count = state.bid.venue_count;
+        snapshot.ask_venue_count = state.ask.venue_count;
+        snapshot.last_update_time = state.last_update_time;
+        snapshot.update_count = state.update_count;
+        snapshot.stale = state.live_venues == 0;
+
+        seq2 = state.sequence.load(std::memory_order_acquire);
+    } while (seq1 != seq2);
+
+    snapshot.last_update_time = TscClock::to_ns(snapshot.last_update_time);
+    return snapshot;
+}
+
+} // namespace mdfh
@@ -0,0 +1,205 @@
+#include "common/index_engine.h"
+#include "common/cache.h"
+#include "common/symbol_map.h"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <utility>
+
+namespace mdfh {
+
+IndexEngine::IndexEngine(size_t num_symbols, const std::vector<IndexDefinition>& indices)
+    : IndexEngine(SymbolMap(num_symbols), indices) {
+}
+
+IndexEngine::IndexEngine(SymbolMap symbols, const std::vector<IndexDefinition>& indices)
+    : symbol_map_(std::move(symbols)),
+      states_(indices.size()),
+      prices_(symbol_map_.size(), 0.0),
+      row_offsets_(symbol_map_.size() + 1, 0) {
+    const size_t num_symbols = symbol_map_.size();
+    names_.reserve(indices.size());
+    index_offsets_.reserve(indices.size() + 1);
+    index_offsets_.push_back(0);
+
+    for (size_t i = 0; i < indices.size(); ++i) {
+        const IndexDefinition& def = indices[i];
+        if (!(def.base_value > 0.0)) {
+            throw std::invalid_argument("IndexEngine: index '" + def.name + "' needs a positive base value");
+        }
+        for (const auto& c : def.constituents) {
+            uint32_t slot = symbol_map_.slot(c.symbol_id);
+            if (slot == SymbolMap::NO_SLOT) {
+                throw std::invalid_argument("IndexEngine: index '" + def.name + "' has unknown symbol " +
+                                            std::to_string(c.symbol_id));
+            }
+            double coefficient = c.shares;
+            if (def.weighting == IndexWeighting::FREE_FLOAT_MARKET_CAP) {
+                if (!(c.free_float > 0.0 && c.free_float <= 1.0)) {
+                    throw std::invalid_argument("IndexEngine: index '" + def.name +
+                                                "' has a free float outside (0, 1]");
+                }
+                coefficient *= c.free_float;
+            }
+            if (!(coefficient > 0.0)) {
+                throw std::invalid_argument("IndexEngine: index '" + def.name + "' has a non-positive weight");
+            }
+            terms_.push_back({slot, coefficient});
+            row_offsets_[slot + 1]++;
+        }
+        index_offsets_.push_back(static_cast<uint32_t>(terms_.size()));
+        names_.push_back(def.name);
+        states_[i].base_value = def.base_value;
+        states_[i].missing = static_cast<uint32_t>(def.constituents.size());
+    }
+
+    // Counts -> offsets, then scatter each index's terms into its symbols' rows
+    for (size_t s = 0; s < num_symbols; ++s) {
+        row_offsets_[s + 1] += row_offsets_[s];
+    }
+    entries_.resize(terms_.size());
+    std::vector<uint32_t> fill(row_offsets_.begin(), row_offsets_.end() - 1);
+    for (size_t i = 0; i < indices.size(); ++i) {
+        for (uint32_t t = index_offsets_[i]; t < index_offsets_[i + 1]; ++t) {
+            entries_[fill[terms_[t].slot]++] = {static_cast<uint32_t>(i), terms_[t].coefficient};
+        }
+    }
+}
+
+void IndexEngine::write_begin() {
+    uint64_t seq = sequence_.load(std::memory_order_relaxed);
+    sequence_.store(seq + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+}
+
+void IndexEngine::write_end() {
+    sequence_.store(sequence_.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+}
+
+void IndexEngine::apply(uint32_t slot, double price) {
+    double old_price = prices_[slot];
+    prices_[slot] = price;
+    double delta = price - old_price;
+    bool first = old_price == 0.0;
+
+    const Entry* entry = entries_.data() + row_offsets_[slot];
+    const Entry* end = entries_.data() + row_offsets_[slot + 1];
+    for (; entry != end; ++entry) {
+        State& state = states_[entry->index];
+        state.sum += entry->coefficient * delta;
+        state.update_count++;
+        if (first && --state.missing == 0) {
+            // Last constituent priced: base the index at its base value
+            state.divisor = state.sum / state.base_value;
+        }
+    }
+    updates_++;
+    index_updates_ += static_cast<uint64_t>(end - (entries_.data() + row_offsets_[slot]));
+}
+
+void IndexEngine::update_price(SymbolId symbol_id, double price) {
+    uint32_t slot = symbol_map_.slot(symbol_id);
+    if (slot >= prices_.size() || !(price > 0.0) || prices_[slot] == price) return;
+
+    write_begin();
+    apply(slot, price);
+    if (resync_interval_ != 0 && !states_.empty() && ++updates_since_resync_ >= resync_interval_) {
+        updates_since_resync_ = 0;
+        resync(next_resync_);
+        next_resync_ = (next_resync_ + 1) % states_.size();
+    }
+    write_end();
+}
+
+void IndexEngine::load_prices(const SymbolCache& cache, const SymbolMap* map) {
+    write_begin();
+    for (uint32_t s = 0; s < prices_.size(); ++s) {
+        SymbolId id = symbol_map_.id(s);
+        uint32_t cache_slot = map ? map->slot(id) : id;
+        if (cache_slot >= cache.get_num_symbols()) {
+            continue;
+        }
+        double price = cache.get_ltp(cache_slot);
+        if (price > 0.0 && price != prices_[s]) {
+            apply(s, price);
+        }
+    }
+    write_end();
+}
+
+void IndexEngine::resync(size_t index) {
+    State& state = states_[index];
+    double sum = 0.0;
+    for (uint32_t t = index_offsets_[index]; t < index_offsets_[index + 1]; ++t) {
+        sum += terms_[t].coefficient * prices_[terms_[t].slot];
+    }
+    if (state.divisor != 0.0 && sum != 0.0) {
+        double drift = std::fabs(state.sum - sum) / sum;
+        if (drift > max_drift_) max_drift_ = drift;
+    }
+    state.sum = sum;
+    resyncs_++;
+}
+
+void IndexEngine::resync_all() {
+    write_begin();
+    for (size_t i = 0; i < states_.size(); ++i) {
+        resync(i);
+    }
+    updates_since_resync_ = 0;
+    write_end();
+}
+
+IndexEngine::Snapshot IndexEngine::get_snapshot(size_t index) const {
+    Snapshot snapshot{};
+    if (index >= states_.size()) return snapshot;
+
+    const State& state = states_[index];
+    uint64_t seq1, seq2;
+    double sum, divisor;
+    do {
+        seq1 = sequence_.load(std::memory_order_acquire);
+        while (seq1 & 1) {
+            seq1 = sequence_.load(std::memory_order_acquire);
+        }
+
+        sum = state.sum;
+        divisor = state.divisor;
+        snapshot.missing_constituents = state.missing;
+        snapshot.update_count = state.update_count;
+
+        std::atomic_thread_fence(std::memory_order_acquire);
+        seq2 = sequence_.load(std::memory_order_relaxed);
+    } while (seq1 != seq2);
+
+    snapshot.value = divisor != 0.0 ? sum / divisor : 0.0;
+    return snapshot;
+}
+
+IndexEngine::Stats IndexEngine::get_stats() const {
+    Stats stats{};
+    uint64_t seq1, seq2;
+    do {
+        seq1 = sequence_.load(std::memory_order_acquire);
+        while (seq1 & 1) {
+            seq1 = sequence_.load(std::memory_order_acquire);
+        }
+
+        stats.updates = updates_;
+        stats.index_updates = index_updates_;
+        stats.resyncs = resyncs_;
+        stats.max_drift = max_drift_;
+
+        std::atomic_thread_fence(std::memory_order_acquire);
+        seq2 = sequence_.load(std::memory_order_relaxed);
+    } while (seq1 != seq2);
+    return stats;
+}
+
+size_t IndexEngine::get_symbol_fanout(SymbolId symbol_id) const {
+    uint32_t slot = symbol_map_.slot(symbol_id);
+    if (slot >= prices_.size()) return 0;
+    return row_offsets_[slot + 1] - row_offsets_[slot];
+}
+
+} // namespace mdfh
@@ -0,0 +1,361 @@
+#include "common/logger.h"
+#include <algorithm>
+#include <ctime>
+#include <cinttypes>
+
+namespace mdfh {
+
+std::atomic<uint8_t> Logger::min_level_{static_cast<uint8_t>(LogLevel::INFO)};
+
+static constexpr int IDLE_SLEEP_US = 500;
+static constexpr uint64_t REPORT_INTERVAL_NS = 1000000000ULL;
+
+namespace {
+
+// The calling thread's ring. RingOwner is only touched once a ring exists,
+// so its destructor runs at thread exit and hands the ring back.
+thread_local LogRing* t_ring = nullptr;
+thread_local bool t_exiting = false;
+
+struct RingOwner {
+    ~RingOwner() {
+        if (t_ring) {
+            t_ring->retired.store(true, std::memory_order_release);
+            t_ring = nullptr;
+        }
+        t_exiting = true;
+    }
+};
+
+} // namespace
+
+bool LogSite::admit(uint64_t now_ns, uint64_t args_hash, uint64_t& folded) {
+    // Deduplication: identical arguments within the window are folded
+    if (args_hash == last_args_hash.load(std::memory_order_relaxed) &&
+        now_ns - last_emit_ns.load(std::memory_order_relaxed) < WINDOW_NS) {
+        suppressed.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    // Rate limiting: fixed one-second window per site
+    if (max_per_second > 0) {
+        uint64_t start = window_start_ns.load(std::memory_order_relaxed);
+        if (now_ns - start >= WINDOW_NS) {
+            window_start_ns.store(now_ns, std::memory_order_relaxed);
+            window_count.store(0, std::memory_order_relaxed);
+        }
+        if (window_count.fetch_add(1, std::memory_order_relaxed) >= max_per_second) {
+            suppressed.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+    }
+
+    last_args_hash.store(args_hash, std::memory_order_relaxed);
+    last_emit_ns.store(now_ns, std::memory_order_relaxed);
+    folded = suppressed.exchange(0, std::memory_order_relaxed);
+    return true;
+}
+
+Logger& Logger::instance() {
+    // Intentionally leaked: threads may still log during static destruction.
+    // Output is drained by the atexit hook instead of the destructor.
+    static Logger* logger = [] {
+        Logger* l = new Logger();
+        std::atexit([] { Logger::instance().shutdown(); });
+        return l;
+    }();
+    return *logger;
+}
+
+Logger::Logger()
+    : running_(true),
+      output_(nullptr),
+      records_written_(0),
+      next_thread_index_(0),
+      retired_dropped_(0),
+      sites_head_(nullptr) {
+
+    auto wall = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+    wall_offset_ns_ = static_cast<int64_t>(wall) - static_cast<int64_t>(now_ns());
+
+    consumer_thread_ = std::thread(&Logger::consumer_loop, this);
+}
+
+Logger::~Logger() {
+    shutdown();
+}
+
+void Logger::set_output(FILE* out) {
+    flush();
+    output_.store(out, std::memory_order_release);
+}
+
+void Logger::flush() {
+    // Snapshot every ring's head, then wait for the consumer to pass it
+    struct Target {
+        LogRing* ring;
+        uint32_t thread_index;      // Tells the ring from a new one at the same address
+        size_t head;
+    };
+    std::vector<Target> targets;
+    {
+        std::scoped_lock lock(rings_mutex_);
+        targets.reserve(rings_.size());
+        for (auto& ring : rings_) {
+            targets.push_back({ring.get(), ring->thread_index, ring->head.load(std::memory_order_acquire)});
+        }
+    }
+
+    for (const Target& target : targets) {
+        while (true) {
+            {
+                // A ring missing from rings_ was retired fully drained
+                std::scoped_lock lock(rings_mutex_);
+                bool live = std::any_of(rings_.begin(), rings_.end(), [&target](const auto& r) {
+                    return r.get() == target.ring && r->thread_index == target.thread_index;
+                });
+                if (!live || target.ring->tail.load(std::memory_order_acquire) >= target.head) {
+                    break;
+                }
+            }
+            if (!running_.load(std::memory_order_acquire)) {
+                drain();
+            } else {
+                std::this_thread::sleep_for(std::chrono::microseconds(IDLE_SLEEP_US));
+            }
+        }
+    }
+
+    FILE* out = output_.load(std::memory_order_acquire);
+    if (out) {
+        std::fflush(out);
+    } else {
+        std::fflush(stdout);
+        std::fflush(stderr);
+    }
+}
+
+void Logger::shutdown() {
+    if (!running_.exchange(false)) {
+        return;
+    }
+    if (consumer_thread_.joinable()) {
+        consumer_thread_.join();
+    }
+    drain();
+    report_suppressed();
+    flush();
+}
+
+uint64_t Logger::get_records_dropped() const {
+    std::scoped_lock lock(rings_mutex_);
+    uint64_t total = retired_dropped_.load(std::memory_order_relaxed);
+    for (const auto& ring : rings_) {
+        total += ring->dropped.load(std::memory_order_relaxed);
+    }
+    return total;
+}
+
+size_t Logger::get_num_rings() const {
+    std::scoped_lock lock(rings_mutex_);
+    return rings_.size();
+}
+
+LogRing& Logger::local_ring() {
+    if (__builtin_expect(t_ring == nullptr, 0)) {
+        t_ring = register_ring();
+        if (!t_exiting) {
+            // A record logged from a thread_local destructor after the owner
+            // ran gets a ring that is never retired
+            static thread_local RingOwner owner;
+            (void)owner;
+        }
+    }
+    return *t_ring;
+}
+
+LogRing* Logger::register_ring() {
+    auto ring = std::make_unique<LogRing>();
+    LogRing* ptr = ring.get();
+
+    std::scoped_lock lock(rings_mutex_);
+    ptr->thread_index = next_thread_index_++;
+    rings_.push_back(std::move(ring));
+    return ptr;
+}
+
+void Logger::register_site(LogSite& site) {
+    bool expected = false;
+    if (!site.registered.compare_exchange_strong(expected, true)) {
+        return;
+    }
+
+    // Lock-free push onto the intrusive site list
+    LogSite* head = sites_head_.load(std::memory_order_relaxed);
+    do {
+        site.next = head;
+    } while (!sites_head_.compare_exchange_weak(head, &site,
+                                                 std::memory_order_release,
+                                                 std::memory_order_relaxed));
+}
+
+void Logger::consumer_loop() {
+    uint64_t last_report = now_ns();
+
+    while (running_.load(std::memory_order_acquire)) {
+        size_t written = drain();
+
+        uint64_t now = now_ns();
+        if (now - last_report >= REPORT_INTERVAL_NS) {
+            report_suppressed();
+            last_report = now;
+        }
+
+        if (written == 0) {
+            std::this_thread::sleep_for(std::chrono::microseconds(IDLE_SLEEP_US));
+        }
+    }
+}
+
+size_t Logger::drain() {
+    // Only this thread frees rings, so the snapshot stays valid
+    std::vector<LogRing*> rings;
+    {
+        std::scoped_lock lock(rings_mutex_);
+        rings.reserve(rings_.size());
+        for (auto& ring : rings_) {
+            rings.push_back(ring.get());
+        }
+    }
+
+    size_t written = 0;
+    bool any_retired = false;
+    for (LogRing* ring : rings) {
+        // Retired before reading head: the head seen is the thread's last
+        any_retired |= ring->retired.load(std::memory_order_acquire);
+        size_t tail = ring->tail.load(std::memory_order_relaxed);
+        size_t head = ring->head.load(std::memory_order_acquire);
+
+        while (tail != head) {
+            const LogRecord& rec = ring->records[tail & LogRing::INDEX_MASK];
+            write_line(rec.site->level, format_record(rec, ring->spill));
+            size_t spill_end = 0;
+            for (uint8_t i = 0; i < rec.num_args; ++i) {
+                if (rec.args[i].type == LogArg::Type::SPILLED) {
+                    spill_end = rec.args[i].spill.end;
+                }
+            }
+            ++tail;
+            ++written;
+            records_written_.fetch_add(1, std::memory_order_relaxed);
+            // Publish per record so producers regain space early
+            if (spill_end != 0) {
+                ring->spill_tail.store(spill_end, std::memory_order_release);
+            }
+            ring->tail.store(tail, std::memory_order_release);
+        }
+    }
+
+    if (any_retired) {
+        free_retired_rings();
+    }
+    return written;
+}
+
+void Logger::free_retired_rings() {
+    std::scoped_lock lock(rings_mutex_);
+    auto drained = [this](const std::unique_ptr<LogRing>& ring) {
+        if (!ring->retired.load(std::memory_order_acquire) ||
+            ring->tail.load(std::memory_order_relaxed) != ring->head.load(std::memory_order_acquire)) {
+            return false;
+        }
+        retired_dropped_.fetch_add(ring->dropped.load(std::memory_order_relaxed),
+                                   std::memory_order_relaxed);
+        return true;
+    };
+    rings_.erase(std::remove_if(rings_.begin(), rings_.end(), drained), rings_.end());
+}
+
+void Logger::report_suppressed() {
+    for (LogSite* site = sites_head_.load(std::memory_order_acquire);
+         site != nullptr; site = site->next) {
+        uint64_t n = site->suppressed.exchange(0, std::memory_order_relaxed);
+        if (n > 0) {
+            write_line(site->level, "suppressed " + std::to_string(n) +
+                                    " repeats of: " + site->format);
+        }
+    }
+}
+
+void Logger::write_line(LogLevel level, const std::string& line) {
+    FILE* out = output_.load(std::memory_order_acquire);
+    if (!out) {
+        out = (level >= LogLevel::WARN) ? stderr : stdout;
+    }
+    std::fwrite(line.data(), 1, line.size(), out);
+    std::fputc('\n', out);
+}
+
+std::string Logger::format_record(const LogRecord& rec, const char* spill) {
+    static const char* LEVEL_NAMES[] = {"DEBUG", "INFO", "WARN", "ERROR"};
+
+    std::string line;
+    line.reserve(128);
+
+    // Timestamp: wall-clock HH:MM:SS.uuuuuu
+    int64_t wall_ns = static_cast<int64_t>(rec.timestamp_ns) + instance().wall_offset_ns_;
+    time_t secs = static_cast<time_t>(wall_ns / 1000000000LL);
+    struct tm tm_buf;
+    localtime_r(&secs, &tm_buf);
+    char prefix[48];
+    int n = std::snprintf(prefix, sizeof(prefix), "%02d:%02d:%02d.%06d [%s] ",
+                          tm_buf.tm_hour, tm_buf.tm_min, tm_buf.tm_sec,
+                          static_cast<int>((wall_ns % 1000000000LL) / 1000),
+                          LEVEL_NAMES[static_cast<uint8_t>(rec.site->level) & 3]);
+    line.append(prefix, n > 0 ? static_cast<size_t>(n) : 0);
+
+    // Substitute "{}" placeholders in order
+    size_t arg_idx = 0;
+    for (const char* p = rec.site->format; *p; ++p) {
+        if (p[0] == '{' && p[1] == '}' && arg_idx < rec.num_args) {
+            const LogArg& arg = rec.args[arg_idx++];
+            char buf[32];
+            switch (arg.type) {
+                case LogArg::Type::INT:
+                    n = std::snprintf(buf, sizeof(buf), "%" PRId64, arg.i);
+                    line.append(buf, n);
+                    break;
+                case LogArg::Type::UINT:
+                    n = std::snprintf(buf, sizeof(buf), "%" PRIu64, arg.u);
+                    line.append(buf, n);
+                    break;
+                case LogArg::Type::DOUBLE:
+                    n = std::snprintf(buf, sizeof(buf), "%g", arg.d);
+                    line.append(buf, n);
+                    break;
+                case LogArg::Type::STR:
+                    line.append(arg.s);
+                    break;
+                case LogArg::Type::SPILLED:
+                    if (spill) {
+                        line.append(spill + arg.spill.offset, arg.spill.length);
+                    }
+                    break;
+            }
+            ++p;
+        } else {
+            line.push_back(*p);
+        }
+    }
+
+    if (rec.folded > 0) {
+        line.append(" [suppressed ");
+        line.append(std::to_string(rec.folded));
+        line.append(" similar]");
+    }
+
+    return line;
+}
+
+} // namespace mdfh
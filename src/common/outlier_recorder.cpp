@@ -0,0 +1,112 @@
+#include "common/outlier_recorder.h"
+#include "common/tsc_clock.h"
+#include <fstream>
+
+namespace mdfh {
+
+// Round up to next power of 2
+static size_t next_power_of_2(size_t n) {
+    if (n == 0) return 1;
+    n--;
+    n |= n >> 1;
+    n |= n >> 2;
+    n |= n >> 4;
+    n |= n >> 8;
+    n |= n >> 16;
+    n |= n >> 32;
+    return n + 1;
+}
+
+const char* latency_stage_name(LatencyStage stage) {
+    switch (stage) {
+        case LatencyStage::RECEIVE:  return "receive";
+        case LatencyStage::QUEUE:    return "queue";
+        case LatencyStage::DISPATCH: return "dispatch";
+        default:                     return "unknown";
+    }
+}
+
+OutlierRecorder::OutlierRecorder(size_t capacity, uint64_t end_to_end_threshold_ns,
+                                 uint64_t stage_threshold_ns)
+    : capacity_(next_power_of_2(capacity)),
+      index_mask_(capacity_ - 1),
+      slots_(new Slot[capacity_]),
+      end_to_end_threshold_ns_(end_to_end_threshold_ns),
+      stage_threshold_ns_(stage_threshold_ns) {
+}
+
+void OutlierRecorder::capture(const OutlierRecord& record) {
+    uint64_t pos = head_.fetch_add(1, std::memory_order_relaxed);
+    Slot& slot = slots_[pos & index_mask_];
+    
+    // Per-slot seqlock: odd while writing, 2 * (pos + 1) when holding `pos`
+    slot.seq.store(2 * pos + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    slot.record = record;
+    slot.seq.store(2 * (pos + 1), std::memory_order_release);
+}
+
+std::vector<OutlierRecord> OutlierRecorder::snapshot() const {
+    std::vector<OutlierRecord> result;
+    uint64_t head = head_.load(std::memory_order_acquire);
+    uint64_t begin = head > capacity_ ? head - capacity_ : 0;
+    result.reserve(head - begin);
+    
+    for (uint64_t pos = begin; pos < head; ++pos) {
+        const Slot& slot = slots_[pos & index_mask_];
+        uint64_t expected = 2 * (pos + 1);
+        
+        // Skip slots still being written or already reused by a newer capture
+        if (slot.seq.load(std::memory_order_acquire) != expected) {
+            continue;
+        }
+        OutlierRecord copy = slot.record;
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (slot.seq.load(std::memory_order_relaxed) != expected) {
+            continue;
+        }
+        result.push_back(copy);
+    }
+    
+    return result;
+}
+
+bool OutlierRecorder::export_to_csv(const std::string& filename) const {
+    std::ofstream file(filename);
+    if (!file.is_open()) {
+        return false;
+    }
+    
+    file << "capture_ns,symbol_id,seq_num,msg_type,exchange_timestamp_ns,end_to_end_ns";
+    for (size_t s = 0; s < static_cast<size_t>(LatencyStage::COUNT); ++s) {
+        file << "," << latency_stage_name(static_cast<LatencyStage>(s)) << "_ns";
+    }
+    file << ",batch_bytes,batch_index,parser_buffer_fill,cpu\n";
+    
+    for (const auto& r : snapshot()) {
+        file << TscClock::to_wall_ns(r.capture_ticks) << ","
+             << r.symbol_id << ","
+             << r.seq_num << ","
+             << r.msg_type << ","
+             << r.exchange_timestamp_ns << ","
+             << r.end_to_end_ns;
+        for (size_t s = 0; s < static_cast<size_t>(LatencyStage::COUNT); ++s) {
+            file << "," << r.stage_ns[s];
+        }
+        file << "," << r.batch_bytes
+             << "," << r.batch_index
+             << "," << r.parser_buffer_fill
+             << "," << r.cpu << "\n";
+    }
+    
+    return true;
+}
+
+void OutlierRecorder::reset() {
+    for (size_t i = 0; i < capacity_; ++i) {
+        slots_[i].seq.store(0, std::memory_order_relaxed);
+    }
+    head_.store(0, std::memory_order_release);
+}
+
+} // namespace mdfh
@@ -0,0 +1,207 @@
+#include "common/philox.h"
+#include <cmath>
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+namespace mdfh {
+
+namespace {
+
+constexpr uint32_t PHILOX_M0 = 0xD2511F53;
+constexpr uint32_t PHILOX_M1 = 0xCD9E8D57;
+constexpr uint32_t PHILOX_W0 = 0x9E3779B9;   // Golden ratio
+constexpr uint32_t PHILOX_W1 = 0xBB67AE85;   // sqrt(3) - 1
+constexpr int PHILOX_ROUNDS = 10;
+
+// Counter lanes [c0..c3] of N blocks, run through all rounds in place
+template<size_t N>
+inline void philox_rounds(uint32_t (&c0)[N], uint32_t (&c1)[N], uint32_t (&c2)[N],
+                          uint32_t (&c3)[N], uint32_t k0, uint32_t k1) {
+    for (int r = 0; r < PHILOX_ROUNDS; ++r) {
+        for (size_t l = 0; l < N; ++l) {
+            uint64_t p0 = static_cast<uint64_t>(PHILOX_M0) * c0[l];
+            uint64_t p1 = static_cast<uint64_t>(PHILOX_M1) * c2[l];
+            uint32_t n0 = static_cast<uint32_t>(p1 >> 32) ^ c1[l] ^ k0;
+            uint32_t n2 = static_cast<uint32_t>(p0 >> 32) ^ c3[l] ^ k1;
+            c0[l] = n0;
+            c1[l] = static_cast<uint32_t>(p1);
+            c2[l] = n2;
+            c3[l] = static_cast<uint32_t>(p0);
+        }
+        k0 += PHILOX_W0;
+        k1 += PHILOX_W1;
+    }
+}
+
+#if defined(__AVX2__)
+// philox_rounds for 8 blocks, one per 32-bit lane of an AVX2 register,
+// written to out as 32 uniforms in block order. The 32x32->64 multiplies
+// (vpmuludq) take the even lanes; the odd lanes are shifted down,
+// multiplied and blended back.
+inline void philox_uniforms_x8(const uint32_t (&c0)[8], const uint32_t (&c1)[8], const uint32_t (&c2)[8],
+                               const uint32_t (&c3)[8], uint32_t k0, uint32_t k1, double* out) {
+    __m256i x0 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(c0));
+    __m256i x1 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(c1));
+    __m256i x2 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(c2));
+    __m256i x3 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(c3));
+    const __m256i m0 = _mm256_set1_epi32(static_cast<int>(PHILOX_M0));
+    const __m256i m1 = _mm256_set1_epi32(static_cast<int>(PHILOX_M1));
+
+    auto mul_hi_lo = [](__m256i a, __m256i m, __m256i& hi, __m256i& lo) {
+        __m256i even = _mm256_mul_epu32(a, m);
+        __m256i odd = _mm256_mul_epu32(_mm256_srli_epi64(a, 32), m);
+        hi = _mm256_blend_epi32(_mm256_srli_epi64(even, 32), odd, 0xAA);
+        lo = _mm256_blend_epi32(even, _mm256_slli_epi64(odd, 32), 0xAA);
+    };
+
+    for (int r = 0; r < PHILOX_ROUNDS; ++r) {
+        __m256i hi0, lo0, hi1, lo1;
+        mul_hi_lo(x0, m0, hi0, lo0);
+        mul_hi_lo(x2, m1, hi1, lo1);
+        __m256i key0 = _mm256_set1_epi32(static_cast<int>(k0));
+        __m256i key1 = _mm256_set1_epi32(static_cast<int>(k1));
+        x0 = _mm256_xor_si256(_mm256_xor_si256(hi1, x1), key0);
+        x1 = lo1;
+        x2 = _mm256_xor_si256(_mm256_xor_si256(hi0, x3), key1);
+        x3 = lo0;
+        k0 += PHILOX_W0;
+        k1 += PHILOX_W1;
+    }
+
+    // Transpose word lanes into blocks: each 128-bit half is one block
+    __m256i t0 = _mm256_unpacklo_epi32(x0, x1);
+    __m256i t1 = _mm256_unpackhi_epi32(x0, x1);
+    __m256i t2 = _mm256_unpacklo_epi32(x2, x3);
+    __m256i t3 = _mm256_unpackhi_epi32(x2, x3);
+    const __m256i blocks[4] = {
+        _mm256_unpacklo_epi64(t0, t2),      // Blocks 0 | 4
+        _mm256_unpackhi_epi64(t0, t2),      // Blocks 1 | 5
+        _mm256_unpacklo_epi64(t1, t3),      // Blocks 2 | 6
+        _mm256_unpackhi_epi64(t1, t3),      // Blocks 3 | 7
+    };
+
+    // Unsigned words to (word + 0.5) / 2^32: flip the sign bit, convert
+    // as signed and add 2^31 back
+    const __m128i sign = _mm_set1_epi32(static_cast<int>(0x80000000u));
+    const __m256d offset = _mm256_set1_pd(2147483648.0 + 0.5);
+    const __m256d scale = _mm256_set1_pd(1.0 / 4294967296.0);
+    for (int b = 0; b < 4; ++b) {
+        __m128i lo = _mm_xor_si128(_mm256_castsi256_si128(blocks[b]), sign);
+        __m128i hi = _mm_xor_si128(_mm256_extracti128_si256(blocks[b], 1), sign);
+        _mm256_storeu_pd(out + 4 * b,
+                         _mm256_mul_pd(_mm256_add_pd(_mm256_cvtepi32_pd(lo), offset), scale));
+        _mm256_storeu_pd(out + 4 * (b + 4),
+                         _mm256_mul_pd(_mm256_add_pd(_mm256_cvtepi32_pd(hi), offset), scale));
+    }
+}
+#endif
+
+// Box-Muller on a pair of (0, 1) uniforms
+inline void box_muller(double u1, double u2, double& z0, double& z1) {
+    double radius = std::sqrt(-2.0 * std::log(u1));
+    double angle = 2.0 * M_PI * u2;
+    z0 = radius * std::cos(angle);
+    z1 = radius * std::sin(angle);
+}
+
+} // namespace
+
+Philox4x32::Philox4x32(uint64_t seed, RngStream purpose, uint32_t id)
+    : key_(seed),
+      stream_(static_cast<uint64_t>(purpose) << 32 | id) {
+}
+
+Philox4x32::Block Philox4x32::block(const Block& counter, uint64_t key) {
+    uint32_t c0[1] = {counter[0]}, c1[1] = {counter[1]}, c2[1] = {counter[2]}, c3[1] = {counter[3]};
+    philox_rounds(c0, c1, c2, c3, static_cast<uint32_t>(key), static_cast<uint32_t>(key >> 32));
+    return {c0[0], c1[0], c2[0], c3[0]};
+}
+
+void Philox4x32::refill() {
+    buffer_ = block({static_cast<uint32_t>(next_block_), static_cast<uint32_t>(next_block_ >> 32),
+                     static_cast<uint32_t>(stream_), static_cast<uint32_t>(stream_ >> 32)}, key_);
+    next_block_++;
+    next_word_ = 0;
+}
+
+void Philox4x32::seek(uint64_t index) {
+    next_block_ = index;
+    next_word_ = 4;
+    has_spare_normal_ = false;
+}
+
+double Philox4x32::normal() {
+    if (has_spare_normal_) {
+        has_spare_normal_ = false;
+        return spare_normal_;
+    }
+    double u1 = uniform();
+    double u2 = uniform();
+    double z0;
+    box_muller(u1, u2, z0, spare_normal_);
+    has_spare_normal_ = true;
+    return z0;
+}
+
+void Philox4x32::fill_uniform(double* out, size_t count) {
+    size_t i = 0;
+    // Finish the buffered block first so bulk and scalar draws line up
+    while (i < count && next_word_ < 4) {
+        out[i++] = uniform();
+    }
+
+    constexpr size_t BATCH = LANES * 4;
+    uint32_t k0 = static_cast<uint32_t>(key_);
+    uint32_t k1 = static_cast<uint32_t>(key_ >> 32);
+    uint32_t s0 = static_cast<uint32_t>(stream_);
+    uint32_t s1 = static_cast<uint32_t>(stream_ >> 32);
+    while (count - i >= BATCH) {
+        uint32_t c0[LANES], c1[LANES], c2[LANES], c3[LANES];
+        for (size_t l = 0; l < LANES; ++l) {
+            uint64_t index = next_block_ + l;
+            c0[l] = static_cast<uint32_t>(index);
+            c1[l] = static_cast<uint32_t>(index >> 32);
+            c2[l] = s0;
+            c3[l] = s1;
+        }
+#if defined(__AVX2__)
+        static_assert(LANES == 8, "AVX2 path computes 8 blocks per pass");
+        philox_uniforms_x8(c0, c1, c2, c3, k0, k1, out + i);
+#else
+        philox_rounds(c0, c1, c2, c3, k0, k1);
+        for (size_t l = 0; l < LANES; ++l) {
+            out[i + 4 * l] = to_unit(c0[l]);
+            out[i + 4 * l + 1] = to_unit(c1[l]);
+            out[i + 4 * l + 2] = to_unit(c2[l]);
+            out[i + 4 * l + 3] = to_unit(c3[l]);
+        }
+#endif
+        next_block_ += LANES;
+        i += BATCH;
+    }
+
+    while (i < count) {
+        out[i++] = uniform();
+    }
+}
+
+void Philox4x32::fill_normal(double* out, size_t count) {
+    size_t i = 0;
+    if (count > 0 && has_spare_normal_) {
+        out[i++] = normal();
+    }
+
+    // Uniform pairs in place, then transformed pairwise
+    size_t pairs = (count - i) / 2;
+    fill_uniform(out + i, pairs * 2);
+    for (size_t p = 0; p < pairs; ++p, i += 2) {
+        box_muller(out[i], out[i + 1], out[i], out[i + 1]);
+    }
+
+    if (i < count) {
+        out[i] = normal();
+    }
+}
+
+} // namespace mdfh
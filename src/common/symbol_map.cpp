@@ -0,0 +1,70 @@
+#include "common/symbol_map.h"
+#include <numeric>
+#include <stdexcept>
+#include <string>
+
+namespace mdfh {
+
+SymbolMap::SymbolMap(size_t num_symbols)
+    : ids_(num_symbols) {
+    if (num_symbols > static_cast<size_t>(MAX_ID) + 1) {
+        throw std::invalid_argument("SymbolMap of " + std::to_string(num_symbols) +
+                                    " symbols exceeds SymbolMap::MAX_ID");
+    }
+    std::iota(ids_.begin(), ids_.end(), 0);
+    build();
+}
+
+SymbolMap::SymbolMap(const std::vector<SymbolId>& ids)
+    : ids_(ids) {
+    build();
+}
+
+void SymbolMap::build() {
+    std::vector<SymbolId> sorted(ids_);
+    std::sort(sorted.begin(), sorted.end());
+    auto duplicate = std::adjacent_find(sorted.begin(), sorted.end());
+    if (duplicate != sorted.end()) {
+        throw std::invalid_argument("Duplicate symbol id " + std::to_string(*duplicate));
+    }
+    const SymbolId max_id = sorted.empty() ? 0 : sorted.back();
+
+    // Smallest table: directory entries up to the largest id (plus the
+    // clamp entry) and one page per distinct page of ids plus the empty one
+    size_t best_bytes = SIZE_MAX;
+    size_t best_pages = 1;
+    for (uint32_t bits = MIN_PAGE_BITS; bits <= MAX_PAGE_BITS; ++bits) {
+        size_t directory = (static_cast<size_t>(max_id) >> bits) + 2;
+        size_t pages = 1;
+        for (size_t i = 0; i < sorted.size(); ++i) {
+            if (i == 0 || (sorted[i] >> bits) != (sorted[i - 1] >> bits)) {
+                pages++;
+            }
+        }
+        size_t bytes = (directory + (pages << bits)) * sizeof(uint32_t);
+        if (bytes < best_bytes) {
+            best_bytes = bytes;
+            best_pages = pages;
+            page_bits_ = bits;
+        }
+    }
+
+    const uint32_t page_size = 1u << page_bits_;
+    page_mask_ = page_size - 1;
+    pages_.assign((static_cast<size_t>(max_id) >> page_bits_) + 2, 0);
+    last_page_ = static_cast<uint32_t>(pages_.size() - 1);
+    slots_.reserve(best_pages << page_bits_);
+    slots_.assign(page_size, NO_SLOT);
+
+    for (size_t slot = 0; slot < ids_.size(); ++slot) {
+        SymbolId id = ids_[slot];
+        uint32_t& page = pages_[id >> page_bits_];
+        if (page == 0) {
+            page = static_cast<uint32_t>(slots_.size());
+            slots_.resize(slots_.size() + page_size, NO_SLOT);
+        }
+        slots_[page + (id & page_mask_)] = static_cast<uint32_t>(slot);
+    }
+}
+
+} // namespace mdfh
@@ -0,0 +1,211 @@
+#include "common/symbol_universe.h"
+#include <algorithm>
+#include <charconv>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <utility>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace mdfh {
+
+namespace {
+
+// Next comma-separated field of [p, end); p moves past the comma
+std::string_view next_field(const char*& p, const char* end) {
+    const char* start = p;
+    while (p < end && *p != ',') {
+        ++p;
+    }
+    std::string_view field(start, static_cast<size_t>(p - start));
+    if (p < end) {
+        ++p;
+    }
+    return field;
+}
+
+template <typename T>
+bool parse_number(std::string_view field, T& value) {
+    const char* begin = field.data();
+    const char* end = begin + field.size();
+    while (begin < end && (*begin == ' ' || *begin == '\t')) ++begin;
+    while (end > begin && (end[-1] == ' ' || end[-1] == '\t')) --end;
+    auto [ptr, ec] = std::from_chars(begin, end, value);
+    return ec == std::errc() && ptr == end && begin < end;
+}
+
+} // namespace
+
+SymbolUniverse SymbolUniverse::load(const std::string& file) {
+    int fd = open(file.c_str(), O_RDONLY);
+    if (fd < 0) {
+        throw std::runtime_error("Symbol file not found: " + file);
+    }
+    struct stat st{};
+    if (fstat(fd, &st) < 0) {
+        close(fd);
+        throw std::runtime_error("Cannot stat symbol file: " + file);
+    }
+
+    SymbolUniverse universe;
+    universe.data_size_ = static_cast<size_t>(st.st_size);
+    if (universe.data_size_ > 0) {
+        void* map = mmap(nullptr, universe.data_size_, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (map == MAP_FAILED) {
+            close(fd);
+            throw std::runtime_error("Cannot map symbol file: " + file);
+        }
+        madvise(map, universe.data_size_, MADV_SEQUENTIAL);
+        universe.data_ = static_cast<const char*>(map);
+    }
+    close(fd);  // The mapping stays valid
+
+    if (universe.data_size_ >= sizeof(MAGIC) && std::memcmp(universe.data_, MAGIC, sizeof(MAGIC)) == 0) {
+        universe.map_binary(file);
+    } else {
+        universe.parse_csv();
+    }
+    return universe;
+}
+
+void SymbolUniverse::parse_csv() {
+    const char* p = data_;
+    const char* end = data_ + data_size_;
+
+    // Skip the header row
+    const char* eol = p ? static_cast<const char*>(std::memchr(p, '\n', data_size_)) : nullptr;
+    p = eol ? eol + 1 : end;
+
+    // One allocation: at most one record per remaining line
+    parsed_.reserve(static_cast<size_t>(std::count(p, end, '\n')) + 1);
+
+    while (p < end) {
+        eol = static_cast<const char*>(std::memchr(p, '\n', static_cast<size_t>(end - p)));
+        const char* line_end = eol ? eol : end;
+        const char* next = eol ? eol + 1 : end;
+        if (line_end > p && line_end[-1] == '\r') {
+            --line_end;
+        }
+        if (line_end == p) {
+            p = next;
+            continue;
+        }
+
+        // symbol_id,symbol,price,volatility,drift[,weight]
+        SymbolRecord record{};
+        std::string_view id = next_field(p, line_end);
+        std::string_view name = next_field(p, line_end);
+        std::string_view price = next_field(p, line_end);
+        std::string_view volatility = next_field(p, line_end);
+        std::string_view drift = next_field(p, line_end);
+        if (parse_number(id, record.symbol_id) && !name.empty() &&
+            parse_number(price, record.price) &&
+            parse_number(volatility, record.volatility) &&
+            parse_number(drift, record.drift)) {
+            if (p < line_end && (!parse_number(next_field(p, line_end), record.weight) || record.weight < 0.0)) {
+                record.weight = 0.0;
+            }
+            record.name_offset = static_cast<uint32_t>(name.data() - data_);
+            record.name_length = static_cast<uint32_t>(name.size());
+            parsed_.push_back(record);
+        } else {
+            skipped_rows_++;
+        }
+        p = next;
+    }
+
+    records_ = parsed_.data();
+    count_ = parsed_.size();
+    names_ = data_;
+    names_size_ = data_size_;
+}
+
+void SymbolUniverse::map_binary(const std::string& file) {
+    FileHeader header;
+    if (data_size_ < sizeof(header)) {
+        throw std::runtime_error("Truncated symbol universe: " + file);
+    }
+    std::memcpy(&header, data_, sizeof(header));
+    if (header.version != VERSION || header.record_size != sizeof(SymbolRecord)) {
+        throw std::runtime_error("Unsupported symbol universe version in " + file);
+    }
+    uint64_t records_size = header.count * sizeof(SymbolRecord);
+    if (header.count > data_size_ / sizeof(SymbolRecord) ||
+        sizeof(header) + records_size + header.names_size != data_size_) {
+        throw std::runtime_error("Truncated symbol universe: " + file);
+    }
+
+    binary_ = true;
+    records_ = reinterpret_cast<const SymbolRecord*>(data_ + sizeof(header));
+    count_ = static_cast<size_t>(header.count);
+    names_ = data_ + sizeof(header) + records_size;
+    names_size_ = static_cast<size_t>(header.names_size);
+    for (const SymbolRecord& record : *this) {
+        if (static_cast<uint64_t>(record.name_offset) + record.name_length > names_size_) {
+            throw std::runtime_error("Corrupt symbol universe: " + file);
+        }
+    }
+}
+
+void SymbolUniverse::save(const std::string& file) const {
+    // Names are compacted into one blob in record order
+    std::vector<SymbolRecord> records(begin(), end());
+    std::string names;
+    for (auto& record : records) {
+        std::string_view n = name(record);
+        record.name_offset = static_cast<uint32_t>(names.size());
+        names.append(n.data(), n.size());
+    }
+
+    FileHeader header{};
+    std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.version = VERSION;
+    header.record_size = sizeof(SymbolRecord);
+    header.count = records.size();
+    header.names_size = names.size();
+
+    std::ofstream out(file, std::ios::binary | std::ios::trunc);
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    out.write(reinterpret_cast<const char*>(records.data()),
+              static_cast<std::streamsize>(records.size() * sizeof(SymbolRecord)));
+    out.write(names.data(), static_cast<std::streamsize>(names.size()));
+    if (!out) {
+        throw std::runtime_error("Failed to write symbol universe: " + file);
+    }
+}
+
+SymbolUniverse::SymbolUniverse(SymbolUniverse&& other) noexcept {
+    *this = std::move(other);
+}
+
+SymbolUniverse& SymbolUniverse::operator=(SymbolUniverse&& other) noexcept {
+    if (this != &other) {
+        unmap();
+        data_ = std::exchange(other.data_, nullptr);
+        data_size_ = std::exchange(other.data_size_, 0);
+        parsed_ = std::move(other.parsed_);   // Buffer moves with it: records_ stays valid
+        records_ = std::exchange(other.records_, nullptr);
+        count_ = std::exchange(other.count_, 0);
+        names_ = std::exchange(other.names_, nullptr);
+        names_size_ = std::exchange(other.names_size_, 0);
+        skipped_rows_ = other.skipped_rows_;
+        binary_ = other.binary_;
+    }
+    return *this;
+}
+
+SymbolUniverse::~SymbolUniverse() {
+    unmap();
+}
+
+void SymbolUniverse::unmap() {
+    if (data_ != nullptr) {
+        munmap(const_cast<char*>(data_), data_size_);
+        data_ = nullptr;
+    }
+}
+
+} // namespace mdfh
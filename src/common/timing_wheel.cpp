@@ -0,0 +1,133 @@
+#include "common/timing_wheel.h"
+#include <algorithm>
+
+namespace mdfh {
+
+TimingWheel::TimingWheel(size_t capacity, uint64_t start)
+    : capacity_(capacity),
+      current_(start),
+      deadline_(capacity, 0),
+      next_(capacity, NONE),
+      prev_(capacity, NONE),
+      slot_of_(capacity, NONE),
+      head_(LEVELS * SLOTS, NONE),
+      tail_(LEVELS * SLOTS, NONE) {
+}
+
+void TimingWheel::schedule(uint32_t id, uint64_t deadline) {
+    if (id >= capacity_) {
+        return;
+    }
+    if (slot_of_[id] != NONE) {
+        unlink(id);
+    } else {
+        size_++;
+    }
+    // The slot for current_ has already fired
+    deadline_[id] = deadline > current_ ? deadline : current_ + 1;
+    insert(id);
+}
+
+bool TimingWheel::cancel(uint32_t id) {
+    if (!is_scheduled(id)) {
+        return false;
+    }
+    unlink(id);
+    size_--;
+    return true;
+}
+
+void TimingWheel::clear(uint64_t now) {
+    std::fill(slot_of_.begin(), slot_of_.end(), NONE);
+    std::fill(head_.begin(), head_.end(), NONE);
+    std::fill(tail_.begin(), tail_.end(), NONE);
+    occupied_.fill(0);
+    size_ = 0;
+    current_ = now;
+}
+
+void TimingWheel::insert(uint32_t id) {
+    uint64_t deadline = deadline_[id];
+    uint64_t delta = deadline > current_ ? deadline - current_ : 0;
+
+    uint32_t level = 0;
+    uint64_t at = deadline > current_ ? deadline : current_;
+    while (level < LEVELS && delta >= (1ull << (SLOT_BITS * (level + 1)))) {
+        level++;
+    }
+    if (level == LEVELS) {
+        // Beyond the horizon: park in the farthest slot, re-inserted on cascade
+        level = LEVELS - 1;
+        at = current_ + HORIZON - 1;
+    }
+    uint32_t slot = static_cast<uint32_t>((at >> (SLOT_BITS * level)) & SLOT_MASK);
+    uint32_t index = level * SLOTS + slot;
+
+    slot_of_[id] = index;
+    next_[id] = NONE;
+    prev_[id] = tail_[index];
+    if (tail_[index] != NONE) {
+        next_[tail_[index]] = id;
+    } else {
+        head_[index] = id;
+    }
+    tail_[index] = id;
+    if (level == 0) {
+        occupied_[slot / 64] |= 1ull << (slot % 64);
+    }
+}
+
+void TimingWheel::unlink(uint32_t id) {
+    uint32_t index = slot_of_[id];
+    if (prev_[id] != NONE) {
+        next_[prev_[id]] = next_[id];
+    } else {
+        head_[index] = next_[id];
+    }
+    if (next_[id] != NONE) {
+        prev_[next_[id]] = prev_[id];
+    } else {
+        tail_[index] = prev_[id];
+    }
+    slot_of_[id] = NONE;
+    if (index < SLOTS && head_[index] == NONE) {
+        occupied_[index / 64] &= ~(1ull << (index % 64));
+    }
+}
+
+void TimingWheel::cascade() {
+    // Highest level whose lower levels all wrapped; cascade top down so a
+    // timer moved into a lower due slot is cascaded again right away
+    uint32_t top = 1;
+    while (top + 1 < LEVELS && (current_ & ((1ull << (SLOT_BITS * (top + 1))) - 1)) == 0) {
+        top++;
+    }
+    for (uint32_t level = top; level >= 1; --level) {
+        uint32_t slot = static_cast<uint32_t>((current_ >> (SLOT_BITS * level)) & SLOT_MASK);
+        uint32_t index = level * SLOTS + slot;
+        uint32_t id = head_[index];
+        head_[index] = NONE;
+        tail_[index] = NONE;
+        while (id != NONE) {
+            uint32_t next = next_[id];
+            insert(id);
+            id = next;
+        }
+    }
+}
+
+uint32_t TimingWheel::next_occupied(uint32_t from) const {
+    uint32_t word = from / 64;
+    uint64_t bits = occupied_[word] & (~0ull << (from % 64));
+    while (true) {
+        if (bits != 0) {
+            return word * 64 + static_cast<uint32_t>(__builtin_ctzll(bits));
+        }
+        if (++word == BITMAP_WORDS) {
+            return SLOTS;
+        }
+        bits = occupied_[word];
+    }
+}
+
+} // namespace mdfh
@@ -0,0 +1,152 @@
+#include "common/trace.h"
+#include <cstdio>
+#include <cinttypes>
+#include <pthread.h>
+
+namespace mdfh {
+
+static const char* ZONE_NAMES[] = {
+    "receive",
+    "parse",
+    "dispatch",
+    "cache_update",
+    "tick_generate",
+    "broadcast",
+    "send"
+};
+
+static_assert(sizeof(ZONE_NAMES) / sizeof(ZONE_NAMES[0]) ==
+              static_cast<size_t>(TraceZoneId::COUNT), "Zone name table out of date");
+
+const char* trace_zone_name(TraceZoneId zone) {
+    size_t idx = static_cast<size_t>(zone);
+    return idx < static_cast<size_t>(TraceZoneId::COUNT) ? ZONE_NAMES[idx] : "unknown";
+}
+
+// Thread names are caller-supplied: escape them as JSON string contents
+static void write_json_string(FILE* out, const std::string& text) {
+    for (unsigned char c : text) {
+        if (c == '"' || c == '\\') {
+            std::fprintf(out, "\\%c", c);
+        } else if (c < 0x20) {
+            std::fprintf(out, "\\u%04x", c);
+        } else {
+            std::fputc(c, out);
+        }
+    }
+}
+
+Tracer& Tracer::instance() {
+    // Leaked so zones in late-exiting threads never touch a destroyed tracer
+    static Tracer* tracer = new Tracer();
+    return *tracer;
+}
+
+TraceBuffer& Tracer::local_buffer() {
+    thread_local TraceBuffer* buffer = nullptr;
+    if (__builtin_expect(buffer == nullptr, 0)) {
+        buffer = register_buffer();
+    }
+    return *buffer;
+}
+
+TraceBuffer* Tracer::register_buffer() {
+    auto buffer = std::make_unique<TraceBuffer>();
+    TraceBuffer* ptr = buffer.get();
+
+    char name[32] = {0};
+    if (pthread_getname_np(pthread_self(), name, sizeof(name)) == 0 && name[0] != '\0') {
+        ptr->thread_name = name;
+    }
+
+    std::scoped_lock lock(buffers_mutex_);
+    ptr->thread_index = static_cast<uint32_t>(buffers_.size());
+    if (ptr->thread_name.empty()) {
+        ptr->thread_name = "thread-" + std::to_string(ptr->thread_index);
+    }
+    buffers_.push_back(std::move(buffer));
+    return ptr;
+}
+
+void Tracer::set_thread_name(const std::string& name) {
+    TraceBuffer& buf = local_buffer();
+    std::scoped_lock lock(buffers_mutex_);
+    buf.thread_name = name;
+}
+
+bool Tracer::dump_chrome_json(const std::string& filename) const {
+    FILE* out = std::fopen(filename.c_str(), "w");
+    if (!out) {
+        return false;
+    }
+
+    std::fprintf(out, "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n");
+    bool first = true;
+
+    std::scoped_lock lock(buffers_mutex_);
+    std::vector<TraceEvent> events;
+
+    for (const auto& buf : buffers_) {
+        std::fprintf(out, "%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%u,"
+                     "\"args\":{\"name\":\"",
+                     first ? "" : ",\n", buf->thread_index);
+        write_json_string(out, buf->thread_name);
+        std::fprintf(out, "\"}}");
+        first = false;
+
+        // Copy the live window, then drop anything the writer may have
+        // overwritten while we were copying. record() fills the slot of
+        // event head before publishing head + 1, so the oldest slot of the
+        // window may be mid-write too and is never trusted.
+        uint64_t head = buf->head.load(std::memory_order_acquire);
+        uint64_t begin = head > TraceBuffer::CAPACITY ? head - TraceBuffer::CAPACITY : 0;
+        events.clear();
+        events.reserve(head - begin);
+        for (uint64_t i = begin; i < head; ++i) {
+            events.push_back(buf->events[i & TraceBuffer::INDEX_MASK]);
+        }
+        uint64_t head_after = buf->head.load(std::memory_order_acquire);
+        uint64_t valid_from = head_after >= TraceBuffer::CAPACITY ?
+                              head_after - TraceBuffer::CAPACITY + 1 : 0;
+        size_t skip = valid_from > begin ? static_cast<size_t>(valid_from - begin) : 0;
+
+        for (size_t i = skip; i < events.size(); ++i) {
+            const TraceEvent& ev = events[i];
+            uint64_t start_ns = TscClock::to_ns(ev.start_ticks);
+            uint64_t dur_ns = TscClock::delta_to_ns(ev.duration_ticks);
+            // Chrome trace timestamps are microseconds
+            std::fprintf(out, ",\n{\"name\":\"%s\",\"ph\":\"X\",\"pid\":1,\"tid\":%u,"
+                         "\"ts\":%" PRIu64 ".%03" PRIu64 ",\"dur\":%" PRIu64 ".%03" PRIu64 "}",
+                         trace_zone_name(static_cast<TraceZoneId>(ev.zone)), buf->thread_index,
+                         start_ns / 1000, start_ns % 1000, dur_ns / 1000, dur_ns % 1000);
+        }
+    }
+
+    std::fprintf(out, "\n]}\n");
+    return std::fclose(out) == 0;
+}
+
+bool Tracer::poll_dump(const std::string& filename) {
+    if (!dump_requested_.exchange(false, std::memory_order_relaxed)) {
+        return false;
+    }
+    return dump_chrome_json(filename);
+}
+
+uint64_t Tracer::get_total_events() const {
+    std::scoped_lock lock(buffers_mutex_);
+    uint64_t total = 0;
+    for (const auto& buf : buffers_) {
+        total += buf->head.load(std::memory_order_relaxed);
+    }
+    return total;
+}
+
+void Tracer::reset() {
+    std::scoped_lock lock(buffers_mutex_);
+    for (auto& buf : buffers_) {
+        buf->head.store(0, std::memory_order_relaxed);
+    }
+}
+
+} // namespace mdfh
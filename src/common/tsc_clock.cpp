@@ -0,0 +1,252 @@
+#include "common/tsc_clock.h"
+#include <algorithm>
+#include <chrono>
+#if MDFH_HAS_RDTSC
+#include <cpuid.h>
+#endif
+
+namespace mdfh {
+
+// Initial calibration runs on first use, possibly from a hot thread,
+// so keep it short; the background calibrator refines it later.
+static constexpr uint32_t INITIAL_CALIBRATION_MS = 5;
+
+// A recalibration corrects the offset from CLOCK_MONOTONIC_RAW by slewing
+// the rate to close it over this long, never by more than MAX_SLEW_PPM
+static constexpr int64_t SLEW_WINDOW_NS = 1000000000LL;
+static constexpr int64_t MAX_SLEW_PPM = 500;
+
+namespace {
+
+struct ClockPair {
+    uint64_t ticks;
+    uint64_t ns;
+};
+
+// Read (ticks, ns) as close together as possible: take the pair whose
+// bracketing clock_gettime calls were nearest to each other.
+ClockPair sample_pair() {
+    ClockPair best{0, 0};
+    uint64_t best_window = UINT64_MAX;
+
+    for (int i = 0; i < 8; ++i) {
+        uint64_t ns0 = TscClock::monotonic_raw_ns();
+        uint64_t ticks = TscClock::rdtscp();
+        uint64_t ns1 = TscClock::monotonic_raw_ns();
+
+        if (ns1 - ns0 < best_window) {
+            best_window = ns1 - ns0;
+            best.ticks = ticks;
+            best.ns = ns0 + (ns1 - ns0) / 2;
+        }
+    }
+    return best;
+}
+
+int64_t measure_wall_offset() {
+    struct timespec rt;
+    uint64_t raw0 = TscClock::monotonic_raw_ns();
+    clock_gettime(CLOCK_REALTIME, &rt);
+    uint64_t raw1 = TscClock::monotonic_raw_ns();
+
+    int64_t wall = static_cast<int64_t>(rt.tv_sec) * 1000000000LL + rt.tv_nsec;
+    return wall - static_cast<int64_t>(raw0 + (raw1 - raw0) / 2);
+}
+
+} // namespace
+
+TscClock::State::State()
+    : use_tsc(false),
+      seq(0),
+      base_ticks(0),
+      base_ns(0),
+      mult(1ULL << SHIFT),
+      wall_offset_ns(0),
+      calibrator_running(false) {
+
+    use_tsc = is_tsc_invariant();
+    wall_offset_ns.store(measure_wall_offset(), std::memory_order_relaxed);
+
+    if (!use_tsc) {
+        // Ticks are already nanoseconds: identity conversion
+        return;
+    }
+
+    ClockPair start = sample_pair();
+    std::this_thread::sleep_for(std::chrono::milliseconds(INITIAL_CALIBRATION_MS));
+    ClockPair end = sample_pair();
+
+    uint64_t dticks = end.ticks - start.ticks;
+    uint64_t dns = end.ns - start.ns;
+    if (dticks == 0) {
+        use_tsc = false;
+        return;
+    }
+
+    base_ticks.store(end.ticks, std::memory_order_relaxed);
+    base_ns.store(end.ns, std::memory_order_relaxed);
+    mult.store(static_cast<uint64_t>((static_cast<unsigned __int128>(dns) << SHIFT) / dticks),
+               std::memory_order_relaxed);
+}
+
+TscClock::State::~State() {
+    calibrator_running.store(false, std::memory_order_release);
+    if (calibrator.joinable()) {
+        calibrator.join();
+    }
+}
+
+TscClock::Params TscClock::load_params() {
+    const State& s = state();
+    Params p;
+    uint64_t seq1, seq2;
+    do {
+        seq1 = s.seq.load(std::memory_order_acquire);
+        p.base_ticks = s.base_ticks.load(std::memory_order_relaxed);
+        p.base_ns = s.base_ns.load(std::memory_order_relaxed);
+        p.mult = s.mult.load(std::memory_order_relaxed);
+        p.wall_offset_ns = s.wall_offset_ns.load(std::memory_order_relaxed);
+        // Keeps the parameter loads above from moving past the re-check
+        std::atomic_thread_fence(std::memory_order_acquire);
+        seq2 = s.seq.load(std::memory_order_relaxed);
+    } while ((seq1 & 1) || seq1 != seq2);
+    return p;
+}
+
+void TscClock::store_params(const Params& p) {
+    // Seqlock write (caller holds write_mutex): odd while parameters are
+    // inconsistent; the fence keeps the stores below from becoming visible
+    // before the odd sequence
+    State& s = state();
+    uint64_t seq = s.seq.load(std::memory_order_relaxed);
+    s.seq.store(seq + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    s.base_ticks.store(p.base_ticks, std::memory_order_relaxed);
+    s.base_ns.store(p.base_ns, std::memory_order_relaxed);
+    s.mult.store(p.mult, std::memory_order_relaxed);
+    s.wall_offset_ns.store(p.wall_offset_ns, std::memory_order_relaxed);
+    s.seq.store(seq + 2, std::memory_order_release);
+}
+
+uint64_t TscClock::convert(const Params& p, uint64_t ticks) {
+    // Ticks taken before the current base (e.g. stored before a recalibration)
+    // are converted backwards from the base
+    if (ticks >= p.base_ticks) {
+        return p.base_ns + static_cast<uint64_t>(
+            (static_cast<unsigned __int128>(ticks - p.base_ticks) * p.mult) >> SHIFT);
+    }
+    return p.base_ns - static_cast<uint64_t>(
+        (static_cast<unsigned __int128>(p.base_ticks - ticks) * p.mult) >> SHIFT);
+}
+
+uint64_t TscClock::to_ns(uint64_t ticks) {
+    if (!state().use_tsc) {
+        return ticks;
+    }
+    return convert(load_params(), ticks);
+}
+
+uint64_t TscClock::to_wall_ns(uint64_t ticks) {
+    Params p = load_params();
+    uint64_t ns = state().use_tsc ? convert(p, ticks) : ticks;
+    return static_cast<uint64_t>(static_cast<int64_t>(ns) + p.wall_offset_ns);
+}
+
+void TscClock::recalibrate(uint32_t sample_ms) {
+    State& s = state();
+    int64_t wall_offset = measure_wall_offset();
+    if (!s.use_tsc) {
+        std::scoped_lock lock(s.write_mutex);
+        Params p = load_params();
+        p.wall_offset_ns = wall_offset;
+        store_params(p);
+        return;
+    }
+
+    ClockPair start = sample_pair();
+    std::this_thread::sleep_for(std::chrono::milliseconds(sample_ms));
+    ClockPair end = sample_pair();
+
+    uint64_t dticks = end.ticks - start.ticks;
+    if (dticks == 0) {
+        return;
+    }
+    int64_t measured = static_cast<int64_t>(
+        (static_cast<unsigned __int128>(end.ns - start.ns) << SHIFT) / dticks);
+
+    std::scoped_lock lock(s.write_mutex);
+    Params old = load_params();
+
+    // The new line starts where the old one is now, so now_ns() does not
+    // step. The old line's offset from CLOCK_MONOTONIC_RAW is closed by
+    // running slightly fast or slow over the slew window instead.
+    int64_t error = static_cast<int64_t>(end.ns - convert(old, end.ticks));
+    int64_t max_error = SLEW_WINDOW_NS / 1000000 * MAX_SLEW_PPM;
+    error = std::clamp(error, -max_error, max_error);
+    int64_t slew = static_cast<int64_t>(
+        static_cast<__int128>(measured) * error / SLEW_WINDOW_NS);
+
+    Params next;
+    next.base_ticks = TscClock::rdtsc();
+    next.base_ns = convert(old, next.base_ticks);
+    next.mult = static_cast<uint64_t>(measured + slew);
+    next.wall_offset_ns = wall_offset;
+    store_params(next);
+}
+
+void TscClock::start_calibration_thread(uint32_t interval_ms) {
+    State& s = state();
+    if (s.calibrator_running.exchange(true)) {
+        return;
+    }
+
+    s.calibrator = std::thread([interval_ms] {
+        State& st = state();
+        // Sleep in short slices so stop is prompt
+        constexpr uint32_t SLICE_MS = 50;
+        while (st.calibrator_running.load(std::memory_order_acquire)) {
+            for (uint32_t waited = 0; waited < interval_ms &&
+                 st.calibrator_running.load(std::memory_order_acquire); waited += SLICE_MS) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(SLICE_MS));
+            }
+            if (st.calibrator_running.load(std::memory_order_acquire)) {
+                recalibrate();
+            }
+        }
+    });
+}
+
+void TscClock::stop_calibration_thread() {
+    State& s = state();
+    s.calibrator_running.store(false, std::memory_order_release);
+    if (s.calibrator.joinable()) {
+        s.calibrator.join();
+    }
+}
+
+bool TscClock::is_tsc_invariant() {
+#if MDFH_HAS_RDTSC
+    unsigned int eax, ebx, ecx, edx;
+    if (!__get_cpuid(0x80000000, &eax, &ebx, &ecx, &edx) || eax < 0x80000007) {
+        return false;
+    }
+    if (!__get_cpuid(0x80000007, &eax, &ebx, &ecx, &edx)) {
+        return false;
+    }
+    // CPUID.80000007H:EDX[8] = invariant TSC
+    return (edx & (1u << 8)) != 0;
+#else
+    return false;
+#endif
+}
+
+double TscClock::ticks_per_ns() {
+    const State& s = state();
+    if (!s.use_tsc) {
+        return 1.0;
+    }
+    return static_cast<double>(1ULL << SHIFT) /
+           static_cast<double>(s.mult.load(std::memory_order_relaxed));
+}
+
+} // namespace mdfh
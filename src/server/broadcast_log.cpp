@@ -0,0 +1,43 @@
+#include "server/broadcast_log.h"
+#include <cstring>
+
+namespace mdfh {
+
+namespace {
+
+size_t round_up_pow2(size_t n) {
+    size_t capacity = BroadcastLog::MIN_CAPACITY;
+    while (capacity < n) {
+        capacity <<= 1;
+    }
+    return capacity;
+}
+
+} // namespace
+
+BroadcastLog::BroadcastLog(size_t capacity_bytes)
+    : capacity_(round_up_pow2(capacity_bytes)),
+      mask_(capacity_ - 1),
+      segment_mask_(capacity_ / SEGMENTS - 1),
+      write_pos_(0) {
+    data_ = std::make_unique<uint8_t[]>(capacity_);
+}
+
+bool BroadcastLog::append(const void* msg, size_t len) {
+    if (len == 0 || len > MAX_MESSAGE_SIZE) {
+        return false;
+    }
+
+    uint64_t pos = next_message_pos(write_pos_);
+
+    // Announce the overwrite before touching the bytes, so a reader that
+    // races with the copy sees its range invalidated (pairs with is_valid)
+    written_.store(pos + len, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    std::memcpy(data_.get() + (pos & mask_), msg, len);
+    write_pos_ = pos + len;
+    return true;
+}
+
+} // namespace mdfh
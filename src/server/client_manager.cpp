@@ -79,12 +79,12 @@ size_t ClientManager::get_client_count() const {
     return clients_.size();
 }
 
-void ClientManager::subscribe(int fd, const std::unordered_set<uint16_t>& symbol_ids) {
+void ClientManager::subscribe(int fd, const std::unordered_set<SymbolId>& symbol_ids) {
     std::scoped_lock lock(mutex_);
     subscriptions_[fd] = symbol_ids;
 }
 
-void ClientManager::unsubscribe(int fd, uint16_t symbol_id) {
+void ClientManager::unsubscribe(int fd, SymbolId symbol_id) {
     std::scoped_lock lock(mutex_);
     auto it = subscriptions_.find(fd);
     if (it != subscriptions_.end()) {
@@ -97,7 +97,7 @@ void ClientManager::clear_subscriptions(int fd) {
     subscriptions_.erase(fd);
 }
 
-bool ClientManager::is_subscribed(int fd, uint16_t symbol_id) const {
+bool ClientManager::is_subscribed(int fd, SymbolId symbol_id) const {
     std::scoped_lock lock(mutex_);
     auto it = subscriptions_.find(fd);
     if (it == subscriptions_.end()) {
@@ -115,7 +115,7 @@ size_t ClientManager::get_subscription_count(int fd) const {
     return it->second.size();
 }
 
-std::vector<int> ClientManager::get_subscribed_clients(uint16_t symbol_id) const {
+std::vector<int> ClientManager::get_subscribed_clients(SymbolId symbol_id) const {
     std::scoped_lock lock(mutex_);
     std::vector<int> result;
     
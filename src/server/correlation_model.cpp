@@ -0,0 +1,198 @@
+#include "server/correlation_model.h"
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#if defined(__AVX2__) && defined(__FMA__)
+#include <immintrin.h>
+#endif
+
+namespace mdfh {
+
+namespace {
+
+size_t round_up(size_t n) {
+    constexpr size_t w = CorrelationModel::SIMD_WIDTH;
+    return (n + w - 1) / w * w;
+}
+
+// a . b over n doubles, n a multiple of SIMD_WIDTH
+inline double dot(const double* a, const double* b, size_t n) {
+#if defined(__AVX2__) && defined(__FMA__)
+    __m256d acc0 = _mm256_setzero_pd();
+    __m256d acc1 = _mm256_setzero_pd();
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        acc0 = _mm256_fmadd_pd(_mm256_loadu_pd(a + i), _mm256_loadu_pd(b + i), acc0);
+        acc1 = _mm256_fmadd_pd(_mm256_loadu_pd(a + i + 4), _mm256_loadu_pd(b + i + 4), acc1);
+    }
+    if (i < n) {
+        acc0 = _mm256_fmadd_pd(_mm256_loadu_pd(a + i), _mm256_loadu_pd(b + i), acc0);
+    }
+    __m256d acc = _mm256_add_pd(acc0, acc1);
+    __m128d sum = _mm_add_pd(_mm256_castpd256_pd128(acc), _mm256_extractf128_pd(acc, 1));
+    return _mm_cvtsd_f64(_mm_add_sd(sum, _mm_unpackhi_pd(sum, sum)));
+#else
+    double acc[CorrelationModel::SIMD_WIDTH] = {};
+    for (size_t i = 0; i < n; i += CorrelationModel::SIMD_WIDTH) {
+        for (size_t j = 0; j < CorrelationModel::SIMD_WIDTH; ++j) {
+            acc[j] += a[i + j] * b[i + j];
+        }
+    }
+    return (acc[0] + acc[2]) + (acc[1] + acc[3]);
+#endif
+}
+
+} // namespace
+
+CorrelationModel::CorrelationModel(Kind kind, size_t num_symbols, size_t num_factors, uint64_t seed)
+    : kind_(kind),
+      num_symbols_(num_symbols),
+      num_factors_(num_factors),
+      row_offsets_(num_symbols + 1, 0),
+      rng_(seed, RngStream::CORRELATION, 0) {
+    for (size_t i = 0; i < num_symbols; ++i) {
+        size_t len = kind == Kind::FULL ? round_up(i + 1) : round_up(num_factors);
+        row_offsets_[i + 1] = row_offsets_[i] + len;
+    }
+    rows_.assign(row_offsets_[num_symbols], 0.0);
+    // FULL: n normals; FACTOR: k common (padded) then n idiosyncratic
+    normals_.assign(kind == Kind::FULL ? round_up(num_symbols) : round_up(num_factors) + num_symbols, 0.0);
+}
+
+CorrelationModel CorrelationModel::full(size_t num_symbols, const std::vector<double>& correlation,
+                                        uint64_t seed) {
+    if (correlation.size() != num_symbols * num_symbols) {
+        throw std::invalid_argument("CorrelationModel: correlation matrix must be n x n");
+    }
+    CorrelationModel model(Kind::FULL, num_symbols, 0, seed);
+
+    // Cholesky-Banachiewicz into the packed rows: L[i][j] for j <= i
+    for (size_t i = 0; i < num_symbols; ++i) {
+        double* li = &model.rows_[model.row_offsets_[i]];
+        for (size_t j = 0; j <= i; ++j) {
+            const double* lj = &model.rows_[model.row_offsets_[j]];
+            double c = correlation[i * num_symbols + j];
+            if (std::fabs(c - correlation[j * num_symbols + i]) > 1e-9) {
+                throw std::invalid_argument("CorrelationModel: correlation matrix is not symmetric");
+            }
+            double sum = c;
+            for (size_t m = 0; m < j; ++m) {
+                sum -= li[m] * lj[m];
+            }
+            if (i == j) {
+                if (!(sum > 1e-12)) {
+                    throw std::invalid_argument("CorrelationModel: correlation matrix is not positive definite");
+                }
+                li[i] = std::sqrt(sum);
+            } else {
+                li[j] = sum / lj[j];
+            }
+        }
+    }
+    return model;
+}
+
+CorrelationModel CorrelationModel::factor(size_t num_symbols, size_t num_factors,
+                                          const std::vector<double>& loadings, uint64_t seed) {
+    if (loadings.size() != num_symbols * num_factors) {
+        throw std::invalid_argument("CorrelationModel: loadings must be n x k");
+    }
+    CorrelationModel model(Kind::FACTOR, num_symbols, num_factors, seed);
+    model.idio_.resize(num_symbols);
+
+    for (size_t i = 0; i < num_symbols; ++i) {
+        double* row = &model.rows_[model.row_offsets_[i]];
+        double explained = 0.0;
+        for (size_t f = 0; f < num_factors; ++f) {
+            row[f] = loadings[i * num_factors + f];
+            explained += row[f] * row[f];
+        }
+        if (explained > 1.0 + 1e-9) {
+            throw std::invalid_argument("CorrelationModel: loadings of symbol " + std::to_string(i) +
+                                        " explain more than its variance");
+        }
+        model.idio_[i] = std::sqrt(std::max(0.0, 1.0 - explained));
+    }
+    return model;
+}
+
+CorrelationModel CorrelationModel::load(const std::string& file, Kind kind, size_t num_symbols,
+                                        uint64_t seed) {
+    return load(file, kind, SymbolMap(num_symbols), seed);
+}
+
+CorrelationModel CorrelationModel::load(const std::string& file, Kind kind, const SymbolMap& symbols,
+                                        uint64_t seed) {
+    const size_t num_symbols = symbols.size();
+    std::ifstream in(file);
+    if (!in.is_open()) {
+        throw std::runtime_error("Correlation file not found: " + file);
+    }
+
+    // Header: symbol_id,<one column per symbol or factor>
+    std::string line;
+    std::getline(in, line);
+    size_t columns = static_cast<size_t>(std::count(line.begin(), line.end(), ','));
+    if (columns == 0) {
+        throw std::runtime_error("Correlation file has no value columns: " + file);
+    }
+    if (kind == Kind::FULL && columns != num_symbols) {
+        throw std::runtime_error("Correlation matrix in " + file + " has " + std::to_string(columns) +
+                                 " columns, expected " + std::to_string(num_symbols));
+    }
+
+    // Unlisted symbols: unit diagonal (FULL) or zero loadings (FACTOR)
+    std::vector<double> values(num_symbols * columns, 0.0);
+    if (kind == Kind::FULL) {
+        for (size_t i = 0; i < num_symbols; ++i) values[i * columns + i] = 1.0;
+    }
+
+    size_t line_no = 1;
+    while (std::getline(in, line)) {
+        line_no++;
+        if (line.empty() || line == "\r") continue;
+        std::istringstream iss(line);
+        unsigned long long symbol_id;
+        if (!(iss >> symbol_id) || symbol_id > SymbolMap::MAX_ID) {
+            throw std::runtime_error("Bad symbol id in " + file + " line " + std::to_string(line_no));
+        }
+        uint32_t row = symbols.slot(static_cast<SymbolId>(symbol_id));
+        if (row == SymbolMap::NO_SLOT) {
+            continue;  // Not in the universe
+        }
+        for (size_t c = 0; c < columns; ++c) {
+            if (!(iss.ignore() && iss >> values[static_cast<size_t>(row) * columns + c])) {
+                throw std::runtime_error("Missing value in " + file + " line " + std::to_string(line_no));
+            }
+        }
+    }
+
+    return kind == Kind::FULL ? full(num_symbols, values, seed)
+                              : factor(num_symbols, columns, values, seed);
+}
+
+void CorrelationModel::draw(double* out) {
+    const double* rows = rows_.data();
+    double* z = normals_.data();
+
+    if (kind_ == Kind::FULL) {
+        rng_.fill_normal(z, num_symbols_);
+        for (size_t i = 0; i < num_symbols_; ++i) {
+            size_t begin = row_offsets_[i];
+            // Row i is zero past column i, and so is z past n
+            out[i] = dot(rows + begin, z, row_offsets_[i + 1] - begin);
+        }
+    } else {
+        size_t k = round_up(num_factors_);
+        rng_.fill_normal(z, num_factors_);
+        double* idio = z + k;
+        rng_.fill_normal(idio, num_symbols_);
+        for (size_t i = 0; i < num_symbols_; ++i) {
+            out[i] = dot(rows + i * k, z, k) + idio_[i] * idio[i];
+        }
+    }
+}
+
+} // namespace mdfh
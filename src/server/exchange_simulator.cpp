@@ -2,9 +2,10 @@
 #include "server/tick_generator.h"
 #include "common/protocol.h"
 #include "common/config_parser.h"
-#include <iostream>
-#include <fstream>
-#include <sstream>
+#include "common/symbol_universe.h"
+#include "common/logger.h"
+#include "common/tsc_clock.h"
+#include "common/trace.h"
 #include <cstring>
 #include <unistd.h>
 #include <fcntl.h>
@@ -14,11 +15,17 @@
 #include <arpa/inet.h>
 #include <chrono>
 #include <random>
+#include <algorithm>
+#include <cmath>
+#include <unordered_set>
 
 namespace mdfh {
 
 // Global config file path with default value
 static constexpr const char* DEFAULT_CONFIG_FILE = "config/server.conf";
+#ifdef MDFH_TRACING
+static constexpr const char* TRACE_OUTPUT_FILE = "mdfh_server_trace.json";
+#endif
 
 ExchangeSimulator::ExchangeSimulator(uint16_t port, size_t num_symbols)
     : port_(port),
@@ -28,10 +35,18 @@ ExchangeSimulator::ExchangeSimulator(uint16_t port, size_t num_symbols)
       running_(false),
       tick_rate_(100000),
       fault_injection_enabled_(false),
-      loaded_symbols_count_(0) {
+      broadcast_log_size_(DEFAULT_BROADCAST_LOG_SIZE),
+      heartbeat_interval_ms_(DEFAULT_HEARTBEAT_INTERVAL_MS),
+      num_reactors_(0),
+      next_reactor_(0) {
     
     load_config(DEFAULT_CONFIG_FILE);
     initialize_symbols();
+    initialize_arrivals();
+    initialize_scenario();
+    initialize_correlation();
+    initialize_matching();
+    broadcast_log_ = std::make_unique<BroadcastLog>(broadcast_log_size_);
 }
 
 #ifdef TESTING
@@ -43,10 +58,18 @@ ExchangeSimulator::ExchangeSimulator(uint16_t port, size_t num_symbols, const st
       running_(false),
       tick_rate_(100000),
       fault_injection_enabled_(false),
-      loaded_symbols_count_(0) {
+      broadcast_log_size_(DEFAULT_BROADCAST_LOG_SIZE),
+      heartbeat_interval_ms_(DEFAULT_HEARTBEAT_INTERVAL_MS),
+      num_reactors_(0),
+      next_reactor_(0) {
     
     load_config(config_file);
     initialize_symbols();
+    initialize_arrivals();
+    initialize_scenario();
+    initialize_correlation();
+    initialize_matching();
+    broadcast_log_ = std::make_unique<BroadcastLog>(broadcast_log_size_);
 }
 #endif
 
@@ -64,18 +87,65 @@ void ExchangeSimulator::load_config(const std::string& config_file) {
         tick_rate_ = config.get_int("market.tick_rate", 100000);
         symbols_file_ = config.get_string("market.symbols_file", "config/symbols.csv");
         fault_injection_enabled_ = config.get_bool("fault_injection.enabled", false);
+        fault_config_.sequence_gap = config.get_double("fault_injection.sequence_gap", fault_config_.sequence_gap);
+        fault_config_.fragment = config.get_double("fault_injection.fragment", fault_config_.fragment);
+        fault_config_.delay = config.get_double("fault_injection.delay", fault_config_.delay);
+        fault_config_.corrupt = config.get_double("fault_injection.corrupt", fault_config_.corrupt);
+        fault_config_.duplicate = config.get_double("fault_injection.duplicate", fault_config_.duplicate);
+        fault_config_.reorder = config.get_double("fault_injection.reorder", fault_config_.reorder);
+        fault_config_.disconnect = config.get_double("fault_injection.disconnect", fault_config_.disconnect);
+        fault_config_.squeeze = config.get_double("fault_injection.squeeze", fault_config_.squeeze);
+        fault_config_.delay_us = config.get_int("fault_injection.delay_us", fault_config_.delay_us);
+        fault_config_.reorder_us = config.get_int("fault_injection.reorder_us", fault_config_.reorder_us);
+        fault_config_.squeeze_bytes = config.get_int("fault_injection.squeeze_bytes", fault_config_.squeeze_bytes);
+        fault_config_.squeeze_ms = config.get_int("fault_injection.squeeze_ms", fault_config_.squeeze_ms);
+        num_reactors_ = config.get_int("server.num_reactors", 0);
+        broadcast_log_size_ = static_cast<size_t>(
+            config.get_int("server.broadcast_log_mb", DEFAULT_BROADCAST_LOG_SIZE >> 20)) << 20;
+        heartbeat_interval_ms_ = config.get_int("server.heartbeat_interval_ms", DEFAULT_HEARTBEAT_INTERVAL_MS);
+        line_b_port_ = static_cast<uint16_t>(config.get_int("server.line_b_port", 0));
+        order_port_ = static_cast<uint16_t>(config.get_int("server.order_port", 0));
+        
+        matching_enabled_ = config.get_string("market.mode", "gbm") == "matching";
+        correlation_mode_ = config.get_string("market.correlation", "none");
+        correlation_file_ = config.get_string("market.correlation_file", "");
+        arrivals_mode_ = config.get_string("market.arrivals", "uniform");
+        rate_skew_ = config.get_double("market.rate_skew", 0.0);
+        scenario_file_ = config.get_string("market.scenario_file", "");
+        seed_ = static_cast<uint64_t>(config.get_int("market.seed", 0));
+        tick_size_ = config.get_double("matching.tick_size", 0.01);
+        price_levels_ = config.get_int("matching.price_levels", OrderBook::DEFAULT_LEVELS);
+        flow_config_.limit_ratio = config.get_double("matching.limit_ratio", flow_config_.limit_ratio);
+        flow_config_.market_ratio = config.get_double("matching.market_ratio", flow_config_.market_ratio);
+        flow_config_.cancel_ratio = config.get_double("matching.cancel_ratio", flow_config_.cancel_ratio);
+        flow_config_.aggressive_ratio = config.get_double("matching.aggressive_ratio", flow_config_.aggressive_ratio);
+        flow_config_.max_depth_ticks = config.get_int("matching.max_depth_ticks", flow_config_.max_depth_ticks);
+        flow_config_.lot_size = config.get_int("matching.lot_size", flow_config_.lot_size);
+        flow_config_.max_lots = config.get_int("matching.max_lots", flow_config_.max_lots);
+        flow_config_.max_live_orders = config.get_int("matching.max_live_orders", flow_config_.max_live_orders);
+        if (tick_size_ <= 0.0) {
+            tick_size_ = 0.01;
+        }
     } else {
         // Use default values
         symbols_file_ = "config/symbols.csv";
-        std::cout << "Warning: Config file not found, using defaults" << std::endl;
+        MDFH_LOG_WARN("Config file not found, using defaults");
+    }
+    
+    if (seed_ == 0) {
+        std::random_device rd;
+        seed_ = static_cast<uint64_t>(rd()) << 32 | rd();
     }
     
-    std::cout << "Exchange Simulator Configuration:" << std::endl;
-    std::cout << "  Port: " << port_ << std::endl;
-    std::cout << "  Symbols: " << num_symbols_ << std::endl;
-    std::cout << "  Tick Rate: " << tick_rate_ << " msgs/sec" << std::endl;
-    std::cout << "  Symbols File: " << symbols_file_ << std::endl;
-    std::cout << "  Fault Injection: " << (fault_injection_enabled_ ? "enabled" : "disabled") << std::endl;
+    MDFH_LOG_INFO("Exchange Simulator Configuration: port={} symbols={} tick_rate={} msgs/sec",
+                  port_, num_symbols_, tick_rate_.load());
+    MDFH_LOG_INFO("  Symbols File: {}", symbols_file_);
+    MDFH_LOG_INFO("  Fault Injection: {}", fault_injection_enabled_ ? "enabled" : "disabled");
+    MDFH_LOG_INFO("  Random Seed: {} (market.seed reproduces this run)", seed_);
+    if (matching_enabled_) {
+        MDFH_LOG_INFO("  Market Mode: matching engine (tick size {}, {} price levels)",
+                      tick_size_, price_levels_);
+    }
 }
 
 ExchangeSimulator::~ExchangeSimulator() {
@@ -83,112 +153,392 @@ ExchangeSimulator::~ExchangeSimulator() {
 }
 
 void ExchangeSimulator::initialize_symbols() {
-    std::ifstream file(symbols_file_);
-    if (!file.is_open()) {
-        throw std::runtime_error("Symbol file not found: " + symbols_file_);
-    }
-    
-    // Skip header row
-    std::string header;
-    std::getline(file, header);
+    // CSV or binary universe, mapped and parsed in one pass
+    SymbolUniverse universe = SymbolUniverse::load(symbols_file_);
     
+    // Ids below num_symbols may be sparse; state is kept per loaded symbol
     symbols_.clear();
-    symbols_.resize(num_symbols_); // Pre-allocate to ensure correct indexing
-    loaded_symbols_.clear();
-    std::string line;
-    size_t loaded_count = 0;
-    
-    while (std::getline(file, line)) {
-        std::istringstream iss(line);
-        uint16_t symbol_id;
-        std::string symbol_name;
-        double price, volatility, drift;
-        
-        // Read: symbol_id,symbol,price,volatility,drift
-        if ((iss >> symbol_id) && iss.ignore() &&
-            std::getline(iss, symbol_name, ',') &&
-            (iss >> price) && iss.ignore() &&
-            (iss >> volatility) && iss.ignore() &&
-            (iss >> drift)) {
-            
-            // Validate symbol_id
-            if (symbol_id >= num_symbols_) {
-                std::cerr << "Warning: Symbol ID " << symbol_id 
-                          << " exceeds max symbols " << num_symbols_ 
-                          << ", skipping" << std::endl;
-                continue;
-            }
-            
-            SymbolState sym;
-            sym.symbol_id = symbol_id;
-            sym.symbol_name = symbol_name;
-            sym.current_price = price;
-            sym.volatility = volatility;
-            sym.drift = drift;
-            sym.seq_num = 0;
-            sym.ticks_since_price_update = 0;
-            
-            symbols_[symbol_id] = sym;
-            loaded_symbols_.push_back(sym);  // Also store in compact array for testing
-            loaded_count++;
+    symbols_.reserve(std::min(universe.size(), num_symbols_));
+    std::vector<SymbolId> ids;
+    ids.reserve(symbols_.capacity());
+    std::unordered_set<SymbolId> seen;
+    seen.reserve(symbols_.capacity());
+    size_t over_limit = 0;
+    size_t duplicates = 0;
+    
+    for (const SymbolRecord& record : universe) {
+        // One summary below rather than a line per row of a large universe.
+        // Any SymbolId is accepted; num_symbols caps how many are loaded.
+        if (symbols_.size() == num_symbols_) {
+            over_limit++;
+            continue;
         }
+        if (!seen.insert(record.symbol_id).second) {
+            duplicates++;  // First row for an id wins
+            continue;
+        }
+        
+        SymbolState sym;
+        sym.symbol_id = record.symbol_id;
+        sym.symbol_name = std::string(universe.name(record));
+        sym.current_price = record.price;
+        sym.volatility = record.volatility;
+        sym.drift = record.drift;
+        sym.seq_num = 0;
+        sym.ticks_since_price_update = 0;
+        sym.tick_weight = record.weight;
+        
+        symbols_.push_back(std::move(sym));
+        ids.push_back(record.symbol_id);
     }
     
-    if (loaded_count == 0) {
+    if (over_limit > 0) {
+        MDFH_LOG_WARN("{} symbols past the first {} (market.num_symbols) skipped", over_limit, num_symbols_);
+    }
+    if (duplicates > 0) {
+        MDFH_LOG_WARN("{} rows with a duplicate symbol ID skipped", duplicates);
+    }
+    if (universe.get_skipped_rows() > 0) {
+        MDFH_LOG_WARN("{} malformed rows skipped in {}", universe.get_skipped_rows(), symbols_file_);
+    }
+    if (symbols_.empty()) {
         throw std::runtime_error("No symbols loaded from file: " + symbols_file_);
     }
+    symbol_map_ = SymbolMap(ids);
+    
+    // One independent stream per symbol and purpose, keyed by symbol id so
+    // a symbol's ticks do not depend on which other symbols are loaded
+    tick_generators_.clear();
+    fault_rngs_.clear();
+    tick_generators_.reserve(symbols_.size());
+    fault_rngs_.reserve(symbols_.size());
+    for (const auto& symbol : symbols_) {
+        tick_generators_.emplace_back(seed_, symbol.symbol_id);
+        fault_rngs_.emplace_back(seed_, RngStream::FAULTS, symbol.symbol_id);
+    }
     
-    loaded_symbols_count_ = loaded_count;
-    std::cout << "Loaded " << loaded_count << " symbols from " << symbols_file_ << std::endl;
+    MDFH_LOG_INFO("Loaded {} symbols from {} ({} KB id map)", symbols_.size(), symbols_file_,
+                  symbol_map_.memory_bytes() / 1024);
 }
 
-void ExchangeSimulator::start() {
+void ExchangeSimulator::initialize_arrivals() {
+    arrival_wheel_.reset();
+    arrival_rngs_.clear();
+    next_arrival_us_.clear();
+    arrival_rate_ = 0;
+    
+    // Uniform: every loaded symbol gets the same share, in turn
+    for (auto& symbol : symbols_) {
+        symbol.rate_share = 1.0 / static_cast<double>(symbols_.size());
+    }
+    if (arrivals_mode_ == "uniform") {
+        return;
+    }
+    if (arrivals_mode_ != "poisson") {
+        throw std::runtime_error("Unknown market.arrivals: " + arrivals_mode_);
+    }
+    
+    // A weight column sets the relative intensity; otherwise the rank in
+    // the symbols file, which is the slot, does (Zipf: 1 / rank^skew)
+    std::vector<double> weights(symbols_.size());
+    double total = 0.0;
+    for (size_t rank = 0; rank < symbols_.size(); ++rank) {
+        double weight = symbols_[rank].tick_weight;
+        if (weight <= 0.0) {
+            weight = 1.0 / std::pow(static_cast<double>(rank + 1), rate_skew_);
+        }
+        weights[rank] = weight;
+        total += weight;
+    }
+    for (size_t rank = 0; rank < symbols_.size(); ++rank) {
+        symbols_[rank].rate_share = weights[rank] / total;
+    }
+    
+    // Timers are slots, so the wheel is sized by the symbols loaded
+    arrival_wheel_ = std::make_unique<TimingWheel>(symbols_.size());
+    arrival_rngs_.reserve(symbols_.size());
+    for (const auto& symbol : symbols_) {
+        arrival_rngs_.emplace_back(seed_, RngStream::ARRIVALS, symbol.symbol_id);
+    }
+    next_arrival_us_.assign(symbols_.size(), 0.0);
+    
+    double hottest = 0.0;
+    for (const auto& symbol : symbols_) {
+        hottest = std::max(hottest, symbol.rate_share);
+    }
+    MDFH_LOG_INFO("  Poisson arrivals: skew {} (hottest symbol {}% of ticks)",
+                  rate_skew_, std::round(hottest * 1000.0) / 10.0);
+}
+
+void ExchangeSimulator::schedule_arrivals(uint32_t rate, uint64_t now_us) {
+    arrival_rate_ = rate;
+    arrival_wheel_->clear(now_us);
+    if (rate == 0) {
+        return;
+    }
+    // Exponential gaps are memoryless, so a fresh draw from now is exact
+    for (uint32_t slot = 0; slot < symbols_.size(); ++slot) {
+        next_arrival_us_[slot] = static_cast<double>(now_us);
+        schedule_next_arrival(slot);
+    }
+}
+
+void ExchangeSimulator::schedule_next_arrival(uint32_t slot) {
+    const auto& symbol = symbols_[slot];
+    double per_us = arrival_rate_ * market_rate_multiplier_ * symbol.rate_multiplier *
+                    symbol.rate_share * 1e-6;
+    if (per_us <= 0.0 || symbol.halted) {
+        arrival_wheel_->cancel(slot);
+        return;
+    }
+    double& next = next_arrival_us_[slot];
+    next -= std::log(arrival_rngs_[slot].uniform()) / per_us;
+    // More than one arrival per microsecond fires on consecutive ticks
+    // until the timer catches up with the exact time
+    arrival_wheel_->schedule(slot, static_cast<uint64_t>(std::ceil(next)));
+}
+
+void ExchangeSimulator::initialize_scenario() {
+    scenario_.reset();
+    scenario_origin_us_ = UINT64_MAX;
+    market_rate_multiplier_ = 1.0;
+    market_volatility_multiplier_ = 1.0;
+    for (auto& symbol : symbols_) {
+        symbol.rate_multiplier = 1.0;
+        symbol.volatility_multiplier = 1.0;
+        symbol.halted = false;
+    }
+    if (scenario_file_.empty()) {
+        return;
+    }
+    
+    scenario_ = std::make_unique<Scenario>(
+        Scenario::load(scenario_file_, static_cast<size_t>(SymbolMap::MAX_ID) + 1));
+    MDFH_LOG_INFO("  Scenario: {} events over {} ms from {}", scenario_->get_events().size(),
+                  scenario_->get_duration_us() / 1000, scenario_file_);
+    if (!arrival_wheel_) {
+        MDFH_LOG_WARN("  Scenario events apply once per second with uniform arrivals "
+                      "(market.arrivals = poisson applies them on time)");
+    }
+}
+
+void ExchangeSimulator::apply_due_scenario_events(uint64_t now_us) {
+    if (!scenario_) {
+        return;
+    }
+    if (scenario_origin_us_ == UINT64_MAX) {
+        scenario_origin_us_ = now_us;
+    }
+    uint64_t elapsed = now_us > scenario_origin_us_ ? now_us - scenario_origin_us_ : 0;
+    while (const ScenarioEvent* event = scenario_->pop_due(elapsed)) {
+        apply_scenario_event(*event, now_us);
+    }
+}
+
+void ExchangeSimulator::apply_scenario_event(const ScenarioEvent& event, uint64_t now_us) {
+    auto apply = [&](SymbolState& symbol) {
+        switch (event.action) {
+            case ScenarioAction::RATE: symbol.rate_multiplier = event.value; break;
+            case ScenarioAction::VOLATILITY: symbol.volatility_multiplier = event.value; break;
+            case ScenarioAction::HALT: symbol.halted = true; break;
+            case ScenarioAction::RESUME: symbol.halted = false; break;
+        }
+    };
+    
+    bool all = event.symbol_id == Scenario::ALL_SYMBOLS;
+    uint32_t slot = all ? SymbolMap::NO_SLOT : symbol_map_.slot(static_cast<SymbolId>(event.symbol_id));
+    if (!all && slot == SymbolMap::NO_SLOT) {
+        return;  // Not in the symbols file
+    }
+    if (all && event.action == ScenarioAction::RATE) {
+        market_rate_multiplier_ = event.value;
+    } else if (all && event.action == ScenarioAction::VOLATILITY) {
+        market_volatility_multiplier_ = event.value;
+    } else if (all) {
+        for (auto& symbol : symbols_) {
+            apply(symbol);
+        }
+    } else {
+        apply(symbols_[slot]);
+    }
+    
+    // Volatility leaves the schedule alone; the rest changes arrival rates
+    if (!arrival_wheel_ || arrival_rate_ == 0 || event.action == ScenarioAction::VOLATILITY) {
+        return;
+    }
+    auto redraw = [&](uint32_t redraw_slot) {
+        next_arrival_us_[redraw_slot] = static_cast<double>(now_us);
+        schedule_next_arrival(redraw_slot);
+    };
+    if (all) {
+        for (uint32_t i = 0; i < symbols_.size(); ++i) {
+            redraw(i);
+        }
+    } else {
+        redraw(slot);
+    }
+}
+
+void ExchangeSimulator::initialize_correlation() {
+    correlation_.reset();
+    if (correlation_mode_ == "none") {
+        return;
+    }
+    
+    CorrelationModel::Kind kind;
+    if (correlation_mode_ == "matrix") {
+        kind = CorrelationModel::Kind::FULL;
+    } else if (correlation_mode_ == "factor") {
+        kind = CorrelationModel::Kind::FACTOR;
+    } else {
+        throw std::runtime_error("Unknown market.correlation: " + correlation_mode_);
+    }
+    
+    correlation_ = std::make_unique<CorrelationModel>(
+        CorrelationModel::load(correlation_file_, kind, symbol_map_, seed_));
+    shocks_.assign(symbols_.size(), 0.0);
+    MDFH_LOG_INFO("  Correlated prices: {} model from {} ({} factors)", correlation_mode_,
+                  correlation_file_, correlation_->get_num_factors());
+}
+
+void ExchangeSimulator::step_correlated_prices(double dt) {
+    // The model's rows are the loaded symbols' slots
+    correlation_->draw(shocks_.data());
+    for (size_t slot = 0; slot < symbols_.size(); ++slot) {
+        SymbolState& symbol = symbols_[slot];
+        double volatility = symbol.volatility * market_volatility_multiplier_ * symbol.volatility_multiplier;
+        symbol.current_price = TickGenerator::gbm_step(
+            symbol.current_price, symbol.drift, volatility, dt, shocks_[slot]);
+    }
+}
+
+uint32_t ExchangeSimulator::price_to_tick(double price) const {
+    long long tick = std::llround(price / tick_size_);
+    return static_cast<uint32_t>(std::max(tick, 1LL));
+}
+
+void ExchangeSimulator::initialize_matching() {
+    matching_.clear();
+    if (!matching_enabled_) {
+        return;
+    }
+    
+    matching_.resize(symbols_.size());
+    uint32_t seed_levels = std::min(SEED_DEPTH_LEVELS, flow_config_.max_depth_ticks);
+    uint32_t seed_quantity = flow_config_.lot_size * flow_config_.max_lots;
+    for (uint32_t slot = 0; slot < symbols_.size(); ++slot) {
+        const auto& symbol = symbols_[slot];
+        if (symbol.current_price <= 0.0) {
+            continue;  // No price to seed a book around
+        }
+        
+        auto& matching = matching_[slot];
+        uint32_t reference_tick = price_to_tick(symbol.current_price);
+        matching.book = std::make_unique<OrderBook>(reference_tick, price_levels_);
+        matching.flow = std::make_unique<OrderFlowGenerator>(
+            flow_config_, seed_, symbol.symbol_id);
+        
+        // Resting depth on both sides so the first quotes have a spread
+        for (uint32_t depth = 1; depth <= seed_levels; ++depth) {
+            if (reference_tick > depth) {
+                matching.flow->on_resting(
+                    matching.book->add_limit(Side::BUY, reference_tick - depth, seed_quantity, fills_));
+            }
+            matching.flow->on_resting(
+                matching.book->add_limit(Side::SELL, reference_tick + depth, seed_quantity, fills_));
+        }
+        matching.published = OrderBook::Top{OrderBook::NO_PRICE, OrderBook::NO_PRICE, 0, 0};
+    }
+    fills_.clear();
+    
+    MDFH_LOG_INFO("Matching engine: {} order books seeded with {} levels per side",
+                  symbols_.size(), seed_levels);
+}
+
+int ExchangeSimulator::open_listener(uint16_t port) {
     // Create socket
-    server_fd_ = socket(AF_INET, SOCK_STREAM, 0);
-    if (server_fd_ < 0) {
+    int fd = socket(AF_INET, SOCK_STREAM, 0);
+    if (fd < 0) {
         throw std::runtime_error("Failed to create socket");
     }
     
     // Set socket options
     int opt = 1;
-    setsockopt(server_fd_, SOL_SOCKET, SO_REUSEADDR, &opt, sizeof(opt));
+    setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &opt, sizeof(opt));
+    
+    // Non-blocking so the acceptor can drain a burst of connections per wakeup
+    int flags = fcntl(fd, F_GETFL, 0);
+    fcntl(fd, F_SETFL, flags | O_NONBLOCK);
     
     // Bind
     struct sockaddr_in addr{};
     addr.sin_family = AF_INET;
     addr.sin_addr.s_addr = INADDR_ANY;
-    addr.sin_port = htons(port_);
+    addr.sin_port = htons(port);
     
-    if (bind(server_fd_, (struct sockaddr*)&addr, sizeof(addr)) < 0) {
-        close(server_fd_);
+    if (bind(fd, (struct sockaddr*)&addr, sizeof(addr)) < 0) {
+        close(fd);
         throw std::runtime_error("Failed to bind socket");
     }
     
     // Listen
-    if (listen(server_fd_, MAX_CLIENTS) < 0) {
-        close(server_fd_);
+    if (listen(fd, MAX_CLIENTS) < 0) {
+        close(fd);
         throw std::runtime_error("Failed to listen on socket");
     }
     
+    // Add to epoll
+    struct epoll_event ev{};
+    ev.events = EPOLLIN; // Monitor for incoming connections
+    ev.data.fd = fd; // Associate with the listening socket
+    epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, fd, &ev); // Add socket to the epoll interest
+    return fd;
+}
+
+void ExchangeSimulator::start() {
     // Create epoll
     epoll_fd_ = epoll_create1(0);
     if (epoll_fd_ < 0) {
-        close(server_fd_);
         throw std::runtime_error("Failed to create epoll");
     }
     
-    // Add server fd to epoll
-    struct epoll_event ev{};
-    ev.events = EPOLLIN; // Monitor for incoming connections
-    ev.data.fd = server_fd_; // Associate with server socket
-    epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, server_fd_, &ev); // Add socket to the epoll interest
+    server_fd_ = open_listener(port_);
+    
+    // Line B: a second port carrying the identical stream from the same
+    // broadcast log, for clients that arbitrate between redundant lines
+    if (line_b_port_ != 0) {
+        line_b_fd_ = open_listener(line_b_port_);
+    }
+    
+    // Order entry: separate sessions on their own port and thread
+    if (order_port_ != 0) {
+        order_gateway_ = std::make_unique<OrderGateway>(order_port_, *this);
+        order_gateway_->start();
+    }
 
+    // Reactors own client sockets; the tick thread only appends to the log
+    size_t num_reactors = num_reactors_;
+    if (num_reactors == 0) {
+        // Leave a core for the tick thread and acceptor
+        unsigned int cores = std::thread::hardware_concurrency();
+        num_reactors = std::clamp<size_t>(cores > 1 ? cores - 1 : 1, 1, 4);
+    }
+    for (size_t i = 0; i < num_reactors; ++i) {
+        reactors_.push_back(std::make_unique<Reactor>(i, symbol_map_, *broadcast_log_, client_manager_,
+                                                      fault_injection_enabled_, fault_config_, seed_));
+        reactors_.back()->set_heartbeat_interval_ms(heartbeat_interval_ms_);
+        reactors_.back()->start();
+    }
+    
     running_ = true;
     
     // Start tick generation thread
     tick_thread_ = std::thread(&ExchangeSimulator::tick_generation_loop, this);
     
-    std::cout << "Exchange Simulator started on port " << port_ << std::endl;
+    MDFH_LOG_INFO("Exchange Simulator started on port {} with {} reactor(s)", port_, reactors_.size());
+    if (line_b_fd_ >= 0) {
+        MDFH_LOG_INFO("Line B listening on port {}", line_b_port_);
+    }
 }
 
 void ExchangeSimulator::run() {
@@ -196,71 +546,114 @@ void ExchangeSimulator::run() {
 
     while (running_) {
         int nfds = epoll_wait(epoll_fd_, events, MAX_EVENTS, 100); //// BLOCKS until events arrive or 100ms timeout
+        
+#ifdef MDFH_TRACING
+        // Dump requested via SIGUSR1
+        if (Tracer::instance().poll_dump(TRACE_OUTPUT_FILE)) {
+            MDFH_LOG_INFO("Trace written to {}", TRACE_OUTPUT_FILE);
+        }
+#endif
 
+        // Only the listener is registered here: client sockets, subscriptions
+        // and disconnects are handled by the reactor that owns each client
         for (int i = 0; i < nfds; ++i) {
-            if (events[i].data.fd == server_fd_)
-            { // Server socket is readable → new client connection
-                handle_new_connection();
-            }
-            else
-            {
-                // Handle client data or disconnection
-                if (events[i].events & (EPOLLHUP | EPOLLERR)) {
-                    handle_client_disconnect(events[i].data.fd);
-                }
-                else if (events[i].events & EPOLLIN) {
-                    // Client has data to read (subscription message)
-                    handle_client_data(events[i].data.fd);
-                }
+            if (events[i].data.fd == server_fd_ || events[i].data.fd == line_b_fd_) {
+                handle_new_connection(events[i].data.fd);
             }
         }
     }
 }
 
-void ExchangeSimulator::handle_new_connection() {
-    struct sockaddr_in client_addr{};
-    socklen_t addr_len = sizeof(client_addr);
+void ExchangeSimulator::handle_new_connection(int listen_fd) {
+    while (true) {
+        struct sockaddr_in client_addr{};
+        socklen_t addr_len = sizeof(client_addr);
 
-    // Accept the new client connection
-    int client_fd = accept(server_fd_, (struct sockaddr*)&client_addr, &addr_len);
-    if (client_fd < 0) {
-        return;
+        // Accept the new client connection
+        int client_fd = accept4(listen_fd, (struct sockaddr*)&client_addr, &addr_len, SOCK_NONBLOCK);
+        if (client_fd < 0) {
+            return;  // EAGAIN: backlog drained
+        }
+
+        // Set TCP_NODELAY (disable Nagle's algorithm for low latency)
+        int nodelay = 1;
+        setsockopt(client_fd, IPPROTO_TCP, TCP_NODELAY, &nodelay, sizeof(nodelay));
+        
+        // Registered before the hand-off so the client is visible immediately
+        client_manager_.add_client(client_fd);
+        
+        reactors_[next_reactor_]->add_client(client_fd);
+        next_reactor_ = (next_reactor_ + 1) % reactors_.size();
+        
+        MDFH_LOG_INFO("New client connected: {}", client_fd);
     }
+}
+
+void ExchangeSimulator::generate_tick(SymbolId symbol_id) {
+    uint32_t slot = symbol_map_.slot(symbol_id);
+    if (slot == SymbolMap::NO_SLOT) return;
     
-    // Set client socket non-blocking
-    int flags = fcntl(client_fd, F_GETFL, 0);
-    fcntl(client_fd, F_SETFL, flags | O_NONBLOCK);
+    std::scoped_lock lock(publish_mutex_);
+    encode_tick(slot);
+    publish();
+}
 
-    // Set TCP_NODELAY (disable Nagle's algorithm for low latency)
-    int nodelay = 1;
-    setsockopt(client_fd, IPPROTO_TCP, TCP_NODELAY, &nodelay, sizeof(nodelay));
+void ExchangeSimulator::generate_arrivals(uint64_t now_us) {
+    if (!arrival_wheel_) return;
     
-    // Add client socket to epoll
-    struct epoll_event ev{};
-    ev.events = EPOLLIN | EPOLLET; // Edge-triggered mode (notifies only on state changes, not continuous readiness)
-    ev.data.fd = client_fd;
-    epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, client_fd, &ev);
+    uint32_t rate = tick_rate_.load();
+    std::unique_lock lock(publish_mutex_);
+    if (rate != arrival_rate_) {
+        // Rate changed or paused: the pending arrivals were drawn for the old one
+        schedule_arrivals(rate, now_us);
+    }
     
-    client_manager_.add_client(client_fd);
+    if (rate == 0) {
+        return;
+    }
     
-    std::cout << "New client connected: " << client_fd << std::endl;
+    // Arrivals fire in time order across symbols and are committed in batches
+    size_t pending = 0;
+    auto fire_until = [&](uint64_t until_us) {
+        arrival_wheel_->advance(until_us, [&](uint32_t slot, uint64_t) {
+            encode_tick(slot);
+            schedule_next_arrival(slot);
+            if (++pending >= TICK_BATCH_SIZE) {
+                publish();
+                pending = 0;
+                lock.unlock();
+                lock.lock();
+            }
+        });
+    };
+    
+    // Scenario events take effect at their exact time on the arrival clock
+    if (scenario_) {
+        apply_due_scenario_events(arrival_wheel_->now());
+        while (scenario_->next_time_us() != UINT64_MAX &&
+               scenario_origin_us_ + scenario_->next_time_us() <= now_us) {
+            uint64_t at = scenario_origin_us_ + scenario_->next_time_us();
+            fire_until(at);
+            apply_due_scenario_events(at);
+        }
+    }
+    fire_until(now_us);
+    if (pending > 0) {
+        publish();
+    }
 }
 
-void ExchangeSimulator::handle_client_disconnect(int client_fd) {
-    epoll_ctl(epoll_fd_, EPOLL_CTL_DEL, client_fd, nullptr);
-    close(client_fd);
-    
-    client_manager_.remove_client(client_fd);
-    client_manager_.clear_subscriptions(client_fd);
-    
-    std::cout << "Client disconnected: " << client_fd << std::endl;
+void ExchangeSimulator::publish() {
+    broadcast_log_->commit();
+    for (auto& reactor : reactors_) {
+        reactor->notify();
+    }
 }
 
-void ExchangeSimulator::generate_tick(uint16_t symbol_id) {
-    if (symbol_id >= num_symbols_) return;
-    
-    TickGenerator gen;
-    auto& symbol = symbols_[symbol_id];
+void ExchangeSimulator::encode_tick(uint32_t slot) {
+    MDFH_TRACE_ZONE(TICK_GENERATE);
+    TickGenerator& gen = tick_generators_[slot];
+    auto& symbol = symbols_[slot];
     
     // Update underlying price only every 100 ticks in production
     // In testing mode, update every tick for predictable test behavior
@@ -269,136 +662,178 @@ void ExchangeSimulator::generate_tick(uint16_t symbol_id) {
 #else
     constexpr uint32_t PRICE_UPDATE_INTERVAL = 100;
 #endif
-    symbol.ticks_since_price_update++;
-    if (symbol.ticks_since_price_update >= PRICE_UPDATE_INTERVAL) {
-        // Calculate dt (time in seconds between price updates)
-        // dt = ticks_between_updates / ticks_per_second_per_symbol
-        // dt = PRICE_UPDATE_INTERVAL / (tick_rate / num_symbols)
-        // dt = PRICE_UPDATE_INTERVAL * num_symbols / tick_rate
-        uint32_t rate = tick_rate_.load();
-        double dt = (rate > 0) ? (static_cast<double>(PRICE_UPDATE_INTERVAL) * num_symbols_) / rate : 0.1;
-        
-        symbol.current_price = gen.generate_next_price(
-            symbol.current_price, symbol.drift, symbol.volatility, dt);
-        symbol.ticks_since_price_update = 0;
+    // dt is the time in seconds between price updates:
+    // dt = ticks_between_updates / ticks_per_second_per_symbol
+    if (correlation_) {
+        // Correlated paths advance together: one joint step per
+        // PRICE_UPDATE_INTERVAL ticks per symbol on average,
+        // dt = PRICE_UPDATE_INTERVAL * loaded symbols / tick_rate
+        const size_t loaded = symbols_.size();
+        if (++ticks_since_step_ >= PRICE_UPDATE_INTERVAL * loaded) {
+            double rate = tick_rate_.load() * market_rate_multiplier_;
+            step_correlated_prices(rate > 0 ? PRICE_UPDATE_INTERVAL * loaded / rate : 0.1);
+            ticks_since_step_ = 0;
+        }
+    } else {
+        symbol.ticks_since_price_update++;
+        if (symbol.ticks_since_price_update >= PRICE_UPDATE_INTERVAL) {
+            // dt = PRICE_UPDATE_INTERVAL / (tick_rate * rate_share), where
+            // rate_share = 1 / loaded symbols unless arrivals are Poisson; a
+            // scenario burst scales the rate and so shortens dt
+            double symbol_rate = tick_rate_.load() * market_rate_multiplier_ *
+                                 symbol.rate_multiplier * symbol.rate_share;
+            double dt = symbol_rate > 0 ? PRICE_UPDATE_INTERVAL / symbol_rate : 0.1;
+            double volatility = symbol.volatility * market_volatility_multiplier_ * symbol.volatility_multiplier;
+            symbol.current_price = gen.generate_next_price(
+                symbol.current_price, symbol.drift, volatility, dt);
+            symbol.ticks_since_price_update = 0;
+        }
     }
     
-    auto now = std::chrono::system_clock::now();
-    auto timestamp = std::chrono::duration_cast<std::chrono::nanoseconds>(
-        now.time_since_epoch()).count();
-    
-    // Fault injection: 1% sequence gaps (skip sequence number)
-    static std::random_device rd;
-    static std::mt19937 gen_fault(rd());
-    static std::uniform_int_distribution<> dis_gap(1, 100);
+    // Wall-clock ns since epoch derived from the TSC (no syscall per tick)
+    uint64_t timestamp = TscClock::now_wall_ns();
     
-    if (fault_injection_enabled_ && dis_gap(gen_fault) <= 1) {
+    // Fault injection: sequence gaps (skip a sequence number)
+    if (fault_injection_enabled_ && fault_rngs_[slot].uniform() < fault_config_.sequence_gap) {
         symbol.seq_num += 2; // Skip one sequence number to create a gap
     }
     
-    if (gen.should_generate_quote()) {
-        // Generate quote
-        QuoteMessage msg{};
-        msg.header.msg_type = static_cast<uint16_t>(MessageType::QUOTE);
-        msg.header.seq_num = ++symbol.seq_num;
-        msg.header.timestamp = timestamp;
-        msg.header.symbol_id = symbol_id;
-        
-        double spread = gen.generate_spread(symbol.current_price);
-        msg.payload.bid_price = symbol.current_price - spread / 2.0;
-        msg.payload.ask_price = symbol.current_price + spread / 2.0;
-        msg.payload.bid_qty = gen.generate_volume();
-        msg.payload.ask_qty = gen.generate_volume();
-        
-        msg.checksum = calculate_checksum(&msg, sizeof(msg) - 4);
-        
-        broadcast_message(&msg, sizeof(msg), symbol_id);
+    if (matching_enabled_) {
+        encode_matching_tick(slot, timestamp);
     } else {
-        // Generate trade
-        TradeMessage msg{};
-        msg.header.msg_type = static_cast<uint16_t>(MessageType::TRADE);
-        msg.header.seq_num = ++symbol.seq_num;
-        msg.header.timestamp = timestamp;
-        msg.header.symbol_id = symbol_id;
+        messages_generated_.fetch_add(1, std::memory_order_relaxed);
         
-        msg.payload.price = symbol.current_price;
-        msg.payload.quantity = gen.generate_volume();
-        
-        msg.checksum = calculate_checksum(&msg, sizeof(msg) - 4);
-        
-        broadcast_message(&msg, sizeof(msg), symbol_id);
+        if (gen.should_generate_quote()) {
+            // Generate quote
+            QuoteMessage msg{};
+            msg.header.msg_type = static_cast<uint16_t>(MessageType::QUOTE);
+            msg.header.seq_num = ++symbol.seq_num;
+            msg.header.timestamp = timestamp;
+            msg.header.symbol_id = symbol.symbol_id;
+            
+            double spread = gen.generate_spread(symbol.current_price);
+            msg.payload.bid_price = symbol.current_price - spread / 2.0;
+            msg.payload.ask_price = symbol.current_price + spread / 2.0;
+            msg.payload.bid_qty = gen.generate_volume();
+            msg.payload.ask_qty = gen.generate_volume();
+            
+            msg.checksum = calculate_checksum(&msg, sizeof(msg) - 4);
+            
+            broadcast_log_->append(&msg, sizeof(msg));
+        } else {
+            // Generate trade
+            TradeMessage msg{};
+            msg.header.msg_type = static_cast<uint16_t>(MessageType::TRADE);
+            msg.header.seq_num = ++symbol.seq_num;
+            msg.header.timestamp = timestamp;
+            msg.header.symbol_id = symbol.symbol_id;
+            
+            msg.payload.price = symbol.current_price;
+            msg.payload.quantity = gen.generate_volume();
+            
+            msg.checksum = calculate_checksum(&msg, sizeof(msg) - 4);
+            
+            broadcast_log_->append(&msg, sizeof(msg));
+        }
+    }
+}
+
+void ExchangeSimulator::encode_matching_tick(uint32_t slot, uint64_t timestamp) {
+    auto& symbol = symbols_[slot];
+    auto& matching = matching_[slot];
+    if (!matching.book) {
+        return;
     }
+    OrderBook& book = *matching.book;
+    OrderFlowGenerator& flow = *matching.flow;
     
-#ifdef TESTING
-    // Update loaded_symbols_ array for test access
-    // This must be done AFTER seq_num is incremented above
-    for (auto& loaded_sym : loaded_symbols_) {
-        if (loaded_sym.symbol_id == symbol_id) {
-            loaded_sym.current_price = symbol.current_price;
-            loaded_sym.seq_num = symbol.seq_num;
-            loaded_sym.ticks_since_price_update = symbol.ticks_since_price_update;
+    // Agents quote around the GBM price, so the book follows it and trades
+    // happen where their orders actually cross
+    OrderEvent event = flow.next(price_to_tick(symbol.current_price));
+    fills_.clear();
+    switch (event.type) {
+        case OrderEvent::Type::LIMIT: {
+            uint64_t order_id = book.add_limit(event.side, event.price_tick, event.quantity, fills_);
+            if (order_id != 0) {
+                flow.on_resting(order_id);
+            }
             break;
         }
+        case OrderEvent::Type::MARKET:
+            book.add_market(event.side, event.quantity, fills_);
+            break;
+        case OrderEvent::Type::CANCEL:
+            book.cancel(event.order_id);
+            break;
     }
-#endif
+    
+    encode_book_changes(slot, timestamp);
 }
 
-void ExchangeSimulator::broadcast_message(const void* data, size_t len, uint16_t symbol_id) {
-    std::vector<int> clients;
+void ExchangeSimulator::encode_book_changes(uint32_t slot, uint64_t timestamp) {
+    auto& symbol = symbols_[slot];
+    auto& matching = matching_[slot];
     
-    // Get clients subscribed to this symbol
-    if (symbol_id != 0xFFFF) {
-        clients = client_manager_.get_subscribed_clients(symbol_id);
-    } else {
-        clients = client_manager_.get_all_clients();
+    // One trade per maker fill, at the maker's price
+    for (const Fill& fill : fills_) {
+        matching.flow->on_fill(fill);
+        
+        TradeMessage msg{};
+        msg.header.msg_type = static_cast<uint16_t>(MessageType::TRADE);
+        msg.header.seq_num = ++symbol.seq_num;
+        msg.header.timestamp = timestamp;
+        msg.header.symbol_id = symbol.symbol_id;
+        msg.payload.price = fill.price_tick * tick_size_;
+        msg.payload.quantity = fill.quantity;
+        msg.checksum = calculate_checksum(&msg, sizeof(msg) - 4);
+        
+        broadcast_log_->append(&msg, sizeof(msg));
+        messages_generated_.fetch_add(1, std::memory_order_relaxed);
     }
     
-    static std::random_device rd;
-    static std::mt19937 gen(rd());
-    static std::uniform_int_distribution<> dis(1, 100);
-    
-    for (int fd : clients) {
-        
-        const uint8_t* send_ptr = static_cast<const uint8_t*>(data);
+    OrderBook::Top top = matching.book->top();
+    if (top != matching.published) {
+        matching.published = top;
         
-        // Fault injection: 5% packet fragmentation (send in two parts)
-        if (fault_injection_enabled_ && dis(gen) <= 5) {
-            size_t first_part = len / 2;
-            ssize_t sent1 = send(fd, send_ptr, first_part, MSG_NOSIGNAL | MSG_DONTWAIT);
-            if (sent1 > 0) {
-                std::this_thread::sleep_for(std::chrono::microseconds(100));
-                send(fd, send_ptr + first_part, len - first_part, MSG_NOSIGNAL | MSG_DONTWAIT);
-            }
-            continue;
+        // An empty side is sent as price 0, quantity 0
+        QuoteMessage msg{};
+        msg.header.msg_type = static_cast<uint16_t>(MessageType::QUOTE);
+        msg.header.seq_num = ++symbol.seq_num;
+        msg.header.timestamp = timestamp;
+        msg.header.symbol_id = symbol.symbol_id;
+        if (top.bid_tick != OrderBook::NO_PRICE) {
+            msg.payload.bid_price = top.bid_tick * tick_size_;
+            msg.payload.bid_qty = static_cast<uint32_t>(std::min<uint64_t>(top.bid_quantity, UINT32_MAX));
         }
-        
-        ssize_t sent = send(fd, data, len, MSG_NOSIGNAL | MSG_DONTWAIT);
-        
-        if (sent < 0) {
-            client_manager_.update_stats(fd, len, false);
-            if (errno == EAGAIN || errno == EWOULDBLOCK) {
-                // Send buffer full - slow consumer detected
-                client_manager_.mark_slow_client(fd);
-                std::cerr << "Slow consumer detected on fd " << fd << std::endl;
-                // Skip this client to avoid blocking others
-                continue;
-            } else if (errno == EPIPE || errno == ECONNRESET) {
-                // Client disconnected
-                handle_client_disconnect(fd);
-            }
-        } else {
-            client_manager_.update_stats(fd, len, true);
+        if (top.ask_tick != OrderBook::NO_PRICE) {
+            msg.payload.ask_price = top.ask_tick * tick_size_;
+            msg.payload.ask_qty = static_cast<uint32_t>(std::min<uint64_t>(top.ask_quantity, UINT32_MAX));
         }
+        msg.checksum = calculate_checksum(&msg, sizeof(msg) - 4);
+        
+        broadcast_log_->append(&msg, sizeof(msg));
+        messages_generated_.fetch_add(1, std::memory_order_relaxed);
     }
 }
 
 void ExchangeSimulator::tick_generation_loop() {
     using namespace std::chrono;
     
+#ifdef MDFH_TRACING
+    Tracer::instance().set_thread_name("tick");
+#endif
+    
+    // Tick clock (microseconds) for Poisson arrivals and scenario events
+    const auto clock_epoch = steady_clock::now();
     while (running_) {
         auto start = steady_clock::now();
+        uint64_t now_us = duration_cast<microseconds>(start - clock_epoch).count();
         
         uint32_t rate = tick_rate_.load();
+        if (arrival_wheel_) {
+            // A rate of 0 drops the schedule so a resume draws fresh arrivals
+            generate_arrivals(now_us);
+        }
         if (rate == 0) {
             // Efficient wait using condition variable instead of polling
             std::unique_lock<std::mutex> lock(tick_rate_mutex_);
@@ -407,17 +842,41 @@ void ExchangeSimulator::tick_generation_loop() {
             });
             continue;
         }
+        if (arrival_wheel_) {
+            std::this_thread::sleep_for(milliseconds(ARRIVAL_POLL_INTERVAL_MS));
+            continue;
+        }
         
-        // Generate ticks for all symbols
+        // Generate ticks for all loaded symbols
         // Message rate: 100000 / 100 symbols = 1000 messages per symbol per second
         // Price update rate: Every 100 ticks = 10 price updates per second
         // This separates high-frequency messaging from realistic price evolution
-        size_t ticks_per_symbol = rate / num_symbols_;
+        size_t ticks_per_symbol = rate / symbols_.size();
         if (ticks_per_symbol == 0) ticks_per_symbol = 1;
         
-        for (uint16_t i = 0; i < num_symbols_; ++i) {
-            for (size_t j = 0; j < ticks_per_symbol; ++j) {
-                generate_tick(i);
+        // Ticks are committed to the broadcast log in batches
+        {
+            std::unique_lock lock(publish_mutex_);
+            apply_due_scenario_events(now_us);
+            size_t pending = 0;
+            for (uint32_t slot = 0; slot < symbols_.size(); ++slot) {
+                const auto& symbol = symbols_[slot];
+                if (symbol.halted) continue;
+                size_t symbol_ticks = static_cast<size_t>(std::llround(
+                    ticks_per_symbol * market_rate_multiplier_ * symbol.rate_multiplier));
+                for (size_t j = 0; j < symbol_ticks; ++j) {
+                    encode_tick(slot);
+                    if (++pending >= TICK_BATCH_SIZE) {
+                        publish();
+                        pending = 0;
+                        // Let test-driven generate_tick calls interleave
+                        lock.unlock();
+                        lock.lock();
+                    }
+                }
+            }
+            if (pending > 0) {
+                publish();
             }
         }
         
@@ -446,97 +905,198 @@ void ExchangeSimulator::enable_fault_injection(bool enable) {
     fault_injection_enabled_ = enable;
 }
 
-void ExchangeSimulator::stop() {
-    running_ = false;
+void ExchangeSimulator::enable_poisson_arrivals(double rate_skew) {
+    std::scoped_lock lock(publish_mutex_);
+    arrivals_mode_ = "poisson";
+    rate_skew_ = rate_skew;
+    initialize_arrivals();
+}
+
+void ExchangeSimulator::set_scenario_file(const std::string& file) {
+    std::scoped_lock lock(publish_mutex_);
+    scenario_file_ = file;
+    initialize_scenario();
+}
+
+void ExchangeSimulator::set_num_reactors(size_t num_reactors) {
+    num_reactors_ = num_reactors;
+}
+
+void ExchangeSimulator::set_heartbeat_interval_ms(uint32_t interval_ms) {
+    heartbeat_interval_ms_ = interval_ms;
+}
+
+void ExchangeSimulator::set_broadcast_log_size(size_t bytes) {
+    std::scoped_lock lock(publish_mutex_);
+    if (!reactors_.empty()) {
+        return;  // Reactors hold references into the current log
+    }
+    broadcast_log_size_ = bytes;
+    broadcast_log_ = std::make_unique<BroadcastLog>(broadcast_log_size_);
+}
+
+OrderResult ExchangeSimulator::submit_order(const OrderRequest& request) {
+    OrderResult result{};
+    result.status = OrderStatus::REJECTED;
     
-    // Wake up tick thread if it's waiting on condition variable
-    tick_rate_cv_.notify_one();
+    uint32_t slot = symbol_map_.slot(request.symbol_id);
+    if (slot == SymbolMap::NO_SLOT) {
+        result.reject_reason = RejectReason::UNKNOWN_SYMBOL;
+        return result;
+    }
+    if (request.quantity == 0) {
+        result.reject_reason = RejectReason::INVALID_QUANTITY;
+        return result;
+    }
+    bool market = request.type == OrderType::MARKET;
+    if (!market && !(request.price > 0.0)) {
+        result.reject_reason = RejectReason::INVALID_PRICE;
+        return result;
+    }
     
-    if (tick_thread_.joinable()) {
-        tick_thread_.join();
+    // The tick thread moves current_price under the same lock
+    std::scoped_lock lock(publish_mutex_);
+    if (symbols_[slot].current_price <= 0.0) {
+        result.reject_reason = RejectReason::UNKNOWN_SYMBOL;
+        return result;
     }
     
-    auto clients = client_manager_.get_all_clients();
-    for (int fd : clients) {
-        close(fd);
-        client_manager_.remove_client(fd);
+    if (!matching_enabled_) {
+        // No book to match against
+        result.exchange_order_id = ++next_gbm_order_id_;
+        result.status = market ? OrderStatus::EXPIRED : OrderStatus::NEW;
+        result.leaves_quantity = market ? 0 : request.quantity;
+        return result;
     }
     
-    if (epoll_fd_ >= 0) {
-        close(epoll_fd_);
-        epoll_fd_ = -1;
+    OrderBook& book = *matching_[slot].book;
+    Side side = request.side == OrderSide::BUY ? Side::BUY : Side::SELL;
+    fills_.clear();
+    uint64_t order_id = 0;
+    if (market) {
+        book.add_market(side, request.quantity, fills_);
+    } else {
+        order_id = book.add_limit(side, price_to_tick(request.price), request.quantity, fills_);
+        if (order_id == 0 && fills_.empty()) {
+            result.reject_reason = RejectReason::INVALID_PRICE;  // Outside the price band
+            return result;
+        }
     }
     
-    if (server_fd_ >= 0) {
-        close(server_fd_);
-        server_fd_ = -1;
+    uint64_t filled = 0;
+    double notional = 0.0;
+    for (const Fill& fill : fills_) {
+        filled += fill.quantity;
+        notional += fill.quantity * (fill.price_tick * tick_size_);
+    }
+    result.exchange_order_id = order_id;
+    result.filled_quantity = static_cast<uint32_t>(filled);
+    result.average_price = filled > 0 ? notional / filled : 0.0;
+    if (order_id != 0) {
+        result.leaves_quantity = request.quantity - result.filled_quantity;
+        result.status = filled > 0 ? OrderStatus::PARTIALLY_FILLED : OrderStatus::NEW;
+    } else {
+        result.status = filled == request.quantity ? OrderStatus::FILLED : OrderStatus::EXPIRED;
     }
+    
+    // The order's trades and the new top of book go out on the feed
+    encode_book_changes(slot, TscClock::now_wall_ns());
+    publish();
+    return result;
 }
 
-void ExchangeSimulator::handle_client_data(int client_fd) {
-    uint8_t buffer[1024];
-    ssize_t bytes_read = recv(client_fd, buffer, sizeof(buffer), MSG_DONTWAIT);
-    
-    if (bytes_read <= 0) {
-        if (bytes_read == 0 || (errno != EAGAIN && errno != EWOULDBLOCK)) {
-            // Connection closed or error
-            handle_client_disconnect(client_fd);
-        }
-        return;
+bool ExchangeSimulator::cancel_order(SymbolId symbol_id, uint64_t exchange_order_id) {
+    if (!matching_enabled_) {
+        return true;  // GBM mode orders only rest notionally
+    }
+    uint32_t slot = symbol_map_.slot(symbol_id);
+    if (slot >= matching_.size() || !matching_[slot].book) {
+        return false;
     }
     
-    // Check if this is a subscription message (starts with 0xFF)
-    if (bytes_read >= 3 && buffer[0] == 0xFF) {
-        handle_subscription_message(client_fd, buffer, bytes_read);
+    std::scoped_lock lock(publish_mutex_);
+    if (!matching_[slot].book->cancel(exchange_order_id)) {
+        return false;
     }
+    fills_.clear();
+    encode_book_changes(slot, TscClock::now_wall_ns());
+    publish();
+    return true;
 }
 
-void ExchangeSimulator::handle_subscription_message(int client_fd, const uint8_t* data, size_t len) {
-    if (len < 3) {
-        std::cerr << "Invalid subscription message: too short" << std::endl;
-        return;
+bool ExchangeSimulator::is_order_open(SymbolId symbol_id, uint64_t exchange_order_id) {
+    if (!matching_enabled_) {
+        return true;
+    }
+    uint32_t slot = symbol_map_.slot(symbol_id);
+    if (slot >= matching_.size() || !matching_[slot].book) {
+        return false;
+    }
+
+    std::scoped_lock lock(publish_mutex_);
+    return matching_[slot].book->is_resting(exchange_order_id);
+}
+
+OrderGatewayStats ExchangeSimulator::get_order_gateway_stats() const {
+    return order_gateway_ ? order_gateway_->get_stats() : OrderGatewayStats{};
+}
+
+ServerStats ExchangeSimulator::get_stats() const {
+    ServerStats stats{};
+    stats.messages_generated = messages_generated_.load(std::memory_order_relaxed);
+    for (const auto& reactor : reactors_) {
+        reactor->accumulate_stats(stats);
     }
+    return stats;
+}
+
+std::array<uint64_t, NUM_FAULTS> ExchangeSimulator::get_fault_counts() const {
+    std::array<uint64_t, NUM_FAULTS> counts{};
+    for (const auto& reactor : reactors_) {
+        for (size_t i = 0; i < NUM_FAULTS; ++i) {
+            counts[i] += reactor->get_fault_injector().get_count(static_cast<Fault>(i));
+        }
+    }
+    return counts;
+}
+
+void ExchangeSimulator::stop() {
+    running_ = false;
+    
+    // Wake up tick thread if it's waiting on condition variable
+    tick_rate_cv_.notify_one();
     
-    // Parse subscription header
-    uint8_t command = data[0];
-    uint16_t count = data[1] | (data[2] << 8);
+    if (tick_thread_.joinable()) {
+        tick_thread_.join();
+    }
     
-    if (command != 0xFF) {
-        std::cerr << "Invalid subscription command: " << (int)command << std::endl;
-        return;
+    // Reactors close the sockets they own
+    for (auto& reactor : reactors_) {
+        reactor->stop();
     }
     
-    size_t expected_len = 3 + (count * 2);
-    if (len < expected_len) {
-        std::cerr << "Invalid subscription message: expected " << expected_len 
-                  << " bytes, got " << len << std::endl;
-        return;
+    if (order_gateway_) {
+        order_gateway_->stop();
     }
     
-    // Parse symbol IDs
-    std::unordered_set<uint16_t> symbol_ids;
-    for (uint16_t i = 0; i < count; ++i) {
-        size_t offset = 3 + (i * 2);
-        uint16_t symbol_id = data[offset] | (data[offset + 1] << 8);
-        
-        // Validate symbol ID
-        if (symbol_id < num_symbols_) {
-            symbol_ids.insert(symbol_id);
-        } else {
-            std::cerr << "Invalid symbol ID in subscription: " << symbol_id 
-                      << " (max=" << num_symbols_ << ")" << std::endl;
-        }
+    if (epoll_fd_ >= 0) {
+        close(epoll_fd_);
+        epoll_fd_ = -1;
     }
     
-    std::cout << "Client " << client_fd << " subscribed to " << symbol_ids.size() 
-              << " symbols" << std::endl;
+    if (server_fd_ >= 0) {
+        close(server_fd_);
+        server_fd_ = -1;
+    }
     
-    // Update client subscriptions
-    client_manager_.subscribe(client_fd, symbol_ids);
+    if (line_b_fd_ >= 0) {
+        close(line_b_fd_);
+        line_b_fd_ = -1;
+    }
 }
 
 #ifdef TESTING
-bool ExchangeSimulator::is_client_subscribed(int client_fd, uint16_t symbol_id) const {
+bool ExchangeSimulator::is_client_subscribed(int client_fd, SymbolId symbol_id) const {
     return client_manager_.is_subscribed(client_fd, symbol_id);
 }
 
@@ -0,0 +1,44 @@
+#include "server/fault_injector.h"
+#include <algorithm>
+
+namespace mdfh {
+
+FaultInjector::FaultInjector(const FaultConfig& config, uint64_t seed, uint32_t stream_id)
+    : config_(config),
+      rng_(seed, RngStream::DELIVERY_FAULTS, stream_id) {
+    double* probabilities[] = {&config_.sequence_gap, &config_.fragment, &config_.delay, &config_.corrupt,
+                               &config_.duplicate, &config_.reorder, &config_.disconnect, &config_.squeeze};
+    for (double* p : probabilities) {
+        *p = std::clamp(*p, 0.0, 1.0);
+    }
+
+    // Indexed by Fault; sequence gaps are drawn by the tick thread instead
+    std::array<double, NUM_FAULTS> weights = {0.0, config_.fragment, config_.delay, config_.corrupt,
+                                              config_.duplicate, config_.reorder, config_.disconnect,
+                                              config_.squeeze};
+    double total = 0.0;
+    for (double w : weights) {
+        total += w;
+    }
+    double scale = total > 1.0 ? 1.0 / total : 1.0;
+    double cumulative = 0.0;
+    for (size_t i = 0; i < NUM_FAULTS; ++i) {
+        cumulative += weights[i] * scale;
+        thresholds_[i] = cumulative;
+    }
+    any_ = cumulative;
+
+    config_.delay_us = std::max<uint32_t>(config_.delay_us, 1);
+    config_.reorder_us = std::max<uint32_t>(config_.reorder_us, 1);
+    config_.squeeze_ms = std::max<uint32_t>(config_.squeeze_ms, 1);
+}
+
+uint64_t FaultInjector::get_total() const {
+    uint64_t total = 0;
+    for (size_t i = 1; i < NUM_FAULTS; ++i) {
+        total += counts_[i].load(std::memory_order_relaxed);
+    }
+    return total;
+}
+
+} // namespace mdfh
@@ -0,0 +1,257 @@
+#include "server/order_book.h"
+#include <algorithm>
+
+namespace mdfh {
+
+OrderBook::OrderBook(uint32_t reference_tick, uint32_t num_levels)
+    : num_levels_(std::max<uint32_t>(num_levels, 16)),
+      base_(reference_tick > num_levels_ / 2 ? reference_tick - num_levels_ / 2 : 0),
+      levels_(num_levels_) {
+    orders_.reserve(1024);
+}
+
+uint32_t OrderBook::allocate() {
+    uint32_t slot;
+    if (free_head_ != NIL) {
+        slot = free_head_;
+        free_head_ = orders_[slot].next;
+    } else {
+        slot = static_cast<uint32_t>(orders_.size());
+        orders_.emplace_back();
+    }
+    // Bump the generation so ids of earlier occupants no longer match
+    Order& order = orders_[slot];
+    uint64_t generation = (order.id >> 32) + 1;
+    order.id = (generation << 32) | slot;
+    order.prev = NIL;
+    order.next = NIL;
+    return slot;
+}
+
+void OrderBook::release(uint32_t slot) {
+    Order& order = orders_[slot];
+    order.quantity = 0;
+    order.prev = NIL;
+    order.next = free_head_;
+    free_head_ = slot;
+}
+
+void OrderBook::unlink(Order& order, Level& level) {
+    if (order.prev != NIL) {
+        orders_[order.prev].next = order.next;
+    } else {
+        level.head = order.next;
+    }
+    if (order.next != NIL) {
+        orders_[order.next].prev = order.prev;
+    } else {
+        level.tail = order.prev;
+    }
+    level.quantity -= order.quantity;
+}
+
+uint32_t OrderBook::next_ask_level(uint32_t from) const {
+    if (ask_orders_ == 0) return NIL;
+    // Asks exist at or above from; the scan is bounded by the band
+    while (from < num_levels_ && levels_[from].head == NIL) {
+        ++from;
+    }
+    return from < num_levels_ ? from : NIL;
+}
+
+uint32_t OrderBook::next_bid_level(uint32_t from) const {
+    if (bid_orders_ == 0) return NIL;
+    for (;;) {
+        if (levels_[from].head != NIL) return from;
+        if (from == 0) return NIL;
+        --from;
+    }
+}
+
+bool OrderBook::recenter(uint32_t price_tick) {
+    // Span of live levels plus the new price must fit in the band
+    uint32_t lo = price_tick;
+    uint32_t hi = price_tick;
+    if (bid_orders_ + ask_orders_ > 0) {
+        uint32_t first = 0;
+        while (levels_[first].head == NIL) ++first;
+        uint32_t last = num_levels_ - 1;
+        while (levels_[last].head == NIL) --last;
+        lo = std::min(lo, base_ + first);
+        hi = std::max(hi, base_ + last);
+    }
+    if (hi - lo >= num_levels_) {
+        return false;
+    }
+
+    uint32_t mid = lo + (hi - lo) / 2;
+    uint32_t new_base = mid > num_levels_ / 2 ? mid - num_levels_ / 2 : 0;
+    new_base = std::min(new_base, lo);
+    if (hi - new_base >= num_levels_) {
+        new_base = hi - num_levels_ + 1;
+    }
+
+    std::vector<Level> moved(num_levels_);
+    for (uint32_t i = 0; i < num_levels_; ++i) {
+        if (levels_[i].head != NIL) {
+            moved[base_ + i - new_base] = levels_[i];
+        }
+    }
+    levels_.swap(moved);
+    if (best_bid_ != NIL) best_bid_ = best_bid_ + base_ - new_base;
+    if (best_ask_ != NIL) best_ask_ = best_ask_ + base_ - new_base;
+    base_ = new_base;
+    recenters_++;
+    return true;
+}
+
+uint32_t OrderBook::index_for(uint32_t price_tick) {
+    if (price_tick >= base_ && price_tick - base_ < num_levels_) {
+        return price_tick - base_;
+    }
+    if (!recenter(price_tick)) {
+        return NIL;
+    }
+    return price_tick - base_;
+}
+
+template<bool IsBuy>
+uint32_t OrderBook::match(uint32_t quantity, uint32_t limit_index, std::vector<Fill>& fills) {
+    uint32_t filled = 0;
+    uint32_t& best = IsBuy ? best_ask_ : best_bid_;
+    size_t& resting = IsBuy ? ask_orders_ : bid_orders_;
+
+    while (quantity > 0 && best != NIL && (IsBuy ? best <= limit_index : best >= limit_index)) {
+        Level& level = levels_[best];
+        uint32_t price_tick = base_ + best;
+
+        // Oldest order first (time priority within the level)
+        while (quantity > 0 && level.head != NIL) {
+            uint32_t slot = level.head;
+            Order& maker = orders_[slot];
+            uint32_t traded = std::min(quantity, maker.quantity);
+            maker.quantity -= traded;
+            level.quantity -= traded;
+            quantity -= traded;
+            filled += traded;
+
+            bool done = maker.quantity == 0;
+            fills.push_back(Fill{maker.id, price_tick, traded, done});
+            if (done) {
+                level.head = maker.next;
+                if (level.head != NIL) {
+                    orders_[level.head].prev = NIL;
+                } else {
+                    level.tail = NIL;
+                }
+                release(slot);
+                resting--;
+            }
+        }
+
+        if (level.head == NIL) {
+            best = IsBuy ? next_ask_level(best + 1)
+                         : (best == 0 ? NIL : next_bid_level(best - 1));
+        }
+    }
+    return filled;
+}
+
+uint64_t OrderBook::add_limit(Side side, uint32_t price_tick, uint32_t quantity, std::vector<Fill>& fills) {
+    if (quantity == 0) return 0;
+
+    uint32_t index = index_for(price_tick);
+    if (index == NIL) {
+        rejected_++;
+        return 0;
+    }
+
+    bool is_buy = side == Side::BUY;
+    uint32_t filled = is_buy ? match<true>(quantity, index, fills)
+                             : match<false>(quantity, index, fills);
+    quantity -= filled;
+    if (quantity == 0) return 0;
+
+    // Rest the remainder at the back of its level
+    uint32_t slot = allocate();
+    Order& order = orders_[slot];
+    order.price_tick = price_tick;
+    order.quantity = quantity;
+    order.side = side;
+
+    Level& level = levels_[index];
+    order.prev = level.tail;
+    if (level.tail != NIL) {
+        orders_[level.tail].next = slot;
+    } else {
+        level.head = slot;
+    }
+    level.tail = slot;
+    level.quantity += quantity;
+
+    if (is_buy) {
+        bid_orders_++;
+        if (best_bid_ == NIL || index > best_bid_) best_bid_ = index;
+    } else {
+        ask_orders_++;
+        if (best_ask_ == NIL || index < best_ask_) best_ask_ = index;
+    }
+    return order.id;
+}
+
+uint32_t OrderBook::add_market(Side side, uint32_t quantity, std::vector<Fill>& fills) {
+    if (quantity == 0) return 0;
+    return side == Side::BUY ? match<true>(quantity, num_levels_ - 1, fills)
+                             : match<false>(quantity, 0, fills);
+}
+
+bool OrderBook::is_resting(uint64_t order_id) const {
+    uint32_t slot = static_cast<uint32_t>(order_id);
+    return slot < orders_.size() && orders_[slot].id == order_id && orders_[slot].quantity != 0;
+}
+
+bool OrderBook::cancel(uint64_t order_id) {
+    uint32_t slot = static_cast<uint32_t>(order_id);
+    if (slot >= orders_.size()) return false;
+
+    Order& order = orders_[slot];
+    if (order.id != order_id || order.quantity == 0) return false;
+
+    uint32_t index = order.price_tick - base_;
+    Level& level = levels_[index];
+    unlink(order, level);
+
+    if (order.side == Side::BUY) {
+        bid_orders_--;
+        if (index == best_bid_ && level.head == NIL) {
+            best_bid_ = index == 0 ? NIL : next_bid_level(index - 1);
+        }
+    } else {
+        ask_orders_--;
+        if (index == best_ask_ && level.head == NIL) {
+            best_ask_ = next_ask_level(index + 1);
+        }
+    }
+    release(slot);
+    return true;
+}
+
+OrderBook::Top OrderBook::top() const {
+    Top top{NO_PRICE, NO_PRICE, 0, 0};
+    if (best_bid_ != NIL) {
+        top.bid_tick = base_ + best_bid_;
+        top.bid_quantity = levels_[best_bid_].quantity;
+    }
+    if (best_ask_ != NIL) {
+        top.ask_tick = base_ + best_ask_;
+        top.ask_quantity = levels_[best_ask_].quantity;
+    }
+    return top;
+}
+
+uint64_t OrderBook::quantity_at(uint32_t price_tick) const {
+    if (price_tick < base_ || price_tick - base_ >= num_levels_) return 0;
+    return levels_[price_tick - base_].quantity;
+}
+
+} // namespace mdfh
@@ -0,0 +1,97 @@
+#include "server/order_flow.h"
+#include <algorithm>
+
+namespace mdfh {
+
+namespace {
+
+constexpr uint32_t NOT_LIVE = UINT32_MAX;
+
+} // namespace
+
+OrderFlowGenerator::OrderFlowGenerator(const OrderFlowConfig& config, uint64_t seed, uint32_t stream_id)
+    : config_(config),
+      rng_(seed, RngStream::ORDER_FLOW, stream_id) {
+    double total = config_.limit_ratio + config_.market_ratio + config_.cancel_ratio;
+    if (total <= 0.0) {
+        config_.limit_ratio = 1.0;
+        total = 1.0;
+    }
+    limit_threshold_ = config_.limit_ratio / total;
+    market_threshold_ = limit_threshold_ + config_.market_ratio / total;
+    config_.max_depth_ticks = std::max<uint32_t>(config_.max_depth_ticks, 1);
+    config_.lot_size = std::max<uint32_t>(config_.lot_size, 1);
+    config_.max_lots = std::max<uint32_t>(config_.max_lots, 1);
+    live_.reserve(config_.max_live_orders);
+}
+
+OrderEvent OrderFlowGenerator::next(uint32_t reference_tick) {
+    OrderEvent event{};
+    event.side = rng_.uniform() < 0.5 ? Side::BUY : Side::SELL;
+    uint32_t lots = 1 + static_cast<uint32_t>(rng_.uniform() * config_.max_lots);
+    event.quantity = std::min(lots, config_.max_lots) * config_.lot_size;
+
+    double pick = rng_.uniform();
+    bool must_cancel = live_.size() >= config_.max_live_orders;
+    if ((pick >= market_threshold_ || must_cancel) && !live_.empty()) {
+        size_t index = static_cast<size_t>(rng_.uniform() * live_.size());
+        index = std::min(index, live_.size() - 1);
+        event.type = OrderEvent::Type::CANCEL;
+        event.order_id = live_[index];
+        forget(event.order_id);
+        return event;
+    }
+
+    if (pick >= limit_threshold_ && pick < market_threshold_) {
+        event.type = OrderEvent::Type::MARKET;
+        return event;
+    }
+
+    // Limit order: passive depth skewed towards the reference (u^2), or
+    // a marketable price a few ticks through it
+    event.type = OrderEvent::Type::LIMIT;
+    bool buy = event.side == Side::BUY;
+    if (rng_.uniform() < config_.aggressive_ratio) {
+        uint32_t through = 1 + static_cast<uint32_t>(rng_.uniform() * 3);
+        event.price_tick = buy ? reference_tick + through
+                               : (reference_tick > through ? reference_tick - through : 1);
+    } else {
+        double u = rng_.uniform();
+        uint32_t depth = 1 + static_cast<uint32_t>(u * u * config_.max_depth_ticks);
+        event.price_tick = buy ? (reference_tick > depth ? reference_tick - depth : 1)
+                               : reference_tick + depth;
+    }
+    return event;
+}
+
+void OrderFlowGenerator::on_resting(uint64_t order_id) {
+    uint32_t slot = static_cast<uint32_t>(order_id);
+    if (slot >= position_.size()) {
+        position_.resize(std::max<size_t>(slot + 1, position_.size() * 2), NOT_LIVE);
+    }
+    position_[slot] = static_cast<uint32_t>(live_.size());
+    live_.push_back(order_id);
+}
+
+void OrderFlowGenerator::on_fill(const Fill& fill) {
+    if (fill.maker_done) {
+        forget(fill.maker_id);
+    }
+}
+
+void OrderFlowGenerator::forget(uint64_t order_id) {
+    uint32_t slot = static_cast<uint32_t>(order_id);
+    if (slot >= position_.size() || position_[slot] == NOT_LIVE) return;
+
+    uint32_t index = position_[slot];
+    if (live_[index] != order_id) return;
+
+    // Swap-remove
+    uint64_t moved = live_.back();
+    live_[index] = moved;
+    position_[static_cast<uint32_t>(moved)] = index;
+    live_.pop_back();
+    position_[slot] = NOT_LIVE;
+}
+
+} // namespace mdfh
@@ -0,0 +1,432 @@
+#include "server/order_gateway.h"
+#include "common/logger.h"
+#include "common/tsc_clock.h"
+#include <cstring>
+#include <stdexcept>
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <errno.h>
+
+namespace mdfh {
+
+namespace {
+
+constexpr int MAX_EVENTS = 64;
+constexpr size_t RX_BUFFER_SIZE = 64 * 1024;
+
+} // namespace
+
+OrderGateway::OrderGateway(uint16_t port, OrderHandler& handler)
+    : port_(port),
+      handler_(handler),
+      listen_fd_(-1),
+      epoll_fd_(-1),
+      wake_fd_(-1),
+      running_(false),
+      rx_buffer_(RX_BUFFER_SIZE) {
+}
+
+OrderGateway::~OrderGateway() {
+    stop();
+}
+
+void OrderGateway::start() {
+    if (running_) {
+        return;
+    }
+
+    epoll_fd_ = epoll_create1(0);
+    if (epoll_fd_ < 0) {
+        throw std::runtime_error("Failed to create order gateway epoll");
+    }
+    wake_fd_ = eventfd(0, EFD_NONBLOCK);
+    if (wake_fd_ < 0) {
+        throw std::runtime_error("Failed to create order gateway eventfd");
+    }
+
+    listen_fd_ = socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK, 0);
+    if (listen_fd_ < 0) {
+        throw std::runtime_error("Failed to create order gateway socket");
+    }
+    int opt = 1;
+    setsockopt(listen_fd_, SOL_SOCKET, SO_REUSEADDR, &opt, sizeof(opt));
+
+    struct sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = INADDR_ANY;
+    addr.sin_port = htons(port_);
+    if (bind(listen_fd_, (struct sockaddr*)&addr, sizeof(addr)) < 0) {
+        throw std::runtime_error("Failed to bind order gateway socket");
+    }
+    if (listen(listen_fd_, static_cast<int>(MAX_SESSIONS)) < 0) {
+        throw std::runtime_error("Failed to listen on order gateway socket");
+    }
+
+    for (int fd : {listen_fd_, wake_fd_}) {
+        struct epoll_event ev{};
+        ev.events = EPOLLIN;
+        ev.data.fd = fd;
+        epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, fd, &ev);
+    }
+
+    running_ = true;
+    thread_ = std::thread(&OrderGateway::loop, this);
+    MDFH_LOG_INFO("Order gateway listening on port {}", port_);
+}
+
+void OrderGateway::stop() {
+    running_ = false;
+    if (wake_fd_ >= 0) {
+        uint64_t one = 1;
+        ssize_t ret = write(wake_fd_, &one, sizeof(one));
+        (void)ret;
+    }
+    if (thread_.joinable()) {
+        thread_.join();
+    }
+
+    for (auto& entry : sessions_) {
+        close(entry.first);
+    }
+    sessions_.clear();
+    session_count_ = 0;
+
+    for (int* fd : {&listen_fd_, &wake_fd_, &epoll_fd_}) {
+        if (*fd >= 0) {
+            close(*fd);
+            *fd = -1;
+        }
+    }
+}
+
+OrderGatewayStats OrderGateway::get_stats() const {
+    OrderGatewayStats stats{};
+    stats.orders_received = orders_received_.load(std::memory_order_relaxed);
+    stats.cancels_received = cancels_received_.load(std::memory_order_relaxed);
+    stats.acks_sent = acks_sent_.load(std::memory_order_relaxed);
+    stats.rejects = rejects_.load(std::memory_order_relaxed);
+    stats.checksum_errors = checksum_errors_.load(std::memory_order_relaxed);
+    stats.protocol_errors = protocol_errors_.load(std::memory_order_relaxed);
+    return stats;
+}
+
+void OrderGateway::loop() {
+    struct epoll_event events[MAX_EVENTS];
+    std::vector<int> dead;
+
+    while (running_.load(std::memory_order_relaxed)) {
+        int nfds = epoll_wait(epoll_fd_, events, MAX_EVENTS, -1);
+        for (int i = 0; i < nfds; ++i) {
+            int fd = events[i].data.fd;
+            if (fd == wake_fd_) {
+                continue;  // stop()
+            }
+            if (fd == listen_fd_) {
+                accept_sessions();
+                continue;
+            }
+
+            auto it = sessions_.find(fd);
+            if (it == sessions_.end()) {
+                continue;
+            }
+            Session& session = *it->second;
+            if (events[i].events & (EPOLLERR | EPOLLHUP)) {
+                session.dead = true;
+            }
+            if (!session.dead && (events[i].events & EPOLLOUT)) {
+                flush(session);
+            }
+            if (!session.dead && (events[i].events & EPOLLIN)) {
+                handle_readable(session);
+            }
+            if (session.dead) {
+                dead.push_back(fd);
+            }
+        }
+
+        for (int fd : dead) {
+            auto it = sessions_.find(fd);
+            if (it != sessions_.end()) {
+                close_session(*it->second);
+            }
+        }
+        dead.clear();
+    }
+}
+
+void OrderGateway::accept_sessions() {
+    while (true) {
+        int fd = accept4(listen_fd_, nullptr, nullptr, SOCK_NONBLOCK);
+        if (fd < 0) {
+            return;  // EAGAIN: backlog drained
+        }
+        if (sessions_.size() >= MAX_SESSIONS) {
+            MDFH_LOG_WARN("Order gateway full ({} sessions), refusing connection", MAX_SESSIONS);
+            close(fd);
+            continue;
+        }
+
+        int nodelay = 1;
+        setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &nodelay, sizeof(nodelay));
+
+        auto session = std::make_unique<Session>();
+        session->fd = fd;
+        session->rx.resize(sizeof(NewOrderMessage));
+
+        struct epoll_event ev{};
+        ev.events = EPOLLIN;
+        ev.data.fd = fd;
+        epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, fd, &ev);
+
+        sessions_[fd] = std::move(session);
+        session_count_.store(sessions_.size(), std::memory_order_relaxed);
+        MDFH_LOG_INFO("Order entry session opened: {}", fd);
+    }
+}
+
+void OrderGateway::handle_readable(Session& session) {
+    ssize_t n = recv(session.fd, rx_buffer_.data(), rx_buffer_.size(), MSG_DONTWAIT);
+    if (n <= 0) {
+        if (n == 0 || (errno != EAGAIN && errno != EWOULDBLOCK)) {
+            session.dead = true;
+        }
+        return;
+    }
+
+    const uint8_t* data = rx_buffer_.data();
+    size_t len = static_cast<size_t>(n);
+
+    // Complete the message cut at the previous read boundary first
+    while (session.rx_len > 0 && len > 0 && !session.dead) {
+        size_t need = sizeof(MessageHeader);
+        if (session.rx_len >= sizeof(uint16_t)) {
+            uint16_t type;
+            std::memcpy(&type, session.rx.data(), sizeof(type));
+            size_t size = get_order_message_size(static_cast<MessageType>(type));
+            need = size > 0 ? size : session.rx_len + 1;
+        }
+        size_t take = std::min(need - session.rx_len, len);
+        if (session.rx_len + take > session.rx.size()) {
+            take = session.rx.size() - session.rx_len;
+        }
+        std::memcpy(session.rx.data() + session.rx_len, data, take);
+        session.rx_len += take;
+        data += take;
+        len -= take;
+
+        size_t used = handle_message(session, session.rx.data(), session.rx_len);
+        if (used == 0) {
+            return;  // Still incomplete; len is 0 here
+        }
+        session.rx_len = 0;
+    }
+
+    // Whole messages straight from the receive buffer
+    while (len > 0 && !session.dead) {
+        size_t used = handle_message(session, data, len);
+        if (used == 0) {
+            std::memcpy(session.rx.data(), data, len);
+            session.rx_len = len;
+            return;
+        }
+        data += used;
+        len -= used;
+    }
+}
+
+size_t OrderGateway::handle_message(Session& session, const uint8_t* data, size_t len) {
+    if (len < sizeof(uint16_t)) {
+        return 0;
+    }
+    uint16_t raw_type;
+    std::memcpy(&raw_type, data, sizeof(raw_type));
+    MessageType type = static_cast<MessageType>(raw_type);
+    size_t size = get_order_message_size(type);
+
+    if (size == 0 || type == MessageType::ORDER_ACK) {
+        // Framing is lost; nothing after this can be trusted
+        protocol_errors_.fetch_add(1, std::memory_order_relaxed);
+        MDFH_LOG_WARN_RL(10, "Order entry session {}: unknown message type {}, closing",
+                         session.fd, raw_type);
+        session.dead = true;
+        return len;
+    }
+    if (len < size) {
+        return 0;
+    }
+    if (!validate_checksum(data, size)) {
+        checksum_errors_.fetch_add(1, std::memory_order_relaxed);
+        return size;
+    }
+
+    if (type == MessageType::NEW_ORDER) {
+        NewOrderMessage msg;
+        std::memcpy(&msg, data, sizeof(msg));
+        handle_new_order(session, msg);
+    } else {
+        CancelOrderMessage msg;
+        std::memcpy(&msg, data, sizeof(msg));
+        handle_cancel(session, msg);
+    }
+    return size;
+}
+
+void OrderGateway::handle_new_order(Session& session, const NewOrderMessage& msg) {
+    orders_received_.fetch_add(1, std::memory_order_relaxed);
+    const NewOrderPayload& order = msg.payload;
+
+    OrderAckPayload ack{};
+    ack.client_order_id = order.client_order_id;
+    ack.trigger_timestamp = order.trigger_timestamp;
+    ack.order_timestamp = msg.header.timestamp;
+    ack.status = static_cast<uint8_t>(OrderStatus::REJECTED);
+
+    // Passive fills are not reported, so a full session sweeps its orders at
+    // most once per PRUNE_INTERVAL new orders before refusing more
+    session.orders_since_prune++;
+    if (session.open_orders.size() >= MAX_OPEN_ORDERS && session.orders_since_prune >= PRUNE_INTERVAL) {
+        prune_open_orders(session);
+    }
+
+    if (order.side > static_cast<uint8_t>(OrderSide::SELL) ||
+        order.order_type > static_cast<uint8_t>(OrderType::MARKET)) {
+        ack.reject_reason = static_cast<uint8_t>(RejectReason::INVALID_FIELD);
+    } else if (session.open_orders.count(order.client_order_id) != 0) {
+        ack.reject_reason = static_cast<uint8_t>(RejectReason::DUPLICATE_ORDER_ID);
+    } else if (session.open_orders.size() >= MAX_OPEN_ORDERS) {
+        ack.reject_reason = static_cast<uint8_t>(RejectReason::TOO_MANY_OPEN_ORDERS);
+    } else {
+        OrderRequest request{msg.header.symbol_id,
+                             static_cast<OrderSide>(order.side),
+                             static_cast<OrderType>(order.order_type),
+                             order.price,
+                             order.quantity};
+        OrderResult result = handler_.submit_order(request);
+
+        ack.exchange_order_id = result.exchange_order_id;
+        ack.average_price = result.average_price;
+        ack.filled_quantity = result.filled_quantity;
+        ack.leaves_quantity = result.leaves_quantity;
+        ack.status = static_cast<uint8_t>(result.status);
+        ack.reject_reason = static_cast<uint8_t>(result.reject_reason);
+
+        if (result.status == OrderStatus::NEW || result.status == OrderStatus::PARTIALLY_FILLED) {
+            session.open_orders[order.client_order_id] = {msg.header.symbol_id, result.exchange_order_id};
+        }
+    }
+
+    send_ack(session, msg.header.symbol_id, ack);
+}
+
+void OrderGateway::prune_open_orders(Session& session) {
+    session.orders_since_prune = 0;
+    for (auto it = session.open_orders.begin(); it != session.open_orders.end();) {
+        if (handler_.is_order_open(it->second.symbol_id, it->second.exchange_order_id)) {
+            ++it;
+        } else {
+            it = session.open_orders.erase(it);
+        }
+    }
+}
+
+void OrderGateway::handle_cancel(Session& session, const CancelOrderMessage& msg) {
+    cancels_received_.fetch_add(1, std::memory_order_relaxed);
+
+    OrderAckPayload ack{};
+    ack.client_order_id = msg.payload.client_order_id;
+    ack.order_timestamp = msg.header.timestamp;
+    ack.status = static_cast<uint8_t>(OrderStatus::REJECTED);
+    ack.reject_reason = static_cast<uint8_t>(RejectReason::UNKNOWN_ORDER);
+
+    SymbolId symbol_id = msg.header.symbol_id;
+    auto it = session.open_orders.find(msg.payload.client_order_id);
+    if (it != session.open_orders.end()) {
+        symbol_id = it->second.symbol_id;
+        ack.exchange_order_id = it->second.exchange_order_id;
+        if (handler_.cancel_order(it->second.symbol_id, it->second.exchange_order_id)) {
+            ack.status = static_cast<uint8_t>(OrderStatus::CANCELLED);
+            ack.reject_reason = static_cast<uint8_t>(RejectReason::NONE);
+        }
+        // Cancelled now, or filled since entry: either way no longer open
+        session.open_orders.erase(it);
+    }
+
+    send_ack(session, symbol_id, ack);
+}
+
+void OrderGateway::send_ack(Session& session, SymbolId symbol_id, const OrderAckPayload& ack) {
+    if (ack.status == static_cast<uint8_t>(OrderStatus::REJECTED)) {
+        rejects_.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    OrderAckMessage msg{};
+    msg.header.msg_type = static_cast<uint16_t>(MessageType::ORDER_ACK);
+    msg.header.seq_num = ++session.ack_seq;
+    msg.header.timestamp = TscClock::now_wall_ns();
+    msg.header.symbol_id = symbol_id;
+    msg.payload = ack;
+    msg.checksum = calculate_checksum(&msg, sizeof(msg) - 4);
+    acks_sent_.fetch_add(1, std::memory_order_relaxed);
+
+    const uint8_t* bytes = reinterpret_cast<const uint8_t*>(&msg);
+    size_t offset = 0;
+    if (session.tx.empty()) {
+        ssize_t sent = send(session.fd, bytes, sizeof(msg), MSG_DONTWAIT | MSG_NOSIGNAL);
+        if (sent < 0) {
+            if (errno != EAGAIN && errno != EWOULDBLOCK) {
+                session.dead = true;
+                return;
+            }
+            sent = 0;
+        }
+        offset = static_cast<size_t>(sent);
+        if (offset == sizeof(msg)) {
+            return;
+        }
+
+        // Socket buffer full: keep the rest and wait for EPOLLOUT
+        struct epoll_event ev{};
+        ev.events = EPOLLIN | EPOLLOUT;
+        ev.data.fd = session.fd;
+        epoll_ctl(epoll_fd_, EPOLL_CTL_MOD, session.fd, &ev);
+    }
+    session.tx.insert(session.tx.end(), bytes + offset, bytes + sizeof(msg));
+}
+
+void OrderGateway::flush(Session& session) {
+    if (session.tx.empty()) {
+        return;
+    }
+    ssize_t sent = send(session.fd, session.tx.data(), session.tx.size(), MSG_DONTWAIT | MSG_NOSIGNAL);
+    if (sent < 0) {
+        if (errno != EAGAIN && errno != EWOULDBLOCK) {
+            session.dead = true;
+        }
+        return;
+    }
+    session.tx.erase(session.tx.begin(), session.tx.begin() + sent);
+    if (session.tx.empty()) {
+        struct epoll_event ev{};
+        ev.events = EPOLLIN;
+        ev.data.fd = session.fd;
+        epoll_ctl(epoll_fd_, EPOLL_CTL_MOD, session.fd, &ev);
+    }
+}
+
+void OrderGateway::close_session(Session& session) {
+    int fd = session.fd;
+    MDFH_LOG_INFO("Order entry session closed: {} ({} open orders left resting)",
+                  fd, session.open_orders.size());
+    epoll_ctl(epoll_fd_, EPOLL_CTL_DEL, fd, nullptr);
+    close(fd);
+    sessions_.erase(fd);
+    session_count_.store(sessions_.size(), std::memory_order_relaxed);
+}
+
+} // namespace mdfh
@@ -0,0 +1,1086 @@
+#include "server/reactor.h"
+#include "server/exchange_simulator.h"
+#include "server/client_manager.h"
+#include "common/logger.h"
+#include "common/trace.h"
+#include "common/tsc_clock.h"
+#include <algorithm>
+#include <cstring>
+#include <unistd.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
+#include <errno.h>
+
+namespace mdfh {
+
+namespace {
+
+constexpr int MAX_EVENTS = 256;
+constexpr int EPOLL_TIMEOUT_MS = 100;
+
+// Single-writer counter: only the owning thread updates it
+inline void bump(std::atomic<uint64_t>& counter, uint64_t delta) {
+    if (delta != 0) {
+        counter.store(counter.load(std::memory_order_relaxed) + delta, std::memory_order_relaxed);
+    }
+}
+
+} // namespace
+
+Reactor::Reactor(size_t index, const SymbolMap& symbol_map, const BroadcastLog& log,
+                 ClientManager& client_manager, const std::atomic<bool>& fault_injection_enabled,
+                 const FaultConfig& faults, uint64_t seed)
+    : index_(index),
+      symbol_map_(symbol_map),
+      client_manager_(client_manager),
+      log_(log),
+      fault_injection_enabled_(fault_injection_enabled),
+      epoll_fd_(-1),
+      wake_fd_(-1),
+      running_(false),
+      sleeping_(false),
+      log_pos_(log.head()),
+      subscriber_list_(symbol_map.size(), NO_LIST),
+      fault_injector_(faults, seed, static_cast<uint32_t>(index)),
+      fault_timers_(MAX_FAULT_TIMERS),
+      timer_clients_(MAX_FAULT_TIMERS, nullptr),
+      rx_buffer_(RX_CHUNK) {
+
+    free_timers_.reserve(MAX_FAULT_TIMERS);
+    for (uint32_t slot = MAX_FAULT_TIMERS; slot > 0; --slot) {
+        free_timers_.push_back(slot - 1);
+    }
+
+    epoll_fd_ = epoll_create1(0);
+    if (epoll_fd_ < 0) {
+        throw std::runtime_error("Failed to create reactor epoll");
+    }
+
+    wake_fd_ = eventfd(0, EFD_NONBLOCK);
+    if (wake_fd_ < 0) {
+        close(epoll_fd_);
+        throw std::runtime_error("Failed to create reactor eventfd");
+    }
+
+    struct epoll_event ev{};
+    ev.events = EPOLLIN;
+    ev.data.ptr = nullptr;  // nullptr marks the wake-up fd
+    epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, wake_fd_, &ev);
+}
+
+Reactor::~Reactor() {
+    stop();
+
+    {
+        std::scoped_lock lock(inbox_mutex_);
+        for (int fd : inbox_) {
+            close(fd);
+            client_manager_.remove_client(fd);
+        }
+        inbox_.clear();
+    }
+
+    close(wake_fd_);
+    close(epoll_fd_);
+}
+
+void Reactor::start() {
+    if (running_.exchange(true)) {
+        return;
+    }
+    thread_ = std::thread(&Reactor::loop, this);
+}
+
+void Reactor::stop() {
+    running_ = false;
+    wake();
+    if (thread_.joinable()) {
+        thread_.join();
+    }
+}
+
+void Reactor::add_client(int fd) {
+    {
+        std::scoped_lock lock(inbox_mutex_);
+        inbox_.push_back(fd);
+    }
+    wake();
+}
+
+void Reactor::notify() {
+    // Pairs with the fence in loop(): either the reactor sees the new head
+    // before sleeping or we see it sleeping and wake it
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (sleeping_.load(std::memory_order_relaxed) && sleeping_.exchange(false)) {
+        wake();
+    }
+}
+
+void Reactor::wake() {
+    uint64_t one = 1;
+    ssize_t ret = write(wake_fd_, &one, sizeof(one));
+    (void)ret;  // EAGAIN: counter already non-zero, reactor will wake anyway
+}
+
+void Reactor::accumulate_stats(ServerStats& stats) const {
+    stats.messages_sent += messages_sent_.load(std::memory_order_relaxed);
+    stats.bytes_sent += bytes_sent_.load(std::memory_order_relaxed);
+    stats.send_failures += send_failures_.load(std::memory_order_relaxed);
+    stats.slow_consumer_events += slow_consumer_events_.load(std::memory_order_relaxed);
+    stats.partial_sends += partial_sends_.load(std::memory_order_relaxed);
+    stats.log_overruns += log_overruns_.load(std::memory_order_relaxed);
+    stats.heartbeats_sent += heartbeats_sent_.load(std::memory_order_relaxed);
+    stats.messages_replayed += messages_replayed_.load(std::memory_order_relaxed);
+    stats.faults_injected += fault_injector_.get_total();
+}
+
+void Reactor::loop() {
+#ifdef MDFH_TRACING
+    Tracer::instance().set_thread_name("reactor");
+#endif
+
+    struct epoll_event events[MAX_EVENTS];
+
+    // Wake often enough to notice idle clients while the market is quiet
+    int idle_timeout = EPOLL_TIMEOUT_MS;
+    if (heartbeat_interval_ns_ > 0) {
+        idle_timeout = static_cast<int>(std::clamp<uint64_t>(heartbeat_interval_ns_ / 4000000, 1, EPOLL_TIMEOUT_MS));
+    }
+
+    while (running_.load(std::memory_order_relaxed)) {
+        now_ns_ = TscClock::now_ns();
+        drain_inbox();
+        bool busy = drain_log();
+
+        // Only block when the log is drained; re-check after announcing the
+        // sleep so entries committed in between are not missed
+        int timeout = 0;
+        if (!busy) {
+            sleeping_.store(true, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            if (log_pos_ == log_.head()) {
+                // Pending fault timers are checked every millisecond
+                timeout = fault_timers_.size() > 0 ? 1 : idle_timeout;
+            }
+        }
+
+        int nfds = epoll_wait(epoll_fd_, events, MAX_EVENTS, timeout);
+        sleeping_.store(false, std::memory_order_relaxed);
+
+        for (int i = 0; i < nfds; ++i) {
+            Client* client = static_cast<Client*>(events[i].data.ptr);
+            if (client == nullptr) {
+                uint64_t count;
+                ssize_t ret = read(wake_fd_, &count, sizeof(count));
+                (void)ret;
+                continue;
+            }
+            if (client->dead) {
+                continue;
+            }
+
+            if (events[i].events & (EPOLLHUP | EPOLLERR)) {
+                client->dead = true;
+                has_dead_clients_ = true;
+                continue;
+            }
+            if (events[i].events & EPOLLIN) {
+                handle_client_data(*client);
+            }
+            if (!client->dead && (events[i].events & EPOLLOUT)) {
+                flush(*client);
+            }
+        }
+
+        reap_dead_clients();
+        run_fault_timers();
+        send_heartbeats();
+    }
+
+    // Shutdown: close every socket this reactor owns
+    for (auto& [fd, client] : clients_) {
+        close(fd);
+        client_manager_.remove_client(fd);
+    }
+    clients_.clear();
+    std::fill(subscriber_list_.begin(), subscriber_list_.end(), NO_LIST);
+    lists_.clear();
+    free_lists_.clear();
+    client_count_.store(0, std::memory_order_relaxed);
+}
+
+void Reactor::drain_inbox() {
+    std::vector<int> fds;
+    {
+        std::scoped_lock lock(inbox_mutex_);
+        if (inbox_.empty()) {
+            return;
+        }
+        fds.swap(inbox_);
+    }
+
+    for (int fd : fds) {
+        auto client = std::make_unique<Client>();
+        client->fd = fd;
+        client->last_send_ns = now_ns_;
+
+        struct epoll_event ev{};
+        ev.events = EPOLLIN;
+        ev.data.ptr = client.get();
+        if (epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, fd, &ev) < 0) {
+            MDFH_LOG_WARN("Reactor {}: failed to add client {}", index_, fd);
+            close(fd);
+            client_manager_.remove_client(fd);
+            continue;
+        }
+
+        clients_[fd] = std::move(client);
+        MDFH_LOG_INFO("Reactor {}: adopted client {}", index_, fd);
+    }
+    client_count_.store(clients_.size(), std::memory_order_relaxed);
+}
+
+bool Reactor::drain_log() {
+    uint64_t head = log_.head();
+    if (log_pos_ == head) {
+        return false;
+    }
+
+    // The reactor itself fell out of the log window: its clients lose the
+    // skipped range (they see sequence gaps), the stream stays framed
+    if (log_.written() - log_pos_ > log_.lag_limit()) {
+        bump(log_overruns_, 1);
+        MDFH_LOG_WARN_RL(10, "Reactor {} fell {} bytes behind the broadcast log, skipping ahead",
+                         index_, head - log_pos_);
+        log_pos_ = head;
+        return true;
+    }
+
+    MDFH_TRACE_ZONE(BROADCAST);
+
+    const uint64_t pass_start = log_pos_;
+    uint64_t pos = log_pos_;
+    uint64_t queued = 0;
+    bool faults = fault_injection_enabled_.load(std::memory_order_relaxed);
+    bool overrun = false;
+
+    // Walk each new message once; subscribers get a run entry, not a copy
+    while (pos < head && pos - pass_start < MAX_PASS_BYTES) {
+        pos = log_.next_message_pos(pos);
+        if (pos >= head) {
+            break;
+        }
+
+        MessageHeader header;
+        std::memcpy(&header, log_.at(pos), sizeof(header));
+        size_t len = get_message_size(static_cast<MessageType>(header.msg_type));
+        if (len == 0) {
+            overrun = true;  // Only possible if the writer lapped us mid-read
+            break;
+        }
+
+        uint32_t slot = symbol_map_.slot(header.symbol_id);
+        uint32_t list = slot != SymbolMap::NO_SLOT ? subscriber_list_[slot] : NO_LIST;
+        if (list != NO_LIST) {
+            for (Client* client : lists_[list]) {
+                if (client->dead) {
+                    continue;
+                }
+                if (faults) {
+                    inject_fault(*client, pos, static_cast<uint32_t>(len));
+                } else {
+                    enqueue(*client, pos, static_cast<uint32_t>(len));
+                }
+                queued++;
+            }
+        }
+        pos += len;
+    }
+
+    if (overrun || !log_.is_valid(pass_start)) {
+        // Runs queued in this pass may point at overwritten bytes
+        rollback_pass();
+        bump(log_overruns_, 1);
+        MDFH_LOG_WARN_RL(10, "Reactor {} was overrun by the broadcast log writer", index_);
+        log_pos_ = log_.head();
+        return true;
+    }
+    log_pos_ = pos;
+    bump(messages_sent_, queued);
+
+    // One sendmsg per client with new output; clients waiting for EPOLLOUT
+    // are only checked for lag
+    for (Client* client : dirty_clients_) {
+        client->dirty = false;
+        if (client->dead) {
+            continue;
+        }
+        if (client->want_write) {
+            drop_if_lapped(*client);
+        } else {
+            flush(*client);
+        }
+    }
+    dirty_clients_.clear();
+
+    reap_dead_clients();
+    return true;
+}
+
+void Reactor::mark_dirty(Client& client) {
+    if (client.dirty) {
+        return;
+    }
+    client.dirty = true;
+    client.pass_runs = client.runs.size();
+    client.pass_last_len = client.runs.empty() ? 0 : client.runs.back().len;
+    client.pass_last_messages = client.runs.empty() ? 0 : client.runs.back().messages;
+    client.pass_stash_len = client.stash_len;
+    client.pass_injected = client.injected.size();
+    client.pass_held_len = client.held_len;
+    dirty_clients_.push_back(&client);
+}
+
+void Reactor::enqueue(Client& client, uint64_t pos, uint32_t len) {
+    mark_dirty(client);
+    append_run(client, pos, len);
+}
+
+void Reactor::append_run(Client& client, uint64_t pos, uint32_t len) {
+    // Extend the last run when this message directly follows it in the ring
+    if (client.run_head < client.runs.size()) {
+        Run& last = client.runs.back();
+        uint64_t end = last.pos + last.len;
+        if (end == pos && (pos & (log_.capacity() - 1)) != 0) {
+            last.len += len;
+            last.messages++;
+            return;
+        }
+    }
+    client.runs.push_back(Run{pos, len, 1});
+}
+
+void Reactor::fragment(Client& client, uint64_t pos, uint32_t len) {
+    mark_dirty(client);
+
+    const uint8_t* msg = log_.at(pos);
+    uint32_t first_part = len / 2;
+    ssize_t sent = send(client.fd, msg, first_part, MSG_NOSIGNAL | MSG_DONTWAIT);
+    if (sent < 0) {
+        if (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR) {
+            client.dead = true;
+            has_dead_clients_ = true;
+            return;
+        }
+        sent = 0;
+    }
+    if (sent > 0) {
+        bump(bytes_sent_, static_cast<uint64_t>(sent));
+        client.last_send_ns = now_ns_;
+    }
+
+    // The rest of the message follows in the next send
+    std::memcpy(client.stash, msg + sent, len - sent);
+    client.stash_head = 0;
+    client.stash_len = static_cast<uint8_t>(len - sent);
+}
+
+void Reactor::inject_fault(Client& client, uint64_t pos, uint32_t len) {
+    Fault fault = fault_injector_.draw();
+    const uint8_t* msg = log_.at(pos);
+
+    switch (fault) {
+    case Fault::NONE:
+        enqueue(client, pos, len);
+        break;
+    case Fault::FRAGMENT:
+        // Only at the head of the stream: the first half goes out right away
+        if (client.has_pending() || client.want_write || client.hold_until_ns != 0) {
+            enqueue(client, pos, len);
+            fault = Fault::NONE;
+        } else {
+            fragment(client, pos, len);
+        }
+        break;
+    case Fault::DELAY:
+        enqueue(client, pos, len);
+        if (client.hold_until_ns == 0) {
+            client.hold_until_ns = now_ns_ + fault_injector_.get_config().delay_us * 1000ULL;
+            if (!arm_fault_timer(client)) {
+                client.hold_until_ns = 0;
+                fault = Fault::NONE;
+            }
+        } else {
+            fault = Fault::NONE;    // Already held
+        }
+        break;
+    case Fault::CORRUPT: {
+        // Flip a payload byte: the checksum fails but the framing holds
+        uint8_t copy[BroadcastLog::MAX_MESSAGE_SIZE];
+        std::memcpy(copy, msg, len);
+        uint32_t payload = len - static_cast<uint32_t>(sizeof(MessageHeader)) - 4;
+        copy[sizeof(MessageHeader) + fault_injector_.draw_index(payload)] ^= 0xFF;
+        mark_dirty(client);
+        append_injected(client, copy, len);
+        break;
+    }
+    case Fault::DUPLICATE:
+        enqueue(client, pos, len);
+        append_injected(client, msg, len);
+        break;
+    case Fault::REORDER:
+        if (client.held_len != 0) {
+            enqueue(client, pos, len);
+            fault = Fault::NONE;
+            break;
+        }
+        mark_dirty(client);
+        std::memcpy(client.held, msg, len);
+        client.held_len = static_cast<uint8_t>(len);
+        client.held_until_ns = now_ns_ + fault_injector_.get_config().reorder_us * 1000ULL;
+        if (arm_fault_timer(client)) {
+            fault_injector_.record(Fault::REORDER);
+            return;     // Held until the next message passes it
+        }
+        client.held_len = 0;
+        client.held_until_ns = 0;
+        enqueue(client, pos, len);
+        fault = Fault::NONE;
+        break;
+    case Fault::DISCONNECT:
+        client.dead = true;
+        has_dead_clients_ = true;
+        break;
+    case Fault::SQUEEZE:
+        enqueue(client, pos, len);
+        if (client.squeeze_until_ns == 0) {
+            squeeze(client);
+        }
+        if (client.squeeze_until_ns == 0) {
+            fault = Fault::NONE;
+        }
+        break;
+    }
+
+    if (fault != Fault::NONE) {
+        fault_injector_.record(fault);
+    }
+
+    // A held message goes out right behind the one that passed it
+    if (client.held_len != 0 && !client.dead) {
+        mark_dirty(client);
+        append_injected(client, client.held, client.held_len);
+        client.held_len = 0;
+        client.held_until_ns = 0;
+    }
+}
+
+void Reactor::append_injected(Client& client, const uint8_t* data, uint32_t len) {
+    uint64_t offset = client.injected.size();
+    client.injected.insert(client.injected.end(), data, data + len);
+    client.runs.push_back(Run{INJECTED | offset, len, 1});
+}
+
+void Reactor::squeeze(Client& client) {
+    int sndbuf = 0;
+    socklen_t optlen = sizeof(sndbuf);
+    if (getsockopt(client.fd, SOL_SOCKET, SO_SNDBUF, &sndbuf, &optlen) < 0) {
+        return;
+    }
+    client.sndbuf = sndbuf / 2;  // The kernel reports twice the size that was set
+    client.squeeze_until_ns = now_ns_ + fault_injector_.get_config().squeeze_ms * 1000000ULL;
+    if (!arm_fault_timer(client)) {
+        client.squeeze_until_ns = 0;
+        return;
+    }
+    int squeezed = static_cast<int>(fault_injector_.get_config().squeeze_bytes);
+    setsockopt(client.fd, SOL_SOCKET, SO_SNDBUF, &squeezed, sizeof(squeezed));
+}
+
+bool Reactor::arm_fault_timer(Client& client) {
+    uint64_t next_ns = UINT64_MAX;
+    for (uint64_t at : {client.hold_until_ns, client.squeeze_until_ns, client.held_until_ns}) {
+        if (at != 0) {
+            next_ns = std::min(next_ns, at);
+        }
+    }
+    if (next_ns == UINT64_MAX) {
+        if (client.timer != NO_TIMER) {
+            fault_timers_.cancel(client.timer);
+            timer_clients_[client.timer] = nullptr;
+            free_timers_.push_back(client.timer);
+            client.timer = NO_TIMER;
+        }
+        return true;
+    }
+
+    if (client.timer == NO_TIMER) {
+        if (free_timers_.empty()) {
+            return false;
+        }
+        client.timer = free_timers_.back();
+        free_timers_.pop_back();
+        timer_clients_[client.timer] = &client;
+    }
+    if (fault_timers_.size() == 0) {
+        fault_timers_.clear(now_ns_ / 1000);    // Restart the idle clock at now
+    }
+    fault_timers_.schedule(client.timer, (next_ns + 999) / 1000);
+    return true;
+}
+
+void Reactor::run_fault_timers() {
+    if (fault_timers_.size() == 0) {
+        return;
+    }
+    expired_.clear();
+    fault_timers_.advance(now_ns_ / 1000, [this](uint32_t slot, uint64_t) {
+        expired_.push_back(timer_clients_[slot]);
+    });
+    for (Client* client : expired_) {
+        expire_faults(*client);
+    }
+    reap_dead_clients();
+}
+
+void Reactor::expire_faults(Client& client) {
+    if (client.held_len != 0 && client.held_until_ns <= now_ns_) {
+        // Nothing passed it in time
+        append_injected(client, client.held, client.held_len);
+        client.held_len = 0;
+        client.held_until_ns = 0;
+    }
+    if (client.squeeze_until_ns != 0 && client.squeeze_until_ns <= now_ns_) {
+        setsockopt(client.fd, SOL_SOCKET, SO_SNDBUF, &client.sndbuf, sizeof(client.sndbuf));
+        client.squeeze_until_ns = 0;
+    }
+    if (client.hold_until_ns != 0 && client.hold_until_ns <= now_ns_) {
+        client.hold_until_ns = 0;
+    }
+
+    arm_fault_timer(client);
+    if (!client.dead && !client.want_write && client.has_pending()) {
+        flush(client);
+    }
+}
+
+const uint8_t* Reactor::run_data(const Client& client, uint64_t pos) const {
+    if (pos & INJECTED) {
+        return client.injected.data() + (pos & ~INJECTED);
+    }
+    return log_.at(pos);
+}
+
+void Reactor::rollback_pass() {
+    for (Client* client : dirty_clients_) {
+        client->dirty = false;
+        client->runs.resize(client->pass_runs);
+        if (!client->runs.empty() && client->runs.size() > client->run_head) {
+            client->runs.back().len = client->pass_last_len;
+            client->runs.back().messages = client->pass_last_messages;
+        }
+        client->injected.resize(client->pass_injected);
+        if (client->held_len != client->pass_held_len) {
+            client->held_len = 0;   // Copied from a possibly overwritten range
+            client->held_until_ns = 0;
+        }
+        if (client->stash_len != client->pass_stash_len) {
+            // Part of a possibly torn message is already on the wire
+            client->dead = true;
+            has_dead_clients_ = true;
+        }
+    }
+    dirty_clients_.clear();
+    reap_dead_clients();
+}
+
+bool Reactor::drop_if_lapped(Client& client) {
+    size_t oldest = client.run_head;
+    while (oldest < client.runs.size() && (client.runs[oldest].pos & INJECTED)) {
+        oldest++;
+    }
+    if (oldest == client.runs.size() ||
+        log_.written() - client.runs[oldest].pos <= log_.lag_limit()) {
+        return false;
+    }
+
+    // Slow consumer: drop every queued whole message and resume at the
+    // log head. A partly sent message (stash) is still completed.
+    uint64_t dropped = 0;
+    for (size_t i = client.run_head; i < client.runs.size(); ++i) {
+        dropped += client.runs[i].messages;
+    }
+    client.runs.clear();
+    client.run_head = 0;
+    client.injected.clear();
+
+    bump(send_failures_, dropped);
+    bump(slow_consumer_events_, 1);
+    if (!client.slow) {
+        client.slow = true;
+        client_manager_.mark_slow_client(client.fd);
+    }
+    MDFH_LOG_WARN_RL(10, "Slow consumer on fd {} lapped by the broadcast log, dropped {} messages",
+                     client.fd, dropped);
+    return true;
+}
+
+void Reactor::flush(Client& client) {
+    drop_if_lapped(client);
+    if (client.hold_until_ns != 0) {
+        set_want_write(client, false);  // Delayed: the fault timer flushes
+        return;
+    }
+
+    struct iovec iov[MAX_IOVECS];
+    bool blocked = false;
+
+    while (client.has_pending()) {
+        int iovcnt = 0;
+        size_t total = 0;
+        if (client.stash_head < client.stash_len) {
+            iov[iovcnt].iov_base = client.stash + client.stash_head;
+            iov[iovcnt].iov_len = client.stash_len - client.stash_head;
+            total += iov[iovcnt].iov_len;
+            iovcnt++;
+        }
+        bool has_runs = false;
+        uint64_t first_pos = 0;
+        for (size_t i = client.run_head; i < client.runs.size() && iovcnt < MAX_IOVECS; ++i) {
+            if (!has_runs && !(client.runs[i].pos & INJECTED)) {
+                has_runs = true;
+                first_pos = client.runs[i].pos;
+            }
+            iov[iovcnt].iov_base = const_cast<uint8_t*>(run_data(client, client.runs[i].pos));
+            iov[iovcnt].iov_len = client.runs[i].len;
+            total += iov[iovcnt].iov_len;
+            iovcnt++;
+        }
+
+        struct msghdr msg{};
+        msg.msg_iov = iov;
+        msg.msg_iovlen = static_cast<size_t>(iovcnt);
+
+        ssize_t sent;
+        {
+            MDFH_TRACE_ZONE(SEND);
+            sent = sendmsg(client.fd, &msg, MSG_NOSIGNAL | MSG_DONTWAIT);
+        }
+
+        if (sent < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            if (errno == EAGAIN || errno == EWOULDBLOCK) {
+                blocked = true;  // Kernel buffer full; resume on EPOLLOUT
+                break;
+            }
+            // EPIPE / ECONNRESET: client is gone
+            client.dead = true;
+            has_dead_clients_ = true;
+            return;
+        }
+
+        bump(bytes_sent_, static_cast<uint64_t>(sent));
+        client.last_send_ns = now_ns_;
+        consume(client, static_cast<size_t>(sent));
+
+        // The kernel copied from the log while the writer kept going; if it
+        // lapped the range in the meantime the stream may carry torn bytes
+        if (has_runs && !log_.is_valid(first_pos)) {
+            bump(log_overruns_, 1);
+            MDFH_LOG_WARN_RL(10, "Broadcast log overran an in-flight send on fd {}, disconnecting",
+                             client.fd);
+            client.dead = true;
+            has_dead_clients_ = true;
+            return;
+        }
+
+        if (static_cast<size_t>(sent) < total) {
+            bump(partial_sends_, 1);
+            blocked = true;
+            break;
+        }
+    }
+
+    if (!client.has_pending()) {
+        client.runs.clear();
+        client.run_head = 0;
+        client.injected.clear();
+        client.slow = false;
+    } else if (client.run_head > client.runs.size() / 2) {
+        client.runs.erase(client.runs.begin(), client.runs.begin() + client.run_head);
+        client.run_head = 0;
+    }
+
+    set_want_write(client, blocked && client.has_pending());
+}
+
+void Reactor::send_heartbeats() {
+    if (heartbeat_interval_ns_ == 0 ||
+        now_ns_ - last_heartbeat_scan_ns_ < heartbeat_interval_ns_ / 4) {
+        return;
+    }
+    last_heartbeat_scan_ns_ = now_ns_;
+
+    // Only idle links get one: a client receiving data already knows the feed is alive
+    for (auto& [fd, client] : clients_) {
+        if (client->dead || client->has_pending() ||
+            now_ns_ - client->last_send_ns < heartbeat_interval_ns_) {
+            continue;
+        }
+
+        HeartbeatMessage msg{};
+        msg.header.msg_type = static_cast<uint16_t>(MessageType::HEARTBEAT);
+        msg.header.seq_num = ++client->heartbeat_seq;
+        msg.header.timestamp = TscClock::now_wall_ns();
+        msg.header.symbol_id = 0;
+        msg.checksum = calculate_checksum(&msg, sizeof(msg) - 4);
+
+        std::memcpy(client->stash, &msg, sizeof(msg));
+        client->stash_head = 0;
+        client->stash_len = sizeof(msg);
+        client->last_send_ns = now_ns_;  // Retry after a full interval even if the send blocks
+        bump(heartbeats_sent_, 1);
+        flush(*client);
+    }
+    reap_dead_clients();
+}
+
+void Reactor::consume(Client& client, size_t sent) {
+    size_t stash_left = client.stash_len - client.stash_head;
+    if (sent < stash_left) {
+        client.stash_head += static_cast<uint8_t>(sent);
+        return;
+    }
+    sent -= stash_left;
+    client.stash_head = 0;
+    client.stash_len = 0;
+
+    while (sent > 0 && client.run_head < client.runs.size()) {
+        Run& run = client.runs[client.run_head];
+        if (sent >= run.len) {
+            sent -= run.len;
+            client.run_head++;
+            continue;
+        }
+
+        // Cut inside a run: skip the whole messages that went out, then
+        // stash the unsent tail of the cut one so the run starts on a
+        // message boundary again (lapped runs can then be dropped whole)
+        uint32_t offset = 0;
+        uint32_t messages = 0;
+        size_t msg_len = 0;
+        while (true) {
+            MessageHeader header;
+            std::memcpy(&header, run_data(client, run.pos + offset), sizeof(header));
+            msg_len = get_message_size(static_cast<MessageType>(header.msg_type));
+            if (msg_len == 0 || offset + msg_len > sent) {
+                break;
+            }
+            offset += static_cast<uint32_t>(msg_len);
+            messages++;
+        }
+        if (msg_len == 0 || offset + msg_len > run.len) {
+            msg_len = run.len - offset;  // Torn bytes; flush() drops the client
+        }
+
+        size_t done = sent - offset;
+        std::memcpy(client.stash, run_data(client, run.pos + sent), msg_len - done);
+        client.stash_head = 0;
+        client.stash_len = static_cast<uint8_t>(msg_len - done);
+
+        uint32_t advance = offset + static_cast<uint32_t>(msg_len);
+        run.pos += advance;
+        run.len -= advance;
+        run.messages -= std::min(run.messages, messages + 1);
+        if (run.len == 0) {
+            client.run_head++;
+        }
+        break;
+    }
+}
+
+void Reactor::set_want_write(Client& client, bool enable) {
+    if (client.want_write == enable) {
+        return;
+    }
+    struct epoll_event ev{};
+    ev.events = enable ? (EPOLLIN | EPOLLOUT) : EPOLLIN;
+    ev.data.ptr = &client;
+    epoll_ctl(epoll_fd_, EPOLL_CTL_MOD, client.fd, &ev);
+    client.want_write = enable;
+}
+
+void Reactor::handle_client_data(Client& client) {
+    uint8_t* buffer = rx_buffer_.data();
+    ssize_t bytes_read = recv(client.fd, buffer, rx_buffer_.size(), MSG_DONTWAIT);
+
+    if (bytes_read <= 0) {
+        if (bytes_read == 0 || (errno != EAGAIN && errno != EWOULDBLOCK)) {
+            // Connection closed or error
+            client.dead = true;
+            has_dead_clients_ = true;
+        }
+        return;
+    }
+
+    // A request may arrive in several reads: complete the buffered one
+    // first, and keep whatever is left incomplete for the next read
+    size_t len = static_cast<size_t>(bytes_read);
+    if (!client.rx.empty()) {
+        client.rx.insert(client.rx.end(), buffer, buffer + len);
+        size_t used = handle_requests(client, client.rx.data(), client.rx.size());
+        client.rx.erase(client.rx.begin(), client.rx.begin() + used);
+        return;
+    }
+    size_t used = handle_requests(client, buffer, len);
+    client.rx.assign(buffer + used, buffer + len);
+}
+
+size_t Reactor::handle_requests(Client& client, const uint8_t* data, size_t len) {
+    // 0xFF subscription: count (u32 LE) x symbol_id (u32 LE)
+    // 0xFE resume: count (u32 LE) x (symbol_id, last_seq)
+    size_t used = 0;
+    while (len - used >= sizeof(SubscriptionHeader) && !client.dead) {
+        const uint8_t* request = data + used;
+        size_t entry_size = request[0] == 0xFF ? sizeof(SymbolId)
+                          : request[0] == 0xFE ? sizeof(ResumeEntry) : 0;
+        if (entry_size == 0) {
+            // No length to skip by, so nothing after it can be framed
+            MDFH_LOG_WARN_RL(10, "Unknown request type {} from client {}, input discarded",
+                             request[0], client.fd);
+            return len;
+        }
+        uint32_t count;
+        std::memcpy(&count, request + 1, sizeof(count));
+        size_t request_len = sizeof(SubscriptionHeader) + size_t{count} * entry_size;
+        if (request_len > MAX_SUBSCRIPTION_MESSAGE_SIZE) {
+            MDFH_LOG_WARN("Client {} sent a {} byte request (max {}), disconnecting",
+                          client.fd, request_len, MAX_SUBSCRIPTION_MESSAGE_SIZE);
+            client.dead = true;
+            has_dead_clients_ = true;
+            return len;
+        }
+        if (len - used < request_len) {
+            break;
+        }
+
+        if (request[0] == 0xFF) {
+            handle_subscription_message(client, request, request_len);
+        } else {
+            handle_resume_message(client, request, request_len);
+        }
+        used += request_len;
+    }
+    return used;
+}
+
+void Reactor::handle_subscription_message(Client& client, const uint8_t* data, size_t len) {
+    // Parse subscription header
+    uint32_t count;
+    std::memcpy(&count, data + 1, sizeof(count));
+
+    size_t expected_len = sizeof(SubscriptionHeader) + size_t{count} * sizeof(SymbolId);
+    if (len < expected_len) {
+        MDFH_LOG_WARN("Invalid subscription message: expected {} bytes, got {}",
+                      expected_len, len);
+        return;
+    }
+
+    // Parse symbol IDs
+    std::unordered_set<SymbolId> symbol_ids;
+    symbol_ids.reserve(count);
+    const uint8_t* ids = data + sizeof(SubscriptionHeader);
+    for (uint32_t i = 0; i < count; ++i) {
+        SymbolId symbol_id;
+        std::memcpy(&symbol_id, ids + size_t{i} * sizeof(SymbolId), sizeof(symbol_id));
+
+        // Validate symbol ID
+        if (symbol_map_.contains(symbol_id)) {
+            symbol_ids.insert(symbol_id);
+        } else {
+            MDFH_LOG_WARN_RL(10, "Unknown symbol ID in subscription: {}", symbol_id);
+        }
+    }
+
+    set_subscription(client, symbol_ids);
+}
+
+void Reactor::handle_resume_message(Client& client, const uint8_t* data, size_t len) {
+    uint32_t count;
+    std::memcpy(&count, data + 1, sizeof(count));
+
+    size_t expected_len = sizeof(SubscriptionHeader) + size_t{count} * sizeof(ResumeEntry);
+    if (len < expected_len) {
+        MDFH_LOG_WARN("Invalid resume message: expected {} bytes, got {}",
+                      expected_len, len);
+        return;
+    }
+
+    // Parse (symbol_id, last_seq) entries; the symbols form the new
+    // subscription. Replay points are kept per requested symbol, not in an
+    // array over the whole universe.
+    std::unordered_set<SymbolId> symbol_ids;
+    std::unordered_map<SymbolId, uint32_t> replay_after;
+    symbol_ids.reserve(count);
+    const uint8_t* entries = data + sizeof(SubscriptionHeader);
+    for (uint32_t i = 0; i < count; ++i) {
+        ResumeEntry entry;
+        std::memcpy(&entry, entries + size_t{i} * sizeof(ResumeEntry), sizeof(entry));
+
+        if (symbol_map_.contains(entry.symbol_id)) {
+            symbol_ids.insert(entry.symbol_id);
+            if (entry.last_seq != 0) {
+                replay_after[entry.symbol_id] = entry.last_seq;
+            }
+        } else {
+            MDFH_LOG_WARN_RL(10, "Unknown symbol ID in resume: {}", SymbolId{entry.symbol_id});
+        }
+    }
+
+    set_subscription(client, symbol_ids);
+    replay(client, replay_after);
+}
+
+void Reactor::replay(Client& client, const std::unordered_map<SymbolId, uint32_t>& replay_after) {
+    // Entries from log_pos_ on reach the client through normal fan-out; the
+    // replay covers what the log still holds before that. Parsing starts at
+    // a segment boundary, the only message boundary known without a cursor.
+    // The window is half the lag limit so the replayed backlog is not
+    // dropped as lapped while it drains.
+    const uint64_t end = log_pos_;
+    const uint64_t written = log_.written();
+    const uint64_t window = log_.lag_limit() / 2;
+    const uint64_t start = log_.segment_start(written > window ? written - window : 0);
+    if (start >= end || replay_after.empty()) {
+        return;
+    }
+
+    const size_t first_run = client.runs.size();
+    uint64_t replayed = 0;
+    bool overrun = false;
+    uint64_t pos = start;
+    while (pos < end) {
+        pos = log_.next_message_pos(pos);
+        if (pos >= end) {
+            break;
+        }
+
+        MessageHeader header;
+        std::memcpy(&header, log_.at(pos), sizeof(header));
+        size_t len = get_message_size(static_cast<MessageType>(header.msg_type));
+        if (len == 0) {
+            overrun = true;
+            break;
+        }
+
+        auto it = replay_after.find(header.symbol_id);
+        if (it != replay_after.end() && header.seq_num > it->second) {
+            append_run(client, pos, static_cast<uint32_t>(len));
+            replayed++;
+        }
+        pos += len;
+    }
+
+    if (overrun || !log_.is_valid(start)) {
+        // The writer lapped the scan; the client sees the gap instead
+        client.runs.resize(first_run);
+        bump(log_overruns_, 1);
+        MDFH_LOG_WARN_RL(10, "Replay for fd {} was overrun by the broadcast log writer", client.fd);
+        return;
+    }
+
+    bump(messages_sent_, replayed);
+    bump(messages_replayed_, replayed);
+    MDFH_LOG_INFO("Client {} resumed, replaying {} messages", client.fd, replayed);
+    if (replayed > 0 && !client.want_write) {
+        flush(client);
+    }
+}
+
+void Reactor::set_subscription(Client& client, const std::unordered_set<SymbolId>& symbol_ids) {
+    // Replace the previous subscription in the local fan-out index
+    for (SymbolId symbol_id : client.symbols) {
+        remove_subscriber(symbol_id, client);
+    }
+    client.symbols.assign(symbol_ids.begin(), symbol_ids.end());
+    for (SymbolId symbol_id : client.symbols) {
+        add_subscriber(symbol_id, client);
+    }
+
+    MDFH_LOG_INFO("Client {} subscribed to {} symbols", client.fd, symbol_ids.size());
+
+    // Mirror into the shared registry (inspection only, not used on the send path)
+    client_manager_.subscribe(client.fd, symbol_ids);
+}
+
+void Reactor::add_subscriber(SymbolId symbol_id, Client& client) {
+    uint32_t& list = subscriber_list_[symbol_map_.slot(symbol_id)];
+    if (list == NO_LIST) {
+        if (free_lists_.empty()) {
+            list = static_cast<uint32_t>(lists_.size());
+            lists_.emplace_back();
+        } else {
+            list = free_lists_.back();
+            free_lists_.pop_back();
+        }
+    }
+    lists_[list].push_back(&client);
+}
+
+void Reactor::remove_subscriber(SymbolId symbol_id, Client& client) {
+    uint32_t& list = subscriber_list_[symbol_map_.slot(symbol_id)];
+    if (list == NO_LIST) {
+        return;
+    }
+    auto& clients = lists_[list];
+    clients.erase(std::remove(clients.begin(), clients.end(), &client), clients.end());
+    if (clients.empty()) {
+        free_lists_.push_back(list);
+        list = NO_LIST;
+    }
+}
+
+void Reactor::remove_client(Client& client) {
+    if (client.timer != NO_TIMER) {
+        fault_timers_.cancel(client.timer);
+        timer_clients_[client.timer] = nullptr;
+        free_timers_.push_back(client.timer);
+    }
+    for (SymbolId symbol_id : client.symbols) {
+        remove_subscriber(symbol_id, client);
+    }
+
+    int fd = client.fd;
+    epoll_ctl(epoll_fd_, EPOLL_CTL_DEL, fd, nullptr);
+    close(fd);
+
+    client_manager_.remove_client(fd);
+    client_manager_.clear_subscriptions(fd);
+
+    MDFH_LOG_INFO("Client disconnected: {}", fd);
+    clients_.erase(fd);  // Destroys client
+}
+
+void Reactor::reap_dead_clients() {
+    if (!has_dead_clients_) {
+        return;
+    }
+    has_dead_clients_ = false;
+
+    std::vector<Client*> dead;
+    for (auto& [fd, client] : clients_) {
+        if (client->dead) {
+            dead.push_back(client.get());
+        }
+    }
+    for (Client* client : dead) {
+        remove_client(*client);
+    }
+    client_count_.store(clients_.size(), std::memory_order_relaxed);
+}
+
+} // namespace mdfh
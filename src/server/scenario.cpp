@@ -0,0 +1,116 @@
+#include "server/scenario.h"
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+
+namespace mdfh {
+
+namespace {
+
+std::string trim(const std::string& s) {
+    size_t begin = s.find_first_not_of(" \t\r");
+    if (begin == std::string::npos) {
+        return "";
+    }
+    size_t end = s.find_last_not_of(" \t\r");
+    return s.substr(begin, end - begin + 1);
+}
+
+} // namespace
+
+Scenario::Scenario(std::vector<ScenarioEvent> events)
+    : events_(std::move(events)) {
+    std::stable_sort(events_.begin(), events_.end(),
+                     [](const ScenarioEvent& a, const ScenarioEvent& b) { return a.time_us < b.time_us; });
+}
+
+Scenario Scenario::load(const std::string& file, size_t num_symbols) {
+    std::ifstream in(file);
+    if (!in.is_open()) {
+        throw std::runtime_error("Scenario file not found: " + file);
+    }
+
+    std::vector<ScenarioEvent> events;
+    std::string line;
+    size_t line_no = 0;
+    bool header = true;
+    while (std::getline(in, line)) {
+        line_no++;
+        line = trim(line.substr(0, line.find('#')));
+        if (line.empty()) continue;
+        if (header) {
+            header = false;     // time_ms,event,symbol,value
+            continue;
+        }
+
+        auto fail = [&](const std::string& what) {
+            return std::runtime_error(what + " in " + file + " line " + std::to_string(line_no));
+        };
+
+        std::vector<std::string> fields;
+        std::istringstream iss(line);
+        std::string field;
+        while (std::getline(iss, field, ',')) {
+            fields.push_back(trim(field));
+        }
+        if (fields.size() < 3) {
+            throw fail("Expected time_ms,event,symbol[,value]");
+        }
+
+        ScenarioEvent event{};
+        size_t used = 0;
+        double time_ms = 0.0;
+        try {
+            time_ms = std::stod(fields[0], &used);
+        } catch (const std::exception&) {
+            used = 0;
+        }
+        if (used != fields[0].size() || time_ms < 0.0) {
+            throw fail("Bad time");
+        }
+        event.time_us = static_cast<uint64_t>(time_ms * 1000.0 + 0.5);
+
+        const std::string& name = fields[1];
+        if (name == "rate") {
+            event.action = ScenarioAction::RATE;
+        } else if (name == "volatility") {
+            event.action = ScenarioAction::VOLATILITY;
+        } else if (name == "halt") {
+            event.action = ScenarioAction::HALT;
+        } else if (name == "resume") {
+            event.action = ScenarioAction::RESUME;
+        } else {
+            throw fail("Unknown event '" + name + "'");
+        }
+
+        if (fields[2] == "*") {
+            event.symbol_id = ALL_SYMBOLS;
+        } else {
+            char* end = nullptr;
+            long long id = std::strtoll(fields[2].c_str(), &end, 10);
+            if (fields[2].empty() || *end != '\0' || id < 0 || static_cast<unsigned long long>(id) >= num_symbols) {
+                throw fail("Bad symbol '" + fields[2] + "'");
+            }
+            event.symbol_id = id;
+        }
+
+        if (event.action == ScenarioAction::RATE || event.action == ScenarioAction::VOLATILITY) {
+            used = 0;
+            try {
+                event.value = fields.size() > 3 ? std::stod(fields[3], &used) : 0.0;
+            } catch (const std::exception&) {
+                used = 0;
+            }
+            if (fields.size() < 4 || used != fields[3].size() || event.value < 0.0) {
+                throw fail("Bad multiplier");
+            }
+        }
+        events.push_back(event);
+    }
+
+    return Scenario(std::move(events));
+}
+
+} // namespace mdfh
@@ -1,4 +1,6 @@
 #include "server/exchange_simulator.h"
+#include "common/tsc_clock.h"
+#include "common/trace.h"
 #include <iostream>
 #include <csignal>
 #include <atomic>
@@ -21,6 +23,14 @@ int main(int argc, char* argv[]) {
     // Install signal handler
     std::signal(SIGINT, signal_handler);
     std::signal(SIGTERM, signal_handler);
+#ifdef MDFH_TRACING
+    mdfh::Tracer::instance().set_thread_name("main");
+    // SIGUSR1 dumps the hot-path trace without stopping the server
+    std::signal(SIGUSR1, [](int) { mdfh::Tracer::instance().request_dump(); });
+#endif
+    
+    // Keep the TSC-to-nanosecond conversion calibrated while running
+    mdfh::TscClock::start_calibration_thread();
     
     try {
         // Parse command line arguments: port [num_symbols]
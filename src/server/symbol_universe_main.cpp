@@ -0,0 +1,34 @@
+#include "common/symbol_universe.h"
+#include <chrono>
+#include <cstdio>
+#include <exception>
+#include <iostream>
+
+// Converts a symbols CSV into a binary universe that the exchange server and
+// feed client map without parsing (point market.symbols_file at it).
+//
+// Usage:
+//   ./build/symbol_universe <symbols.csv> <universe.bin>
+
+int main(int argc, char* argv[]) {
+    if (argc != 3) {
+        std::cerr << "Usage: " << argv[0] << " <symbols.csv> <universe.bin>\n";
+        return 1;
+    }
+
+    try {
+        auto start = std::chrono::steady_clock::now();
+        mdfh::SymbolUniverse universe = mdfh::SymbolUniverse::load(argv[1]);
+        auto parsed = std::chrono::steady_clock::now();
+        universe.save(argv[2]);
+
+        std::printf("%zu symbols from %s -> %s (parsed in %.1f ms, %zu malformed rows skipped)\n",
+                    universe.size(), argv[1], argv[2],
+                    std::chrono::duration<double, std::milli>(parsed - start).count(),
+                    universe.get_skipped_rows());
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << "\n";
+        return 1;
+    }
+    return 0;
+}
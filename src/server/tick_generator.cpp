@@ -1,22 +1,35 @@
 #include "server/tick_generator.h"
 #include <cmath>
-#include <chrono>
+#include <random>
 
 namespace mdfh {
 
+namespace {
+
+uint64_t random_seed() {
+    std::random_device rd;
+    return static_cast<uint64_t>(rd()) << 32 | rd();
+}
+
+} // namespace
+
 TickGenerator::TickGenerator() 
-    : random_num_gen_(std::random_device{}()),
-      uniform_(0.0, 1.0),
-      has_spare_normal_(false),
-      spare_normal_(0.0) {
+    : TickGenerator(random_seed(), 0) {
+}
+
+TickGenerator::TickGenerator(uint64_t seed, uint32_t symbol_id)
+    : random_num_gen_(seed, RngStream::TICKS, symbol_id) {
 }
 
 double TickGenerator::generate_next_price(double current_price, double drift,
                                            double volatility, double dt) {
+    return gbm_step(current_price, drift, volatility, dt, random_num_gen_.normal());
+}
+
+double TickGenerator::gbm_step(double current_price, double drift,
+                               double volatility, double dt, double normal) {
     // dS = μ * S * dt + σ * S * dW
     // where dW = sqrt(dt) * N(0,1)
-    
-    double normal = generate_normal();
     double drift_component = drift * current_price * dt;
     double diffusion_component = volatility * current_price * std::sqrt(dt) * normal;
     
@@ -36,45 +49,20 @@ double TickGenerator::generate_spread(double price) {
     double max_spread_pct = 0.002;
     
     double spread_pct = min_spread_pct + 
-                        uniform_(random_num_gen_) * (max_spread_pct - min_spread_pct);
+                        random_num_gen_.uniform() * (max_spread_pct - min_spread_pct);
     
     return price * spread_pct;
 }
 
 uint32_t TickGenerator::generate_volume() {
     // Generate volume between 100 and 100,000
-    double log_volume = 2.0 + uniform_(random_num_gen_) * 3.0; // log10(100) to log10(100000)
+    double log_volume = 2.0 + random_num_gen_.uniform() * 3.0; // log10(100) to log10(100000)
     return static_cast<uint32_t>(std::pow(10.0, log_volume));
 }
 
 bool TickGenerator::should_generate_quote() {
     // 70% chance of generating quote, 30% trade
-    return uniform_(random_num_gen_) < 0.7;
-}
-
-double TickGenerator::generate_normal() {
-    // Box-Muller transform
-    if (has_spare_normal_) {
-        has_spare_normal_ = false;
-        return spare_normal_;
-    }
-    
-    double u1, u2;
-    do {
-        u1 = uniform_(random_num_gen_);
-    } while (u1 == 0.0); // Avoid log(0)
-    
-    u2 = uniform_(random_num_gen_);
-    
-    // Box-Muller: radius_factor = sqrt(-2*ln(u1)), then convert to Cartesian coordinates
-    double radius_factor = std::sqrt(-2.0 * std::log(u1));
-    double z0 = radius_factor * std::cos(2.0 * M_PI * u2);
-    double z1 = radius_factor * std::sin(2.0 * M_PI * u2);
-    
-    spare_normal_ = z1;
-    has_spare_normal_ = true;
-    
-    return z0;
+    return random_num_gen_.uniform() < 0.7;
 }
 
 } // namespace mdfh
@@ -0,0 +1,134 @@
+#include <gtest/gtest.h>
+#include "server/broadcast_log.h"
+#include <cstring>
+
+using namespace mdfh;
+
+class BroadcastLogTest : public ::testing::Test {
+protected:
+    static TradeMessage make_trade(uint32_t seq_num) {
+        TradeMessage trade{};
+        trade.header.msg_type = static_cast<uint16_t>(MessageType::TRADE);
+        trade.header.seq_num = seq_num;
+        trade.header.symbol_id = 7;
+        trade.checksum = calculate_checksum(&trade, sizeof(TradeMessage) - sizeof(uint32_t));
+        return trade;
+    }
+
+    static QuoteMessage make_quote(uint32_t seq_num) {
+        QuoteMessage quote{};
+        quote.header.msg_type = static_cast<uint16_t>(MessageType::QUOTE);
+        quote.header.seq_num = seq_num;
+        quote.checksum = calculate_checksum(&quote, sizeof(QuoteMessage) - sizeof(uint32_t));
+        return quote;
+    }
+};
+
+// Test: Capacity is rounded up to a power of 2 with a floor
+TEST_F(BroadcastLogTest, CapacityRounding) {
+    EXPECT_EQ(BroadcastLog(1).capacity(), BroadcastLog::MIN_CAPACITY);
+    EXPECT_EQ(BroadcastLog(BroadcastLog::MIN_CAPACITY + 1).capacity(), 2 * BroadcastLog::MIN_CAPACITY);
+    EXPECT_EQ(BroadcastLog(1 << 20).lag_limit(), (1u << 20) / 2);
+}
+
+// Test: Appended messages become visible only on commit
+TEST_F(BroadcastLogTest, CommitPublishesAppends) {
+    BroadcastLog log(BroadcastLog::MIN_CAPACITY);
+    TradeMessage trade = make_trade(1);
+
+    ASSERT_TRUE(log.append(&trade, sizeof(trade)));
+    EXPECT_EQ(log.head(), 0u);
+    EXPECT_EQ(log.written(), sizeof(trade));
+
+    log.commit();
+    EXPECT_EQ(log.head(), sizeof(trade));
+    EXPECT_EQ(std::memcmp(log.at(0), &trade, sizeof(trade)), 0);
+}
+
+// Test: Empty and oversized messages are rejected
+TEST_F(BroadcastLogTest, RejectsInvalidLengths) {
+    BroadcastLog log(BroadcastLog::MIN_CAPACITY);
+    uint8_t big[BroadcastLog::MAX_MESSAGE_SIZE + 1] = {};
+
+    EXPECT_FALSE(log.append(big, 0));
+    EXPECT_FALSE(log.append(big, sizeof(big)));
+    log.commit();
+    EXPECT_EQ(log.head(), 0u);
+}
+
+// Test: A message never straddles the end of the ring, and readers
+// find it with the same rule the writer used
+TEST_F(BroadcastLogTest, MessagesNeverStraddleTheWrap) {
+    BroadcastLog log(BroadcastLog::MIN_CAPACITY);
+    const size_t capacity = log.capacity();
+
+    uint64_t pos = 0;
+    uint32_t seq = 0;
+    while (pos < capacity + 1000) {
+        QuoteMessage quote = make_quote(++seq);
+        ASSERT_TRUE(log.append(&quote, sizeof(quote)));
+        log.commit();
+
+        uint64_t start = log.next_message_pos(pos);
+        ASSERT_EQ(start + sizeof(quote), log.head());
+        ASSERT_LE((start & (capacity - 1)) + sizeof(quote), capacity);
+
+        MessageHeader header;
+        std::memcpy(&header, log.at(start), sizeof(header));
+        ASSERT_EQ(header.seq_num, seq);
+        pos = log.head();
+    }
+    EXPECT_GT(pos, capacity);
+}
+
+// Test: Every segment start is a message boundary, so a reader without a
+// cursor can start parsing there
+TEST_F(BroadcastLogTest, SegmentStartsAreMessageBoundaries) {
+    BroadcastLog log(BroadcastLog::MIN_CAPACITY);
+    const uint64_t segment = log.capacity() / BroadcastLog::SEGMENTS;
+    EXPECT_EQ(log.segment_start(0), 0u);
+    EXPECT_EQ(log.segment_start(1), segment);
+    EXPECT_EQ(log.segment_start(segment), segment);
+
+    // Mixed sizes so the writer lands at every offset within a segment
+    uint32_t seq = 0;
+    while (log.written() < 3 * segment + 100) {
+        if (seq % 3 == 0) {
+            TradeMessage trade = make_trade(++seq);
+            ASSERT_TRUE(log.append(&trade, sizeof(trade)));
+        } else {
+            QuoteMessage quote = make_quote(++seq);
+            ASSERT_TRUE(log.append(&quote, sizeof(quote)));
+        }
+    }
+    log.commit();
+
+    for (uint64_t start = segment; start < 4 * segment; start += segment) {
+        MessageHeader header;
+        std::memcpy(&header, log.at(start), sizeof(header));
+        EXPECT_NE(get_message_size(static_cast<MessageType>(header.msg_type)), 0u) << start;
+        EXPECT_GT(header.seq_num, 0u);
+    }
+}
+
+// Test: Ranges stay valid until the writer laps them
+TEST_F(BroadcastLogTest, ValidityTracksOverwrites) {
+    BroadcastLog log(BroadcastLog::MIN_CAPACITY);
+    TradeMessage trade = make_trade(1);
+
+    ASSERT_TRUE(log.append(&trade, sizeof(trade)));
+    log.commit();
+    EXPECT_TRUE(log.is_valid(0));
+
+    while (log.written() <= log.capacity()) {
+        EXPECT_TRUE(log.is_valid(0));
+        ASSERT_TRUE(log.append(&trade, sizeof(trade)));
+    }
+    EXPECT_FALSE(log.is_valid(0));
+    EXPECT_TRUE(log.is_valid(log.written() - log.capacity()));
+}
+
+int main(int argc, char** argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -70,6 +70,42 @@ TEST_F(CacheTest, MultipleUpdates) {
     EXPECT_EQ(state.update_count, 3);
 }
 
+TEST_F(CacheTest, StaleFlagClearedByUpdate) {
+    cache->update_trade(3, 101.0, 10);
+    EXPECT_FALSE(cache->is_stale(3));
+    
+    cache->mark_stale(3);
+    EXPECT_TRUE(cache->is_stale(3));
+    EXPECT_TRUE(cache->get_snapshot(3).stale);
+    EXPECT_DOUBLE_EQ(cache->get_snapshot(3).last_traded_price, 101.0);  // Value kept
+    EXPECT_FALSE(cache->is_stale(4));
+    
+    cache->update_quote(3, 100.5, 1, 101.5, 1);
+    EXPECT_FALSE(cache->is_stale(3));
+}
+
+TEST_F(CacheTest, MarkAllStale) {
+    cache->mark_all_stale();
+    EXPECT_EQ(cache->get_stale_count(), 100u);
+    
+    cache->update_bid(0, 1500.25, 1000);
+    cache->update_trade(7, 99.0, 5);
+    EXPECT_EQ(cache->get_stale_count(), 98u);
+    EXPECT_FALSE(cache->is_stale(100));  // Out of range
+}
+
+TEST_F(CacheTest, MarkAllStalePastSixteenBitSlots) {
+    SymbolCache large(70000);
+    large.mark_all_stale();
+    EXPECT_EQ(large.get_stale_count(), 70000u);
+    EXPECT_TRUE(large.is_stale(69999));
+
+    large.update_bid(65536, 10.0, 1);
+    large.update_bid(69999, 10.0, 1);
+    EXPECT_EQ(large.get_stale_count(), 69998u);
+    EXPECT_TRUE(large.is_stale(0));
+}
+
 TEST_F(CacheTest, MultipleSymbols) {
     cache->update_bid(0, 1500.25, 1000);
     cache->update_bid(1, 2450.50, 1500);
@@ -1,5 +1,6 @@
 #include <gtest/gtest.h>
 #include "server/client_manager.h"
+#include <chrono>
 #include <thread>
 #include <vector>
 #include <algorithm>
@@ -394,7 +395,7 @@ TEST_F(ClientManagerTest, SubscribeSingleClient) {
     int fd = 10;
     manager_->add_client(fd);
     
-    std::unordered_set<uint16_t> symbols = {0, 1, 2};
+    std::unordered_set<SymbolId> symbols = {0, 1, 2};
     manager_->subscribe(fd, symbols);
     
     EXPECT_TRUE(manager_->is_subscribed(fd, 0));
@@ -545,7 +546,7 @@ TEST_F(ClientManagerTest, ManySubscriptions) {
     int fd = 10;
     manager_->add_client(fd);
     
-    std::unordered_set<uint16_t> symbols;
+    std::unordered_set<SymbolId> symbols;
     for (uint16_t i = 0; i < 1000; ++i) {
         symbols.insert(i);
     }
@@ -572,7 +573,7 @@ TEST_F(ClientManagerTest, ConcurrentSubscriptions) {
     for (int t = 0; t < num_threads; ++t) {
         threads.emplace_back([this, t, num_clients]() {
             for (int i = 0; i < num_clients; ++i) {
-                std::unordered_set<uint16_t> symbols;
+                std::unordered_set<SymbolId> symbols;
                 for (uint16_t s = t * 10; s < (t + 1) * 10; ++s) {
                     symbols.insert(s);
                 }
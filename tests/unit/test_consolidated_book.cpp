@@ -0,0 +1,376 @@
+#include <gtest/gtest.h>
+#include "common/consolidated_book.h"
+#include "server/exchange_simulator.h"
+#include "client/feed_handler.h"
+#include <fstream>
+#include <filesystem>
+#include <chrono>
+#include <thread>
+#include <atomic>
+#include <random>
+
+namespace fs = std::filesystem;
+
+namespace mdfh {
+
+class ConsolidatedBookTest : public ::testing::Test {
+protected:
+    static constexpr size_t NUM_SYMBOLS = 10;
+    static constexpr size_t NUM_VENUES = 3;
+};
+
+// Test: A symbol nobody has quoted is stale with no venue
+TEST_F(ConsolidatedBookTest, InitiallyStale) {
+    ConsolidatedBook book(NUM_SYMBOLS, NUM_VENUES);
+    auto snap = book.get_snapshot(0);
+
+    EXPECT_TRUE(snap.stale);
+    EXPECT_EQ(snap.bid_venue, ConsolidatedBook::NO_VENUE);
+    EXPECT_EQ(snap.ask_venue, ConsolidatedBook::NO_VENUE);
+    EXPECT_EQ(snap.update_count, 0u);
+}
+
+// Test: Best bid and best ask may come from different venues
+TEST_F(ConsolidatedBookTest, BestOfEachSideWithVenue) {
+    ConsolidatedBook book(NUM_SYMBOLS, NUM_VENUES);
+    book.update_quote(0, 1, 100.00, 500, 100.10, 400, 0);
+    book.update_quote(1, 1, 100.02, 300, 100.12, 200, 0);
+    book.update_quote(2, 1, 99.98, 900, 100.06, 100, 0);
+
+    auto snap = book.get_snapshot(1);
+    EXPECT_FALSE(snap.stale);
+    EXPECT_DOUBLE_EQ(snap.best_bid, 100.02);
+    EXPECT_EQ(snap.bid_quantity, 300u);
+    EXPECT_EQ(snap.bid_venue, 1);
+    EXPECT_DOUBLE_EQ(snap.best_ask, 100.06);
+    EXPECT_EQ(snap.ask_quantity, 100u);
+    EXPECT_EQ(snap.ask_venue, 2);
+    EXPECT_EQ(snap.update_count, 3u);
+}
+
+// Test: Size is aggregated over venues at the best price, and the venue
+// with the most size there is attributed
+TEST_F(ConsolidatedBookTest, AggregatesSizeAtBestPrice) {
+    ConsolidatedBook book(NUM_SYMBOLS, NUM_VENUES);
+    book.update_quote(0, 0, 50.00, 100, 50.05, 100, 0);
+    book.update_quote(1, 0, 50.00, 700, 50.05, 200, 0);
+    book.update_quote(2, 0, 50.00, 300, 50.10, 900, 0);
+
+    auto snap = book.get_snapshot(0);
+    EXPECT_EQ(snap.bid_quantity, 1100u);
+    EXPECT_EQ(snap.bid_venue_count, 3);
+    EXPECT_EQ(snap.bid_venue, 1);
+    EXPECT_EQ(snap.ask_quantity, 300u);
+    EXPECT_EQ(snap.ask_venue_count, 2);
+    EXPECT_EQ(snap.ask_venue, 1);
+}
+
+// Test: When the best venue backs off, the next best venue takes over
+TEST_F(ConsolidatedBookTest, BestVenueBacksOff) {
+    ConsolidatedBook book(NUM_SYMBOLS, NUM_VENUES);
+    book.update_quote(0, 2, 10.00, 100, 10.05, 100, 0);
+    book.update_quote(1, 2, 10.01, 100, 10.04, 100, 0);
+    EXPECT_EQ(book.get_snapshot(2).bid_venue, 1);
+
+    book.update_quote(1, 2, 9.95, 100, 10.09, 100, 0);
+    auto snap = book.get_snapshot(2);
+    EXPECT_DOUBLE_EQ(snap.best_bid, 10.00);
+    EXPECT_EQ(snap.bid_venue, 0);
+    EXPECT_DOUBLE_EQ(snap.best_ask, 10.05);
+    EXPECT_EQ(snap.ask_venue, 0);
+}
+
+// Test: An empty side on one venue does not hide the others
+TEST_F(ConsolidatedBookTest, EmptySideIgnored) {
+    ConsolidatedBook book(NUM_SYMBOLS, NUM_VENUES);
+    book.update_quote(0, 3, 20.00, 100, 0.0, 0, 0);
+    book.update_quote(1, 3, 0.0, 0, 20.10, 50, 0);
+
+    auto snap = book.get_snapshot(3);
+    EXPECT_DOUBLE_EQ(snap.best_bid, 20.00);
+    EXPECT_EQ(snap.bid_venue, 0);
+    EXPECT_DOUBLE_EQ(snap.best_ask, 20.10);
+    EXPECT_EQ(snap.ask_venue, 1);
+}
+
+// Test: A lost venue drops out of every symbol until it quotes again
+TEST_F(ConsolidatedBookTest, StaleVenueDropsOut) {
+    ConsolidatedBook book(NUM_SYMBOLS, NUM_VENUES);
+    book.update_quote(0, 4, 30.00, 100, 30.10, 100, 0);
+    book.update_quote(1, 4, 30.05, 100, 30.08, 100, 0);
+    book.update_quote(1, 5, 40.00, 100, 40.10, 100, 0);
+
+    book.mark_venue_stale(1);
+    auto snap = book.get_snapshot(4);
+    EXPECT_FALSE(snap.stale);
+    EXPECT_DOUBLE_EQ(snap.best_bid, 30.00);
+    EXPECT_EQ(snap.bid_venue, 0);
+    EXPECT_TRUE(book.get_snapshot(5).stale);
+
+    book.update_quote(1, 5, 40.01, 100, 40.09, 100, 0);
+    EXPECT_FALSE(book.get_snapshot(5).stale);
+    EXPECT_EQ(book.get_snapshot(5).bid_venue, 1);
+}
+
+// Test: Incremental updates agree with a full recompute over the venues,
+// including empty sides, ties and lost venues
+TEST_F(ConsolidatedBookTest, IncrementalMatchesFullRecompute) {
+    constexpr size_t VENUES = 4;
+    ConsolidatedBook book(1, VENUES);
+    struct Quote { double bid = 0, ask = 0; uint32_t bid_qty = 0, ask_qty = 0; bool live = false; };
+    Quote venues[VENUES];
+
+    std::mt19937 rng(7);
+    std::uniform_int_distribution<int> pick(0, VENUES - 1);
+    std::uniform_int_distribution<int> ticks(0, 4);
+    std::uniform_int_distribution<int> action(0, 19);
+
+    for (int i = 0; i < 20000; ++i) {
+        size_t v = static_cast<size_t>(pick(rng));
+        int a = action(rng);
+        if (a == 0) {
+            book.mark_venue_stale(v);
+            venues[v].live = false;
+        } else {
+            // Few price levels so ties are common; occasionally an empty side
+            Quote q;
+            q.bid = a == 1 ? 0.0 : 100.0 + ticks(rng) * 0.01;
+            q.bid_qty = a == 1 ? 0 : static_cast<uint32_t>(100 * (1 + ticks(rng)));
+            q.ask = a == 2 ? 0.0 : 100.05 + ticks(rng) * 0.01;
+            q.ask_qty = a == 2 ? 0 : static_cast<uint32_t>(100 * (1 + ticks(rng)));
+            q.live = true;
+            venues[v] = q;
+            book.update_quote(v, 0, q.bid, q.bid_qty, q.ask, q.ask_qty, 0);
+        }
+
+        double best_bid = 0.0, best_ask = 0.0;
+        uint32_t bid_qty = 0, ask_qty = 0;
+        bool any_live = false;
+        for (const auto& q : venues) {
+            if (!q.live) continue;
+            any_live = true;
+            if (q.bid_qty > 0 && q.bid > best_bid) { best_bid = q.bid; bid_qty = 0; }
+            if (q.ask_qty > 0 && (best_ask == 0.0 || q.ask < best_ask)) { best_ask = q.ask; ask_qty = 0; }
+        }
+        for (const auto& q : venues) {
+            if (!q.live) continue;
+            if (q.bid_qty > 0 && q.bid == best_bid) bid_qty += q.bid_qty;
+            if (q.ask_qty > 0 && q.ask == best_ask) ask_qty += q.ask_qty;
+        }
+
+        auto snap = book.get_snapshot(0);
+        ASSERT_EQ(snap.stale, !any_live) << "step " << i;
+        ASSERT_DOUBLE_EQ(snap.best_bid, best_bid) << "step " << i;
+        ASSERT_DOUBLE_EQ(snap.best_ask, best_ask) << "step " << i;
+        ASSERT_EQ(snap.bid_quantity, bid_qty) << "step " << i;
+        ASSERT_EQ(snap.ask_quantity, ask_qty) << "step " << i;
+        if (bid_qty > 0) {
+            ASSERT_DOUBLE_EQ(venues[snap.bid_venue].bid, best_bid) << "step " << i;
+        }
+        if (ask_qty > 0) {
+            ASSERT_DOUBLE_EQ(venues[snap.ask_venue].ask, best_ask) << "step " << i;
+        }
+    }
+}
+
+// Test: Out-of-range venue counts are rejected; out-of-range updates ignored
+TEST_F(ConsolidatedBookTest, InvalidArguments) {
+    EXPECT_THROW(ConsolidatedBook(NUM_SYMBOLS, 0), std::invalid_argument);
+    EXPECT_THROW(ConsolidatedBook(NUM_SYMBOLS, ConsolidatedBook::MAX_VENUES + 1), std::invalid_argument);
+
+    ConsolidatedBook book(NUM_SYMBOLS, NUM_VENUES);
+    book.update_quote(NUM_VENUES, 0, 1.0, 1, 2.0, 1, 0);
+    book.update_quote(0, NUM_SYMBOLS, 1.0, 1, 2.0, 1, 0);
+    EXPECT_TRUE(book.get_snapshot(0).stale);
+}
+
+// Test: A book over a symbol map takes wide ids and ignores unmapped ones
+TEST_F(ConsolidatedBookTest, WideSymbolIdsThroughMap) {
+    ConsolidatedBook book(SymbolMap(std::vector<SymbolId>{1000000, 5}), NUM_VENUES);
+    EXPECT_EQ(book.get_num_symbols(), 2u);
+
+    book.update_quote(0, 1000000, 10.00, 100, 10.10, 100, 0);
+    book.update_quote(2, 1000000, 10.02, 200, 10.12, 200, 0);
+    book.update_quote(1, 6, 20.00, 100, 20.10, 100, 0);
+
+    auto snap = book.get_snapshot(1000000);
+    EXPECT_FALSE(snap.stale);
+    EXPECT_DOUBLE_EQ(snap.best_bid, 10.02);
+    EXPECT_EQ(snap.bid_venue, 2);
+    EXPECT_DOUBLE_EQ(snap.best_ask, 10.10);
+    EXPECT_EQ(snap.ask_venue, 0);
+    EXPECT_TRUE(book.get_snapshot(5).stale);
+    EXPECT_TRUE(book.get_snapshot(6).stale);
+}
+
+// Test: Venue threads writing the same symbol never tear a snapshot and
+// no update is lost
+TEST_F(ConsolidatedBookTest, ConcurrentVenueWriters) {
+    ConsolidatedBook book(1, NUM_VENUES);
+    constexpr int UPDATES = 20000;
+    std::atomic<bool> done{false};
+
+    // Each venue quotes bid = venue + i, ask = bid + 1, sizes equal to the
+    // venue, so any consistent snapshot has ask - bid <= 1 and matching
+    // attribution
+    std::vector<std::thread> writers;
+    for (size_t v = 0; v < NUM_VENUES; ++v) {
+        writers.emplace_back([&book, v]() {
+            for (int i = 1; i <= UPDATES; ++i) {
+                double bid = static_cast<double>(i * 10 + v);
+                book.update_quote(v, 0, bid, static_cast<uint32_t>(v + 1), bid + 1.0,
+                                  static_cast<uint32_t>(v + 1), 0);
+            }
+        });
+    }
+
+    std::thread reader([&book, &done]() {
+        while (!done.load()) {
+            auto snap = book.get_snapshot(0);
+            if (snap.bid_venue != ConsolidatedBook::NO_VENUE && snap.bid_venue_count == 1) {
+                ASSERT_EQ(snap.bid_quantity, static_cast<uint32_t>(snap.bid_venue + 1));
+            }
+        }
+    });
+
+    for (auto& w : writers) {
+        w.join();
+    }
+    done = true;
+    reader.join();
+
+    auto snap = book.get_snapshot(0);
+    EXPECT_EQ(snap.update_count, NUM_VENUES * UPDATES);
+    EXPECT_DOUBLE_EQ(snap.best_bid, UPDATES * 10.0 + (NUM_VENUES - 1));
+    EXPECT_EQ(snap.bid_venue, NUM_VENUES - 1);
+}
+
+// End to end: one simulator per venue, one FeedHandler per venue, all
+// writing into the same consolidated book
+class ConsolidatedFeedTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        test_dir_ = "test_consolidated_temp";
+        fs::create_directories(test_dir_);
+        symbols_file_ = test_dir_ + "/symbols.csv";
+
+        std::ofstream symbols(symbols_file_);
+        symbols << "symbol_id,symbol,price,volatility,drift\n";
+        for (size_t i = 0; i < NUM_SYMBOLS; ++i) {
+            symbols << i << ",SYM" << i << "," << (100.0 + i) << ",0.02,0.01\n";
+        }
+        symbols.close();
+
+        for (size_t v = 0; v < NUM_VENUES; ++v) {
+            std::string config_file = test_dir_ + "/venue" + std::to_string(v) + ".conf";
+            std::ofstream config(config_file);
+            config << "server.port=" << (BASE_PORT + v) << "\n";
+            config << "market.num_symbols=" << NUM_SYMBOLS << "\n";
+            config << "market.tick_rate=0\n";
+            config << "market.symbols_file=" << fs::absolute(symbols_file_).string() << "\n";
+            config << "fault_injection.enabled=false\n";
+            config.close();
+            config_files_.push_back(config_file);
+        }
+    }
+
+    void TearDown() override {
+        if (fs::exists(test_dir_)) {
+            fs::remove_all(test_dir_);
+        }
+    }
+
+    static constexpr size_t NUM_SYMBOLS = 8;
+    static constexpr size_t NUM_VENUES = 3;
+    static constexpr uint16_t BASE_PORT = 12370;
+
+    std::string test_dir_;
+    std::string symbols_file_;
+    std::vector<std::string> config_files_;
+};
+
+// Test: The consolidated BBO matches the best over the venue caches
+TEST_F(ConsolidatedFeedTest, MatchesBestOfVenueCaches) {
+    ConsolidatedBook book(NUM_SYMBOLS, NUM_VENUES);
+    std::vector<std::unique_ptr<ExchangeSimulator>> sims;
+    std::vector<std::thread> event_threads;
+    std::vector<std::unique_ptr<FeedHandler>> handlers;
+
+    std::vector<SymbolId> symbols;
+    for (uint16_t i = 0; i < NUM_SYMBOLS; ++i) {
+        symbols.push_back(i);
+    }
+
+    for (size_t v = 0; v < NUM_VENUES; ++v) {
+        uint16_t port = static_cast<uint16_t>(BASE_PORT + v);
+        sims.push_back(std::make_unique<ExchangeSimulator>(port, NUM_SYMBOLS, config_files_[v]));
+        sims.back()->set_tick_rate(0);
+        sims.back()->start();
+        ExchangeSimulator* sim = sims.back().get();
+        event_threads.emplace_back([sim]() { sim->run(); });
+
+        handlers.push_back(std::make_unique<FeedHandler>("127.0.0.1", port, NUM_SYMBOLS));
+        handlers.back()->set_consolidated_book(&book, v);
+        ASSERT_TRUE(handlers.back()->start());
+        ASSERT_TRUE(handlers.back()->subscribe(symbols));
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+
+    constexpr uint64_t TICKS_PER_VENUE = 500;
+    for (uint64_t i = 0; i < TICKS_PER_VENUE; ++i) {
+        for (auto& sim : sims) {
+            sim->generate_tick(static_cast<uint16_t>(i % NUM_SYMBOLS));
+        }
+    }
+
+    auto all_received = [&handlers]() {
+        for (auto& h : handlers) {
+            if (h->get_messages_received() < TICKS_PER_VENUE) return false;
+        }
+        return true;
+    };
+    for (int i = 0; i < 300 && !all_received(); ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    ASSERT_TRUE(all_received());
+
+    for (uint16_t s = 0; s < NUM_SYMBOLS; ++s) {
+        double best_bid = 0.0;
+        double best_ask = 0.0;
+        for (auto& h : handlers) {
+            MarketSnapshot venue = h->get_cache().get_snapshot(s);
+            if (venue.bid_quantity > 0 && venue.best_bid > best_bid) {
+                best_bid = venue.best_bid;
+            }
+            if (venue.ask_quantity > 0 && venue.best_ask > 0.0 &&
+                (best_ask == 0.0 || venue.best_ask < best_ask)) {
+                best_ask = venue.best_ask;
+            }
+        }
+
+        auto snap = book.get_snapshot(s);
+        EXPECT_DOUBLE_EQ(snap.best_bid, best_bid) << "symbol " << s;
+        EXPECT_DOUBLE_EQ(snap.best_ask, best_ask) << "symbol " << s;
+        if (best_bid > 0.0) {
+            ASSERT_LT(snap.bid_venue, NUM_VENUES);
+            EXPECT_DOUBLE_EQ(handlers[snap.bid_venue]->get_cache().get_snapshot(s).best_bid, best_bid);
+        }
+    }
+
+    for (auto& h : handlers) {
+        h->stop();
+    }
+    for (auto& sim : sims) {
+        sim->stop();
+    }
+    for (auto& t : event_threads) {
+        t.join();
+    }
+}
+
+} // namespace mdfh
+
+int main(int argc, char** argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
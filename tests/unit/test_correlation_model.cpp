@@ -0,0 +1,220 @@
+#include <gtest/gtest.h>
+#include "server/correlation_model.h"
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+namespace mdfh {
+
+class CorrelationModelTest : public ::testing::Test {
+protected:
+    static constexpr size_t DRAWS = 100000;
+
+    // Sample correlation matrix of many draws (n x n, row-major)
+    static std::vector<double> sample_correlation(CorrelationModel& model) {
+        size_t n = model.get_num_symbols();
+        std::vector<double> x(n), sum(n, 0.0), cross(n * n, 0.0);
+        for (size_t d = 0; d < DRAWS; ++d) {
+            model.draw(x.data());
+            for (size_t i = 0; i < n; ++i) {
+                sum[i] += x[i];
+                for (size_t j = 0; j < n; ++j) cross[i * n + j] += x[i] * x[j];
+            }
+        }
+        std::vector<double> cov(n * n);
+        for (size_t i = 0; i < n; ++i) {
+            for (size_t j = 0; j < n; ++j) {
+                cov[i * n + j] = cross[i * n + j] / DRAWS - (sum[i] / DRAWS) * (sum[j] / DRAWS);
+            }
+        }
+        std::vector<double> corr(n * n);
+        for (size_t i = 0; i < n; ++i) {
+            for (size_t j = 0; j < n; ++j) {
+                corr[i * n + j] = cov[i * n + j] / std::sqrt(cov[i * n + i] * cov[j * n + j]);
+            }
+        }
+        return corr;
+    }
+};
+
+// Test: Draws through the Cholesky factor reproduce the target correlation
+// and have unit variance (n not a multiple of the SIMD width)
+TEST_F(CorrelationModelTest, FullMatrixReproducesCorrelation) {
+    const size_t n = 5;
+    std::vector<double> target = {
+        1.0,  0.8,  0.3, -0.2, 0.0,
+        0.8,  1.0,  0.4, -0.1, 0.0,
+        0.3,  0.4,  1.0,  0.5, 0.1,
+       -0.2, -0.1,  0.5,  1.0, 0.2,
+        0.0,  0.0,  0.1,  0.2, 1.0,
+    };
+    auto model = CorrelationModel::full(n, target, 1);
+    EXPECT_EQ(model.get_kind(), CorrelationModel::Kind::FULL);
+
+    auto corr = sample_correlation(model);
+    for (size_t i = 0; i < n * n; ++i) {
+        EXPECT_NEAR(corr[i], target[i], 0.02) << "entry " << i / n << "," << i % n;
+    }
+
+    // Variance check on the first symbol
+    std::vector<double> x(n);
+    double sq = 0.0;
+    for (size_t d = 0; d < DRAWS; ++d) {
+        model.draw(x.data());
+        sq += x[0] * x[0];
+    }
+    EXPECT_NEAR(sq / DRAWS, 1.0, 0.03);
+}
+
+// Test: A factor model's draws have correlation B_i . B_j
+TEST_F(CorrelationModelTest, FactorModelImpliedCorrelation) {
+    const size_t n = 6, k = 2;
+    std::vector<double> loadings = {
+        0.7, 0.5,
+        0.7, 0.5,
+        0.7, -0.5,
+        0.3, 0.0,
+        0.0, 0.9,
+        0.0, 0.0,
+    };
+    auto model = CorrelationModel::factor(n, k, loadings, 2);
+    EXPECT_EQ(model.get_num_factors(), k);
+
+    auto corr = sample_correlation(model);
+    for (size_t i = 0; i < n; ++i) {
+        for (size_t j = 0; j < n; ++j) {
+            double expected = i == j ? 1.0
+                : loadings[i * k] * loadings[j * k] + loadings[i * k + 1] * loadings[j * k + 1];
+            EXPECT_NEAR(corr[i * n + j], expected, 0.02) << "entry " << i << "," << j;
+        }
+    }
+}
+
+// Test: The same seed gives the same draws
+TEST_F(CorrelationModelTest, Deterministic) {
+    std::vector<double> c = {1.0, 0.5, 0.5, 1.0};
+    auto a = CorrelationModel::full(2, c, 99);
+    auto b = CorrelationModel::full(2, c, 99);
+    double xa[2], xb[2];
+    for (int i = 0; i < 100; ++i) {
+        a.draw(xa);
+        b.draw(xb);
+        ASSERT_EQ(xa[0], xb[0]);
+        ASSERT_EQ(xa[1], xb[1]);
+    }
+}
+
+// Test: Invalid models are rejected
+TEST_F(CorrelationModelTest, InvalidModels) {
+    // Not positive definite (|rho| > 1)
+    EXPECT_THROW(CorrelationModel::full(2, {1.0, 1.5, 1.5, 1.0}, 1), std::invalid_argument);
+    // Not symmetric
+    EXPECT_THROW(CorrelationModel::full(2, {1.0, 0.5, 0.2, 1.0}, 1), std::invalid_argument);
+    // Wrong size
+    EXPECT_THROW(CorrelationModel::full(3, {1.0, 0.0, 0.0, 1.0}, 1), std::invalid_argument);
+    // Loadings explaining more than the variance
+    EXPECT_THROW(CorrelationModel::factor(1, 2, {0.8, 0.8}, 1), std::invalid_argument);
+}
+
+// Test: Loading from CSV; unlisted symbols are uncorrelated
+TEST_F(CorrelationModelTest, LoadFromFile) {
+    fs::path dir = fs::temp_directory_path() / "mdfh_correlation_test";
+    fs::create_directories(dir);
+    std::string factors = (dir / "factors.csv").string();
+    {
+        std::ofstream f(factors);
+        f << "symbol_id,market,sector\n";
+        f << "0,0.8,0.3\n";
+        f << "2,0.8,0.3\n";
+    }
+    auto model = CorrelationModel::load(factors, CorrelationModel::Kind::FACTOR, 3, 5);
+    EXPECT_EQ(model.get_num_factors(), 2u);
+    auto corr = sample_correlation(model);
+    EXPECT_NEAR(corr[0 * 3 + 2], 0.73, 0.02);
+    EXPECT_NEAR(corr[0 * 3 + 1], 0.0, 0.02);
+
+    std::string matrix = (dir / "matrix.csv").string();
+    {
+        std::ofstream f(matrix);
+        f << "symbol_id,a,b\n";
+        f << "0,1.0,0.6\n";
+        f << "1,0.6,1.0\n";
+    }
+    auto full = CorrelationModel::load(matrix, CorrelationModel::Kind::FULL, 2, 5);
+    EXPECT_NEAR(sample_correlation(full)[1], 0.6, 0.02);
+
+    // Matrix width must match the universe; malformed rows and missing files throw
+    EXPECT_THROW(CorrelationModel::load(matrix, CorrelationModel::Kind::FULL, 3, 5), std::runtime_error);
+    {
+        std::ofstream f(factors);
+        f << "symbol_id,market\n";
+        f << "0,abc\n";
+    }
+    EXPECT_THROW(CorrelationModel::load(factors, CorrelationModel::Kind::FACTOR, 3, 5), std::runtime_error);
+    EXPECT_THROW(CorrelationModel::load((dir / "missing.csv").string(), CorrelationModel::Kind::FACTOR, 3, 5),
+                 std::runtime_error);
+
+    fs::remove_all(dir);
+}
+
+// Test: Over a symbol map the model has one row per mapped symbol, in slot
+// order, and rows for other ids are ignored
+TEST_F(CorrelationModelTest, LoadOverSymbolMap) {
+    fs::path dir = fs::temp_directory_path() / "mdfh_correlation_map_test";
+    fs::create_directories(dir);
+    std::string factors = (dir / "factors.csv").string();
+    {
+        std::ofstream f(factors);
+        f << "symbol_id,market,sector\n";
+        f << "3000000000,0.8,0.3\n";
+        f << "42,0.8,0.3\n";          // Not in the map
+        f << "1000000,0.8,0.3\n";
+    }
+    SymbolMap symbols(std::vector<SymbolId>{1000000, 5, 3000000000u});
+    auto model = CorrelationModel::load(factors, CorrelationModel::Kind::FACTOR, symbols, 5);
+    EXPECT_EQ(model.get_num_symbols(), 3u);
+    auto corr = sample_correlation(model);
+    EXPECT_NEAR(corr[0 * 3 + 2], 0.73, 0.02);
+    EXPECT_NEAR(corr[0 * 3 + 1], 0.0, 0.02);
+    EXPECT_NEAR(corr[1 * 3 + 2], 0.0, 0.02);
+
+    {
+        std::ofstream f(factors);
+        f << "symbol_id,market\n";
+        f << "99999999999,0.5\n";     // Past the SymbolId range
+    }
+    EXPECT_THROW(CorrelationModel::load(factors, CorrelationModel::Kind::FACTOR, symbols, 5),
+                 std::runtime_error);
+
+    fs::remove_all(dir);
+}
+
+// Test: Larger universes use the same kernel across many SIMD blocks
+TEST_F(CorrelationModelTest, LargeUniverseVariance) {
+    const size_t n = 203;
+    std::vector<double> c(n * n, 0.25);
+    for (size_t i = 0; i < n; ++i) c[i * n + i] = 1.0;
+    auto model = CorrelationModel::full(n, c, 3);
+
+    std::vector<double> x(n);
+    double sq_last = 0.0, cross = 0.0;
+    const size_t draws = 20000;
+    for (size_t d = 0; d < draws; ++d) {
+        model.draw(x.data());
+        sq_last += x[n - 1] * x[n - 1];
+        cross += x[0] * x[n - 1];
+    }
+    EXPECT_NEAR(sq_last / draws, 1.0, 0.05);
+    EXPECT_NEAR(cross / draws, 0.25, 0.05);
+}
+
+} // namespace mdfh
+
+int main(int argc, char** argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -8,9 +8,12 @@
 #include <thread>
 #include <sys/socket.h>
 #include <netinet/in.h>
+#include <netinet/tcp.h>
 #include <arpa/inet.h>
 #include <unistd.h>
 #include <cstring>
+#include <cmath>
+#include <numeric>
 
 namespace fs = std::filesystem;
 
@@ -92,6 +95,34 @@ protected:
         file.close();
     }
 
+    // Helper to connect a raw client subscribed to symbol 0
+    int connect_subscriber(uint16_t port) {
+        int fd = socket(AF_INET, SOCK_STREAM, 0);
+        struct sockaddr_in addr{};
+        addr.sin_family = AF_INET;
+        addr.sin_port = htons(port);
+        addr.sin_addr.s_addr = inet_addr("127.0.0.1");
+        if (fd < 0 || connect(fd, (struct sockaddr*)&addr, sizeof(addr)) != 0) {
+            return -1;
+        }
+        uint8_t sub_msg[] = {0xFF, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00};
+        send(fd, sub_msg, sizeof(sub_msg), 0);
+        return fd;
+    }
+
+    // Helper to read until the connection is closed or idle for timeout_ms
+    std::vector<uint8_t> drain_socket(int fd, int timeout_ms) {
+        struct timeval tv{timeout_ms / 1000, (timeout_ms % 1000) * 1000};
+        setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv));
+        std::vector<uint8_t> stream;
+        uint8_t buffer[65536];
+        ssize_t n;
+        while ((n = recv(fd, buffer, sizeof(buffer), 0)) > 0) {
+            stream.insert(stream.end(), buffer, buffer + n);
+        }
+        return stream;
+    }
+
     std::string test_dir_;
     std::string config_dir_;
 };
@@ -373,6 +404,52 @@ TEST_F(ExchangeSimulatorTest, GenerateTickWithInvalidSymbolId) {
     }
 }
 
+// Test: A few ids scattered over the whole id space are loaded without
+// per-id state; ticks go to loaded ids and unloaded ids are ignored.
+// num_symbols caps how many symbols load, not how large an id may be.
+TEST_F(ExchangeSimulatorTest, SparseSymbolIds) {
+    std::string symbol_file = config_dir_ + "/sparse_symbols.csv";
+    {
+        std::ofstream file(symbol_file);
+        file << "symbol_id,symbol,price,volatility,drift\n";
+        file << "60000,FAR,100.0,0.02,0.01\n";
+        file << "7,NEAR,200.0,0.02,0.01\n";
+        file << "60000,DUP,300.0,0.02,0.01\n";       // Duplicate id, skipped
+        file << "4000000000,WIDE,400.0,0.02,0.01\n";
+        file << "9,OVER,500.0,0.02,0.01\n";          // Past num_symbols, skipped
+    }
+    std::string config_file = create_test_config(symbol_file, 0, 3);
+    
+    ExchangeSimulator sim(0, 3, config_file);
+    ASSERT_EQ(sim.get_num_loaded_symbols(), 3u);
+    EXPECT_EQ(sim.get_symbol(0).symbol_name, "FAR");
+    EXPECT_EQ(sim.get_symbol(1).symbol_name, "NEAR");
+    EXPECT_EQ(sim.get_symbol(2).symbol_name, "WIDE");
+    
+    // The id map is a few pages, not a 16 GB array over the id space
+    const SymbolMap& map = sim.get_symbol_map();
+    EXPECT_EQ(map.slot(60000), 0u);
+    EXPECT_EQ(map.slot(7), 1u);
+    EXPECT_EQ(map.slot(4000000000u), 2u);
+    EXPECT_FALSE(map.contains(9));
+    EXPECT_LT(map.memory_bytes(), 2u * 1024 * 1024);
+    
+    sim.generate_tick(60000);
+    sim.generate_tick(60000);
+    sim.generate_tick(4000000000u);
+    sim.generate_tick(8);       // Not loaded
+    sim.generate_tick(9);
+    EXPECT_EQ(sim.get_symbol(0).seq_num, 2u);
+    EXPECT_EQ(sim.get_symbol(1).seq_num, 0u);
+    EXPECT_EQ(sim.get_symbol(2).seq_num, 1u);
+    
+    OrderRequest order{};
+    order.symbol_id = 8;
+    order.quantity = 100;
+    order.type = OrderType::MARKET;
+    EXPECT_EQ(sim.submit_order(order).reject_reason, RejectReason::UNKNOWN_SYMBOL);
+}
+
 // Test Case 11: Fault Injection Enable/Disable
 TEST_F(ExchangeSimulatorTest, FaultInjectionToggle) {
     std::string symbol_file = config_dir_ + "/symbols.csv";
@@ -560,12 +637,14 @@ TEST_F(ExchangeSimulatorTest, BroadcastMessageConnectivity) {
         // Send subscription for symbol 0 (required for subscription-only mode)
         std::vector<uint8_t> sub_msg;
         sub_msg.push_back(0xFF); // Subscribe command
-        uint16_t count = 1;
-        sub_msg.push_back(count & 0xFF);
-        sub_msg.push_back((count >> 8) & 0xFF);
-        uint16_t symbol_id = 0;
-        sub_msg.push_back(symbol_id & 0xFF);
-        sub_msg.push_back((symbol_id >> 8) & 0xFF);
+        uint32_t count = 1;
+        for (int shift = 0; shift < 32; shift += 8) {
+            sub_msg.push_back((count >> shift) & 0xFF);
+        }
+        SymbolId symbol_id = 0;
+        for (int shift = 0; shift < 32; shift += 8) {
+            sub_msg.push_back((symbol_id >> shift) & 0xFF);
+        }
         ssize_t sent = send(client_fd, sub_msg.data(), sub_msg.size(), 0);
         ASSERT_EQ(sent, static_cast<ssize_t>(sub_msg.size())) << "Failed to send subscription";
         
@@ -663,12 +742,14 @@ TEST_F(ExchangeSimulatorTest, BroadcastQuoteMessageCorrectness) {
         // Send subscription for symbol 0 (required for subscription-only mode)
         std::vector<uint8_t> sub_msg;
         sub_msg.push_back(0xFF); // Subscribe command
-        uint16_t count = 1;
-        sub_msg.push_back(count & 0xFF);
-        sub_msg.push_back((count >> 8) & 0xFF);
-        uint16_t symbol_id = 0;
-        sub_msg.push_back(symbol_id & 0xFF);
-        sub_msg.push_back((symbol_id >> 8) & 0xFF);
+        uint32_t count = 1;
+        for (int shift = 0; shift < 32; shift += 8) {
+            sub_msg.push_back((count >> shift) & 0xFF);
+        }
+        SymbolId symbol_id = 0;
+        for (int shift = 0; shift < 32; shift += 8) {
+            sub_msg.push_back((symbol_id >> shift) & 0xFF);
+        }
         send(client_fd, sub_msg.data(), sub_msg.size(), 0);
         std::this_thread::sleep_for(std::chrono::milliseconds(100));
         
@@ -773,12 +854,14 @@ TEST_F(ExchangeSimulatorTest, BroadcastTradeMessageCorrectness) {
         // Send subscription for symbol 0 (required for subscription-only mode)
         std::vector<uint8_t> sub_msg;
         sub_msg.push_back(0xFF); // Subscribe command
-        uint16_t count = 1;
-        sub_msg.push_back(count & 0xFF);
-        sub_msg.push_back((count >> 8) & 0xFF);
-        uint16_t symbol_id = 0;
-        sub_msg.push_back(symbol_id & 0xFF);
-        sub_msg.push_back((symbol_id >> 8) & 0xFF);
+        uint32_t count = 1;
+        for (int shift = 0; shift < 32; shift += 8) {
+            sub_msg.push_back((count >> shift) & 0xFF);
+        }
+        SymbolId symbol_id = 0;
+        for (int shift = 0; shift < 32; shift += 8) {
+            sub_msg.push_back((symbol_id >> shift) & 0xFF);
+        }
         send(client_fd, sub_msg.data(), sub_msg.size(), 0);
         std::this_thread::sleep_for(std::chrono::milliseconds(100));
         
@@ -956,12 +1039,14 @@ TEST_F(ExchangeSimulatorTest, HandleNewConnection) {
         // Send subscription for symbol 0 from client1 (required for subscription-only mode)
         std::vector<uint8_t> sub_msg;
         sub_msg.push_back(0xFF); // Subscribe command
-        uint16_t count = 1;
-        sub_msg.push_back(count & 0xFF);
-        sub_msg.push_back((count >> 8) & 0xFF);
-        uint16_t symbol_id = 0;
-        sub_msg.push_back(symbol_id & 0xFF);
-        sub_msg.push_back((symbol_id >> 8) & 0xFF);
+        uint32_t count = 1;
+        for (int shift = 0; shift < 32; shift += 8) {
+            sub_msg.push_back((count >> shift) & 0xFF);
+        }
+        SymbolId symbol_id = 0;
+        for (int shift = 0; shift < 32; shift += 8) {
+            sub_msg.push_back((symbol_id >> shift) & 0xFF);
+        }
         send(client1_fd, sub_msg.data(), sub_msg.size(), 0);
         std::this_thread::sleep_for(std::chrono::milliseconds(100));
         
@@ -1034,12 +1119,14 @@ TEST_F(ExchangeSimulatorTest, HandleClientDisconnect) {
         // Send subscription for symbol 0 from clients 1 and 2 (required for subscription-only mode)
         std::vector<uint8_t> sub_msg;
         sub_msg.push_back(0xFF); // Subscribe command
-        uint16_t count = 1;
-        sub_msg.push_back(count & 0xFF);
-        sub_msg.push_back((count >> 8) & 0xFF);
-        uint16_t symbol_id = 0;
-        sub_msg.push_back(symbol_id & 0xFF);
-        sub_msg.push_back((symbol_id >> 8) & 0xFF);
+        uint32_t count = 1;
+        for (int shift = 0; shift < 32; shift += 8) {
+            sub_msg.push_back((count >> shift) & 0xFF);
+        }
+        SymbolId symbol_id = 0;
+        for (int shift = 0; shift < 32; shift += 8) {
+            sub_msg.push_back((symbol_id >> shift) & 0xFF);
+        }
         
         // Subscribe clients 1 and 2 (not client 0, which we'll disconnect)
         send(client_fds[1], sub_msg.data(), sub_msg.size(), 0);
@@ -1153,15 +1240,17 @@ TEST_F(ExchangeSimulatorTest, ClientManagerIntegration) {
         // Verify client is tracked by ClientManager
         EXPECT_EQ(sim.get_num_connected_clients(), 1) << "One client connected";
         
-        // Send subscription message: command(1) + count(2) + symbol_ids(2*n)
+        // Send subscription message: command(1) + count(4) + symbol_ids(4*n)
         std::vector<uint8_t> sub_msg;
         sub_msg.push_back(0xFF); // Subscribe command
-        sub_msg.push_back(2);    // count low byte (2 symbols)
-        sub_msg.push_back(0);    // count high byte
-        sub_msg.push_back(0);    // symbol 0 low byte
-        sub_msg.push_back(0);    // symbol 0 high byte
-        sub_msg.push_back(1);    // symbol 1 low byte
-        sub_msg.push_back(0);    // symbol 1 high byte
+        for (uint8_t byte : {2, 0, 0, 0}) {
+            sub_msg.push_back(byte);  // count (2 symbols), little-endian
+        }
+        for (SymbolId symbol_id : {0u, 1u}) {
+            for (int shift = 0; shift < 32; shift += 8) {
+                sub_msg.push_back((symbol_id >> shift) & 0xFF);
+            }
+        }
         
         ssize_t sent = send(sock, sub_msg.data(), sub_msg.size(), 0);
         EXPECT_EQ(sent, static_cast<ssize_t>(sub_msg.size()));
@@ -1195,6 +1284,921 @@ TEST_F(ExchangeSimulatorTest, ClientManagerIntegration) {
     }
 }
 
+// Test: Send-side statistics
+TEST_F(ExchangeSimulatorTest, ServerStatsCountSends) {
+    std::string symbol_file = config_dir_ + "/symbols.csv";
+    create_valid_symbol_file(symbol_file, 3);
+    std::string config_file = create_test_config(symbol_file, 12349, 3, 0);  // tick_rate=0
+    
+    try {
+        ExchangeSimulator sim(12349, 3, config_file);
+        sim.set_tick_rate(0);
+        
+        // No clients: generated but not sent
+        sim.generate_tick(0);
+        ServerStats stats = sim.get_stats();
+        EXPECT_EQ(stats.messages_generated, 1);
+        EXPECT_EQ(stats.messages_sent, 0);
+        
+        sim.start();
+        std::thread event_thread([&sim]() {
+            sim.run();
+        });
+        
+        int client_fd = socket(AF_INET, SOCK_STREAM, 0);
+        ASSERT_GE(client_fd, 0);
+        struct sockaddr_in server_addr{};
+        server_addr.sin_family = AF_INET;
+        server_addr.sin_port = htons(12349);
+        server_addr.sin_addr.s_addr = inet_addr("127.0.0.1");
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        ASSERT_EQ(connect(client_fd, (struct sockaddr*)&server_addr, sizeof(server_addr)), 0);
+        
+        uint8_t sub_msg[] = {0xFF, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00};  // Subscribe to symbol 0
+        ASSERT_EQ(send(client_fd, sub_msg, sizeof(sub_msg), 0), static_cast<ssize_t>(sizeof(sub_msg)));
+        
+        // Ticks generated before the reactor registers the subscription
+        // would not be sent, so wait for it rather than for a fixed time
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+        auto subscribed = [&sim]() {
+            auto fds = sim.get_client_fds();
+            return fds.size() == 1 && sim.is_client_subscribed(fds[0], 0);
+        };
+        while (!subscribed() && std::chrono::steady_clock::now() < deadline) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        }
+        ASSERT_TRUE(subscribed());
+        
+        for (int i = 0; i < 10; ++i) {
+            sim.generate_tick(0);
+        }
+        sim.generate_tick(1);  // Not subscribed
+        
+        // Reactors fan out asynchronously
+        deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+        auto sent_all = [&sim]() {
+            ServerStats current = sim.get_stats();
+            return current.messages_sent >= 10 && current.bytes_sent >= 10 * sizeof(TradeMessage);
+        };
+        while (!sent_all() && std::chrono::steady_clock::now() < deadline) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        }
+        stats = sim.get_stats();
+        EXPECT_EQ(stats.messages_generated, 12);
+        EXPECT_EQ(stats.messages_sent, 10);
+        EXPECT_GE(stats.bytes_sent, 10 * sizeof(TradeMessage));
+        EXPECT_EQ(stats.send_failures, 0);
+        EXPECT_EQ(stats.slow_consumer_events, 0);
+        EXPECT_EQ(stats.partial_sends, 0);
+        EXPECT_EQ(stats.log_overruns, 0);
+        
+        close(client_fd);
+        sim.stop();
+        event_thread.join();
+    } catch (const std::exception& e) {
+        FAIL() << "Exception thrown: " << e.what();
+    }
+}
+
+// Test: Clients are spread across reactors and each gets its own symbols
+TEST_F(ExchangeSimulatorTest, ClientsSpreadAcrossReactors) {
+    std::string symbol_file = config_dir_ + "/symbols.csv";
+    create_valid_symbol_file(symbol_file, 4);
+    std::string config_file = create_test_config(symbol_file, 12350, 4, 0);
+    
+    try {
+        ExchangeSimulator sim(12350, 4, config_file);
+        sim.set_tick_rate(0);
+        sim.set_num_reactors(2);
+        sim.start();
+        EXPECT_EQ(sim.get_num_reactors(), 2);
+        std::thread event_thread([&sim]() {
+            sim.run();
+        });
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        
+        // Client i subscribes to symbol i
+        std::vector<int> clients;
+        for (uint8_t i = 0; i < 4; ++i) {
+            int fd = socket(AF_INET, SOCK_STREAM, 0);
+            ASSERT_GE(fd, 0);
+            struct sockaddr_in addr{};
+            addr.sin_family = AF_INET;
+            addr.sin_port = htons(12350);
+            addr.sin_addr.s_addr = inet_addr("127.0.0.1");
+            ASSERT_EQ(connect(fd, (struct sockaddr*)&addr, sizeof(addr)), 0);
+            uint8_t sub_msg[] = {0xFF, 0x01, 0x00, 0x00, 0x00, i, 0x00, 0x00, 0x00};
+            send(fd, sub_msg, sizeof(sub_msg), 0);
+            clients.push_back(fd);
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(200));
+        EXPECT_EQ(sim.get_num_connected_clients(), 4);
+        
+        for (uint16_t symbol = 0; symbol < 4; ++symbol) {
+            sim.generate_tick(symbol);
+        }
+        
+        struct timeval tv{1, 0};
+        for (uint16_t i = 0; i < 4; ++i) {
+            setsockopt(clients[i], SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv));
+            uint8_t buffer[sizeof(QuoteMessage)];
+            ssize_t bytes = recv(clients[i], buffer, sizeof(MessageHeader), MSG_WAITALL);
+            ASSERT_EQ(bytes, static_cast<ssize_t>(sizeof(MessageHeader)));
+            MessageHeader header;
+            std::memcpy(&header, buffer, sizeof(header));
+            EXPECT_EQ(header.symbol_id, i) << "Client " << i << " got another symbol";
+        }
+        
+        for (int fd : clients) {
+            close(fd);
+        }
+        sim.stop();
+        event_thread.join();
+    } catch (const std::exception& e) {
+        FAIL() << "Exception thrown: " << e.what();
+    }
+}
+
+// Test: A client that stops reading loses messages but never framing
+TEST_F(ExchangeSimulatorTest, SlowConsumerStreamStaysFramed) {
+    std::string symbol_file = config_dir_ + "/symbols.csv";
+    create_valid_symbol_file(symbol_file, 1);
+    std::string config_file = create_test_config(symbol_file, 12351, 1, 0);
+    
+    try {
+        ExchangeSimulator sim(12351, 1, config_file);
+        sim.set_tick_rate(0);
+        sim.set_num_reactors(1);
+        sim.set_broadcast_log_size(1 << 20);
+        sim.start();
+        std::thread event_thread([&sim]() {
+            sim.run();
+        });
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        
+        int fd = socket(AF_INET, SOCK_STREAM, 0);
+        ASSERT_GE(fd, 0);
+        int rcvbuf = 4096;
+        setsockopt(fd, SOL_SOCKET, SO_RCVBUF, &rcvbuf, sizeof(rcvbuf));
+        struct sockaddr_in addr{};
+        addr.sin_family = AF_INET;
+        addr.sin_port = htons(12351);
+        addr.sin_addr.s_addr = inet_addr("127.0.0.1");
+        ASSERT_EQ(connect(fd, (struct sockaddr*)&addr, sizeof(addr)), 0);
+        uint8_t sub_msg[] = {0xFF, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00};
+        send(fd, sub_msg, sizeof(sub_msg), 0);
+        std::this_thread::sleep_for(std::chrono::milliseconds(200));
+        
+        // Far more than the (auto-tuned) socket buffers plus the log window
+        for (int i = 0; i < 200000; ++i) {
+            sim.generate_tick(0);
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(200));
+        ServerStats stats = sim.get_stats();
+        EXPECT_GT(stats.slow_consumer_events + stats.log_overruns, 0);
+        
+        // Drain everything: every message must frame and checksum correctly
+        std::vector<uint8_t> stream;
+        uint8_t buffer[65536];
+        struct timeval tv{0, 300000};
+        setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv));
+        ssize_t n;
+        while ((n = recv(fd, buffer, sizeof(buffer), 0)) > 0) {
+            stream.insert(stream.end(), buffer, buffer + n);
+        }
+        
+        size_t pos = 0;
+        size_t messages = 0;
+        while (pos + sizeof(MessageHeader) <= stream.size()) {
+            MessageHeader header;
+            std::memcpy(&header, stream.data() + pos, sizeof(header));
+            size_t size = get_message_size(static_cast<MessageType>(header.msg_type));
+            ASSERT_GT(size, 0u) << "Lost framing at offset " << pos;
+            ASSERT_LE(pos + size, stream.size());
+            EXPECT_TRUE(validate_checksum(stream.data() + pos, size));
+            pos += size;
+            messages++;
+        }
+        EXPECT_EQ(pos, stream.size());
+        EXPECT_GT(messages, 0u);
+        
+        close(fd);
+        sim.stop();
+        event_thread.join();
+    } catch (const std::exception& e) {
+        FAIL() << "Exception thrown: " << e.what();
+    }
+}
+
+// Test: Idle connections get heartbeats, busy ones do not need them
+TEST_F(ExchangeSimulatorTest, IdleClientReceivesHeartbeats) {
+    std::string symbol_file = config_dir_ + "/symbols.csv";
+    create_valid_symbol_file(symbol_file, 1);
+    std::string config_file = create_test_config(symbol_file, 12352, 1, 0);
+    
+    try {
+        ExchangeSimulator sim(12352, 1, config_file);
+        sim.set_tick_rate(0);
+        sim.set_heartbeat_interval_ms(50);
+        sim.start();
+        std::thread event_thread([&sim]() {
+            sim.run();
+        });
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        
+        int fd = socket(AF_INET, SOCK_STREAM, 0);
+        ASSERT_GE(fd, 0);
+        struct sockaddr_in addr{};
+        addr.sin_family = AF_INET;
+        addr.sin_port = htons(12352);
+        addr.sin_addr.s_addr = inet_addr("127.0.0.1");
+        ASSERT_EQ(connect(fd, (struct sockaddr*)&addr, sizeof(addr)), 0);
+        
+        struct timeval tv{1, 0};
+        setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv));
+        uint32_t last_seq = 0;
+        for (int i = 0; i < 3; ++i) {
+            HeartbeatMessage heartbeat;
+            ssize_t bytes = recv(fd, &heartbeat, sizeof(heartbeat), MSG_WAITALL);
+            ASSERT_EQ(bytes, static_cast<ssize_t>(sizeof(heartbeat)));
+            EXPECT_EQ(heartbeat.header.msg_type, static_cast<uint16_t>(MessageType::HEARTBEAT));
+            EXPECT_GT(heartbeat.header.seq_num, last_seq);
+            EXPECT_TRUE(validate_checksum(&heartbeat, sizeof(heartbeat)));
+            last_seq = heartbeat.header.seq_num;
+        }
+        EXPECT_GE(sim.get_stats().heartbeats_sent, 3u);
+        
+        close(fd);
+        sim.stop();
+        event_thread.join();
+    } catch (const std::exception& e) {
+        FAIL() << "Exception thrown: " << e.what();
+    }
+}
+
+// Test: A resume request replays retained messages after the client's last sequence
+TEST_F(ExchangeSimulatorTest, ResumeReplaysFromLastSequence) {
+    std::string symbol_file = config_dir_ + "/symbols.csv";
+    create_valid_symbol_file(symbol_file, 2);
+    std::string config_file = create_test_config(symbol_file, 12353, 2, 0);
+    
+    try {
+        ExchangeSimulator sim(12353, 2, config_file);
+        sim.set_tick_rate(0);
+        sim.start();
+        std::thread event_thread([&sim]() {
+            sim.run();
+        });
+        
+        // Published before the client connects: only reachable by replay
+        for (int i = 0; i < 10; ++i) {
+            sim.generate_tick(0);
+            sim.generate_tick(1);
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        
+        int fd = socket(AF_INET, SOCK_STREAM, 0);
+        ASSERT_GE(fd, 0);
+        struct sockaddr_in addr{};
+        addr.sin_family = AF_INET;
+        addr.sin_port = htons(12353);
+        addr.sin_addr.s_addr = inet_addr("127.0.0.1");
+        ASSERT_EQ(connect(fd, (struct sockaddr*)&addr, sizeof(addr)), 0);
+        
+        // Resume symbol 0 after seq 4; symbol 1 with last_seq 0 (no replay)
+        uint8_t resume_msg[] = {0xFE, 0x02, 0x00, 0x00, 0x00,
+                                0x00, 0x00, 0x00, 0x00, 0x04, 0x00, 0x00, 0x00,
+                                0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00};
+        ASSERT_EQ(send(fd, resume_msg, sizeof(resume_msg), 0), static_cast<ssize_t>(sizeof(resume_msg)));
+        
+        struct timeval tv{1, 0};
+        setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv));
+        for (uint32_t expected = 5; expected <= 10; ++expected) {
+            uint8_t buffer[sizeof(QuoteMessage)];
+            ASSERT_EQ(recv(fd, buffer, sizeof(MessageHeader), MSG_WAITALL),
+                      static_cast<ssize_t>(sizeof(MessageHeader)));
+            MessageHeader header;
+            std::memcpy(&header, buffer, sizeof(header));
+            size_t len = get_message_size(static_cast<MessageType>(header.msg_type));
+            ASSERT_GT(len, 0u);
+            ASSERT_EQ(recv(fd, buffer + sizeof(header), len - sizeof(header), MSG_WAITALL),
+                      static_cast<ssize_t>(len - sizeof(header)));
+            EXPECT_TRUE(validate_checksum(buffer, len));
+            EXPECT_EQ(header.symbol_id, 0);
+            EXPECT_EQ(header.seq_num, expected);
+        }
+        
+        // Live fan-out continues after the replay, for both symbols
+        sim.generate_tick(1);
+        MessageHeader header;
+        ASSERT_EQ(recv(fd, &header, sizeof(header), MSG_WAITALL), static_cast<ssize_t>(sizeof(header)));
+        EXPECT_EQ(header.symbol_id, 1);
+        EXPECT_EQ(header.seq_num, 11u);
+        EXPECT_EQ(sim.get_stats().messages_replayed, 6u);
+        
+        close(fd);
+        sim.stop();
+        event_thread.join();
+    } catch (const std::exception& e) {
+        FAIL() << "Exception thrown: " << e.what();
+    }
+}
+
+// Test: Delivery faults mangle each client's stream independently, and
+// the stream stays framed: corrupted messages fail their checksum,
+// duplicated and reordered ones arrive intact, nothing else is lost
+// Test: Requests split across TCP segments are reassembled
+TEST_F(ExchangeSimulatorTest, SplitRequestsAreReassembled) {
+    std::string symbol_file = config_dir_ + "/symbols.csv";
+    create_valid_symbol_file(symbol_file, 2);
+    std::string config_file = create_test_config(symbol_file, 12357, 2, 0);
+    
+    ExchangeSimulator sim(12357, 2, config_file);
+    sim.set_tick_rate(0);
+    sim.start();
+    std::thread event_thread([&sim]() {
+        sim.run();
+    });
+    for (int i = 0; i < 10; ++i) {
+        sim.generate_tick(0);
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    
+    int fd = socket(AF_INET, SOCK_STREAM, 0);
+    ASSERT_GE(fd, 0);
+    int one = 1;
+    setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+    struct sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(12357);
+    addr.sin_addr.s_addr = inet_addr("127.0.0.1");
+    ASSERT_EQ(connect(fd, (struct sockaddr*)&addr, sizeof(addr)), 0);
+    
+    // Resume symbol 0 after seq 7, cut inside the entry's last_seq
+    uint8_t resume_msg[] = {0xFE, 0x01, 0x00, 0x00, 0x00,
+                            0x00, 0x00, 0x00, 0x00, 0x07, 0x00, 0x00, 0x00};
+    ASSERT_EQ(send(fd, resume_msg, 10, 0), 10);
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    ASSERT_EQ(send(fd, resume_msg + 10, sizeof(resume_msg) - 10, 0),
+              static_cast<ssize_t>(sizeof(resume_msg) - 10));
+    
+    struct timeval tv{1, 0};
+    setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv));
+    auto read_header = [fd](MessageHeader& header) {
+        uint8_t buffer[sizeof(QuoteMessage)];
+        if (recv(fd, buffer, sizeof(MessageHeader), MSG_WAITALL) != static_cast<ssize_t>(sizeof(MessageHeader))) {
+            return false;
+        }
+        std::memcpy(&header, buffer, sizeof(header));
+        size_t len = get_message_size(static_cast<MessageType>(header.msg_type));
+        return len > 0 && recv(fd, buffer + sizeof(header), len - sizeof(header), MSG_WAITALL) ==
+                          static_cast<ssize_t>(len - sizeof(header));
+    };
+    for (uint32_t expected = 8; expected <= 10; ++expected) {
+        MessageHeader header;
+        ASSERT_TRUE(read_header(header));
+        EXPECT_EQ(header.symbol_id, 0u);
+        EXPECT_EQ(header.seq_num, expected);
+    }
+    
+    // Switch to symbol 1 with a subscription cut inside the symbol id
+    uint8_t sub_msg[] = {0xFF, 0x01, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00};
+    ASSERT_EQ(send(fd, sub_msg, 7, 0), 7);
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    ASSERT_EQ(send(fd, sub_msg + 7, 2, 0), 2);
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    
+    sim.generate_tick(0);
+    sim.generate_tick(1);
+    MessageHeader header;
+    ASSERT_TRUE(read_header(header));
+    EXPECT_EQ(header.symbol_id, 1u);
+    EXPECT_EQ(header.seq_num, 1u);
+    
+    close(fd);
+    sim.stop();
+    event_thread.join();
+}
+
+TEST_F(ExchangeSimulatorTest, DeliveryFaultsKeepStreamFramed) {
+    std::string symbol_file = config_dir_ + "/symbols.csv";
+    create_valid_symbol_file(symbol_file, 1);
+    std::string config_file = create_test_config(symbol_file, 12355, 1, 0);
+    
+    try {
+        ExchangeSimulator sim(12355, 1, config_file);
+        FaultConfig faults;
+        faults.sequence_gap = 0.0;
+        faults.fragment = 0.1;     // Only applies to a client with nothing queued
+        faults.corrupt = 0.05;
+        faults.duplicate = 0.05;
+        faults.reorder = 0.05;
+        faults.delay = 0.01;
+        faults.delay_us = 2000;
+        faults.squeeze = 0.01;
+        faults.squeeze_ms = 5;
+        sim.set_fault_config(faults);
+        sim.enable_fault_injection(true);
+        sim.set_tick_rate(0);
+        sim.set_num_reactors(1);
+        sim.start();
+        std::thread event_thread([&sim]() {
+            sim.run();
+        });
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        
+        int fds[2] = {connect_subscriber(12355), connect_subscriber(12355)};
+        ASSERT_GE(fds[0], 0);
+        ASSERT_GE(fds[1], 0);
+        std::this_thread::sleep_for(std::chrono::milliseconds(200));
+        
+        const uint32_t ticks = 4000;
+        for (uint32_t i = 0; i < ticks; ++i) {
+            sim.generate_tick(0);
+            if (i % 20 == 19) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+        }
+        
+        std::vector<uint32_t> seqs[2];
+        for (int c = 0; c < 2; ++c) {
+            std::vector<uint8_t> stream = drain_socket(fds[c], 300);
+            size_t pos = 0;
+            size_t corrupted = 0;
+            size_t duplicates = 0;
+            size_t out_of_order = 0;
+            uint32_t highest = 0;
+            std::vector<bool> seen(ticks + 1, false);
+            while (pos + sizeof(MessageHeader) <= stream.size()) {
+                MessageHeader header;
+                std::memcpy(&header, stream.data() + pos, sizeof(header));
+                size_t size = get_message_size(static_cast<MessageType>(header.msg_type));
+                ASSERT_GT(size, 0u) << "Lost framing at offset " << pos;
+                ASSERT_LE(pos + size, stream.size());
+                pos += size;
+                if (header.msg_type == static_cast<uint16_t>(MessageType::HEARTBEAT)) {
+                    continue;
+                }
+                if (!validate_checksum(stream.data() + pos - size, size)) {
+                    corrupted++;
+                    continue;
+                }
+                ASSERT_GE(header.seq_num, 1u);
+                ASSERT_LE(header.seq_num, ticks);
+                seqs[c].push_back(header.seq_num);
+                duplicates += seen[header.seq_num];
+                seen[header.seq_num] = true;
+                out_of_order += header.seq_num < highest;
+                highest = std::max(highest, header.seq_num);
+            }
+            EXPECT_EQ(pos, stream.size());
+            size_t unique = seqs[c].size() - duplicates;
+            EXPECT_EQ(unique + corrupted, ticks) << "client " << c;
+            EXPECT_GT(corrupted, 0u);
+            EXPECT_GT(duplicates, 0u);
+            EXPECT_GT(out_of_order, 0u);
+        }
+        EXPECT_NE(seqs[0], seqs[1]);  // Drawn independently per client
+        
+        auto counts = sim.get_fault_counts();
+        for (Fault fault : {Fault::FRAGMENT, Fault::CORRUPT, Fault::DUPLICATE, Fault::REORDER,
+                            Fault::DELAY, Fault::SQUEEZE}) {
+            EXPECT_GT(counts[static_cast<size_t>(fault)], 0u) << "fault " << static_cast<int>(fault);
+        }
+        EXPECT_EQ(counts[static_cast<size_t>(Fault::DISCONNECT)], 0u);
+        EXPECT_EQ(sim.get_stats().faults_injected,
+                  std::accumulate(counts.begin(), counts.end(), uint64_t{0}));
+        
+        close(fds[0]);
+        close(fds[1]);
+        sim.stop();
+        event_thread.join();
+    } catch (const std::exception& e) {
+        FAIL() << "Exception thrown: " << e.what();
+    }
+}
+
+// Test: A delayed client's output is held by a timer, not a sleep: the
+// tick thread keeps going and the held messages arrive together after
+// the delay. A disconnect fault closes the connection.
+TEST_F(ExchangeSimulatorTest, DelayAndDisconnectFaults) {
+    std::string symbol_file = config_dir_ + "/symbols.csv";
+    create_valid_symbol_file(symbol_file, 1);
+    std::string config_file = create_test_config(symbol_file, 12356, 1, 0);
+    
+    try {
+        ExchangeSimulator sim(12356, 1, config_file);
+        FaultConfig faults;
+        faults.sequence_gap = 0.0;
+        faults.fragment = 0.0;
+        faults.delay = 1.0;
+        faults.delay_us = 150000;
+        sim.set_fault_config(faults);
+        sim.enable_fault_injection(true);
+        sim.set_tick_rate(0);
+        sim.start();
+        std::thread event_thread([&sim]() {
+            sim.run();
+        });
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        
+        int fd = connect_subscriber(12356);
+        ASSERT_GE(fd, 0);
+        std::this_thread::sleep_for(std::chrono::milliseconds(200));
+        
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < 10; ++i) {
+            sim.generate_tick(0);
+        }
+        EXPECT_LT(std::chrono::steady_clock::now() - start, std::chrono::milliseconds(50));
+        
+        struct timeval tv{1, 0};
+        setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv));
+        for (uint32_t expected = 1; expected <= 10; ++expected) {
+            uint8_t buffer[BroadcastLog::MAX_MESSAGE_SIZE];
+            ASSERT_EQ(recv(fd, buffer, sizeof(MessageHeader), MSG_WAITALL),
+                      static_cast<ssize_t>(sizeof(MessageHeader)));
+            if (expected == 1) {
+                EXPECT_GE(std::chrono::steady_clock::now() - start, std::chrono::milliseconds(140));
+            }
+            MessageHeader header;
+            std::memcpy(&header, buffer, sizeof(header));
+            size_t len = get_message_size(static_cast<MessageType>(header.msg_type));
+            ASSERT_GT(len, 0u);
+            ASSERT_EQ(recv(fd, buffer + sizeof(header), len - sizeof(header), MSG_WAITALL),
+                      static_cast<ssize_t>(len - sizeof(header)));
+            EXPECT_EQ(header.seq_num, expected);
+        }
+        EXPECT_EQ(sim.get_fault_counts()[static_cast<size_t>(Fault::DELAY)], 1u);
+        
+        close(fd);
+        sim.stop();
+        event_thread.join();
+        
+        // Every message disconnects: the client sees the connection close
+        ExchangeSimulator closing(12357, 1, config_file);
+        faults.delay = 0.0;
+        faults.disconnect = 1.0;
+        closing.set_fault_config(faults);
+        closing.enable_fault_injection(true);
+        closing.set_tick_rate(0);
+        closing.start();
+        std::thread closing_thread([&closing]() {
+            closing.run();
+        });
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        fd = connect_subscriber(12357);
+        ASSERT_GE(fd, 0);
+        std::this_thread::sleep_for(std::chrono::milliseconds(200));
+        closing.generate_tick(0);
+        EXPECT_TRUE(drain_socket(fd, 1000).empty());
+        EXPECT_EQ(closing.get_fault_counts()[static_cast<size_t>(Fault::DISCONNECT)], 1u);
+        
+        close(fd);
+        closing.stop();
+        closing_thread.join();
+    } catch (const std::exception& e) {
+        FAIL() << "Exception thrown: " << e.what();
+    }
+}
+
+// Test: With a factor model the symbols' prices move together: every joint
+// step moves all of them, and their returns are strongly correlated
+TEST_F(ExchangeSimulatorTest, CorrelatedPricesMoveTogether) {
+    std::string symbol_file = config_dir_ + "/symbols.csv";
+    create_valid_symbol_file(symbol_file, 2);
+    std::string factor_file = config_dir_ + "/factors.csv";
+    {
+        std::ofstream factors(factor_file);
+        factors << "symbol_id,market\n";
+        factors << "0,0.99\n";
+        factors << "1,0.99\n";
+    }
+    std::string config_file = create_test_config(symbol_file, 0, 2);
+    {
+        std::ofstream config(config_file, std::ios::app);
+        config << "market.correlation=factor\n";
+        config << "market.correlation_file=" << fs::absolute(factor_file).string() << "\n";
+    }
+    
+    try {
+        ExchangeSimulator sim(0, 2, config_file);
+        ASSERT_TRUE(sim.is_correlated());
+        
+        // Only symbol 0 ticks, but each joint step (2 ticks) moves both
+        double sx = 0, sy = 0, sxx = 0, syy = 0, sxy = 0;
+        const int steps = 2000;
+        for (int i = 0; i < steps; ++i) {
+            double p0 = sim.get_symbol(0).current_price;
+            double p1 = sim.get_symbol(1).current_price;
+            sim.generate_tick(0);
+            sim.generate_tick(0);
+            double r0 = std::log(sim.get_symbol(0).current_price / p0);
+            double r1 = std::log(sim.get_symbol(1).current_price / p1);
+            ASSERT_NE(r1, 0.0);
+            sx += r0; sy += r1; sxx += r0 * r0; syy += r1 * r1; sxy += r0 * r1;
+        }
+        double cov = sxy / steps - (sx / steps) * (sy / steps);
+        double var0 = sxx / steps - (sx / steps) * (sx / steps);
+        double var1 = syy / steps - (sy / steps) * (sy / steps);
+        EXPECT_GT(cov / std::sqrt(var0 * var1), 0.9);
+    } catch (const std::exception& e) {
+        FAIL() << "Exception thrown: " << e.what();
+    }
+    
+    // Unknown model names are configuration errors
+    {
+        std::ofstream config(config_file, std::ios::app);
+        config << "market.correlation=cholesky\n";
+    }
+    EXPECT_THROW(ExchangeSimulator(0, 2, config_file), std::runtime_error);
+}
+
+// Test: The same seed gives every symbol the same path whatever order the
+// symbols are ticked in (as when sharded across threads); another seed
+// gives a different market
+TEST_F(ExchangeSimulatorTest, SeedReproducesMarketInAnyTickOrder) {
+    std::string symbol_file = config_dir_ + "/symbols.csv";
+    create_valid_symbol_file(symbol_file, 3);
+    std::string config_file = create_test_config(symbol_file, 0, 3);
+    {
+        std::ofstream config(config_file, std::ios::app);
+        config << "market.seed=424242\n";
+    }
+    
+    try {
+        ExchangeSimulator round_robin(0, 3, config_file);
+        ExchangeSimulator by_symbol(0, 3, config_file);
+        EXPECT_EQ(round_robin.get_seed(), 424242u);
+        round_robin.enable_fault_injection(true);
+        by_symbol.enable_fault_injection(true);
+        
+        const int ticks = 500;
+        for (int i = 0; i < ticks; ++i) {
+            for (uint16_t s = 0; s < 3; ++s) {
+                round_robin.generate_tick(s);
+            }
+        }
+        for (int s = 2; s >= 0; --s) {
+            for (int i = 0; i < ticks; ++i) {
+                by_symbol.generate_tick(static_cast<uint16_t>(s));
+            }
+        }
+        
+        for (size_t s = 0; s < 3; ++s) {
+            EXPECT_EQ(round_robin.get_symbol(s).current_price, by_symbol.get_symbol(s).current_price);
+            // Injected gaps come from the symbol's own stream too
+            EXPECT_EQ(round_robin.get_symbol(s).seq_num, by_symbol.get_symbol(s).seq_num);
+            EXPECT_GT(round_robin.get_symbol(s).seq_num, static_cast<uint32_t>(ticks));
+        }
+    } catch (const std::exception& e) {
+        FAIL() << "Exception thrown: " << e.what();
+    }
+    
+    {
+        std::ofstream config(config_file, std::ios::app);
+        config << "market.seed=7\n";
+    }
+    ExchangeSimulator a(0, 3, config_file);
+    ExchangeSimulator b(0, 3, create_test_config(symbol_file, 0, 3));
+    for (int i = 0; i < 10; ++i) {
+        a.generate_tick(0);
+        b.generate_tick(0);
+    }
+    EXPECT_EQ(a.get_seed(), 7u);
+    EXPECT_NE(a.get_symbol(0).current_price, b.get_symbol(0).current_price);
+}
+
+// Test: Poisson arrivals give each symbol its Zipf share of the tick rate
+// over simulated time, and a weight column in the symbols file overrides it
+TEST_F(ExchangeSimulatorTest, PoissonArrivalsFollowSymbolRates) {
+    std::string symbol_file = config_dir_ + "/symbols.csv";
+    create_valid_symbol_file(symbol_file, 10);
+    std::string config_file = create_test_config(symbol_file, 0, 10, 10000);
+    {
+        std::ofstream config(config_file, std::ios::app);
+        config << "market.arrivals=poisson\n";
+        config << "market.rate_skew=1.0\n";
+        config << "market.seed=99\n";
+    }
+    
+    try {
+        ExchangeSimulator sim(0, 10, config_file);
+        ASSERT_TRUE(sim.is_poisson_arrivals());
+        
+        // 10 simulated seconds at 10k ticks/s
+        sim.generate_arrivals(0);
+        sim.generate_arrivals(10'000'000);
+        double harmonic = 0.0;
+        uint64_t total = 0;
+        for (size_t i = 0; i < 10; ++i) {
+            harmonic += 1.0 / (i + 1);
+            total += sim.get_symbol(i).seq_num;
+        }
+        EXPECT_NEAR(total, 100000.0, 1500.0);
+        for (size_t i = 0; i < 10; ++i) {
+            double expected = 100000.0 / ((i + 1) * harmonic);
+            EXPECT_NEAR(sim.get_symbol(i).rate_share, 1.0 / ((i + 1) * harmonic), 1e-12);
+            EXPECT_NEAR(sim.get_symbol(i).seq_num, expected, 5.0 * std::sqrt(expected)) << "symbol " << i;
+        }
+        
+        // Pausing drops the schedule: nothing is generated for the gap
+        sim.set_tick_rate(0);
+        sim.generate_arrivals(20'000'000);
+        sim.set_tick_rate(10000);
+        sim.generate_arrivals(20'000'000);
+        uint64_t after_pause = 0;
+        for (size_t i = 0; i < 10; ++i) {
+            after_pause += sim.get_symbol(i).seq_num;
+        }
+        EXPECT_EQ(after_pause, total);
+    } catch (const std::exception& e) {
+        FAIL() << "Exception thrown: " << e.what();
+    }
+    
+    // Explicit weights: symbol 1 three times as busy as symbol 0
+    {
+        std::ofstream symbols(symbol_file);
+        symbols << "symbol_id,symbol,price,volatility,drift,weight\n";
+        symbols << "0,SYM0,1000.0,0.02,0.01,1\n";
+        symbols << "1,SYM1,1010.0,0.02,0.01,3\n";
+    }
+    ExchangeSimulator weighted(0, 10, config_file);
+    weighted.generate_arrivals(0);
+    weighted.generate_arrivals(10'000'000);
+    EXPECT_NEAR(weighted.get_symbol(0).rate_share, 0.25, 1e-12);
+    EXPECT_NEAR(weighted.get_symbol(0).seq_num, 25000.0, 800.0);
+    EXPECT_NEAR(weighted.get_symbol(1).seq_num, 75000.0, 1400.0);
+    
+    {
+        std::ofstream config(config_file, std::ios::app);
+        config << "market.arrivals=bursty\n";
+    }
+    EXPECT_THROW(ExchangeSimulator(0, 10, config_file), std::runtime_error);
+}
+
+// Test: A scenario timeline bursts the tick rate and halts a symbol at the
+// scheduled times on the arrival clock
+TEST_F(ExchangeSimulatorTest, ScenarioBurstsAndHalts) {
+    std::string symbol_file = config_dir_ + "/symbols.csv";
+    create_valid_symbol_file(symbol_file, 2);
+    std::string scenario_file = config_dir_ + "/scenario.csv";
+    {
+        std::ofstream scenario(scenario_file);
+        scenario << "time_ms,event,symbol,value\n";
+        scenario << "1000,rate,*,10\n";
+        scenario << "2000,rate,*,1\n";
+        scenario << "2000,halt,1,\n";
+        scenario << "3000,resume,1,\n";
+    }
+    std::string config_file = create_test_config(symbol_file, 0, 2, 10000);
+    {
+        std::ofstream config(config_file, std::ios::app);
+        config << "market.arrivals=poisson\n";
+        config << "market.rate_skew=0\n";
+        config << "market.seed=5\n";
+        config << "market.scenario_file=" << fs::absolute(scenario_file).string() << "\n";
+    }
+    
+    try {
+        ExchangeSimulator sim(0, 2, config_file);
+        ASSERT_TRUE(sim.has_scenario());
+        
+        // Ticks per symbol in each simulated second
+        std::vector<std::vector<double>> counts;
+        uint32_t last[2] = {0, 0};
+        sim.generate_arrivals(0);
+        for (uint64_t second = 1; second <= 4; ++second) {
+            sim.generate_arrivals(second * 1'000'000);
+            std::vector<double> window;
+            for (size_t s = 0; s < 2; ++s) {
+                window.push_back(sim.get_symbol(s).seq_num - last[s]);
+                last[s] = sim.get_symbol(s).seq_num;
+            }
+            counts.push_back(window);
+        }
+        
+        const double expected[4][2] = {{5000, 5000}, {50000, 50000}, {5000, 0}, {5000, 5000}};
+        for (size_t w = 0; w < 4; ++w) {
+            for (size_t s = 0; s < 2; ++s) {
+                EXPECT_NEAR(counts[w][s], expected[w][s], 5.0 * std::sqrt(expected[w][s]) + 0.5)
+                    << "second " << w + 1 << " symbol " << s;
+            }
+        }
+    } catch (const std::exception& e) {
+        FAIL() << "Exception thrown: " << e.what();
+    }
+}
+
+// Test: In matching mode quotes and trades come from the order book: quotes
+// are never crossed, trades never print inside the last quoted spread, and
+// the last quote is the book's top
+TEST_F(ExchangeSimulatorTest, MatchingModeTradesConsistentWithQuotes) {
+    std::string symbol_file = config_dir_ + "/symbols.csv";
+    create_valid_symbol_file(symbol_file, 2);
+    std::string config_file = create_test_config(symbol_file, 12354, 2, 0);
+    {
+        std::ofstream config(config_file, std::ios::app);
+        config << "market.mode=matching\n";
+        config << "matching.tick_size=0.05\n";
+    }
+    
+    try {
+        ExchangeSimulator sim(12354, 2, config_file);
+        ASSERT_TRUE(sim.is_matching_enabled());
+        ASSERT_NE(sim.get_order_book(0), nullptr);
+        sim.set_tick_rate(0);
+        sim.start();
+        std::thread event_thread([&sim]() {
+            sim.run();
+        });
+        
+        int fd = socket(AF_INET, SOCK_STREAM, 0);
+        ASSERT_GE(fd, 0);
+        struct sockaddr_in addr{};
+        addr.sin_family = AF_INET;
+        addr.sin_port = htons(12354);
+        addr.sin_addr.s_addr = inet_addr("127.0.0.1");
+        ASSERT_EQ(connect(fd, (struct sockaddr*)&addr, sizeof(addr)), 0);
+        uint8_t sub_msg[] = {0xFF, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00};
+        ASSERT_EQ(send(fd, sub_msg, sizeof(sub_msg), 0), static_cast<ssize_t>(sizeof(sub_msg)));
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        
+        for (int i = 0; i < 3000; ++i) {
+            sim.generate_tick(0);
+        }
+        uint32_t last_seq = sim.get_symbol(0).seq_num;
+        ASSERT_GT(last_seq, 0u);
+        
+        struct timeval tv{2, 0};
+        setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv));
+        double bid = 0.0, ask = 0.0;
+        uint32_t bid_qty = 0, ask_qty = 0;
+        size_t quotes = 0, trades = 0;
+        uint32_t expected_seq = 1;
+        while (expected_seq <= last_seq) {
+            uint8_t buffer[sizeof(QuoteMessage)];
+            ASSERT_EQ(recv(fd, buffer, sizeof(MessageHeader), MSG_WAITALL),
+                      static_cast<ssize_t>(sizeof(MessageHeader)));
+            MessageHeader header;
+            std::memcpy(&header, buffer, sizeof(header));
+            size_t len = get_message_size(static_cast<MessageType>(header.msg_type));
+            ASSERT_GT(len, 0u);
+            ASSERT_EQ(recv(fd, buffer + sizeof(header), len - sizeof(header), MSG_WAITALL),
+                      static_cast<ssize_t>(len - sizeof(header)));
+            ASSERT_TRUE(validate_checksum(buffer, len));
+            ASSERT_EQ(header.seq_num, expected_seq++);
+            
+            if (header.msg_type == static_cast<uint16_t>(MessageType::QUOTE)) {
+                QuoteMessage quote;
+                std::memcpy(&quote, buffer, sizeof(quote));
+                bid = quote.payload.bid_price;
+                ask = quote.payload.ask_price;
+                bid_qty = quote.payload.bid_qty;
+                ask_qty = quote.payload.ask_qty;
+                if (bid_qty > 0 && ask_qty > 0) {
+                    ASSERT_LT(bid, ask) << "crossed quote at seq " << header.seq_num;
+                }
+                quotes++;
+            } else if (header.msg_type == static_cast<uint16_t>(MessageType::TRADE)) {
+                TradeMessage trade;
+                std::memcpy(&trade, buffer, sizeof(trade));
+                ASSERT_GT(trade.payload.quantity, 0u);
+                // Buys lift the ask (or deeper), sells hit the bid (or
+                // deeper); the first event may trade before any quote
+                bool at_or_beyond_bid = bid_qty > 0 && trade.payload.price <= bid + 1e-9;
+                bool at_or_beyond_ask = ask_qty > 0 && trade.payload.price >= ask - 1e-9;
+                if (quotes > 0) {
+                    ASSERT_TRUE(at_or_beyond_bid || at_or_beyond_ask)
+                        << "trade " << trade.payload.price << " inside " << bid << " x " << ask;
+                }
+                trades++;
+            }
+        }
+        EXPECT_GT(quotes, 100u);
+        EXPECT_GT(trades, 10u);
+        
+        // Trades only move prices on the tick grid
+        const OrderBook& book = *sim.get_order_book(0);
+        auto top = book.top();
+        if (top.bid_tick != OrderBook::NO_PRICE) {
+            EXPECT_NEAR(bid, top.bid_tick * 0.05, 1e-9);
+            EXPECT_EQ(bid_qty, top.bid_quantity);
+        }
+        if (top.ask_tick != OrderBook::NO_PRICE) {
+            EXPECT_NEAR(ask, top.ask_tick * 0.05, 1e-9);
+            EXPECT_EQ(ask_qty, top.ask_quantity);
+        }
+        EXPECT_EQ(sim.get_stats().messages_generated, last_seq);
+        
+        close(fd);
+        sim.stop();
+        event_thread.join();
+    } catch (const std::exception& e) {
+        FAIL() << "Exception thrown: " << e.what();
+    }
+}
+
 } // namespace mdfh
 
 // Main function for running tests
@@ -0,0 +1,92 @@
+#include <gtest/gtest.h>
+#include "server/fault_injector.h"
+#include <array>
+#include <cmath>
+
+namespace mdfh {
+
+// Test: Each fault is drawn at its configured probability
+TEST(FaultInjectorTest, DrawsFaultsAtConfiguredRates) {
+    FaultConfig config;
+    config.fragment = 0.10;
+    config.delay = 0.05;
+    config.corrupt = 0.02;
+    config.duplicate = 0.03;
+    config.reorder = 0.04;
+    config.disconnect = 0.01;
+    config.squeeze = 0.05;
+    FaultInjector injector(config, 42, 0);
+
+    const int draws = 1000000;
+    std::array<int, NUM_FAULTS> counts{};
+    for (int i = 0; i < draws; ++i) {
+        counts[static_cast<size_t>(injector.draw())]++;
+    }
+
+    const double expected[NUM_FAULTS] = {0.70, 0.10, 0.05, 0.02, 0.03, 0.04, 0.01, 0.05};
+    for (size_t i = 0; i < NUM_FAULTS; ++i) {
+        double sigma = std::sqrt(draws * expected[i] * (1.0 - expected[i]));
+        EXPECT_NEAR(counts[i], draws * expected[i], 5.0 * sigma) << "fault " << i;
+    }
+}
+
+// Test: No faults when every probability is zero; a seed and stream give
+// the same draws every run, other streams differ
+TEST(FaultInjectorTest, ZeroProbabilityAndReproducibleStreams) {
+    FaultConfig none;
+    none.fragment = 0.0;
+    FaultInjector quiet(none, 7, 0);
+    for (int i = 0; i < 100000; ++i) {
+        ASSERT_EQ(quiet.draw(), Fault::NONE);
+    }
+
+    FaultConfig config;
+    config.fragment = 0.2;
+    config.duplicate = 0.2;
+    FaultInjector a(config, 7, 1);
+    FaultInjector b(config, 7, 1);
+    FaultInjector c(config, 7, 2);
+    int differ = 0;
+    for (int i = 0; i < 1000; ++i) {
+        Fault fa = a.draw();
+        ASSERT_EQ(fa, b.draw());
+        differ += fa != c.draw();
+    }
+    EXPECT_GT(differ, 100);
+}
+
+// Test: Probabilities are clamped to [0, 1] and scaled down when they sum past 1
+TEST(FaultInjectorTest, ClampsAndNormalizesProbabilities) {
+    FaultConfig config;
+    config.sequence_gap = 3.0;
+    config.fragment = 1.5;      // Clamped to 1
+    config.delay = 1.0;
+    config.corrupt = -0.5;      // Clamped to 0
+    config.delay_us = 0;
+    FaultInjector injector(config, 1, 0);
+    EXPECT_DOUBLE_EQ(injector.get_config().sequence_gap, 1.0);
+    EXPECT_DOUBLE_EQ(injector.get_config().corrupt, 0.0);
+    EXPECT_EQ(injector.get_config().delay_us, 1u);
+
+    int fragments = 0;
+    const int draws = 100000;
+    for (int i = 0; i < draws; ++i) {
+        Fault fault = injector.draw();
+        ASSERT_TRUE(fault == Fault::FRAGMENT || fault == Fault::DELAY);
+        fragments += fault == Fault::FRAGMENT;
+    }
+    EXPECT_NEAR(fragments, draws / 2, 5.0 * std::sqrt(draws * 0.25));
+
+    injector.record(Fault::DELAY);
+    injector.record(Fault::DELAY);
+    injector.record(Fault::SQUEEZE);
+    EXPECT_EQ(injector.get_count(Fault::DELAY), 2u);
+    EXPECT_EQ(injector.get_total(), 3u);
+}
+
+} // namespace mdfh
+
+int main(int argc, char** argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
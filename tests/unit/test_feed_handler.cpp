@@ -2,6 +2,9 @@
 #include "client/feed_handler.h"
 #include <thread>
 #include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
 #include <sys/socket.h>
 #include <netinet/in.h>
 #include <arpa/inet.h>
@@ -103,6 +106,9 @@ TEST_F(FeedHandlerTest, GetLatencyStats) {
     
     auto latency_stats = handler_->get_latency_stats();
     EXPECT_EQ(latency_stats.sample_count, 0);
+    
+    auto e2e_stats = handler_->get_end_to_end_latency_stats();
+    EXPECT_EQ(e2e_stats.sample_count, 0);
 }
 
 // Test: Disconnect without connect
@@ -132,7 +138,7 @@ TEST_F(FeedHandlerTest, StartWithoutConnection) {
 TEST_F(FeedHandlerTest, SubscribeWithoutConnection) {
     handler_ = std::make_unique<FeedHandler>("127.0.0.1", test_port_, num_symbols_);
     
-    std::vector<uint16_t> symbols = {0, 1, 2};
+    std::vector<SymbolId> symbols = {0, 1, 2};
     bool result = handler_->subscribe(symbols);
     EXPECT_FALSE(result); // Should fail if not connected
 }
@@ -189,7 +195,7 @@ TEST_F(FeedHandlerTest, ConnectAndSubscribe) {
     if (handler_->connect("127.0.0.1", test_port_)) {
         std::this_thread::sleep_for(std::chrono::milliseconds(50));
         
-        std::vector<uint16_t> symbols = {0, 1, 2, 3, 4};
+        std::vector<SymbolId> symbols = {0, 1, 2, 3, 4};
         handler_->subscribe(symbols);
         
         std::this_thread::sleep_for(std::chrono::milliseconds(100));
@@ -234,7 +240,7 @@ TEST_F(FeedHandlerTest, MultipleConnectDisconnectCycles) {
 TEST_F(FeedHandlerTest, SubscribeEmptyList) {
     handler_ = std::make_unique<FeedHandler>("127.0.0.1", test_port_, num_symbols_);
     
-    std::vector<uint16_t> empty_symbols;
+    std::vector<SymbolId> empty_symbols;
     bool result = handler_->subscribe(empty_symbols);
     EXPECT_FALSE(result); // Should handle empty list gracefully
 }
@@ -259,7 +265,7 @@ TEST_F(FeedHandlerTest, SubscribeLargeList) {
     handler_ = std::make_unique<FeedHandler>("127.0.0.1", test_port_, 100);
     
     if (handler_->connect("127.0.0.1", test_port_)) {
-        std::vector<uint16_t> symbols;
+        std::vector<SymbolId> symbols;
         for (uint16_t i = 0; i < 100; ++i) {
             symbols.push_back(i);
         }
@@ -317,6 +323,576 @@ TEST_F(FeedHandlerTest, StatisticsAfterDisconnect) {
     EXPECT_EQ(stats.bytes_received, 0);
 }
 
+// Test: Outliers are captured with message context
+TEST_F(FeedHandlerTest, CapturesOutliersWithContext) {
+    server_fd_ = create_test_server(test_port_);
+    ASSERT_GE(server_fd_, 0);
+    
+    constexpr uint32_t NUM_MESSAGES = 5;
+    std::thread accept_thread([this]() {
+        sockaddr_in client_addr{};
+        socklen_t client_len = sizeof(client_addr);
+        int client_fd = accept(server_fd_, (sockaddr*)&client_addr, &client_len);
+        if (client_fd < 0) {
+            return;
+        }
+        
+        std::vector<uint8_t> batch;
+        for (uint32_t seq = 1; seq <= NUM_MESSAGES; ++seq) {
+            TradeMessage trade{};
+            trade.header.msg_type = static_cast<uint16_t>(MessageType::TRADE);
+            trade.header.seq_num = seq;
+            trade.header.timestamp = 0;  // Far in the past: always over the e2e threshold
+            trade.header.symbol_id = static_cast<uint16_t>(seq % 3);
+            trade.payload.price = 100.0 + seq;
+            trade.payload.quantity = 10;
+            trade.checksum = calculate_checksum(&trade, sizeof(TradeMessage) - sizeof(uint32_t));
+            
+            const uint8_t* bytes = reinterpret_cast<const uint8_t*>(&trade);
+            batch.insert(batch.end(), bytes, bytes + sizeof(TradeMessage));
+        }
+        send(client_fd, batch.data(), batch.size(), 0);
+        std::this_thread::sleep_for(std::chrono::milliseconds(300));
+        close(client_fd);
+    });
+    
+    handler_ = std::make_unique<FeedHandler>("127.0.0.1", test_port_, num_symbols_);
+    handler_->get_outlier_recorder().set_thresholds(1000000, 0);
+    ASSERT_TRUE(handler_->start());
+    
+    for (int i = 0; i < 100 && handler_->get_messages_received() < NUM_MESSAGES; ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    handler_->stop();
+    accept_thread.join();
+    
+    EXPECT_EQ(handler_->get_end_to_end_latency_stats().sample_count, NUM_MESSAGES);
+    
+    auto records = handler_->get_outlier_recorder().snapshot();
+    ASSERT_EQ(records.size(), NUM_MESSAGES);
+    for (size_t i = 0; i < records.size(); ++i) {
+        EXPECT_EQ(records[i].seq_num, i + 1);
+        EXPECT_EQ(records[i].symbol_id, (i + 1) % 3);
+        EXPECT_EQ(records[i].msg_type, static_cast<uint16_t>(MessageType::TRADE));
+        EXPECT_GT(records[i].end_to_end_ns, 1000000u);
+        EXPECT_GE(records[i].cpu, 0);
+        EXPECT_GT(records[i].batch_bytes, 0u);
+        EXPECT_GE(records[i].parser_buffer_fill, sizeof(TradeMessage));
+    }
+    EXPECT_EQ(records[0].batch_index, 0u);
+}
+
+// Test: Silence beyond the liveness timeout drops the feed and marks symbols stale
+TEST_F(FeedHandlerTest, LivenessTimeoutMarksSymbolsStale) {
+    server_fd_ = create_test_server(test_port_);
+    ASSERT_GE(server_fd_, 0);
+    
+    std::atomic<bool> done{false};
+    std::thread accept_thread([this, &done]() {
+        int client_fd = accept(server_fd_, nullptr, nullptr);
+        if (client_fd < 0) {
+            return;
+        }
+        TradeMessage trade{};
+        trade.header.msg_type = static_cast<uint16_t>(MessageType::TRADE);
+        trade.header.seq_num = 1;
+        trade.header.symbol_id = 2;
+        trade.payload.price = 100.0;
+        trade.payload.quantity = 10;
+        trade.checksum = calculate_checksum(&trade, sizeof(TradeMessage) - sizeof(uint32_t));
+        send(client_fd, &trade, sizeof(trade), 0);
+        
+        // Then go silent without closing the connection
+        while (!done) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+        close(client_fd);
+    });
+    
+    handler_ = std::make_unique<FeedHandler>("127.0.0.1", test_port_, num_symbols_);
+    handler_->set_liveness_timeout_ms(100);
+    ASSERT_TRUE(handler_->start());
+    
+    for (int i = 0; i < 100 && handler_->get_stats().liveness_timeouts == 0; ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    EXPECT_GE(handler_->get_stats().liveness_timeouts, 1u);
+    EXPECT_EQ(handler_->get_messages_received(), 1u);
+    EXPECT_TRUE(handler_->get_cache().is_stale(2));
+    EXPECT_DOUBLE_EQ(handler_->get_cache().get_ltp(2), 100.0);
+    
+    done = true;
+    handler_->stop();
+    accept_thread.join();
+}
+
+// Test: Heartbeats keep a quiet feed alive
+TEST_F(FeedHandlerTest, HeartbeatsKeepFeedAlive) {
+    server_fd_ = create_test_server(test_port_);
+    ASSERT_GE(server_fd_, 0);
+    
+    std::thread accept_thread([this]() {
+        int client_fd = accept(server_fd_, nullptr, nullptr);
+        if (client_fd < 0) {
+            return;
+        }
+        for (uint32_t seq = 1; seq <= 15; ++seq) {
+            HeartbeatMessage heartbeat{};
+            heartbeat.header.msg_type = static_cast<uint16_t>(MessageType::HEARTBEAT);
+            heartbeat.header.seq_num = seq;
+            heartbeat.checksum = calculate_checksum(&heartbeat, sizeof(heartbeat) - sizeof(uint32_t));
+            send(client_fd, &heartbeat, sizeof(heartbeat), 0);
+            std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        }
+        close(client_fd);
+    });
+    
+    handler_ = std::make_unique<FeedHandler>("127.0.0.1", test_port_, num_symbols_);
+    handler_->set_liveness_timeout_ms(100);
+    ASSERT_TRUE(handler_->start());
+    accept_thread.join();
+    handler_->stop();
+    
+    auto stats = handler_->get_stats();
+    EXPECT_EQ(stats.liveness_timeouts, 0u);
+    EXPECT_GE(stats.heartbeats_received, 10u);
+    EXPECT_EQ(stats.sequence_gaps, 0u);
+}
+
+// Test: After a drop the handler reconnects on its own, resumes the
+// subscription from the last sequence and reports the recovery time
+TEST_F(FeedHandlerTest, ReconnectResumesFromLastSequence) {
+    server_fd_ = create_test_server(test_port_);
+    ASSERT_GE(server_fd_, 0);
+    
+    auto send_trade = [](int fd, uint32_t seq) {
+        TradeMessage trade{};
+        trade.header.msg_type = static_cast<uint16_t>(MessageType::TRADE);
+        trade.header.seq_num = seq;
+        trade.header.symbol_id = 2;
+        trade.payload.price = 100.0 + seq;
+        trade.payload.quantity = 10;
+        trade.checksum = calculate_checksum(&trade, sizeof(TradeMessage) - sizeof(uint32_t));
+        send(fd, &trade, sizeof(trade), MSG_NOSIGNAL);
+    };
+    
+    std::vector<uint8_t> resume(64);
+    ssize_t resume_len = 0;
+    std::atomic<bool> done{false};
+    std::thread server_thread([&]() {
+        // First connection: subscription, two trades and half of a third, then drop
+        int client_fd = accept(server_fd_, nullptr, nullptr);
+        if (client_fd < 0) {
+            return;
+        }
+        uint8_t subscription[16];
+        recv(client_fd, subscription, sizeof(subscription), 0);
+        send_trade(client_fd, 1);
+        send_trade(client_fd, 2);
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        TradeMessage partial{};
+        send(client_fd, &partial, sizeof(partial) / 2, MSG_NOSIGNAL);
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        close(client_fd);
+        
+        // Second connection: expect a resume request, then continue the stream
+        client_fd = accept(server_fd_, nullptr, nullptr);
+        if (client_fd < 0) {
+            return;
+        }
+        struct timeval tv{2, 0};
+        setsockopt(client_fd, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv));
+        resume_len = recv(client_fd, resume.data(), resume.size(), 0);
+        send_trade(client_fd, 3);
+        while (!done) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+        close(client_fd);
+    });
+    
+    handler_ = std::make_unique<FeedHandler>("127.0.0.1", test_port_, num_symbols_);
+    handler_->set_liveness_timeout_ms(0);
+    ASSERT_TRUE(handler_->start());
+    ASSERT_TRUE(handler_->subscribe({2}));
+    
+    for (int i = 0; i < 200 && handler_->get_messages_received() < 3; ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    done = true;
+    server_thread.join();
+    
+    // 0xFE, count = 1, symbol 2, last_seq 2
+    ASSERT_EQ(resume_len, 13);
+    EXPECT_EQ(resume[0], 0xFE);
+    uint32_t count;
+    std::memcpy(&count, resume.data() + 1, sizeof(count));
+    EXPECT_EQ(count, 1u);
+    SymbolId symbol_id;
+    std::memcpy(&symbol_id, resume.data() + 5, sizeof(symbol_id));
+    EXPECT_EQ(symbol_id, 2u);
+    uint32_t last_seq;
+    std::memcpy(&last_seq, resume.data() + 9, sizeof(last_seq));
+    EXPECT_EQ(last_seq, 2u);
+    
+    auto stats = handler_->get_stats();
+    EXPECT_EQ(handler_->get_messages_received(), 3u);
+    EXPECT_EQ(stats.reconnects, 1u);
+    EXPECT_GT(stats.last_recovery_ns, 0u);
+    EXPECT_EQ(stats.max_recovery_ns, stats.last_recovery_ns);
+    EXPECT_EQ(stats.sequence_gaps, 0u);
+    EXPECT_EQ(stats.checksum_errors, 0u);
+    EXPECT_FALSE(handler_->get_cache().is_stale(2));
+    EXPECT_DOUBLE_EQ(handler_->get_cache().get_ltp(2), 103.0);
+}
+
+// Test: With two lines the first copy of each sequence wins, duplicates are
+// dropped and a gap on one line is filled from the other
+TEST_F(FeedHandlerTest, ArbitratesBetweenTwoLines) {
+    server_fd_ = create_test_server(test_port_);
+    ASSERT_GE(server_fd_, 0);
+    int line_b_fd = create_test_server(test_port_ + 1);
+    ASSERT_GE(line_b_fd, 0);
+    
+    auto serve = [](int listen_fd, std::vector<uint32_t> seqs, int delay_ms, std::atomic<bool>* done) {
+        int client_fd = accept(listen_fd, nullptr, nullptr);
+        if (client_fd < 0) {
+            return;
+        }
+        // Let both lines connect before any data flows
+        std::this_thread::sleep_for(std::chrono::milliseconds(delay_ms));
+        for (uint32_t seq : seqs) {
+            TradeMessage trade{};
+            trade.header.msg_type = static_cast<uint16_t>(MessageType::TRADE);
+            trade.header.seq_num = seq;
+            trade.header.symbol_id = 4;
+            trade.payload.price = 100.0 + seq;
+            trade.payload.quantity = seq;
+            trade.checksum = calculate_checksum(&trade, sizeof(TradeMessage) - sizeof(uint32_t));
+            send(client_fd, &trade, sizeof(trade), MSG_NOSIGNAL);
+            std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        }
+        while (!*done) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+        close(client_fd);
+    };
+    
+    // Line A is faster but lost seq 3; line B trails with the full stream
+    std::atomic<bool> done{false};
+    std::thread line_a(serve, server_fd_, std::vector<uint32_t>{1, 2, 4, 5}, 100, &done);
+    std::thread line_b(serve, line_b_fd, std::vector<uint32_t>{1, 2, 3, 4, 5}, 150, &done);
+    
+    handler_ = std::make_unique<FeedHandler>("127.0.0.1", test_port_, num_symbols_);
+    handler_->set_line_b("127.0.0.1", test_port_ + 1);
+    ASSERT_TRUE(handler_->is_arbitrating());
+    ASSERT_TRUE(handler_->start());
+    
+    for (int i = 0; i < 200 && handler_->get_arbitration_stats().duplicates < 4; ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    handler_->stop();
+    done = true;
+    line_a.join();
+    line_b.join();
+    close(line_b_fd);
+    
+    // A wins 1 and 2 and holds back 4 and 5 at its gap; B fills 3, which
+    // releases A's 4 and 5, and B's own copies of 1, 2, 4 and 5 are dropped,
+    // so every sequence is applied exactly once
+    auto arb = handler_->get_arbitration_stats();
+    EXPECT_EQ(handler_->get_messages_received(), 5u);
+    EXPECT_EQ(arb.wins[0], 4u);
+    EXPECT_EQ(arb.wins[1], 1u);
+    EXPECT_EQ(arb.duplicates, 4u);
+    EXPECT_EQ(arb.gaps_deferred, 2u);
+    EXPECT_EQ(arb.restarts, 0u);
+    EXPECT_EQ(arb.line_gaps[0], 1u);
+    EXPECT_EQ(arb.line_gaps[1], 0u);
+    EXPECT_EQ(arb.advantage[0].sample_count, 4u);
+    EXPECT_GT(arb.advantage[0].p50, 0u);
+    EXPECT_EQ(handler_->get_stats().sequence_gaps, 0u);
+    EXPECT_DOUBLE_EQ(handler_->get_cache().get_ltp(4), 105.0);
+}
+
+// Test: After a server restart both lines reconnect to a new session whose
+// sequences start over; arbitration follows the new session instead of
+// dropping it as duplicates of the old one
+TEST_F(FeedHandlerTest, ArbitrationFollowsRestartedSession) {
+    server_fd_ = create_test_server(test_port_ + 2);
+    ASSERT_GE(server_fd_, 0);
+    int line_b_fd = create_test_server(test_port_ + 3);
+    ASSERT_GE(line_b_fd, 0);
+    
+    auto send_trades = [](int client_fd, uint32_t first, uint32_t last, double base) {
+        for (uint32_t seq = first; seq <= last; ++seq) {
+            TradeMessage trade{};
+            trade.header.msg_type = static_cast<uint16_t>(MessageType::TRADE);
+            trade.header.seq_num = seq;
+            trade.header.symbol_id = 6;
+            trade.payload.price = base + seq;
+            trade.payload.quantity = seq;
+            trade.checksum = calculate_checksum(&trade, sizeof(TradeMessage) - sizeof(uint32_t));
+            send(client_fd, &trade, sizeof(trade), MSG_NOSIGNAL);
+            std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        }
+    };
+    
+    // Each line carries seqs 1-10 of the first session, drops (the server
+    // went away) and after the reconnect carries seqs 1-3 of the new one
+    std::atomic<bool> done{false};
+    auto serve = [&](int listen_fd, int delay_ms) {
+        int client_fd = accept(listen_fd, nullptr, nullptr);
+        if (client_fd < 0) {
+            return;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(delay_ms));
+        send_trades(client_fd, 1, 10, 100.0);
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        close(client_fd);
+        
+        client_fd = accept(listen_fd, nullptr, nullptr);
+        if (client_fd < 0) {
+            return;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(delay_ms));
+        send_trades(client_fd, 1, 3, 200.0);
+        while (!done) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+        close(client_fd);
+    };
+    std::thread line_a(serve, server_fd_, 100);
+    std::thread line_b(serve, line_b_fd, 150);
+    
+    handler_ = std::make_unique<FeedHandler>("127.0.0.1", test_port_ + 2, num_symbols_);
+    handler_->set_line_b("127.0.0.1", test_port_ + 3);
+    ASSERT_TRUE(handler_->start());
+    
+    // Wait for the trailing line's copies of the new session too
+    for (int i = 0; i < 300 && handler_->get_arbitration_stats().duplicates < 13; ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    handler_->stop();
+    done = true;
+    line_a.join();
+    line_b.join();
+    close(line_b_fd);
+    
+    // The first line back restarts the symbol; the other line's copies of
+    // the new session are then ordinary duplicates
+    auto arb = handler_->get_arbitration_stats();
+    EXPECT_EQ(handler_->get_messages_received(), 13u);
+    EXPECT_EQ(arb.restarts, 1u);
+    EXPECT_EQ(arb.duplicates, 13u);
+    EXPECT_EQ(handler_->get_stats().sequence_gaps, 0u);
+    EXPECT_DOUBLE_EQ(handler_->get_cache().get_ltp(6), 203.0);
+}
+
+// Test: A late copy on a line that did not reconnect is not a new session:
+// it neither rolls the cache back nor lets the other line's next sequence
+// apply twice
+TEST_F(FeedHandlerTest, LateCopyIsNotARestart) {
+    server_fd_ = create_test_server(test_port_ + 5);
+    ASSERT_GE(server_fd_, 0);
+    int line_b_fd = create_test_server(test_port_ + 6);
+    ASSERT_GE(line_b_fd, 0);
+    
+    auto send_trade = [](int client_fd, uint32_t seq, double price) {
+        TradeMessage trade{};
+        trade.header.msg_type = static_cast<uint16_t>(MessageType::TRADE);
+        trade.header.seq_num = seq;
+        trade.header.symbol_id = 6;
+        trade.payload.price = price;
+        trade.payload.quantity = seq;
+        trade.checksum = calculate_checksum(&trade, sizeof(TradeMessage) - sizeof(uint32_t));
+        send(client_fd, &trade, sizeof(trade), MSG_NOSIGNAL);
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    };
+    
+    // B leads with 1-3; A follows with 1-3 and then a late 2 while B is at
+    // 3; then B and A each carry 4
+    std::atomic<bool> done{false};
+    auto serve = [&](int listen_fd, int delay_ms, bool late) {
+        int client_fd = accept(listen_fd, nullptr, nullptr);
+        if (client_fd < 0) {
+            return;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(delay_ms));
+        for (uint32_t seq = 1; seq <= 3; ++seq) {
+            send_trade(client_fd, seq, 100.0 + seq);
+        }
+        if (late) {
+            send_trade(client_fd, 2, 999.0);
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(200));
+        send_trade(client_fd, 4, 104.0);
+        while (!done) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+        close(client_fd);
+    };
+    std::thread line_a(serve, server_fd_, 200, true);
+    std::thread line_b(serve, line_b_fd, 100, false);
+    
+    handler_ = std::make_unique<FeedHandler>("127.0.0.1", test_port_ + 5, num_symbols_);
+    handler_->set_line_b("127.0.0.1", test_port_ + 6);
+    ASSERT_TRUE(handler_->start());
+    
+    // After A's late 2 (its fourth duplicate) the cache still holds 3
+    for (int i = 0; i < 300 && handler_->get_arbitration_stats().duplicates < 4; ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    EXPECT_DOUBLE_EQ(handler_->get_cache().get_ltp(6), 103.0);
+    for (int i = 0; i < 300 && handler_->get_arbitration_stats().duplicates < 5; ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    handler_->stop();
+    done = true;
+    line_a.join();
+    line_b.join();
+    close(line_b_fd);
+    
+    auto arb = handler_->get_arbitration_stats();
+    EXPECT_EQ(handler_->get_messages_received(), 4u);
+    EXPECT_EQ(arb.restarts, 0u);
+    EXPECT_EQ(arb.duplicates, 5u);
+    EXPECT_EQ(arb.wins[1], 4u);
+    EXPECT_DOUBLE_EQ(handler_->get_cache().get_ltp(6), 104.0);
+}
+
+// Test: A symbols file with ids past 65535 is remapped onto dense cache
+// slots, and trades for those ids land in their slots
+TEST_F(FeedHandlerTest, RemapsWideSymbolIdsToDenseSlots) {
+    std::string symbols_file = "/tmp/mdfh_feed_handler_wide_symbols.csv";
+    {
+        std::ofstream out(symbols_file);
+        out << "symbol_id,symbol,price,volatility,drift\n"
+            << "1000000,WIDE,100.0,0.02,0.0\n"
+            << "70000,MID,50.0,0.02,0.0\n"
+            << "3,LOW,10.0,0.02,0.0\n";
+    }
+    
+    server_fd_ = create_test_server(test_port_);
+    ASSERT_GE(server_fd_, 0);
+    
+    std::thread server_thread([this]() {
+        int client_fd = accept(server_fd_, nullptr, nullptr);
+        if (client_fd < 0) {
+            return;
+        }
+        std::vector<uint8_t> batch(3 * sizeof(TradeMessage));
+        uint32_t seq = 0;
+        for (SymbolId symbol_id : {1000000u, 70000u, 3u}) {
+            TradeMessage trade{};
+            trade.header.msg_type = static_cast<uint16_t>(MessageType::TRADE);
+            trade.header.seq_num = ++seq;
+            trade.header.symbol_id = symbol_id;
+            trade.payload.price = 1.0 + symbol_id;
+            trade.payload.quantity = 10;
+            trade.checksum = calculate_checksum(&trade, sizeof(TradeMessage) - sizeof(uint32_t));
+            std::memcpy(batch.data() + (seq - 1) * sizeof(TradeMessage), &trade, sizeof(TradeMessage));
+        }
+        send(client_fd, batch.data(), batch.size(), MSG_NOSIGNAL);
+        std::this_thread::sleep_for(std::chrono::milliseconds(300));
+        close(client_fd);
+    });
+    
+    handler_ = std::make_unique<FeedHandler>("127.0.0.1", test_port_, num_symbols_);
+    ASSERT_TRUE(handler_->load_symbols(symbols_file));
+    std::remove(symbols_file.c_str());
+    
+    const SymbolMap& map = handler_->get_symbol_map();
+    ASSERT_EQ(map.size(), 3u);
+    EXPECT_EQ(map.slot(1000000), 0u);
+    EXPECT_EQ(map.slot(70000), 1u);
+    EXPECT_EQ(map.slot(3), 2u);
+    EXPECT_EQ(handler_->get_symbol_name(70000), "MID");
+    EXPECT_EQ(handler_->get_symbol_name(4), "UNKNOWN");
+    
+    ASSERT_TRUE(handler_->start());
+    for (int i = 0; i < 100 && handler_->get_messages_received() < 3; ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    handler_->stop();
+    server_thread.join();
+    
+    EXPECT_EQ(handler_->get_cache().get_num_symbols(), 3u);  // Only the tracked symbols
+    EXPECT_DOUBLE_EQ(handler_->get_cache().get_ltp(map.slot(1000000)), 1000001.0);
+    EXPECT_DOUBLE_EQ(handler_->get_cache().get_ltp(map.slot(70000)), 70001.0);
+    EXPECT_DOUBLE_EQ(handler_->get_cache().get_ltp(map.slot(3)), 4.0);
+    EXPECT_EQ(handler_->get_stats().sequence_gaps, 0u);
+}
+
+// Test: A wide id reaches the consolidated book and the index engine, which
+// map exchange ids through their own copy of the handler's symbol map
+TEST_F(FeedHandlerTest, WideSymbolIdsReachBookAndIndex) {
+    std::string symbols_file = "/tmp/mdfh_feed_handler_wide_book.csv";
+    {
+        std::ofstream out(symbols_file);
+        out << "symbol_id,symbol,price,volatility,drift\n"
+            << "1000000,WIDE,100.0,0.02,0.0\n"
+            << "3,LOW,10.0,0.02,0.0\n";
+    }
+    
+    server_fd_ = create_test_server(test_port_ + 4);
+    ASSERT_GE(server_fd_, 0);
+    
+    std::thread server_thread([this]() {
+        int client_fd = accept(server_fd_, nullptr, nullptr);
+        if (client_fd < 0) {
+            return;
+        }
+        QuoteMessage quote{};
+        quote.header.msg_type = static_cast<uint16_t>(MessageType::QUOTE);
+        quote.header.seq_num = 1;
+        quote.header.symbol_id = 1000000;
+        quote.payload.bid_price = 99.5;
+        quote.payload.bid_qty = 100;
+        quote.payload.ask_price = 100.5;
+        quote.payload.ask_qty = 200;
+        quote.checksum = calculate_checksum(&quote, sizeof(QuoteMessage) - sizeof(uint32_t));
+        
+        TradeMessage trade{};
+        trade.header.msg_type = static_cast<uint16_t>(MessageType::TRADE);
+        trade.header.seq_num = 2;
+        trade.header.symbol_id = 1000000;
+        trade.payload.price = 125.0;
+        trade.payload.quantity = 10;
+        trade.checksum = calculate_checksum(&trade, sizeof(TradeMessage) - sizeof(uint32_t));
+        
+        send(client_fd, &quote, sizeof(quote), MSG_NOSIGNAL);
+        send(client_fd, &trade, sizeof(trade), MSG_NOSIGNAL);
+        std::this_thread::sleep_for(std::chrono::milliseconds(300));
+        close(client_fd);
+    });
+    
+    handler_ = std::make_unique<FeedHandler>("127.0.0.1", test_port_ + 4, num_symbols_);
+    ASSERT_TRUE(handler_->load_symbols(symbols_file));
+    std::remove(symbols_file.c_str());
+    
+    ConsolidatedBook book(handler_->get_symbol_map(), 1);
+    IndexDefinition def{"WIDE", IndexWeighting::PRICE, 1000.0, {{1000000, 1.0, 1.0}}};
+    IndexEngine engine(handler_->get_symbol_map(), {def});
+    handler_->set_consolidated_book(&book, 0);
+    handler_->set_index_engine(&engine);
+    
+    ASSERT_TRUE(handler_->start());
+    for (int i = 0; i < 100 && handler_->get_messages_received() < 2; ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    handler_->stop();
+    server_thread.join();
+    
+    EXPECT_EQ(book.get_num_symbols(), 2u);
+    auto snap = book.get_snapshot(1000000);
+    EXPECT_FALSE(snap.stale);
+    EXPECT_DOUBLE_EQ(snap.best_bid, 99.5);
+    EXPECT_DOUBLE_EQ(snap.best_ask, 100.5);
+    EXPECT_EQ(snap.ask_quantity, 200u);
+    EXPECT_EQ(engine.get_stats().updates, 1u);
+    EXPECT_DOUBLE_EQ(engine.get_value(0), 1000.0);
+}
+
 int main(int argc, char **argv) {
     ::testing::InitGoogleTest(&argc, argv);
     return RUN_ALL_TESTS();
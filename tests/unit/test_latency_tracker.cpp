@@ -1,5 +1,6 @@
 #include <gtest/gtest.h>
 #include "common/latency_tracker.h"
+#include <chrono>
 #include <thread>
 #include <vector>
 #include <random>
@@ -0,0 +1,107 @@
+#include <gtest/gtest.h>
+#include "server/exchange_simulator.h"
+#include "client/feed_handler.h"
+#include <fstream>
+#include <filesystem>
+#include <chrono>
+#include <thread>
+
+namespace fs = std::filesystem;
+
+namespace mdfh {
+
+// End to end: one simulator serves the same stream on line A and line B,
+// each line's client lands on its own reactor (independent scheduling and
+// send timing), and the feed handler arbitrates between the two
+class LineArbitrationTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        test_dir_ = "test_arbitration_temp";
+        fs::create_directories(test_dir_);
+        symbols_file_ = test_dir_ + "/symbols.csv";
+        config_file_ = test_dir_ + "/server.conf";
+
+        std::ofstream symbols(symbols_file_);
+        symbols << "symbol_id,symbol,price,volatility,drift\n";
+        for (int i = 0; i < NUM_SYMBOLS; ++i) {
+            symbols << i << ",SYM" << i << "," << (100.0 + i) << ",0.02,0.01\n";
+        }
+        symbols.close();
+
+        std::ofstream config(config_file_);
+        config << "server.port=" << PORT_A << "\n";
+        config << "server.line_b_port=" << PORT_B << "\n";
+        config << "server.num_reactors=2\n";
+        config << "market.num_symbols=" << NUM_SYMBOLS << "\n";
+        config << "market.tick_rate=0\n";
+        config << "market.symbols_file=" << fs::absolute(symbols_file_).string() << "\n";
+        config << "fault_injection.enabled=false\n";
+        config.close();
+    }
+
+    void TearDown() override {
+        if (fs::exists(test_dir_)) {
+            fs::remove_all(test_dir_);
+        }
+    }
+
+    static constexpr int NUM_SYMBOLS = 8;
+    static constexpr uint16_t PORT_A = 12360;
+    static constexpr uint16_t PORT_B = 12361;
+
+    std::string test_dir_;
+    std::string symbols_file_;
+    std::string config_file_;
+};
+
+// Test: Every tick is applied once, the second copy is dropped, and both
+// lines' wins and lead are reported
+TEST_F(LineArbitrationTest, TwoLinesFromOneSimulator) {
+    ExchangeSimulator sim(PORT_A, NUM_SYMBOLS, config_file_);
+    sim.set_tick_rate(0);
+    sim.start();
+    ASSERT_EQ(sim.get_num_reactors(), 2u);
+    std::thread event_thread([&sim]() {
+        sim.run();
+    });
+
+    FeedHandler handler("127.0.0.1", PORT_A, NUM_SYMBOLS);
+    handler.set_line_b("127.0.0.1", PORT_B);
+    ASSERT_TRUE(handler.start());
+    std::vector<SymbolId> symbols;
+    for (uint16_t i = 0; i < NUM_SYMBOLS; ++i) {
+        symbols.push_back(i);
+    }
+    ASSERT_TRUE(handler.subscribe(symbols));
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+
+    constexpr uint64_t TICKS = 2000;
+    for (uint64_t i = 0; i < TICKS; ++i) {
+        sim.generate_tick(static_cast<uint16_t>(i % NUM_SYMBOLS));
+    }
+
+    for (int i = 0; i < 300 && handler.get_arbitration_stats().duplicates < TICKS; ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    handler.stop();
+    sim.stop();
+    event_thread.join();
+
+    auto arb = handler.get_arbitration_stats();
+    auto stats = handler.get_stats();
+    EXPECT_EQ(handler.get_messages_received(), TICKS);
+    EXPECT_EQ(arb.wins[0] + arb.wins[1], TICKS);
+    EXPECT_EQ(arb.duplicates, TICKS);
+    EXPECT_EQ(arb.gaps_deferred, 0u);
+    EXPECT_EQ(stats.sequence_gaps, 0u);
+    EXPECT_EQ(stats.checksum_errors, 0u);
+    EXPECT_GT(arb.advantage[0].sample_count + arb.advantage[1].sample_count, 0u);
+    EXPECT_EQ(sim.get_stats().messages_sent, 2 * TICKS);
+}
+
+} // namespace mdfh
+
+int main(int argc, char** argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
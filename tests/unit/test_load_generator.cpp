@@ -0,0 +1,283 @@
+#include <gtest/gtest.h>
+#include "client/load_generator.h"
+#include "common/protocol.h"
+#include <chrono>
+#include <cstring>
+#include <set>
+#include <thread>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+#include <poll.h>
+#include <unistd.h>
+
+using namespace mdfh;
+
+class LoadGeneratorTest : public ::testing::Test {
+protected:
+    void TearDown() override {
+        for (int fd : client_fds_) {
+            close(fd);
+        }
+        if (server_fd_ >= 0) {
+            close(server_fd_);
+        }
+    }
+
+    int create_test_server(uint16_t port) {
+        int server_fd = socket(AF_INET, SOCK_STREAM, 0);
+        if (server_fd < 0) {
+            return -1;
+        }
+
+        int opt = 1;
+        setsockopt(server_fd, SOL_SOCKET, SO_REUSEADDR, &opt, sizeof(opt));
+
+        sockaddr_in addr{};
+        addr.sin_family = AF_INET;
+        addr.sin_addr.s_addr = INADDR_ANY;
+        addr.sin_port = htons(port);
+
+        if (bind(server_fd, (sockaddr*)&addr, sizeof(addr)) < 0 || listen(server_fd, 64) < 0) {
+            close(server_fd);
+            return -1;
+        }
+        return server_fd;
+    }
+
+    // Accept one client and read its subscription; returns the symbol ids
+    std::vector<SymbolId> accept_and_read_subscription() {
+        pollfd pfd{server_fd_, POLLIN, 0};
+        if (poll(&pfd, 1, 2000) <= 0) {
+            return {};
+        }
+        int fd = accept(server_fd_, nullptr, nullptr);
+        if (fd < 0) {
+            return {};
+        }
+        client_fds_.push_back(fd);
+
+        uint8_t buffer[1024];
+        size_t len = 0;
+        auto request_count = [&buffer]() {
+            uint32_t count;
+            std::memcpy(&count, buffer + 1, sizeof(count));
+            return count;
+        };
+        while (len < sizeof(SubscriptionHeader) ||
+               len < sizeof(SubscriptionHeader) + sizeof(SymbolId) * request_count()) {
+            pollfd cpfd{fd, POLLIN, 0};
+            if (poll(&cpfd, 1, 2000) <= 0) {
+                return {};
+            }
+            ssize_t n = recv(fd, buffer + len, sizeof(buffer) - len, 0);
+            if (n <= 0) {
+                return {};
+            }
+            len += static_cast<size_t>(n);
+        }
+
+        EXPECT_EQ(buffer[0], 0xFF);
+        uint32_t count = request_count();
+        std::vector<SymbolId> ids;
+        for (uint32_t i = 0; i < count; ++i) {
+            SymbolId id;
+            std::memcpy(&id, buffer + sizeof(SubscriptionHeader) + i * sizeof(SymbolId), sizeof(id));
+            ids.push_back(id);
+        }
+        return ids;
+    }
+
+    static TradeMessage make_trade(uint16_t symbol_id, uint32_t seq_num) {
+        TradeMessage trade{};
+        trade.header.msg_type = static_cast<uint16_t>(MessageType::TRADE);
+        trade.header.seq_num = seq_num;
+        trade.header.timestamp = 1;
+        trade.header.symbol_id = symbol_id;
+        trade.payload.price = 100.0;
+        trade.payload.quantity = 10;
+        trade.checksum = calculate_checksum(&trade, sizeof(TradeMessage) - sizeof(uint32_t));
+        return trade;
+    }
+
+    template<typename Pred>
+    static bool wait_for(Pred pred, int timeout_ms = 2000) {
+        for (int i = 0; i < timeout_ms / 10; ++i) {
+            if (pred()) return true;
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+        return pred();
+    }
+
+    int server_fd_ = -1;
+    std::vector<int> client_fds_;
+    const uint16_t test_port_ = 17950;
+};
+
+TEST_F(LoadGeneratorTest, SendsRandomizedSubscriptions) {
+    server_fd_ = create_test_server(test_port_);
+    ASSERT_GE(server_fd_, 0);
+
+    LoadGeneratorConfig config;
+    config.port = test_port_;
+    config.num_connections = 8;
+    config.num_threads = 2;
+    config.num_symbols = 20;
+    config.min_subscriptions = 2;
+    config.max_subscriptions = 5;
+
+    LoadGenerator generator(config);
+    ASSERT_TRUE(generator.start());
+
+    std::set<std::vector<SymbolId>> distinct;
+    for (size_t i = 0; i < config.num_connections; ++i) {
+        auto ids = accept_and_read_subscription();
+        ASSERT_GE(ids.size(), 2u);
+        ASSERT_LE(ids.size(), 5u);
+        std::set<SymbolId> unique(ids.begin(), ids.end());
+        EXPECT_EQ(unique.size(), ids.size());
+        for (SymbolId id : ids) {
+            EXPECT_LT(id, 20);
+        }
+        distinct.insert(ids);
+    }
+    EXPECT_GT(distinct.size(), 1u);
+
+    EXPECT_TRUE(wait_for([&] { return generator.get_stats().connections_open == 8; }));
+    generator.stop();
+}
+
+TEST_F(LoadGeneratorTest, CountsMessagesAndSequenceGaps) {
+    server_fd_ = create_test_server(test_port_ + 1);
+    ASSERT_GE(server_fd_, 0);
+
+    LoadGeneratorConfig config;
+    config.port = test_port_ + 1;
+    config.num_connections = 1;
+    config.num_symbols = 2;
+    config.min_subscriptions = 2;
+    config.max_subscriptions = 2;
+
+    LoadGenerator generator(config);
+    ASSERT_TRUE(generator.start());
+    ASSERT_EQ(accept_and_read_subscription().size(), 2u);
+    int fd = client_fds_.back();
+
+    // Symbol 0: 1, 2, 4 (one gap); symbol 1: 1, 2
+    std::vector<TradeMessage> trades = {
+        make_trade(0, 1), make_trade(1, 1), make_trade(0, 2), make_trade(1, 2), make_trade(0, 4)
+    };
+    const uint8_t* bytes = reinterpret_cast<const uint8_t*>(trades.data());
+    size_t total = trades.size() * sizeof(TradeMessage);
+
+    // Split mid-message to exercise the carry-over path
+    ASSERT_EQ(send(fd, bytes, 45, 0), 45);
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    ASSERT_EQ(send(fd, bytes + 45, total - 45, 0), static_cast<ssize_t>(total - 45));
+
+    ASSERT_TRUE(wait_for([&] { return generator.get_stats().messages == 5; }));
+    auto stats = generator.get_stats();
+    EXPECT_EQ(stats.bytes, total);
+    EXPECT_EQ(stats.sequence_gaps, 1u);
+    EXPECT_EQ(stats.malformed, 0u);
+
+    auto per_connection = generator.get_connection_stats();
+    ASSERT_EQ(per_connection.size(), 1u);
+    EXPECT_TRUE(per_connection[0].connected);
+    EXPECT_EQ(per_connection[0].messages, 5u);
+    EXPECT_EQ(per_connection[0].sequence_gaps, 1u);
+    generator.stop();
+}
+
+TEST_F(LoadGeneratorTest, ValidateCountsChecksumErrors) {
+    server_fd_ = create_test_server(test_port_ + 2);
+    ASSERT_GE(server_fd_, 0);
+
+    LoadGeneratorConfig config;
+    config.port = test_port_ + 2;
+    config.num_connections = 1;
+    config.num_symbols = 1;
+    config.validate = true;
+
+    LoadGenerator generator(config);
+    ASSERT_TRUE(generator.start());
+    ASSERT_EQ(accept_and_read_subscription().size(), 1u);
+
+    TradeMessage trades[2] = {make_trade(0, 1), make_trade(0, 2)};
+    trades[1].checksum ^= 0x1;
+    ASSERT_EQ(send(client_fds_.back(), trades, sizeof(trades), 0), static_cast<ssize_t>(sizeof(trades)));
+
+    ASSERT_TRUE(wait_for([&] { return generator.get_stats().checksum_errors == 1; }));
+    EXPECT_EQ(generator.get_stats().messages, 1u);
+    generator.stop();
+}
+
+TEST_F(LoadGeneratorTest, ResyncsAfterGarbage) {
+    server_fd_ = create_test_server(test_port_ + 3);
+    ASSERT_GE(server_fd_, 0);
+
+    LoadGeneratorConfig config;
+    config.port = test_port_ + 3;
+    config.num_connections = 1;
+    config.num_symbols = 1;
+
+    LoadGenerator generator(config);
+    ASSERT_TRUE(generator.start());
+    ASSERT_EQ(accept_and_read_subscription().size(), 1u);
+
+    uint8_t buffer[3 + 2 * sizeof(TradeMessage)];
+    TradeMessage first = make_trade(0, 1);
+    TradeMessage second = make_trade(0, 2);
+    std::memcpy(buffer, &first, sizeof(first));
+    std::memset(buffer + sizeof(first), 0xEE, 3);
+    std::memcpy(buffer + sizeof(first) + 3, &second, sizeof(second));
+    ASSERT_EQ(send(client_fds_.back(), buffer, sizeof(buffer), 0), static_cast<ssize_t>(sizeof(buffer)));
+
+    ASSERT_TRUE(wait_for([&] { return generator.get_stats().messages == 2; }));
+    EXPECT_EQ(generator.get_stats().malformed, 1u);
+    EXPECT_EQ(generator.get_stats().sequence_gaps, 0u);
+    generator.stop();
+}
+
+TEST_F(LoadGeneratorTest, CountsConnectFailuresAndDisconnects) {
+    LoadGeneratorConfig config;
+    config.port = test_port_ + 4;  // Nothing listening
+    config.num_connections = 4;
+
+    {
+        LoadGenerator generator(config);
+        ASSERT_TRUE(generator.start());
+        EXPECT_TRUE(wait_for([&] { return generator.get_stats().connect_failures == 4; }));
+        EXPECT_EQ(generator.get_stats().connections_open, 0u);
+    }
+
+    server_fd_ = create_test_server(test_port_ + 4);
+    ASSERT_GE(server_fd_, 0);
+    config.num_connections = 1;
+
+    LoadGenerator generator(config);
+    ASSERT_TRUE(generator.start());
+    ASSERT_FALSE(accept_and_read_subscription().empty());
+    ASSERT_TRUE(wait_for([&] { return generator.get_stats().connections_open == 1; }));
+
+    close(client_fds_.back());
+    client_fds_.pop_back();
+
+    EXPECT_TRUE(wait_for([&] { return generator.get_stats().disconnects == 1; }));
+    EXPECT_EQ(generator.get_stats().connections_open, 0u);
+    EXPECT_GT(generator.get_connection_stats()[0].disconnected_ns, 0u);
+}
+
+TEST_F(LoadGeneratorTest, InvalidHostFailsToStart) {
+    LoadGeneratorConfig config;
+    config.host = "not-an-address";
+    config.num_connections = 1;
+
+    LoadGenerator generator(config);
+    EXPECT_FALSE(generator.start());
+}
+
+int main(int argc, char** argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
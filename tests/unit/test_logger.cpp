@@ -0,0 +1,233 @@
+#include <gtest/gtest.h>
+#include "common/logger.h"
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace mdfh;
+
+int main(int argc, char** argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
+
+class LoggerTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        out_ = std::tmpfile();
+        ASSERT_NE(out_, nullptr);
+        Logger::instance().set_output(out_);
+    }
+
+    void TearDown() override {
+        Logger::instance().set_output(nullptr);
+        std::fclose(out_);
+    }
+
+    // Flush the logger and return everything written to the temp file
+    std::string read_output() {
+        Logger::instance().flush();
+        std::string result;
+        std::rewind(out_);
+        char buf[4096];
+        size_t n;
+        while ((n = std::fread(buf, 1, sizeof(buf), out_)) > 0) {
+            result.append(buf, n);
+        }
+        return result;
+    }
+
+    static size_t count_lines(const std::string& text, const std::string& needle) {
+        size_t count = 0;
+        size_t pos = 0;
+        while ((pos = text.find(needle, pos)) != std::string::npos) {
+            count++;
+            pos += needle.size();
+        }
+        return count;
+    }
+
+    FILE* out_ = nullptr;
+};
+
+TEST_F(LoggerTest, FormatsArguments) {
+    MDFH_LOG_INFO("int={} uint={} dbl={} str={}", -42, 7u, 2.5, "RELIANCE");
+
+    std::string out = read_output();
+    EXPECT_NE(out.find("[INFO] int=-42 uint=7 dbl=2.5 str=RELIANCE"), std::string::npos) << out;
+}
+
+TEST_F(LoggerTest, FormatsStdStringAndLongStrings) {
+    std::string host = "127.0.0.1";
+    std::string path = "/var/lib/mdfh/config/" + std::string(64, 'x') + "/server.conf";
+    MDFH_LOG_ERROR("host={} path={}", host, path);
+
+    std::string out = read_output();
+    EXPECT_NE(out.find("[ERROR] host=127.0.0.1 path=" + path + "\n"), std::string::npos) << out;
+}
+
+TEST_F(LoggerTest, LongStringsWrapSpillBuffer) {
+    // Each string is a sizeable part of the spill buffer, so the writes wrap
+    const size_t len = LogRing::SPILL_CAPACITY / 5;
+    for (int i = 0; i < 12; ++i) {
+        MDFH_LOG_INFO("n={} s={}", i, std::string(len, static_cast<char>('a' + i)));
+        Logger::instance().flush();
+    }
+
+    std::string out = read_output();
+    for (int i = 0; i < 12; ++i) {
+        std::string expected = "n=" + std::to_string(i) + " s=" + std::string(len, static_cast<char>('a' + i)) + "\n";
+        EXPECT_NE(out.find(expected), std::string::npos) << i;
+    }
+}
+
+TEST_F(LoggerTest, OversizedStringTruncatedVisibly) {
+    std::string huge(LogRing::MAX_SPILL_STR + 1, 'y');
+    MDFH_LOG_WARN("huge={}", huge);
+
+    std::string out = read_output();
+    EXPECT_NE(out.find("huge=" + std::string(LogArg::MAX_STR - 3, 'y') + "...\n"), std::string::npos) << out;
+}
+
+TEST_F(LoggerTest, ExitedThreadRingsAreFreed) {
+    MDFH_LOG_INFO("main ring");
+    read_output();
+    size_t before = Logger::instance().get_num_rings();
+
+    for (int t = 0; t < 8; ++t) {
+        std::thread([t] { MDFH_LOG_INFO("short-lived thread {}", t); }).join();
+    }
+
+    // The logger thread frees a retired ring once it has drained it
+    std::string out = read_output();
+    for (int i = 0; i < 200 && Logger::instance().get_num_rings() > before; ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    EXPECT_EQ(Logger::instance().get_num_rings(), before);
+    EXPECT_EQ(count_lines(out, "short-lived thread "), 8u);
+}
+
+TEST_F(LoggerTest, ExtraPlaceholdersLeftVerbatim) {
+    MDFH_LOG_INFO("a={} b={}", 1);
+
+    std::string out = read_output();
+    EXPECT_NE(out.find("a=1 b={}"), std::string::npos) << out;
+}
+
+TEST_F(LoggerTest, LevelFilterSkipsDebug) {
+    MDFH_LOG_DEBUG("debug message {}", 1);
+    MDFH_LOG_INFO("info message {}", 1);
+
+    std::string out = read_output();
+    EXPECT_EQ(out.find("debug message"), std::string::npos);
+    EXPECT_NE(out.find("info message"), std::string::npos);
+}
+
+TEST_F(LoggerTest, DeduplicatesIdenticalArguments) {
+    for (int i = 0; i < 100; ++i) {
+        MDFH_LOG_WARN("Slow consumer detected on fd {}", 5);
+    }
+
+    std::string out = read_output();
+    EXPECT_EQ(count_lines(out, "Slow consumer detected on fd 5"), 1u) << out;
+}
+
+TEST_F(LoggerTest, DeduplicatesLongStringsByContent) {
+    // Admission hashes the whole string before anything is spilled
+    std::string path(200, 'x');
+    for (int i = 0; i < 50; ++i) {
+        MDFH_LOG_WARN("cannot open {}", path);
+    }
+    path.back() = 'y';
+    MDFH_LOG_WARN("cannot open {}", path);
+
+    std::string out = read_output();
+    EXPECT_EQ(count_lines(out, "cannot open " + std::string(199, 'x') + "x"), 1u);
+    EXPECT_EQ(count_lines(out, "cannot open " + std::string(199, 'x') + "y"), 1u);
+}
+
+TEST_F(LoggerTest, DistinctArgumentsAreNotDeduplicated) {
+    for (int i = 0; i < 10; ++i) {
+        MDFH_LOG_INFO("distinct value {}", i);
+    }
+
+    std::string out = read_output();
+    EXPECT_EQ(count_lines(out, "distinct value"), 10u) << out;
+}
+
+TEST_F(LoggerTest, RateLimitPerCallSite) {
+    for (int i = 0; i < 1000; ++i) {
+        MDFH_LOG_WARN_RL(5, "rate limited {}", i);
+    }
+    // A different call site is unaffected
+    MDFH_LOG_WARN_RL(5, "other site {}", 1);
+
+    std::string out = read_output();
+    EXPECT_EQ(count_lines(out, "[WARN] rate limited"), 5u) << out;
+    EXPECT_EQ(count_lines(out, "other site 1"), 1u) << out;
+}
+
+TEST_F(LoggerTest, SuppressedCountReportedWithNextRecord) {
+    LogSite site(LogLevel::INFO, "value {}", 0);
+
+    uint64_t folded = 0;
+    EXPECT_TRUE(site.admit(1000, 1, folded));
+    EXPECT_EQ(folded, 0u);
+    EXPECT_FALSE(site.admit(2000, 1, folded));
+    EXPECT_FALSE(site.admit(3000, 1, folded));
+    EXPECT_TRUE(site.admit(4000, 2, folded));
+    EXPECT_EQ(folded, 2u);
+}
+
+TEST_F(LoggerTest, DedupWindowExpires) {
+    LogSite site(LogLevel::INFO, "value {}", 0);
+
+    uint64_t folded = 0;
+    EXPECT_TRUE(site.admit(0 + 1, 7, folded));
+    EXPECT_FALSE(site.admit(LogSite::WINDOW_NS / 2, 7, folded));
+    EXPECT_TRUE(site.admit(LogSite::WINDOW_NS + 2, 7, folded));
+    EXPECT_EQ(folded, 1u);
+}
+
+TEST_F(LoggerTest, MultipleProducerThreads) {
+    constexpr int NUM_THREADS = 4;
+    constexpr int PER_THREAD = 200;
+
+    uint64_t written_before = Logger::instance().get_records_written();
+    uint64_t dropped_before = Logger::instance().get_records_dropped();
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < NUM_THREADS; ++t) {
+        threads.emplace_back([t] {
+            for (int i = 0; i < PER_THREAD; ++i) {
+                MDFH_LOG_INFO("thread {} msg {}", t, i);
+            }
+        });
+    }
+    for (auto& th : threads) {
+        th.join();
+    }
+
+    std::string out = read_output();
+    uint64_t written = Logger::instance().get_records_written() - written_before;
+    uint64_t dropped = Logger::instance().get_records_dropped() - dropped_before;
+
+    EXPECT_EQ(written + dropped, static_cast<uint64_t>(NUM_THREADS * PER_THREAD));
+    EXPECT_EQ(count_lines(out, "thread "), written);
+}
+
+TEST_F(LoggerTest, FormatRecordAppendsFoldedCount) {
+    static LogSite site(LogLevel::ERROR, "fd {}", 0);
+
+    LogRecord rec{};
+    rec.site = &site;
+    rec.timestamp_ns = Logger::now_ns();
+    rec.folded = 3;
+    rec.num_args = 1;
+    log_detail::encode(rec.args[0], 9);
+
+    std::string line = Logger::format_record(rec);
+    EXPECT_NE(line.find("[ERROR] fd 9 [suppressed 3 similar]"), std::string::npos) << line;
+}
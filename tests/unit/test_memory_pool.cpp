@@ -1,5 +1,6 @@
 #include <gtest/gtest.h>
 #include "common/memory_pool.h"
+#include <chrono>
 #include <thread>
 #include <vector>
 
@@ -0,0 +1,267 @@
+#include <gtest/gtest.h>
+#include "server/order_book.h"
+#include "server/order_flow.h"
+#include <map>
+#include <random>
+
+using namespace mdfh;
+
+class OrderBookTest : public ::testing::Test {
+protected:
+    static constexpr uint32_t REF = 10000;
+
+    OrderBook book{REF, 256};
+    std::vector<Fill> fills;
+};
+
+// Test: An empty book has no top of book
+TEST_F(OrderBookTest, EmptyBook) {
+    auto top = book.top();
+    EXPECT_EQ(top.bid_tick, OrderBook::NO_PRICE);
+    EXPECT_EQ(top.ask_tick, OrderBook::NO_PRICE);
+    EXPECT_EQ(top.bid_quantity, 0u);
+    EXPECT_EQ(book.order_count(), 0u);
+}
+
+// Test: Non-crossing limits rest and set the best on each side
+TEST_F(OrderBookTest, RestingOrdersSetTopOfBook) {
+    EXPECT_NE(book.add_limit(Side::BUY, REF - 2, 100, fills), 0u);
+    EXPECT_NE(book.add_limit(Side::BUY, REF - 1, 200, fills), 0u);
+    EXPECT_NE(book.add_limit(Side::BUY, REF - 1, 50, fills), 0u);
+    EXPECT_NE(book.add_limit(Side::SELL, REF + 1, 300, fills), 0u);
+    EXPECT_TRUE(fills.empty());
+
+    auto top = book.top();
+    EXPECT_EQ(top.bid_tick, REF - 1);
+    EXPECT_EQ(top.bid_quantity, 250u);
+    EXPECT_EQ(top.ask_tick, REF + 1);
+    EXPECT_EQ(top.ask_quantity, 300u);
+    EXPECT_EQ(book.order_count(), 4u);
+}
+
+// Test: Within a level the oldest order fills first; a partial fill keeps
+// its place
+TEST_F(OrderBookTest, TimePriorityWithinLevel) {
+    uint64_t first = book.add_limit(Side::SELL, REF, 100, fills);
+    uint64_t second = book.add_limit(Side::SELL, REF, 100, fills);
+
+    EXPECT_EQ(book.add_limit(Side::BUY, REF, 150, fills), 0u);
+    ASSERT_EQ(fills.size(), 2u);
+    EXPECT_EQ(fills[0].maker_id, first);
+    EXPECT_EQ(fills[0].quantity, 100u);
+    EXPECT_TRUE(fills[0].maker_done);
+    EXPECT_EQ(fills[1].maker_id, second);
+    EXPECT_EQ(fills[1].quantity, 50u);
+    EXPECT_FALSE(fills[1].maker_done);
+    EXPECT_EQ(book.quantity_at(REF), 50u);
+
+    fills.clear();
+    uint64_t third = book.add_limit(Side::SELL, REF, 100, fills);
+    book.add_market(Side::BUY, 60, fills);
+    ASSERT_EQ(fills.size(), 2u);
+    EXPECT_EQ(fills[0].maker_id, second);
+    EXPECT_EQ(fills[1].maker_id, third);
+    EXPECT_EQ(fills[1].quantity, 10u);
+}
+
+// Test: Better prices fill first and each fill is at the maker's price; the
+// remainder of a crossing limit rests at its own price
+TEST_F(OrderBookTest, PricePriorityAndRemainderRests) {
+    book.add_limit(Side::SELL, REF + 3, 100, fills);
+    book.add_limit(Side::SELL, REF + 1, 100, fills);
+    book.add_limit(Side::SELL, REF + 2, 100, fills);
+
+    uint64_t id = book.add_limit(Side::BUY, REF + 2, 250, fills);
+    ASSERT_EQ(fills.size(), 2u);
+    EXPECT_EQ(fills[0].price_tick, REF + 1);
+    EXPECT_EQ(fills[1].price_tick, REF + 2);
+    EXPECT_NE(id, 0u);
+
+    auto top = book.top();
+    EXPECT_EQ(top.bid_tick, REF + 2);
+    EXPECT_EQ(top.bid_quantity, 50u);
+    EXPECT_EQ(top.ask_tick, REF + 3);
+}
+
+// Test: A market order sweeps levels and drops what it cannot fill
+TEST_F(OrderBookTest, MarketOrderSweepsAndDiscardsRemainder) {
+    book.add_limit(Side::BUY, REF - 1, 100, fills);
+    book.add_limit(Side::BUY, REF - 5, 100, fills);
+
+    EXPECT_EQ(book.add_market(Side::SELL, 500, fills), 200u);
+    ASSERT_EQ(fills.size(), 2u);
+    EXPECT_EQ(fills[1].price_tick, REF - 5);
+    EXPECT_EQ(book.top().bid_tick, OrderBook::NO_PRICE);
+    EXPECT_EQ(book.order_count(), 0u);
+}
+
+// Test: Cancel removes an order in O(1) by id, updates the best, and stale
+// or unknown ids are rejected even after the slot is reused
+TEST_F(OrderBookTest, CancelById) {
+    uint64_t a = book.add_limit(Side::BUY, REF - 1, 100, fills);
+    uint64_t b = book.add_limit(Side::BUY, REF - 1, 100, fills);
+    uint64_t c = book.add_limit(Side::BUY, REF - 3, 100, fills);
+
+    EXPECT_TRUE(book.cancel(a));
+    EXPECT_FALSE(book.cancel(a));
+    EXPECT_EQ(book.top().bid_quantity, 100u);
+
+    EXPECT_TRUE(book.cancel(b));
+    EXPECT_EQ(book.top().bid_tick, REF - 3);
+
+    // b's slot is reused by the next order; b's id must not cancel it
+    uint64_t d = book.add_limit(Side::BUY, REF - 2, 100, fills);
+    EXPECT_EQ(static_cast<uint32_t>(d), static_cast<uint32_t>(b));
+    EXPECT_NE(d, b);
+    EXPECT_FALSE(book.cancel(b));
+    EXPECT_EQ(book.top().bid_tick, REF - 2);
+
+    EXPECT_TRUE(book.cancel(c));
+    EXPECT_TRUE(book.cancel(d));
+    EXPECT_FALSE(book.cancel(0));
+    EXPECT_FALSE(book.cancel(12345678));
+    EXPECT_EQ(book.top().bid_tick, OrderBook::NO_PRICE);
+}
+
+// Test: Filled orders cannot be cancelled
+TEST_F(OrderBookTest, FilledOrderNotCancellable) {
+    uint64_t id = book.add_limit(Side::SELL, REF, 100, fills);
+    book.add_market(Side::BUY, 100, fills);
+    EXPECT_FALSE(book.cancel(id));
+}
+
+// Test: The band re-centres when the price moves away, keeping resting
+// orders; an order that cannot fit with them is rejected
+TEST_F(OrderBookTest, PriceBandRecenters) {
+    uint64_t resting = book.add_limit(Side::BUY, REF, 100, fills);
+
+    // Well above the initial band but within reach of the resting order
+    EXPECT_NE(book.add_limit(Side::SELL, REF + 200, 100, fills), 0u);
+    EXPECT_EQ(book.get_recenters(), 1u);
+    EXPECT_EQ(book.quantity_at(REF), 100u);
+    EXPECT_EQ(book.top().ask_tick, REF + 200);
+
+    // Too far from the resting bid for one band
+    EXPECT_EQ(book.add_limit(Side::SELL, REF + 1000, 100, fills), 0u);
+    EXPECT_EQ(book.get_rejected(), 1u);
+
+    EXPECT_TRUE(book.cancel(resting));
+    EXPECT_EQ(book.top().bid_tick, OrderBook::NO_PRICE);
+    EXPECT_EQ(book.top().ask_tick, REF + 200);
+}
+
+// Test: Random flow against a reference model: top of book, level totals
+// and fills agree, and the book is never left crossed
+TEST_F(OrderBookTest, RandomFlowMatchesReferenceModel) {
+    OrderFlowConfig config;
+    config.max_depth_ticks = 15;
+    config.max_live_orders = 300;
+    OrderFlowGenerator flow(config, 42);
+
+    // Reference: price -> total quantity per side
+    std::map<uint32_t, uint64_t> bids;
+    std::map<uint32_t, uint64_t> asks;
+    std::map<uint64_t, std::pair<uint32_t, uint32_t>> live;  // id -> (price, remaining)
+    std::map<uint64_t, Side> sides;
+
+    std::mt19937 walk(3);
+    uint32_t reference = REF;
+    uint64_t traded = 0;
+    for (int i = 0; i < 50000; ++i) {
+        if (walk() % 8 == 0) {
+            reference += (walk() % 2) ? 1 : -1;
+        }
+        OrderEvent event = flow.next(reference);
+        fills.clear();
+
+        uint64_t id = 0;
+        if (event.type == OrderEvent::Type::LIMIT) {
+            id = book.add_limit(event.side, event.price_tick, event.quantity, fills);
+        } else if (event.type == OrderEvent::Type::MARKET) {
+            book.add_market(event.side, event.quantity, fills);
+        } else {
+            auto it = live.find(event.order_id);
+            bool expected = it != live.end();
+            ASSERT_EQ(book.cancel(event.order_id), expected);
+            if (expected) {
+                auto& levels = sides[event.order_id] == Side::BUY ? bids : asks;
+                levels[it->second.first] -= it->second.second;
+                if (levels[it->second.first] == 0) levels.erase(it->second.first);
+                live.erase(it);
+            }
+        }
+
+        uint64_t filled = 0;
+        for (const Fill& fill : fills) {
+            flow.on_fill(fill);
+            auto it = live.find(fill.maker_id);
+            ASSERT_NE(it, live.end());
+            ASSERT_EQ(it->second.first, fill.price_tick);
+            ASSERT_LE(fill.quantity, it->second.second);
+            auto& levels = sides[fill.maker_id] == Side::BUY ? bids : asks;
+            levels[fill.price_tick] -= fill.quantity;
+            if (levels[fill.price_tick] == 0) levels.erase(fill.price_tick);
+            it->second.second -= fill.quantity;
+            ASSERT_EQ(it->second.second == 0, fill.maker_done);
+            if (fill.maker_done) live.erase(it);
+            filled += fill.quantity;
+        }
+        traded += filled;
+
+        if (id != 0) {
+            flow.on_resting(id);
+            uint32_t remaining = event.quantity - static_cast<uint32_t>(filled);
+            live[id] = {event.price_tick, remaining};
+            sides[id] = event.side;
+            (event.side == Side::BUY ? bids : asks)[event.price_tick] += remaining;
+        }
+
+        auto top = book.top();
+        if (bids.empty()) {
+            ASSERT_EQ(top.bid_tick, OrderBook::NO_PRICE);
+        } else {
+            ASSERT_EQ(top.bid_tick, bids.rbegin()->first) << "event " << i;
+            ASSERT_EQ(top.bid_quantity, bids.rbegin()->second) << "event " << i;
+        }
+        if (asks.empty()) {
+            ASSERT_EQ(top.ask_tick, OrderBook::NO_PRICE);
+        } else {
+            ASSERT_EQ(top.ask_tick, asks.begin()->first) << "event " << i;
+            ASSERT_EQ(top.ask_quantity, asks.begin()->second) << "event " << i;
+        }
+        if (!bids.empty() && !asks.empty()) {
+            ASSERT_LT(top.bid_tick, top.ask_tick);
+        }
+        ASSERT_EQ(book.order_count(), live.size());
+    }
+
+    EXPECT_GT(traded, 0u);
+    EXPECT_LE(flow.live_orders(), config.max_live_orders);
+}
+
+// Test: The flow generator only cancels orders it still holds
+TEST(OrderFlowTest, CancelsOnlyLiveOrders) {
+    OrderFlowConfig config;
+    config.limit_ratio = 0.0;
+    config.market_ratio = 0.0;
+    config.cancel_ratio = 1.0;
+    OrderFlowGenerator flow(config, 1);
+
+    flow.on_resting(5);
+    flow.on_resting(7);
+    flow.on_fill(Fill{5, 100, 10, true});
+    EXPECT_EQ(flow.live_orders(), 1u);
+
+    OrderEvent event = flow.next(100);
+    EXPECT_EQ(event.type, OrderEvent::Type::CANCEL);
+    EXPECT_EQ(event.order_id, 7u);
+    EXPECT_EQ(flow.live_orders(), 0u);
+
+    // Nothing left to cancel: falls back to a limit order
+    EXPECT_EQ(flow.next(100).type, OrderEvent::Type::LIMIT);
+}
+
+int main(int argc, char** argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,390 @@
+#include <gtest/gtest.h>
+#include "server/exchange_simulator.h"
+#include "client/feed_handler.h"
+#include "client/order_sender.h"
+#include <algorithm>
+#include <fstream>
+#include <filesystem>
+#include <thread>
+#include <chrono>
+#include <mutex>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+
+namespace fs = std::filesystem;
+
+namespace mdfh {
+
+class OrderGatewayTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        test_dir_ = "test_order_gateway_temp";
+        fs::create_directories(test_dir_);
+        symbols_file_ = test_dir_ + "/symbols.csv";
+
+        std::ofstream symbols(symbols_file_);
+        symbols << "symbol_id,symbol,price,volatility,drift\n";
+        for (size_t i = 0; i < NUM_SYMBOLS; ++i) {
+            symbols << i << ",SYM" << i << "," << (100.0 + i) << ",0.02,0.01\n";
+        }
+    }
+
+    void TearDown() override {
+        if (sim_) {
+            sim_->stop();
+        }
+        if (event_thread_.joinable()) {
+            event_thread_.join();
+        }
+        sim_.reset();
+        if (fs::exists(test_dir_)) {
+            fs::remove_all(test_dir_);
+        }
+    }
+
+    // Start a simulator with order entry on ORDER_PORT and no agent flow
+    void start_simulator(bool matching) {
+        std::string config_file = test_dir_ + "/server.conf";
+        std::ofstream config(config_file);
+        config << "server.port=" << FEED_PORT << "\n";
+        config << "server.order_port=" << ORDER_PORT << "\n";
+        config << "market.num_symbols=" << NUM_SYMBOLS << "\n";
+        config << "market.tick_rate=0\n";
+        config << "market.symbols_file=" << fs::absolute(symbols_file_).string() << "\n";
+        config << "market.mode=" << (matching ? "matching" : "gbm") << "\n";
+        config.close();
+
+        sim_ = std::make_unique<ExchangeSimulator>(FEED_PORT, NUM_SYMBOLS, config_file);
+        sim_->set_tick_rate(0);
+        sim_->start();
+        event_thread_ = std::thread([this]() { sim_->run(); });
+    }
+
+    // Send count limit orders in batches small enough for the socket buffer,
+    // draining the acks between them; returns how many rest
+    size_t fill_open_orders(OrderSender& sender, SymbolId symbol, OrderSide side, double price, size_t count) {
+        size_t resting = 0;
+        for (size_t sent = 0; sent < count;) {
+            size_t batch = std::min<size_t>(256, count - sent);
+            for (size_t i = 0; i < batch; ++i) {
+                sender.send_new_order(symbol, side, OrderType::LIMIT, price, 1);
+            }
+            sent += batch;
+            for (const auto& ack : wait_acks(sender, batch)) {
+                resting += ack.payload.status == static_cast<uint8_t>(OrderStatus::NEW);
+            }
+        }
+        return resting;
+    }
+
+    // Wait for count acks in total
+    std::vector<OrderAckMessage> wait_acks(OrderSender& sender, size_t count) {
+        std::vector<OrderAckMessage> acks;
+        for (int i = 0; i < 200 && acks.size() < count; ++i) {
+            sender.poll_acks([&acks](const OrderAckMessage& ack) { acks.push_back(ack); }, 10);
+        }
+        return acks;
+    }
+
+    static int connect_raw() {
+        int fd = socket(AF_INET, SOCK_STREAM, 0);
+        struct sockaddr_in addr{};
+        addr.sin_family = AF_INET;
+        addr.sin_port = htons(ORDER_PORT);
+        inet_pton(AF_INET, "127.0.0.1", &addr.sin_addr);
+        if (connect(fd, (struct sockaddr*)&addr, sizeof(addr)) < 0) {
+            close(fd);
+            return -1;
+        }
+        return fd;
+    }
+
+    static NewOrderMessage make_order(uint64_t client_order_id, uint8_t side, double price, uint32_t quantity) {
+        NewOrderMessage msg{};
+        msg.header.msg_type = static_cast<uint16_t>(MessageType::NEW_ORDER);
+        msg.header.symbol_id = 1;
+        msg.payload.client_order_id = client_order_id;
+        msg.payload.price = price;
+        msg.payload.quantity = quantity;
+        msg.payload.side = side;
+        msg.payload.order_type = static_cast<uint8_t>(OrderType::LIMIT);
+        msg.checksum = calculate_checksum(&msg, sizeof(msg) - 4);
+        return msg;
+    }
+
+    static bool read_ack(int fd, OrderAckMessage& ack) {
+        size_t got = 0;
+        while (got < sizeof(ack)) {
+            ssize_t n = recv(fd, reinterpret_cast<uint8_t*>(&ack) + got, sizeof(ack) - got, 0);
+            if (n <= 0) return false;
+            got += n;
+        }
+        return validate_checksum(&ack, sizeof(ack));
+    }
+
+    static constexpr size_t NUM_SYMBOLS = 4;
+    static constexpr uint16_t FEED_PORT = 12380;
+    static constexpr uint16_t ORDER_PORT = 12381;
+
+    std::string test_dir_;
+    std::string symbols_file_;
+    std::unique_ptr<ExchangeSimulator> sim_;
+    std::thread event_thread_;
+};
+
+// Test: Without a book, limit orders are acknowledged as resting and can be
+// cancelled once; market orders expire unfilled
+TEST_F(OrderGatewayTest, GbmModeAcknowledgesAndCancels) {
+    start_simulator(false);
+    OrderSender sender;
+    ASSERT_TRUE(sender.connect("127.0.0.1", ORDER_PORT));
+
+    uint64_t limit_id = sender.send_new_order(0, OrderSide::BUY, OrderType::LIMIT, 99.5, 100, 42);
+    uint64_t market_id = sender.send_new_order(0, OrderSide::SELL, OrderType::MARKET, 0.0, 100);
+    ASSERT_NE(limit_id, 0u);
+    auto acks = wait_acks(sender, 2);
+    ASSERT_EQ(acks.size(), 2u);
+
+    EXPECT_EQ(acks[0].payload.client_order_id, limit_id);
+    EXPECT_EQ(acks[0].payload.status, static_cast<uint8_t>(OrderStatus::NEW));
+    EXPECT_EQ(acks[0].payload.leaves_quantity, 100u);
+    EXPECT_EQ(acks[0].payload.trigger_timestamp, 42u);
+    EXPECT_NE(acks[0].payload.exchange_order_id, 0u);
+    EXPECT_EQ(acks[0].header.seq_num, 1u);
+    EXPECT_EQ(acks[1].payload.client_order_id, market_id);
+    EXPECT_EQ(acks[1].payload.status, static_cast<uint8_t>(OrderStatus::EXPIRED));
+    EXPECT_EQ(acks[1].payload.filled_quantity, 0u);
+
+    ASSERT_TRUE(sender.send_cancel(0, limit_id));
+    ASSERT_TRUE(sender.send_cancel(0, limit_id));
+    acks = wait_acks(sender, 2);
+    ASSERT_EQ(acks.size(), 2u);
+    EXPECT_EQ(acks[0].payload.status, static_cast<uint8_t>(OrderStatus::CANCELLED));
+    EXPECT_EQ(acks[1].payload.status, static_cast<uint8_t>(OrderStatus::REJECTED));
+    EXPECT_EQ(acks[1].payload.reject_reason, static_cast<uint8_t>(RejectReason::UNKNOWN_ORDER));
+}
+
+// Test: A session holds at most MAX_OPEN_ORDERS open orders; a cancel
+// makes room for another
+TEST_F(OrderGatewayTest, CapsOpenOrdersPerSession) {
+    start_simulator(false);
+    OrderSender sender;
+    ASSERT_TRUE(sender.connect("127.0.0.1", ORDER_PORT));
+
+    ASSERT_EQ(fill_open_orders(sender, 0, OrderSide::BUY, 99.5, OrderGateway::MAX_OPEN_ORDERS),
+              OrderGateway::MAX_OPEN_ORDERS);
+
+    uint64_t over = sender.send_new_order(0, OrderSide::BUY, OrderType::LIMIT, 99.5, 1);
+    auto acks = wait_acks(sender, 1);
+    ASSERT_EQ(acks.size(), 1u);
+    EXPECT_EQ(acks[0].payload.client_order_id, over);
+    EXPECT_EQ(acks[0].payload.status, static_cast<uint8_t>(OrderStatus::REJECTED));
+    EXPECT_EQ(acks[0].payload.reject_reason, static_cast<uint8_t>(RejectReason::TOO_MANY_OPEN_ORDERS));
+
+    // Client order ids count up from 1
+    sender.send_cancel(0, 1);
+    sender.send_new_order(0, OrderSide::BUY, OrderType::LIMIT, 99.5, 1);
+    acks = wait_acks(sender, 2);
+    ASSERT_EQ(acks.size(), 2u);
+    EXPECT_EQ(acks[0].payload.status, static_cast<uint8_t>(OrderStatus::CANCELLED));
+    EXPECT_EQ(acks[1].payload.status, static_cast<uint8_t>(OrderStatus::NEW));
+}
+
+// Test: Orders filled passively are dropped from a full session's open
+// orders, so they do not count against the cap
+TEST_F(OrderGatewayTest, PassiveFillsLeaveTheSession) {
+    start_simulator(true);
+    OrderSender maker;
+    OrderSender taker;
+    ASSERT_TRUE(maker.connect("127.0.0.1", ORDER_PORT));
+    ASSERT_TRUE(taker.connect("127.0.0.1", ORDER_PORT));
+
+    // Symbol 1 is seeded with asks from 101.01, so these rest ahead of them
+    ASSERT_EQ(fill_open_orders(maker, 1, OrderSide::SELL, 101.00, OrderGateway::MAX_OPEN_ORDERS),
+              OrderGateway::MAX_OPEN_ORDERS);
+
+    taker.send_new_order(1, OrderSide::BUY, OrderType::LIMIT, 101.00, OrderGateway::MAX_OPEN_ORDERS);
+    auto acks = wait_acks(taker, 1);
+    ASSERT_EQ(acks.size(), 1u);
+    EXPECT_EQ(acks[0].payload.status, static_cast<uint8_t>(OrderStatus::FILLED));
+
+    maker.send_new_order(1, OrderSide::SELL, OrderType::LIMIT, 101.00, 1);
+    acks = wait_acks(maker, 1);
+    ASSERT_EQ(acks.size(), 1u);
+    EXPECT_EQ(acks[0].payload.status, static_cast<uint8_t>(OrderStatus::NEW));
+}
+
+// Test: Invalid orders are rejected with a reason and nothing rests
+TEST_F(OrderGatewayTest, RejectsInvalidOrders) {
+    start_simulator(true);
+    OrderSender sender;
+    ASSERT_TRUE(sender.connect("127.0.0.1", ORDER_PORT));
+
+    sender.send_new_order(NUM_SYMBOLS + 5, OrderSide::BUY, OrderType::LIMIT, 100.0, 100);
+    sender.send_new_order(0, OrderSide::BUY, OrderType::LIMIT, 100.0, 0);
+    sender.send_new_order(0, OrderSide::BUY, OrderType::LIMIT, -1.0, 100);
+    sender.send_new_order(0, OrderSide::BUY, OrderType::LIMIT, 100.0 * 1000, 100);  // Outside the band
+    auto acks = wait_acks(sender, 4);
+    ASSERT_EQ(acks.size(), 4u);
+
+    RejectReason expected[] = {RejectReason::UNKNOWN_SYMBOL, RejectReason::INVALID_QUANTITY,
+                               RejectReason::INVALID_PRICE, RejectReason::INVALID_PRICE};
+    for (size_t i = 0; i < 4; ++i) {
+        EXPECT_EQ(acks[i].payload.status, static_cast<uint8_t>(OrderStatus::REJECTED)) << i;
+        EXPECT_EQ(acks[i].payload.reject_reason, static_cast<uint8_t>(expected[i])) << i;
+        EXPECT_EQ(acks[i].payload.exchange_order_id, 0u);
+    }
+    EXPECT_EQ(sim_->get_order_gateway_stats().rejects, 4u);
+}
+
+// Test: In matching mode an order trades against the book, the ack reports
+// the fill, and the trades and new top of book go out on the feed
+TEST_F(OrderGatewayTest, MatchingModeFillsAndPublishes) {
+    start_simulator(true);
+    FeedHandler handler("127.0.0.1", FEED_PORT, NUM_SYMBOLS);
+    std::mutex trades_mutex;
+    std::vector<TradeMessage> trades;
+    handler.set_trade_callback([&](const TradeMessage& trade) {
+        std::scoped_lock lock(trades_mutex);
+        trades.push_back(trade);
+    });
+    ASSERT_TRUE(handler.start());
+    ASSERT_TRUE(handler.subscribe({0, 1, 2, 3}));
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+
+    OrderSender sender;
+    ASSERT_TRUE(sender.connect("127.0.0.1", ORDER_PORT));
+
+    // Symbol 1 is seeded with 1000 per level at 101.01, 101.02, ...
+    sender.send_new_order(1, OrderSide::BUY, OrderType::MARKET, 0.0, 1500);
+    auto acks = wait_acks(sender, 1);
+    ASSERT_EQ(acks.size(), 1u);
+    EXPECT_EQ(acks[0].payload.status, static_cast<uint8_t>(OrderStatus::FILLED));
+    EXPECT_EQ(acks[0].payload.filled_quantity, 1500u);
+    EXPECT_NEAR(acks[0].payload.average_price, (101.01 * 1000 + 101.02 * 500) / 1500, 1e-9);
+
+    // A passive buy rests and can be cancelled
+    uint64_t id = sender.send_new_order(1, OrderSide::BUY, OrderType::LIMIT, 100.50, 300);
+    acks = wait_acks(sender, 1);
+    ASSERT_EQ(acks.size(), 1u);
+    EXPECT_EQ(acks[0].payload.status, static_cast<uint8_t>(OrderStatus::NEW));
+    EXPECT_EQ(sim_->get_order_book(1)->quantity_at(10050), 300u);
+    sender.send_cancel(1, id);
+    acks = wait_acks(sender, 1);
+    ASSERT_EQ(acks.size(), 1u);
+    EXPECT_EQ(acks[0].payload.status, static_cast<uint8_t>(OrderStatus::CANCELLED));
+    EXPECT_EQ(sim_->get_order_book(1)->quantity_at(10050), 0u);
+
+    // The fills reached the feed as trades at the makers' prices
+    for (int i = 0; i < 100; ++i) {
+        std::scoped_lock lock(trades_mutex);
+        if (trades.size() >= 2) break;
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    {
+        std::scoped_lock lock(trades_mutex);
+        ASSERT_EQ(trades.size(), 2u);
+        EXPECT_DOUBLE_EQ(trades[0].payload.price, 101.01);
+        EXPECT_EQ(trades[0].payload.quantity, 1000u);
+        EXPECT_DOUBLE_EQ(trades[1].payload.price, 101.02);
+        EXPECT_EQ(trades[1].payload.quantity, 500u);
+    }
+    MarketSnapshot snap = handler.get_cache().get_snapshot(1);
+    EXPECT_DOUBLE_EQ(snap.best_ask, 101.02);
+    EXPECT_EQ(snap.ask_quantity, 500u);
+
+    handler.stop();
+}
+
+// Test: Messages split across reads are reassembled; duplicate open ids
+// and corrupted messages are refused; an unknown type closes the session
+TEST_F(OrderGatewayTest, SessionFraming) {
+    start_simulator(true);
+    int fd = connect_raw();
+    ASSERT_GE(fd, 0);
+
+    NewOrderMessage order = make_order(7, 0, 100.0, 100);
+    const uint8_t* bytes = reinterpret_cast<const uint8_t*>(&order);
+    ASSERT_EQ(send(fd, bytes, 9, 0), 9);
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    ASSERT_EQ(send(fd, bytes + 9, sizeof(order) - 9, 0), static_cast<ssize_t>(sizeof(order) - 9));
+    OrderAckMessage ack;
+    ASSERT_TRUE(read_ack(fd, ack));
+    EXPECT_EQ(ack.payload.client_order_id, 7u);
+    EXPECT_EQ(ack.payload.status, static_cast<uint8_t>(OrderStatus::NEW));
+
+    // Corrupted copy is dropped; duplicate of the open id is rejected
+    NewOrderMessage corrupt = order;
+    corrupt.payload.quantity = 200;
+    NewOrderMessage bad_side = make_order(8, 7, 100.0, 100);
+    uint8_t batch[3 * sizeof(NewOrderMessage)];
+    std::memcpy(batch, &corrupt, sizeof(order));
+    std::memcpy(batch + sizeof(order), &order, sizeof(order));
+    std::memcpy(batch + 2 * sizeof(order), &bad_side, sizeof(order));
+    ASSERT_EQ(send(fd, batch, sizeof(batch), 0), static_cast<ssize_t>(sizeof(batch)));
+    ASSERT_TRUE(read_ack(fd, ack));
+    EXPECT_EQ(ack.payload.reject_reason, static_cast<uint8_t>(RejectReason::DUPLICATE_ORDER_ID));
+    ASSERT_TRUE(read_ack(fd, ack));
+    EXPECT_EQ(ack.payload.reject_reason, static_cast<uint8_t>(RejectReason::INVALID_FIELD));
+
+    auto stats = sim_->get_order_gateway_stats();
+    EXPECT_EQ(stats.checksum_errors, 1u);
+    EXPECT_EQ(stats.orders_received, 3u);
+
+    uint8_t garbage[16] = {0x77, 0x00};
+    ASSERT_EQ(send(fd, garbage, sizeof(garbage), 0), static_cast<ssize_t>(sizeof(garbage)));
+    uint8_t byte;
+    EXPECT_EQ(recv(fd, &byte, 1, 0), 0);  // Closed by the gateway
+    EXPECT_EQ(sim_->get_order_gateway_stats().protocol_errors, 1u);
+    close(fd);
+}
+
+// Test: Orders sent from the feed handler's quote callback carry the tick's
+// exchange timestamp, which the ack echoes back (tick-to-trade loop)
+TEST_F(OrderGatewayTest, TickToTradeThroughFeedCallback) {
+    start_simulator(false);
+    OrderSender sender;
+    ASSERT_TRUE(sender.connect("127.0.0.1", ORDER_PORT));
+
+    FeedHandler handler("127.0.0.1", FEED_PORT, NUM_SYMBOLS);
+    std::vector<uint64_t> quote_timestamps;
+    handler.set_quote_callback([&](const QuoteMessage& quote) {
+        quote_timestamps.push_back(quote.header.timestamp);
+        sender.send_new_order(quote.header.symbol_id, OrderSide::BUY, OrderType::LIMIT,
+                              quote.payload.bid_price, 100, quote.header.timestamp);
+    });
+    ASSERT_TRUE(handler.start());
+    ASSERT_TRUE(handler.subscribe({0, 1, 2, 3}));
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+
+    for (int i = 0; i < 200; ++i) {
+        sim_->generate_tick(static_cast<uint16_t>(i % NUM_SYMBOLS));
+    }
+    for (int i = 0; i < 300 && handler.get_messages_received() < 200; ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    ASSERT_EQ(handler.get_messages_received(), 200u);
+
+    size_t orders = sender.get_orders_sent();
+    ASSERT_GT(orders, 0u);
+    auto acks = wait_acks(sender, orders);
+    handler.stop();
+    ASSERT_EQ(acks.size(), orders);
+    ASSERT_EQ(quote_timestamps.size(), orders);
+
+    for (size_t i = 0; i < acks.size(); ++i) {
+        EXPECT_EQ(acks[i].payload.trigger_timestamp, quote_timestamps[i]);
+        // Sent after the tick was stamped, processed after it was sent
+        EXPECT_GE(acks[i].payload.order_timestamp, quote_timestamps[i]);
+        EXPECT_GE(acks[i].header.timestamp, acks[i].payload.order_timestamp);
+    }
+}
+
+} // namespace mdfh
+
+int main(int argc, char** argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
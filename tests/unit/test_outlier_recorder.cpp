@@ -0,0 +1,169 @@
+#include <gtest/gtest.h>
+#include "common/outlier_recorder.h"
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+#include <unistd.h>
+
+using namespace mdfh;
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
+
+class OutlierRecorderTest : public ::testing::Test {
+protected:
+    static OutlierRecord make_record(uint16_t symbol_id, uint32_t seq_num) {
+        OutlierRecord record{};
+        record.symbol_id = symbol_id;
+        record.seq_num = seq_num;
+        record.end_to_end_ns = 5000000;
+        record.stage_ns[static_cast<size_t>(LatencyStage::QUEUE)] = 250000;
+        record.batch_bytes = 4096;
+        record.batch_index = 12;
+        record.parser_buffer_fill = 320;
+        record.cpu = 3;
+        return record;
+    }
+};
+
+// Test: Record layout
+TEST_F(OutlierRecorderTest, RecordIsOneCacheLine) {
+    EXPECT_EQ(sizeof(OutlierRecord), 64);
+}
+
+// Test: Capacity rounds up to a power of 2
+TEST_F(OutlierRecorderTest, CapacityRoundsUp) {
+    OutlierRecorder recorder(1000);
+    EXPECT_EQ(recorder.capacity(), 1024);
+}
+
+// Test: Threshold checks
+TEST_F(OutlierRecorderTest, ThresholdChecks) {
+    OutlierRecorder recorder(16, 1000000, 100000);
+    
+    EXPECT_FALSE(recorder.is_outlier(500000, 50000));
+    EXPECT_TRUE(recorder.is_outlier(1500000, 50000));   // End-to-end
+    EXPECT_TRUE(recorder.is_outlier(500000, 150000));   // Stage
+    
+    // Zero disables a check
+    recorder.set_thresholds(0, 100000);
+    EXPECT_FALSE(recorder.is_outlier(UINT64_MAX, 50000));
+    EXPECT_TRUE(recorder.is_outlier(0, 150000));
+    
+    recorder.set_thresholds(0, 0);
+    EXPECT_FALSE(recorder.is_outlier(UINT64_MAX, UINT64_MAX));
+}
+
+// Test: Empty recorder
+TEST_F(OutlierRecorderTest, EmptySnapshot) {
+    OutlierRecorder recorder(16);
+    EXPECT_EQ(recorder.get_outlier_count(), 0);
+    EXPECT_TRUE(recorder.snapshot().empty());
+}
+
+// Test: Captured context is preserved
+TEST_F(OutlierRecorderTest, CaptureAndSnapshot) {
+    OutlierRecorder recorder(16);
+    recorder.capture(make_record(42, 1001));
+    recorder.capture(make_record(7, 1002));
+    
+    auto records = recorder.snapshot();
+    ASSERT_EQ(records.size(), 2);
+    EXPECT_EQ(records[0].symbol_id, 42);
+    EXPECT_EQ(records[0].seq_num, 1001);
+    EXPECT_EQ(records[0].batch_bytes, 4096);
+    EXPECT_EQ(records[0].batch_index, 12);
+    EXPECT_EQ(records[0].parser_buffer_fill, 320);
+    EXPECT_EQ(records[0].cpu, 3);
+    EXPECT_EQ(records[0].stage_ns[static_cast<size_t>(LatencyStage::QUEUE)], 250000);
+    EXPECT_EQ(records[1].symbol_id, 7);
+    EXPECT_EQ(records[1].seq_num, 1002);
+}
+
+// Test: Oldest records are overwritten when full
+TEST_F(OutlierRecorderTest, RingOverwritesOldest) {
+    OutlierRecorder recorder(8);
+    for (uint32_t seq = 1; seq <= 20; ++seq) {
+        recorder.capture(make_record(1, seq));
+    }
+    
+    EXPECT_EQ(recorder.get_outlier_count(), 20);
+    auto records = recorder.snapshot();
+    ASSERT_EQ(records.size(), 8);
+    EXPECT_EQ(records.front().seq_num, 13);
+    EXPECT_EQ(records.back().seq_num, 20);
+}
+
+// Test: Reset discards records
+TEST_F(OutlierRecorderTest, Reset) {
+    OutlierRecorder recorder(8);
+    recorder.capture(make_record(1, 1));
+    recorder.reset();
+    
+    EXPECT_EQ(recorder.get_outlier_count(), 0);
+    EXPECT_TRUE(recorder.snapshot().empty());
+}
+
+// Test: Concurrent writers and a concurrent reader
+TEST_F(OutlierRecorderTest, ConcurrentCapture) {
+    constexpr int NUM_THREADS = 4;
+    constexpr uint32_t PER_THREAD = 10000;
+    OutlierRecorder recorder(1024);
+    std::atomic<bool> done(false);
+    
+    // Every snapshot must contain only fully written records
+    std::thread reader([&]() {
+        while (!done.load()) {
+            for (const auto& r : recorder.snapshot()) {
+                ASSERT_EQ(r.seq_num % 1000, r.batch_index);
+            }
+        }
+    });
+    
+    std::vector<std::thread> writers;
+    for (int t = 0; t < NUM_THREADS; ++t) {
+        writers.emplace_back([&recorder, t]() {
+            for (uint32_t i = 0; i < PER_THREAD; ++i) {
+                OutlierRecord record = make_record(static_cast<uint16_t>(t), i);
+                record.batch_index = i % 1000;
+                recorder.capture(record);
+            }
+        });
+    }
+    for (auto& w : writers) {
+        w.join();
+    }
+    done = true;
+    reader.join();
+    
+    EXPECT_EQ(recorder.get_outlier_count(), NUM_THREADS * PER_THREAD);
+    EXPECT_EQ(recorder.snapshot().size(), 1024);
+}
+
+// Test: CSV export
+TEST_F(OutlierRecorderTest, ExportToCsv) {
+    OutlierRecorder recorder(16);
+    recorder.capture(make_record(42, 1001));
+    recorder.capture(make_record(43, 1002));
+    
+    std::string filename = "/tmp/mdfh_outliers_test_" + std::to_string(::getpid()) + ".csv";
+    ASSERT_TRUE(recorder.export_to_csv(filename));
+    
+    std::ifstream in(filename);
+    std::vector<std::string> lines;
+    std::string line;
+    while (std::getline(in, line)) {
+        lines.push_back(line);
+    }
+    std::remove(filename.c_str());
+    
+    ASSERT_EQ(lines.size(), 3);
+    EXPECT_NE(lines[0].find("symbol_id,seq_num"), std::string::npos);
+    EXPECT_NE(lines[0].find("queue_ns"), std::string::npos);
+    EXPECT_NE(lines[1].find(",42,1001,"), std::string::npos);
+    EXPECT_NE(lines[2].find(",43,1002,"), std::string::npos);
+}
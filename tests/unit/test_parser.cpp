@@ -1,6 +1,7 @@
 #include <gtest/gtest.h>
 #include "client/parser.h"
 #include "common/protocol.h"
+#include <chrono>
 #include <cstring>
 #include <vector>
 
@@ -175,6 +176,26 @@ TEST_F(ParserTest, DetectSequenceGap) {
     EXPECT_GT(parser->get_sequence_gaps(), 0);
 }
 
+TEST_F(ParserTest, SequenceTrackedPerSymbol) {
+    std::vector<uint8_t> buffer;
+    parser->set_generic_handler([](const auto&) {});
+    
+    // Interleaved symbols, each with its own contiguous sequence
+    for (uint32_t seq = 1; seq <= 3; ++seq) {
+        for (uint16_t symbol_id : {0, 7, 300}) {
+            create_trade_message(buffer, seq, symbol_id, 1500.50, 100);
+            parser->parse(buffer.data(), buffer.size());
+        }
+    }
+    EXPECT_EQ(parser->get_sequence_gaps(), 0);
+    
+    create_trade_message(buffer, 6, 7, 1500.50, 100);  // Gap on symbol 7 only: 3 -> 6
+    parser->parse(buffer.data(), buffer.size());
+    create_trade_message(buffer, 4, 0, 1500.50, 100);
+    parser->parse(buffer.data(), buffer.size());
+    EXPECT_EQ(parser->get_sequence_gaps(), 1);
+}
+
 TEST_F(ParserTest, ValidateChecksum) {
     std::vector<uint8_t> buffer;
     create_trade_message(buffer, 1, 10, 1500.50, 100);
@@ -271,6 +292,60 @@ TEST_F(ParserTest, GenericHandlerForAllMessages) {
     EXPECT_DOUBLE_EQ(received_quote.payload.bid_price, 2450.25);
 }
 
+TEST_F(ParserTest, HeartbeatsDoNotAffectSequenceTracking) {
+    int heartbeat_count = 0;
+    parser->set_generic_handler([&](const auto& msg) {
+        if constexpr (std::is_same_v<std::decay_t<decltype(msg)>, HeartbeatMessage>) {
+            heartbeat_count++;
+        }
+    });
+    
+    // Heartbeats use symbol_id 0 and their own per-connection counter
+    HeartbeatMessage heartbeat{};
+    heartbeat.header.msg_type = static_cast<uint16_t>(MessageType::HEARTBEAT);
+    heartbeat.header.symbol_id = 0;
+    
+    std::vector<uint8_t> buffer;
+    for (uint32_t seq = 1; seq <= 3; ++seq) {
+        create_trade_message(buffer, seq, 0, 100.0, 1);
+        parser->parse(buffer.data(), buffer.size());
+        
+        heartbeat.header.seq_num = 100 + seq;
+        heartbeat.checksum = calculate_checksum(&heartbeat, sizeof(heartbeat) - sizeof(uint32_t));
+        parser->parse(&heartbeat, sizeof(heartbeat));
+    }
+    
+    EXPECT_EQ(heartbeat_count, 3);
+    EXPECT_EQ(parser->get_messages_parsed(), 6u);
+    EXPECT_EQ(parser->get_sequence_gaps(), 0u);
+}
+
+TEST_F(ParserTest, ResetBufferDropsPartialMessageKeepsSequences) {
+    int trade_count = 0;
+    parser->set_generic_handler([&trade_count](const auto&) {
+        trade_count++;
+    });
+    
+    std::vector<uint8_t> buffer;
+    create_trade_message(buffer, 7, 3, 100.0, 1);
+    parser->parse(buffer.data(), buffer.size());
+    EXPECT_EQ(parser->get_last_sequence(3), 7u);
+    EXPECT_EQ(parser->get_last_sequence(4), 0u);
+    
+    // Connection drops mid-message
+    create_trade_message(buffer, 8, 3, 100.0, 1);
+    parser->parse(buffer.data(), 10);
+    parser->reset_buffer();
+    EXPECT_EQ(parser->get_buffer_fill(), 0u);
+    
+    // The new connection resumes cleanly after the last processed sequence
+    parser->parse(buffer.data(), buffer.size());
+    EXPECT_EQ(trade_count, 2);
+    EXPECT_EQ(parser->get_last_sequence(3), 8u);
+    EXPECT_EQ(parser->get_sequence_gaps(), 0u);
+    EXPECT_EQ(parser->get_checksum_errors(), 0u);
+}
+
 TEST_F(ParserTest, GenericHandlerPerformance) {
     std::vector<uint8_t> buffer;
     create_trade_message(buffer, 1, 10, 1500.50, 100);
@@ -0,0 +1,121 @@
+#include <gtest/gtest.h>
+#include "common/philox.h"
+#include <cmath>
+#include <set>
+#include <vector>
+
+namespace mdfh {
+
+// Test: Known-answer vectors of the Random123 reference implementation
+TEST(PhiloxTest, KnownAnswers) {
+    auto zero = Philox4x32::block({0, 0, 0, 0}, 0);
+    EXPECT_EQ(zero, (Philox4x32::Block{0x6627e8d5, 0xe169c58d, 0xbc57ac4c, 0x9b00dbd8}));
+
+    auto ones = Philox4x32::block({0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff}, 0xffffffffffffffffULL);
+    EXPECT_EQ(ones, (Philox4x32::Block{0x408f276d, 0x41c83b0e, 0xa20bc7c6, 0x6d5451fd}));
+
+    auto pi = Philox4x32::block({0x243f6a88, 0x85a308d3, 0x13198a2e, 0x03707344},
+                                0x299f31d0ULL << 32 | 0xa4093822);
+    EXPECT_EQ(pi, (Philox4x32::Block{0xd16cfe09, 0x94fdcceb, 0x5001e420, 0x24126ea1}));
+}
+
+// Test: The generator walks the stream's blocks in counter order
+TEST(PhiloxTest, WordsFollowCounter) {
+    const uint64_t seed = 12345;
+    Philox4x32 rng(seed, RngStream::TICKS, 7);
+    for (uint32_t b = 0; b < 3; ++b) {
+        auto expected = Philox4x32::block({b, 0, 7, static_cast<uint32_t>(RngStream::TICKS)}, seed);
+        for (int w = 0; w < 4; ++w) {
+            EXPECT_EQ(rng(), expected[w]);
+        }
+    }
+    EXPECT_EQ(rng.get_block_index(), 3u);
+}
+
+// Test: Bulk fills produce exactly what the same number of scalar calls
+// would, whatever the alignment to the block and batch boundaries
+TEST(PhiloxTest, BulkMatchesScalar) {
+    for (size_t skip : {0u, 1u, 3u}) {
+        for (size_t count : {1u, 7u, 32u, 33u, 100u, 1001u}) {
+            Philox4x32 scalar(99, RngStream::FAULTS, 3);
+            Philox4x32 bulk(99, RngStream::FAULTS, 3);
+            for (size_t i = 0; i < skip; ++i) {
+                scalar.uniform();
+                bulk.uniform();
+            }
+            std::vector<double> out(count);
+            bulk.fill_uniform(out.data(), count);
+            for (size_t i = 0; i < count; ++i) {
+                ASSERT_EQ(out[i], scalar.uniform()) << "skip " << skip << " count " << count << " at " << i;
+            }
+            // Continues in step afterwards
+            EXPECT_EQ(bulk.uniform(), scalar.uniform());
+
+            bulk.fill_normal(out.data(), count);
+            for (size_t i = 0; i < count; ++i) {
+                ASSERT_EQ(out[i], scalar.normal()) << "normals, count " << count << " at " << i;
+            }
+            EXPECT_EQ(bulk.normal(), scalar.normal());
+        }
+    }
+}
+
+// Test: seek() jumps straight to a block
+TEST(PhiloxTest, Seek) {
+    Philox4x32 a(5, RngStream::ORDER_FLOW, 1);
+    for (int i = 0; i < 4 * 1000; ++i) a();
+    Philox4x32 b(5, RngStream::ORDER_FLOW, 1);
+    b.seek(1000);
+    for (int i = 0; i < 16; ++i) {
+        EXPECT_EQ(a(), b());
+    }
+}
+
+// Test: Different seeds, ids and purposes give unrelated streams
+TEST(PhiloxTest, StreamsAreDistinct) {
+    std::set<uint32_t> first_words;
+    for (uint64_t seed : {1ULL, 2ULL}) {
+        for (uint32_t id : {0u, 1u, 65535u}) {
+            for (RngStream purpose : {RngStream::TICKS, RngStream::FAULTS, RngStream::CORRELATION}) {
+                Philox4x32 rng(seed, purpose, id);
+                first_words.insert(rng());
+            }
+        }
+    }
+    EXPECT_EQ(first_words.size(), 18u);
+}
+
+// Test: Uniforms lie in (0, 1) with the right mean and variance; normals
+// have mean 0 and variance 1
+TEST(PhiloxTest, Moments) {
+    const size_t n = 1 << 20;
+    std::vector<double> u(n);
+    Philox4x32 rng(2024, RngStream::TICKS, 0);
+    rng.fill_uniform(u.data(), n);
+    double sum = 0.0, sq = 0.0;
+    for (double x : u) {
+        ASSERT_GT(x, 0.0);
+        ASSERT_LT(x, 1.0);
+        sum += x;
+        sq += x * x;
+    }
+    EXPECT_NEAR(sum / n, 0.5, 0.002);
+    EXPECT_NEAR(sq / n - 0.25, 1.0 / 12.0, 0.002);
+
+    rng.fill_normal(u.data(), n);
+    sum = sq = 0.0;
+    for (double z : u) {
+        ASSERT_TRUE(std::isfinite(z));
+        sum += z;
+        sq += z * z;
+    }
+    EXPECT_NEAR(sum / n, 0.0, 0.005);
+    EXPECT_NEAR(sq / n, 1.0, 0.005);
+}
+
+} // namespace mdfh
+
+int main(int argc, char** argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
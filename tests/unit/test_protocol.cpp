@@ -1,5 +1,6 @@
 #include <gtest/gtest.h>
 #include "common/protocol.h"
+#include <cstddef>
 #include <cstring>
 
 using namespace mdfh;
@@ -11,15 +12,33 @@ protected:
 };
 
 TEST_F(ProtocolTest, MessageHeaderSize) {
-    EXPECT_EQ(sizeof(MessageHeader), 16);
+    EXPECT_EQ(sizeof(MessageHeader), 20);
+}
+
+TEST_F(ProtocolTest, HeaderCarriesVersionAndWideSymbolId) {
+    MessageHeader header{};
+    EXPECT_EQ(header.version, PROTOCOL_VERSION);
+    header.symbol_id = 1000000;  // Past the v1 16-bit range
+    EXPECT_EQ(header.symbol_id, 1000000u);
+    EXPECT_EQ(offsetof(MessageHeader, symbol_id), 16u);
+    EXPECT_EQ(sizeof(ResumeEntry), 8u);
 }
 
 TEST_F(ProtocolTest, TradeMessageSize) {
-    EXPECT_EQ(sizeof(TradeMessage), 32);  // 16 header + 12 payload + 4 checksum
+    EXPECT_EQ(sizeof(TradeMessage), 36);  // 20 header + 12 payload + 4 checksum
 }
 
 TEST_F(ProtocolTest, QuoteMessageSize) {
-    EXPECT_EQ(sizeof(QuoteMessage), 44);  // 16 header + 24 payload + 4 checksum
+    EXPECT_EQ(sizeof(QuoteMessage), 48);  // 20 header + 24 payload + 4 checksum
+}
+
+TEST_F(ProtocolTest, OrderEntryMessageSizes) {
+    EXPECT_EQ(sizeof(NewOrderMessage), 54);     // 20 header + 30 payload + 4 checksum
+    EXPECT_EQ(sizeof(CancelOrderMessage), 32);  // 20 header + 8 payload + 4 checksum
+    EXPECT_EQ(sizeof(OrderAckMessage), 74);     // 20 header + 50 payload + 4 checksum
+    EXPECT_EQ(get_order_message_size(MessageType::NEW_ORDER), sizeof(NewOrderMessage));
+    EXPECT_EQ(get_order_message_size(MessageType::TRADE), 0u);
+    EXPECT_EQ(get_message_size(MessageType::ORDER_ACK), 0u);  // Not on the market data stream
 }
 
 TEST_F(ProtocolTest, MessageTypeValues) {
@@ -33,20 +52,21 @@ TEST_F(ProtocolTest, SubscriptionMessageFormat) {
     uint8_t buffer[256];
     buffer[0] = 0xFF; // Subscribe command
     
-    uint16_t count = 5;
-    std::memcpy(&buffer[1], &count, sizeof(uint16_t));
+    uint32_t count = 5;
+    std::memcpy(&buffer[1], &count, sizeof(uint32_t));
     
     // Add symbol IDs
-    for (uint16_t i = 0; i < count; i++) {
-        uint16_t symbol_id = i * 10;
-        std::memcpy(&buffer[3 + i * sizeof(uint16_t)], &symbol_id, sizeof(uint16_t));
+    for (uint32_t i = 0; i < count; i++) {
+        SymbolId symbol_id = i * 10;
+        std::memcpy(&buffer[sizeof(SubscriptionHeader) + i * sizeof(SymbolId)], &symbol_id, sizeof(SymbolId));
     }
     
     EXPECT_EQ(buffer[0], 0xFF);
+    EXPECT_EQ(sizeof(SubscriptionHeader), 5u);
     
-    uint16_t read_count;
-    std::memcpy(&read_count, &buffer[1], sizeof(uint16_t));
-    EXPECT_EQ(read_count, 5);
+    uint32_t read_count;
+    std::memcpy(&read_count, &buffer[1], sizeof(uint32_t));
+    EXPECT_EQ(read_count, 5u);
 }
 
 TEST_F(ProtocolTest, MessageHeaderConstruction) {
@@ -94,8 +114,10 @@ TEST_F(ProtocolTest, MessageAlignment) {
 TEST_F(ProtocolTest, MessagePacking) {
     // Ensure structures are packed (no padding)
     MessageHeader header;
-    EXPECT_EQ(reinterpret_cast<uintptr_t>(&header.seq_num) -
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(&header.version) -
               reinterpret_cast<uintptr_t>(&header.msg_type), 2);
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(&header.seq_num) -
+              reinterpret_cast<uintptr_t>(&header.version), 2);
     EXPECT_EQ(reinterpret_cast<uintptr_t>(&header.timestamp) - 
               reinterpret_cast<uintptr_t>(&header.seq_num), 4);
     EXPECT_EQ(reinterpret_cast<uintptr_t>(&header.symbol_id) - 
@@ -0,0 +1,112 @@
+#include <gtest/gtest.h>
+#include "server/scenario.h"
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+
+namespace fs = std::filesystem;
+
+namespace mdfh {
+
+class ScenarioTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        dir_ = fs::temp_directory_path() / "mdfh_scenario_test";
+        fs::create_directories(dir_);
+    }
+
+    void TearDown() override {
+        fs::remove_all(dir_);
+    }
+
+    std::string write(const std::string& contents) {
+        std::string file = (dir_ / "scenario.csv").string();
+        std::ofstream out(file);
+        out << contents;
+        return file;
+    }
+
+    fs::path dir_;
+};
+
+// Test: Events parse with comments, blank lines and CRLF endings, and are
+// ordered by time with ties kept in file order
+TEST_F(ScenarioTest, LoadsTimelineInTimeOrder) {
+    std::string file = write(
+        "# Opening burst then a storm on one symbol\n"
+        "time_ms,event,symbol,value\n"
+        "\n"
+        "2000,rate,*,1\r\n"
+        "0,rate,*,30      # the open\n"
+        "1500.5,volatility,7,10\n"
+        "1500.5,halt,7,\n"
+        "3000,resume,7\n");
+    Scenario scenario = Scenario::load(file, 10);
+
+    const auto& events = scenario.get_events();
+    ASSERT_EQ(events.size(), 5u);
+    EXPECT_EQ(events[0].time_us, 0u);
+    EXPECT_EQ(events[0].action, ScenarioAction::RATE);
+    EXPECT_EQ(events[0].symbol_id, Scenario::ALL_SYMBOLS);
+    EXPECT_DOUBLE_EQ(events[0].value, 30.0);
+    EXPECT_EQ(events[1].time_us, 1500500u);
+    EXPECT_EQ(events[1].action, ScenarioAction::VOLATILITY);
+    EXPECT_EQ(events[1].symbol_id, 7);
+    EXPECT_EQ(events[2].action, ScenarioAction::HALT);
+    EXPECT_EQ(events[3].time_us, 2000000u);
+    EXPECT_EQ(events[4].action, ScenarioAction::RESUME);
+    EXPECT_EQ(scenario.get_duration_us(), 3000000u);
+}
+
+// Test: pop_due hands out each event once, when its time has come
+TEST_F(ScenarioTest, PopDueFollowsClock) {
+    Scenario scenario({{1000, ScenarioAction::RATE, Scenario::ALL_SYMBOLS, 5.0},
+                       {0, ScenarioAction::HALT, 3, 0.0},
+                       {1000, ScenarioAction::RESUME, 3, 0.0}});
+    EXPECT_EQ(scenario.next_time_us(), 0u);
+    const ScenarioEvent* e = scenario.pop_due(999);
+    ASSERT_NE(e, nullptr);
+    EXPECT_EQ(e->action, ScenarioAction::HALT);
+    EXPECT_EQ(scenario.pop_due(999), nullptr);
+    EXPECT_EQ(scenario.next_time_us(), 1000u);
+
+    ASSERT_NE(scenario.pop_due(5000), nullptr);
+    ASSERT_NE(scenario.pop_due(5000), nullptr);
+    EXPECT_EQ(scenario.pop_due(5000), nullptr);
+    EXPECT_EQ(scenario.next_time_us(), UINT64_MAX);
+
+    scenario.rewind();
+    EXPECT_EQ(scenario.next_time_us(), 0u);
+}
+
+// Test: Bad lines are rejected with the line number
+TEST_F(ScenarioTest, RejectsBadLines) {
+    const char* bad[] = {
+        "x,rate,*,2\n",             // Time
+        "-5,rate,*,2\n",            // Negative time
+        "0,surge,*,2\n",            // Unknown event
+        "0,rate,10,2\n",            // Symbol outside the universe
+        "0,rate,abc,2\n",           // Symbol
+        "0,rate,*\n",               // Missing multiplier
+        "0,volatility,1,-1\n",      // Negative multiplier
+        "0,halt\n",                 // Too few fields
+    };
+    for (const char* line : bad) {
+        std::string file = write(std::string("time_ms,event,symbol,value\n0,rate,*,1\n") + line);
+        try {
+            Scenario::load(file, 10);
+            ADD_FAILURE() << "accepted: " << line;
+        } catch (const std::runtime_error& e) {
+            EXPECT_NE(std::string(e.what()).find("line 3"), std::string::npos) << e.what();
+        }
+    }
+    EXPECT_THROW(Scenario::load((dir_ / "missing.csv").string(), 10), std::runtime_error);
+}
+
+} // namespace mdfh
+
+int main(int argc, char** argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
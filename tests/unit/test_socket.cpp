@@ -2,6 +2,7 @@
 #include "client/socket.h"
 #include <thread>
 #include <chrono>
+#include <cstring>
 #include <sys/socket.h>
 #include <netinet/in.h>
 #include <arpa/inet.h>
@@ -189,7 +190,7 @@ TEST_F(SocketTest, SendSubscription) {
     });
     
     if (socket_->connect("127.0.0.1", test_port_, 2000)) {
-        std::vector<uint16_t> symbols = {0, 1, 2, 3, 4};
+        std::vector<SymbolId> symbols = {0, 1, 2, 3, 4};
         bool sent = socket_->send_subscription(symbols);
         
         std::this_thread::sleep_for(std::chrono::milliseconds(100));
@@ -307,6 +308,89 @@ TEST_F(SocketTest, ConnectionTimeout) {
     EXPECT_LT(duration, std::chrono::milliseconds(2000));
 }
 
+// Test: Non-blocking connect completes through poll_connect
+TEST_F(SocketTest, NonBlockingConnect) {
+    server_fd_ = create_test_server(test_port_);
+    ASSERT_GE(server_fd_, 0);
+    
+    auto status = socket_->start_connect("127.0.0.1", test_port_);
+    ASSERT_NE(status, MarketDataSocket::ConnectStatus::FAILED);
+    for (int i = 0; i < 100 && status == MarketDataSocket::ConnectStatus::IN_PROGRESS; ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        status = socket_->poll_connect();
+    }
+    EXPECT_EQ(status, MarketDataSocket::ConnectStatus::CONNECTED);
+    EXPECT_TRUE(socket_->is_connected());
+    EXPECT_FALSE(socket_->is_connecting());
+    
+    int client_fd = accept(server_fd_, nullptr, nullptr);
+    ASSERT_GE(client_fd, 0);
+    
+    // Resume request: header, then (symbol_id u32, last_seq u32) per symbol
+    ASSERT_TRUE(socket_->send_resume({3, 0x10009}, {42, 0}));
+    const uint8_t expected[] = {0xFE, 0x02, 0x00, 0x00, 0x00, 0x03, 0x00, 0x00, 0x00, 42, 0, 0, 0,
+                                0x09, 0x00, 0x01, 0x00, 0, 0, 0, 0};
+    uint8_t buffer[sizeof(expected)];
+    ssize_t n = recv(client_fd, buffer, sizeof(buffer), MSG_WAITALL);
+    ASSERT_EQ(n, static_cast<ssize_t>(sizeof(expected)));
+    EXPECT_EQ(std::memcmp(buffer, expected, sizeof(expected)), 0);
+    close(client_fd);
+}
+
+// Test: Requests past 64KB carry their full 32-bit count; over-long lists
+// are refused rather than truncated
+TEST_F(SocketTest, SendLargeResume) {
+    server_fd_ = create_test_server(test_port_);
+    ASSERT_GE(server_fd_, 0);
+    ASSERT_TRUE(socket_->connect("127.0.0.1", test_port_, 2000));
+    int client_fd = accept(server_fd_, nullptr, nullptr);
+    ASSERT_GE(client_fd, 0);
+    
+    const size_t count = 40000;
+    std::vector<SymbolId> ids(count);
+    std::vector<uint32_t> seqs(count);
+    for (size_t i = 0; i < count; ++i) {
+        ids[i] = static_cast<SymbolId>(i * 3);
+        seqs[i] = static_cast<uint32_t>(i);
+    }
+    
+    // 320KB outgrows the send buffer, so read it while it is sent
+    std::vector<uint8_t> received(sizeof(SubscriptionHeader) + count * sizeof(ResumeEntry));
+    ssize_t n = 0;
+    std::thread reader([&]() {
+        n = recv(client_fd, received.data(), received.size(), MSG_WAITALL);
+    });
+    EXPECT_TRUE(socket_->send_resume(ids, seqs));
+    reader.join();
+    ASSERT_EQ(n, static_cast<ssize_t>(received.size()));
+    
+    EXPECT_EQ(received[0], 0xFE);
+    uint32_t wire_count;
+    std::memcpy(&wire_count, received.data() + 1, sizeof(wire_count));
+    EXPECT_EQ(wire_count, count);
+    ResumeEntry last;
+    std::memcpy(&last, received.data() + received.size() - sizeof(last), sizeof(last));
+    EXPECT_EQ(last.symbol_id, ids.back());
+    EXPECT_EQ(last.last_seq, seqs.back());
+    
+    std::vector<SymbolId> too_many(MAX_SUBSCRIPTION_COUNT + 1);
+    EXPECT_FALSE(socket_->send_subscription(too_many));
+    EXPECT_TRUE(socket_->is_connected());
+    close(client_fd);
+}
+
+// Test: Non-blocking connect to a closed port fails without blocking
+TEST_F(SocketTest, NonBlockingConnectRefused) {
+    auto status = socket_->start_connect("127.0.0.1", test_port_ + 100);
+    for (int i = 0; i < 100 && status == MarketDataSocket::ConnectStatus::IN_PROGRESS; ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        status = socket_->poll_connect();
+    }
+    EXPECT_EQ(status, MarketDataSocket::ConnectStatus::FAILED);
+    EXPECT_FALSE(socket_->is_connected());
+    EXPECT_FALSE(socket_->is_connecting());
+}
+
 int main(int argc, char **argv) {
     ::testing::InitGoogleTest(&argc, argv);
     return RUN_ALL_TESTS();
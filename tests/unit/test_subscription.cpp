@@ -70,23 +70,36 @@ protected:
         return sock;
     }
 
-    bool send_subscription(int sock, const std::vector<uint16_t>& symbol_ids) {
+    bool send_subscription(int sock, const std::vector<SymbolId>& symbol_ids) {
         std::vector<uint8_t> msg;
         msg.push_back(0xFF); // Subscribe command
         
-        uint16_t count = static_cast<uint16_t>(symbol_ids.size());
-        msg.push_back(count & 0xFF);
-        msg.push_back((count >> 8) & 0xFF);
+        uint32_t count = static_cast<uint32_t>(symbol_ids.size());
+        for (int shift = 0; shift < 32; shift += 8) {
+            msg.push_back((count >> shift) & 0xFF);
+        }
         
-        for (uint16_t id : symbol_ids) {
-            msg.push_back(id & 0xFF);
-            msg.push_back((id >> 8) & 0xFF);
+        for (SymbolId id : symbol_ids) {
+            for (int shift = 0; shift < 32; shift += 8) {
+                msg.push_back((id >> shift) & 0xFF);
+            }
         }
         
         ssize_t sent = send(sock, msg.data(), msg.size(), 0);
         return sent == static_cast<ssize_t>(msg.size());
     }
 
+    bool wait_for_subscription_count(ExchangeSimulator& sim, int fd, size_t expected) {
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+        while (sim.get_client_subscription_count(fd) != expected) {
+            if (std::chrono::steady_clock::now() > deadline) {
+                return false;
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+        return true;
+    }
+
     std::string test_dir_;
     std::string config_dir_;
 };
@@ -109,7 +122,7 @@ TEST_F(SubscriptionTest, ClientSubscribesToSymbols) {
     
     std::this_thread::sleep_for(std::chrono::milliseconds(50));
     
-    std::vector<uint16_t> symbols = {0, 2, 5};
+    std::vector<SymbolId> symbols = {0, 2, 5};
     ASSERT_TRUE(send_subscription(client, symbols));
     
     std::this_thread::sleep_for(std::chrono::milliseconds(100));
@@ -157,7 +170,7 @@ TEST_F(SubscriptionTest, ClientReceivesOnlySubscribedSymbols) {
     
     std::this_thread::sleep_for(std::chrono::milliseconds(50));
     
-    std::vector<uint16_t> symbols = {0};
+    std::vector<SymbolId> symbols = {0};
     ASSERT_TRUE(send_subscription(client, symbols));
     
     std::this_thread::sleep_for(std::chrono::milliseconds(50));
@@ -327,8 +340,8 @@ TEST_F(SubscriptionTest, InvalidSubscriptionMessage) {
     ASSERT_EQ(sim.get_num_connected_clients(), 1);
     int server_client_fd = sim.get_client_fds()[0];
     
-    // Send invalid message (wrong command)
-    uint8_t invalid_msg[] = {0xFE, 0x02, 0x00, 0x00, 0x00, 0x01, 0x00};
+    // Send invalid message (wrong command; 0xFF and 0xFE are requests)
+    uint8_t invalid_msg[] = {0xAB, 0x02, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00};
     send(client, invalid_msg, sizeof(invalid_msg), 0);
     std::this_thread::sleep_for(std::chrono::milliseconds(50));
     
@@ -432,6 +445,58 @@ TEST_F(SubscriptionTest, EmptySubscription) {
     }
 }
 
+// Test Case 8: Requests past 64KB (more than 16,384 symbols) are framed by
+// their 32-bit count and accepted whole
+TEST_F(SubscriptionTest, LargeSubscriptionAndResume) {
+    const size_t num_symbols = 20000;
+    std::string config = create_test_config(12407, num_symbols);
+    ExchangeSimulator sim(12407, num_symbols, config);
+    sim.start();
+    
+    std::thread event_thread([&sim]() {
+        sim.run();
+    });
+    
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    
+    int client = create_client_socket(12407);
+    ASSERT_GE(client, 0);
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    ASSERT_EQ(sim.get_num_connected_clients(), 1);
+    int server_client_fd = sim.get_client_fds()[0];
+    
+    // 80KB subscription to every symbol
+    std::vector<SymbolId> symbols(num_symbols);
+    for (size_t i = 0; i < num_symbols; ++i) {
+        symbols[i] = static_cast<SymbolId>(i);
+    }
+    ASSERT_TRUE(send_subscription(client, symbols));
+    EXPECT_TRUE(wait_for_subscription_count(sim, server_client_fd, num_symbols));
+    
+    // 160KB resume for the upper 18,000 symbols with no replay
+    const uint32_t count = 18000;
+    std::vector<uint8_t> resume(sizeof(SubscriptionHeader) + count * sizeof(ResumeEntry));
+    resume[0] = 0xFE;
+    std::memcpy(resume.data() + 1, &count, sizeof(count));
+    for (uint32_t i = 0; i < count; ++i) {
+        ResumeEntry entry{static_cast<SymbolId>(num_symbols - count + i), 0};
+        std::memcpy(resume.data() + sizeof(SubscriptionHeader) + i * sizeof(ResumeEntry),
+                    &entry, sizeof(entry));
+    }
+    ASSERT_EQ(send(client, resume.data(), resume.size(), 0), static_cast<ssize_t>(resume.size()));
+    EXPECT_TRUE(wait_for_subscription_count(sim, server_client_fd, count));
+    EXPECT_FALSE(sim.is_client_subscribed(server_client_fd, 0));
+    EXPECT_TRUE(sim.is_client_subscribed(server_client_fd, num_symbols - 1));
+    EXPECT_EQ(sim.get_num_connected_clients(), 1);
+    
+    close(client);
+    sim.stop();
+    
+    if (event_thread.joinable()) {
+        event_thread.join();
+    }
+}
+
 } // namespace mdfh
 
 int main(int argc, char** argv) {
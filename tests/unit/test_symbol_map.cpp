@@ -0,0 +1,99 @@
+#include <gtest/gtest.h>
+#include "common/symbol_map.h"
+#include <stdexcept>
+#include <vector>
+
+namespace mdfh {
+
+// Test: The default map is the identity over 0..num_symbols-1
+TEST(SymbolMapTest, IdentityMap) {
+    SymbolMap map(4);
+    EXPECT_EQ(map.size(), 4u);
+    for (SymbolId id = 0; id < 4; ++id) {
+        EXPECT_EQ(map.slot(id), id);
+        EXPECT_EQ(map.id(id), id);
+    }
+    EXPECT_FALSE(map.contains(4));
+    EXPECT_EQ(map.slot(1000000), SymbolMap::NO_SLOT);
+}
+
+// Test: Ids past the 16-bit range get dense slots in the order given
+TEST(SymbolMapTest, WideIdsMapToDenseSlots) {
+    SymbolMap map(std::vector<SymbolId>{70000, 5, 1000000});
+    ASSERT_EQ(map.size(), 3u);
+    EXPECT_EQ(map.slot(70000), 0u);
+    EXPECT_EQ(map.slot(5), 1u);
+    EXPECT_EQ(map.slot(1000000), 2u);
+    EXPECT_EQ(map.id(2), 1000000u);
+    EXPECT_FALSE(map.contains(6));
+    EXPECT_FALSE(map.contains(1000001));
+    EXPECT_EQ(map.slot(UINT32_MAX), SymbolMap::NO_SLOT);
+}
+
+// Test: Duplicate ids are rejected
+TEST(SymbolMapTest, RejectsDuplicateIds) {
+    EXPECT_THROW(SymbolMap(std::vector<SymbolId>{1, 2, 1}), std::invalid_argument);
+    EXPECT_THROW(SymbolMap(std::vector<SymbolId>{UINT32_MAX, 7, UINT32_MAX}), std::invalid_argument);
+}
+
+// Test: The whole SymbolId range maps, and the top of it costs a small table
+TEST(SymbolMapTest, FullIdRange) {
+    std::vector<SymbolId> ids = {0, 1u << 24, 0x80000000u, UINT32_MAX - 1, UINT32_MAX};
+    SymbolMap map(ids);
+    for (uint32_t slot = 0; slot < ids.size(); ++slot) {
+        EXPECT_EQ(map.slot(ids[slot]), slot);
+    }
+    EXPECT_FALSE(map.contains(UINT32_MAX - 2));
+    EXPECT_FALSE(map.contains((1u << 24) - 1));
+    EXPECT_LT(map.memory_bytes(), 2u * 1024 * 1024);  // A flat table is 16 GB
+}
+
+// Test: Dense ids pick large pages, so the table stays close to a flat array
+TEST(SymbolMapTest, DenseIdsUseFlatSizedTable) {
+    SymbolMap map(65536);
+    for (SymbolId id = 0; id < 65536; id += 4099) {
+        EXPECT_EQ(map.slot(id), id);
+    }
+    EXPECT_FALSE(map.contains(65536));
+    // Slot table, id list and one empty page over the 2 * 256 KB floor
+    EXPECT_LT(map.memory_bytes(), 2u * 256 * 1024 + 64 * 1024);
+}
+
+// Test: A few ids scattered over a wide space cost pages, not the id range
+TEST(SymbolMapTest, SparseIdsStaySmall) {
+    std::vector<SymbolId> ids = {3, 20000, 40000, 60000, 65535};
+    SymbolMap small(ids);
+    EXPECT_LT(small.memory_bytes(), 8u * 1024);   // A flat table is 256 KB
+    
+    std::vector<SymbolId> wide;
+    for (SymbolId i = 0; i < 1000; ++i) {
+        wide.push_back(i * 16777);
+    }
+    SymbolMap map(wide);
+    EXPECT_LT(map.memory_bytes(), 2u * 1024 * 1024);  // A flat table is 64 MB
+    for (uint32_t slot = 0; slot < wide.size(); ++slot) {
+        EXPECT_EQ(map.slot(wide[slot]), slot);
+        EXPECT_FALSE(map.contains(wide[slot] + 1));
+    }
+    EXPECT_GE(map.page_bits(), SymbolMap::MIN_PAGE_BITS);
+    EXPECT_LE(map.page_bits(), SymbolMap::MAX_PAGE_BITS);
+}
+
+// Test: Ids past the largest tracked id, up to UINT32_MAX, miss safely
+TEST(SymbolMapTest, IdsPastDirectoryMiss) {
+    SymbolMap map(std::vector<SymbolId>{100});
+    EXPECT_EQ(map.slot(100), 0u);
+    for (SymbolId id : {101u, 4096u, 1u << 24, SymbolMap::MAX_ID}) {
+        EXPECT_EQ(map.slot(id), SymbolMap::NO_SLOT) << id;
+    }
+    SymbolMap empty;
+    EXPECT_EQ(empty.size(), 0u);
+    EXPECT_EQ(empty.slot(0), SymbolMap::NO_SLOT);
+}
+
+} // namespace mdfh
+
+int main(int argc, char** argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
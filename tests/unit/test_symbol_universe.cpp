@@ -0,0 +1,106 @@
+#include <gtest/gtest.h>
+#include "common/symbol_universe.h"
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+
+namespace fs = std::filesystem;
+
+namespace mdfh {
+
+class SymbolUniverseTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        dir_ = fs::temp_directory_path() / "mdfh_symbol_universe_test";
+        fs::create_directories(dir_);
+    }
+
+    void TearDown() override {
+        fs::remove_all(dir_);
+    }
+
+    std::string write(const std::string& name, const std::string& contents) {
+        std::string file = (dir_ / name).string();
+        std::ofstream out(file, std::ios::binary);
+        out << contents;
+        return file;
+    }
+
+    fs::path dir_;
+};
+
+// Test: CSV rows parse with CRLF endings, blank lines, padded numbers and
+// an optional weight; malformed rows are skipped and counted
+TEST_F(SymbolUniverseTest, ParsesCsv) {
+    std::string file = write("symbols.csv",
+        "symbol_id,symbol,price,volatility,drift,weight\r\n"
+        "0,RELIANCE,2450.50,0.02,0.0001\r\n"
+        "\r\n"
+        "1,TCS, 3200.75 ,0.015,-0.0002,2.5\r\n"
+        "x,BAD,1,1,1\n"                 // Id
+        "2,,1,1,1\n"                    // Name
+        "3,SHORT,1,1\n"                 // Too few fields
+        "4,HDFC,1650,0.018,0.0001,-1\n" // Negative weight -> 0
+        "70000,WIDE,10,0.01,0");        // No trailing newline
+    SymbolUniverse universe = SymbolUniverse::load(file);
+
+    EXPECT_FALSE(universe.is_binary());
+    ASSERT_EQ(universe.size(), 4u);
+    EXPECT_EQ(universe.get_skipped_rows(), 3u);
+    EXPECT_EQ(universe[0].symbol_id, 0u);
+    EXPECT_EQ(universe.name(universe[0]), "RELIANCE");
+    EXPECT_DOUBLE_EQ(universe[0].price, 2450.50);
+    EXPECT_DOUBLE_EQ(universe[0].weight, 0.0);
+    EXPECT_EQ(universe.name(universe[1]), "TCS");
+    EXPECT_DOUBLE_EQ(universe[1].price, 3200.75);
+    EXPECT_DOUBLE_EQ(universe[1].drift, -0.0002);
+    EXPECT_DOUBLE_EQ(universe[1].weight, 2.5);
+    EXPECT_DOUBLE_EQ(universe[2].weight, 0.0);
+    EXPECT_EQ(universe[3].symbol_id, 70000u);
+    EXPECT_EQ(universe.name(universe[3]), "WIDE");
+}
+
+// Test: A saved binary universe loads back identically, and survives a move
+TEST_F(SymbolUniverseTest, BinaryRoundTrip) {
+    std::string csv = write("symbols.csv",
+        "symbol_id,symbol,price,volatility,drift\n"
+        "5,INFY,1500,0.02,0.0001\n"
+        "2,ITC,450.25,0.01,0\n");
+    std::string bin = (dir_ / "universe.bin").string();
+    SymbolUniverse::load(csv).save(bin);
+
+    SymbolUniverse loaded = SymbolUniverse::load(bin);
+    SymbolUniverse universe = std::move(loaded);
+    EXPECT_TRUE(universe.is_binary());
+    ASSERT_EQ(universe.size(), 2u);
+    EXPECT_EQ(universe[0].symbol_id, 5u);
+    EXPECT_EQ(universe.name(universe[0]), "INFY");
+    EXPECT_EQ(universe[1].symbol_id, 2u);
+    EXPECT_EQ(universe.name(universe[1]), "ITC");
+    EXPECT_DOUBLE_EQ(universe[1].price, 450.25);
+}
+
+// Test: Missing files and truncated or foreign binary universes throw
+TEST_F(SymbolUniverseTest, RejectsBadFiles) {
+    EXPECT_THROW(SymbolUniverse::load((dir_ / "missing.csv").string()), std::runtime_error);
+
+    std::string csv = write("symbols.csv", "symbol_id,symbol,price,volatility,drift\n1,ABC,10,0.01,0\n");
+    std::string bin = (dir_ / "universe.bin").string();
+    SymbolUniverse::load(csv).save(bin);
+    fs::resize_file(bin, fs::file_size(bin) - 1);
+    EXPECT_THROW(SymbolUniverse::load(bin), std::runtime_error);
+
+    std::string header(SymbolUniverse::MAGIC, sizeof(SymbolUniverse::MAGIC));
+    EXPECT_THROW(SymbolUniverse::load(write("short.bin", header + "abc")), std::runtime_error);
+
+    // An empty file is an empty universe, not an error
+    EXPECT_EQ(SymbolUniverse::load(write("empty.csv", "")).size(), 0u);
+}
+
+} // namespace mdfh
+
+int main(int argc, char** argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
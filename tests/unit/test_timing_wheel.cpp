@@ -0,0 +1,109 @@
+#include <gtest/gtest.h>
+#include "common/timing_wheel.h"
+#include <algorithm>
+#include <random>
+#include <utility>
+#include <vector>
+
+namespace mdfh {
+
+// Test: Timers fire exactly at their deadline on every level, including
+// past the horizon where they are re-parked on cascade
+TEST(TimingWheelTest, FiresAtDeadlineOnEveryLevel) {
+    const std::vector<uint64_t> deadlines = {
+        1, 2, 255, 256, 257, 300, 65535, 65536, 65537, 100000,
+        (1ull << 24) - 1, 1ull << 24, (1ull << 24) + 5,
+        TimingWheel::HORIZON - 1, TimingWheel::HORIZON + 12345
+    };
+    TimingWheel wheel(deadlines.size());
+    for (size_t i = 0; i < deadlines.size(); ++i) {
+        wheel.schedule(static_cast<uint32_t>(i), deadlines[i]);
+    }
+    EXPECT_EQ(wheel.size(), deadlines.size());
+
+    std::vector<uint64_t> fired_at(deadlines.size(), 0);
+    size_t fired = wheel.advance(TimingWheel::HORIZON + 20000, [&](uint32_t id, uint64_t deadline) {
+        EXPECT_EQ(deadline, deadlines[id]);
+        fired_at[id] = wheel.now();
+    });
+    EXPECT_EQ(fired, deadlines.size());
+    EXPECT_EQ(wheel.size(), 0u);
+    for (size_t i = 0; i < deadlines.size(); ++i) {
+        EXPECT_EQ(fired_at[i], deadlines[i]) << "timer " << i;
+    }
+}
+
+// Test: Random deadlines, advanced in random steps, fire in deadline order
+// and none before or after its tick
+TEST(TimingWheelTest, RandomDeadlinesFireInOrder) {
+    const uint32_t timers = 5000;
+    std::mt19937_64 rng(42);
+    std::uniform_int_distribution<uint64_t> delay(0, 1 << 20);
+    TimingWheel wheel(timers, 1000);
+    for (uint32_t i = 0; i < timers; ++i) {
+        wheel.schedule(i, 1000 + delay(rng));
+    }
+
+    uint64_t last = 0;
+    size_t fired = 0;
+    std::uniform_int_distribution<uint64_t> step(1, 5000);
+    while (wheel.size() > 0) {
+        uint64_t target = wheel.now() + step(rng);
+        fired += wheel.advance(target, [&](uint32_t id, uint64_t deadline) {
+            EXPECT_EQ(deadline, wheel.now()) << "timer " << id;
+            EXPECT_GE(deadline, last);
+            last = deadline;
+        });
+        EXPECT_EQ(wheel.now(), target);
+    }
+    EXPECT_EQ(fired, timers);
+}
+
+// Test: Rescheduling from the callback (a periodic timer) and deadlines in
+// the past, which fire on the next tick
+TEST(TimingWheelTest, RescheduleFromCallback) {
+    TimingWheel wheel(2, 100);
+    wheel.schedule(0, 50);                  // In the past
+    EXPECT_EQ(wheel.get_deadline(0), 101u);
+    wheel.schedule(1, 110);
+
+    std::vector<std::pair<uint32_t, uint64_t>> events;
+    wheel.advance(1000, [&](uint32_t id, uint64_t deadline) {
+        events.emplace_back(id, deadline);
+        if (id == 1 && deadline < 600) {
+            wheel.schedule(1, deadline + 250);
+        }
+    });
+    std::vector<std::pair<uint32_t, uint64_t>> expected = {{0, 101}, {1, 110}, {1, 360}, {1, 610}};
+    EXPECT_EQ(events, expected);
+    EXPECT_FALSE(wheel.is_scheduled(1));
+}
+
+// Test: Cancel and re-arm move a pending timer; clear restarts the clock
+TEST(TimingWheelTest, CancelAndClear) {
+    TimingWheel wheel(3);
+    wheel.schedule(0, 10);
+    wheel.schedule(1, 70000);
+    wheel.schedule(2, 20);
+    EXPECT_TRUE(wheel.cancel(1));
+    EXPECT_FALSE(wheel.cancel(1));
+    wheel.schedule(2, 5);                   // Re-arm earlier
+    EXPECT_EQ(wheel.size(), 2u);
+
+    std::vector<uint32_t> order;
+    wheel.advance(100000, [&](uint32_t id, uint64_t) { order.push_back(id); });
+    EXPECT_EQ(order, (std::vector<uint32_t>{2, 0}));
+
+    wheel.schedule(0, 200000);
+    wheel.clear(5);
+    EXPECT_EQ(wheel.size(), 0u);
+    EXPECT_EQ(wheel.now(), 5u);
+    EXPECT_EQ(wheel.advance(300000, [](uint32_t, uint64_t) {}), 0u);
+}
+
+} // namespace mdfh
+
+int main(int argc, char** argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,143 @@
+#include <gtest/gtest.h>
+#include "common/trace.h"
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <thread>
+#include <vector>
+#include <unistd.h>
+
+using namespace mdfh;
+
+int main(int argc, char** argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
+
+class TraceTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        Tracer::instance().reset();
+        filename_ = "/tmp/mdfh_trace_test_" + std::to_string(::getpid()) + ".json";
+    }
+    
+    void TearDown() override {
+        std::remove(filename_.c_str());
+    }
+    
+    std::string read_file() {
+        std::ifstream in(filename_);
+        std::stringstream ss;
+        ss << in.rdbuf();
+        return ss.str();
+    }
+    
+    static size_t count_occurrences(const std::string& text, const std::string& needle) {
+        size_t count = 0;
+        for (size_t pos = text.find(needle); pos != std::string::npos;
+             pos = text.find(needle, pos + needle.size())) {
+            count++;
+        }
+        return count;
+    }
+    
+    std::string filename_;
+};
+
+TEST_F(TraceTest, ZoneNames) {
+    EXPECT_STREQ(trace_zone_name(TraceZoneId::RECEIVE), "receive");
+    EXPECT_STREQ(trace_zone_name(TraceZoneId::CACHE_UPDATE), "cache_update");
+    EXPECT_STREQ(trace_zone_name(TraceZoneId::SEND), "send");
+    EXPECT_STREQ(trace_zone_name(TraceZoneId::COUNT), "unknown");
+}
+
+TEST_F(TraceTest, ScopedZoneRecordsEvent) {
+    uint64_t before = Tracer::instance().get_total_events();
+    {
+        TraceZone zone(TraceZoneId::PARSE);
+    }
+    EXPECT_EQ(Tracer::instance().get_total_events(), before + 1);
+}
+
+TEST_F(TraceTest, MacroMatchesBuildOption) {
+    uint64_t before = Tracer::instance().get_total_events();
+    {
+        MDFH_TRACE_ZONE(DISPATCH);
+    }
+#ifdef MDFH_TRACING
+    EXPECT_EQ(Tracer::instance().get_total_events(), before + 1);
+#else
+    EXPECT_EQ(Tracer::instance().get_total_events(), before);
+#endif
+}
+
+TEST_F(TraceTest, DumpChromeJson) {
+    Tracer::instance().set_thread_name("test-main");
+    for (int i = 0; i < 10; ++i) {
+        TraceZone zone(TraceZoneId::TICK_GENERATE);
+    }
+    Tracer::instance().record(TraceZoneId::SEND, TscClock::now_ticks(), TscClock::now_ticks() + 100);
+    
+    ASSERT_TRUE(Tracer::instance().dump_chrome_json(filename_));
+    std::string json = read_file();
+    
+    EXPECT_EQ(json.find("{\"displayTimeUnit\""), 0u);
+    EXPECT_NE(json.find("\"traceEvents\""), std::string::npos);
+    EXPECT_NE(json.find("\"name\":\"test-main\""), std::string::npos);
+    EXPECT_EQ(count_occurrences(json, "\"name\":\"tick_generate\",\"ph\":\"X\""), 10u);
+    EXPECT_EQ(count_occurrences(json, "\"name\":\"send\",\"ph\":\"X\""), 1u);
+    EXPECT_NE(json.rfind("]}"), std::string::npos);
+}
+
+TEST_F(TraceTest, PerThreadBuffers) {
+    constexpr int NUM_THREADS = 3;
+    constexpr int PER_THREAD = 100;
+    uint64_t before = Tracer::instance().get_total_events();
+    
+    std::vector<std::thread> threads;
+    for (int t = 0; t < NUM_THREADS; ++t) {
+        threads.emplace_back([] {
+            for (int i = 0; i < PER_THREAD; ++i) {
+                TraceZone zone(TraceZoneId::RECEIVE);
+            }
+        });
+    }
+    for (auto& th : threads) {
+        th.join();
+    }
+    
+    EXPECT_EQ(Tracer::instance().get_total_events(), before + NUM_THREADS * PER_THREAD);
+    
+    ASSERT_TRUE(Tracer::instance().dump_chrome_json(filename_));
+    EXPECT_EQ(count_occurrences(read_file(), "\"name\":\"receive\",\"ph\":\"X\""),
+              static_cast<size_t>(NUM_THREADS * PER_THREAD));
+}
+
+TEST_F(TraceTest, RingOverwritesOldestEvents) {
+    for (size_t i = 0; i < TraceBuffer::CAPACITY + 500; ++i) {
+        Tracer::instance().record(TraceZoneId::BROADCAST, i, i + 1);
+    }
+    
+    // The oldest slot is the one the next record() overwrites, so a full
+    // ring dumps one event less than it holds
+    ASSERT_TRUE(Tracer::instance().dump_chrome_json(filename_));
+    EXPECT_EQ(count_occurrences(read_file(), "\"name\":\"broadcast\",\"ph\":\"X\""),
+              TraceBuffer::CAPACITY - 1);
+}
+
+TEST_F(TraceTest, ThreadNameIsEscaped) {
+    Tracer::instance().set_thread_name("feed \"A\"\\line\n");
+    Tracer::instance().record(TraceZoneId::SEND, 1, 2);
+    
+    ASSERT_TRUE(Tracer::instance().dump_chrome_json(filename_));
+    EXPECT_NE(read_file().find("\"name\":\"feed \\\"A\\\"\\\\line\\u000a\""), std::string::npos);
+    Tracer::instance().set_thread_name("test-main");
+}
+
+TEST_F(TraceTest, PollDumpOnlyAfterRequest) {
+    EXPECT_FALSE(Tracer::instance().poll_dump(filename_));
+    
+    Tracer::instance().request_dump();
+    EXPECT_TRUE(Tracer::instance().poll_dump(filename_));
+    EXPECT_FALSE(Tracer::instance().poll_dump(filename_));
+}
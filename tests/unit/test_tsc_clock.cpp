@@ -0,0 +1,122 @@
+#include <gtest/gtest.h>
+#include "common/tsc_clock.h"
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <cstdlib>
+
+using namespace mdfh;
+
+int main(int argc, char** argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
+
+TEST(TscClockTest, TicksAreMonotonic) {
+    uint64_t prev = TscClock::now_ticks();
+    for (int i = 0; i < 10000; ++i) {
+        uint64_t now = TscClock::now_ticks();
+        EXPECT_GE(now, prev);
+        prev = now;
+    }
+}
+
+TEST(TscClockTest, TicksPerNsIsPlausible) {
+    double tpn = TscClock::ticks_per_ns();
+    // Anything between 100 MHz and 10 GHz
+    EXPECT_GT(tpn, 0.1);
+    EXPECT_LT(tpn, 10.0);
+    
+    if (!TscClock::is_tsc_invariant()) {
+        EXPECT_FALSE(TscClock::using_tsc());
+        EXPECT_DOUBLE_EQ(tpn, 1.0);
+    }
+}
+
+TEST(TscClockTest, NowNsTracksMonotonicRaw) {
+    uint64_t raw = TscClock::monotonic_raw_ns();
+    uint64_t ns = TscClock::now_ns();
+    
+    // Within 1ms of the kernel clock it was calibrated against
+    EXPECT_LT(std::llabs(static_cast<long long>(ns - raw)), 1000000LL);
+}
+
+TEST(TscClockTest, DeltaMatchesSleep) {
+    uint64_t start = TscClock::now_ticks();
+    auto wall_start = std::chrono::steady_clock::now();
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    uint64_t end = TscClock::now_ticks();
+    auto wall_elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - wall_start).count();
+    
+    uint64_t elapsed = TscClock::delta_to_ns(end - start);
+    EXPECT_NEAR(static_cast<double>(elapsed), static_cast<double>(wall_elapsed),
+                wall_elapsed * 0.05 + 100000.0);
+}
+
+TEST(TscClockTest, WallClockCloseToSystemClock) {
+    uint64_t wall = TscClock::now_wall_ns();
+    uint64_t sys = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+    
+    EXPECT_LT(std::llabs(static_cast<long long>(wall - sys)), 10000000LL);  // 10ms
+}
+
+TEST(TscClockTest, RecalibrateKeepsConversionContinuous) {
+    uint64_t ticks = TscClock::now_ticks();
+    uint64_t before = TscClock::to_ns(ticks);
+    
+    TscClock::recalibrate(5);
+    uint64_t after = TscClock::to_ns(ticks);
+    
+    // Same tick value must map to (nearly) the same time after recalibration
+    EXPECT_LT(std::llabs(static_cast<long long>(after - before)), 100000LL);  // 100us
+}
+
+TEST(TscClockTest, NowNsMonotonicAcrossRecalibration) {
+    std::atomic<bool> done{false};
+    std::atomic<uint64_t> backwards{0};
+    std::atomic<uint64_t> reads{0};
+    std::thread reader([&] {
+        uint64_t prev = TscClock::now_ns();
+        while (!done.load(std::memory_order_relaxed)) {
+            uint64_t now = TscClock::now_ns();
+            if (now < prev) {
+                backwards.fetch_add(1, std::memory_order_relaxed);
+            }
+            prev = now;
+            reads.fetch_add(1, std::memory_order_relaxed);
+        }
+    });
+    
+    for (int i = 0; i < 20; ++i) {
+        TscClock::recalibrate(1);
+    }
+    done.store(true);
+    reader.join();
+    
+    EXPECT_GT(reads.load(), 0u);
+    EXPECT_EQ(backwards.load(), 0u);
+    
+    // Slewing keeps the clock near the kernel clock it is steered towards
+    uint64_t raw = TscClock::monotonic_raw_ns();
+    EXPECT_LT(std::llabs(static_cast<long long>(TscClock::now_ns() - raw)), 1000000LL);
+}
+
+TEST(TscClockTest, ConvertsTicksBeforeBase) {
+    uint64_t old_ticks = TscClock::now_ticks();
+    std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    TscClock::recalibrate(2);
+    uint64_t new_ticks = TscClock::now_ticks();
+    
+    EXPECT_LT(TscClock::to_ns(old_ticks), TscClock::to_ns(new_ticks));
+}
+
+TEST(TscClockTest, CalibrationThreadStartStop) {
+    TscClock::start_calibration_thread(50);
+    TscClock::start_calibration_thread(50);  // Idempotent
+    std::this_thread::sleep_for(std::chrono::milliseconds(120));
+    TscClock::stop_calibration_thread();
+    
+    EXPECT_GT(TscClock::now_ns(), 0u);
+}